@@ -20,6 +20,10 @@
 #include <fstream>
 #include <cstdlib>
 #include <cstring>
+#include <chrono>
+#include <deque>
+#include <future>
+#include <mutex>
 
 #include "mantaio.h"
 #include "grid.h"
@@ -386,6 +390,90 @@ static void registerCustomCodecs()
                                        openvdb::points::TruncateCodec>::registerType();
 }
 
+// Compressing and writing a file runs in the background, so that the solver can continue with
+// the next step meanwhile. The vdb grids are copies of the mantaflow objects, they are not
+// touched by the solver anymore once a write started.
+static const size_t MAX_PENDING_WRITES = 4;
+
+static struct {
+  std::mutex mutex;
+  std::deque<std::pair<string, std::shared_future<void>>> writes;
+} pendingWrites;
+
+// Remove the finished writes from the front of the queue, the mutex must be locked.
+static void removeFinishedWrites()
+{
+  while (!pendingWrites.writes.empty() &&
+         pendingWrites.writes.front().second.wait_for(std::chrono::seconds(0)) ==
+             std::future_status::ready)
+  {
+    pendingWrites.writes.pop_front();
+  }
+}
+
+// Wait for the pending writes of the given file, or for all writes if the filename is empty.
+static void waitForWrites(const string &filename)
+{
+  std::vector<std::shared_future<void>> writes;
+  {
+    std::lock_guard<std::mutex> lock(pendingWrites.mutex);
+    for (const auto &write : pendingWrites.writes) {
+      if (filename.empty() || write.first == filename) {
+        writes.push_back(write.second);
+      }
+    }
+  }
+  for (const std::shared_future<void> &write : writes) {
+    write.wait();
+  }
+
+  std::lock_guard<std::mutex> lock(pendingWrites.mutex);
+  removeFinishedWrites();
+}
+
+static void writeGridsInBackground(const string &filename,
+                                   const openvdb::GridPtrVec &gridsVDB,
+                                   const int vdb_flags)
+{
+  // A file is written again when a frame is baked again, the previous write has to finish first.
+  waitForWrites(filename);
+
+  // Create the file right away, so that cache lookups by file name find the frame already.
+  std::ofstream(filename, std::ios::binary | std::ios::trunc);
+
+  std::shared_future<void> write = std::async(std::launch::async, [=]() {
+    try {
+      openvdb::io::File file(filename);
+      file.setCompression(vdb_flags);
+      file.write(gridsVDB);
+      file.close();
+    }
+    catch (const std::exception &e) {
+      std::cerr << "writeObjectsVDB: Could not write vdb file " << filename << ": " << e.what()
+                << std::endl;
+    }
+  });
+
+  // Limit the memory used by the copies of grids that are not written yet.
+  std::shared_future<void> oldest;
+  {
+    std::lock_guard<std::mutex> lock(pendingWrites.mutex);
+    removeFinishedWrites();
+    pendingWrites.writes.emplace_back(filename, write);
+    if (pendingWrites.writes.size() > MAX_PENDING_WRITES) {
+      oldest = pendingWrites.writes.front().second;
+    }
+  }
+  if (oldest.valid()) {
+    oldest.wait();
+  }
+}
+
+void flushWritesVDB()
+{
+  waitForWrites("");
+}
+
 int writeObjectsVDB(const string &filename,
                     std::vector<PbClass *> *objects,
                     float worldSize,
@@ -397,7 +485,6 @@ int writeObjectsVDB(const string &filename,
                     const bool meta)
 {
   openvdb::initialize();
-  openvdb::io::File file(filename);
   openvdb::GridPtrVec gridsVDB;
 
   // Register custom codecs, this makes sure custom attributes can be read
@@ -543,10 +630,8 @@ int writeObjectsVDB(const string &filename,
         break;
       }
     }
-    file.setCompression(vdb_flags);
-    file.write(gridsVDB);
+    writeGridsInBackground(filename, gridsVDB, vdb_flags);
   }
-  file.close();
   return 1;
 }
 
@@ -590,6 +675,8 @@ static void clearAll(std::vector<PbClass *> *objects, std::vector<ParticleDataBa
 
 int readObjectsVDB(const string &filename, std::vector<PbClass *> *objects, float worldSize)
 {
+  // The file may still be written in the background.
+  waitForWrites(filename);
 
   openvdb::initialize();
   openvdb::io::File file(filename);
@@ -867,6 +954,10 @@ template void exportVDB<Vec3, openvdb::Vec3s>(ParticleDataImpl<Vec3> *from,
 
 #else
 
+void flushWritesVDB()
+{
+}
+
 int writeObjectsVDB(const string &filename,
                     std::vector<PbClass *> *objects,
                     float worldSize,
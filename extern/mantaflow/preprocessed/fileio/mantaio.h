@@ -82,6 +82,8 @@ int writeObjectsVDB(const std::string &filename,
 int readObjectsVDB(const std::string &filename,
                    std::vector<PbClass *> *objects,
                    float scale = 1.0);
+// Files are written in the background, wait until all of them are complete.
+void flushWritesVDB();
 
 // Numpy
 template<class T> int writeGridNumpy(const std::string &name, Grid<T> *grid);
@@ -8,6 +8,7 @@
 #include "scene/camera.h"
 #include "scene/integrator.h"
 #include "scene/scene.h"
+#include "scene/scene_cache.h"
 #include "session/buffers.h"
 #include "session/session.h"
 
@@ -49,6 +50,7 @@ struct Options {
   bool show_help, interactive, pause;
   string output_filepath;
   string output_pass;
+  string cache_filepath;
 } options;
 
 static void session_print(const string &str)
@@ -112,6 +114,12 @@ static void scene_init()
     xml_read_file(options.scene, options.filepath.c_str());
   }
 
+  /* Write geometry, objects and lights to a cache, which can be loaded with a `<cache>` element
+   * instead of exporting the scene again. */
+  if (!options.cache_filepath.empty()) {
+    scene_cache_write(options.scene, options.cache_filepath);
+  }
+
   /* Camera width/height override? */
   if (!(options.width == 0 || options.height == 0)) {
     options.scene->camera->set_full_width(options.width);
@@ -411,9 +419,17 @@ static void options_parse(int argc, const char **argv)
              "--samples %d",
              &options.session_params.samples,
              "Number of samples to render",
+             "--sample-offset %d",
+             &options.session_params.sample_offset,
+             "Number of samples to skip, to render a subset of the samples on each of several "
+             "machines",
              "--output %s",
              &options.output_filepath,
              "File path to write output image",
+             "--write-cache %s",
+             &options.cache_filepath,
+             "File path to write the scene geometry, objects and lights to, for loading with a "
+             "cache element in a later render",
              "--threads %d",
              &options.session_params.threads,
              "CPU Rendering Threads",
@@ -529,6 +545,13 @@ static void options_parse(int argc, const char **argv)
     fprintf(stderr, "Invalid number of samples: %d\n", options.session_params.samples);
     exit(EXIT_FAILURE);
   }
+  else if (options.session_params.sample_offset < 0 ||
+           options.session_params.sample_offset >
+               Integrator::MAX_SAMPLES - options.session_params.samples)
+  {
+    fprintf(stderr, "Invalid sample offset: %d\n", options.session_params.sample_offset);
+    exit(EXIT_FAILURE);
+  }
   else if (options.filepath == "") {
     fprintf(stderr, "No file path specified\n");
     exit(EXIT_FAILURE);
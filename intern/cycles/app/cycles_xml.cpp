@@ -20,6 +20,7 @@
 #include "scene/object.h"
 #include "scene/osl.h"
 #include "scene/scene.h"
+#include "scene/scene_cache.h"
 #include "scene/shader.h"
 #include "scene/shader_graph.h"
 #include "scene/shader_nodes.h"
@@ -683,6 +684,15 @@ static void xml_read_scene(XMLReadState &state, xml_node scene_node)
       xml_read_state(substate, node);
       xml_read_scene(substate, node);
     }
+    else if (string_iequals(node.name(), "cache")) {
+      string src;
+
+      if (xml_read_string(&src, node, "src")) {
+        if (!scene_cache_read(state.scene, path_join(state.base, src))) {
+          exit(EXIT_FAILURE);
+        }
+      }
+    }
     else if (string_iequals(node.name(), "include")) {
       string src;
 
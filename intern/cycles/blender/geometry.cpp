@@ -2,6 +2,8 @@
  *
  * SPDX-License-Identifier: Apache-2.0 */
 
+#include <optional>
+
 #include "scene/curves.h"
 #include "scene/hair.h"
 #include "scene/mesh.h"
@@ -15,6 +17,10 @@
 #include "util/foreach.h"
 #include "util/task.h"
 
+#include "BKE_attribute.hh"
+#include "BKE_curves.hh"
+#include "BKE_pointcloud.hh"
+
 CCL_NAMESPACE_BEGIN
 
 static Geometry::Type determine_geom_type(BObjectInfo &b_ob_info, bool use_particle_hair)
@@ -37,6 +43,57 @@ static Geometry::Type determine_geom_type(BObjectInfo &b_ob_info, bool use_parti
   return Geometry::MESH;
 }
 
+/* Gather the arrays of curves and point cloud data, to share one Cycles geometry between
+ * objects whose evaluated data shares all its arrays, like geometry nodes instances that were
+ * realized or copied. The positions array comes first and is used as key. Returns false when
+ * some attribute is not stored as a plain array. */
+static bool geometry_shared_data_arrays(BObjectInfo &b_ob_info,
+                                        const Geometry::Type geom_type,
+                                        const bool use_particle_hair,
+                                        vector<const void *> &r_arrays)
+{
+  std::optional<blender::bke::AttributeAccessor> b_attributes;
+
+  if (geom_type == Geometry::HAIR && !use_particle_hair &&
+      b_ob_info.object_data.is_a(&RNA_Curves))
+  {
+    const blender::bke::CurvesGeometry &b_curves =
+        static_cast<const ::Curves *>(b_ob_info.object_data.ptr.data)->geometry.wrap();
+    if (b_curves.points_num() == 0) {
+      return false;
+    }
+    r_arrays.push_back(b_curves.positions().data());
+    r_arrays.push_back(b_curves.offsets().data());
+    b_attributes = b_curves.attributes();
+  }
+  else if (geom_type == Geometry::POINTCLOUD) {
+    const ::PointCloud &b_pointcloud = *static_cast<const ::PointCloud *>(
+        b_ob_info.object_data.ptr.data);
+    if (b_pointcloud.totpoint == 0) {
+      return false;
+    }
+    r_arrays.push_back(b_pointcloud.positions().data());
+    b_attributes = b_pointcloud.attributes();
+  }
+  else {
+    return false;
+  }
+
+  bool all_spans = true;
+  b_attributes->for_all([&](const blender::bke::AttributeIDRef &id,
+                            const blender::bke::AttributeMetaData /*meta_data*/) {
+    const blender::bke::GAttributeReader b_attr = b_attributes->lookup(id);
+    if (!b_attr || !b_attr.varray.is_span()) {
+      all_spans = false;
+      return false;
+    }
+    r_arrays.push_back(b_attr.varray.get_internal_span().data());
+    return true;
+  });
+
+  return all_spans;
+}
+
 array<Node *> BlenderSync::find_used_shaders(BL::Object &b_ob)
 {
   BL::Material material_override = view_layer.material_override;
@@ -81,8 +138,36 @@ Geometry *BlenderSync::sync_geometry(BL::Depsgraph &b_depsgraph,
                         b_ob_info.object_data;
   GeometryKey key(b_key_id.ptr.data, geom_type);
 
-  /* Find shader indices. */
-  array<Node *> used_shaders = find_used_shaders(b_ob_info.iter_object);
+  /* Share geometry between different data-blocks that share all their arrays and shaders. Motion
+   * blur reads other time steps from each object, so sharing is only done without it. */
+  bool force_sync = false;
+  array<Node *> used_shaders;
+  vector<const void *> shared_arrays;
+  if (scene->need_motion() != Scene::MOTION_BLUR &&
+      geometry_shared_data_arrays(b_ob_info, geom_type, use_particle_hair, shared_arrays))
+  {
+    used_shaders = find_used_shaders(b_ob_info.iter_object);
+    shared_arrays.insert(shared_arrays.end(), used_shaders.begin(), used_shaders.end());
+    const GeometryKey shared_key(const_cast<void *>(shared_arrays[0]), geom_type);
+    Geometry *shared_geom = geometry_map.find(shared_key);
+    auto it = geometry_shared_data.find(shared_key);
+
+    if (shared_geom == nullptr || it == geometry_shared_data.end()) {
+      key = shared_key;
+      geometry_shared_data[key] = shared_arrays;
+    }
+    else if (it->second == shared_arrays) {
+      key = shared_key;
+    }
+    else if (geometry_synced.find(shared_geom) == geometry_synced.end()) {
+      /* Same positions as in a previous sync but other arrays changed, sync again. */
+      key = shared_key;
+      it->second = shared_arrays;
+      force_sync = true;
+    }
+    /* Otherwise the arrays differ from geometry already synced with this key, so fall back to
+     * the data-block as key. */
+  }
 
   /* Ensure we only sync instanced geometry once. */
   Geometry *geom = geometry_map.find(key);
@@ -92,6 +177,11 @@ Geometry *BlenderSync::sync_geometry(BL::Depsgraph &b_depsgraph,
     }
   }
 
+  /* Find shader indices. */
+  if (used_shaders.empty()) {
+    used_shaders = find_used_shaders(b_ob_info.iter_object);
+  }
+
   /* Test if we need to sync. */
   bool sync = true;
   if (geom == NULL) {
@@ -112,7 +202,7 @@ Geometry *BlenderSync::sync_geometry(BL::Depsgraph &b_depsgraph,
   }
   else {
     /* Test if we need to update existing geometry. */
-    sync = geometry_map.update(geom, b_key_id);
+    sync = geometry_map.update(geom, b_key_id) || force_sync;
   }
 
   if (!sync) {
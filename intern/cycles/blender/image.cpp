@@ -2,8 +2,6 @@
  *
  * SPDX-License-Identifier: Apache-2.0 */
 
-#include "MEM_guardedalloc.h"
-
 #include "blender/image.h"
 #include "blender/session.h"
 #include "blender/util.h"
@@ -101,14 +99,12 @@ bool BlenderImageLoader::load_pixels(const ImageMetaData &metadata,
   const int channels = metadata.channels;
 
   if (metadata.type == IMAGE_DATA_TYPE_FLOAT || metadata.type == IMAGE_DATA_TYPE_FLOAT4) {
-    /* Float. */
-    float *in_pixels = image_get_float_pixels_for_frame(b_image, frame, tile_number);
+    /* Float, straight copy pixel data. */
+    const bool found = num_pixels * channels == out_pixels_size &&
+                       image_get_float_pixels_for_frame(
+                           b_image, frame, tile_number, (float *)out_pixels, out_pixels_size);
 
-    if (in_pixels && num_pixels * channels == out_pixels_size) {
-      /* Straight copy pixel data. */
-      memcpy(out_pixels, in_pixels, out_pixels_size * sizeof(float));
-    }
-    else {
+    if (!found) {
       /* Missing or invalid pixel data. */
       if (channels == 1) {
         memset(out_pixels, 0, num_pixels * sizeof(float));
@@ -126,35 +122,36 @@ bool BlenderImageLoader::load_pixels(const ImageMetaData &metadata,
         }
       }
     }
-
-    if (in_pixels) {
-      MEM_freeN(in_pixels);
-    }
   }
   else if (metadata.type == IMAGE_DATA_TYPE_HALF || metadata.type == IMAGE_DATA_TYPE_HALF4) {
     /* Half float. Blender does not have a half type, but in some cases
      * we up-sample byte to half to avoid precision loss for colorspace
      * conversion. */
-    unsigned char *in_pixels = image_get_pixels_for_frame(b_image, frame, tile_number);
-
-    if (in_pixels && num_pixels * channels == out_pixels_size) {
+    /* The byte pixels are read into the start of the output buffer, and converted in place from
+     * the end so that no temporary copy of the image is needed. */
+    const uchar *in_pixels = (const uchar *)out_pixels;
+    half *out_half = (half *)out_pixels;
+    const bool found = num_pixels * channels == out_pixels_size &&
+                       image_get_pixels_for_frame(
+                           b_image, frame, tile_number, (uchar *)out_pixels, out_pixels_size);
+
+    if (found) {
       /* Convert uchar to half. */
-      const uchar *in_pixel = in_pixels;
-      half *out_pixel = (half *)out_pixels;
       if (associate_alpha && channels == 4) {
-        for (size_t i = 0; i < num_pixels; i++, in_pixel += 4, out_pixel += 4) {
-          const float alpha = util_image_cast_to_float(in_pixel[3]);
-          out_pixel[0] = float_to_half_image(util_image_cast_to_float(in_pixel[0]) * alpha);
-          out_pixel[1] = float_to_half_image(util_image_cast_to_float(in_pixel[1]) * alpha);
-          out_pixel[2] = float_to_half_image(util_image_cast_to_float(in_pixel[2]) * alpha);
-          out_pixel[3] = float_to_half_image(alpha);
+        for (size_t i = num_pixels; i-- > 0;) {
+          const float r = util_image_cast_to_float(in_pixels[i * 4 + 0]);
+          const float g = util_image_cast_to_float(in_pixels[i * 4 + 1]);
+          const float b = util_image_cast_to_float(in_pixels[i * 4 + 2]);
+          const float alpha = util_image_cast_to_float(in_pixels[i * 4 + 3]);
+          out_half[i * 4 + 0] = float_to_half_image(r * alpha);
+          out_half[i * 4 + 1] = float_to_half_image(g * alpha);
+          out_half[i * 4 + 2] = float_to_half_image(b * alpha);
+          out_half[i * 4 + 3] = float_to_half_image(alpha);
         }
       }
       else {
-        for (size_t i = 0; i < num_pixels; i++) {
-          for (int c = 0; c < channels; c++, in_pixel++, out_pixel++) {
-            *out_pixel = float_to_half_image(util_image_cast_to_float(*in_pixel));
-          }
+        for (size_t i = out_pixels_size; i-- > 0;) {
+          out_half[i] = float_to_half_image(util_image_cast_to_float(in_pixels[i]));
         }
       }
     }
@@ -176,19 +173,14 @@ bool BlenderImageLoader::load_pixels(const ImageMetaData &metadata,
         }
       }
     }
-
-    if (in_pixels) {
-      MEM_freeN(in_pixels);
-    }
   }
   else {
-    /* Byte. */
-    unsigned char *in_pixels = image_get_pixels_for_frame(b_image, frame, tile_number);
-
-    if (in_pixels && num_pixels * channels == out_pixels_size) {
-      /* Straight copy pixel data. */
-      memcpy(out_pixels, in_pixels, out_pixels_size * sizeof(unsigned char));
+    /* Byte, straight copy pixel data. */
+    const bool found = num_pixels * channels == out_pixels_size &&
+                       image_get_pixels_for_frame(
+                           b_image, frame, tile_number, (uchar *)out_pixels, out_pixels_size);
 
+    if (found) {
       if (associate_alpha && channels == 4) {
         /* Premultiply, byte images are always straight for Blender. */
         unsigned char *out_pixel = (unsigned char *)out_pixels;
@@ -217,10 +209,6 @@ bool BlenderImageLoader::load_pixels(const ImageMetaData &metadata,
         }
       }
     }
-
-    if (in_pixels) {
-      MEM_freeN(in_pixels);
-    }
   }
 
   /* Free image buffers to save memory during render. */
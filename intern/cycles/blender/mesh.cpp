@@ -25,6 +25,7 @@
 #include "util/hash.h"
 #include "util/log.h"
 #include "util/math.h"
+#include "util/tbb.h"
 
 #include "mikktspace.hh"
 
@@ -813,6 +814,19 @@ static void attr_create_random_per_island(Scene *scene,
 
 /* Create Mesh */
 
+/* Convert mesh data in parallel, with a grain size big enough to avoid threading overhead on
+ * small meshes. */
+template<typename Func> static void mesh_parallel_for(const size_t size, const Func &func)
+{
+  static const size_t ELEMENTS_PER_TASK = 4096;
+  parallel_for(blocked_range<size_t>(0, size, ELEMENTS_PER_TASK),
+               [&](const blocked_range<size_t> &r) {
+                 for (size_t i = r.begin(); i != r.end(); i++) {
+                   func(i);
+                 }
+               });
+}
+
 static void create_mesh(Scene *scene,
                         Mesh *mesh,
                         const ::Mesh &b_mesh,
@@ -865,9 +879,9 @@ static void create_mesh(Scene *scene,
   mesh->resize_mesh(positions.size(), numtris);
 
   float3 *verts = mesh->get_verts().data();
-  for (const int i : positions.index_range()) {
+  mesh_parallel_for(positions.size(), [&](const size_t i) {
     verts[i] = make_float3(positions[i][0], positions[i][1], positions[i][2]);
-  }
+  });
 
   AttributeSet &attributes = (subdivision) ? mesh->subd_attributes : mesh->attributes;
   Attribute *attr_N = attributes.add(ATTR_STD_VERTEX_NORMAL);
@@ -875,9 +889,9 @@ static void create_mesh(Scene *scene,
 
   if (subdivision || !(use_corner_normals && !corner_normals.is_empty())) {
     const blender::Span<blender::float3> vert_normals = b_mesh.vert_normals();
-    for (const int i : vert_normals.index_range()) {
+    mesh_parallel_for(vert_normals.size(), [&](const size_t i) {
       N[i] = make_float3(vert_normals[i][0], vert_normals[i][1], vert_normals[i][2]);
-    }
+    });
   }
 
   const set<ustring> blender_uv_names = get_blender_uv_names(b_mesh);
@@ -901,7 +915,7 @@ static void create_mesh(Scene *scene,
 
     float3 *generated = attr->data_float3();
 
-    for (const int i : positions.index_range()) {
+    mesh_parallel_for(positions.size(), [&](const size_t i) {
       blender::float3 value;
       if (orco) {
         madd_v3_v3v3v3(value, texspace_location, orco[i], texspace_size);
@@ -910,7 +924,7 @@ static void create_mesh(Scene *scene,
         value = positions[i];
       }
       generated[i] = make_float3(value[0], value[1], value[2]) * size - loc;
-    }
+    });
   }
 
   auto clamp_material_index = [&](const int material_index) -> int {
@@ -924,18 +938,18 @@ static void create_mesh(Scene *scene,
     int *shader = mesh->get_shader().data();
 
     const blender::Span<blender::int3> corner_tris = b_mesh.corner_tris();
-    for (const int i : corner_tris.index_range()) {
+    mesh_parallel_for(corner_tris.size(), [&](const size_t i) {
       const blender::int3 &tri = corner_tris[i];
       triangles[i * 3 + 0] = corner_verts[tri[0]];
       triangles[i * 3 + 1] = corner_verts[tri[1]];
       triangles[i * 3 + 2] = corner_verts[tri[2]];
-    }
+    });
 
     if (!material_indices.is_empty()) {
       const blender::Span<int> tri_faces = b_mesh.corner_tri_faces();
-      for (const int i : corner_tris.index_range()) {
+      mesh_parallel_for(corner_tris.size(), [&](const size_t i) {
         shader[i] = clamp_material_index(material_indices[tri_faces[i]]);
-      }
+      });
     }
     else {
       std::fill(shader, shader + numtris, 0);
@@ -943,9 +957,8 @@ static void create_mesh(Scene *scene,
 
     if (!sharp_faces.is_empty() && !(use_corner_normals && !corner_normals.is_empty())) {
       const blender::Span<int> tri_faces = b_mesh.corner_tri_faces();
-      for (const int i : corner_tris.index_range()) {
-        smooth[i] = !sharp_faces[tri_faces[i]];
-      }
+      mesh_parallel_for(corner_tris.size(),
+                        [&](const size_t i) { smooth[i] = !sharp_faces[tri_faces[i]]; });
     }
     else {
       /* If only face normals are needed, all faces are sharp. */
@@ -405,8 +405,15 @@ static float4 lookup_instance_property(BL::DepsgraphObjectInstance &b_instance,
 
 bool BlenderSync::sync_object_attributes(BL::DepsgraphObjectInstance &b_instance, Object *object)
 {
-  /* Find which attributes are needed. */
-  AttributeRequestSet requests = object->get_geometry()->needed_attributes();
+  /* Find which attributes are needed. This is the same for every instance of the geometry, as
+   * long as its shaders don't change. */
+  Geometry *geom = object->get_geometry();
+  GeometryAttributeRequests &cached_requests = geometry_attribute_requests[geom];
+  if (cached_requests.used_shaders != geom->get_used_shaders()) {
+    cached_requests.used_shaders = geom->get_used_shaders();
+    cached_requests.requests = geom->needed_attributes();
+  }
+  AttributeRequestSet &requests = cached_requests.requests;
 
   /* Delete attributes that became unnecessary. */
   vector<ParamValue> &attributes = object->attributes;
@@ -562,6 +569,7 @@ void BlenderSync::sync_objects(BL::Depsgraph &b_depsgraph,
     geometry_motion_synced.clear();
   }
   instance_geometries_by_object.clear();
+  geometry_attribute_requests.clear();
 
   /* initialize culling */
   BlenderObjectCulling culling(scene, b_scene);
@@ -661,6 +669,16 @@ void BlenderSync::sync_objects(BL::Depsgraph &b_depsgraph,
     geometry_map.post_sync();
     particle_system_map.post_sync();
     procedural_map.post_sync();
+
+    /* Forget the data arrays of deleted geometry. */
+    for (auto it = geometry_shared_data.begin(); it != geometry_shared_data.end();) {
+      if (geometry_map.key_to_scene_data().count(it->first)) {
+        ++it;
+      }
+      else {
+        it = geometry_shared_data.erase(it);
+      }
+    }
   }
 
   if (motion)
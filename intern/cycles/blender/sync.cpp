@@ -31,6 +31,8 @@
 #include "util/log.h"
 #include "util/openimagedenoise.h"
 
+#include "BLI_trace.hh"
+
 CCL_NAMESPACE_BEGIN
 
 static const char *cryptomatte_prefix = "Crypto";
@@ -265,6 +267,7 @@ void BlenderSync::sync_data(BL::RenderSettings &b_render,
     return;
   }
 
+  TRACE_SCOPE("Cycles::sync_data");
   scoped_timer timer;
 
   BL::ViewLayer b_view_layer = b_depsgraph.view_layer_eval();
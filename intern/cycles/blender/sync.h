@@ -15,6 +15,7 @@
 #include "blender/util.h"
 #include "blender/viewport.h"
 
+#include "scene/attribute.h"
 #include "scene/scene.h"
 #include "session/session.h"
 
@@ -233,10 +234,18 @@ class BlenderSync {
   id_map<ObjectKey, Light> light_map;
   id_map<ParticleSystemKey, ParticleSystem> particle_system_map;
   set<Geometry *> geometry_synced;
+  /** Data arrays of geometry keyed by its positions array, see #sync_geometry. */
+  map<GeometryKey, vector<const void *>> geometry_shared_data;
   set<Geometry *> geometry_motion_synced;
   set<Geometry *> geometry_motion_attribute_synced;
   /** Remember which geometries come from which objects to be able to sync them after changes. */
   map<void *, set<BL::ID>> instance_geometries_by_object;
+  /** Attributes needed by each geometry's shaders, to avoid gathering them for every instance. */
+  struct GeometryAttributeRequests {
+    array<Node *> used_shaders;
+    AttributeRequestSet requests;
+  };
+  map<Geometry *, GeometryAttributeRequests> geometry_attribute_requests;
   set<float> motion_times;
   void *world_map;
   bool world_recalc;
@@ -30,8 +30,10 @@ void BKE_image_user_file_path_ex(void *bmain,
                                  char *filepath,
                                  bool resolve_udim,
                                  bool resolve_multiview);
-unsigned char *BKE_image_get_pixels_for_frame(void *image, int frame, int tile);
-float *BKE_image_get_float_pixels_for_frame(void *image, int frame, int tile);
+bool BKE_image_get_pixels_for_frame(
+    void *image, int frame, int tile, unsigned char *r_pixels, size_t pixels_num);
+bool BKE_image_get_float_pixels_for_frame(
+    void *image, int frame, int tile, float *r_pixels, size_t pixels_num);
 }
 
 CCL_NAMESPACE_BEGIN
@@ -316,14 +318,16 @@ static inline int image_user_frame_number(BL::ImageUser &iuser, BL::Image &ima,
   return iuser.frame_current();
 }
 
-static inline unsigned char *image_get_pixels_for_frame(BL::Image &image, int frame, int tile)
+static inline bool image_get_pixels_for_frame(
+    BL::Image &image, int frame, int tile, unsigned char *r_pixels, size_t pixels_num)
 {
-  return BKE_image_get_pixels_for_frame(image.ptr.data, frame, tile);
+  return BKE_image_get_pixels_for_frame(image.ptr.data, frame, tile, r_pixels, pixels_num);
 }
 
-static inline float *image_get_float_pixels_for_frame(BL::Image &image, int frame, int tile)
+static inline bool image_get_float_pixels_for_frame(
+    BL::Image &image, int frame, int tile, float *r_pixels, size_t pixels_num)
 {
-  return BKE_image_get_float_pixels_for_frame(image.ptr.data, frame, tile);
+  return BKE_image_get_float_pixels_for_frame(image.ptr.data, frame, tile, r_pixels, pixels_num);
 }
 
 static inline void render_add_metadata(BL::RenderResult &b_rr, string name, string value)
@@ -174,10 +174,111 @@ void BVHEmbree::build(Progress &progress,
     return;
   }
 
+  object_states.clear();
+  if (params.top_level) {
+    object_states.reserve(objects.size());
+    for (size_t j = 0; j < objects.size(); ++j) {
+      object_states.push_back(get_object_state(objects[j], j));
+    }
+  }
+
   rtcSetSceneProgressMonitorFunction(scene, rtc_progress_func, &progress);
   rtcCommitScene(scene);
 }
 
+bool BVHEmbree::ObjectState::operator==(const ObjectState &other) const
+{
+  return geometry == other.geometry && instance_scene == other.instance_scene &&
+         tfm == other.tfm && motion == other.motion && visibility == other.visibility &&
+         prim_offset == other.prim_offset && rtc_geom_id == other.rtc_geom_id;
+}
+
+BVHEmbree::ObjectState BVHEmbree::get_object_state(const Object *ob, int i) const
+{
+  ObjectState state;
+  if (!ob->is_traceable()) {
+    return state;
+  }
+
+  const Geometry *geom = ob->get_geometry();
+  state.geometry = geom;
+  state.visibility = ob->visibility_for_tracing();
+
+  if (geom->is_instanced()) {
+    state.instance_scene = static_cast<const BVHEmbree *>(geom->bvh)->scene;
+    state.tfm = ob->get_tfm();
+    state.motion = ob->get_motion();
+    state.rtc_geom_id = i * 2;
+  }
+  else if (geom->geometry_type == Geometry::MESH || geom->geometry_type == Geometry::VOLUME) {
+    const Mesh *mesh = static_cast<const Mesh *>(geom);
+    state.prim_offset = mesh->prim_offset;
+    state.rtc_geom_id = (mesh->num_triangles() > 0) ? i * 2 : -1;
+  }
+  else if (geom->geometry_type == Geometry::HAIR) {
+    const Hair *hair = static_cast<const Hair *>(geom);
+    state.prim_offset = hair->curve_segment_offset;
+    state.rtc_geom_id = (hair->num_curves() > 0) ? i * 2 + 1 : -1;
+  }
+  else if (geom->geometry_type == Geometry::POINTCLOUD) {
+    const PointCloud *pointcloud = static_cast<const PointCloud *>(geom);
+    state.prim_offset = pointcloud->prim_offset;
+    state.rtc_geom_id = (pointcloud->num_points() > 0) ? i * 2 : -1;
+  }
+
+  return state;
+}
+
+bool BVHEmbree::refit_top_level(Progress &progress)
+{
+  if (object_states.size() != objects.size()) {
+    return false;
+  }
+
+  /* Find objects whose transform or visibility changed, or whose geometry was modified. Both
+   * non-instanced geometry stored directly in the top level scene and instances of a refitted
+   * geometry BVH have to be re-added for their bounds to be updated. */
+  vector<std::pair<int, ObjectState>> changed;
+  for (size_t i = 0; i < objects.size(); ++i) {
+    ObjectState state = get_object_state(objects[i], i);
+    const bool geometry_modified = state.geometry && state.geometry->is_modified();
+    if (geometry_modified || !(state == object_states[i])) {
+      changed.emplace_back(i, std::move(state));
+    }
+  }
+
+  /* Detaching and re-adding most of the objects is slower than building the scene from scratch,
+   * and a full build also lets Embree choose a better top level hierarchy. */
+  if (changed.size() * 2 > objects.size()) {
+    return false;
+  }
+
+  progress.set_substatus(string_printf("Updating %d of %d BVH instances",
+                                       (int)changed.size(),
+                                       (int)objects.size()));
+
+  for (auto &[i, state] : changed) {
+    if (object_states[i].rtc_geom_id != -1) {
+      rtcDetachGeometry(scene, object_states[i].rtc_geom_id);
+    }
+
+    Object *ob = objects[i];
+    if (state.instance_scene) {
+      add_instance(ob, i);
+    }
+    else if (state.geometry) {
+      add_object(ob, i);
+    }
+
+    object_states[i] = std::move(state);
+  }
+
+  rtcSetSceneProgressMonitorFunction(scene, rtc_progress_func, &progress);
+  rtcCommitScene(scene);
+
+  return true;
+}
+
 void BVHEmbree::add_object(Object *ob, int i)
 {
   Geometry *geom = ob->get_geometry();
@@ -635,47 +736,51 @@ void BVHEmbree::add_curves(const Object *ob, const Hair *hair, int i)
   rtcReleaseGeometry(geom_id);
 }
 
-void BVHEmbree::refit(Progress &progress)
+bool BVHEmbree::refit(Progress &progress)
 {
+  if (params.top_level) {
+    return refit_top_level(progress);
+  }
+
   progress.set_substatus("Refitting BVH nodes");
 
   /* Update all vertex buffers, then tell Embree to rebuild/-fit the BVHs. */
   unsigned geom_id = 0;
   foreach (Object *ob, objects) {
-    if (!params.top_level || (ob->is_traceable() && !ob->get_geometry()->is_instanced())) {
-      Geometry *geom = ob->get_geometry();
-
-      if (geom->geometry_type == Geometry::MESH || geom->geometry_type == Geometry::VOLUME) {
-        Mesh *mesh = static_cast<Mesh *>(geom);
-        if (mesh->num_triangles() > 0) {
-          RTCGeometry geom = rtcGetGeometry(scene, geom_id);
-          set_tri_vertex_buffer(geom, mesh, true);
-          rtcSetGeometryUserData(geom, (void *)mesh->prim_offset);
-          rtcCommitGeometry(geom);
-        }
+    Geometry *geom = ob->get_geometry();
+
+    if (geom->geometry_type == Geometry::MESH || geom->geometry_type == Geometry::VOLUME) {
+      Mesh *mesh = static_cast<Mesh *>(geom);
+      if (mesh->num_triangles() > 0) {
+        RTCGeometry geom = rtcGetGeometry(scene, geom_id);
+        set_tri_vertex_buffer(geom, mesh, true);
+        rtcSetGeometryUserData(geom, (void *)mesh->prim_offset);
+        rtcCommitGeometry(geom);
       }
-      else if (geom->geometry_type == Geometry::HAIR) {
-        Hair *hair = static_cast<Hair *>(geom);
-        if (hair->num_curves() > 0) {
-          RTCGeometry geom = rtcGetGeometry(scene, geom_id + 1);
-          set_curve_vertex_buffer(geom, hair, true);
-          rtcSetGeometryUserData(geom, (void *)hair->curve_segment_offset);
-          rtcCommitGeometry(geom);
-        }
+    }
+    else if (geom->geometry_type == Geometry::HAIR) {
+      Hair *hair = static_cast<Hair *>(geom);
+      if (hair->num_curves() > 0) {
+        RTCGeometry geom = rtcGetGeometry(scene, geom_id + 1);
+        set_curve_vertex_buffer(geom, hair, true);
+        rtcSetGeometryUserData(geom, (void *)hair->curve_segment_offset);
+        rtcCommitGeometry(geom);
       }
-      else if (geom->geometry_type == Geometry::POINTCLOUD) {
-        PointCloud *pointcloud = static_cast<PointCloud *>(geom);
-        if (pointcloud->num_points() > 0) {
-          RTCGeometry geom = rtcGetGeometry(scene, geom_id);
-          set_point_vertex_buffer(geom, pointcloud, true);
-          rtcCommitGeometry(geom);
-        }
+    }
+    else if (geom->geometry_type == Geometry::POINTCLOUD) {
+      PointCloud *pointcloud = static_cast<PointCloud *>(geom);
+      if (pointcloud->num_points() > 0) {
+        RTCGeometry geom = rtcGetGeometry(scene, geom_id);
+        set_point_vertex_buffer(geom, pointcloud, true);
+        rtcCommitGeometry(geom);
       }
     }
     geom_id += 2;
   }
 
   rtcCommitScene(scene);
+
+  return true;
 }
 
 CCL_NAMESPACE_END
@@ -18,7 +18,9 @@
 #  include "bvh/bvh.h"
 #  include "bvh/params.h"
 
+#  include "util/array.h"
 #  include "util/thread.h"
+#  include "util/transform.h"
 #  include "util/types.h"
 #  include "util/vector.h"
 
@@ -34,7 +36,9 @@ class BVHEmbree : public BVH {
              Stats *stats,
              RTCDevice rtc_device,
              const bool isSyclEmbreeDevice = false);
-  void refit(Progress &progress);
+  /* Returns false when a full build is preferable over refitting, in which case the BVH is left
+   * unchanged. */
+  bool refit(Progress &progress);
 
   RTCScene scene;
 
@@ -52,6 +56,24 @@ class BVHEmbree : public BVH {
   void add_triangles(const Object *ob, const Mesh *mesh, int i);
 
  private:
+  /* State of an object at the time it was added to the top level scene, used to detect which
+   * objects have to be re-added when refitting. */
+  struct ObjectState {
+    const Geometry *geometry = nullptr;
+    RTCScene instance_scene = nullptr;
+    Transform tfm = transform_identity();
+    array<Transform> motion;
+    uint visibility = 0;
+    size_t prim_offset = 0;
+    /* Embree geometry ID the object is attached with, -1 when nothing is attached. */
+    int rtc_geom_id = -1;
+
+    bool operator==(const ObjectState &other) const;
+  };
+
+  ObjectState get_object_state(const Object *ob, int i) const;
+  bool refit_top_level(Progress &progress);
+
   void set_tri_vertex_buffer(RTCGeometry geom_id, const Mesh *mesh, const bool update);
   void set_curve_vertex_buffer(RTCGeometry geom_id, const Hair *hair, const bool update);
   void set_point_vertex_buffer(RTCGeometry geom_id,
@@ -61,6 +83,7 @@ class BVHEmbree : public BVH {
   RTCDevice rtc_device;
   bool rtc_device_is_sycl;
   enum RTCBuildQuality build_quality;
+  vector<ObjectState> object_states;
 };
 
 CCL_NAMESPACE_END
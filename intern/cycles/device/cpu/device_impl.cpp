@@ -271,10 +271,7 @@ void CPUDevice::build_bvh(BVH *bvh, Progress &progress, bool refit)
       bvh->params.bvh_layout == BVH_LAYOUT_MULTI_EMBREEGPU_EMBREE)
   {
     BVHEmbree *const bvh_embree = static_cast<BVHEmbree *>(bvh);
-    if (refit) {
-      bvh_embree->refit(progress);
-    }
-    else {
+    if (!refit || !bvh_embree->refit(progress)) {
       bvh_embree->build(progress, &stats, embree_device);
     }
 
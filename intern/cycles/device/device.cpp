@@ -687,6 +687,7 @@ GPUDevice::Mem *GPUDevice::generic_alloc(device_memory &mem, size_t pitch_paddin
     if (mem_alloc_result) {
       transform_host_pointer(device_pointer, shared_pointer);
       map_host_used += size;
+      stats.mem_alloc_mapped_host(size);
       status = " in host memory";
     }
   }
@@ -774,6 +775,7 @@ void GPUDevice::generic_free(device_memory &mem)
         }
       }
       map_host_used -= mem.device_size;
+      stats.mem_free_mapped_host(mem.device_size);
     }
     else {
       /* Free device memory. */
@@ -153,10 +153,7 @@ void OneapiDevice::build_bvh(BVH *bvh, Progress &progress, bool refit)
 {
   if (embree_device && bvh->params.bvh_layout == BVH_LAYOUT_EMBREEGPU) {
     BVHEmbree *const bvh_embree = static_cast<BVHEmbree *>(bvh);
-    if (refit) {
-      bvh_embree->refit(progress);
-    }
-    else {
+    if (!refit || !bvh_embree->refit(progress)) {
       bvh_embree->build(progress, &stats, embree_device, true);
     }
     if (bvh->params.top_level) {
@@ -6,8 +6,11 @@
 
 #include "util/algorithm.h"
 #include "util/log.h"
+#include "util/path.h"
+#include "util/string.h"
 #include "util/time.h"
 
+#include <atomic>
 #include <iomanip>
 
 CCL_NAMESPACE_BEGIN
@@ -16,14 +19,27 @@ DeviceQueue::DeviceQueue(Device *device)
     : device(device),
       last_kernels_enqueued_(0),
       last_sync_time_(0.0),
-      is_per_kernel_performance_(false)
+      is_per_kernel_performance_(false),
+      trace_start_time_(0.0)
 {
   DCHECK_NE(device, nullptr);
   is_per_kernel_performance_ = getenv("CYCLES_DEBUG_PER_KERNEL_PERFORMANCE");
+
+  const char *trace_filepath_prefix = getenv("CYCLES_DEBUG_KERNEL_TRACE");
+  if (trace_filepath_prefix && trace_filepath_prefix[0]) {
+    /* Every queue writes its own file, as there might be multiple devices. */
+    static std::atomic<int> trace_queue_index = 0;
+    trace_filepath_ = string_printf("%s_%d.json", trace_filepath_prefix, trace_queue_index++);
+    trace_start_time_ = time_dt();
+  }
 }
 
 DeviceQueue::~DeviceQueue()
 {
+  if (is_tracing()) {
+    write_trace();
+  }
+
   if (VLOG_DEVICE_STATS_IS_ON) {
     /* Print kernel execution times sorted by time. */
     vector<pair<DeviceKernelMask, double>> stats_sorted;
@@ -53,9 +69,35 @@ DeviceQueue::~DeviceQueue()
   }
 }
 
+void DeviceQueue::write_trace() const
+{
+  FILE *file = path_fopen(trace_filepath_, "w");
+  if (!file) {
+    LOG(ERROR) << "Failed to open kernel trace file " << trace_filepath_;
+    return;
+  }
+
+  /* Times are in microseconds, relative to the queue creation. */
+  fprintf(file, "{\"traceEvents\": [\n");
+  for (size_t i = 0; i < trace_events_.size(); i++) {
+    const TraceEvent &event = trace_events_[i];
+    fprintf(file,
+            "  {\"name\": \"%s\", \"cat\": \"kernel\", \"ph\": \"X\", \"ts\": %.3f, "
+            "\"dur\": %.3f, \"pid\": 0, \"tid\": 0}%s\n",
+            device_kernel_mask_as_string(event.kernels).c_str(),
+            (event.start_time - trace_start_time_) * 1e6,
+            event.elapsed_time * 1e6,
+            (i + 1 < trace_events_.size()) ? "," : "");
+  }
+  fprintf(file, "]}\n");
+  fclose(file);
+
+  VLOG_INFO << "Written kernel trace to " << trace_filepath_;
+}
+
 void DeviceQueue::debug_init_execution()
 {
-  if (VLOG_DEVICE_STATS_IS_ON) {
+  if (VLOG_DEVICE_STATS_IS_ON || is_tracing()) {
     last_sync_time_ = time_dt();
   }
 
@@ -74,14 +116,15 @@ void DeviceQueue::debug_enqueue_begin(DeviceKernel kernel, const int work_size)
 
 void DeviceQueue::debug_enqueue_end()
 {
-  if (VLOG_DEVICE_STATS_IS_ON && is_per_kernel_performance_) {
+  /* Tracing synchronizes after every kernel, so that each kernel gets its own event. */
+  if ((VLOG_DEVICE_STATS_IS_ON && is_per_kernel_performance_) || is_tracing()) {
     synchronize();
   }
 }
 
 void DeviceQueue::debug_synchronize()
 {
-  if (VLOG_DEVICE_STATS_IS_ON) {
+  if (VLOG_DEVICE_STATS_IS_ON || is_tracing()) {
     const double new_time = time_dt();
     const double elapsed_time = new_time - last_sync_time_;
     VLOG_DEVICE_STATS << "GPU queue synchronize, elapsed " << std::setw(10) << elapsed_time << "s";
@@ -90,6 +133,10 @@ void DeviceQueue::debug_synchronize()
      * container without related kernel information. */
     if (last_kernels_enqueued_ != 0) {
       stats_kernel_time_[last_kernels_enqueued_] += elapsed_time;
+
+      if (is_tracing()) {
+        trace_events_.push_back({last_kernels_enqueued_, last_sync_time_, elapsed_time});
+      }
     }
 
     last_sync_time_ = new_time;
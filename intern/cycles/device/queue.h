@@ -12,6 +12,7 @@
 #include "util/map.h"
 #include "util/string.h"
 #include "util/unique_ptr.h"
+#include "util/vector.h"
 
 CCL_NAMESPACE_BEGIN
 
@@ -182,6 +183,24 @@ class DeviceQueue {
   /* If it is true, then a performance statistics in the debugging logs will have focus on kernels
    * and an explicit queue synchronization will be added after each kernel execution. */
   bool is_per_kernel_performance_;
+
+  /* Kernel executions recorded for the trace file, when enabled. */
+  struct TraceEvent {
+    DeviceKernelMask kernels;
+    double start_time;
+    double elapsed_time;
+  };
+  /* File to write a trace of the kernel executions to, in the Chrome trace event format.
+   * Set from the `CYCLES_DEBUG_KERNEL_TRACE` environment variable, empty if disabled. */
+  string trace_filepath_;
+  vector<TraceEvent> trace_events_;
+  double trace_start_time_;
+
+  bool is_tracing() const
+  {
+    return !trace_filepath_.empty();
+  }
+  void write_trace() const;
 };
 
 CCL_NAMESPACE_END
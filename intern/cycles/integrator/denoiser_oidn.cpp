@@ -12,6 +12,7 @@
 #include "session/buffers.h"
 #include "util/array.h"
 #include "util/log.h"
+#include "util/map.h"
 #include "util/openimagedenoise.h"
 
 #include "kernel/device/cpu/compat.h"
@@ -21,12 +22,69 @@ CCL_NAMESPACE_BEGIN
 
 thread_mutex OIDNDenoiser::mutex_;
 
+#ifdef WITH_OPENIMAGEDENOISE
+/* Creating an OpenImageDenoise device and committing a filter is expensive compared to denoising
+ * small images or denoising an animation frame by frame, so they are kept between calls. Filters
+ * are created again when settings they depend on change. */
+class OIDNDenoiser::State {
+ public:
+  oidn::DeviceRef oidn_device;
+  map<string, oidn::FilterRef> oidn_filters;
+
+  /* Settings the filters were created for. */
+  int width = 0;
+  int height = 0;
+  bool use_pass_albedo = false;
+  bool use_pass_normal = false;
+  DenoiserPrefilter prefilter = DENOISER_PREFILTER_NONE;
+  DenoiserQuality quality = DENOISER_QUALITY_HIGH;
+
+  void ensure(const DenoiseParams &params, const BufferParams &buffer_params)
+  {
+    if (!oidn_device) {
+      oidn_device = oidn::newDevice(oidn::DeviceType::CPU);
+      oidn_device.set("setAffinity", false);
+      oidn_device.commit();
+    }
+
+    if (width != buffer_params.width || height != buffer_params.height ||
+        use_pass_albedo != params.use_pass_albedo || use_pass_normal != params.use_pass_normal ||
+        prefilter != params.prefilter || quality != params.quality)
+    {
+      oidn_filters.clear();
+      width = buffer_params.width;
+      height = buffer_params.height;
+      use_pass_albedo = params.use_pass_albedo;
+      use_pass_normal = params.use_pass_normal;
+      prefilter = params.prefilter;
+      quality = params.quality;
+    }
+  }
+
+  /* Get the filter for the given purpose, r_created is set when it is new and its parameters
+   * need to be set. */
+  oidn::FilterRef &get_filter(const string &key, bool &r_created)
+  {
+    auto it = oidn_filters.find(key);
+    r_created = (it == oidn_filters.end());
+    if (r_created) {
+      it = oidn_filters.insert(std::make_pair(key, oidn_device.newFilter("RT"))).first;
+    }
+    return it->second;
+  }
+};
+#else
+class OIDNDenoiser::State {};
+#endif
+
 OIDNDenoiser::OIDNDenoiser(Device *path_trace_device, const DenoiseParams &params)
     : Denoiser(path_trace_device, params)
 {
   DCHECK_EQ(params.type, DENOISER_OPENIMAGEDENOISE);
 }
 
+OIDNDenoiser::~OIDNDenoiser() {}
+
 #ifdef WITH_OPENIMAGEDENOISE
 static bool oidn_progress_monitor_function(void *user_ptr, double /*n*/)
 {
@@ -91,12 +149,14 @@ class OIDNPass {
 class OIDNDenoiseContext {
  public:
   OIDNDenoiseContext(OIDNDenoiser *denoiser,
+                     OIDNDenoiser::State &state,
                      const DenoiseParams &denoise_params,
                      const BufferParams &buffer_params,
                      RenderBuffers *render_buffers,
                      const int num_samples,
                      const bool allow_inplace_modification)
       : denoiser_(denoiser),
+        state_(state),
         denoise_params_(denoise_params),
         buffer_params_(buffer_params),
         render_buffers_(render_buffers),
@@ -151,47 +211,48 @@ class OIDNDenoiseContext {
 
     OIDNPass oidn_color_access_pass = read_input_pass(oidn_color_pass, oidn_output_pass);
 
-    oidn::DeviceRef oidn_device = oidn::newDevice(oidn::DeviceType::CPU);
-    oidn_device.set("setAffinity", false);
-    oidn_device.commit();
-
     /* Create a filter for denoising a beauty (color) image using prefiltered auxiliary images too.
-     */
-    oidn::FilterRef oidn_filter = oidn_device.newFilter("RT");
+     * The set of images only depends on the pass type and the settings the filter was created
+     * for, so setting them again replaces all images of a reused filter. */
+    bool created;
+    oidn::FilterRef &oidn_filter = state_.get_filter(
+        string("color_") + pass_type_as_string(pass_type), created);
     set_input_pass(oidn_filter, oidn_color_access_pass);
     set_guiding_passes(oidn_filter, oidn_color_pass);
     set_output_pass(oidn_filter, oidn_output_pass);
-    oidn_filter.setProgressMonitorFunction(oidn_progress_monitor_function, denoiser_);
-    oidn_filter.set("hdr", true);
-    oidn_filter.set("srgb", false);
+    if (created) {
+      oidn_filter.setProgressMonitorFunction(oidn_progress_monitor_function, denoiser_);
+      oidn_filter.set("hdr", true);
+      oidn_filter.set("srgb", false);
 
 #  if OIDN_VERSION_MAJOR >= 2
-    switch (denoise_params_.quality) {
-      case DENOISER_QUALITY_BALANCED:
-        oidn_filter.set("quality", OIDN_QUALITY_BALANCED);
-        break;
-      case DENOISER_QUALITY_HIGH:
-      default:
-        oidn_filter.set("quality", OIDN_QUALITY_HIGH);
-    }
+      switch (denoise_params_.quality) {
+        case DENOISER_QUALITY_BALANCED:
+          oidn_filter.set("quality", OIDN_QUALITY_BALANCED);
+          break;
+        case DENOISER_QUALITY_HIGH:
+        default:
+          oidn_filter.set("quality", OIDN_QUALITY_HIGH);
+      }
 #  endif
 
-    if (denoise_params_.prefilter == DENOISER_PREFILTER_NONE ||
-        denoise_params_.prefilter == DENOISER_PREFILTER_ACCURATE)
-    {
-      oidn_filter.set("cleanAux", true);
+      if (denoise_params_.prefilter == DENOISER_PREFILTER_NONE ||
+          denoise_params_.prefilter == DENOISER_PREFILTER_ACCURATE)
+      {
+        oidn_filter.set("cleanAux", true);
+      }
     }
     oidn_filter.commit();
 
-    filter_guiding_pass_if_needed(oidn_device, oidn_albedo_pass_);
-    filter_guiding_pass_if_needed(oidn_device, oidn_normal_pass_);
+    filter_guiding_pass_if_needed(oidn_albedo_pass_);
+    filter_guiding_pass_if_needed(oidn_normal_pass_);
 
     /* Filter the beauty image. */
     oidn_filter.execute();
 
     /* Check for errors. */
     const char *error_message;
-    const oidn::Error error = oidn_device.getError(error_message);
+    const oidn::Error error = state_.oidn_device.getError(error_message);
     if (error != oidn::Error::None && error != oidn::Error::Cancelled) {
       denoiser_->set_error("OpenImageDenoise error: " + string(error_message));
     }
@@ -200,7 +261,7 @@ class OIDNDenoiseContext {
   }
 
  protected:
-  void filter_guiding_pass_if_needed(oidn::DeviceRef &oidn_device, OIDNPass &oidn_pass)
+  void filter_guiding_pass_if_needed(OIDNPass &oidn_pass)
   {
     if (denoise_params_.prefilter != DENOISER_PREFILTER_ACCURATE || !oidn_pass ||
         oidn_pass.is_filtered)
@@ -208,7 +269,8 @@ class OIDNDenoiseContext {
       return;
     }
 
-    oidn::FilterRef oidn_filter = oidn_device.newFilter("RT");
+    bool created;
+    oidn::FilterRef &oidn_filter = state_.get_filter(oidn_pass.name, created);
     set_pass(oidn_filter, oidn_pass);
     set_output_pass(oidn_filter, oidn_pass);
     oidn_filter.commit();
@@ -528,6 +590,7 @@ class OIDNDenoiseContext {
   }
 
   OIDNDenoiser *denoiser_ = nullptr;
+  OIDNDenoiser::State &state_;
 
   const DenoiseParams &denoise_params_;
   const BufferParams &buffer_params_;
@@ -596,8 +659,18 @@ bool OIDNDenoiser::denoise_buffer(const BufferParams &buffer_params,
   unique_ptr<DeviceQueue> queue = create_device_queue(render_buffers);
   copy_render_buffers_from_device(queue, render_buffers);
 
-  OIDNDenoiseContext context(
-      this, params_, buffer_params, render_buffers, num_samples, allow_inplace_modification);
+  if (!state_) {
+    state_ = make_unique<State>();
+  }
+  state_->ensure(params_, buffer_params);
+
+  OIDNDenoiseContext context(this,
+                             *state_,
+                             params_,
+                             buffer_params,
+                             render_buffers,
+                             num_samples,
+                             allow_inplace_modification);
 
   if (context.need_denoising()) {
     context.read_guiding_passes();
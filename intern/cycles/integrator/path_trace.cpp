@@ -1279,11 +1279,14 @@ string PathTrace::full_report() const
   return result;
 }
 
-void PathTrace::set_guiding_params(const GuidingParams &guiding_params, const bool reset)
+void PathTrace::set_guiding_params(const GuidingParams &guiding_params,
+                                   const bool reset,
+                                   const bool retrain)
 {
 #ifdef WITH_PATH_GUIDING
   if (guiding_params_.modified(guiding_params)) {
     guiding_params_ = guiding_params;
+    guiding_training_start_iteration_ = 0;
 
 #  if !(OPENPGL_VERSION_MAJOR == 0 && OPENPGL_VERSION_MINOR <= 5)
 #    define OPENPGL_USE_FIELD_CONFIG
@@ -1372,10 +1375,17 @@ void PathTrace::set_guiding_params(const GuidingParams &guiding_params, const bo
     if (guiding_field_) {
       guiding_field_->Reset();
     }
+    guiding_training_start_iteration_ = 0;
+  }
+  else if (retrain) {
+    if (guiding_field_) {
+      guiding_training_start_iteration_ = guiding_field_->GetIteration();
+    }
   }
 #else
   (void)guiding_params;
   (void)reset;
+  (void)retrain;
 #endif
 }
 
@@ -1383,7 +1393,8 @@ void PathTrace::guiding_prepare_structures()
 {
 #ifdef WITH_PATH_GUIDING
   const bool train = (guiding_params_.training_samples == 0) ||
-                     (guiding_field_->GetIteration() < guiding_params_.training_samples);
+                     (guiding_field_->GetIteration() - guiding_training_start_iteration_ <
+                      guiding_params_.training_samples);
 
   for (auto &&path_trace_work : path_trace_works_) {
     path_trace_work->guiding_init_kernel_globals(
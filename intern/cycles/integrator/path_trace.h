@@ -95,8 +95,11 @@ class PathTrace {
   void set_adaptive_sampling(const AdaptiveSampling &adaptive_sampling);
 
   /* Set the parameters for guiding.
-   * Use to setup the guiding structures before each rendering iteration. */
-  void set_guiding_params(const GuidingParams &params, const bool reset);
+   * Use to setup the guiding structures before each rendering iteration.
+   *
+   * When reset is true the guiding field is trained from scratch. When only retrain is true the
+   * field is kept, and training continues from it for another round of training samples. */
+  void set_guiding_params(const GuidingParams &params, const bool reset, const bool retrain);
 
   /* Sets output driver for render buffer output. */
   void set_output_driver(unique_ptr<OutputDriver> driver);
@@ -297,6 +300,9 @@ class PathTrace {
 
   /* The number of already performed training iterations for the guiding field. */
   int guiding_update_count = 0;
+
+  /* Iteration of the guiding field at which the current round of training started. */
+  int guiding_training_start_iteration_ = 0;
 #endif
 
   /* State which is common for all the steps of the render work.
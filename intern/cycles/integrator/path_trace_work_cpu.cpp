@@ -73,15 +73,22 @@ void PathTraceWorkCPU::render_samples(RenderStatistics &statistics,
     }
   }
 
+  /* With adaptive sampling only iterate over the pixels that are not converged yet, so that all
+   * threads are busy with pixels which actually need more samples. */
+  const bool use_active_pixels = use_active_pixels_ &&
+                                 active_pixels_total_num_ == total_pixels_num;
+  const int64_t work_num = use_active_pixels ? int64_t(active_pixels_.size()) : total_pixels_num;
+
   tbb::task_arena local_arena = local_tbb_arena_create(device_);
   local_arena.execute([&]() {
-    parallel_for(int64_t(0), total_pixels_num, [&](int64_t work_index) {
+    parallel_for(int64_t(0), work_num, [&](int64_t work_index) {
       if (is_cancel_requested()) {
         return;
       }
 
-      const int y = work_index / image_width;
-      const int x = work_index - y * image_width;
+      const int64_t pixel_index = use_active_pixels ? active_pixels_[work_index] : work_index;
+      const int y = pixel_index / image_width;
+      const int x = pixel_index - y * image_width;
 
       KernelWorkTile work_tile;
       work_tile.x = effective_buffer_params_.full_x + x;
@@ -205,12 +212,14 @@ bool PathTraceWorkCPU::copy_render_buffers_from_device()
 bool PathTraceWorkCPU::copy_render_buffers_to_device()
 {
   buffers_->buffer.copy_to_device();
+  use_active_pixels_ = false;
   return true;
 }
 
 bool PathTraceWorkCPU::zero_render_buffers()
 {
   buffers_->zero();
+  use_active_pixels_ = false;
   return true;
 }
 
@@ -264,9 +273,71 @@ int PathTraceWorkCPU::adaptive_sampling_converge_filter_count_active(float thres
     });
   }
 
+  update_active_pixels();
+
   return num_active_pixels;
 }
 
+void PathTraceWorkCPU::update_active_pixels()
+{
+  const KernelFilm &kfilm = device_scene_->data.film;
+  if (kfilm.pass_adaptive_aux_buffer == PASS_UNUSED) {
+    use_active_pixels_ = false;
+    return;
+  }
+
+  const int full_x = effective_buffer_params_.full_x;
+  const int full_y = effective_buffer_params_.full_y;
+  const int width = effective_buffer_params_.width;
+  const int height = effective_buffer_params_.height;
+  const int64_t offset = effective_buffer_params_.offset;
+  const int64_t stride = effective_buffer_params_.stride;
+  const int64_t pass_stride = kfilm.pass_stride;
+
+  /* Pixels that still need samples have the converged flag cleared, matching the check done by
+   * film_need_sample_pixel() in the kernel. */
+  const float *render_buffer = buffers_->buffer.data();
+  const auto is_pixel_active = [&](const int x, const int y) {
+    const int64_t render_pixel_index = offset + (full_x + x) + int64_t(full_y + y) * stride;
+    const float *buffer = render_buffer + render_pixel_index * pass_stride;
+    return buffer[kfilm.pass_adaptive_aux_buffer + 3] == 0.0f;
+  };
+
+  /* Count active pixels per row first, so rows can be written in parallel at their offset. */
+  vector<int> row_offsets(height + 1, 0);
+
+  tbb::task_arena local_arena = local_tbb_arena_create(device_);
+  local_arena.execute([&]() {
+    parallel_for(0, height, [&](int y) {
+      int num_row_pixels_active = 0;
+      for (int x = 0; x < width; ++x) {
+        num_row_pixels_active += is_pixel_active(x, y);
+      }
+      row_offsets[y + 1] = num_row_pixels_active;
+    });
+  });
+
+  for (int y = 0; y < height; ++y) {
+    row_offsets[y + 1] += row_offsets[y];
+  }
+
+  active_pixels_.resize(row_offsets[height]);
+
+  local_arena.execute([&]() {
+    parallel_for(0, height, [&](int y) {
+      int active_index = row_offsets[y];
+      for (int x = 0; x < width; ++x) {
+        if (is_pixel_active(x, y)) {
+          active_pixels_[active_index++] = y * width + x;
+        }
+      }
+    });
+  });
+
+  active_pixels_total_num_ = int64_t(width) * height;
+  use_active_pixels_ = true;
+}
+
 void PathTraceWorkCPU::cryptomatte_postproces()
 {
   const int width = effective_buffer_params_.width;
@@ -74,6 +74,10 @@ class PathTraceWorkCPU : public PathTraceWork {
                                     const KernelWorkTile &work_tile,
                                     const int samples_num);
 
+  /* Gather pixels that are not converged yet after adaptive sampling filtering, so that
+   * following samples are only scheduled for them. */
+  void update_active_pixels();
+
   /* CPU kernels. */
   const CPUKernels &kernels_;
 
@@ -83,6 +87,13 @@ class PathTraceWorkCPU : public PathTraceWork {
    * accessing it, but some "localization" is required to decouple from kernel globals stored
    * on the device level. */
   vector<CPUKernelThreadGlobals> kernel_thread_globals_;
+
+  /* Indices of the pixels within the effective buffer that still need to be sampled, as of the
+   * last adaptive sampling filter. Only used when `use_active_pixels_` is true, which is reset
+   * whenever the render buffer contents are replaced. */
+  vector<int> active_pixels_;
+  int64_t active_pixels_total_num_ = 0;
+  bool use_active_pixels_ = false;
 };
 
 CCL_NAMESPACE_END
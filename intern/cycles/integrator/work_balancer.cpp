@@ -38,37 +38,41 @@ static double calculate_total_time(const vector<WorkBalanceInfo> &work_balance_i
   return total_time;
 }
 
-/* The balance is based on equalizing time which devices spent performing a task. Assume that
- * average of the observed times is usable for estimating whether more or less work is to be
- * scheduled, and how difference in the work scheduling is needed. */
+/* The balance is based on the measured throughput of every device: the fraction of the work it
+ * was given, divided by the time it spent on it. Weights proportional to the throughput make all
+ * devices finish at the same time, assuming the cost of the work is uniform.
+ *
+ * The cost is not uniform across the image in practice, so the weights only move part of the way
+ * towards the estimate. This converges in a few rebalances even when devices differ a lot in
+ * performance, like a CPU next to a GPU, without oscillating between configurations. */
 
 bool work_balance_do_rebalance(vector<WorkBalanceInfo> &work_balance_infos)
 {
+  /* Fraction of the distance to the estimated weights which is covered by a single rebalance. */
+  static const double kRebalanceFactor = 0.75;
+
   const int num_infos = work_balance_infos.size();
 
   const double total_time = calculate_total_time(work_balance_infos);
   const double time_average = total_time / num_infos;
 
-  double total_weight = 0;
-  vector<double> new_weights;
-  new_weights.reserve(num_infos);
-
-  /* Equalize the overall average time. This means that we don't make it so every work will perform
-   * amount of work based on the current average, but that after the weights changes the time will
-   * equalize.
-   * Can think of it that if one of the devices is 10% faster than another, then one device needs
-   * to do 5% less of the current work, and another needs to do 5% more. */
-  const double lerp_weight = 1.0 / num_infos;
+  double total_throughput = 0;
+  vector<double> throughputs;
+  throughputs.reserve(num_infos);
 
   bool has_big_difference = false;
 
   for (const WorkBalanceInfo &info : work_balance_infos) {
-    const double time_target = mix(info.time_spent, time_average, lerp_weight);
-    const double new_weight = info.weight * time_target / info.time_spent;
-    new_weights.push_back(new_weight);
-    total_weight += new_weight;
+    if (info.time_spent <= 0.0) {
+      /* No statistics for this device yet. */
+      return false;
+    }
+
+    const double throughput = info.weight / info.time_spent;
+    throughputs.push_back(throughput);
+    total_throughput += throughput;
 
-    if (std::fabs(1.0 - time_target / time_average) > 0.02) {
+    if (std::fabs(1.0 - info.time_spent / time_average) > 0.02) {
       has_big_difference = true;
     }
   }
@@ -77,10 +81,12 @@ bool work_balance_do_rebalance(vector<WorkBalanceInfo> &work_balance_infos)
     return false;
   }
 
-  const double total_weight_inv = 1.0 / total_weight;
+  /* Both the current and the estimated weights add up to one, so no normalization is needed. */
+  const double total_throughput_inv = 1.0 / total_throughput;
   for (int i = 0; i < num_infos; ++i) {
     WorkBalanceInfo &info = work_balance_infos[i];
-    info.weight = new_weights[i] * total_weight_inv;
+    const double estimated_weight = throughputs[i] * total_throughput_inv;
+    info.weight = mix(info.weight, estimated_weight, kRebalanceFactor);
     info.time_spent = 0;
   }
 
@@ -127,6 +127,7 @@ ccl_device_inline bool volume_shader_sample(KernelGlobals kg,
 ccl_device_forceinline void volume_step_init(KernelGlobals kg,
                                              ccl_private const RNGState *rng_state,
                                              const float object_step_size,
+                                             const float ray_footprint,
                                              const float tmin,
                                              const float tmax,
                                              ccl_private float *step_size,
@@ -147,6 +148,10 @@ ccl_device_forceinline void volume_step_init(KernelGlobals kg,
     const float t = tmax - tmin;
     float step = min(object_step_size, t);
 
+    /* Don't step finer than the ray footprint, detail smaller than that averages out over the
+     * pixel anyway. This skips most of the steps for distant volumes with small voxels. */
+    step = min(max(step, ray_footprint), t);
+
     /* compute exact steps in advance for malloc */
     if (t > *max_steps * step) {
       step = t / (float)*max_steps;
@@ -209,6 +214,7 @@ ccl_device void volume_shadow_heterogeneous(KernelGlobals kg,
   volume_step_init(kg,
                    &rng_state,
                    object_step_size,
+                   0.0f,
                    ray->tmin,
                    ray->tmax,
                    &step_size,
@@ -543,12 +549,17 @@ ccl_device_forceinline void volume_integrate_heterogeneous(
   PROFILING_INIT(kg, PROFILING_SHADE_VOLUME_INTEGRATE);
 
   /* Prepare for stepping.
-   * Using a different step offset for the first step avoids banding artifacts. */
+   * Using a different step offset for the first step avoids banding artifacts. The footprint
+   * is taken at the start of the segment, where it is smallest. */
+  const float ray_footprint = differential_transfer_compact(
+      ray->dP, ray->D, ray->dD, ray->tmin);
+
   int max_steps;
   float step_size, step_shade_offset, steps_offset;
   volume_step_init(kg,
                    rng_state,
                    object_step_size,
+                   ray_footprint,
                    ray->tmin,
                    ray->tmax,
                    &step_size,
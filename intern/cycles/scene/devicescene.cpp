@@ -5,6 +5,7 @@
 #include "scene/devicescene.h"
 #include "device/device.h"
 #include "device/memory.h"
+#include "scene/stats.h"
 
 CCL_NAMESPACE_BEGIN
 
@@ -62,4 +63,69 @@ DeviceScene::DeviceScene(Device *device)
   memset((void *)&data, 0, sizeof(data));
 }
 
+void DeviceScene::collect_statistics(DeviceMemoryStats *stats) const
+{
+  auto add_category = [stats](const char *name,
+                              std::initializer_list<const device_memory *> mems) {
+    size_t size = 0;
+    for (const device_memory *mem : mems) {
+      size += mem->device_size;
+    }
+    stats->categories.add_entry(NamedSizeEntry(name, size));
+  };
+
+  add_category("BVH",
+               {&bvh_nodes,
+                &bvh_leaf_nodes,
+                &object_node,
+                &prim_type,
+                &prim_visibility,
+                &prim_index,
+                &prim_object,
+                &prim_time});
+  add_category("Geometry",
+               {&tri_verts,
+                &tri_shader,
+                &tri_vnormal,
+                &tri_vindex,
+                &tri_patch,
+                &tri_patch_uv,
+                &curves,
+                &curve_keys,
+                &curve_segments,
+                &patches,
+                &points,
+                &points_shader});
+  add_category("Attributes",
+               {&attributes_map,
+                &attributes_float,
+                &attributes_float2,
+                &attributes_float3,
+                &attributes_float4,
+                &attributes_uchar4});
+  add_category("Objects",
+               {&objects,
+                &object_motion_pass,
+                &object_motion,
+                &object_flag,
+                &object_volume_step,
+                &object_prim_offset,
+                &camera_motion,
+                &particles});
+  add_category("Lights",
+               {&light_distribution,
+                &lights,
+                &light_background_marginal_cdf,
+                &light_background_conditional_cdf,
+                &light_tree_nodes,
+                &light_tree_emitters,
+                &light_to_tree,
+                &object_to_tree,
+                &object_lookup_offset,
+                &triangle_to_tree,
+                &ies_lights});
+  add_category("Shaders", {&svm_nodes, &shaders});
+  add_category("Lookup tables", {&lookup_table, &sample_pattern_lut});
+}
+
 CCL_NAMESPACE_END
@@ -13,6 +13,8 @@
 
 CCL_NAMESPACE_BEGIN
 
+class DeviceMemoryStats;
+
 class DeviceScene {
  public:
   /* BVH */
@@ -95,6 +97,9 @@ class DeviceScene {
   KernelData data;
 
   DeviceScene(Device *device);
+
+  /* Add device memory used by the arrays above to the statistics, by category. */
+  void collect_statistics(DeviceMemoryStats *stats) const;
 };
 
 CCL_NAMESPACE_END
@@ -126,9 +126,11 @@ void GeometryManager::device_update_bvh(Device *device,
 
   VLOG_INFO << "Using " << bvh_layout_name(bparams.bvh_layout) << " layout.";
 
+  /* Embree falls back to a full build when refitting is not worth it. */
   const bool can_refit = scene->bvh != nullptr &&
                          (bparams.bvh_layout == BVHLayout::BVH_LAYOUT_OPTIX ||
-                          bparams.bvh_layout == BVHLayout::BVH_LAYOUT_METAL);
+                          bparams.bvh_layout == BVHLayout::BVH_LAYOUT_METAL ||
+                          bparams.bvh_layout == BVHLayout::BVH_LAYOUT_EMBREE);
 
   BVH *bvh = scene->bvh;
   if (!scene->bvh) {
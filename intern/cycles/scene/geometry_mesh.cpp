@@ -33,6 +33,7 @@
 #include "util/log.h"
 #include "util/progress.h"
 #include "util/task.h"
+#include "util/tbb.h"
 
 CCL_NAMESPACE_BEGIN
 
@@ -102,7 +103,9 @@ void GeometryManager::device_update_mesh(Device *,
                                dscene->tri_patch.need_realloc() ||
                                dscene->tri_patch_uv.need_realloc();
 
-    foreach (Geometry *geom, scene->geometry) {
+    /* Each geometry packs into its own range of the arrays, so they can be packed in parallel. */
+    parallel_for(size_t(0), scene->geometry.size(), [&](const size_t i) {
+      Geometry *geom = scene->geometry[i];
       if (geom->geometry_type == Geometry::MESH || geom->geometry_type == Geometry::VOLUME) {
         Mesh *mesh = static_cast<Mesh *>(geom);
 
@@ -124,11 +127,11 @@ void GeometryManager::device_update_mesh(Device *,
                            &tri_patch[mesh->prim_offset],
                            &tri_patch_uv[mesh->vert_offset]);
         }
-
-        if (progress.get_cancel()) {
-          return;
-        }
       }
+    });
+
+    if (progress.get_cancel()) {
+      return;
     }
 
     /* vertex coordinates */
@@ -153,7 +156,8 @@ void GeometryManager::device_update_mesh(Device *,
                                dscene->curves.need_realloc() ||
                                dscene->curve_segments.need_realloc();
 
-    foreach (Geometry *geom, scene->geometry) {
+    parallel_for(size_t(0), scene->geometry.size(), [&](const size_t i) {
+      Geometry *geom = scene->geometry[i];
       if (geom->is_hair()) {
         Hair *hair = static_cast<Hair *>(geom);
 
@@ -163,17 +167,18 @@ void GeometryManager::device_update_mesh(Device *,
                                    hair->curve_first_key_is_modified();
 
         if (!curve_keys_co_modified && !curve_data_modified && !copy_all_data) {
-          continue;
+          return;
         }
 
         hair->pack_curves(scene,
                           &curve_keys[hair->curve_key_offset],
                           &curves[hair->prim_offset],
                           &curve_segments[hair->curve_segment_offset]);
-        if (progress.get_cancel()) {
-          return;
-        }
       }
+    });
+
+    if (progress.get_cancel()) {
+      return;
     }
 
     dscene->curve_keys.copy_to_device_if_modified();
@@ -187,19 +192,31 @@ void GeometryManager::device_update_mesh(Device *,
     float4 *points = dscene->points.alloc(point_size);
     uint *points_shader = dscene->points_shader.alloc(point_size);
 
-    foreach (Geometry *geom, scene->geometry) {
+    const bool copy_all_data = dscene->points.need_realloc() ||
+                               dscene->points_shader.need_realloc();
+
+    parallel_for(size_t(0), scene->geometry.size(), [&](const size_t i) {
+      Geometry *geom = scene->geometry[i];
       if (geom->is_pointcloud()) {
         PointCloud *pointcloud = static_cast<PointCloud *>(geom);
-        pointcloud->pack(
-            scene, &points[pointcloud->prim_offset], &points_shader[pointcloud->prim_offset]);
-        if (progress.get_cancel()) {
+
+        if (!pointcloud->points_is_modified() && !pointcloud->radius_is_modified() &&
+            !pointcloud->shader_is_modified() && !copy_all_data)
+        {
           return;
         }
+
+        pointcloud->pack(
+            scene, &points[pointcloud->prim_offset], &points_shader[pointcloud->prim_offset]);
       }
+    });
+
+    if (progress.get_cancel()) {
+      return;
     }
 
-    dscene->points.copy_to_device();
-    dscene->points_shader.copy_to_device();
+    dscene->points.copy_to_device_if_modified();
+    dscene->points_shader.copy_to_device_if_modified();
   }
 
   if (patch_size != 0 && dscene->patches.need_realloc()) {
@@ -28,6 +28,9 @@ CCL_NAMESPACE_BEGIN
 
 namespace {
 
+/* Maximum size of images loaded at preview resolution, see #set_use_preview_resolution. */
+const int IMAGE_PREVIEW_TEXTURE_LIMIT = 512;
+
 /* Some helpers to silence warning in templated function. */
 bool isfinite(uchar /*value*/)
 {
@@ -243,6 +246,8 @@ ImageMetaData::ImageMetaData()
       colorspace(u_colorspace_raw),
       colorspace_file_format(""),
       use_transform_3d(false),
+      num_miplevels(1),
+      miplevel(0),
       compress_as_srgb(false)
 {
 }
@@ -321,6 +326,7 @@ bool ImageLoader::is_vdb_loader() const
 ImageManager::ImageManager(const DeviceInfo &info)
 {
   need_update_ = true;
+  use_preview_resolution_ = false;
   osl_texture_system = NULL;
   animation_frame = 0;
 
@@ -340,6 +346,31 @@ void ImageManager::set_osl_texture_system(void *texture_system)
   osl_texture_system = texture_system;
 }
 
+void ImageManager::set_use_preview_resolution(bool use)
+{
+  use_preview_resolution_ = use;
+}
+
+bool ImageManager::tag_full_resolution_update()
+{
+  thread_scoped_lock device_lock(images_mutex);
+
+  bool tagged = false;
+  for (Image *img : images) {
+    if (img && img->need_full_resolution && !img->need_load) {
+      img->need_full_resolution = false;
+      img->need_load = true;
+      tagged = true;
+    }
+  }
+
+  if (tagged) {
+    need_update_ = true;
+  }
+
+  return tagged;
+}
+
 bool ImageManager::set_animation_frame_update(int frame)
 {
   if (frame != animation_frame) {
@@ -485,6 +516,7 @@ size_t ImageManager::add_image_slot(ImageLoader *loader,
   img->loader = loader;
   img->need_metadata = true;
   img->need_load = !(osl_texture_system && !img->loader->osl_filepath().empty());
+  img->need_full_resolution = false;
   img->builtin = builtin;
   img->users = 1;
   img->mem = NULL;
@@ -531,6 +563,38 @@ static bool image_associate_alpha(ImageManager::Image *img)
            img->params.alpha_type == IMAGE_ALPHA_CHANNEL_PACKED);
 }
 
+/* Check if all pixels of an RGBA image are gray and fully opaque. */
+template<typename StorageType>
+static bool image_is_opaque_grayscale(const StorageType *pixels, const size_t num_pixels)
+{
+  for (size_t i = 0; i < num_pixels; i++) {
+    const StorageType *pixel = &pixels[i * 4];
+    const float r = util_image_cast_to_float(pixel[0]);
+    if (util_image_cast_to_float(pixel[1]) != r || util_image_cast_to_float(pixel[2]) != r ||
+        util_image_cast_to_float(pixel[3]) != 1.0f)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+static ImageDataType image_single_channel_type(const ImageDataType type)
+{
+  switch (type) {
+    case IMAGE_DATA_TYPE_FLOAT4:
+      return IMAGE_DATA_TYPE_FLOAT;
+    case IMAGE_DATA_TYPE_HALF4:
+      return IMAGE_DATA_TYPE_HALF;
+    case IMAGE_DATA_TYPE_BYTE4:
+      return IMAGE_DATA_TYPE_BYTE;
+    case IMAGE_DATA_TYPE_USHORT4:
+      return IMAGE_DATA_TYPE_USHORT;
+    default:
+      return type;
+  }
+}
+
 template<TypeDesc::BASETYPE FileFormat, typename StorageType>
 bool ImageManager::file_load_image(Image *img, int texture_limit)
 {
@@ -540,10 +604,28 @@ bool ImageManager::file_load_image(Image *img, int texture_limit)
   }
 
   /* Get metadata. */
-  int width = img->metadata.width;
-  int height = img->metadata.height;
-  int depth = img->metadata.depth;
-  int components = img->metadata.channels;
+  ImageMetaData metadata = img->metadata;
+  int width = metadata.width;
+  int height = metadata.height;
+  int depth = metadata.depth;
+  int components = metadata.channels;
+
+  /* When the texture size is limited, load a lower resolution MIP level from the file if it has
+   * any, rather than loading the full resolution image to scale it down afterwards. */
+  if (texture_limit > 0 && depth <= 1) {
+    while (metadata.miplevel + 1 < metadata.num_miplevels && max(width, height) > texture_limit)
+    {
+      width = max(width / 2, 1);
+      height = max(height / 2, 1);
+      metadata.miplevel++;
+    }
+    if (metadata.miplevel > 0) {
+      VLOG_WORK << "Loading image " << img->loader->name() << " from MIP level "
+                << metadata.miplevel << ".";
+      metadata.width = width;
+      metadata.height = height;
+    }
+  }
 
   /* Read pixels. */
   vector<StorageType> pixels_storage;
@@ -570,8 +652,7 @@ bool ImageManager::file_load_image(Image *img, int texture_limit)
   }
 
   const size_t num_pixels = ((size_t)width) * height * depth;
-  img->loader->load_pixels(
-      img->metadata, pixels, num_pixels * components, image_associate_alpha(img));
+  img->loader->load_pixels(metadata, pixels, num_pixels * components, image_associate_alpha(img));
 
   /* The kernel can handle 1 and 4 channel images. Anything that is not a single
    * channel image is converted to RGBA format. */
@@ -655,6 +736,40 @@ bool ImageManager::file_load_image(Image *img, int texture_limit)
     }
   }
 
+  /* Store gray images without alpha as a single channel texture, using a quarter of the memory.
+   * This is lossless since the kernel reads single channel textures as (f, f, f, 1). It is
+   * checked after color space conversion, which does not necessarily keep gray pixels gray. */
+  if (is_rgba && image_is_opaque_grayscale(pixels, num_pixels)) {
+    VLOG_WORK << "Storing grayscale image " << img->loader->name() << " as single channel.";
+
+    for (size_t i = 0; i < num_pixels; i++) {
+      pixels[i] = pixels[i * 4];
+    }
+    is_rgba = false;
+
+    thread_scoped_lock device_lock(device_mutex);
+    device_texture *mem = new device_texture(img->mem->device,
+                                             img->mem_name.c_str(),
+                                             img->mem->slot,
+                                             image_single_channel_type(img->metadata.type),
+                                             img->params.interpolation,
+                                             img->params.extension);
+    mem->info.use_transform_3d = img->mem->info.use_transform_3d;
+    mem->info.transform_3d = img->mem->info.transform_3d;
+
+    if (pixels_storage.size() > 0) {
+      /* Pixels are allocated below when scaling down. */
+      pixels_storage.resize(num_pixels);
+    }
+    else {
+      StorageType *texture_pixels = (StorageType *)mem->alloc(width, height, depth);
+      memcpy(texture_pixels, pixels, num_pixels * sizeof(StorageType));
+    }
+
+    delete img->mem;
+    img->mem = mem;
+  }
+
   /* Scale image down if needed. */
   if (pixels_storage.size() > 0) {
     float scale_factor = 1.0f;
@@ -699,11 +814,24 @@ void ImageManager::device_load_image(Device *device, Scene *scene, size_t slot,
 
   progress->set_status("Updating Images", "Loading " + img->loader->name());
 
-  const int texture_limit = scene->params.texture_limit;
+  int texture_limit = scene->params.texture_limit;
 
   load_image_metadata(img);
   ImageDataType type = img->metadata.type;
 
+  /* On the first load read a low resolution MIP level, which is cheap compared to the full
+   * resolution. The full resolution is loaded after the first render, see
+   * #tag_full_resolution_update. */
+  img->need_full_resolution = false;
+  if (use_preview_resolution_ && img->mem == NULL && img->metadata.num_miplevels > 1 &&
+      img->metadata.depth <= 1 &&
+      max(img->metadata.width, img->metadata.height) > IMAGE_PREVIEW_TEXTURE_LIMIT &&
+      (texture_limit == 0 || texture_limit > IMAGE_PREVIEW_TEXTURE_LIMIT))
+  {
+    texture_limit = IMAGE_PREVIEW_TEXTURE_LIMIT;
+    img->need_full_resolution = true;
+  }
+
   /* Name for debugging. */
   img->mem_name = string_printf("tex_image_%s_%03d", name_from_type(type), (int)slot);
 
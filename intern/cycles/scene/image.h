@@ -77,6 +77,11 @@ class ImageMetaData {
   bool use_transform_3d;
   Transform transform_3d;
 
+  /* Optional number of MIP levels stored in the file, each half the size of the previous one.
+   * Pixels are loaded from the given level, with width and height set to that level's size. */
+  int num_miplevels;
+  int miplevel;
+
   /* Automatically set. */
   bool compress_as_srgb;
 
@@ -195,6 +200,13 @@ class ImageManager {
 
   bool need_update() const;
 
+  /* Load images that have MIP levels at a low resolution the first time, for a quick first look
+   * in interactive renders. */
+  void set_use_preview_resolution(bool use);
+  /* Tag images loaded at preview resolution to be loaded at full resolution. Returns true when
+   * any image was tagged. */
+  bool tag_full_resolution_update();
+
   struct Image {
     ImageParams params;
     ImageMetaData metadata;
@@ -203,6 +215,7 @@ class ImageManager {
     float frame;
     bool need_metadata;
     bool need_load;
+    bool need_full_resolution;
     bool builtin;
 
     string mem_name;
@@ -214,6 +227,7 @@ class ImageManager {
 
  private:
   bool need_update_;
+  bool use_preview_resolution_;
 
   ImageDeviceFeatures features;
 
@@ -84,6 +84,22 @@ bool OIIOImageLoader::load_metadata(const ImageDeviceFeatures & /*features*/,
   metadata.colorspace_file_format = in->format_name();
   metadata.colorspace_file_hint = spec.get_string_attribute("oiio:ColorSpace");
 
+  /* Count MIP levels, as found in `.tx` files. Only levels that halve the size of the previous
+   * one are used, so their size is known without opening the file again. */
+  if (spec.depth <= 1) {
+    int mip_width = spec.width;
+    int mip_height = spec.height;
+    ImageSpec mip_spec;
+    while (in->seek_subimage(0, metadata.num_miplevels, mip_spec)) {
+      mip_width = max(mip_width / 2, 1);
+      mip_height = max(mip_height / 2, 1);
+      if (mip_spec.width != mip_width || mip_spec.height != mip_height) {
+        break;
+      }
+      metadata.num_miplevels++;
+    }
+  }
+
   in->close();
 
   return true;
@@ -111,7 +127,7 @@ static void oiio_load_pixels(const ImageMetaData &metadata,
   if (depth <= 1) {
     size_t scanlinesize = width * components * sizeof(StorageType);
     in->read_image(0,
-                   0,
+                   metadata.miplevel,
                    0,
                    components,
                    FileFormat,
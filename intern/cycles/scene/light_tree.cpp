@@ -7,6 +7,7 @@
 #include "scene/object.h"
 
 #include "util/progress.h"
+#include "util/tbb.h"
 
 CCL_NAMESPACE_BEGIN
 
@@ -499,6 +500,29 @@ void LightTree::recursive_build(const Child child,
   }
 }
 
+using LightTreeBuckets = std::array<LightTreeBucket, LightTreeBucket::num_buckets>;
+
+/* Place emitters into buckets along the given dimension, where the centroid box is split into
+ * equal partitions. */
+static void light_tree_bin_emitters(const LightTreeEmitter *emitters,
+                                    const int start,
+                                    const int end,
+                                    const BoundBox &centroid_bbox,
+                                    const int dim,
+                                    LightTreeBuckets &buckets)
+{
+  const float inv_extent = 1 / (centroid_bbox.size()[dim]);
+  for (int i = start; i < end; i++) {
+    const LightTreeEmitter *emitter = emitters + i;
+
+    int bucket_idx = LightTreeBucket::num_buckets *
+                     (emitter->centroid[dim] - centroid_bbox.min[dim]) * inv_extent;
+    bucket_idx = clamp(bucket_idx, 0, LightTreeBucket::num_buckets - 1);
+
+    buckets[bucket_idx].add(*emitter);
+  }
+}
+
 bool LightTree::should_split(LightTreeEmitter *emitters,
                              const int start,
                              int &middle,
@@ -519,14 +543,62 @@ bool LightTree::should_split(LightTreeEmitter *emitters,
 
   middle = (start + end) / 2;
 
+  /* For large nodes the emitters are binned in parallel, in chunks of a fixed size which are
+   * merged in order. This way the result does not depend on the number of threads. */
+  const bool use_parallel_binning = num_emitters > MIN_EMITTERS_PARALLEL_BINNING;
+  const int num_chunks = use_parallel_binning ? divide_up(num_emitters, MIN_EMITTERS_PER_THREAD) :
+                                                1;
+  const auto chunk_range = [&](const int chunk, int &chunk_start, int &chunk_end) {
+    chunk_start = start + chunk * MIN_EMITTERS_PER_THREAD;
+    chunk_end = min(chunk_start + MIN_EMITTERS_PER_THREAD, end);
+  };
+
   BoundBox centroid_bbox = BoundBox::empty;
-  for (int i = start; i < end; i++) {
-    centroid_bbox.grow((emitters + i)->centroid);
+  if (use_parallel_binning) {
+    vector<BoundBox> chunk_bbox(num_chunks, BoundBox::empty);
+    parallel_for(0, num_chunks, [&](const int chunk) {
+      int chunk_start, chunk_end;
+      chunk_range(chunk, chunk_start, chunk_end);
+      for (int i = chunk_start; i < chunk_end; i++) {
+        chunk_bbox[chunk].grow((emitters + i)->centroid);
+      }
+    });
+    for (const BoundBox &bbox : chunk_bbox) {
+      centroid_bbox.grow(bbox);
+    }
+  }
+  else {
+    for (int i = start; i < end; i++) {
+      centroid_bbox.grow((emitters + i)->centroid);
+    }
   }
 
   const float3 extent = centroid_bbox.size();
   const float max_extent = max4(extent.x, extent.y, extent.z, 0.0f);
 
+  /* Bin all dimensions that are checked below at once. */
+  std::array<LightTreeBuckets, 3> parallel_buckets;
+  if (use_parallel_binning) {
+    vector<std::array<LightTreeBuckets, 3>> chunk_buckets(num_chunks);
+    parallel_for(0, num_chunks, [&](const int chunk) {
+      int chunk_start, chunk_end;
+      chunk_range(chunk, chunk_start, chunk_end);
+      for (int dim = 0; dim < 3; dim++) {
+        if (dim == 0 || extent[dim] != 0.0f) {
+          light_tree_bin_emitters(
+              emitters, chunk_start, chunk_end, centroid_bbox, dim, chunk_buckets[chunk][dim]);
+        }
+      }
+    });
+    for (const std::array<LightTreeBuckets, 3> &buckets : chunk_buckets) {
+      for (int dim = 0; dim < 3; dim++) {
+        for (int i = 0; i < LightTreeBucket::num_buckets; i++) {
+          parallel_buckets[dim][i] = parallel_buckets[dim][i] + buckets[dim][i];
+        }
+      }
+    }
+  }
+
   /* Check each dimension to find the minimum splitting cost. */
   float total_cost = 0.0f;
   float min_cost = FLT_MAX;
@@ -540,17 +612,12 @@ bool LightTree::should_split(LightTreeEmitter *emitters,
     const float inv_extent = 1 / (centroid_bbox.size()[dim]);
 
     /* Fill in buckets with emitters. */
-    std::array<LightTreeBucket, LightTreeBucket::num_buckets> buckets;
-    for (int i = start; i < end; i++) {
-      const LightTreeEmitter *emitter = emitters + i;
-
-      /* Place emitter into the appropriate bucket, where the centroid box is split into equal
-       * partitions. */
-      int bucket_idx = LightTreeBucket::num_buckets *
-                       (emitter->centroid[dim] - centroid_bbox.min[dim]) * inv_extent;
-      bucket_idx = clamp(bucket_idx, 0, LightTreeBucket::num_buckets - 1);
-
-      buckets[bucket_idx].add(*emitter);
+    LightTreeBuckets buckets;
+    if (use_parallel_binning) {
+      buckets = parallel_buckets[dim];
+    }
+    else {
+      light_tree_bin_emitters(emitters, start, end, centroid_bbox, dim, buckets);
     }
 
     /* Precompute the left bucket measure cumulatively. */
@@ -431,6 +431,9 @@ class LightTree {
   TaskPool task_pool;
   /* Do not spawn a thread if less than this amount of emitters are to be processed. */
   enum { MIN_EMITTERS_PER_THREAD = 4096 };
+  /* Bin emitters in parallel when splitting a node with more than this amount of emitters, which
+   * happens near the root where there are not enough subtrees yet to keep all threads busy. */
+  enum { MIN_EMITTERS_PARALLEL_BINNING = 4 * MIN_EMITTERS_PER_THREAD };
 
   void recursive_build(Child child,
                        LightTreeNode *inner,
@@ -460,6 +460,23 @@ void Scene::collect_statistics(RenderStats *stats)
 {
   geometry_manager->collect_statistics(this, stats);
   image_manager->collect_statistics(stats);
+
+  DeviceMemoryStats &device_memory = stats->device_memory;
+  dscene.collect_statistics(&device_memory);
+  device_memory.categories.add_entry(
+      NamedSizeEntry("Textures", stats->image.textures.total_size));
+
+  /* Everything else, like render buffers, integrator state and BVH memory owned by the device.
+   * With multiple devices the used memory is the sum over all of them, so it can't be compared
+   * to the scene memory of a single device. */
+  if (device->info.multi_devices.empty() &&
+      device->stats.mem_used > device_memory.categories.total_size)
+  {
+    device_memory.categories.add_entry(
+        NamedSizeEntry("Other", device->stats.mem_used - device_memory.categories.total_size));
+  }
+
+  device_memory.mapped_host_size = device->stats.mem_mapped_host;
 }
 
 void Scene::enable_update_stats()
@@ -0,0 +1,611 @@
+/* SPDX-FileCopyrightText: 2011-2022 Blender Foundation
+ *
+ * SPDX-License-Identifier: Apache-2.0 */
+
+#include "scene/scene_cache.h"
+
+#include "scene/attribute.h"
+#include "scene/hair.h"
+#include "scene/light.h"
+#include "scene/mesh.h"
+#include "scene/object.h"
+#include "scene/pointcloud.h"
+#include "scene/scene.h"
+#include "scene/shader.h"
+
+#include "util/foreach.h"
+#include "util/log.h"
+#include "util/map.h"
+#include "util/path.h"
+#include "util/transform.h"
+#include "util/vector.h"
+
+CCL_NAMESPACE_BEGIN
+
+/* Bump when the layout of the file or of any of the stored node types changes. */
+static const char SCENE_CACHE_MAGIC[8] = {'C', 'Y', 'C', 'A', 'C', 'H', 'E', '\0'};
+static const uint SCENE_CACHE_VERSION = 1;
+
+/* Writer */
+
+class SceneCacheWriter {
+ public:
+  vector<uint8_t> data;
+  map<const Node *, int> node_ids;
+
+  void write(const void *value, const size_t size)
+  {
+    const uint8_t *bytes = (const uint8_t *)value;
+    data.insert(data.end(), bytes, bytes + size);
+  }
+
+  template<typename T> void write_value(const T &value)
+  {
+    write(&value, sizeof(T));
+  }
+
+  void write_string(const string &value)
+  {
+    write_value<uint>(value.size());
+    write(value.data(), value.size());
+  }
+
+  template<typename T> void write_array(const array<T> &value)
+  {
+    write_value<uint64_t>(value.size());
+    write(value.data(), value.size() * sizeof(T));
+  }
+
+  void write_node_ref(const Node *node)
+  {
+    map<const Node *, int>::const_iterator it = node_ids.find(node);
+    write_value<int>((it != node_ids.end()) ? it->second : -1);
+  }
+
+  void add_node_id(const Node *node)
+  {
+    const int id = node_ids.size();
+    node_ids[node] = id;
+  }
+
+  void write_socket(const Node *node, const SocketType &socket);
+  void write_node(const Node *node);
+  void write_attributes(const AttributeSet &attributes);
+};
+
+void SceneCacheWriter::write_socket(const Node *node, const SocketType &socket)
+{
+  switch (socket.type) {
+    case SocketType::BOOLEAN:
+      write_value(node->get_bool(socket));
+      break;
+    case SocketType::FLOAT:
+      write_value(node->get_float(socket));
+      break;
+    case SocketType::INT:
+      write_value(node->get_int(socket));
+      break;
+    case SocketType::UINT:
+      write_value(node->get_uint(socket));
+      break;
+    case SocketType::UINT64:
+      write_value(node->get_uint64(socket));
+      break;
+    case SocketType::COLOR:
+    case SocketType::VECTOR:
+    case SocketType::POINT:
+    case SocketType::NORMAL:
+      write_value(node->get_float3(socket));
+      break;
+    case SocketType::POINT2:
+      write_value(node->get_float2(socket));
+      break;
+    case SocketType::STRING:
+    case SocketType::ENUM:
+      write_string(node->get_string(socket).string());
+      break;
+    case SocketType::TRANSFORM:
+      write_value(node->get_transform(socket));
+      break;
+    case SocketType::NODE:
+      write_node_ref(node->get_node(socket));
+      break;
+    case SocketType::BOOLEAN_ARRAY:
+      write_array(node->get_bool_array(socket));
+      break;
+    case SocketType::FLOAT_ARRAY:
+      write_array(node->get_float_array(socket));
+      break;
+    case SocketType::INT_ARRAY:
+      write_array(node->get_int_array(socket));
+      break;
+    case SocketType::COLOR_ARRAY:
+    case SocketType::VECTOR_ARRAY:
+    case SocketType::POINT_ARRAY:
+    case SocketType::NORMAL_ARRAY:
+      write_array(node->get_float3_array(socket));
+      break;
+    case SocketType::POINT2_ARRAY:
+      write_array(node->get_float2_array(socket));
+      break;
+    case SocketType::TRANSFORM_ARRAY:
+      write_array(node->get_transform_array(socket));
+      break;
+    case SocketType::STRING_ARRAY: {
+      const array<ustring> &value = node->get_string_array(socket);
+      write_value<uint64_t>(value.size());
+      for (size_t i = 0; i < value.size(); i++) {
+        write_string(value[i].string());
+      }
+      break;
+    }
+    case SocketType::NODE_ARRAY: {
+      const array<Node *> &value = node->get_node_array(socket);
+      write_value<uint64_t>(value.size());
+      for (size_t i = 0; i < value.size(); i++) {
+        write_node_ref(value[i]);
+      }
+      break;
+    }
+    case SocketType::CLOSURE:
+    case SocketType::UNDEFINED:
+    case SocketType::NUM_TYPES:
+      break;
+  }
+}
+
+void SceneCacheWriter::write_node(const Node *node)
+{
+  write_string(node->name.string());
+
+  /* Only sockets that differ from their default value are written. Each of them is prefixed
+   * with its name, type and size, so sockets that no longer exist can be skipped on read. */
+  vector<const SocketType *> sockets;
+  foreach (const SocketType &socket, node->type->inputs) {
+    if (socket.type == SocketType::CLOSURE || socket.type == SocketType::UNDEFINED) {
+      continue;
+    }
+    if (!node->has_default_value(socket)) {
+      sockets.push_back(&socket);
+    }
+  }
+
+  write_value<uint>(sockets.size());
+  foreach (const SocketType *socket, sockets) {
+    write_string(socket->name.string());
+    write_value<int>(socket->type);
+
+    const size_t size_offset = data.size();
+    write_value<uint64_t>(0);
+    write_socket(node, *socket);
+
+    const uint64_t size = data.size() - size_offset - sizeof(uint64_t);
+    memcpy(data.data() + size_offset, &size, sizeof(size));
+  }
+}
+
+void SceneCacheWriter::write_attributes(const AttributeSet &attributes)
+{
+  vector<const Attribute *> write_attributes;
+  foreach (const Attribute &attr, attributes.attributes) {
+    if (attr.element != ATTR_ELEMENT_VOXEL) {
+      write_attributes.push_back(&attr);
+    }
+  }
+
+  write_value<uint>(write_attributes.size());
+  foreach (const Attribute *attr, write_attributes) {
+    write_string(attr->name.string());
+    write_value<int>(attr->std);
+    write_value<int>(attr->element);
+    write_value<uint>(attr->flags);
+    write_value<uchar>(attr->type.basetype);
+    write_value<uchar>(attr->type.aggregate);
+    write_value<uchar>(attr->type.vecsemantics);
+    write_value<int>(attr->type.arraylen);
+    write_value<uint64_t>(attr->buffer.size());
+    write(attr->buffer.data(), attr->buffer.size());
+  }
+}
+
+bool scene_cache_write(Scene *scene, const string &filepath)
+{
+  SceneCacheWriter writer;
+
+  writer.write(SCENE_CACHE_MAGIC, sizeof(SCENE_CACHE_MAGIC));
+  writer.write_value(SCENE_CACHE_VERSION);
+  writer.write_value<uint>(sizeof(float3));
+  writer.write_value<uint>(sizeof(Transform));
+
+  /* Shaders, by name only. */
+  writer.write_value<uint>(scene->shaders.size());
+  foreach (const Shader *shader, scene->shaders) {
+    writer.add_node_id(shader);
+    writer.write_string(shader->name.string());
+  }
+
+  /* Geometry. */
+  vector<const Geometry *> geometry;
+  foreach (const Geometry *geom, scene->geometry) {
+    if (geom->geometry_type != Geometry::VOLUME) {
+      geometry.push_back(geom);
+    }
+  }
+
+  writer.write_value<uint>(geometry.size());
+  foreach (const Geometry *geom, geometry) {
+    writer.add_node_id(geom);
+    writer.write_value<int>(geom->geometry_type);
+    writer.write_node(geom);
+    writer.write_attributes(geom->attributes);
+    if (geom->geometry_type == Geometry::MESH) {
+      writer.write_attributes(static_cast<const Mesh *>(geom)->subd_attributes);
+    }
+  }
+
+  /* Lights and objects. Objects are written last, so the geometry they reference is known when
+   * reading them. */
+  writer.write_value<uint>(scene->lights.size());
+  foreach (const Light *light, scene->lights) {
+    writer.add_node_id(light);
+    writer.write_node(light);
+  }
+
+  vector<const Object *> objects;
+  foreach (const Object *object, scene->objects) {
+    if (writer.node_ids.find(object->get_geometry()) != writer.node_ids.end()) {
+      objects.push_back(object);
+    }
+  }
+
+  writer.write_value<uint>(objects.size());
+  foreach (const Object *object, objects) {
+    writer.add_node_id(object);
+    writer.write_node(object);
+  }
+
+  if (!path_write_binary(filepath, writer.data)) {
+    fprintf(stderr, "Failed to write scene cache \"%s\".\n", filepath.c_str());
+    return false;
+  }
+
+  VLOG_INFO << "Wrote scene cache " << filepath << " with " << geometry.size()
+            << " geometry, " << scene->lights.size() << " lights and " << objects.size()
+            << " objects, " << string_human_readable_size(writer.data.size()) << ".";
+
+  return true;
+}
+
+/* Reader */
+
+class SceneCacheReader {
+ public:
+  const vector<uint8_t> &data;
+  size_t offset = 0;
+  bool error = false;
+  vector<Node *> nodes;
+
+  explicit SceneCacheReader(const vector<uint8_t> &data) : data(data) {}
+
+  bool read(void *value, const size_t size)
+  {
+    if (error || size > data.size() - offset) {
+      error = true;
+      return false;
+    }
+    memcpy(value, data.data() + offset, size);
+    offset += size;
+    return true;
+  }
+
+  template<typename T> T read_value()
+  {
+    T value{};
+    read(&value, sizeof(T));
+    return value;
+  }
+
+  string read_string()
+  {
+    const uint size = read_value<uint>();
+    if (error || size > data.size() - offset) {
+      error = true;
+      return string();
+    }
+    string value((const char *)data.data() + offset, size);
+    offset += size;
+    return value;
+  }
+
+  template<typename T> void read_array(array<T> &value)
+  {
+    const uint64_t size = read_value<uint64_t>();
+    if (error || size > (data.size() - offset) / sizeof(T)) {
+      error = true;
+      return;
+    }
+    value.resize(size);
+    read(value.data(), size * sizeof(T));
+  }
+
+  Node *read_node_ref(const NodeType *node_type)
+  {
+    const int id = read_value<int>();
+    if (id < 0 || id >= int(nodes.size())) {
+      return nullptr;
+    }
+    return (nodes[id] && nodes[id]->is_a(node_type)) ? nodes[id] : nullptr;
+  }
+
+  void read_socket(Node *node, const SocketType &socket);
+  void read_node(Node *node);
+  void read_attributes(AttributeSet &attributes);
+};
+
+void SceneCacheReader::read_socket(Node *node, const SocketType &socket)
+{
+  switch (socket.type) {
+    case SocketType::BOOLEAN:
+      node->set(socket, read_value<bool>());
+      break;
+    case SocketType::FLOAT:
+      node->set(socket, read_value<float>());
+      break;
+    case SocketType::INT:
+      node->set(socket, read_value<int>());
+      break;
+    case SocketType::UINT:
+      node->set(socket, read_value<uint>());
+      break;
+    case SocketType::UINT64:
+      node->set(socket, read_value<uint64_t>());
+      break;
+    case SocketType::COLOR:
+    case SocketType::VECTOR:
+    case SocketType::POINT:
+    case SocketType::NORMAL:
+      node->set(socket, read_value<float3>());
+      break;
+    case SocketType::POINT2:
+      node->set(socket, read_value<float2>());
+      break;
+    case SocketType::STRING:
+      node->set(socket, ustring(read_string()));
+      break;
+    case SocketType::ENUM: {
+      ustring value(read_string());
+      if (socket.enum_values->exists(value)) {
+        node->set(socket, value);
+      }
+      break;
+    }
+    case SocketType::TRANSFORM:
+      node->set(socket, read_value<Transform>());
+      break;
+    case SocketType::NODE:
+      node->set(socket, read_node_ref(socket.node_type));
+      break;
+    case SocketType::BOOLEAN_ARRAY: {
+      array<bool> value;
+      read_array(value);
+      node->set(socket, value);
+      break;
+    }
+    case SocketType::FLOAT_ARRAY: {
+      array<float> value;
+      read_array(value);
+      node->set(socket, value);
+      break;
+    }
+    case SocketType::INT_ARRAY: {
+      array<int> value;
+      read_array(value);
+      node->set(socket, value);
+      break;
+    }
+    case SocketType::COLOR_ARRAY:
+    case SocketType::VECTOR_ARRAY:
+    case SocketType::POINT_ARRAY:
+    case SocketType::NORMAL_ARRAY: {
+      array<float3> value;
+      read_array(value);
+      node->set(socket, value);
+      break;
+    }
+    case SocketType::POINT2_ARRAY: {
+      array<float2> value;
+      read_array(value);
+      node->set(socket, value);
+      break;
+    }
+    case SocketType::TRANSFORM_ARRAY: {
+      array<Transform> value;
+      read_array(value);
+      node->set(socket, value);
+      break;
+    }
+    case SocketType::STRING_ARRAY: {
+      const uint64_t size = read_value<uint64_t>();
+      array<ustring> value;
+      for (uint64_t i = 0; i < size && !error; i++) {
+        value.push_back_slow(ustring(read_string()));
+      }
+      node->set(socket, value);
+      break;
+    }
+    case SocketType::NODE_ARRAY: {
+      const uint64_t size = read_value<uint64_t>();
+      array<Node *> value;
+      for (uint64_t i = 0; i < size && !error; i++) {
+        value.push_back_slow(read_node_ref(socket.node_type));
+      }
+      node->set(socket, value);
+      break;
+    }
+    case SocketType::CLOSURE:
+    case SocketType::UNDEFINED:
+    case SocketType::NUM_TYPES:
+      break;
+  }
+}
+
+void SceneCacheReader::read_node(Node *node)
+{
+  node->name = ustring(read_string());
+
+  const uint num_sockets = read_value<uint>();
+  for (uint i = 0; i < num_sockets && !error; i++) {
+    const ustring name(read_string());
+    const int type = read_value<int>();
+    const uint64_t size = read_value<uint64_t>();
+    if (error || size > data.size() - offset) {
+      error = true;
+      break;
+    }
+
+    const size_t end_offset = offset + size;
+    const SocketType *socket = node->type->find_input(name);
+    if (socket && socket->type == type) {
+      read_socket(node, *socket);
+    }
+    else {
+      VLOG_WARNING << "Skipping unknown socket \"" << name << "\" of " << node->type->name
+                   << " in scene cache.";
+    }
+
+    /* Always continue after the stored value, even if it was not fully consumed. */
+    if (!error) {
+      offset = end_offset;
+    }
+  }
+}
+
+void SceneCacheReader::read_attributes(AttributeSet &attributes)
+{
+  const uint num_attributes = read_value<uint>();
+  for (uint i = 0; i < num_attributes && !error; i++) {
+    const ustring name(read_string());
+    const AttributeStandard std = (AttributeStandard)read_value<int>();
+    const AttributeElement element = (AttributeElement)read_value<int>();
+    const uint flags = read_value<uint>();
+    const TypeDesc::BASETYPE basetype = (TypeDesc::BASETYPE)read_value<uchar>();
+    const TypeDesc::AGGREGATE aggregate = (TypeDesc::AGGREGATE)read_value<uchar>();
+    const TypeDesc::VECSEMANTICS vecsemantics = (TypeDesc::VECSEMANTICS)read_value<uchar>();
+    const int arraylen = read_value<int>();
+    const uint64_t size = read_value<uint64_t>();
+    if (error || size > data.size() - offset || element == ATTR_ELEMENT_VOXEL) {
+      error = true;
+      break;
+    }
+
+    Attribute *attr = attributes.add(
+        name, TypeDesc(basetype, aggregate, vecsemantics, arraylen), element);
+    attr->std = std;
+    attr->flags = flags;
+    attr->buffer.assign((const char *)data.data() + offset,
+                        (const char *)data.data() + offset + size);
+    offset += size;
+  }
+}
+
+bool scene_cache_read(Scene *scene, const string &filepath)
+{
+  vector<uint8_t> data;
+  if (!path_read_binary(filepath, data)) {
+    fprintf(stderr, "Failed to read scene cache \"%s\".\n", filepath.c_str());
+    return false;
+  }
+
+  SceneCacheReader reader(data);
+
+  char magic[sizeof(SCENE_CACHE_MAGIC)];
+  reader.read(magic, sizeof(magic));
+  const uint version = reader.read_value<uint>();
+  const uint float3_size = reader.read_value<uint>();
+  const uint transform_size = reader.read_value<uint>();
+
+  if (reader.error || memcmp(magic, SCENE_CACHE_MAGIC, sizeof(magic)) != 0 ||
+      version != SCENE_CACHE_VERSION || float3_size != sizeof(float3) ||
+      transform_size != sizeof(Transform))
+  {
+    fprintf(stderr, "Scene cache \"%s\" is not compatible.\n", filepath.c_str());
+    return false;
+  }
+
+  /* Shaders, resolved by name. Missing shaders fall back to the default surface, so geometry
+   * never ends up with empty shader slots. */
+  map<ustring, Shader *> shader_map;
+  foreach (Shader *shader, scene->shaders) {
+    shader_map[shader->name] = shader;
+  }
+
+  const uint num_shaders = reader.read_value<uint>();
+  for (uint i = 0; i < num_shaders && !reader.error; i++) {
+    const ustring name(reader.read_string());
+    map<ustring, Shader *>::iterator it = shader_map.find(name);
+    if (it == shader_map.end()) {
+      fprintf(stderr, "Shader \"%s\" from scene cache not found.\n", name.c_str());
+    }
+    reader.nodes.push_back((it != shader_map.end()) ? it->second : scene->default_surface);
+  }
+
+  /* Geometry. */
+  const uint num_geometry = reader.read_value<uint>();
+  for (uint i = 0; i < num_geometry && !reader.error; i++) {
+    const Geometry::Type type = (Geometry::Type)reader.read_value<int>();
+
+    Geometry *geom = nullptr;
+    switch (type) {
+      case Geometry::MESH:
+        geom = scene->create_node<Mesh>();
+        break;
+      case Geometry::HAIR:
+        geom = scene->create_node<Hair>();
+        break;
+      case Geometry::POINTCLOUD:
+        geom = scene->create_node<PointCloud>();
+        break;
+      case Geometry::VOLUME:
+        break;
+    }
+
+    if (geom == nullptr) {
+      reader.error = true;
+      break;
+    }
+
+    reader.read_node(geom);
+    reader.read_attributes(geom->attributes);
+    if (type == Geometry::MESH) {
+      reader.read_attributes(static_cast<Mesh *>(geom)->subd_attributes);
+    }
+    reader.nodes.push_back(geom);
+  }
+
+  /* Lights and objects. */
+  const uint num_lights = reader.read_value<uint>();
+  for (uint i = 0; i < num_lights && !reader.error; i++) {
+    Light *light = scene->create_node<Light>();
+    reader.read_node(light);
+    reader.nodes.push_back(light);
+  }
+
+  const uint num_objects = reader.read_value<uint>();
+  for (uint i = 0; i < num_objects && !reader.error; i++) {
+    Object *object = scene->create_node<Object>();
+    reader.read_node(object);
+    reader.nodes.push_back(object);
+  }
+
+  if (reader.error) {
+    fprintf(stderr, "Scene cache \"%s\" is truncated or corrupt.\n", filepath.c_str());
+    return false;
+  }
+
+  VLOG_INFO << "Read scene cache " << filepath << " with " << num_geometry << " geometry, "
+            << num_lights << " lights and " << num_objects << " objects.";
+
+  return true;
+}
+
+CCL_NAMESPACE_END
@@ -0,0 +1,26 @@
+/* SPDX-FileCopyrightText: 2011-2022 Blender Foundation
+ *
+ * SPDX-License-Identifier: Apache-2.0 */
+
+#pragma once
+
+#include "util/string.h"
+
+CCL_NAMESPACE_BEGIN
+
+class Scene;
+
+/* Binary cache of the scene geometry, objects and lights.
+ *
+ * Socket values and attribute buffers are stored as raw memory, so that loading a cache is a
+ * matter of copying arrays instead of exporting and converting the data again. The cache is only
+ * meant to be read by the same Cycles version and architecture that wrote it.
+ *
+ * Shaders are not part of the cache, they are referenced by name and resolved against the
+ * shaders that already exist in the scene when reading. Volumes are skipped, as their voxel
+ * data is stored in images. */
+
+bool scene_cache_write(Scene *scene, const string &filepath);
+bool scene_cache_read(Scene *scene, const string &filepath);
+
+CCL_NAMESPACE_END
@@ -115,6 +115,9 @@ Shader::Shader() : Node(get_node_type())
 
   id = -1;
 
+  svm_nodes_background = false;
+  svm_nodes_referenced = false;
+
   need_update_uvs = true;
   need_update_attribute = true;
   need_update_displacement = true;
@@ -309,6 +312,7 @@ void Shader::set_graph(ShaderGraph *graph_)
   /* assign graph */
   delete graph;
   graph = graph_;
+  svm_nodes.clear();
 
   /* Store info here before graph optimization to make sure that
    * nodes that get optimized away still count. */
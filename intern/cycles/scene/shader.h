@@ -125,6 +125,12 @@ class Shader : public Node {
   /* determined before compiling */
   uint id;
 
+  /* SVM nodes from the last compilation, reused while the shader is not modified. Empty when the
+   * shader needs to be compiled. */
+  array<int4> svm_nodes;
+  bool svm_nodes_background;
+  bool svm_nodes_referenced;
+
 #ifdef WITH_OSL
   /* osl shading state references */
   OSL::ShaderGroupRef osl_surface_ref;
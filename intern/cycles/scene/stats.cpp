@@ -222,6 +222,24 @@ string ImageStats::full_report(int indent_level)
   return result;
 }
 
+/* Device memory statistics. */
+
+DeviceMemoryStats::DeviceMemoryStats() : mapped_host_size(0) {}
+
+string DeviceMemoryStats::full_report(int indent_level)
+{
+  const string indent(indent_level * kIndentNumSpaces, ' ');
+  string result = "";
+  result += indent + "Categories:\n" + categories.full_report(indent_level + 1);
+  if (mapped_host_size > 0) {
+    result += string_printf("%sMapped host memory: %s (%s), out of device memory\n",
+                            indent.c_str(),
+                            string_human_readable_size(mapped_host_size).c_str(),
+                            string_human_readable_number(mapped_host_size).c_str());
+  }
+  return result;
+}
+
 /* Overall statistics. */
 
 RenderStats::RenderStats()
@@ -287,6 +305,7 @@ string RenderStats::full_report()
   string result = "";
   result += "Mesh statistics:\n" + mesh.full_report(1);
   result += "Image statistics:\n" + image.full_report(1);
+  result += "Device memory statistics:\n" + device_memory.full_report(1);
   if (has_profiling) {
     result += "Kernel statistics:\n" + kernel.full_report(1);
     result += "Shader statistics:\n" + shaders.full_report(1);
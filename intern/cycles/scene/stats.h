@@ -161,6 +161,23 @@ class ImageStats {
   NamedSizeStats textures;
 };
 
+/* Statistics about memory used on the render device. */
+class DeviceMemoryStats {
+ public:
+  DeviceMemoryStats();
+
+  /* Generate full human-readable report. */
+  string full_report(int indent_level = 0);
+
+  /* Device memory by category, like BVH, geometry, attributes and textures. Memory which is not
+   * part of the scene, like render buffers and integrator state, is reported as other. */
+  NamedSizeStats categories;
+
+  /* Memory which did not fit on the device and is in host memory mapped into the device address
+   * space instead, which makes rendering a lot slower. */
+  size_t mapped_host_size;
+};
+
 /* Render process statistics. */
 class RenderStats {
  public:
@@ -176,6 +193,7 @@ class RenderStats {
 
   MeshStats mesh;
   ImageStats image;
+  DeviceMemoryStats device_memory;
   NamedNestedSampleStats kernel;
   NamedSampleCountStats shaders;
   NamedSampleCountStats objects;
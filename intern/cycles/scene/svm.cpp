@@ -27,12 +27,14 @@ SVMShaderManager::SVMShaderManager() {}
 
 SVMShaderManager::~SVMShaderManager() {}
 
-void SVMShaderManager::reset(Scene * /*scene*/) {}
+void SVMShaderManager::reset(Scene *scene)
+{
+  foreach (Shader *shader, scene->shaders) {
+    shader->svm_nodes.clear();
+  }
+}
 
-void SVMShaderManager::device_update_shader(Scene *scene,
-                                            Shader *shader,
-                                            Progress *progress,
-                                            array<int4> *svm_nodes)
+void SVMShaderManager::device_update_shader(Scene *scene, Shader *shader, Progress *progress)
 {
   if (progress->get_cancel()) {
     return;
@@ -42,7 +44,21 @@ void SVMShaderManager::device_update_shader(Scene *scene,
   SVMCompiler::Summary summary;
   SVMCompiler compiler(scene);
   compiler.background = (shader == scene->background->get_shader(scene));
-  compiler.compile(shader, *svm_nodes, 0, &summary);
+
+  /* Reuse the nodes of the previous compilation when nothing changed. Image and IES slots are
+   * kept by the nodes of the graph, so they stay valid as well. */
+  const bool referenced = shader->reference_count() != 0;
+  if (!shader->is_modified() && shader->svm_nodes.size() != 0 &&
+      shader->svm_nodes_background == compiler.background &&
+      shader->svm_nodes_referenced == referenced)
+  {
+    return;
+  }
+
+  shader->svm_nodes.clear();
+  shader->svm_nodes_background = compiler.background;
+  shader->svm_nodes_referenced = referenced;
+  compiler.compile(shader, shader->svm_nodes, 0, &summary);
 
   VLOG_WORK << "Compilation summary:\n"
             << "Shader name: " << shader->name << "\n"
@@ -75,14 +91,9 @@ void SVMShaderManager::device_update_specific(Device *device,
 
   /* Build all shaders. */
   TaskPool task_pool;
-  vector<array<int4>> shader_svm_nodes(num_shaders);
   for (int i = 0; i < num_shaders; i++) {
-    task_pool.push(function_bind(&SVMShaderManager::device_update_shader,
-                                 this,
-                                 scene,
-                                 scene->shaders[i],
-                                 &progress,
-                                 &shader_svm_nodes[i]));
+    task_pool.push(function_bind(
+        &SVMShaderManager::device_update_shader, this, scene, scene->shaders[i], &progress));
   }
   task_pool.wait_work();
 
@@ -95,7 +106,7 @@ void SVMShaderManager::device_update_specific(Device *device,
   int svm_nodes_size = num_shaders;
   for (int i = 0; i < num_shaders; i++) {
     /* Since we're not copying the local jump node, the size ends up being one node lower. */
-    svm_nodes_size += shader_svm_nodes[i].size() - 1;
+    svm_nodes_size += scene->shaders[i]->svm_nodes.size() - 1;
   }
 
   int4 *svm_nodes = dscene->svm_nodes.alloc(svm_nodes_size);
@@ -113,22 +124,22 @@ void SVMShaderManager::device_update_specific(Device *device,
      * Each compiled shader starts with a jump node that has offsets local
      * to the shader, so copy those and add the offset into the global node list. */
     int4 &global_jump_node = svm_nodes[shader->id];
-    int4 &local_jump_node = shader_svm_nodes[i][0];
+    const int4 &local_jump_node = shader->svm_nodes[0];
 
     global_jump_node.x = NODE_SHADER_JUMP;
     global_jump_node.y = local_jump_node.y - 1 + node_offset;
     global_jump_node.z = local_jump_node.z - 1 + node_offset;
     global_jump_node.w = local_jump_node.w - 1 + node_offset;
 
-    node_offset += shader_svm_nodes[i].size() - 1;
+    node_offset += shader->svm_nodes.size() - 1;
   }
 
   /* Copy the nodes of each shader into the correct location. */
   svm_nodes += num_shaders;
   for (int i = 0; i < num_shaders; i++) {
-    int shader_size = shader_svm_nodes[i].size() - 1;
+    int shader_size = scene->shaders[i]->svm_nodes.size() - 1;
 
-    memcpy(svm_nodes, &shader_svm_nodes[i][1], sizeof(int4) * shader_size);
+    memcpy(svm_nodes, &scene->shaders[i]->svm_nodes[1], sizeof(int4) * shader_size);
     svm_nodes += shader_size;
   }
 
@@ -41,10 +41,7 @@ class SVMShaderManager : public ShaderManager {
   void device_free(Device *device, DeviceScene *dscene, Scene *scene) override;
 
  protected:
-  void device_update_shader(Scene *scene,
-                            Shader *shader,
-                            Progress *progress,
-                            array<int4> *svm_nodes);
+  void device_update_shader(Scene *scene, Shader *shader, Progress *progress);
 };
 
 /* Graph Compiler */
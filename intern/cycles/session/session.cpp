@@ -12,10 +12,13 @@
 #include "scene/background.h"
 #include "scene/bake.h"
 #include "scene/camera.h"
+#include "scene/image.h"
 #include "scene/integrator.h"
 #include "scene/light.h"
 #include "scene/mesh.h"
 #include "scene/object.h"
+#include "scene/particles.h"
+#include "scene/procedural.h"
 #include "scene/scene.h"
 #include "scene/shader_graph.h"
 #include "session/buffers.h"
@@ -50,6 +53,10 @@ Session::Session(const SessionParams &params_, const SceneParams &scene_params)
 
   scene = new Scene(scene_params, device);
 
+  /* Show a first look with low resolution textures in interactive renders, before loading them at
+   * full resolution. */
+  scene->image_manager->set_use_preview_resolution(!params.background);
+
   /* Configure path tracer. */
   path_trace_ = make_unique<PathTrace>(
       device, scene->film, &scene->dscene, render_scheduler_, tile_manager_);
@@ -213,9 +220,34 @@ void Session::run_main_render_loop()
     if (did_cancel) {
       break;
     }
+
+    if (!params.background) {
+      run_update_full_resolution_images();
+    }
   }
 }
 
+void Session::run_update_full_resolution_images()
+{
+  thread_scoped_lock scene_lock(scene->mutex);
+  thread_scoped_lock reset_lock(delayed_reset_.mutex);
+
+  /* Don't override a reset requested by the host application. */
+  if (delayed_reset_.do_reset) {
+    return;
+  }
+
+  if (!scene->image_manager->tag_full_resolution_update()) {
+    return;
+  }
+
+  /* Start over once the images are loaded at full resolution, so no samples are accumulated from
+   * the low resolution images. */
+  delayed_reset_.do_reset = true;
+  delayed_reset_.session_params = params;
+  delayed_reset_.buffer_params = buffer_params_;
+}
+
 void Session::thread_run()
 {
   while (true) {
@@ -336,8 +368,20 @@ RenderWork Session::run_update_for_next_iteration()
   /* Update path guiding. */
   {
     const GuidingParams guiding_params = scene->integrator->get_guiding_params(device);
-    const bool guiding_reset = (guiding_params.use) ? scene->need_reset(false) : false;
-    path_trace_->set_guiding_params(guiding_params, guiding_reset);
+    /* The guiding field represents the incident radiance in world space, so it only needs to be
+     * trained from scratch when geometry or objects change. For other changes, like materials,
+     * lights or the world, the current field is a good starting point and training continues
+     * from it. Camera changes don't affect the field at all. */
+    bool guiding_reset = false;
+    bool guiding_retrain = false;
+    if (guiding_params.use) {
+      guiding_reset = scene->geometry_manager->need_update() ||
+                      scene->object_manager->need_update() ||
+                      scene->particle_system_manager->need_update() ||
+                      scene->procedural_manager->need_update();
+      guiding_retrain = !guiding_reset && scene->need_reset(false);
+    }
+    path_trace_->set_guiding_params(guiding_params, guiding_reset, guiding_retrain);
   }
 
   render_scheduler_.set_num_samples(params.samples);
@@ -716,6 +760,14 @@ void Session::update_status_time(bool show_pause, bool show_done)
     substatus += string_printf(" (%s)", device_status.c_str());
   }
 
+  /* Make it clear why rendering may be much slower than expected. */
+  if (stats.mem_mapped_host > 0) {
+    substatus = status_append(
+        substatus,
+        "Out of device memory, using " + string_human_readable_size(stats.mem_mapped_host) +
+            " of system memory");
+  }
+
   /* TODO(sergey): Denoising status from the path trace. */
 
   if (show_pause) {
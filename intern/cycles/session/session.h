@@ -192,6 +192,10 @@ class Session {
    * checking the pause. */
   bool run_wait_for_work(const RenderWork &render_work);
 
+  /* Tag images that were loaded at preview resolution for the first look to be loaded at full
+   * resolution, and request a reset to restart rendering with them. */
+  void run_update_full_resolution_images();
+
   void run_main_render_loop();
 
   bool update_scene(int width, int height);
@@ -0,0 +1,65 @@
+/* SPDX-FileCopyrightText: 2011-2022 Blender Foundation
+ *
+ * SPDX-License-Identifier: Apache-2.0 */
+
+#include "testing/testing.h"
+
+#include "integrator/work_balancer.h"
+
+CCL_NAMESPACE_BEGIN
+
+/* Simulate rendering with the given throughput per device, as fraction of the work per second. */
+static void simulate_render(vector<WorkBalanceInfo> &infos, const vector<double> &throughputs)
+{
+  for (size_t i = 0; i < infos.size(); i++) {
+    infos[i].time_spent = infos[i].weight / throughputs[i];
+  }
+}
+
+TEST(work_balance_do_rebalance, EqualDevices)
+{
+  vector<WorkBalanceInfo> infos(2);
+  work_balance_do_initial(infos);
+  simulate_render(infos, {1.0, 1.0});
+
+  EXPECT_FALSE(work_balance_do_rebalance(infos));
+  EXPECT_EQ(infos[0].weight, 0.5);
+  EXPECT_EQ(infos[1].weight, 0.5);
+}
+
+TEST(work_balance_do_rebalance, NoStatistics)
+{
+  vector<WorkBalanceInfo> infos(2);
+  work_balance_do_initial(infos);
+  infos[0].time_spent = 1.0;
+
+  EXPECT_FALSE(work_balance_do_rebalance(infos));
+  EXPECT_EQ(infos[0].weight, 0.5);
+  EXPECT_EQ(infos[1].weight, 0.5);
+}
+
+TEST(work_balance_do_rebalance, Converge)
+{
+  /* A device ten times faster than the other. */
+  const vector<double> throughputs = {10.0, 1.0};
+
+  vector<WorkBalanceInfo> infos(2);
+  work_balance_do_initial(infos);
+
+  simulate_render(infos, throughputs);
+  EXPECT_TRUE(work_balance_do_rebalance(infos));
+  EXPECT_NEAR(infos[0].weight, 0.5 + 0.75 * (10.0 / 11.0 - 0.5), 1e-6);
+  EXPECT_NEAR(infos[0].weight + infos[1].weight, 1.0, 1e-6);
+  EXPECT_EQ(infos[0].time_spent, 0.0);
+
+  for (int i = 0; i < 3; i++) {
+    simulate_render(infos, throughputs);
+    work_balance_do_rebalance(infos);
+  }
+  EXPECT_NEAR(infos[0].weight, 10.0 / 11.0, 1e-2);
+
+  simulate_render(infos, throughputs);
+  EXPECT_FALSE(work_balance_do_rebalance(infos));
+}
+
+CCL_NAMESPACE_END
@@ -14,7 +14,7 @@ class Stats {
  public:
   enum static_init_t { static_init = 0 };
 
-  Stats() : mem_used(0), mem_peak(0) {}
+  Stats() : mem_used(0), mem_peak(0), mem_mapped_host(0) {}
   explicit Stats(static_init_t) {}
 
   void mem_alloc(size_t size)
@@ -29,8 +29,22 @@ class Stats {
     atomic_sub_and_fetch_z(&mem_used, size);
   }
 
+  void mem_alloc_mapped_host(size_t size)
+  {
+    atomic_add_and_fetch_z(&mem_mapped_host, size);
+  }
+
+  void mem_free_mapped_host(size_t size)
+  {
+    assert(mem_mapped_host >= size);
+    atomic_sub_and_fetch_z(&mem_mapped_host, size);
+  }
+
   size_t mem_used;
   size_t mem_peak;
+  /* Part of the used memory which did not fit on the device, and is in host memory mapped into
+   * the device address space instead. */
+  size_t mem_mapped_host;
 };
 
 CCL_NAMESPACE_END
@@ -185,6 +185,36 @@ extern void (*MEM_reset_peak_memory)(void);
 /** Get the peak memory usage in bytes, including `mmap` allocations. */
 extern size_t (*MEM_get_peak_memory)(void) ATTR_WARN_UNUSED_RESULT;
 
+/**
+ * Subsystems that allocated memory can be attributed to. Every block stores the tag that was
+ * active on the allocating thread, which gives a rough breakdown of the memory usage without
+ * having to use the guarded allocator and its per-block names.
+ */
+typedef enum eMEM_Tag {
+  MEM_TAG_NONE = 0,
+  MEM_TAG_DEPSGRAPH = 1,
+  MEM_TAG_DRAW = 2,
+  MEM_TAG_UNDO = 3,
+  MEM_TAG_IMAGE = 4,
+  MEM_TAG_GEOMETRY_NODES = 5,
+} eMEM_Tag;
+#define MEM_TAG_NUM (MEM_TAG_GEOMETRY_NODES + 1)
+
+/**
+ * Set the tag of allocations done by the calling thread and return the previous one, which should
+ * be restored afterwards. Work that is moved to other threads (e.g. by a task pool) does not
+ * inherit the tag. In C++ #MEM_TagScope should be used instead.
+ */
+eMEM_Tag MEM_tag_set(eMEM_Tag tag);
+/** Get a readable name of the tag, for printing statistics. */
+const char *MEM_tag_name(eMEM_Tag tag);
+
+/**
+ * Get the number of bytes in use by blocks that were allocated with the given tag. For
+ * #MEM_TAG_NONE this is the memory that is not attributed to any subsystem.
+ */
+extern size_t (*MEM_get_memory_in_use_for_tag)(eMEM_Tag tag) ATTR_WARN_UNUSED_RESULT;
+
 #ifdef __cplusplus
 #  define MEM_SAFE_FREE(v) \
     do { \
@@ -283,6 +313,25 @@ void MEM_use_guarded_allocator(void);
     (__STDCPP_DEFAULT_NEW_ALIGNMENT__ < alignof(void *) ? __STDCPP_DEFAULT_NEW_ALIGNMENT__ : \
                                                           alignof(void *))
 
+/**
+ * Attribute all allocations of the calling thread to the given subsystem until the end of the
+ * scope. Scopes can be nested, the previous tag is restored on destruction.
+ */
+class MEM_TagScope {
+ private:
+  eMEM_Tag prev_tag_;
+
+ public:
+  explicit MEM_TagScope(const eMEM_Tag tag) : prev_tag_(MEM_tag_set(tag)) {}
+  ~MEM_TagScope()
+  {
+    MEM_tag_set(prev_tag_);
+  }
+
+  MEM_TagScope(const MEM_TagScope &other) = delete;
+  MEM_TagScope &operator=(const MEM_TagScope &other) = delete;
+};
+
 /**
  * Allocate new memory for and constructs an object of type #T.
  * #MEM_delete should be used to delete the object. Just calling #MEM_freeN is not enough when #T
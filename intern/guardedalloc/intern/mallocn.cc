@@ -56,6 +56,7 @@ size_t (*MEM_get_memory_in_use)(void) = MEM_lockfree_get_memory_in_use;
 uint (*MEM_get_memory_blocks_in_use)(void) = MEM_lockfree_get_memory_blocks_in_use;
 void (*MEM_reset_peak_memory)(void) = MEM_lockfree_reset_peak_memory;
 size_t (*MEM_get_peak_memory)(void) = MEM_lockfree_get_peak_memory;
+size_t (*MEM_get_memory_in_use_for_tag)(eMEM_Tag tag) = MEM_lockfree_get_memory_in_use_for_tag;
 
 void (*mem_clearmemlist)(void) = mem_lockfree_clearmemlist;
 
@@ -64,6 +65,35 @@ const char *(*MEM_name_ptr)(void *vmemh) = MEM_lockfree_name_ptr;
 void (*MEM_name_ptr_set)(void *vmemh, const char *str) = MEM_lockfree_name_ptr_set;
 #endif
 
+thread_local eMEM_Tag mem_tag_current = MEM_TAG_NONE;
+
+eMEM_Tag MEM_tag_set(const eMEM_Tag tag)
+{
+  assert(uint(tag) < MEM_TAG_NUM);
+  const eMEM_Tag prev_tag = mem_tag_current;
+  mem_tag_current = tag;
+  return prev_tag;
+}
+
+const char *MEM_tag_name(const eMEM_Tag tag)
+{
+  switch (tag) {
+    case MEM_TAG_NONE:
+      return "Other";
+    case MEM_TAG_DEPSGRAPH:
+      return "Dependency Graph";
+    case MEM_TAG_DRAW:
+      return "Draw";
+    case MEM_TAG_UNDO:
+      return "Undo";
+    case MEM_TAG_IMAGE:
+      return "Image";
+    case MEM_TAG_GEOMETRY_NODES:
+      return "Geometry Nodes";
+  }
+  return "Unknown";
+}
+
 void *aligned_malloc(size_t size, size_t alignment)
 {
   /* #posix_memalign requires alignment to be a multiple of `sizeof(void *)`. */
@@ -141,6 +171,7 @@ void MEM_use_lockfree_allocator()
   MEM_get_memory_blocks_in_use = MEM_lockfree_get_memory_blocks_in_use;
   MEM_reset_peak_memory = MEM_lockfree_reset_peak_memory;
   MEM_get_peak_memory = MEM_lockfree_get_peak_memory;
+  MEM_get_memory_in_use_for_tag = MEM_lockfree_get_memory_in_use_for_tag;
 
   mem_clearmemlist = mem_lockfree_clearmemlist;
 
@@ -176,6 +207,7 @@ void MEM_use_guarded_allocator()
   MEM_get_memory_blocks_in_use = MEM_guarded_get_memory_blocks_in_use;
   MEM_reset_peak_memory = MEM_guarded_reset_peak_memory;
   MEM_get_peak_memory = MEM_guarded_get_peak_memory;
+  MEM_get_memory_in_use_for_tag = MEM_guarded_get_memory_in_use_for_tag;
 
   mem_clearmemlist = mem_guarded_clearmemlist;
 
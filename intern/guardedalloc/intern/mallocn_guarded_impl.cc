@@ -112,7 +112,8 @@ typedef struct MemHead {
   const char *name;
   const char *nextname;
   int tag2;
-  short pad1;
+  /* #eMEM_Tag of the thread that allocated the block. */
+  short mem_tag;
   /* if non-zero aligned allocation was used and alignment is stored here. */
   short alignment;
 #ifdef DEBUG_MEMCOUNTER
@@ -175,6 +176,7 @@ static const char *check_memlist(const MemHead *memh);
 
 static uint totblock = 0;
 static size_t mem_in_use = 0, peak_mem = 0;
+static size_t mem_in_use_per_tag[MEM_TAG_NUM] = {0};
 
 static volatile localListBase _membase;
 static volatile localListBase *membase = &_membase;
@@ -422,7 +424,7 @@ static void make_memhead_header(MemHead *memh, size_t len, const char *str)
   memh->name = str;
   memh->nextname = nullptr;
   memh->len = len;
-  memh->pad1 = 0;
+  memh->mem_tag = short(mem_tag_current);
   memh->alignment = 0;
   memh->tag2 = MEMTAG2;
 
@@ -439,6 +441,7 @@ static void make_memhead_header(MemHead *memh, size_t len, const char *str)
 
   atomic_add_and_fetch_u(&totblock, 1);
   atomic_add_and_fetch_z(&mem_in_use, len);
+  atomic_add_and_fetch_z(&mem_in_use_per_tag[memh->mem_tag], len);
 
   mem_lock_thread();
   addtail(membase, &memh->next);
@@ -761,6 +764,11 @@ void MEM_guarded_printmemlist_stats()
   printf("\ntotal memory len: %.3f MB\n", double(mem_in_use) / double(1024 * 1024));
   printf("peak memory len: %.3f MB\n", double(peak_mem) / double(1024 * 1024));
   printf("slop memory len: %.3f MB\n", double(mem_in_use_slop) / double(1024 * 1024));
+  for (int tag = 0; tag < MEM_TAG_NUM; tag++) {
+    printf("  %s: %.3f MB\n",
+           MEM_tag_name(eMEM_Tag(tag)),
+           double(mem_in_use_per_tag[tag]) / double(1024 * 1024));
+  }
   printf(" ITEMS TOTAL-MiB AVERAGE-KiB TYPE\n");
   for (a = 0, pb = printblock; a < totpb; a++, pb++) {
     printf("%6d (%8.3f  %8.3f) %s\n",
@@ -1074,6 +1082,7 @@ static void rem_memblock(MemHead *memh)
 
   atomic_sub_and_fetch_u(&totblock, 1);
   atomic_sub_and_fetch_z(&mem_in_use, memh->len);
+  atomic_sub_and_fetch_z(&mem_in_use_per_tag[memh->mem_tag], memh->len);
 
 #ifdef DEBUG_MEMDUPLINAME
   if (memh->need_free_name)
@@ -1261,6 +1270,17 @@ size_t MEM_guarded_get_memory_in_use()
   return _mem_in_use;
 }
 
+size_t MEM_guarded_get_memory_in_use_for_tag(const eMEM_Tag tag)
+{
+  size_t _mem_in_use;
+
+  mem_lock_thread();
+  _mem_in_use = mem_in_use_per_tag[tag];
+  mem_unlock_thread();
+
+  return _mem_in_use;
+}
+
 uint MEM_guarded_get_memory_blocks_in_use()
 {
   uint _totblock;
@@ -110,10 +110,11 @@ extern bool leak_detector_has_run;
 extern char free_after_leak_detection_message[];
 
 void memory_usage_init(void);
-void memory_usage_block_alloc(size_t size);
-void memory_usage_block_free(size_t size);
+void memory_usage_block_alloc(size_t size, eMEM_Tag tag);
+void memory_usage_block_free(size_t size, eMEM_Tag tag);
 size_t memory_usage_block_num(void);
 size_t memory_usage_current(void);
+size_t memory_usage_current_for_tag(eMEM_Tag tag);
 size_t memory_usage_peak(void);
 void memory_usage_peak_reset(void);
 
@@ -171,6 +172,7 @@ size_t MEM_lockfree_get_memory_in_use(void);
 unsigned int MEM_lockfree_get_memory_blocks_in_use(void);
 void MEM_lockfree_reset_peak_memory(void);
 size_t MEM_lockfree_get_peak_memory(void) ATTR_WARN_UNUSED_RESULT;
+size_t MEM_lockfree_get_memory_in_use_for_tag(eMEM_Tag tag) ATTR_WARN_UNUSED_RESULT;
 
 void mem_lockfree_clearmemlist(void);
 
@@ -220,6 +222,7 @@ size_t MEM_guarded_get_memory_in_use(void);
 unsigned int MEM_guarded_get_memory_blocks_in_use(void);
 void MEM_guarded_reset_peak_memory(void);
 size_t MEM_guarded_get_peak_memory(void) ATTR_WARN_UNUSED_RESULT;
+size_t MEM_guarded_get_memory_in_use_for_tag(eMEM_Tag tag) ATTR_WARN_UNUSED_RESULT;
 
 void mem_guarded_clearmemlist(void);
 
@@ -230,6 +233,9 @@ void MEM_guarded_name_ptr_set(void *vmemh, const char *str);
 
 #ifdef __cplusplus
 }
+
+/** Tag that is stored in blocks allocated by the current thread, see #MEM_tag_set. */
+extern thread_local eMEM_Tag mem_tag_current;
 #endif
 
 #endif /* __MALLOCN_INTERN_H__ */
@@ -54,7 +54,15 @@ enum {
 #define PTR_FROM_MEMHEAD(memhead) (memhead + 1)
 #define MEMHEAD_ALIGNED_FROM_PTR(ptr) (((MemHeadAligned *)ptr) - 1)
 #define MEMHEAD_IS_ALIGNED(memhead) ((memhead)->len & size_t(MEMHEAD_ALIGN_FLAG))
-#define MEMHEAD_LEN(memhead) ((memhead)->len & ~size_t(MEMHEAD_ALIGN_FLAG))
+/* The #eMEM_Tag of the block is stored in the highest bits of the length, which are never needed
+ * for the size of an actual allocation. */
+#define MEMHEAD_TAG_SHIFT (sizeof(size_t) * 8 - 4)
+#define MEMHEAD_TAG_MASK (size_t(0xf) << MEMHEAD_TAG_SHIFT)
+#define MEMHEAD_TAG(memhead) eMEM_Tag((memhead)->len >> MEMHEAD_TAG_SHIFT)
+#define MEMHEAD_TAG_BITS(tag) (size_t(tag) << MEMHEAD_TAG_SHIFT)
+#define MEMHEAD_LEN(memhead) \
+  ((memhead)->len & ~(size_t(MEMHEAD_ALIGN_FLAG) | MEMHEAD_TAG_MASK))
+static_assert(MEM_TAG_NUM <= 16, "Tags don't fit into MemHead");
 
 #ifdef __GNUC__
 __attribute__((format(printf, 1, 2)))
@@ -101,7 +109,7 @@ void MEM_lockfree_freeN(void *vmemh)
   MemHead *memh = MEMHEAD_FROM_PTR(vmemh);
   size_t len = MEMHEAD_LEN(memh);
 
-  memory_usage_block_free(len);
+  memory_usage_block_free(len, MEMHEAD_TAG(memh));
 
   if (UNLIKELY(malloc_debug_memset && len)) {
     memset(memh + 1, 255, len);
@@ -220,8 +228,9 @@ void *MEM_lockfree_callocN(size_t len, const char *str)
   memh = (MemHead *)calloc(1, len + sizeof(MemHead));
 
   if (LIKELY(memh)) {
-    memh->len = len;
-    memory_usage_block_alloc(len);
+    const eMEM_Tag tag = mem_tag_current;
+    memh->len = len | MEMHEAD_TAG_BITS(tag);
+    memory_usage_block_alloc(len, tag);
 
     return PTR_FROM_MEMHEAD(memh);
   }
@@ -277,8 +286,9 @@ void *MEM_lockfree_mallocN(size_t len, const char *str)
 #endif /* WITH_MEM_VALGRIND */
     }
 
-    memh->len = len;
-    memory_usage_block_alloc(len);
+    const eMEM_Tag tag = mem_tag_current;
+    memh->len = len | MEMHEAD_TAG_BITS(tag);
+    memory_usage_block_alloc(len, tag);
 
     return PTR_FROM_MEMHEAD(memh);
   }
@@ -358,9 +368,10 @@ void *MEM_lockfree_mallocN_aligned(size_t len, size_t alignment, const char *str
 #endif /* WITH_MEM_VALGRIND */
     }
 
-    memh->len = len | size_t(MEMHEAD_ALIGN_FLAG);
+    const eMEM_Tag tag = mem_tag_current;
+    memh->len = len | size_t(MEMHEAD_ALIGN_FLAG) | MEMHEAD_TAG_BITS(tag);
     memh->alignment = short(alignment);
-    memory_usage_block_alloc(len);
+    memory_usage_block_alloc(len, tag);
 
     return PTR_FROM_MEMHEAD(memh);
   }
@@ -417,6 +428,11 @@ void MEM_lockfree_printmemlist_stats()
 {
   printf("\ntotal memory len: %.3f MB\n", double(memory_usage_current()) / double(1024 * 1024));
   printf("peak memory len: %.3f MB\n", double(memory_usage_peak()) / double(1024 * 1024));
+  for (int tag = 0; tag < MEM_TAG_NUM; tag++) {
+    printf("  %s: %.3f MB\n",
+           MEM_tag_name(eMEM_Tag(tag)),
+           double(memory_usage_current_for_tag(eMEM_Tag(tag))) / double(1024 * 1024));
+  }
   printf(
       "\nFor more detailed per-block statistics run Blender with memory debugging command line "
       "argument.\n");
@@ -463,6 +479,11 @@ size_t MEM_lockfree_get_peak_memory()
   return memory_usage_peak();
 }
 
+size_t MEM_lockfree_get_memory_in_use_for_tag(const eMEM_Tag tag)
+{
+  return memory_usage_current_for_tag(tag);
+}
+
 #ifndef NDEBUG
 const char *MEM_lockfree_name_ptr(void *vmemh)
 {
@@ -54,6 +54,11 @@ struct alignas(128) Local {
    * accurate, but it's still good enough for practical purposes.
    */
   std::atomic<int64_t> mem_in_use_during_peak_update = 0;
+  /**
+   * Number of bytes per #eMEM_Tag. Like #mem_in_use this can be negative. Blocks without a tag are
+   * not counted here, to avoid the overhead for the majority of allocations.
+   */
+  std::atomic<int64_t> mem_in_use_per_tag[MEM_TAG_NUM] = {};
 
   Local();
   ~Local();
@@ -90,6 +95,10 @@ struct Global {
    * Number of blocks that are not tracked by #Local, for the same reason as above.
    */
   std::atomic<int64_t> blocks_num_outside_locals = 0;
+  /**
+   * Number of bytes per #eMEM_Tag that are not tracked by #Local, for the same reason as above.
+   */
+  std::atomic<int64_t> mem_in_use_per_tag_outside_locals[MEM_TAG_NUM] = {};
   /**
    * Peak memory usage since the last reset.
    */
@@ -152,6 +161,10 @@ Local::~Local()
   /* Don't forget the memory counts stored locally. */
   this->global->blocks_num_outside_locals.fetch_add(this->blocks_num, std::memory_order_relaxed);
   this->global->mem_in_use_outside_locals.fetch_add(this->mem_in_use, std::memory_order_relaxed);
+  for (int tag = 0; tag < MEM_TAG_NUM; tag++) {
+    this->global->mem_in_use_per_tag_outside_locals[tag].fetch_add(
+        this->mem_in_use_per_tag[tag], std::memory_order_relaxed);
+  }
 
   if (this->is_main) {
     /* The main thread started shutting down. Use global counters from now on to avoid accessing
@@ -166,26 +179,34 @@ Local::~Local()
 static void update_global_peak()
 {
   Global &global = get_global();
-  /* Update peak. */
-  global.peak = std::max<size_t>(global.peak, memory_usage_current());
-
-  std::lock_guard lock{global.locals_mutex};
-
-  for (Local *local : global.locals) {
-    assert(!local->destructed);
-    /* Updating this makes sure that the peak is not updated too often, which would degrade
-     * performance. */
-    local->mem_in_use_during_peak_update = local->mem_in_use.load(std::memory_order_relaxed);
+  const size_t current = memory_usage_current();
+  size_t peak = global.peak.load(std::memory_order_relaxed);
+  while (current > peak &&
+         !global.peak.compare_exchange_weak(peak, current, std::memory_order_relaxed))
+  {
   }
 }
 
+/**
+ * Same as above, but also remember the memory usage of the calling thread. Only the counters of
+ * this thread are written, so that frequently allocating threads don't write into the cache lines
+ * of all other threads, which would make them contend with each other.
+ */
+static void update_global_peak_from_local(Local &local)
+{
+  /* Updating this makes sure that the peak is not updated too often, which would degrade
+   * performance. */
+  local.mem_in_use_during_peak_update = local.mem_in_use.load(std::memory_order_relaxed);
+  update_global_peak();
+}
+
 void memory_usage_init()
 {
   /* Makes sure that the static and thread-local variables on the main thread are initialized. */
   get_local_data();
 }
 
-void memory_usage_block_alloc(const size_t size)
+void memory_usage_block_alloc(const size_t size, const eMEM_Tag tag)
 {
   if (LIKELY(use_local_counters.load(std::memory_order_relaxed))) {
     Local &local = get_local_data();
@@ -195,10 +216,13 @@ void memory_usage_block_alloc(const size_t size)
      * time, which is very rare compared to doing allocations. */
     local.blocks_num.fetch_add(1, std::memory_order_relaxed);
     local.mem_in_use.fetch_add(int64_t(size), std::memory_order_relaxed);
+    if (tag != MEM_TAG_NONE) {
+      local.mem_in_use_per_tag[tag].fetch_add(int64_t(size), std::memory_order_relaxed);
+    }
 
     /* If a certain amount of new memory has been allocated, update the peak. */
     if (local.mem_in_use - local.mem_in_use_during_peak_update > peak_update_threshold) {
-      update_global_peak();
+      update_global_peak_from_local(local);
     }
   }
   else {
@@ -206,10 +230,14 @@ void memory_usage_block_alloc(const size_t size)
     /* Increase global memory counts. */
     global.blocks_num_outside_locals.fetch_add(1, std::memory_order_relaxed);
     global.mem_in_use_outside_locals.fetch_add(int64_t(size), std::memory_order_relaxed);
+    if (tag != MEM_TAG_NONE) {
+      global.mem_in_use_per_tag_outside_locals[tag].fetch_add(int64_t(size),
+                                                              std::memory_order_relaxed);
+    }
   }
 }
 
-void memory_usage_block_free(const size_t size)
+void memory_usage_block_free(const size_t size, const eMEM_Tag tag)
 {
   if (LIKELY(use_local_counters)) {
     /* Decrease local memory counts. See comment in #memory_usage_block_alloc for details regarding
@@ -217,12 +245,19 @@ void memory_usage_block_free(const size_t size)
     Local &local = get_local_data();
     local.mem_in_use.fetch_sub(int64_t(size), std::memory_order_relaxed);
     local.blocks_num.fetch_sub(1, std::memory_order_relaxed);
+    if (tag != MEM_TAG_NONE) {
+      local.mem_in_use_per_tag[tag].fetch_sub(int64_t(size), std::memory_order_relaxed);
+    }
   }
   else {
     Global &global = get_global();
     /* Decrease global memory counts. */
     global.blocks_num_outside_locals.fetch_sub(1, std::memory_order_relaxed);
     global.mem_in_use_outside_locals.fetch_sub(int64_t(size), std::memory_order_relaxed);
+    if (tag != MEM_TAG_NONE) {
+      global.mem_in_use_per_tag_outside_locals[tag].fetch_sub(int64_t(size),
+                                                              std::memory_order_relaxed);
+    }
   }
 }
 
@@ -252,6 +287,29 @@ size_t memory_usage_current()
   return size_t(mem_in_use);
 }
 
+size_t memory_usage_current_for_tag(const eMEM_Tag tag)
+{
+  if (tag == MEM_TAG_NONE) {
+    /* Untagged blocks are not counted separately. */
+    size_t tagged = 0;
+    for (int i = MEM_TAG_NONE + 1; i < MEM_TAG_NUM; i++) {
+      tagged += memory_usage_current_for_tag(eMEM_Tag(i));
+    }
+    const size_t total = memory_usage_current();
+    return total - std::min(tagged, total);
+  }
+
+  Global &global = get_global();
+  std::lock_guard lock{global.locals_mutex};
+
+  int64_t mem_in_use = global.mem_in_use_per_tag_outside_locals[tag];
+  for (const Local *local : global.locals) {
+    mem_in_use += local->mem_in_use_per_tag[tag];
+  }
+  /* Individual threads may see a negative count, the total should never be negative. */
+  return size_t(std::max<int64_t>(mem_in_use, 0));
+}
+
 /**
  * Get the approximate peak memory usage since the last call to #memory_usage_peak_reset.
  * This is approximate, because the peak usage is not updated after every allocation (see
@@ -272,4 +330,10 @@ void memory_usage_peak_reset()
 {
   Global &global = get_global();
   global.peak = memory_usage_current();
+
+  std::lock_guard lock{global.locals_mutex};
+  for (Local *local : global.locals) {
+    assert(!local->destructed);
+    local->mem_in_use_during_peak_update = local->mem_in_use.load(std::memory_order_relaxed);
+  }
 }
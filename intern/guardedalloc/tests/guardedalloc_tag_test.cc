@@ -0,0 +1,51 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0 */
+
+#include "testing/testing.h"
+
+#include "MEM_guardedalloc.h"
+#include "guardedalloc_test_base.h"
+
+namespace {
+
+void DoBasicTagChecks()
+{
+  const size_t size = 1024 * 1024;
+  const size_t in_use_before = MEM_get_memory_in_use_for_tag(MEM_TAG_IMAGE);
+
+  void *untagged = MEM_mallocN(size, "untagged");
+  EXPECT_EQ(MEM_get_memory_in_use_for_tag(MEM_TAG_IMAGE), in_use_before);
+
+  void *tagged, *tagged_aligned;
+  {
+    MEM_TagScope tag_scope(MEM_TAG_IMAGE);
+    tagged = MEM_callocN(size, "tagged");
+    {
+      MEM_TagScope nested_scope(MEM_TAG_DRAW);
+      MEM_freeN(MEM_mallocN(size, "nested"));
+    }
+    tagged_aligned = MEM_mallocN_aligned(size, 64, "tagged aligned");
+  }
+  EXPECT_EQ(MEM_get_memory_in_use_for_tag(MEM_TAG_IMAGE), in_use_before + 2 * size);
+  EXPECT_EQ(MEM_allocN_len(tagged), size);
+  EXPECT_EQ(MEM_allocN_len(tagged_aligned), size);
+
+  /* The tag is stored in the block, it does not matter which tag is active when freeing. */
+  MEM_freeN(tagged);
+  MEM_freeN(tagged_aligned);
+  MEM_freeN(untagged);
+  EXPECT_EQ(MEM_get_memory_in_use_for_tag(MEM_TAG_IMAGE), in_use_before);
+}
+
+}  // namespace
+
+TEST_F(LockFreeAllocatorTest, MEM_tag)
+{
+  DoBasicTagChecks();
+}
+
+TEST_F(GuardedAllocatorTest, MEM_tag)
+{
+  DoBasicTagChecks();
+}
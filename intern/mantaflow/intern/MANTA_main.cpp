@@ -15,6 +15,7 @@
 
 #include "MANTA_main.h"
 #include "Python.h"
+#include "fileio/mantaio.h"
 #include "fluid_script.h"
 #include "liquid_script.h"
 #include "manta.h"
@@ -561,6 +562,9 @@ MANTA::~MANTA()
          << ")" << endl;
   }
 
+  /* Pending writes only use copies of the grids, but the cache has to be complete. */
+  flushCacheWrites();
+
   /* Destruction string for Python. */
   string tmpString = "";
   vector<string> pythonCommands;
@@ -732,6 +736,11 @@ void MANTA::terminateMantaflow()
   PyGILState_Release(gilstate);
 }
 
+void MANTA::flushCacheWrites()
+{
+  Manta::flushWritesVDB();
+}
+
 static string getCacheFileEnding(char cache_format)
 {
   if (MANTA::with_debug) {
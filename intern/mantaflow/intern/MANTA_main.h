@@ -93,6 +93,9 @@ struct MANTA {
   bool exportSmokeScript(struct FluidModifierData *fmd);
   bool exportLiquidScript(struct FluidModifierData *fmd);
 
+  /* Cache files are written in the background, wait until all of them are complete. */
+  static void flushCacheWrites();
+
   /* Check cache status by frame. */
   bool hasConfig(FluidModifierData *fmd, int framenr);
   bool hasData(FluidModifierData *fmd, int framenr);
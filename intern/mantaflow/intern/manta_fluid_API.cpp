@@ -53,6 +53,11 @@ bool manta_write_noise(MANTA *fluid, FluidModifierData *fmd, int framenr)
   return fluid->writeNoise(fmd, framenr);
 }
 
+void manta_flush_cache_writes()
+{
+  MANTA::flushCacheWrites();
+}
+
 bool manta_read_config(MANTA *fluid, FluidModifierData *fmd, int framenr)
 {
   return fluid->readConfiguration(fmd, framenr);
@@ -328,6 +328,24 @@ class OBJECT_PT_lineart(ObjectButtonsPanel, Panel):
         subrow.prop(lineart, "intersection_priority", text="")
 
 
+class OBJECT_PT_playback_cache(ObjectButtonsPanel, Panel):
+    bl_label = "Playback Cache"
+    bl_options = {'DEFAULT_CLOSED'}
+    bl_order = 10
+
+    @classmethod
+    def poll(cls, context):
+        ob = context.object
+        return (ob.type == 'MESH')
+
+    def draw(self, context):
+        layout = self.layout
+        layout.use_property_split = True
+
+        ob = context.object
+        layout.prop(ob, "use_playback_cache", text="Cache Evaluated Mesh")
+
+
 class OBJECT_PT_motion_paths(MotionPathButtonsPanel, Panel):
     # bl_label = "Object Motion Paths"
     bl_context = "object"
@@ -439,6 +457,7 @@ classes = (
     OBJECT_PT_display,
     OBJECT_PT_visibility,
     OBJECT_PT_lineart,
+    OBJECT_PT_playback_cache,
     OBJECT_PT_custom_props,
 )
 
@@ -300,10 +300,19 @@ static GPUTexture *blf_batch_cache_texture_load()
     int offset_x = bitmap_len_landed % tex_width;
     int offset_y = bitmap_len_landed / tex_width;
 
-    /* TODO(@germano): Update more than one row in a single call. */
+    /* The glyphs are packed contiguously, so the new data is at most a partial row, followed by
+     * a block of full rows and another partial row. Each of these is uploaded with one call. */
     while (remain) {
-      int remain_row = tex_width - offset_x;
-      int width = remain > remain_row ? remain_row : remain;
+      int width, height;
+      if (offset_x != 0 || remain < tex_width) {
+        const int remain_row = tex_width - offset_x;
+        width = remain > remain_row ? remain_row : remain;
+        height = 1;
+      }
+      else {
+        width = tex_width;
+        height = remain / tex_width;
+      }
       GPU_texture_update_sub(gc->texture,
                              GPU_DATA_UBYTE,
                              &gc->bitmap_result[bitmap_len_landed],
@@ -311,13 +320,13 @@ static GPUTexture *blf_batch_cache_texture_load()
                              offset_y,
                              0,
                              width,
-                             1,
+                             height,
                              0);
 
-      bitmap_len_landed += width;
-      remain -= width;
-      offset_x = 0;
-      offset_y += 1;
+      bitmap_len_landed += width * height;
+      remain -= width * height;
+      offset_x = (offset_x + width) % tex_width;
+      offset_y += (offset_x == 0) ? height : 0;
     }
 
     gc->bitmap_len_landed = bitmap_len_landed;
@@ -1437,7 +1437,10 @@ void blf_glyph_draw(FontBLF *font, GlyphCacheBLF *gc, GlyphBLF *g, const int x,
 
     if (bitmap_len > gc->bitmap_len_alloc) {
       int w = font->tex_size_max;
-      int h = bitmap_len / w + 1;
+      /* Grow the height geometrically, the texture is created and uploaded again for every
+       * reallocation, which would otherwise happen for every new row of glyphs. */
+      int h = std::max(bitmap_len / w + 1,
+                       std::min(2 * (gc->bitmap_len_alloc / w), font->tex_size_max));
 
       gc->bitmap_len_alloc = w * h;
       gc->bitmap_result = static_cast<char *>(
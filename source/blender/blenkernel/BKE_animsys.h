@@ -359,6 +359,9 @@ void BKE_animsys_eval_driver(struct Depsgraph *depsgraph,
 
 void BKE_animsys_update_driver_array(struct ID *id);
 
+/** Free the cache of resolved channels created by #BKE_animsys_eval_animdata. */
+void BKE_animsys_eval_cache_free(struct AnimData *adt);
+
 /* ************************************* */
 
 #ifdef __cplusplus
@@ -82,6 +82,13 @@ class BlobWriteSharing : NonCopyable, NonMovable {
     std::shared_ptr<io::serialize::DictionaryValue> io_data;
   };
 
+  struct StoredByContentValue {
+    /** Where the data has been written to. */
+    BlobSlice slice;
+    /** True when the slice contains the data compressed with zstd. */
+    bool is_compressed;
+  };
+
   /**
    * Map used to detect when some data has already been written. It keeps a weak reference to
    * #ImplicitSharingInfo, allowing it to check for equality of two arrays just by comparing the
@@ -93,7 +100,7 @@ class BlobWriteSharing : NonCopyable, NonMovable {
    * Remembers where data was stored based on the hash of the data. This allows us to skip writing
    * the same array again if it has the same hash.
    */
-  Map<uint64_t, BlobSlice> slice_by_content_hash_;
+  Map<uint64_t, StoredByContentValue> stored_by_content_hash_;
 
  public:
   ~BlobWriteSharing();
@@ -112,6 +119,9 @@ class BlobWriteSharing : NonCopyable, NonMovable {
    * Checks if the given data was written before. If it was, it's not written again, but a
    * reference to the previously written data is returned. If the data is new, it's written now.
    * Its hash is remembered so that the same data won't be written again.
+   *
+   * Large data is compressed before it's written when that reduces its size noticeably. The
+   * returned identifier then also contains the used compression.
    */
   [[nodiscard]] std::shared_ptr<io::serialize::DictionaryValue> write_deduplicated(
       BlobWriter &writer, const void *data, int64_t size_in_bytes);
@@ -469,6 +469,12 @@ void CustomData_swap_corners(CustomData *data, int index, const int *corner_indi
  */
 void CustomData_ensure_data_is_mutable(CustomDataLayer *layer, int totelem);
 void CustomData_ensure_layers_are_mutable(CustomData *data, int totelem);
+/**
+ * Like #CustomData_ensure_layers_are_mutable for the layers in \a mask, but shared layers get new
+ * uninitialized arrays instead of a copy. Only meant for callers that overwrite all values of
+ * these layers right after, where copying the old values would be wasted work.
+ */
+void CustomData_unshare_layers_for_overwrite(CustomData *data, eCustomDataMask mask, int totelem);
 
 /**
  * Retrieve a pointer to an element of the active layer of the given \a type, chosen by the
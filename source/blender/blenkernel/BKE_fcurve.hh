@@ -610,6 +610,17 @@ bool BKE_fcurve_is_empty(const FCurve *fcu);
 float calculate_fcurve(PathResolvedRNA *anim_rna,
                        FCurve *fcu,
                        const AnimationEvalContext *anim_eval_context);
+/**
+ * Same as #calculate_fcurve, but the keyframe segment used for evaluation is remembered in
+ * \a segment_hint and checked first on the next call. When evaluating at increasing times, like
+ * during playback, this avoids searching the keyframes on every frame.
+ *
+ * \param segment_hint: Should be initialized to zero, any value gives a correct result.
+ */
+float calculate_fcurve_with_hint(PathResolvedRNA *anim_rna,
+                                 FCurve *fcu,
+                                 const AnimationEvalContext *anim_eval_context,
+                                 int *segment_hint);
 
 /* ************* F-Curve Samples API ******************** */
 
@@ -47,6 +47,8 @@ void BKE_fluid_reallocate_copy_fluid(struct FluidDomainSettings *fds,
                                      int n_shift[3]);
 void BKE_fluid_cache_free_all(struct FluidDomainSettings *fds, struct Object *ob);
 void BKE_fluid_cache_free(struct FluidDomainSettings *fds, struct Object *ob, int cache_map);
+/** Wait until the cache files that are written in the background are complete. */
+void BKE_fluid_cache_flush_writes();
 void BKE_fluid_cache_new_name_for_current_session(int maxlen, char *r_name);
 
 /**
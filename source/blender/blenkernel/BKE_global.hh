@@ -184,6 +184,8 @@ enum {
   /** Support simulating events (for testing). */
   G_FLAG_EVENT_SIMULATE = (1 << 3),
   G_FLAG_USERPREF_NO_SAVE_ON_EXIT = (1 << 4),
+  /** Share large read-only data with other processes reading the same files (render farms). */
+  G_FLAG_READ_SHARED_MEMORY = (1 << 5),
 
   G_FLAG_SCRIPT_AUTOEXEC = (1 << 13),
   /** When this flag is set ignore the preferences #USER_SCRIPT_AUTOEXEC_DISABLE. */
@@ -195,7 +197,7 @@ enum {
 /** Don't overwrite these flags when reading a file. */
 #define G_FLAG_ALL_RUNTIME \
   (G_FLAG_SCRIPT_AUTOEXEC | G_FLAG_SCRIPT_OVERRIDE_PREF | G_FLAG_EVENT_SIMULATE | \
-   G_FLAG_USERPREF_NO_SAVE_ON_EXIT | \
+   G_FLAG_USERPREF_NO_SAVE_ON_EXIT | G_FLAG_READ_SHARED_MEMORY | \
 \
    /* #BPY_python_reset is responsible for resetting these flags on file load. */ \
    G_FLAG_SCRIPT_AUTOEXEC_FAIL | G_FLAG_SCRIPT_AUTOEXEC_FAIL_QUIET)
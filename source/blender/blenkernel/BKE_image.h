@@ -450,8 +450,14 @@ void BKE_image_buf_fill_checker_color(unsigned char *rect,
 
 /* Cycles hookup */
 
-unsigned char *BKE_image_get_pixels_for_frame(struct Image *image, int frame, int tile);
-float *BKE_image_get_float_pixels_for_frame(struct Image *image, int frame, int tile);
+/**
+ * Copy the first \a pixels_num elements of the image buffer into \a r_pixels.
+ * Returns false when the buffer does not exist or is smaller than requested.
+ */
+bool BKE_image_get_pixels_for_frame(
+    struct Image *image, int frame, int tile, unsigned char *r_pixels, size_t pixels_num);
+bool BKE_image_get_float_pixels_for_frame(
+    struct Image *image, int frame, int tile, float *r_pixels, size_t pixels_num);
 
 /* Image modifications */
 
@@ -549,6 +555,13 @@ ImageGPUTextures BKE_image_get_gpu_material_texture(struct Image *image,
                                                     struct ImageUser *iuser,
                                                     const bool use_tile_mapping);
 
+/**
+ * Load the image buffers of the given file images that don't have a GPU texture yet in parallel,
+ * such that creating their GPU textures afterwards doesn't decode the images one after another.
+ * `iusers` can contain null pointers.
+ */
+void BKE_image_preload_gpu_textures(struct Image **images, struct ImageUser **iusers, int num);
+
 /**
  * Is the alpha of the `GPUTexture` for a given image/ibuf premultiplied.
  */
@@ -570,6 +570,18 @@ void BKE_lib_id_swap_full(
  * immediately before or after that pointer. It must always be into given \a lb list.
  */
 void id_sort_by_name(ListBase *lb, ID *id, ID *id_sorting_hint);
+
+/**
+ * Defer sorting IDs added to (or renamed in) \a bmain by name until the matching
+ * #BKE_main_id_sort_defer_end call, which sorts each affected list once. Inserting each new ID
+ * at its sorted position gets expensive when creating many IDs with unsorted names (e.g. from
+ * importers or scripts).
+ *
+ * Calls can be nested. While deferred, the ID lists are not sorted by name, unique names are
+ * still ensured.
+ */
+void BKE_main_id_sort_defer_begin(Main *bmain);
+void BKE_main_id_sort_defer_end(Main *bmain);
 /**
  * Expand ID usages of given id as 'extern' (and no more indirect) linked data.
  * Used by ID copy/make_local functions.
@@ -168,6 +168,14 @@ struct Main {
    */
   bool is_locked_for_linking;
 
+  /**
+   * When non-zero, sorting IDs by name is deferred, see #BKE_main_id_sort_defer_begin.
+   * #id_sort_deferred_types has a bit set for the index (#BKE_idtype_idcode_to_index) of each ID
+   * type that needs sorting.
+   */
+  int id_sort_defer_level;
+  uint64_t id_sort_deferred_types;
+
   /**
    * When set, indicates that an unrecoverable error/data corruption was detected.
    * Should only be set by readfile code, and used by upper-level code (typically #setup_app_data)
@@ -40,6 +40,8 @@ enum eMeshBatchDirtyMode {
   BKE_MESH_BATCH_DIRTY_SHADING,
   BKE_MESH_BATCH_DIRTY_UVEDIT_ALL,
   BKE_MESH_BATCH_DIRTY_UVEDIT_SELECT,
+  /** Only vertex positions changed, topology and attributes are unchanged. */
+  BKE_MESH_BATCH_DIRTY_DEFORM,
 };
 
 /* `mesh.cc` */
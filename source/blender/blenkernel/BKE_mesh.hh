@@ -45,6 +45,19 @@ void corner_tris_calc_with_normals(Span<float3> vert_positions,
                                    Span<float3> face_normals,
                                    MutableSpan<int3> corner_tris);
 
+/**
+ * A version of #corner_tris_calc that reuses the n-gon triangulation from before the vertex
+ * positions changed, for faces where it is still valid. The topology must be unchanged.
+ *
+ * \param face_normals: Optional pre-calculated face normals, see #corner_tris_calc_with_normals.
+ */
+void corner_tris_calc_reuse(Span<float3> vert_positions,
+                            OffsetIndices<int> faces,
+                            Span<int> corner_verts,
+                            Span<float3> face_normals,
+                            Span<int3> corner_tris_prev,
+                            MutableSpan<int3> corner_tris);
+
 void corner_tris_calc_face_indices(OffsetIndices<int> faces, MutableSpan<int> tri_faces);
 
 /**
@@ -149,10 +162,17 @@ struct CornerNormalSpaceArray {
   /**
    * A map containing the face corners that make up each space,
    * in the order that they were processed (winding around a vertex).
+   * Stored as flat arrays to avoid an allocation per space, see #corners_by_space().
    */
-  Array<Array<int>> corners_by_space;
+  Array<int> corners_by_space_offsets;
+  Array<int> corners_by_space_indices;
   /** Whether to create the above map when calculating normals. */
   bool create_corners_by_space = false;
+
+  GroupedSpan<int> corners_by_space() const
+  {
+    return {OffsetIndices<int>(corners_by_space_offsets), corners_by_space_indices};
+  }
 };
 
 short2 corner_space_custom_normal_to_data(const CornerNormalSpace &lnor_space,
@@ -0,0 +1,77 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#pragma once
+
+/** \file
+ * \ingroup bke
+ *
+ * Evaluated meshes of an object stored per frame, so that scrubbing over frames which were
+ * evaluated before skips the modifier stack. The cache is enabled per object with
+ * #OB_FLAG_USE_PLAYBACK_CACHE and only used by the active dependency graph in object mode.
+ *
+ * The cached meshes are shallow copies, so data which doesn't change between frames (typically
+ * everything except positions for deforming modifiers) is shared with implicit sharing. The
+ * cache is cleared by the dependency graph's point cache reset operation, which runs for user
+ * edits to the object and all of its dependencies but not for frame changes.
+ */
+
+#include "BLI_map.hh"
+
+#include "DNA_customdata_types.h"
+
+#include "BKE_geometry_set.hh"
+
+struct Mesh;
+struct Object;
+
+namespace blender::bke {
+
+class MeshPlaybackCache {
+ public:
+  struct Frame {
+    /** Final evaluated geometry, the mesh component owns a shallow copy of the evaluated mesh. */
+    GeometrySet geometry;
+    /** Mesh with only the deform modifiers applied, may be empty. */
+    GeometrySet deform;
+    CustomData_MeshMasks data_mask;
+    bool need_mapping;
+    /** Estimated size of the data of this frame which is not shared with other frames. */
+    int64_t memory;
+  };
+
+ private:
+  Map<float, Frame> frames_;
+  int64_t memory_ = 0;
+
+ public:
+  /**
+   * Find the frame evaluated at the given time, if it provides at least the requested
+   * custom data layers.
+   */
+  const Frame *lookup(float ctime, const CustomData_MeshMasks &data_mask, bool need_mapping) const;
+
+  /**
+   * Store the evaluation result of a frame. When the memory limit is exceeded, the frames
+   * furthest away from the new one are removed first.
+   */
+  void add(float ctime,
+           const GeometrySet &geometry,
+           const Mesh &mesh_eval,
+           const Mesh *mesh_deform_eval,
+           const CustomData_MeshMasks &data_mask,
+           bool need_mapping);
+
+  void clear();
+
+  int64_t memory() const
+  {
+    return memory_;
+  }
+};
+
+/** Remove all cached frames of the evaluated object. */
+void mesh_playback_cache_clear(Object &object);
+
+}  // namespace blender::bke
@@ -142,6 +142,11 @@ struct MeshRuntime {
 
   /** Cache for derived triangulation of the mesh, accessed with #Mesh::corner_tris(). */
   SharedCache<Array<int3>> corner_tris_cache;
+  /**
+   * The triangulation from before the last change of positions. The topology is the same, so it
+   * can be partially reused when recalculating #corner_tris_cache.
+   */
+  SharedCache<Array<int3>> corner_tris_prev_cache;
   /** Cache for triangle to original face index map, accessed with #Mesh::corner_tri_faces(). */
   SharedCache<Array<int>> corner_tri_faces_cache;
 
@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <memory>
 #include <optional>
 
 #include "BLI_array.hh"
@@ -23,6 +24,7 @@ struct PoseBackup;
 namespace blender::bke {
 
 struct GeometrySet;
+class MeshPlaybackCache;
 
 struct ObjectRuntime {
   /** Final transformation matrices with constraints & animsys applied. */
@@ -135,6 +137,12 @@ struct ObjectRuntime {
   /** Runtime evaluated curve-specific data, not stored in the file. */
   CurveCache *curve_cache = nullptr;
 
+  /**
+   * Evaluated meshes of previous frames, see #OB_FLAG_USE_PLAYBACK_CACHE. Only set on evaluated
+   * objects of the active dependency graph, kept when the object is copied again for evaluation.
+   */
+  std::shared_ptr<MeshPlaybackCache> mesh_playback_cache;
+
   unsigned short local_collections_bits = 0;
 
   Array<float3x3, 0> crazyspace_deform_imats;
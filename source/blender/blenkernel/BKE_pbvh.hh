@@ -43,8 +43,15 @@ enum PBVHNodeFlags {
   PBVH_TexLeaf = 1 << 16,
   /** Used internally by `pbvh_bmesh.cc`. */
   PBVH_TopologyUpdated = 1 << 17,
+  /**
+   * Only the mask, color or face set draw buffers need to be updated. Ignored when
+   * #PBVH_UpdateDrawBuffers is set, which updates all buffers.
+   */
+  PBVH_UpdateDrawMask = 1 << 18,
+  PBVH_UpdateDrawColor = 1 << 19,
+  PBVH_UpdateDrawFaceSets = 1 << 20,
 };
-ENUM_OPERATORS(PBVHNodeFlags, PBVH_TopologyUpdated);
+ENUM_OPERATORS(PBVHNodeFlags, PBVH_UpdateDrawFaceSets);
 
 /* A few C++ methods to play nice with sets and maps. */
 #define PBVH_REF_CXX_METHODS(Class) \
@@ -19,6 +19,8 @@ class OpenSubdiv_TopologyRefiner;
 
 namespace blender::bke::subdiv {
 
+struct TopologyKey;
+
 enum VtxBoundaryInterpolation {
   /* Do not interpolate boundaries. */
   SUBDIV_VTX_BOUNDARY_NONE,
@@ -181,6 +183,9 @@ struct Subdiv {
      * In total this array has a size of `num base faces + 1`.
      */
     int *face_ptex_offset;
+    /* Identifies the mesh data the topology refiner was last created from or compared with, so
+     * that the topology comparison can be skipped when that data didn't change. */
+    TopologyKey *topology_key;
   } cache_;
 };
 
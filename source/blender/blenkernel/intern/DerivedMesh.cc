@@ -46,6 +46,7 @@
 #include "BKE_mesh.hh"
 #include "BKE_mesh_iterators.hh"
 #include "BKE_mesh_mapping.hh"
+#include "BKE_mesh_playback_cache.hh"
 #include "BKE_mesh_runtime.hh"
 #include "BKE_mesh_tangent.hh"
 #include "BKE_mesh_wrapper.hh"
@@ -1222,6 +1223,20 @@ static void mesh_build_extra_data(const Depsgraph *depsgraph,
   }
 }
 
+static blender::bke::MeshPlaybackCache *mesh_playback_cache_get(Depsgraph *depsgraph, Object *ob)
+{
+  if ((ob->flag & OB_FLAG_USE_PLAYBACK_CACHE) == 0 || ob->mode != OB_MODE_OBJECT ||
+      !DEG_is_active(depsgraph))
+  {
+    ob->runtime->mesh_playback_cache.reset();
+    return nullptr;
+  }
+  if (!ob->runtime->mesh_playback_cache) {
+    ob->runtime->mesh_playback_cache = std::make_shared<blender::bke::MeshPlaybackCache>();
+  }
+  return ob->runtime->mesh_playback_cache.get();
+}
+
 static void mesh_build_data(Depsgraph *depsgraph,
                             const Scene *scene,
                             Object *ob,
@@ -1239,17 +1254,42 @@ static void mesh_build_data(Depsgraph *depsgraph,
 
   Mesh *mesh_eval = nullptr, *mesh_deform_eval = nullptr;
   GeometrySet *geometry_set_eval = nullptr;
-  mesh_calc_modifiers(depsgraph,
-                      scene,
-                      ob,
-                      true,
-                      need_mapping,
-                      dataMask,
-                      true,
-                      true,
-                      &mesh_deform_eval,
-                      &mesh_eval,
-                      &geometry_set_eval);
+
+  blender::bke::MeshPlaybackCache *playback_cache = mesh_playback_cache_get(depsgraph, ob);
+  const float ctime = DEG_get_ctime(depsgraph);
+  if (playback_cache) {
+    if (const blender::bke::MeshPlaybackCache::Frame *frame = playback_cache->lookup(
+            ctime, *dataMask, need_mapping))
+    {
+      mesh_eval = BKE_mesh_copy_for_eval(frame->geometry.get_mesh());
+      if (frame->deform.has_mesh()) {
+        mesh_deform_eval = BKE_mesh_copy_for_eval(frame->deform.get_mesh());
+      }
+      /* The mesh is added back as a non-owning component below. */
+      geometry_set_eval = new GeometrySet(frame->geometry);
+      geometry_set_eval->remove<MeshComponent>();
+    }
+  }
+
+  if (mesh_eval == nullptr) {
+    mesh_calc_modifiers(depsgraph,
+                        scene,
+                        ob,
+                        true,
+                        need_mapping,
+                        dataMask,
+                        true,
+                        true,
+                        &mesh_deform_eval,
+                        &mesh_eval,
+                        &geometry_set_eval);
+
+    /* Wrappers (e.g. for GPU subdivision) depend on the draw code, only cache plain meshes. */
+    if (playback_cache && mesh_eval->runtime->wrapper_type == ME_WRAPPER_TYPE_MDATA) {
+      playback_cache->add(
+          ctime, *geometry_set_eval, *mesh_eval, mesh_deform_eval, *dataMask, need_mapping);
+    }
+  }
 
   /* The modifier stack evaluation is storing result in mesh->runtime.mesh_eval, but this result
    * is not guaranteed to be owned by object.
@@ -11,6 +11,7 @@
 #include <cstddef>
 #include <cstdio>
 #include <cstring>
+#include <string>
 
 #include "MEM_guardedalloc.h"
 
@@ -19,10 +20,12 @@
 #include "BLI_blenlib.h"
 #include "BLI_dynstr.h"
 #include "BLI_listbase.h"
+#include "BLI_map.hh"
 #include "BLI_math_rotation.h"
 #include "BLI_math_vector.h"
 #include "BLI_string_utils.hh"
 #include "BLI_utildefines.h"
+#include "BLI_vector.hh"
 
 #include "BLT_translation.hh"
 
@@ -583,6 +586,86 @@ static void animsys_evaluate_fcurves(PointerRNA *ptr,
   }
 }
 
+/**
+ * Channels of the active action of an evaluated ID, so that the RNA paths of its F-Curves don't
+ * have to be resolved on every frame. Channels are matched with the F-Curves by their position in
+ * the action and their RNA path, so changes to the action only re-resolve the affected channels.
+ *
+ * Only properties of the animated ID itself are cached. Their pointers stay valid until the
+ * evaluated copy of the ID is updated from the original, which frees the animation data and
+ * with it the cache. Properties of other IDs are resolved on every evaluation.
+ */
+struct AnimationEvalCache {
+  struct Channel {
+    std::string rna_path;
+    int array_index = -1;
+    /** Whether #anim_rna is resolved for the current path. */
+    bool is_cached = false;
+    PathResolvedRNA anim_rna;
+    /** See #calculate_fcurve_with_hint. */
+    int segment_hint = 0;
+  };
+  blender::Vector<Channel> channels;
+  /** Properties resolved from the RNA paths of NLA strips, see #nlaevalchan_verify. */
+  blender::Map<std::string, NlaEvalChannelKey> nla_paths;
+};
+
+void BKE_animsys_eval_cache_free(AnimData *adt)
+{
+  MEM_delete(adt->eval_cache);
+  adt->eval_cache = nullptr;
+}
+
+static void animsys_eval_cache_channel_update(AnimationEvalCache::Channel &channel,
+                                              PointerRNA *ptr,
+                                              const FCurve *fcu)
+{
+  channel.rna_path = fcu->rna_path;
+  channel.array_index = fcu->array_index;
+  channel.segment_hint = 0;
+  channel.is_cached = BKE_animsys_rna_path_resolve(
+                          ptr, fcu->rna_path, fcu->array_index, &channel.anim_rna) &&
+                      channel.anim_rna.ptr.owner_id == ptr->owner_id;
+}
+
+/** Same as #animsys_evaluate_fcurves, using and updating the \a cache. */
+static void animsys_evaluate_fcurves_cached(PointerRNA *ptr,
+                                            ListBase *list,
+                                            AnimationEvalCache &cache,
+                                            const AnimationEvalContext *anim_eval_context,
+                                            bool flush_to_original)
+{
+  int channel_index = 0;
+  LISTBASE_FOREACH (FCurve *, fcu, list) {
+    if (channel_index == cache.channels.size()) {
+      cache.channels.append({});
+    }
+    AnimationEvalCache::Channel &channel = cache.channels[channel_index++];
+
+    if (!is_fcurve_evaluatable(fcu) || fcu->rna_path == nullptr) {
+      continue;
+    }
+    if (channel.array_index != fcu->array_index || channel.rna_path != fcu->rna_path) {
+      animsys_eval_cache_channel_update(channel, ptr, fcu);
+    }
+
+    PathResolvedRNA anim_rna;
+    if (channel.is_cached) {
+      anim_rna = channel.anim_rna;
+    }
+    else if (!BKE_animsys_rna_path_resolve(ptr, fcu->rna_path, fcu->array_index, &anim_rna)) {
+      continue;
+    }
+    const float curval = calculate_fcurve_with_hint(
+        &anim_rna, fcu, anim_eval_context, &channel.segment_hint);
+    BKE_animsys_write_to_rna_path(&anim_rna, curval);
+    if (flush_to_original) {
+      animsys_write_orig_anim_rna(ptr, fcu->rna_path, fcu->array_index, curval);
+    }
+  }
+  cache.channels.resize(channel_index);
+}
+
 /**
  * This function assumes that the quaternion keys are sequential. They do not
  * have to be in array_index order. If the quaternion is only partially keyed,
@@ -1531,21 +1614,35 @@ static NlaEvalChannel *nlaevalchan_verify(PointerRNA *ptr, NlaEvalData *nlaeval,
   /* Resolve the property and look it up in the key hash. */
   NlaEvalChannelKey key;
 
-  if (!RNA_path_resolve_property(ptr, path, &key.ptr, &key.prop)) {
-    /* Report failure to resolve the path. */
-    if (G.debug & G_DEBUG) {
-      CLOG_WARN(&LOG,
-                "Animato: Invalid path. ID = '%s',  '%s'",
-                (ptr->owner_id) ? (ptr->owner_id->name + 2) : "<No ID>",
-                path);
+  const NlaEvalChannelKey *cached_key = nlaeval->eval_cache ?
+                                            nlaeval->eval_cache->nla_paths.lookup_ptr_as(
+                                                blender::StringRef(path)) :
+                                            nullptr;
+  if (cached_key) {
+    key = *cached_key;
+  }
+  else {
+    if (!RNA_path_resolve_property(ptr, path, &key.ptr, &key.prop)) {
+      /* Report failure to resolve the path. */
+      if (G.debug & G_DEBUG) {
+        CLOG_WARN(&LOG,
+                  "Animato: Invalid path. ID = '%s',  '%s'",
+                  (ptr->owner_id) ? (ptr->owner_id->name + 2) : "<No ID>",
+                  path);
+      }
+
+      return nullptr;
     }
 
-    return nullptr;
-  }
+    /* Check that the property can be animated. */
+    if (ptr->owner_id != nullptr && !RNA_property_animateable(&key.ptr, key.prop)) {
+      return nullptr;
+    }
 
-  /* Check that the property can be animated. */
-  if (ptr->owner_id != nullptr && !RNA_property_animateable(&key.ptr, key.prop)) {
-    return nullptr;
+    /* Same as for the active action, only properties of the animated ID itself are kept. */
+    if (nlaeval->eval_cache && ptr->owner_id != nullptr && key.ptr.owner_id == ptr->owner_id) {
+      nlaeval->eval_cache->nla_paths.add(path, key);
+    }
   }
 
   NlaEvalChannel *nec = nlaevalchan_verify_key(nlaeval, path, &key);
@@ -3547,6 +3644,7 @@ static void animsys_calculate_nla(PointerRNA *ptr,
   NlaEvalData echannels;
 
   nlaeval_init(&echannels);
+  echannels.eval_cache = adt->eval_cache;
 
   /* evaluate the NLA stack, obtaining a set of values to flush */
   if (animsys_evaluate_nla_for_flush(&echannels, ptr, adt, anim_eval_context, flush_to_original)) {
@@ -3942,6 +4040,14 @@ void BKE_animsys_evaluate_animdata(ID *id,
         animsys_calculate_nla(&id_ptr, adt, anim_eval_context, flush_to_original);
       }
       /* evaluate Active Action only */
+      else if (adt->action && adt->eval_cache) {
+        action_idcode_patch_check(id, adt->action);
+        animsys_evaluate_fcurves_cached(&id_ptr,
+                                        &adt->action->curves,
+                                        *adt->eval_cache,
+                                        anim_eval_context,
+                                        flush_to_original);
+      }
       else if (adt->action) {
         animsys_evaluate_action(&id_ptr, adt->action, anim_eval_context, flush_to_original);
       }
@@ -4123,6 +4229,11 @@ void BKE_animsys_eval_animdata(Depsgraph *depsgraph, ID *id)
   DEG_debug_print_eval_time(depsgraph, __func__, id->name, id, ctime);
   const bool flush_to_original = DEG_is_active(depsgraph);
 
+  /* Only the evaluated copy owns a cache, it is only used by one thread at a time. */
+  if (adt != nullptr && adt->eval_cache == nullptr) {
+    adt->eval_cache = MEM_new<AnimationEvalCache>(__func__);
+  }
+
   const AnimationEvalContext anim_eval_context = BKE_animsys_eval_context_construct(depsgraph,
                                                                                     ctime);
   BKE_animsys_evaluate_animdata(id, adt, &anim_eval_context, ADT_RECALC_ANIM, flush_to_original);
@@ -46,32 +46,58 @@ static std::unique_ptr<BakeMaterialsList> materials_to_weak_references(
   return materials_list;
 }
 
+static bool has_anonymous_attributes(const AttributeAccessor &attributes)
+{
+  for (const AttributeIDRef &id : attributes.all_ids()) {
+    if (id.is_anonymous()) {
+      return true;
+    }
+  }
+  return false;
+}
+
 void GeometryBakeItem::prepare_geometry_for_bake(GeometrySet &main_geometry,
                                                  BakeDataBlockMap *data_block_map)
 {
   main_geometry.ensure_owns_all_data();
   main_geometry.modify_geometry_sets([&](GeometrySet &geometry) {
-    if (Mesh *mesh = geometry.get_mesh_for_write()) {
-      mesh->attributes_for_write().remove_anonymous();
-      mesh->runtime->bake_materials = materials_to_weak_references(
-          &mesh->mat, &mesh->totcol, data_block_map);
+    /* Only get write access when something has to change. The geometry often still shares its
+     * components with a previous simulation state, and write access would copy them. */
+    if (const Mesh *mesh = geometry.get_mesh()) {
+      if (mesh->totcol > 0 || has_anonymous_attributes(mesh->attributes())) {
+        Mesh *mesh_for_write = geometry.get_mesh_for_write();
+        mesh_for_write->attributes_for_write().remove_anonymous();
+        mesh_for_write->runtime->bake_materials = materials_to_weak_references(
+            &mesh_for_write->mat, &mesh_for_write->totcol, data_block_map);
+      }
     }
-    if (Curves *curves = geometry.get_curves_for_write()) {
-      curves->geometry.wrap().attributes_for_write().remove_anonymous();
-      curves->geometry.runtime->bake_materials = materials_to_weak_references(
-          &curves->mat, &curves->totcol, data_block_map);
+    if (const Curves *curves = geometry.get_curves()) {
+      if (curves->totcol > 0 || has_anonymous_attributes(curves->geometry.wrap().attributes())) {
+        Curves *curves_for_write = geometry.get_curves_for_write();
+        curves_for_write->geometry.wrap().attributes_for_write().remove_anonymous();
+        curves_for_write->geometry.runtime->bake_materials = materials_to_weak_references(
+            &curves_for_write->mat, &curves_for_write->totcol, data_block_map);
+      }
     }
-    if (PointCloud *pointcloud = geometry.get_pointcloud_for_write()) {
-      pointcloud->attributes_for_write().remove_anonymous();
-      pointcloud->runtime->bake_materials = materials_to_weak_references(
-          &pointcloud->mat, &pointcloud->totcol, data_block_map);
+    if (const PointCloud *pointcloud = geometry.get_pointcloud()) {
+      if (pointcloud->totcol > 0 || has_anonymous_attributes(pointcloud->attributes())) {
+        PointCloud *pointcloud_for_write = geometry.get_pointcloud_for_write();
+        pointcloud_for_write->attributes_for_write().remove_anonymous();
+        pointcloud_for_write->runtime->bake_materials = materials_to_weak_references(
+            &pointcloud_for_write->mat, &pointcloud_for_write->totcol, data_block_map);
+      }
     }
-    if (Volume *volume = geometry.get_volume_for_write()) {
-      volume->runtime->bake_materials = materials_to_weak_references(
-          &volume->mat, &volume->totcol, data_block_map);
+    if (const Volume *volume = geometry.get_volume()) {
+      if (volume->totcol > 0) {
+        Volume *volume_for_write = geometry.get_volume_for_write();
+        volume_for_write->runtime->bake_materials = materials_to_weak_references(
+            &volume_for_write->mat, &volume_for_write->totcol, data_block_map);
+      }
     }
-    if (bke::Instances *instances = geometry.get_instances_for_write()) {
-      instances->attributes_for_write().remove_anonymous();
+    if (const bke::Instances *instances = geometry.get_instances()) {
+      if (has_anonymous_attributes(instances->attributes())) {
+        geometry.get_instances_for_write()->attributes_for_write().remove_anonymous();
+      }
     }
     geometry.keep_only_during_modify({GeometryComponent::Type::Mesh,
                                       GeometryComponent::Type::Curve,
@@ -109,26 +135,38 @@ void GeometryBakeItem::try_restore_data_blocks(GeometrySet &main_geometry,
                                                BakeDataBlockMap *data_block_map)
 {
   main_geometry.modify_geometry_sets([&](GeometrySet &geometry) {
-    if (Mesh *mesh = geometry.get_mesh_for_write()) {
-      restore_materials(
-          &mesh->mat, &mesh->totcol, std::move(mesh->runtime->bake_materials), data_block_map);
+    /* Avoid copying components that are shared with the stored state when there are no
+     * materials to restore. */
+    if (const Mesh *mesh = geometry.get_mesh(); mesh && mesh->runtime->bake_materials) {
+      Mesh *mesh_for_write = geometry.get_mesh_for_write();
+      restore_materials(&mesh_for_write->mat,
+                        &mesh_for_write->totcol,
+                        std::move(mesh_for_write->runtime->bake_materials),
+                        data_block_map);
     }
-    if (Curves *curves = geometry.get_curves_for_write()) {
-      restore_materials(&curves->mat,
-                        &curves->totcol,
-                        std::move(curves->geometry.runtime->bake_materials),
+    if (const Curves *curves = geometry.get_curves();
+        curves && curves->geometry.runtime->bake_materials)
+    {
+      Curves *curves_for_write = geometry.get_curves_for_write();
+      restore_materials(&curves_for_write->mat,
+                        &curves_for_write->totcol,
+                        std::move(curves_for_write->geometry.runtime->bake_materials),
                         data_block_map);
     }
-    if (PointCloud *pointcloud = geometry.get_pointcloud_for_write()) {
-      restore_materials(&pointcloud->mat,
-                        &pointcloud->totcol,
-                        std::move(pointcloud->runtime->bake_materials),
+    if (const PointCloud *pointcloud = geometry.get_pointcloud();
+        pointcloud && pointcloud->runtime->bake_materials)
+    {
+      PointCloud *pointcloud_for_write = geometry.get_pointcloud_for_write();
+      restore_materials(&pointcloud_for_write->mat,
+                        &pointcloud_for_write->totcol,
+                        std::move(pointcloud_for_write->runtime->bake_materials),
                         data_block_map);
     }
-    if (Volume *volume = geometry.get_volume_for_write()) {
-      restore_materials(&volume->mat,
-                        &volume->totcol,
-                        std::move(volume->runtime->bake_materials),
+    if (const Volume *volume = geometry.get_volume(); volume && volume->runtime->bake_materials) {
+      Volume *volume_for_write = geometry.get_volume_for_write();
+      restore_materials(&volume_for_write->mat,
+                        &volume_for_write->totcol,
+                        std::move(volume_for_write->runtime->bake_materials),
                         data_block_map);
     }
   });
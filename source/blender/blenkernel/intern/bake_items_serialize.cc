@@ -26,6 +26,7 @@
 #include <fmt/format.h>
 #include <sstream>
 #include <xxhash.h>
+#include <zstd.h>
 
 #ifdef WITH_OPENVDB
 #  include <openvdb/io/Stream.h>
@@ -189,13 +190,42 @@ DictionaryValuePtr BlobWriteSharing::write_implicitly_shared(
       });
 }
 
+/** Smaller blobs are not compressed, because the gain would be small compared to the overhead. */
+static constexpr int64_t min_compressed_blob_size = 64 * 1024;
+/**
+ * Use a fast compression level, because bakes are written while the simulation runs. Decompression
+ * speed is mostly independent of the level.
+ */
+static constexpr int blob_compression_level = 1;
+
 std::shared_ptr<io::serialize::DictionaryValue> BlobWriteSharing::write_deduplicated(
     BlobWriter &writer, const void *data, const int64_t size_in_bytes)
 {
   const uint64_t content_hash = XXH3_64bits(data, size_in_bytes);
-  const BlobSlice slice = slice_by_content_hash_.lookup_or_add_cb(
-      content_hash, [&]() { return writer.write(data, size_in_bytes); });
-  return slice.serialize();
+  const StoredByContentValue &value = stored_by_content_hash_.lookup_or_add_cb(
+      content_hash, [&]() -> StoredByContentValue {
+        if (size_in_bytes >= min_compressed_blob_size) {
+          Array<uint8_t> compressed(ZSTD_compressBound(size_in_bytes), NoInitialization());
+          const size_t compressed_size = ZSTD_compress(compressed.data(),
+                                                       compressed.size(),
+                                                       data,
+                                                       size_in_bytes,
+                                                       blob_compression_level);
+          /* Only use the compressed data if it saves a noticeable amount of space, because it has
+           * to be decompressed on every read. */
+          if (!ZSTD_isError(compressed_size) &&
+              int64_t(compressed_size) < size_in_bytes - size_in_bytes / 8)
+          {
+            return {writer.write(compressed.data(), compressed_size), true};
+          }
+        }
+        return {writer.write(data, size_in_bytes), false};
+      });
+  DictionaryValuePtr io_data = value.slice.serialize();
+  if (value.is_compressed) {
+    io_data->append_str("compression", "zstd");
+  }
+  return io_data;
 }
 
 std::optional<ImplicitSharingInfoAndData> BlobReadSharing::read_shared(
@@ -265,6 +295,38 @@ static std::optional<eCustomDataType> get_data_type_from_io_name(const StringRef
   return eCustomDataType(domain);
 }
 
+/**
+ * Read a slice written by #BlobWriteSharing::write_deduplicated into the provided buffer and
+ * decompress it if necessary.
+ */
+[[nodiscard]] static bool read_blob_slice(const BlobReader &blob_reader,
+                                          const DictionaryValue &io_data,
+                                          const int64_t size_in_bytes,
+                                          void *r_data)
+{
+  const std::optional<BlobSlice> slice = BlobSlice::deserialize(io_data);
+  if (!slice) {
+    return false;
+  }
+  const std::optional<StringRefNull> compression = io_data.lookup_str("compression");
+  if (!compression) {
+    if (slice->range.size() != size_in_bytes) {
+      return false;
+    }
+    return blob_reader.read(*slice, r_data);
+  }
+  if (*compression == "zstd") {
+    Array<uint8_t> compressed(slice->range.size(), NoInitialization());
+    if (!blob_reader.read(*slice, compressed.data())) {
+      return false;
+    }
+    const size_t decompressed_size = ZSTD_decompress(
+        r_data, size_in_bytes, compressed.data(), compressed.size());
+    return !ZSTD_isError(decompressed_size) && int64_t(decompressed_size) == size_in_bytes;
+  }
+  return false;
+}
+
 /**
  * Write the data and remember which endianness the data had.
  */
@@ -290,14 +352,7 @@ static std::shared_ptr<DictionaryValue> write_blob_raw_data_with_endian(
                                                          const int64_t elements_num,
                                                          void *r_data)
 {
-  const std::optional<BlobSlice> slice = BlobSlice::deserialize(io_data);
-  if (!slice) {
-    return false;
-  }
-  if (slice->range.size() != element_size * elements_num) {
-    return false;
-  }
-  if (!blob_reader.read(*slice, r_data)) {
+  if (!read_blob_slice(blob_reader, io_data, element_size * elements_num, r_data)) {
     return false;
   }
   const StringRefNull stored_endian = io_data.lookup_str("endian").value_or("little");
@@ -338,14 +393,7 @@ static std::shared_ptr<DictionaryValue> write_blob_raw_bytes(BlobWriter &blob_wr
                                               const int64_t bytes_num,
                                               void *r_data)
 {
-  const std::optional<BlobSlice> slice = BlobSlice::deserialize(io_data);
-  if (!slice) {
-    return false;
-  }
-  if (slice->range.size() != bytes_num) {
-    return false;
-  }
-  return blob_reader.read(*slice, r_data);
+  return read_blob_slice(blob_reader, io_data, bytes_num, r_data);
 }
 
 static std::shared_ptr<DictionaryValue> write_blob_simple_gspan(BlobWriter &blob_writer,
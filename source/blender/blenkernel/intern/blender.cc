@@ -15,6 +15,7 @@
 #include "MEM_guardedalloc.h"
 
 #include "BLI_listbase.h"
+#include "BLI_memory_cache.hh"
 #include "BLI_string.h"
 #include "BLI_utildefines.h"
 
@@ -75,6 +76,7 @@ void BKE_blender_free()
   BKE_callback_global_finalize();
 
   IMB_moviecache_destruct();
+  blender::memory_cache::clear();
 #ifdef WITH_FFMPEG
   BKE_ffmpeg_exit();
 #endif
@@ -1112,16 +1112,20 @@ void BKE_blendfile_read_make_empty(bContext *C)
   ListBase *lb;
   ID *id;
 
+  /* Delete all IDs at once, deleting them one by one would scan the whole database for every
+   * deleted ID to clear its users. */
+  BKE_main_id_tag_all(bmain, LIB_TAG_DOIT, false);
   FOREACH_MAIN_LISTBASE_BEGIN (bmain, lb) {
     FOREACH_MAIN_LISTBASE_ID_BEGIN (lb, id) {
       if (ELEM(GS(id->name), ID_SCE, ID_SCR, ID_WM, ID_WS)) {
         break;
       }
-      BKE_id_delete(bmain, id);
+      id->tag |= LIB_TAG_DOIT;
     }
     FOREACH_MAIN_LISTBASE_ID_END;
   }
   FOREACH_MAIN_LISTBASE_END;
+  BKE_id_multi_tagged_delete(bmain);
 }
 
 /** \} */
@@ -9,8 +9,13 @@
 #include "DNA_meshdata_types.h"
 #include "DNA_pointcloud_types.h"
 
+#include "BLI_hash.hh"
+#include "BLI_implicit_sharing.hh"
 #include "BLI_math_geom.h"
+#include "BLI_memory_cache.hh"
+#include "BLI_struct_equality_utils.hh"
 #include "BLI_task.h"
+#include "BLI_vector.hh"
 
 #include "BKE_attribute.hh"
 #include "BKE_bvhutils.hh"
@@ -29,9 +34,34 @@ using blender::VArray;
 /** \name BVHCache
  * \{ */
 
-struct BVHCacheItem {
-  bool is_filled;
+namespace {
+
+/** A tree in the global #memory_cache, it can be used by different meshes with the same data. */
+class CachedBVHTree : public blender::memory_cache::CachedValue {
+ public:
   BVHTree *tree;
+
+  CachedBVHTree(BVHTree *tree) : tree(tree) {}
+
+  ~CachedBVHTree() override
+  {
+    BLI_bvhtree_free(tree);
+  }
+
+  int64_t size_in_bytes() const override
+  {
+    /* Rough estimate per element, including the bounds and the inner nodes. */
+    return int64_t(BLI_bvhtree_get_len(tree)) * 128;
+  }
+};
+
+}  // namespace
+
+struct BVHCacheItem {
+  bool is_filled = false;
+  BVHTree *tree = nullptr;
+  /** When set, the tree is owned by the global cache instead of this item. */
+  std::shared_ptr<const CachedBVHTree> shared_tree;
 };
 
 struct BVHCache {
@@ -109,7 +139,7 @@ bool bvhcache_has_tree(const BVHCache *bvh_cache, const BVHTree *tree)
 
 BVHCache *bvhcache_init()
 {
-  BVHCache *cache = MEM_cnew<BVHCache>(__func__);
+  BVHCache *cache = MEM_new<BVHCache>(__func__);
   BLI_mutex_init(&cache->mutex);
   return cache;
 }
@@ -129,15 +159,28 @@ static void bvhcache_insert(BVHCache *bvh_cache, BVHTree *tree, BVHCacheType typ
   item->is_filled = true;
 }
 
+static void bvhcache_insert_shared(BVHCache *bvh_cache,
+                                   std::shared_ptr<const CachedBVHTree> shared_tree,
+                                   BVHCacheType type)
+{
+  BVHCacheItem *item = &bvh_cache->items[type];
+  BLI_assert(!item->is_filled);
+  item->tree = shared_tree->tree;
+  item->shared_tree = std::move(shared_tree);
+  item->is_filled = true;
+}
+
 void bvhcache_free(BVHCache *bvh_cache)
 {
   for (int index = 0; index < BVHTREE_MAX_ITEM; index++) {
     BVHCacheItem *item = &bvh_cache->items[index];
-    BLI_bvhtree_free(item->tree);
+    if (!item->shared_tree) {
+      BLI_bvhtree_free(item->tree);
+    }
     item->tree = nullptr;
   }
   BLI_mutex_end(&bvh_cache->mutex);
-  MEM_freeN(bvh_cache);
+  MEM_delete(bvh_cache);
 }
 
 /**
@@ -896,117 +939,248 @@ static BitVector<> corner_tris_no_hidden_map_get(const blender::OffsetIndices<in
   return corner_tris_mask;
 }
 
-BVHTree *BKE_bvhtree_from_mesh_get(BVHTreeFromMesh *data,
-                                   const Mesh *mesh,
-                                   const BVHCacheType bvh_cache_type,
-                                   const int tree_type)
-{
-  using namespace blender;
-  using namespace blender::bke;
-  BVHCache **bvh_cache_p = (BVHCache **)&mesh->runtime->bvh_cache;
+namespace {
 
-  Span<int3> corner_tris;
-  if (ELEM(bvh_cache_type, BVHTREE_FROM_CORNER_TRIS, BVHTREE_FROM_CORNER_TRIS_NO_HIDDEN)) {
-    corner_tris = mesh->corner_tris();
+/**
+ * Identifies a tree built from mesh data by the implicit sharing info of the arrays it is built
+ * from. That allows reusing trees for meshes that are copies of each other, even when the mesh
+ * that originally built the tree has been freed already, e.g. when the same input mesh is
+ * evaluated again on the next frame.
+ */
+class BVHTreeKey : public blender::memory_cache::GenericKey {
+ public:
+  struct SharedData {
+    const blender::ImplicitSharingInfo *sharing_info;
+    int64_t version;
+
+    BLI_STRUCT_EQUALITY_OPERATORS_2(SharedData, sharing_info, version)
+  };
+
+  BVHCacheType bvh_cache_type;
+  int tree_type;
+  blender::Vector<SharedData, 3> data;
+  bool owns_weak_users = false;
+
+  ~BVHTreeKey() override
+  {
+    if (owns_weak_users) {
+      for (const SharedData &shared_data : data) {
+        shared_data.sharing_info->remove_weak_user_and_delete_if_last();
+      }
+    }
   }
 
-  const Span<float3> positions = mesh->vert_positions();
-  const Span<int2> edges = mesh->edges();
-  const Span<int> corner_verts = mesh->corner_verts();
+  uint64_t hash() const override
+  {
+    uint64_t hash = blender::get_default_hash(int(bvh_cache_type), tree_type);
+    for (const SharedData &shared_data : data) {
+      hash = blender::get_default_hash(hash, shared_data.sharing_info, shared_data.version);
+    }
+    return hash;
+  }
 
-  /* Setup BVHTreeFromMesh */
-  bvhtree_from_mesh_setup_data(nullptr,
-                               bvh_cache_type,
-                               positions,
-                               edges,
-                               corner_verts,
-                               corner_tris,
-                               (const MFace *)CustomData_get_layer(&mesh->fdata_legacy, CD_MFACE),
-                               data);
+  bool equal_to(const GenericKey &other) const override
+  {
+    const BVHTreeKey &b = static_cast<const BVHTreeKey &>(other);
+    return bvh_cache_type == b.bvh_cache_type && tree_type == b.tree_type && data == b.data;
+  }
 
-  bool lock_started = false;
-  data->cached = bvhcache_find(
-      bvh_cache_p, bvh_cache_type, &data->tree, &lock_started, &mesh->runtime->eval_mutex);
+  std::unique_ptr<GenericKey> to_storable() const override
+  {
+    std::unique_ptr<BVHTreeKey> key = std::make_unique<BVHTreeKey>(*this);
+    for (const SharedData &shared_data : key->data) {
+      shared_data.sharing_info->add_weak_user();
+    }
+    key->owns_weak_users = true;
+    return key;
+  }
+};
 
-  if (data->cached) {
-    BLI_assert(lock_started == false);
+}  // namespace
 
-    /* NOTE: #data->tree can be nullptr. */
-    return data->tree;
+static const blender::ImplicitSharingInfo *mesh_layer_sharing_info(const CustomData &data,
+                                                                   const eCustomDataType type,
+                                                                   const char *name)
+{
+  const int layer_index = CustomData_get_named_layer_index(&data, type, name);
+  if (layer_index == -1) {
+    return nullptr;
   }
+  return data.layers[layer_index].sharing_info;
+}
 
-  /* Create BVHTree. */
+/**
+ * Only trees that depend on nothing but positions and topology can be shared between meshes.
+ * Trees that depend on e.g. hide flags are only cached on the mesh itself.
+ */
+static std::optional<BVHTreeKey> bvhtree_key_for_mesh(const Mesh &mesh,
+                                                      const BVHCacheType bvh_cache_type,
+                                                      const int tree_type)
+{
+  blender::Vector<const blender::ImplicitSharingInfo *, 3> sharing_infos;
+  sharing_infos.append(mesh_layer_sharing_info(mesh.vert_data, CD_PROP_FLOAT3, "position"));
+  switch (bvh_cache_type) {
+    case BVHTREE_FROM_VERTS:
+      break;
+    case BVHTREE_FROM_EDGES:
+      sharing_infos.append(
+          mesh_layer_sharing_info(mesh.edge_data, CD_PROP_INT32_2D, ".edge_verts"));
+      break;
+    case BVHTREE_FROM_CORNER_TRIS:
+      sharing_infos.append(
+          mesh_layer_sharing_info(mesh.corner_data, CD_PROP_INT32, ".corner_vert"));
+      sharing_infos.append(mesh.runtime->face_offsets_sharing_info);
+      break;
+    default:
+      return std::nullopt;
+  }
+  BVHTreeKey key;
+  key.bvh_cache_type = bvh_cache_type;
+  key.tree_type = tree_type;
+  for (const blender::ImplicitSharingInfo *sharing_info : sharing_infos) {
+    if (sharing_info == nullptr) {
+      return std::nullopt;
+    }
+    key.data.append({sharing_info, sharing_info->version()});
+  }
+  return key;
+}
 
+static BVHTree *bvhtree_from_mesh_create(const Mesh &mesh,
+                                         const BVHCacheType bvh_cache_type,
+                                         const int tree_type,
+                                         const BVHTreeFromMesh &data)
+{
+  using namespace blender;
+  using namespace blender::bke;
+  const Span<float3> positions = data.vert_positions;
+  const Span<int2> edges = data.edges;
+  const Span<int> corner_verts = data.corner_verts;
+  const Span<int3> corner_tris = data.corner_tris;
   switch (bvh_cache_type) {
     case BVHTREE_FROM_LOOSEVERTS: {
-      const LooseVertCache &loose_verts = mesh->loose_verts();
-      data->tree = bvhtree_from_mesh_verts_create_tree(
+      const LooseVertCache &loose_verts = mesh.loose_verts();
+      return bvhtree_from_mesh_verts_create_tree(
           0.0f, tree_type, 6, positions, loose_verts.is_loose_bits, loose_verts.count);
-      break;
     }
     case BVHTREE_FROM_LOOSEVERTS_NO_HIDDEN: {
       int mask_bits_act_len = -1;
-      const BitVector<> mask = loose_verts_no_hidden_mask_get(*mesh, &mask_bits_act_len);
-      data->tree = bvhtree_from_mesh_verts_create_tree(
+      const BitVector<> mask = loose_verts_no_hidden_mask_get(mesh, &mask_bits_act_len);
+      return bvhtree_from_mesh_verts_create_tree(
           0.0f, tree_type, 6, positions, mask, mask_bits_act_len);
-      break;
     }
     case BVHTREE_FROM_VERTS: {
-      data->tree = bvhtree_from_mesh_verts_create_tree(0.0f, tree_type, 6, positions, {}, -1);
-      break;
+      return bvhtree_from_mesh_verts_create_tree(0.0f, tree_type, 6, positions, {}, -1);
     }
     case BVHTREE_FROM_LOOSEEDGES: {
-      const LooseEdgeCache &loose_edges = mesh->loose_edges();
-      data->tree = bvhtree_from_mesh_edges_create_tree(
+      const LooseEdgeCache &loose_edges = mesh.loose_edges();
+      return bvhtree_from_mesh_edges_create_tree(
           positions, edges, loose_edges.is_loose_bits, loose_edges.count, 0.0f, tree_type, 6);
-      break;
     }
     case BVHTREE_FROM_LOOSEEDGES_NO_HIDDEN: {
       int mask_bits_act_len = -1;
-      const BitVector<> mask = loose_edges_no_hidden_mask_get(*mesh, &mask_bits_act_len);
-      data->tree = bvhtree_from_mesh_edges_create_tree(
+      const BitVector<> mask = loose_edges_no_hidden_mask_get(mesh, &mask_bits_act_len);
+      return bvhtree_from_mesh_edges_create_tree(
           positions, edges, mask, mask_bits_act_len, 0.0f, tree_type, 6);
-      break;
     }
     case BVHTREE_FROM_EDGES: {
-      data->tree = bvhtree_from_mesh_edges_create_tree(
-          positions, edges, {}, -1, 0.0f, tree_type, 6);
-      break;
+      return bvhtree_from_mesh_edges_create_tree(positions, edges, {}, -1, 0.0f, tree_type, 6);
     }
     case BVHTREE_FROM_FACES: {
-      BLI_assert(!(mesh->totface_legacy == 0 && mesh->faces_num != 0));
-      data->tree = bvhtree_from_mesh_faces_create_tree(
+      BLI_assert(!(mesh.totface_legacy == 0 && mesh.faces_num != 0));
+      return bvhtree_from_mesh_faces_create_tree(
           0.0f,
           tree_type,
           6,
           positions,
-          (const MFace *)CustomData_get_layer(&mesh->fdata_legacy, CD_MFACE),
-          mesh->totface_legacy,
+          (const MFace *)CustomData_get_layer(&mesh.fdata_legacy, CD_MFACE),
+          mesh.totface_legacy,
           {},
           -1);
-      break;
     }
     case BVHTREE_FROM_CORNER_TRIS_NO_HIDDEN: {
-      AttributeAccessor attributes = mesh->attributes();
+      AttributeAccessor attributes = mesh.attributes();
       int mask_bits_act_len = -1;
       const BitVector<> mask = corner_tris_no_hidden_map_get(
-          mesh->faces(),
+          mesh.faces(),
           *attributes.lookup_or_default(".hide_poly", AttrDomain::Face, false),
           corner_tris.size(),
           &mask_bits_act_len);
-      data->tree = bvhtree_from_mesh_corner_tris_create_tree(
+      return bvhtree_from_mesh_corner_tris_create_tree(
           0.0f, tree_type, 6, positions, corner_verts, corner_tris, mask, mask_bits_act_len);
-      break;
     }
     case BVHTREE_FROM_CORNER_TRIS: {
-      data->tree = bvhtree_from_mesh_corner_tris_create_tree(
+      return bvhtree_from_mesh_corner_tris_create_tree(
           0.0f, tree_type, 6, positions, corner_verts, corner_tris, {}, -1);
-      break;
     }
     case BVHTREE_MAX_ITEM:
       BLI_assert_unreachable();
       break;
   }
+  return nullptr;
+}
+
+BVHTree *BKE_bvhtree_from_mesh_get(BVHTreeFromMesh *data,
+                                   const Mesh *mesh,
+                                   const BVHCacheType bvh_cache_type,
+                                   const int tree_type)
+{
+  using namespace blender;
+  using namespace blender::bke;
+  BVHCache **bvh_cache_p = (BVHCache **)&mesh->runtime->bvh_cache;
+
+  Span<int3> corner_tris;
+  if (ELEM(bvh_cache_type, BVHTREE_FROM_CORNER_TRIS, BVHTREE_FROM_CORNER_TRIS_NO_HIDDEN)) {
+    corner_tris = mesh->corner_tris();
+  }
+
+  const Span<float3> positions = mesh->vert_positions();
+  const Span<int2> edges = mesh->edges();
+  const Span<int> corner_verts = mesh->corner_verts();
+
+  /* Setup BVHTreeFromMesh */
+  bvhtree_from_mesh_setup_data(nullptr,
+                               bvh_cache_type,
+                               positions,
+                               edges,
+                               corner_verts,
+                               corner_tris,
+                               (const MFace *)CustomData_get_layer(&mesh->fdata_legacy, CD_MFACE),
+                               data);
+
+  bool lock_started = false;
+  data->cached = bvhcache_find(
+      bvh_cache_p, bvh_cache_type, &data->tree, &lock_started, &mesh->runtime->eval_mutex);
+
+  if (data->cached) {
+    BLI_assert(lock_started == false);
+
+    /* NOTE: #data->tree can be nullptr. */
+    return data->tree;
+  }
+
+  if (std::optional<BVHTreeKey> key = bvhtree_key_for_mesh(*mesh, bvh_cache_type, tree_type)) {
+    /* Look up a tree that was built for a different mesh with the same data before. */
+    std::shared_ptr<const CachedBVHTree> shared_tree = memory_cache::get<CachedBVHTree>(
+        *key, [&]() -> std::unique_ptr<CachedBVHTree> {
+          BVHTree *tree = bvhtree_from_mesh_create(*mesh, bvh_cache_type, tree_type, *data);
+          if (tree == nullptr) {
+            return nullptr;
+          }
+          bvhtree_balance(tree, lock_started);
+          return std::make_unique<CachedBVHTree>(tree);
+        });
+    if (shared_tree) {
+      data->tree = shared_tree->tree;
+      data->cached = true;
+      bvhcache_insert_shared(*bvh_cache_p, std::move(shared_tree), bvh_cache_type);
+      bvhcache_unlock(*bvh_cache_p, lock_started);
+      return data->tree;
+    }
+  }
+
+  /* Create BVHTree. */
+  data->tree = bvhtree_from_mesh_create(*mesh, bvh_cache_type, tree_type, *data);
 
   bvhtree_balance(data->tree, lock_started);
 
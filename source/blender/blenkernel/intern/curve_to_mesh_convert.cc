@@ -2,8 +2,11 @@
  *
  * SPDX-License-Identifier: GPL-2.0-or-later */
 
+#include <mutex>
+
 #include "BLI_array.hh"
 #include "BLI_array_utils.hh"
+#include "BLI_implicit_sharing_ptr.hh"
 #include "BLI_math_matrix.hh"
 #include "BLI_math_rotation.h"
 #include "BLI_set.hh"
@@ -332,6 +335,142 @@ static ResultOffsets calculate_result_offsets(const CurvesInfo &info, const bool
   return result;
 }
 
+/**
+ * The topology of the result only depends on the evaluated point counts and the cyclic flags of
+ * the curves, which usually stay the same when curves are animated. The topology arrays of the
+ * most recent results are kept, so that new meshes can share them instead of filling them again.
+ */
+struct CachedTopology {
+  Array<int> main_offsets;
+  Array<bool> main_cyclic;
+  Array<int> profile_offsets;
+  Array<bool> profile_cyclic;
+  bool fill_caps;
+
+  ImplicitSharingPtrAndData edges;
+  ImplicitSharingPtrAndData face_offsets;
+  ImplicitSharingPtrAndData corner_verts;
+  ImplicitSharingPtrAndData corner_edges;
+
+  bool matches(const CurvesInfo &info, const bool fill_caps) const
+  {
+    return this->fill_caps == fill_caps &&
+           this->main_offsets.as_span() == info.main.evaluated_points_by_curve().data() &&
+           this->profile_offsets.as_span() == info.profile.evaluated_points_by_curve().data() &&
+           this->main_cyclic.as_span() == Span<bool>(info.main_cyclic) &&
+           this->profile_cyclic.as_span() == Span<bool>(info.profile_cyclic);
+  }
+};
+
+/** Least recently used results come first, the memory of each is kept alive by the cache. */
+struct TopologyCache {
+  static constexpr int max_size = 4;
+  std::mutex mutex;
+  Vector<std::shared_ptr<const CachedTopology>> topologies;
+};
+
+static TopologyCache &get_topology_cache()
+{
+  static TopologyCache cache;
+  return cache;
+}
+
+static std::shared_ptr<const CachedTopology> lookup_cached_topology(const CurvesInfo &info,
+                                                                    const bool fill_caps)
+{
+  TopologyCache &cache = get_topology_cache();
+  std::lock_guard lock{cache.mutex};
+  for (const int i : cache.topologies.index_range()) {
+    if (cache.topologies[i]->matches(info, fill_caps)) {
+      std::shared_ptr<const CachedTopology> topology = cache.topologies[i];
+      cache.topologies.remove(i);
+      cache.topologies.append(topology);
+      return topology;
+    }
+  }
+  return nullptr;
+}
+
+static ImplicitSharingPtrAndData share_attribute(const GAttributeReader &attribute)
+{
+  if (!attribute.sharing_info || !attribute.varray.is_span()) {
+    return {};
+  }
+  attribute.sharing_info->add_user();
+  return {ImplicitSharingPtr(attribute.sharing_info), attribute.varray.get_internal_span().data()};
+}
+
+static void add_cached_topology(const CurvesInfo &info, const bool fill_caps, const Mesh &mesh)
+{
+  auto topology = std::make_shared<CachedTopology>();
+  topology->main_offsets = info.main.evaluated_points_by_curve().data();
+  topology->main_cyclic = Span<bool>(info.main_cyclic);
+  topology->profile_offsets = info.profile.evaluated_points_by_curve().data();
+  topology->profile_cyclic = Span<bool>(info.profile_cyclic);
+  topology->fill_caps = fill_caps;
+
+  const AttributeAccessor attributes = mesh.attributes();
+  topology->edges = share_attribute(attributes.lookup(".edge_verts"));
+  topology->corner_verts = share_attribute(attributes.lookup(".corner_vert"));
+  topology->corner_edges = share_attribute(attributes.lookup(".corner_edge"));
+  if (const ImplicitSharingInfo *sharing_info = mesh.runtime->face_offsets_sharing_info) {
+    sharing_info->add_user();
+    topology->face_offsets = {ImplicitSharingPtr(sharing_info), mesh.face_offset_indices};
+  }
+  /* Empty arrays may not be allocated. */
+  if ((mesh.edges_num > 0 && !topology->edges.has_value()) ||
+      (mesh.faces_num > 0 && !topology->face_offsets.has_value()) ||
+      (mesh.corners_num > 0 &&
+       (!topology->corner_verts.has_value() || !topology->corner_edges.has_value())))
+  {
+    return;
+  }
+
+  TopologyCache &cache = get_topology_cache();
+  std::lock_guard lock{cache.mutex};
+  if (cache.topologies.size() == TopologyCache::max_size) {
+    cache.topologies.remove(0);
+  }
+  cache.topologies.append(std::move(topology));
+}
+
+static void add_shared_attribute(MutableAttributeAccessor attributes,
+                                 const StringRef name,
+                                 const AttrDomain domain,
+                                 const eCustomDataType type,
+                                 const ImplicitSharingPtrAndData &data)
+{
+  if (data.has_value()) {
+    attributes.add(name, domain, type, AttributeInitShared(data.data, *data.sharing_info));
+  }
+  else {
+    attributes.add(name, domain, type, AttributeInitConstruct());
+  }
+}
+
+static Mesh *create_mesh_with_cached_topology(const ResultOffsets &offsets,
+                                              const CachedTopology &topology)
+{
+  Mesh *mesh = mesh_new_no_attributes(offsets.vert.last(), offsets.edge.last(), 0, 0);
+  mesh->faces_num = offsets.face.last();
+  mesh->corners_num = offsets.loop.last();
+  if (topology.face_offsets.has_value()) {
+    implicit_sharing::copy_shared_pointer(
+        static_cast<int *>(const_cast<void *>(topology.face_offsets.data)),
+        topology.face_offsets.sharing_info.get(),
+        &mesh->face_offset_indices,
+        &mesh->runtime->face_offsets_sharing_info);
+  }
+  MutableAttributeAccessor attributes = mesh->attributes_for_write();
+  add_shared_attribute(
+      attributes, ".edge_verts", AttrDomain::Edge, CD_PROP_INT32_2D, topology.edges);
+  add_shared_attribute(
+      attributes, ".corner_vert", AttrDomain::Corner, CD_PROP_INT32, topology.corner_verts);
+  add_shared_attribute(
+      attributes, ".corner_edge", AttrDomain::Corner, CD_PROP_INT32, topology.corner_edges);
+  return mesh;
+}
+
 static AttrDomain get_attribute_domain_for_mesh(const AttributeAccessor &mesh_attributes,
                                                 const AttributeIDRef &attribute_id)
 {
@@ -812,32 +951,40 @@ Mesh *curve_to_mesh_sweep(const CurvesGeometry &main,
   }
 
   /* Add the position attribute later so it can be shared in some cases. */
-  Mesh *mesh = BKE_mesh_new_nomain(
-      0, offsets.edge.last(), offsets.face.last(), offsets.loop.last());
-  CustomData_free_layer_named(&mesh->vert_data, "position", 0);
-  mesh->verts_num = offsets.vert.last();
-
-  MutableSpan<int2> edges = mesh->edges_for_write();
-  MutableSpan<int> face_offsets = mesh->face_offsets_for_write();
-  MutableSpan<int> corner_verts = mesh->corner_verts_for_write();
-  MutableSpan<int> corner_edges = mesh->corner_edges_for_write();
-  MutableAttributeAccessor mesh_attributes = mesh->attributes_for_write();
+  Mesh *mesh;
+  if (const std::shared_ptr<const CachedTopology> topology = lookup_cached_topology(curves_info,
+                                                                                    fill_caps))
+  {
+    mesh = create_mesh_with_cached_topology(offsets, *topology);
+  }
+  else {
+    mesh = BKE_mesh_new_nomain(0, offsets.edge.last(), offsets.face.last(), offsets.loop.last());
+    CustomData_free_layer_named(&mesh->vert_data, "position", 0);
+    mesh->verts_num = offsets.vert.last();
 
-  foreach_curve_combination(curves_info, offsets, [&](const CombinationInfo &info) {
-    fill_mesh_topology(info.vert_range.start(),
-                       info.edge_range.start(),
-                       info.face_range.start(),
-                       info.loop_range.start(),
-                       info.main_points.size(),
-                       info.profile_points.size(),
-                       info.main_cyclic,
-                       info.profile_cyclic,
-                       fill_caps,
-                       edges,
-                       corner_verts,
-                       corner_edges,
-                       face_offsets);
-  });
+    MutableSpan<int2> edges = mesh->edges_for_write();
+    MutableSpan<int> face_offsets = mesh->face_offsets_for_write();
+    MutableSpan<int> corner_verts = mesh->corner_verts_for_write();
+    MutableSpan<int> corner_edges = mesh->corner_edges_for_write();
+
+    foreach_curve_combination(curves_info, offsets, [&](const CombinationInfo &info) {
+      fill_mesh_topology(info.vert_range.start(),
+                         info.edge_range.start(),
+                         info.face_range.start(),
+                         info.loop_range.start(),
+                         info.main_points.size(),
+                         info.profile_points.size(),
+                         info.main_cyclic,
+                         info.profile_cyclic,
+                         fill_caps,
+                         edges,
+                         corner_verts,
+                         corner_edges,
+                         face_offsets);
+    });
+    add_cached_topology(curves_info, fill_caps, *mesh);
+  }
+  MutableAttributeAccessor mesh_attributes = mesh->attributes_for_write();
 
   if (fill_caps) {
     /* TODO: This is used to keep the tests passing after refactoring mesh shade smooth flags. It
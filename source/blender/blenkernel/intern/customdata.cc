@@ -35,6 +35,7 @@
 #include "BLI_string_ref.hh"
 #include "BLI_string_utf8.h"
 #include "BLI_string_utils.hh"
+#include "BLI_task.hh"
 #include "BLI_utildefines.h"
 
 #ifndef NDEBUG
@@ -2363,7 +2364,16 @@ static void *copy_layer_data(const eCustomDataType type, const void *data, const
     type_info.copy(data, new_data, totelem);
   }
   else {
-    memcpy(new_data, data, size_in_bytes);
+    /* Making a shared layer mutable copies the whole layer even when only a few elements are
+     * changed afterwards, so copy large layers with multiple threads. */
+    blender::threading::memory_bandwidth_bound_task(size_in_bytes * 2, [&]() {
+      blender::threading::parallel_for(
+          IndexRange(size_in_bytes), 1024 * 1024, [&](const IndexRange range) {
+            memcpy(POINTER_OFFSET(new_data, range.start()),
+                   POINTER_OFFSET(data, range.start()),
+                   size_t(range.size()));
+          });
+    });
   }
   return new_data;
 }
@@ -2603,6 +2613,36 @@ void CustomData_ensure_layers_are_mutable(CustomData *data, int totelem)
   }
 }
 
+void CustomData_unshare_layers_for_overwrite(CustomData *data,
+                                             const eCustomDataMask mask,
+                                             const int totelem)
+{
+  for (const int i : IndexRange(data->totlayer)) {
+    CustomDataLayer &layer = data->layers[i];
+    if (!(mask & CD_TYPE_AS_MASK(layer.type))) {
+      continue;
+    }
+    if (layer.data == nullptr || layer.sharing_info == nullptr) {
+      continue;
+    }
+    if (layer.sharing_info->is_mutable()) {
+      layer.sharing_info->tag_ensured_mutable();
+      continue;
+    }
+    const eCustomDataType type = eCustomDataType(layer.type);
+    const LayerTypeInfo &type_info = *layerType_getInfo(type);
+    if (type_info.copy || type_info.free) {
+      /* Types that own memory per element need their values to be copied properly. */
+      ensure_layer_data_is_mutable(layer, totelem);
+      continue;
+    }
+    layer.sharing_info->remove_user_and_delete_if_last();
+    layer.data = MEM_mallocN_aligned(
+        int64_t(totelem) * type_info.size, type_info.alignment, __func__);
+    layer.sharing_info = make_implicit_sharing_info_for_layer(type, layer.data, totelem);
+  }
+}
+
 void CustomData_realloc(CustomData *data,
                         const int old_size,
                         const int new_size,
@@ -5497,6 +5537,12 @@ void CustomData_blend_read(BlendDataReader *reader, CustomData *data, const int
             }
             return sharing_info;
           });
+      const LayerTypeInfo *typeInfo = layerType_getInfo(eCustomDataType(layer->type));
+      if (typeInfo->copy == nullptr && typeInfo->free == nullptr) {
+        /* Only data without pointers can be shared with other processes. */
+        BLO_read_shared_memory_array(
+            reader, &layer->data, size_t(count) * typeInfo->size, &layer->sharing_info);
+      }
       i++;
     }
   }
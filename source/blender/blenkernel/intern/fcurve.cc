@@ -2069,9 +2069,24 @@ static float fcurve_eval_keyframes_extrapolate(
   return endpoint_bezt->vec[1][1] - (fac * dx);
 }
 
+/**
+ * Whether the binary search for \a evaltime would return \a index as the keyframe that ends the
+ * segment containing it, without an exact match on either end of the segment.
+ */
+static bool fcurve_segment_contains(const BezTriple *bezts,
+                                    const int totvert,
+                                    const int index,
+                                    const float evaltime,
+                                    const float threshold)
+{
+  return index > 0 && index < totvert && evaltime - bezts[index - 1].vec[1][0] > threshold &&
+         bezts[index].vec[1][0] - evaltime > threshold;
+}
+
 static float fcurve_eval_keyframes_interpolate(const FCurve *fcu,
                                                const BezTriple *bezts,
-                                               float evaltime)
+                                               float evaltime,
+                                               int *segment_hint)
 {
   const float eps = 1.e-8f;
   uint a;
@@ -2089,7 +2104,27 @@ static float fcurve_eval_keyframes_interpolate(const FCurve *fcu,
    *   Weird errors, like selecting the wrong keyframe range (see #39207), occur.
    *   This lower bound was established in b888a32eee8147b028464336ad2404d8155c64dd.
    */
-  a = BKE_fcurve_bezt_binarysearch_index_ex(bezts, evaltime, fcu->totvert, 0.0001, &exact);
+  const float threshold = 0.0001f;
+
+  /* During playback the evaluation time mostly stays in the segment used for the previous
+   * evaluation or moves on to the next one, check those before searching. */
+  if (segment_hint &&
+      fcurve_segment_contains(bezts, fcu->totvert, *segment_hint, evaltime, threshold))
+  {
+    a = *segment_hint;
+  }
+  else if (segment_hint &&
+           fcurve_segment_contains(bezts, fcu->totvert, *segment_hint + 1, evaltime, threshold))
+  {
+    a = *segment_hint + 1;
+    *segment_hint = a;
+  }
+  else {
+    a = BKE_fcurve_bezt_binarysearch_index_ex(bezts, evaltime, fcu->totvert, threshold, &exact);
+    if (segment_hint) {
+      *segment_hint = a;
+    }
+  }
   const BezTriple *bezt = bezts + a;
 
   if (exact) {
@@ -2333,7 +2368,10 @@ static float fcurve_eval_keyframes_interpolate(const FCurve *fcu,
 }
 
 /* Calculate F-Curve value for 'evaltime' using #BezTriple keyframes. */
-static float fcurve_eval_keyframes(FCurve *fcu, BezTriple *bezts, float evaltime)
+static float fcurve_eval_keyframes(FCurve *fcu,
+                                   BezTriple *bezts,
+                                   float evaltime,
+                                   int *segment_hint)
 {
   if (evaltime <= bezts->vec[1][0]) {
     return fcurve_eval_keyframes_extrapolate(fcu, bezts, evaltime, 0, +1);
@@ -2344,7 +2382,7 @@ static float fcurve_eval_keyframes(FCurve *fcu, BezTriple *bezts, float evaltime
     return fcurve_eval_keyframes_extrapolate(fcu, bezts, evaltime, fcu->totvert - 1, -1);
   }
 
-  return fcurve_eval_keyframes_interpolate(fcu, bezts, evaltime);
+  return fcurve_eval_keyframes_interpolate(fcu, bezts, evaltime, segment_hint);
 }
 
 /* Calculate F-Curve value for 'evaltime' using #FPoint samples. */
@@ -2391,8 +2429,12 @@ static float fcurve_eval_samples(const FCurve *fcu, const FPoint *fpts, float ev
 
 /* Evaluate and return the value of the given F-Curve at the specified frame ("evaltime")
  * NOTE: this is also used for drivers.
+ * \param segment_hint: Optional, see #calculate_fcurve_with_hint.
  */
-static float evaluate_fcurve_ex(FCurve *fcu, float evaltime, float cvalue)
+static float evaluate_fcurve_ex(FCurve *fcu,
+                                float evaltime,
+                                float cvalue,
+                                int *segment_hint = nullptr)
 {
   /* Evaluate modifiers which modify time to evaluate the base curve at. */
   FModifiersStackStorage storage;
@@ -2408,7 +2450,7 @@ static float evaluate_fcurve_ex(FCurve *fcu, float evaltime, float cvalue)
    *   F-Curve modifier on the stack requested the curve to be evaluated at.
    */
   if (fcu->bezt) {
-    cvalue = fcurve_eval_keyframes(fcu, fcu->bezt, devaltime);
+    cvalue = fcurve_eval_keyframes(fcu, fcu->bezt, devaltime, segment_hint);
   }
   else if (fcu->fpt) {
     cvalue = fcurve_eval_samples(fcu, fcu->fpt, devaltime);
@@ -2519,6 +2561,20 @@ float calculate_fcurve(PathResolvedRNA *anim_rna,
   return curval;
 }
 
+float calculate_fcurve_with_hint(PathResolvedRNA *anim_rna,
+                                 FCurve *fcu,
+                                 const AnimationEvalContext *anim_eval_context,
+                                 int *segment_hint)
+{
+  if (fcu->driver || BKE_fcurve_is_empty(fcu)) {
+    return calculate_fcurve(anim_rna, fcu, anim_eval_context);
+  }
+
+  const float curval = evaluate_fcurve_ex(fcu, anim_eval_context->eval_time, 0.0f, segment_hint);
+  fcu->curval = curval; /* Debug display only, not thread safe! */
+  return curval;
+}
+
 /** \} */
 
 /* -------------------------------------------------------------------- */
@@ -5,6 +5,7 @@
 
 #include "MEM_guardedalloc.h"
 
+#include "BKE_animsys.h"
 #include "BKE_fcurve.hh"
 
 #include "ANIM_fcurve.hh"
@@ -13,6 +14,7 @@
 
 #include "DNA_anim_types.h"
 
+#include "BLI_index_range.hh"
 #include "BLI_math_vector_types.hh"
 
 namespace blender::bke::tests {
@@ -209,6 +211,32 @@ TEST(evaluate_fcurve, ExtrapolationBezierKeys)
   BKE_fcurve_free(fcu);
 }
 
+TEST(evaluate_fcurve, SegmentHint)
+{
+  FCurve *fcu = BKE_fcurve_create();
+
+  const KeyframeSettings settings = get_keyframe_settings(false);
+  for (const int i : IndexRange(10)) {
+    insert_vert_fcurve(fcu, {float(i * 2), float(i % 3) * 5.0f}, settings, INSERTKEY_NOFLAGS);
+  }
+
+  /* The hint must not change the result, whether it is evaluated forward, backward, on keys or
+   * outside the keys, and whatever the hint was before. */
+  const float times[] = {
+      -1.0f, 0.5f, 1.0f, 2.0f, 2.5f, 3.0f, 7.5f, 4.0f, 1.5f, 17.9f, 30.0f, 3.3f};
+  for (const int initial_hint : {0, 5, 100, -3}) {
+    int segment_hint = initial_hint;
+    for (const float time : times) {
+      const AnimationEvalContext anim_eval_context = {nullptr, time};
+      EXPECT_NEAR(calculate_fcurve_with_hint(nullptr, fcu, &anim_eval_context, &segment_hint),
+                  evaluate_fcurve(fcu, time),
+                  EPSILON);
+    }
+  }
+
+  BKE_fcurve_free(fcu);
+}
+
 TEST(fcurve_subdivide, BKE_fcurve_bezt_subdivide_handles)
 {
   FCurve *fcu = BKE_fcurve_create();
@@ -4628,6 +4628,8 @@ static ImBuf *image_acquire_ibuf(Image *ima, ImageUser *iuser, void **r_lock)
     return nullptr;
   }
 
+  MEM_TagScope mem_tag_scope(MEM_TAG_IMAGE);
+
   bool is_cached_empty = false;
   ibuf = image_get_cached_ibuf(ima, iuser, &entry, &index, &is_cached_empty);
   if (is_cached_empty) {
@@ -5214,64 +5216,56 @@ void BKE_image_get_aspect(Image *image, float *r_aspx, float *r_aspy)
   }
 }
 
-uchar *BKE_image_get_pixels_for_frame(Image *image, int frame, int tile)
+bool BKE_image_get_pixels_for_frame(
+    Image *image, int frame, int tile, uchar *r_pixels, size_t pixels_num)
 {
   ImageUser iuser;
   BKE_imageuser_default(&iuser);
   void *lock;
   ImBuf *ibuf;
-  uchar *pixels = nullptr;
+  bool found = false;
 
   iuser.framenr = frame;
   iuser.tile = tile;
 
   ibuf = BKE_image_acquire_ibuf(image, &iuser, &lock);
 
-  if (ibuf) {
-    pixels = ibuf->byte_buffer.data;
-
-    if (pixels) {
-      pixels = static_cast<uchar *>(MEM_dupallocN(pixels));
-    }
-
-    BKE_image_release_ibuf(image, ibuf, lock);
+  /* Copy straight from the cached buffer, the caller owns the destination memory so no
+   * intermediate copy of the whole image is made. */
+  if (ibuf && ibuf->byte_buffer.data && pixels_num <= IMB_get_rect_len(ibuf) * 4) {
+    memcpy(r_pixels, ibuf->byte_buffer.data, pixels_num * sizeof(uchar));
+    found = true;
   }
 
-  if (!pixels) {
-    return nullptr;
-  }
+  BKE_image_release_ibuf(image, ibuf, lock);
 
-  return pixels;
+  return found;
 }
 
-float *BKE_image_get_float_pixels_for_frame(Image *image, int frame, int tile)
+bool BKE_image_get_float_pixels_for_frame(
+    Image *image, int frame, int tile, float *r_pixels, size_t pixels_num)
 {
   ImageUser iuser;
   BKE_imageuser_default(&iuser);
   void *lock;
   ImBuf *ibuf;
-  float *pixels = nullptr;
+  bool found = false;
 
   iuser.framenr = frame;
   iuser.tile = tile;
 
   ibuf = BKE_image_acquire_ibuf(image, &iuser, &lock);
 
-  if (ibuf) {
-    pixels = ibuf->float_buffer.data;
-
-    if (pixels) {
-      pixels = static_cast<float *>(MEM_dupallocN(pixels));
-    }
-
-    BKE_image_release_ibuf(image, ibuf, lock);
+  if (ibuf && ibuf->float_buffer.data &&
+      pixels_num <= IMB_get_rect_len(ibuf) * size_t(ibuf->channels))
+  {
+    memcpy(r_pixels, ibuf->float_buffer.data, pixels_num * sizeof(float));
+    found = true;
   }
 
-  if (!pixels) {
-    return nullptr;
-  }
+  BKE_image_release_ibuf(image, ibuf, lock);
 
-  return pixels;
+  return found;
 }
 
 int BKE_image_sequence_guess_offset(Image *image)
@@ -6,13 +6,17 @@
  * \ingroup bke
  */
 
+#include <algorithm>
+
 #include "MEM_guardedalloc.h"
 
 #include "BLI_boxpack_2d.h"
 #include "BLI_linklist.h"
 #include "BLI_listbase.h"
+#include "BLI_task.hh"
 #include "BLI_threads.h"
 #include "BLI_time.h"
+#include "BLI_vector.hh"
 
 #include "DNA_image_types.h"
 #include "DNA_userdef_types.h"
@@ -492,6 +496,38 @@ ImageGPUTextures BKE_image_get_gpu_material_texture(Image *image,
   return image_get_gpu_texture(image, iuser, false, use_tile_mapping);
 }
 
+void BKE_image_preload_gpu_textures(Image **images, ImageUser **iusers, const int num)
+{
+  using namespace blender;
+
+  Vector<int> indices_to_load;
+  for (const int i : IndexRange(num)) {
+    Image *ima = images[i];
+    if (ima == nullptr || ima->source != IMA_SRC_FILE) {
+      continue;
+    }
+    const int view = (iusers[i] && iusers[i]->multi_index < 2) ? iusers[i]->multi_index : 0;
+    if (ima->gputexture[TEXTARGET_2D][view] || ima->gputexture[TEXTARGET_2D_ARRAY][view]) {
+      continue;
+    }
+    indices_to_load.append(i);
+  }
+
+  /* Loading a single image gains nothing from threading. */
+  if (indices_to_load.size() < 2) {
+    return;
+  }
+
+  /* Acquiring an image buffer loads it into the image cache, where it is found again when the GPU
+   * texture is created. Acquiring is thread safe, including for images listed multiple times. */
+  threading::parallel_for(indices_to_load.index_range(), 1, [&](const IndexRange range) {
+    for (const int i : indices_to_load.as_span().slice(range)) {
+      ImBuf *ibuf = BKE_image_acquire_ibuf(images[i], iusers[i], nullptr);
+      BKE_image_release_ibuf(images[i], ibuf, nullptr);
+    }
+  });
+}
+
 /** \} */
 
 /* -------------------------------------------------------------------- */
@@ -580,11 +616,63 @@ void BKE_image_free_anim_gputextures(Main *bmain)
   }
 }
 
+/**
+ * Fraction of the GPU memory below which textures of images that were not drawn recently are
+ * freed, regardless of #UserDef.textimeout.
+ */
+#define GPU_TEXTURE_FREE_MEMORY_THRESHOLD 0.1f
+
+/**
+ * Free the GPU textures of the least recently used images when running low on GPU memory.
+ */
+static void image_free_gputextures_memory_pressure(Main *bmain, const int ctime)
+{
+  static int lasttime = 0;
+  if (ctime == lasttime || !GPU_mem_stats_supported()) {
+    return;
+  }
+  lasttime = ctime;
+
+  int total_mem_kb, free_mem_kb;
+  GPU_mem_stats_get(&total_mem_kb, &free_mem_kb);
+  if (total_mem_kb <= 0 || free_mem_kb > total_mem_kb * GPU_TEXTURE_FREE_MEMORY_THRESHOLD) {
+    return;
+  }
+
+  blender::Vector<Image *> images;
+  LISTBASE_FOREACH (Image *, ima, &bmain->images) {
+    /* Images used by the last redraws have just been tagged, keep them. */
+    if ((ima->flag & IMA_NOCOLLECT) == 0 && ctime - ima->lastused > 1 &&
+        BKE_image_has_opengl_texture(ima))
+    {
+      images.append(ima);
+    }
+  }
+  if (images.is_empty()) {
+    return;
+  }
+
+  std::sort(images.begin(), images.end(), [](const Image *a, const Image *b) {
+    return a->lastused < b->lastused;
+  });
+
+  /* Memory statistics are not updated immediately, so the amount of memory freed can't be
+   * measured here. Free half of the candidates, the next collection continues if needed. */
+  const int64_t free_len = std::max(images.size() / 2, int64_t(1));
+  for (Image *ima : images.as_span().take_front(free_len)) {
+    BKE_image_free_gputextures(ima);
+  }
+}
+
 void BKE_image_free_old_gputextures(Main *bmain)
 {
   static int lasttime = 0;
   int ctime = int(BLI_time_now_seconds());
 
+  if (!G.is_rendering) {
+    image_free_gputextures_memory_pressure(bmain, ctime);
+  }
+
   /*
    * Run garbage collector once for every collecting period of time
    * if textimeout is 0, that's the option to NOT run the collector
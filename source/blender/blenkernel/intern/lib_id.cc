@@ -9,6 +9,7 @@
  * allocate and free of all library data
  */
 
+#include <algorithm>
 #include <cctype>
 #include <cstddef>
 #include <cstdio>
@@ -35,8 +36,10 @@
 #include "BLI_blenlib.h"
 #include "BLI_ghash.h"
 #include "BLI_linklist.h"
+#include "BLI_map.hh"
 #include "BLI_memarena.h"
 #include "BLI_string_utils.hh"
+#include "BLI_vector.hh"
 
 #include "BLT_translation.hh"
 
@@ -1715,6 +1718,65 @@ void id_sort_by_name(ListBase *lb, ID *id, ID *id_sorting_hint)
 #undef ID_SORT_STEP_SIZE
 }
 
+/**
+ * Sort all IDs of \a lb in the same order #id_sort_by_name results in: local IDs first, then the
+ * IDs of each library in the order they first appear in the list, each sorted by name.
+ */
+static void id_list_sort_by_name(ListBase *lb)
+{
+  blender::Map<const Library *, int> library_order;
+  library_order.add(nullptr, 0);
+  blender::Vector<ID *> ids;
+  LISTBASE_FOREACH (ID *, id, lb) {
+    library_order.add(id->lib, library_order.size());
+    ids.append(id);
+  }
+
+  std::stable_sort(ids.begin(), ids.end(), [&](const ID *a, const ID *b) {
+    if (a->lib != b->lib) {
+      return library_order.lookup(a->lib) < library_order.lookup(b->lib);
+    }
+    return BLI_strcasecmp(a->name, b->name) < 0;
+  });
+
+  BLI_listbase_clear(lb);
+  for (ID *id : ids) {
+    BLI_addtail(lb, id);
+  }
+}
+
+void BKE_main_id_sort_defer_begin(Main *bmain)
+{
+  bmain->id_sort_defer_level++;
+}
+
+void BKE_main_id_sort_defer_end(Main *bmain)
+{
+  BLI_assert(bmain->id_sort_defer_level > 0);
+  if (--bmain->id_sort_defer_level > 0) {
+    return;
+  }
+
+  ListBase *lbarray[INDEX_ID_MAX];
+  const int lb_len = set_listbasepointers(bmain, lbarray);
+  for (const int i : blender::IndexRange(lb_len)) {
+    if (bmain->id_sort_deferred_types & (uint64_t(1) << i)) {
+      id_list_sort_by_name(lbarray[i]);
+    }
+  }
+  bmain->id_sort_deferred_types = 0;
+}
+
+static void id_sort_by_name_or_defer(Main *bmain, ListBase *lb, ID *id)
+{
+  if (bmain->id_sort_defer_level > 0) {
+    BLI_STATIC_ASSERT(INDEX_ID_MAX <= 64, "Deferred sorting flags need a bit per ID type");
+    bmain->id_sort_deferred_types |= uint64_t(1) << BKE_idtype_idcode_to_index(GS(id->name));
+    return;
+  }
+  id_sort_by_name(lb, id, nullptr);
+}
+
 bool BKE_id_new_name_validate(
     Main *bmain, ListBase *lb, ID *id, const char *tname, const bool do_linked_data)
 {
@@ -1723,7 +1785,7 @@ bool BKE_id_new_name_validate(
 
   /* If library, don't rename (unless explicitly required), but do ensure proper sorting. */
   if (!do_linked_data && ID_IS_LINKED(id)) {
-    id_sort_by_name(lb, id, nullptr);
+    id_sort_by_name_or_defer(bmain, lb, id);
 
     return result;
   }
@@ -1751,7 +1813,7 @@ bool BKE_id_new_name_validate(
   }
 
   BLI_strncpy(id->name + 2, name, sizeof(id->name) - 2);
-  id_sort_by_name(lb, id, nullptr);
+  id_sort_by_name_or_defer(bmain, lb, id);
   return result;
 }
 
@@ -260,6 +260,26 @@ TEST(lib_id_main_unique_name, ids_sorted_by_default)
   EXPECT_EQ(ctx.bmain->name_map_global, nullptr);
 }
 
+TEST(lib_id_main_unique_name, ids_sorted_deferred)
+{
+  LibIDMainSortTestContext ctx;
+
+  BKE_main_id_sort_defer_begin(ctx.bmain);
+  ID *id_foo = static_cast<ID *>(BKE_id_new(ctx.bmain, ID_OB, "Foo"));
+  ID *id_bar = static_cast<ID *>(BKE_id_new(ctx.bmain, ID_OB, "Bar"));
+  ID *id_foo2 = static_cast<ID *>(BKE_id_new(ctx.bmain, ID_OB, "Foo"));
+  ID *id_baz = static_cast<ID *>(BKE_id_new(ctx.bmain, ID_OB, "Baz"));
+  /* Unique names are still ensured, but the list isn't sorted yet. */
+  EXPECT_STREQ(id_foo2->name + 2, "Foo.001");
+  test_lib_id_main_sort_check_order({id_foo, id_bar, id_foo2, id_baz});
+  BKE_main_id_sort_defer_end(ctx.bmain);
+
+  test_lib_id_main_sort_check_order({id_bar, id_baz, id_foo, id_foo2});
+  EXPECT_EQ(ctx.bmain->id_sort_deferred_types, 0);
+
+  EXPECT_TRUE(BKE_main_namemap_validate(ctx.bmain));
+}
+
 static ID *add_id_in_library(Main *bmain, const char *name, Library *lib)
 {
   ID *id = static_cast<ID *>(BKE_id_new(bmain, ID_OB, name));
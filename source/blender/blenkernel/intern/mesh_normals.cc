@@ -627,6 +627,10 @@ struct CornerSplitTaskDataCommon {
    * different elements in the arrays. */
   CornerNormalSpaceArray *lnors_spacearr;
   MutableSpan<float3> corner_normals;
+  /* Only used when creating #CornerNormalSpaceArray::corners_by_space. The number of corners in
+   * each space, and the position of each corner in the processing order of its space. */
+  MutableSpan<int> space_corners_num;
+  MutableSpan<int> corner_index_in_space;
 
   /* Read-only. */
   Span<float3> positions;
@@ -870,8 +874,9 @@ static void lnor_space_for_single_fan(CornerSplitTaskDataCommon *common_data,
       corner_normals[corner] = corner_space_custom_data_to_normal(space, clnors_data[corner]);
     }
 
-    if (!lnors_spacearr->corners_by_space.is_empty()) {
-      lnors_spacearr->corners_by_space[space_index] = {corner};
+    if (!common_data->space_corners_num.is_empty()) {
+      common_data->space_corners_num[space_index] = 1;
+      common_data->corner_index_in_space[corner] = 0;
     }
   }
 }
@@ -961,9 +966,6 @@ static void split_corner_normal_fan_do(CornerSplitTaskDataCommon *common_data,
         /* We store here all edges-normalized vectors processed. */
         edge_vectors->append(vec_curr);
       }
-      if (!lnors_spacearr->corners_by_space.is_empty()) {
-        lnors_spacearr->corners_by_space[space_index] = processed_corners.as_span();
-      }
       if (!clnors_data.is_empty()) {
         clnors_avg += int2(clnors_data[vert_corner]);
       }
@@ -1006,6 +1008,13 @@ static void split_corner_normal_fan_do(CornerSplitTaskDataCommon *common_data,
         processed_corners.as_span(), space_index);
     edge_vectors->clear();
 
+    if (!common_data->space_corners_num.is_empty()) {
+      common_data->space_corners_num[space_index] = processed_corners.size();
+      for (const int i : processed_corners.index_range()) {
+        common_data->corner_index_in_space[processed_corners[i]] = i;
+      }
+    }
+
     if (!clnors_data.is_empty()) {
       clnors_avg /= processed_corners.size();
       lnor = corner_space_custom_data_to_normal(lnor_space, short2(clnors_avg));
@@ -1231,11 +1240,17 @@ void normals_calc_corners(const Span<float3> vert_positions,
   Vector<int, 32> fan_corners;
   corner_split_generator(&common_data, single_corners, fan_corners);
 
+  Array<int> corner_index_in_space;
   if (r_lnors_spacearr) {
     r_lnors_spacearr->spaces.reinitialize(single_corners.size() + fan_corners.size());
     r_lnors_spacearr->corner_space_indices = Array<int>(corner_verts.size(), -1);
     if (r_lnors_spacearr->create_corners_by_space) {
-      r_lnors_spacearr->corners_by_space.reinitialize(r_lnors_spacearr->spaces.size());
+      const int spaces_num = r_lnors_spacearr->spaces.size();
+      r_lnors_spacearr->corners_by_space_offsets.reinitialize(spaces_num + 1);
+      corner_index_in_space.reinitialize(corner_verts.size());
+      common_data.space_corners_num =
+          r_lnors_spacearr->corners_by_space_offsets.as_mutable_span().take_front(spaces_num);
+      common_data.corner_index_in_space = corner_index_in_space;
     }
   }
 
@@ -1254,6 +1269,24 @@ void normals_calc_corners(const Span<float3> vert_positions,
       split_corner_normal_fan_do(&common_data, corner, space_index, &edge_vectors);
     }
   });
+
+  if (r_lnors_spacearr && r_lnors_spacearr->create_corners_by_space) {
+    /* Every corner is part of at most one space, so the map can be built by scattering the
+     * corners to their position in the processing order of each space. */
+    const OffsetIndices<int> offsets = offset_indices::accumulate_counts_to_offsets(
+        r_lnors_spacearr->corners_by_space_offsets);
+    r_lnors_spacearr->corners_by_space_indices.reinitialize(offsets.total_size());
+    MutableSpan<int> indices = r_lnors_spacearr->corners_by_space_indices;
+    const Span<int> corner_space_indices = r_lnors_spacearr->corner_space_indices;
+    threading::parallel_for(corner_space_indices.index_range(), 4096, [&](const IndexRange range) {
+      for (const int corner : range) {
+        const int space_index = corner_space_indices[corner];
+        if (space_index != -1) {
+          indices[offsets[space_index][corner_index_in_space[corner]]] = corner;
+        }
+      }
+    });
+  }
 }
 
 #undef INDEX_UNSET
@@ -1352,7 +1385,7 @@ static void mesh_normals_corner_custom_set(const Span<float3> positions,
       }
 
       const int space_index = lnors_spacearr.corner_space_indices[i];
-      const Span<int> fan_corners = lnors_spacearr.corners_by_space[space_index];
+      const Span<int> fan_corners = lnors_spacearr.corners_by_space()[space_index];
 
       /* Notes:
        * - In case of mono-corner smooth fan, we have nothing to do.
@@ -1447,7 +1480,7 @@ static void mesh_normals_corner_custom_set(const Span<float3> positions,
     }
 
     const int space_index = lnors_spacearr.corner_space_indices[i];
-    const Span<int> fan_corners = lnors_spacearr.corners_by_space[space_index];
+    const Span<int> fan_corners = lnors_spacearr.corners_by_space()[space_index];
 
     /* Note we accumulate and average all custom normals in current smooth fan,
      * to avoid getting different clnors data (tiny differences in plain custom normals can
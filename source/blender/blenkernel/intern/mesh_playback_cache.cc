@@ -0,0 +1,104 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup bke
+ */
+
+#include <cmath>
+
+#include "BLI_math_vector_types.hh"
+
+#include "DNA_mesh_types.h"
+#include "DNA_object_types.h"
+
+#include "BKE_customdata.hh"
+#include "BKE_mesh.h"
+#include "BKE_mesh_playback_cache.hh"
+#include "BKE_object_types.hh"
+
+namespace blender::bke {
+
+/** Memory that the cached frames of a single object may use. */
+static constexpr int64_t MEMORY_LIMIT = int64_t(1024) * 1024 * 1024;
+
+/**
+ * Deforming modifiers usually only change positions, the other arrays stay shared between frames.
+ * Vertex and face normals are included since they are computed again for changed positions.
+ */
+static int64_t estimate_frame_memory(const Mesh &mesh)
+{
+  return int64_t(sizeof(float3)) * (int64_t(mesh.verts_num) * 2 + int64_t(mesh.faces_num));
+}
+
+const MeshPlaybackCache::Frame *MeshPlaybackCache::lookup(const float ctime,
+                                                          const CustomData_MeshMasks &data_mask,
+                                                          const bool need_mapping) const
+{
+  const Frame *frame = frames_.lookup_ptr(ctime);
+  if (frame == nullptr) {
+    return nullptr;
+  }
+  if (!CustomData_MeshMasks_are_matching(&frame->data_mask, &data_mask)) {
+    return nullptr;
+  }
+  if (need_mapping && !frame->need_mapping) {
+    return nullptr;
+  }
+  return frame;
+}
+
+void MeshPlaybackCache::add(const float ctime,
+                            const GeometrySet &geometry,
+                            const Mesh &mesh_eval,
+                            const Mesh *mesh_deform_eval,
+                            const CustomData_MeshMasks &data_mask,
+                            const bool need_mapping)
+{
+  Frame frame;
+  frame.geometry = geometry;
+  frame.geometry.replace_mesh(BKE_mesh_copy_for_eval(&mesh_eval));
+  frame.memory = estimate_frame_memory(mesh_eval);
+  if (mesh_deform_eval != nullptr) {
+    frame.deform.replace_mesh(BKE_mesh_copy_for_eval(mesh_deform_eval));
+    frame.memory += estimate_frame_memory(*mesh_deform_eval);
+  }
+  frame.data_mask = data_mask;
+  frame.need_mapping = need_mapping;
+
+  if (const Frame *old_frame = frames_.lookup_ptr(ctime)) {
+    memory_ -= old_frame->memory;
+    frames_.remove(ctime);
+  }
+  if (frame.memory > MEMORY_LIMIT) {
+    return;
+  }
+  while (memory_ + frame.memory > MEMORY_LIMIT) {
+    float furthest_ctime = ctime;
+    for (const float other_ctime : frames_.keys()) {
+      if (std::abs(other_ctime - ctime) >= std::abs(furthest_ctime - ctime)) {
+        furthest_ctime = other_ctime;
+      }
+    }
+    memory_ -= frames_.pop(furthest_ctime).memory;
+  }
+
+  memory_ += frame.memory;
+  frames_.add_new(ctime, std::move(frame));
+}
+
+void MeshPlaybackCache::clear()
+{
+  frames_.clear();
+  memory_ = 0;
+}
+
+void mesh_playback_cache_clear(Object &object)
+{
+  if (object.runtime->mesh_playback_cache) {
+    object.runtime->mesh_playback_cache->clear();
+  }
+}
+
+}  // namespace blender::bke
@@ -25,6 +25,7 @@
 #include "BLI_memarena.h"
 #include "BLI_polyfill_2d.h"
 #include "BLI_rand.h"
+#include "BLI_task.hh"
 #include "BLI_utildefines.h"
 
 #include "BKE_bvhutils.hh"
@@ -358,6 +359,67 @@ void BKE_mesh_remap_item_define_invalid(MeshPairRemap *map, const int index)
   mesh_remap_item_define(map, index, FLT_MAX, 0, 0, nullptr, nullptr);
 }
 
+/**
+ * Allocating from the map's arena isn't thread-safe. For mapping modes with a small fixed number
+ * of sources per item, allocate the source arrays of all items up front, so that
+ * #mesh_remap_item_define_preallocated can be used from multiple threads.
+ */
+static void mesh_remap_items_sources_preallocate(MeshPairRemap *map, const int sources_max)
+{
+  MemArena *mem = map->mem;
+  const size_t num = size_t(map->items_num) * size_t(sources_max);
+  int *indices = static_cast<int *>(BLI_memarena_alloc(mem, sizeof(*indices) * num));
+  float *weights = static_cast<float *>(BLI_memarena_alloc(mem, sizeof(*weights) * num));
+  for (int i = 0; i < map->items_num; i++) {
+    map->items[i].indices_src = &indices[i * sources_max];
+    map->items[i].weights_src = &weights[i * sources_max];
+  }
+}
+
+static void mesh_remap_item_define_preallocated(MeshPairRemap *map,
+                                                const int index,
+                                                const int sources_num,
+                                                const int *indices_src,
+                                                const float *weights_src)
+{
+  MeshPairRemapItem *mapit = &map->items[index];
+  mapit->sources_num = sources_num;
+  if (sources_num) {
+    memcpy(mapit->indices_src, indices_src, sizeof(*mapit->indices_src) * size_t(sources_num));
+    memcpy(mapit->weights_src, weights_src, sizeof(*mapit->weights_src) * size_t(sources_num));
+  }
+  else {
+    mapit->indices_src = nullptr;
+    mapit->weights_src = nullptr;
+  }
+  mapit->island = 0;
+}
+
+/**
+ * Call \a fn for every destination item, with fixed size blocks of items processed in parallel.
+ * The blocks don't depend on scheduling, so the proximity heuristic of
+ * #mesh_remap_bvhtree_query_nearest (reset at the start of every block) gives the same mapping on
+ * every run.
+ */
+template<typename Fn>
+static void mesh_remap_parallel_for_nearest(const int items_num, const Fn &fn)
+{
+  constexpr int block_size = 1024;
+  const int blocks_num = (items_num + block_size - 1) / block_size;
+  blender::threading::parallel_for(
+      blender::IndexRange(blocks_num), 1, [&](const blender::IndexRange blocks) {
+        for (const int64_t block : blocks) {
+          const int start = int(block) * block_size;
+          const int end = std::min(start + block_size, items_num);
+          BVHTreeNearest block_nearest = {0};
+          block_nearest.index = -1;
+          for (int index = start; index < end; index++) {
+            fn(index, block_nearest);
+          }
+        }
+      });
+}
+
 static int mesh_remap_interp_face_data_get(const blender::IndexRange face,
                                            const blender::Span<int> corner_verts,
                                            const blender::Span<blender::float3> positions_src,
@@ -479,73 +541,83 @@ void BKE_mesh_remap_calc_verts_from_mesh(const int mode,
 
     if (mode == MREMAP_MODE_VERT_NEAREST) {
       BKE_bvhtree_from_mesh_get(&treedata, me_src, BVHTREE_FROM_VERTS, 2);
-      nearest.index = -1;
+      mesh_remap_items_sources_preallocate(r_map, 1);
 
-      for (i = 0; i < numverts_dst; i++) {
-        copy_v3_v3(tmp_co, vert_positions_dst[i]);
+      mesh_remap_parallel_for_nearest(
+          numverts_dst, [&](const int vert_dst, BVHTreeNearest &block_nearest) {
+            float co[3];
+            float dist;
+            copy_v3_v3(co, vert_positions_dst[vert_dst]);
 
-        /* Convert the vertex to tree coordinates, if needed. */
-        if (space_transform) {
-          BLI_space_transform_apply(space_transform, tmp_co);
-        }
+            /* Convert the vertex to tree coordinates, if needed. */
+            if (space_transform) {
+              BLI_space_transform_apply(space_transform, co);
+            }
 
-        if (mesh_remap_bvhtree_query_nearest(&treedata, &nearest, tmp_co, max_dist_sq, &hit_dist))
-        {
-          mesh_remap_item_define(r_map, i, hit_dist, 0, 1, &nearest.index, &full_weight);
-        }
-        else {
-          /* No source for this dest vertex! */
-          BKE_mesh_remap_item_define_invalid(r_map, i);
-        }
-      }
+            if (mesh_remap_bvhtree_query_nearest(
+                    &treedata, &block_nearest, co, max_dist_sq, &dist))
+            {
+              mesh_remap_item_define_preallocated(
+                  r_map, vert_dst, 1, &block_nearest.index, &full_weight);
+            }
+            else {
+              /* No source for this dest vertex! */
+              mesh_remap_item_define_preallocated(r_map, vert_dst, 0, nullptr, nullptr);
+            }
+          });
     }
     else if (ELEM(mode, MREMAP_MODE_VERT_EDGE_NEAREST, MREMAP_MODE_VERT_EDGEINTERP_NEAREST)) {
       const blender::Span<blender::int2> edges_src = me_src->edges();
       const blender::Span<blender::float3> positions_src = me_src->vert_positions();
 
       BKE_bvhtree_from_mesh_get(&treedata, me_src, BVHTREE_FROM_EDGES, 2);
-      nearest.index = -1;
+      mesh_remap_items_sources_preallocate(r_map,
+                                           mode == MREMAP_MODE_VERT_EDGEINTERP_NEAREST ? 2 : 1);
 
-      for (i = 0; i < numverts_dst; i++) {
-        copy_v3_v3(tmp_co, vert_positions_dst[i]);
+      mesh_remap_parallel_for_nearest(
+          numverts_dst, [&](const int vert_dst, BVHTreeNearest &block_nearest) {
+            float co[3];
+            float dist;
+            copy_v3_v3(co, vert_positions_dst[vert_dst]);
 
-        /* Convert the vertex to tree coordinates, if needed. */
-        if (space_transform) {
-          BLI_space_transform_apply(space_transform, tmp_co);
-        }
+            /* Convert the vertex to tree coordinates, if needed. */
+            if (space_transform) {
+              BLI_space_transform_apply(space_transform, co);
+            }
 
-        if (mesh_remap_bvhtree_query_nearest(&treedata, &nearest, tmp_co, max_dist_sq, &hit_dist))
-        {
-          const blender::int2 &edge = edges_src[nearest.index];
-          const float *v1cos = positions_src[edge[0]];
-          const float *v2cos = positions_src[edge[1]];
-
-          if (mode == MREMAP_MODE_VERT_EDGE_NEAREST) {
-            const float dist_v1 = len_squared_v3v3(tmp_co, v1cos);
-            const float dist_v2 = len_squared_v3v3(tmp_co, v2cos);
-            const int index = (dist_v1 > dist_v2) ? edge[1] : edge[0];
-            mesh_remap_item_define(r_map, i, hit_dist, 0, 1, &index, &full_weight);
-          }
-          else if (mode == MREMAP_MODE_VERT_EDGEINTERP_NEAREST) {
-            int indices[2];
-            float weights[2];
+            if (!mesh_remap_bvhtree_query_nearest(
+                    &treedata, &block_nearest, co, max_dist_sq, &dist))
+            {
+              /* No source for this dest vertex! */
+              mesh_remap_item_define_preallocated(r_map, vert_dst, 0, nullptr, nullptr);
+              return;
+            }
 
-            indices[0] = edge[0];
-            indices[1] = edge[1];
+            const blender::int2 &edge = edges_src[block_nearest.index];
+            const float *v1cos = positions_src[edge[0]];
+            const float *v2cos = positions_src[edge[1]];
 
-            /* Weight is inverse of point factor here... */
-            weights[0] = line_point_factor_v3(tmp_co, v2cos, v1cos);
-            CLAMP(weights[0], 0.0f, 1.0f);
-            weights[1] = 1.0f - weights[0];
+            if (mode == MREMAP_MODE_VERT_EDGE_NEAREST) {
+              const float dist_v1 = len_squared_v3v3(co, v1cos);
+              const float dist_v2 = len_squared_v3v3(co, v2cos);
+              const int index = (dist_v1 > dist_v2) ? edge[1] : edge[0];
+              mesh_remap_item_define_preallocated(r_map, vert_dst, 1, &index, &full_weight);
+            }
+            else if (mode == MREMAP_MODE_VERT_EDGEINTERP_NEAREST) {
+              int indices[2];
+              float weights[2];
 
-            mesh_remap_item_define(r_map, i, hit_dist, 0, 2, indices, weights);
-          }
-        }
-        else {
-          /* No source for this dest vertex! */
-          BKE_mesh_remap_item_define_invalid(r_map, i);
-        }
-      }
+              indices[0] = edge[0];
+              indices[1] = edge[1];
+
+              /* Weight is inverse of point factor here... */
+              weights[0] = line_point_factor_v3(co, v2cos, v1cos);
+              CLAMP(weights[0], 0.0f, 1.0f);
+              weights[1] = 1.0f - weights[0];
+
+              mesh_remap_item_define_preallocated(r_map, vert_dst, 2, indices, weights);
+            }
+          });
     }
     else if (ELEM(mode,
                   MREMAP_MODE_VERT_FACE_NEAREST,
@@ -2072,29 +2144,32 @@ void BKE_mesh_remap_calc_faces_from_mesh(const int mode,
     BKE_bvhtree_from_mesh_get(&treedata, me_src, BVHTREE_FROM_CORNER_TRIS, 2);
 
     if (mode == MREMAP_MODE_POLY_NEAREST) {
-      nearest.index = -1;
+      mesh_remap_items_sources_preallocate(r_map, 1);
 
-      for (const int64_t i : faces_dst.index_range()) {
-        const blender::IndexRange face = faces_dst[i];
-        tmp_co = blender::bke::mesh::face_center_calc(
-            {reinterpret_cast<const blender::float3 *>(vert_positions_dst), numverts_dst},
-            {&corner_verts_dst[face.start()], face.size()});
+      mesh_remap_parallel_for_nearest(
+          int(faces_dst.size()), [&](const int face_dst, BVHTreeNearest &block_nearest) {
+            const blender::IndexRange face = faces_dst[face_dst];
+            blender::float3 co = blender::bke::mesh::face_center_calc(
+                {reinterpret_cast<const blender::float3 *>(vert_positions_dst), numverts_dst},
+                {&corner_verts_dst[face.start()], face.size()});
+            float dist;
 
-        /* Convert the vertex to tree coordinates, if needed. */
-        if (space_transform) {
-          BLI_space_transform_apply(space_transform, tmp_co);
-        }
+            /* Convert the vertex to tree coordinates, if needed. */
+            if (space_transform) {
+              BLI_space_transform_apply(space_transform, co);
+            }
 
-        if (mesh_remap_bvhtree_query_nearest(&treedata, &nearest, tmp_co, max_dist_sq, &hit_dist))
-        {
-          const int face_index = tri_faces[nearest.index];
-          mesh_remap_item_define(r_map, int(i), hit_dist, 0, 1, &face_index, &full_weight);
-        }
-        else {
-          /* No source for this dest face! */
-          BKE_mesh_remap_item_define_invalid(r_map, int(i));
-        }
-      }
+            if (mesh_remap_bvhtree_query_nearest(
+                    &treedata, &block_nearest, co, max_dist_sq, &dist))
+            {
+              const int face_index = tri_faces[block_nearest.index];
+              mesh_remap_item_define_preallocated(r_map, face_dst, 1, &face_index, &full_weight);
+            }
+            else {
+              /* No source for this dest face! */
+              mesh_remap_item_define_preallocated(r_map, face_dst, 0, nullptr, nullptr);
+            }
+          });
     }
     else if (mode == MREMAP_MODE_POLY_NOR) {
       for (const int64_t i : faces_dst.index_range()) {
@@ -235,12 +235,24 @@ blender::Span<blender::int3> Mesh::corner_tris() const
 
     r_data.reinitialize(poly_to_tri_count(faces.size(), corner_verts.size()));
 
-    if (BKE_mesh_face_normals_are_dirty(this)) {
+    const Span<float3> face_normals = BKE_mesh_face_normals_are_dirty(this) ?
+                                          Span<float3>() :
+                                          this->face_normals();
+    if (this->runtime->corner_tris_prev_cache.is_cached()) {
+      blender::bke::mesh::corner_tris_calc_reuse(positions,
+                                                 faces,
+                                                 corner_verts,
+                                                 face_normals,
+                                                 this->runtime->corner_tris_prev_cache.data(),
+                                                 r_data);
+      this->runtime->corner_tris_prev_cache.tag_dirty();
+    }
+    else if (face_normals.is_empty()) {
       blender::bke::mesh::corner_tris_calc(positions, faces, corner_verts, r_data);
     }
     else {
       blender::bke::mesh::corner_tris_calc_with_normals(
-          positions, faces, corner_verts, this->face_normals(), r_data);
+          positions, faces, corner_verts, face_normals, r_data);
     }
   });
 
@@ -297,6 +309,7 @@ void BKE_mesh_runtime_clear_geometry(Mesh *mesh)
   mesh->runtime->loose_verts_cache.tag_dirty();
   mesh->runtime->verts_no_face_cache.tag_dirty();
   mesh->runtime->corner_tris_cache.tag_dirty();
+  mesh->runtime->corner_tris_prev_cache.tag_dirty();
   mesh->runtime->corner_tri_faces_cache.tag_dirty();
   mesh->runtime->shrinkwrap_boundary_cache.tag_dirty();
   mesh->runtime->subsurf_face_dot_tags.clear_and_shrink();
@@ -364,6 +377,10 @@ void Mesh::tag_positions_changed()
 void Mesh::tag_positions_changed_no_normals()
 {
   free_bvh_cache(*this->runtime);
+  if (this->runtime->corner_tris_cache.is_cached()) {
+    /* Keep the triangulation around, since it may still be valid for many faces. */
+    this->runtime->corner_tris_prev_cache = this->runtime->corner_tris_cache;
+  }
   this->runtime->corner_tris_cache.tag_dirty();
   this->runtime->bounds_cache.tag_dirty();
   this->runtime->shrinkwrap_boundary_cache.tag_dirty();
@@ -11,6 +11,8 @@
  * \see `bmesh_mesh_tessellate.cc` for the #BMesh equivalent of this file.
  */
 
+#include <algorithm>
+
 #include "BLI_array_utils.hh"
 #include "BLI_enumerable_thread_specific.hh"
 #include "BLI_math_geom.h"
@@ -32,14 +34,43 @@ namespace blender::bke::mesh {
  * Fill in Corner Triangle Array
  * \{ */
 
+/**
+ * Check whether a triangulation of an n-gon is still valid for its current vertex positions,
+ * meaning all triangles still have the same winding as the whole face when projected to 2D.
+ */
+static bool ngon_tessellation_is_valid(const float (*projverts)[2],
+                                       const int face_start,
+                                       const int face_size,
+                                       const int3 *tris)
+{
+  const float face_sign = cross_poly_v2(projverts, uint(face_size));
+  if (face_sign == 0.0f) {
+    return false;
+  }
+  const int totfilltri = face_size - 2;
+  for (int j = 0; j < totfilltri; j++) {
+    const int3 &tri = tris[j];
+    const float tri_sign = cross_tri_v2(projverts[tri[0] - face_start],
+                                        projverts[tri[1] - face_start],
+                                        projverts[tri[2] - face_start]);
+    if (face_sign > 0.0f ? tri_sign <= 0.0f : tri_sign >= 0.0f) {
+      return false;
+    }
+  }
+  return true;
+}
+
 /**
  * \param face_normal: This will be optimized out as a constant.
+ * \param tri_prev: Optional triangulation of the face from before its positions were changed,
+ * reused for n-gons when it is still valid.
  */
 BLI_INLINE void mesh_calc_tessellation_for_face_impl(const Span<int> corner_verts,
                                                      const Span<float3> positions,
                                                      const int face_start,
                                                      const int face_size,
                                                      int3 *tri,
+                                                     const int3 *tri_prev,
                                                      MemArena **pf_arena_p,
                                                      const bool face_normal,
                                                      const float normal_precalc[3])
@@ -113,6 +144,13 @@ BLI_INLINE void mesh_calc_tessellation_for_face_impl(const Span<int> corner_vert
         mul_v2_m3v3(projverts[j], axis_mat, positions[corner_verts[face_start + j]]);
       }
 
+      if (tri_prev && ngon_tessellation_is_valid(projverts, face_start, face_size, tri_prev)) {
+        /* Filling the face is much more expensive than checking the existing triangulation. */
+        std::copy_n(tri_prev, totfilltri, tri);
+        BLI_memarena_clear(pf_arena);
+        break;
+      }
+
       BLI_polyfill_calc_arena(projverts, uint(face_size), 1, tris, pf_arena);
 
       /* Apply fill. */
@@ -132,10 +170,11 @@ static void mesh_calc_tessellation_for_face(const Span<int> corner_verts,
                                             const int face_start,
                                             const int face_size,
                                             int3 *tri,
+                                            const int3 *tri_prev,
                                             MemArena **pf_arena_p)
 {
   mesh_calc_tessellation_for_face_impl(
-      corner_verts, positions, face_start, face_size, tri, pf_arena_p, false, nullptr);
+      corner_verts, positions, face_start, face_size, tri, tri_prev, pf_arena_p, false, nullptr);
 }
 
 static void mesh_calc_tessellation_for_face_with_normal(const Span<int> corner_verts,
@@ -143,11 +182,19 @@ static void mesh_calc_tessellation_for_face_with_normal(const Span<int> corner_v
                                                         const int face_start,
                                                         const int face_size,
                                                         int3 *tri,
+                                                        const int3 *tri_prev,
                                                         MemArena **pf_arena_p,
                                                         const float normal_precalc[3])
 {
-  mesh_calc_tessellation_for_face_impl(
-      corner_verts, positions, face_start, face_size, tri, pf_arena_p, true, normal_precalc);
+  mesh_calc_tessellation_for_face_impl(corner_verts,
+                                       positions,
+                                       face_start,
+                                       face_size,
+                                       tri,
+                                       tri_prev,
+                                       pf_arena_p,
+                                       true,
+                                       normal_precalc);
 }
 
 struct LocalData {
@@ -165,9 +212,14 @@ static void corner_tris_calc_impl(const Span<float3> positions,
                                   const OffsetIndices<int> faces,
                                   const Span<int> corner_verts,
                                   const Span<float3> face_normals,
+                                  const Span<int3> corner_tris_prev,
                                   MutableSpan<int3> corner_tris)
 {
+  BLI_assert(corner_tris_prev.is_empty() || corner_tris_prev.size() == corner_tris.size());
   threading::EnumerableThreadSpecific<LocalData> all_local_data;
+  auto prev_tris_get = [&](const int tris_start) -> const int3 * {
+    return corner_tris_prev.is_empty() ? nullptr : &corner_tris_prev[tris_start];
+  };
   if (face_normals.is_empty()) {
     threading::parallel_for(faces.index_range(), 1024, [&](const IndexRange range) {
       LocalData &local_data = all_local_data.local();
@@ -180,6 +232,7 @@ static void corner_tris_calc_impl(const Span<float3> positions,
                                         face_start,
                                         face_size,
                                         &corner_tris[tris_start],
+                                        prev_tris_get(tris_start),
                                         &local_data.pf_arena);
       }
     });
@@ -196,6 +249,7 @@ static void corner_tris_calc_impl(const Span<float3> positions,
                                                     face_start,
                                                     face_size,
                                                     &corner_tris[tris_start],
+                                                    prev_tris_get(tris_start),
                                                     &local_data.pf_arena,
                                                     face_normals[i]);
       }
@@ -208,7 +262,7 @@ void corner_tris_calc(const Span<float3> vert_positions,
                       const Span<int> corner_verts,
                       MutableSpan<int3> corner_tris)
 {
-  corner_tris_calc_impl(vert_positions, faces, corner_verts, {}, corner_tris);
+  corner_tris_calc_impl(vert_positions, faces, corner_verts, {}, {}, corner_tris);
 }
 
 void corner_tris_calc_face_indices(const OffsetIndices<int> faces, MutableSpan<int> tri_faces)
@@ -230,7 +284,18 @@ void corner_tris_calc_with_normals(const Span<float3> vert_positions,
                                    MutableSpan<int3> corner_tris)
 {
   BLI_assert(!face_normals.is_empty() || faces.is_empty());
-  corner_tris_calc_impl(vert_positions, faces, corner_verts, face_normals, corner_tris);
+  corner_tris_calc_impl(vert_positions, faces, corner_verts, face_normals, {}, corner_tris);
+}
+
+void corner_tris_calc_reuse(const Span<float3> vert_positions,
+                            const OffsetIndices<int> faces,
+                            const Span<int> corner_verts,
+                            const Span<float3> face_normals,
+                            const Span<int3> corner_tris_prev,
+                            MutableSpan<int3> corner_tris)
+{
+  corner_tris_calc_impl(
+      vert_positions, faces, corner_verts, face_normals, corner_tris_prev, corner_tris);
 }
 
 /** \} */
@@ -41,6 +41,7 @@
 #include "BLI_string.h"
 #include "BLI_string_utf8.h"
 #include "BLI_string_utils.hh"
+#include "BLI_time.h"
 #include "BLI_utildefines.h"
 
 #include "BLT_translation.hh"
@@ -69,6 +70,7 @@
 /* end */
 
 #include "DEG_depsgraph.hh"
+#include "DEG_depsgraph_debug.hh"
 #include "DEG_depsgraph_query.hh"
 
 #include "MOD_modifiertypes.hh"
@@ -1461,6 +1463,8 @@ ScopedModifierTimer::~ScopedModifierTimer()
   const double end_time = get_current_time_in_seconds();
   const double duration = end_time - start_time_;
   md_.execution_time = duration;
+  /* The trace uses its own clock, only the duration is shared. */
+  DEG_debug_trace_event_add(md_.name, "modifier", BLI_time_now_seconds() - duration, duration);
 }
 
 }  // namespace blender::bke
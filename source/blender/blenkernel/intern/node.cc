@@ -46,6 +46,7 @@
 #include "BLI_string_utils.hh"
 #include "BLI_threads.h"
 #include "BLI_time.h"
+#include "BLI_trace.hh"
 #include "BLI_utildefines.h"
 #include "BLI_vector_set.hh"
 #include "BLT_translation.hh"
@@ -4642,6 +4643,8 @@ void node_type_storage(bNodeType *ntype,
 
 void BKE_node_system_init()
 {
+  TRACE_SCOPE("BKE::node_system_init");
+
   blender::bke::nodetreetypes_hash = BLI_ghash_str_new("nodetreetypes_hash gh");
   blender::bke::nodetypes_hash = BLI_ghash_str_new("nodetypes_hash gh");
   blender::bke::nodetypes_alias_hash = BLI_ghash_str_new("nodetypes_alias_hash gh");
@@ -4881,6 +4881,7 @@ void BKE_object_runtime_reset_on_copy(Object *object, const int /*flag*/)
   runtime->pose_backup = nullptr;
   runtime->object_as_temp_curve = nullptr;
   runtime->geometry_set_eval = nullptr;
+  runtime->mesh_playback_cache.reset();
 
   runtime->crazyspace_deform_imats = {};
   runtime->crazyspace_deform_cos = {};
@@ -90,6 +90,8 @@ struct DupliContext {
   Scene *scene;
   /** Root parent object at the scene level. */
   Object *root_object;
+  /** Hash of the #root_object name, used for #DupliObject.random_id of every instance. */
+  uint root_object_name_hash;
   /** Immediate parent object in the context. */
   Object *object;
   float space_mat[4][4];
@@ -153,6 +155,7 @@ static void init_context(DupliContext *r_ctx,
   r_ctx->collection = nullptr;
 
   r_ctx->root_object = ob;
+  r_ctx->root_object_name_hash = BLI_hash_int(BLI_hash_string(ob->id.name + 2));
   r_ctx->object = ob;
   r_ctx->obedit = OBEDIT_FROM_OBACT(ob);
   r_ctx->instance_stack = &instance_stack;
@@ -301,7 +304,7 @@ static DupliObject *make_dupli(const DupliContext *ctx,
   }
 
   if (ctx->root_object != ob) {
-    dob->random_id ^= BLI_hash_int(BLI_hash_string(ctx->root_object->id.name + 2));
+    dob->random_id ^= ctx->root_object_name_hash;
   }
 
   return dob;
@@ -317,6 +320,15 @@ static DupliObject *make_dupli(const DupliContext *ctx,
   return make_dupli(ctx, ob, static_cast<ID *>(ob->data), mat, index, geometry, instance_index);
 }
 
+/**
+ * Cheap check for whether #get_dupli_generator can return a generator for the object, used to
+ * skip creating a sub-context for every instance of objects that don't instance anything.
+ */
+static bool object_may_create_duplis(const Object &ob)
+{
+  return (ob.transflag & OB_DUPLI) != 0 || ob.runtime->geometry_set_eval != nullptr;
+}
+
 /**
  * Recursive dupli-objects.
  *
@@ -943,6 +955,15 @@ static void make_duplis_geometry_set_impl(const DupliContext *ctx,
   Span<int> almost_unique_ids = instances->almost_unique_ids();
   Span<InstanceReference> references = instances->references();
 
+  /* Millions of instances often reference only a few objects, so check once per reference
+   * whether recursing into the instanced object can create more duplis at all. */
+  Array<bool> reference_may_create_duplis(references.size());
+  for (const int handle : references.index_range()) {
+    const InstanceReference &reference = references[handle];
+    reference_may_create_duplis[handle] = reference.type() == InstanceReference::Type::Object &&
+                                          object_may_create_duplis(reference.object());
+  }
+
   for (int64_t i : instance_offset_matrices.index_range()) {
     const InstanceReference &reference = references[reference_handles[i]];
     const int id = almost_unique_ids[i];
@@ -963,6 +984,9 @@ static void make_duplis_geometry_set_impl(const DupliContext *ctx,
         mul_m4_m4m4(matrix, parent_transform, instance_offset_matrices[i].ptr());
         make_dupli(ctx_for_instance, &object, matrix, id, &geometry_set, i);
 
+        if (!reference_may_create_duplis[reference_handles[i]]) {
+          break;
+        }
         float space_matrix[4][4];
         mul_m4_m4m4(
             space_matrix, instance_offset_matrices[i].ptr(), object.world_to_object().ptr());
@@ -31,6 +31,7 @@
 #include "BKE_layer.hh"
 #include "BKE_mball.hh"
 #include "BKE_mesh.hh"
+#include "BKE_mesh_playback_cache.hh"
 #include "BKE_object.hh"
 #include "BKE_object_types.hh"
 #include "BKE_particle.h"
@@ -322,6 +323,7 @@ void BKE_object_eval_ptcache_reset(Depsgraph *depsgraph, Scene *scene, Object *o
 {
   DEG_debug_print_eval(depsgraph, __func__, object->id.name, object);
   BKE_ptcache_object_reset(scene, object, PTCACHE_RESET_DEPSGRAPH);
+  blender::bke::mesh_playback_cache_clear(*object);
 }
 
 void BKE_object_eval_transform_all(Depsgraph *depsgraph, Scene *scene, Object *object)
@@ -162,7 +162,9 @@ static bool face_materials_match(const Span<int> material_indices,
 }
 
 /* Adapted from BLI_kdopbvh.c */
-/* Returns the index of the first element on the right of the partition */
+/* Returns the index of the first element on the right of the partition. The bounds of the
+ * primitive centroids on each side are computed as well, so that the children don't have to
+ * iterate over their primitives again to find them. */
 static int partition_prim_indices(MutableSpan<int> prim_indices,
                                   int *prim_scratch,
                                   int lo,
@@ -170,8 +172,13 @@ static int partition_prim_indices(MutableSpan<int> prim_indices,
                                   int axis,
                                   float mid,
                                   const Span<Bounds<float3>> prim_bounds,
-                                  const Span<int> prim_to_face_map)
+                                  const Span<int> prim_to_face_map,
+                                  Bounds<float3> &r_left_cb,
+                                  Bounds<float3> &r_right_cb)
 {
+  r_left_cb = negative_bounds();
+  r_right_cb = negative_bounds();
+
   for (int i = lo; i < hi; i++) {
     prim_scratch[i - lo] = prim_indices[i];
   }
@@ -184,7 +191,12 @@ static int partition_prim_indices(MutableSpan<int> prim_indices,
     const Bounds<float3> &bounds = prim_bounds[prim_scratch[i2]];
     const bool side = math::midpoint(bounds.min[axis], bounds.max[axis]) >= mid;
 
+    Bounds<float3> &side_cb = side ? r_right_cb : r_left_cb;
+
     while (i1 < hi && prim_to_face_map[prim_scratch[i2]] == face_i) {
+      const Bounds<float3> &prim_bounds_i = prim_bounds[prim_scratch[i2]];
+      math::min_max(
+          math::midpoint(prim_bounds_i.min, prim_bounds_i.max), side_cb.min, side_cb.max);
       prim_indices[side ? hi2-- : lo2++] = prim_scratch[i2];
       i1++;
       i2++;
@@ -228,15 +240,15 @@ static int partition_indices_material_faces(MutableSpan<int> indices,
 /* Add a vertex to the map, with a positive value for unique vertices and
  * a negative value for additional vertices */
 static int map_insert_vert(Map<int, int> &map,
-                           MutableSpan<bool> vert_bitmap,
+                           const Span<int> vert_owners,
+                           const int leaf_order,
                            int *face_verts,
                            int *uniq_verts,
                            int vertex)
 {
   return map.lookup_or_add_cb(vertex, [&]() {
     int value;
-    if (!vert_bitmap[vertex]) {
-      vert_bitmap[vertex] = true;
+    if (vert_owners[vertex] == leaf_order) {
       value = *uniq_verts;
       (*uniq_verts)++;
     }
@@ -248,12 +260,14 @@ static int map_insert_vert(Map<int, int> &map,
   });
 }
 
-/* Find vertices used by the faces in this node and update the draw buffers */
+/* Find vertices used by the faces in this node and update the draw buffers. A vertex is unique
+ * to the node when it is the vertex's owner, see #calc_vert_owners. */
 static void build_mesh_leaf_node(const Span<int> corner_verts,
                                  const Span<int3> corner_tris,
                                  const Span<int> tri_faces,
                                  const Span<bool> hide_poly,
-                                 MutableSpan<bool> vert_bitmap,
+                                 const Span<int> vert_owners,
+                                 const int leaf_order,
                                  PBVHNode *node)
 {
   node->uniq_verts = node->face_verts = 0;
@@ -268,8 +282,12 @@ static void build_mesh_leaf_node(const Span<int> corner_verts,
   for (const int i : prim_indices.index_range()) {
     const int3 &tri = corner_tris[prim_indices[i]];
     for (int j = 0; j < 3; j++) {
-      node->face_vert_indices[i][j] = map_insert_vert(
-          map, vert_bitmap, &node->face_verts, &node->uniq_verts, corner_verts[tri[j]]);
+      node->face_vert_indices[i][j] = map_insert_vert(map,
+                                                      vert_owners,
+                                                      leaf_order,
+                                                      &node->face_verts,
+                                                      &node->uniq_verts,
+                                                      corner_verts[tri[j]]);
     }
   }
 
@@ -358,12 +376,8 @@ static void build_grid_leaf_node(PBVH *pbvh, PBVHNode *node)
   BKE_pbvh_node_mark_rebuild_draw(node);
 }
 
+/* The vertex and draw data of leaves is built afterwards by #build_leaf_nodes_data. */
 static void build_leaf(PBVH *pbvh,
-                       const Span<int> corner_verts,
-                       const Span<int3> corner_tris,
-                       const Span<int> tri_faces,
-                       const Span<bool> hide_poly,
-                       MutableSpan<bool> vert_bitmap,
                        int node_index,
                        const Span<Bounds<float3>> prim_bounds,
                        int offset,
@@ -376,13 +390,82 @@ static void build_leaf(PBVH *pbvh,
 
   /* Still need vb for searches */
   update_vb(pbvh->prim_indices, &node, prim_bounds, offset, count);
+}
+
+/**
+ * Find the leaf that stores each vertex as one of its unique vertices. That is the first leaf
+ * using the vertex, in the order of the leaves' primitive ranges (which is the order in which
+ * #build_sub creates them).
+ */
+static Array<int> calc_vert_owners(const Span<int> corner_verts,
+                                   const Span<int3> corner_tris,
+                                   const int verts_num,
+                                   const Span<PBVHNode *> leaves)
+{
+  Array<int> vert_owners(verts_num, INT_MAX);
+  threading::parallel_for(leaves.index_range(), 1, [&](const IndexRange range) {
+    for (const int leaf_order : range) {
+      for (const int tri : leaves[leaf_order]->prim_indices) {
+        for (const int i : IndexRange(3)) {
+          int32_t *owner = &vert_owners[corner_verts[corner_tris[tri][i]]];
+          int32_t old_owner = *owner;
+          while (leaf_order < old_owner) {
+            const int32_t prev_owner = atomic_cas_int32(owner, old_owner, leaf_order);
+            if (prev_owner == old_owner) {
+              break;
+            }
+            old_owner = prev_owner;
+          }
+        }
+      }
+    }
+  });
+  return vert_owners;
+}
 
-  if (!pbvh->corner_tris.is_empty()) {
-    build_mesh_leaf_node(corner_verts, corner_tris, tri_faces, hide_poly, vert_bitmap, &node);
+/**
+ * Build the vertex indices and draw data of all leaves. This is done after the tree structure
+ * is known so that the leaves can be processed in parallel.
+ */
+static void build_leaf_nodes_data(PBVH *pbvh,
+                                  const Span<int> corner_verts,
+                                  const Span<int3> corner_tris,
+                                  const Span<int> tri_faces,
+                                  const Span<bool> hide_poly,
+                                  const int verts_num)
+{
+  Vector<PBVHNode *> leaves;
+  for (PBVHNode &node : pbvh->nodes) {
+    if (node.flag & PBVH_Leaf) {
+      leaves.append(&node);
+    }
   }
-  else {
-    build_grid_leaf_node(pbvh, &node);
+
+  if (corner_tris.is_empty()) {
+    threading::parallel_for(leaves.index_range(), 8, [&](const IndexRange range) {
+      for (PBVHNode *node : leaves.as_span().slice(range)) {
+        build_grid_leaf_node(pbvh, node);
+      }
+    });
+    return;
   }
+
+  std::sort(leaves.begin(), leaves.end(), [](const PBVHNode *a, const PBVHNode *b) {
+    return a->prim_indices.data() < b->prim_indices.data();
+  });
+  const Array<int> vert_owners = calc_vert_owners(corner_verts, corner_tris, verts_num, leaves);
+
+  threading::parallel_for(leaves.index_range(), 1, [&](const IndexRange range) {
+    for (const int leaf_order : range) {
+      build_mesh_leaf_node(corner_verts,
+                           corner_tris,
+                           tri_faces,
+                           hide_poly,
+                           vert_owners,
+                           leaf_order,
+                           leaves[leaf_order]);
+    }
+  });
 }
 
 /* Return zero if all primitives in the node can be drawn with the
@@ -455,13 +538,9 @@ static void test_face_boundaries(PBVH *pbvh, const Mesh &mesh)
  */
 
 static void build_sub(PBVH *pbvh,
-                      const Span<int> corner_verts,
-                      const Span<int3> corner_tris,
                       const Span<int> tri_faces,
-                      const Span<bool> hide_poly,
                       const Span<int> material_indices,
                       const Span<bool> sharp_faces,
-                      MutableSpan<bool> vert_bitmap,
                       int node_index,
                       const Bounds<float3> *cb,
                       const Span<Bounds<float3>> prim_bounds,
@@ -485,16 +564,7 @@ static void build_sub(PBVH *pbvh,
     if (!leaf_needs_material_split(
             pbvh, prim_to_face_map, material_indices, sharp_faces, offset, count))
     {
-      build_leaf(pbvh,
-                 corner_verts,
-                 corner_tris,
-                 tri_faces,
-                 hide_poly,
-                 vert_bitmap,
-                 node_index,
-                 prim_bounds,
-                 offset,
-                 count);
+      build_leaf(pbvh, node_index, prim_bounds, offset, count);
 
       if (node_index == 0) {
         MEM_SAFE_FREE(prim_scratch);
@@ -512,6 +582,10 @@ static void build_sub(PBVH *pbvh,
   update_vb(pbvh->prim_indices, &pbvh->nodes[node_index], prim_bounds, offset, count);
 
   Bounds<float3> cb_backing;
+  Bounds<float3> left_cb;
+  Bounds<float3> right_cb;
+  const Bounds<float3> *left_cb_ptr = nullptr;
+  const Bounds<float3> *right_cb_ptr = nullptr;
   if (!below_leaf_limit) {
     /* Find axis with widest range of primitive centroids */
     if (!cb) {
@@ -533,7 +607,11 @@ static void build_sub(PBVH *pbvh,
                                  axis,
                                  math::midpoint(cb->min[axis], cb->max[axis]),
                                  prim_bounds,
-                                 prim_to_face_map);
+                                 prim_to_face_map,
+                                 left_cb,
+                                 right_cb);
+    left_cb_ptr = &left_cb;
+    right_cb_ptr = &right_cb;
   }
   else {
     /* Partition primitives by material */
@@ -547,30 +625,22 @@ static void build_sub(PBVH *pbvh,
 
   /* Build children */
   build_sub(pbvh,
-            corner_verts,
-            corner_tris,
             tri_faces,
-            hide_poly,
             material_indices,
             sharp_faces,
-            vert_bitmap,
             pbvh->nodes[node_index].children_offset,
-            nullptr,
+            left_cb_ptr,
             prim_bounds,
             offset,
             end - offset,
             prim_scratch,
             depth + 1);
   build_sub(pbvh,
-            corner_verts,
-            corner_tris,
             tri_faces,
-            hide_poly,
             material_indices,
             sharp_faces,
-            vert_bitmap,
             pbvh->nodes[node_index].children_offset + 1,
-            nullptr,
+            right_cb_ptr,
             prim_bounds,
             end,
             offset + count - end,
@@ -589,7 +659,7 @@ static void pbvh_build(PBVH *pbvh,
                        const Span<bool> hide_poly,
                        const Span<int> material_indices,
                        const Span<bool> sharp_faces,
-                       MutableSpan<bool> vert_bitmap,
+                       const int verts_num,
                        const Bounds<float3> *cb,
                        const Span<Bounds<float3>> prim_bounds,
                        int totprim)
@@ -605,13 +675,9 @@ static void pbvh_build(PBVH *pbvh,
   pbvh->nodes.resize(1);
 
   build_sub(pbvh,
-            corner_verts,
-            corner_tris,
             tri_faces,
-            hide_poly,
             material_indices,
             sharp_faces,
-            vert_bitmap,
             0,
             cb,
             prim_bounds,
@@ -619,6 +685,8 @@ static void pbvh_build(PBVH *pbvh,
             totprim,
             nullptr,
             0);
+
+  build_leaf_nodes_data(pbvh, corner_verts, corner_tris, tri_faces, hide_poly, verts_num);
 }
 
 #ifdef VALIDATE_UNIQUE_NODE_FACES
@@ -723,7 +791,6 @@ PBVH *build_mesh(Mesh *mesh)
   update_mesh_pointers(pbvh.get(), mesh);
   const Span<int> tri_faces = pbvh->corner_tri_faces;
 
-  Array<bool> vert_bitmap(totvert, false);
   pbvh->totvert = totvert;
 
 #ifdef TEST_PBVH_FACE_SPLIT
@@ -768,7 +835,7 @@ PBVH *build_mesh(Mesh *mesh)
                hide_poly,
                material_index,
                sharp_face,
-               vert_bitmap,
+               totvert,
                &cb,
                prim_bounds,
                corner_tris_num);
@@ -846,7 +913,7 @@ PBVH *build_grids(const CCGKey *key, Mesh *mesh, SubdivCCG *subdiv_ccg)
                {},
                material_index,
                sharp_face,
-               {},
+               0,
                &cb,
                prim_bounds,
                grids.size());
@@ -1694,17 +1761,17 @@ void BKE_pbvh_node_mark_update(PBVHNode *node)
 
 void BKE_pbvh_node_mark_update_mask(PBVHNode *node)
 {
-  node->flag |= PBVH_UpdateMask | PBVH_UpdateDrawBuffers | PBVH_UpdateRedraw;
+  node->flag |= PBVH_UpdateMask | PBVH_UpdateDrawMask | PBVH_UpdateRedraw;
 }
 
 void BKE_pbvh_node_mark_update_color(PBVHNode *node)
 {
-  node->flag |= PBVH_UpdateColor | PBVH_UpdateDrawBuffers | PBVH_UpdateRedraw;
+  node->flag |= PBVH_UpdateColor | PBVH_UpdateDrawColor | PBVH_UpdateRedraw;
 }
 
 void BKE_pbvh_node_mark_update_face_sets(PBVHNode *node)
 {
-  node->flag |= PBVH_UpdateDrawBuffers | PBVH_UpdateRedraw;
+  node->flag |= PBVH_UpdateDrawFaceSets | PBVH_UpdateRedraw;
 }
 
 void BKE_pbvh_mark_rebuild_pixels(PBVH *pbvh)
@@ -2652,6 +2719,11 @@ static blender::draw::pbvh::PBVH_GPU_Args pbvh_draw_args_init(const Mesh &mesh,
 
 namespace blender::bke::pbvh {
 
+/** All flags that cause (some of) the draw buffers of a node to be updated. */
+static constexpr PBVHNodeFlags PBVH_UpdateDrawAny = PBVH_UpdateDrawBuffers | PBVH_UpdateDrawMask |
+                                                    PBVH_UpdateDrawColor |
+                                                    PBVH_UpdateDrawFaceSets;
+
 static void node_update_draw_buffers(const Mesh &mesh, PBVH &pbvh, PBVHNode &node)
 {
   /* Create and update draw buffers. The functions called here must not
@@ -2662,12 +2734,23 @@ static void node_update_draw_buffers(const Mesh &mesh, PBVH &pbvh, PBVHNode &nod
     node.draw_batches = blender::draw::pbvh::node_create(args);
   }
 
-  if (node.flag & PBVH_UpdateDrawBuffers) {
+  if (node.flag & PBVH_UpdateDrawAny) {
     node.debug_draw_gen++;
 
     if (node.draw_batches) {
       const blender::draw::pbvh::PBVH_GPU_Args args = pbvh_draw_args_init(mesh, pbvh, node);
-      blender::draw::pbvh::node_update(node.draw_batches, args);
+      if (node.flag & PBVH_UpdateDrawBuffers || pbvh.header.type != PBVH_FACES) {
+        blender::draw::pbvh::node_update(node.draw_batches, args);
+      }
+      else {
+        /* Positions and normals are unchanged, only refill the buffers that depend on the
+         * changed attributes. */
+        blender::draw::pbvh::AttributeUpdate update;
+        update.mask = node.flag & PBVH_UpdateDrawMask;
+        update.face_sets = node.flag & PBVH_UpdateDrawFaceSets;
+        update.generic = node.flag & PBVH_UpdateDrawColor;
+        blender::draw::pbvh::node_update_attributes(node.draw_batches, args, update);
+      }
     }
   }
 }
@@ -2696,7 +2779,7 @@ static void pbvh_update_draw_buffers(const Mesh &mesh,
       if (node->flag & PBVH_RebuildDrawBuffers) {
         free_draw_buffers(pbvh, node);
       }
-      else if ((node->flag & PBVH_UpdateDrawBuffers) && node->draw_batches) {
+      else if ((node->flag & PBVH_UpdateDrawAny) && node->draw_batches) {
         const draw::pbvh::PBVH_GPU_Args args = pbvh_draw_args_init(mesh, pbvh, *node);
         draw::pbvh::update_pre(node->draw_batches, args);
       }
@@ -2712,14 +2795,14 @@ static void pbvh_update_draw_buffers(const Mesh &mesh,
 
   /* Flush buffers uses OpenGL, so not in parallel. */
   for (PBVHNode *node : nodes) {
-    if (node->flag & PBVH_UpdateDrawBuffers) {
+    if (node->flag & PBVH_UpdateDrawAny) {
 
       if (node->draw_batches) {
         draw::pbvh::node_gpu_flush(node->draw_batches);
       }
     }
 
-    node->flag &= ~(PBVH_RebuildDrawBuffers | PBVH_UpdateDrawBuffers);
+    node->flag &= ~(PBVH_RebuildDrawBuffers | PBVH_UpdateDrawAny);
   }
 }
 
@@ -2742,16 +2825,16 @@ void draw_cb(const Mesh &mesh,
       update_flag |= node.flag;
       return true;
     });
-    if (update_flag & (PBVH_RebuildDrawBuffers | PBVH_UpdateDrawBuffers)) {
+    if (update_flag & (PBVH_RebuildDrawBuffers | PBVH_UpdateDrawAny)) {
       pbvh_update_draw_buffers(mesh, *pbvh, nodes, update_flag);
     }
   }
   else {
     /* Get all nodes with draw updates, also those outside the view. */
     Vector<PBVHNode *> nodes = search_gather(pbvh, [&](PBVHNode &node) {
-      return update_search(&node, PBVH_RebuildDrawBuffers | PBVH_UpdateDrawBuffers);
+      return update_search(&node, PBVH_RebuildDrawBuffers | PBVH_UpdateDrawAny);
     });
-    pbvh_update_draw_buffers(mesh, *pbvh, nodes, PBVH_RebuildDrawBuffers | PBVH_UpdateDrawBuffers);
+    pbvh_update_draw_buffers(mesh, *pbvh, nodes, PBVH_RebuildDrawBuffers | PBVH_UpdateDrawAny);
   }
 
   /* Draw visible nodes. */
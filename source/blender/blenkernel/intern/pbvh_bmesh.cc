@@ -16,6 +16,7 @@
 #include "BLI_math_vector.hh"
 #include "BLI_memarena.h"
 #include "BLI_span.hh"
+#include "BLI_task.hh"
 #include "BLI_time.h"
 #include "BLI_utildefines.h"
 
@@ -929,54 +930,81 @@ static void short_edge_queue_edge_add(EdgeQueueContext *eq_ctx, BMEdge *e)
   }
 }
 
-static void long_edge_queue_face_add(EdgeQueueContext *eq_ctx, BMFace *f)
+/** Return true if the edges of the face should be considered for the queue. */
+static bool edge_queue_face_in_range(const EdgeQueue *q, BMFace *f)
 {
 #ifdef USE_EDGEQUEUE_FRONTFACE
-  if (eq_ctx->q->use_view_normal) {
-    if (dot_v3v3(f->no, eq_ctx->q->view_normal) < 0.0f) {
-      return;
+  if (q->use_view_normal) {
+    if (dot_v3v3(f->no, q->view_normal) < 0.0f) {
+      return false;
     }
   }
 #endif
 
-  if (eq_ctx->q->edge_queue_tri_in_range(eq_ctx->q, f)) {
-    /* Check each edge of the face. */
-    BMLoop *l_first = BM_FACE_FIRST_LOOP(f);
-    BMLoop *l_iter = l_first;
-    do {
-#ifdef USE_EDGEQUEUE_EVEN_SUBDIV
-      const float len_sq = BM_edge_calc_length_squared(l_iter->e);
-      if (len_sq > eq_ctx->q->limit_len_squared) {
-        long_edge_queue_edge_add_recursive(
-            eq_ctx, l_iter->radial_next, l_iter, len_sq, eq_ctx->q->limit_len);
-      }
-#else
-      long_edge_queue_edge_add(eq_ctx, l_iter->e);
-#endif
-    } while ((l_iter = l_iter->next) != l_first);
-  }
+  return q->edge_queue_tri_in_range(q, f);
 }
 
-static void short_edge_queue_face_add(EdgeQueueContext *eq_ctx, BMFace *f)
+/**
+ * Find the faces in range of the brush in the leaf nodes marked for topology update, see
+ * #edge_queue_face_in_range. Testing the faces doesn't modify anything and is the expensive part
+ * of creating the queues, so it is done for all nodes in parallel. The faces are returned per
+ * node in the same order as iterating over the nodes directly, so that adding their edges to the
+ * queue gives the same result as before.
+ */
+static Array<Vector<BMFace *>> edge_queue_faces_in_range(const EdgeQueue *q, PBVH *pbvh)
 {
-#ifdef USE_EDGEQUEUE_FRONTFACE
-  if (eq_ctx->q->use_view_normal) {
-    if (dot_v3v3(f->no, eq_ctx->q->view_normal) < 0.0f) {
-      return;
+  Vector<PBVHNode *> nodes;
+  for (PBVHNode &node : pbvh->nodes) {
+    if ((node.flag & PBVH_Leaf) && (node.flag & PBVH_UpdateTopology) &&
+        !(node.flag & PBVH_FullyHidden))
+    {
+      nodes.append(&node);
     }
   }
+
+  Array<Vector<BMFace *>> faces_in_range(nodes.size());
+  threading::parallel_for(nodes.index_range(), 1, [&](const IndexRange range) {
+    for (const int i : range) {
+      for (BMFace *f : nodes[i]->bm_faces) {
+        if (edge_queue_face_in_range(q, f)) {
+          faces_in_range[i].append(f);
+        }
+      }
+    }
+  });
+  return faces_in_range;
+}
+
+/** Add the edges of a face that is in range, see #edge_queue_face_in_range. */
+static void long_edge_queue_face_add(EdgeQueueContext *eq_ctx, BMFace *f)
+{
+  /* Check each edge of the face. */
+  BMLoop *l_first = BM_FACE_FIRST_LOOP(f);
+  BMLoop *l_iter = l_first;
+  do {
+#ifdef USE_EDGEQUEUE_EVEN_SUBDIV
+    const float len_sq = BM_edge_calc_length_squared(l_iter->e);
+    if (len_sq > eq_ctx->q->limit_len_squared) {
+      long_edge_queue_edge_add_recursive(
+          eq_ctx, l_iter->radial_next, l_iter, len_sq, eq_ctx->q->limit_len);
+    }
+#else
+    long_edge_queue_edge_add(eq_ctx, l_iter->e);
 #endif
+  } while ((l_iter = l_iter->next) != l_first);
+}
 
-  if (eq_ctx->q->edge_queue_tri_in_range(eq_ctx->q, f)) {
-    BMLoop *l_iter;
-    BMLoop *l_first;
+/** Add the edges of a face that is in range, see #edge_queue_face_in_range. */
+static void short_edge_queue_face_add(EdgeQueueContext *eq_ctx, BMFace *f)
+{
+  BMLoop *l_iter;
+  BMLoop *l_first;
 
-    /* Check each edge of the face. */
-    l_iter = l_first = BM_FACE_FIRST_LOOP(f);
-    do {
-      short_edge_queue_edge_add(eq_ctx, l_iter->e);
-    } while ((l_iter = l_iter->next) != l_first);
-  }
+  /* Check each edge of the face. */
+  l_iter = l_first = BM_FACE_FIRST_LOOP(f);
+  do {
+    short_edge_queue_edge_add(eq_ctx, l_iter->e);
+  } while ((l_iter = l_iter->next) != l_first);
 }
 
 /**
@@ -1025,14 +1053,9 @@ static void long_edge_queue_create(EdgeQueueContext *eq_ctx,
   pbvh_bmesh_edge_tag_verify(pbvh);
 #endif
 
-  for (PBVHNode &node : pbvh->nodes) {
-    /* Check leaf nodes marked for topology update. */
-    if ((node.flag & PBVH_Leaf) && (node.flag & PBVH_UpdateTopology) &&
-        !(node.flag & PBVH_FullyHidden))
-    {
-      for (BMFace *f : node.bm_faces) {
-        long_edge_queue_face_add(eq_ctx, f);
-      }
+  for (const Span<BMFace *> faces : edge_queue_faces_in_range(eq_ctx->q, pbvh)) {
+    for (BMFace *f : faces) {
+      long_edge_queue_face_add(eq_ctx, f);
     }
   }
 }
@@ -1079,14 +1102,9 @@ static void short_edge_queue_create(EdgeQueueContext *eq_ctx,
     eq_ctx->q->edge_queue_tri_in_range = edge_queue_tri_in_sphere;
   }
 
-  for (PBVHNode &node : pbvh->nodes) {
-    /* Check leaf nodes marked for topology update */
-    if ((node.flag & PBVH_Leaf) && (node.flag & PBVH_UpdateTopology) &&
-        !(node.flag & PBVH_FullyHidden))
-    {
-      for (BMFace *f : node.bm_faces) {
-        short_edge_queue_face_add(eq_ctx, f);
-      }
+  for (const Span<BMFace *> faces : edge_queue_faces_in_range(eq_ctx->q, pbvh)) {
+    for (BMFace *f : faces) {
+      short_edge_queue_face_add(eq_ctx, f);
     }
   }
 }
@@ -12,6 +12,7 @@
 #include <cstring>
 #include <sys/stat.h>
 #include <sys/types.h>
+#include <zstd.h>
 
 /* needed for directory lookup */
 #ifndef WIN32
@@ -40,6 +41,7 @@
 #include "BLI_math_rotation.h"
 #include "BLI_math_vector.h"
 #include "BLI_string.h"
+#include "BLI_task.hh"
 #include "BLI_time.h"
 #include "BLI_utildefines.h"
 
@@ -80,8 +82,12 @@
     lzo_align_t __LZO_MMODEL var[((size) + (sizeof(lzo_align_t) - 1)) / sizeof(lzo_align_t)]
 #endif
 
+/* Also large enough for `ZSTD_compressBound`. */
 #define LZO_OUT_LEN(size) ((size) + (size) / 16 + 64 + 3)
 
+/* Fast to compress and faster to decompress than LZO, with a ratio close to LZMA. */
+#define PTCACHE_ZSTD_LEVEL 3
+
 #ifdef WITH_LZMA
 #  include "LzmaLib.h"
 #endif
@@ -1545,6 +1551,10 @@ static int ptcache_file_compressed_read(PTCacheFile *pf, uchar *result, uint len
         r = LzmaUncompress(result, &leno, in, &leni, props, sizeOfIt);
       }
 #endif
+      if (compressed == 3) {
+        const size_t out_len = ZSTD_decompress(result, len, in, in_len);
+        r = (ZSTD_isError(out_len) || out_len != len) ? 1 : 0;
+      }
       MEM_freeN(in);
     }
   }
@@ -1556,16 +1566,27 @@ static int ptcache_file_compressed_read(PTCacheFile *pf, uchar *result, uint len
 
   return r;
 }
-static int ptcache_file_compressed_write(
-    PTCacheFile *pf, uchar *in, uint in_len, uchar *out, int mode)
-{
-  int r = 0;
+/** Result of compressing a block of data, before it is written to the file. */
+struct PTCacheCompressed {
+  /** Method used (1 LZO, 2 LZMA, 3 ZSTD), 0 when the data is stored uncompressed. */
   uchar compressed = 0;
   size_t out_len = 0;
-  uchar *props = static_cast<uchar *>(MEM_callocN(sizeof(char[16]), "tmp"));
+  /** LZMA properties. */
+  uchar props[16] = {0};
   size_t sizeOfIt = 5;
+  int r = 0;
+};
 
-  (void)mode; /* unused when building w/o compression */
+/**
+ * Compress `in` into `out`, which must hold at least #LZO_OUT_LEN bytes. Does not access the
+ * file, so that multiple blocks can be compressed in parallel.
+ */
+static void ptcache_compress(
+    const uchar *in, uint in_len, uchar *out, int mode, PTCacheCompressed *result)
+{
+  int r = 0;
+  uchar compressed = 0;
+  size_t out_len = 0;
 
 #ifdef WITH_LZO
   out_len = LZO_OUT_LEN(in_len);
@@ -1588,8 +1609,8 @@ static int ptcache_file_compressed_write(
                      &out_len,
                      in,
                      in_len, /* Assume `sizeof(char) == 1`. */
-                     props,
-                     &sizeOfIt,
+                     result->props,
+                     &result->sizeOfIt,
                      5,
                      1 << 24,
                      3,
@@ -1606,26 +1627,52 @@ static int ptcache_file_compressed_write(
     }
   }
 #endif
+  if (mode == PTCACHE_COMPRESS_ZSTD) {
+    out_len = ZSTD_compress(out, LZO_OUT_LEN(in_len), in, in_len, PTCACHE_ZSTD_LEVEL);
+    r = ZSTD_isError(out_len) ? 1 : 0;
+    if (r || (out_len >= in_len)) {
+      compressed = 0;
+    }
+    else {
+      compressed = 3;
+    }
+  }
 
-  ptcache_file_write(pf, &compressed, 1, sizeof(uchar));
-  if (compressed) {
-    uint size = out_len;
+  result->compressed = compressed;
+  result->out_len = out_len;
+  result->r = r;
+}
+/** Write a block compressed by #ptcache_compress, or `in` itself when it wasn't compressed. */
+static int ptcache_file_compressed_write_result(PTCacheFile *pf,
+                                                const uchar *in,
+                                                uint in_len,
+                                                const uchar *out,
+                                                const PTCacheCompressed *result)
+{
+  ptcache_file_write(pf, &result->compressed, 1, sizeof(uchar));
+  if (result->compressed) {
+    uint size = result->out_len;
     ptcache_file_write(pf, &size, 1, sizeof(uint));
-    ptcache_file_write(pf, out, out_len, sizeof(uchar));
+    ptcache_file_write(pf, out, result->out_len, sizeof(uchar));
   }
   else {
     ptcache_file_write(pf, in, in_len, sizeof(uchar));
   }
 
-  if (compressed == 2) {
-    uint size = sizeOfIt;
-    ptcache_file_write(pf, &sizeOfIt, 1, sizeof(uint));
-    ptcache_file_write(pf, props, size, sizeof(uchar));
+  if (result->compressed == 2) {
+    uint size = result->sizeOfIt;
+    ptcache_file_write(pf, &size, 1, sizeof(uint));
+    ptcache_file_write(pf, result->props, size, sizeof(uchar));
   }
 
-  MEM_freeN(props);
-
-  return r;
+  return result->r;
+}
+static int ptcache_file_compressed_write(
+    PTCacheFile *pf, uchar *in, uint in_len, uchar *out, int mode)
+{
+  PTCacheCompressed result;
+  ptcache_compress(in, in_len, out, mode, &result);
+  return ptcache_file_compressed_write_result(pf, in, in_len, out, &result);
 }
 static int ptcache_file_read(PTCacheFile *pf, void *f, uint tot, uint size)
 {
@@ -2064,13 +2111,30 @@ static int ptcache_mem_frame_to_disk(PTCacheID *pid, PTCacheMem *pm)
 
   if (!error) {
     if (pid->cache->compression) {
+      /* Compress the data types in parallel, the file is written in order afterwards. */
+      uchar *out[BPHYS_TOT_DATA] = {nullptr};
+      PTCacheCompressed result[BPHYS_TOT_DATA];
+      blender::threading::parallel_for(
+          blender::IndexRange(BPHYS_TOT_DATA), 1, [&](const blender::IndexRange range) {
+            for (const int64_t type : range) {
+              if (pm->data[type]) {
+                uint in_len = pm->totpoint * ptcache_data_size[type];
+                out[type] = (uchar *)MEM_callocN(LZO_OUT_LEN(in_len) * 4,
+                                                 "pointcache_lzo_buffer");
+                ptcache_compress((uchar *)(pm->data[type]),
+                                 in_len,
+                                 out[type],
+                                 pid->cache->compression,
+                                 &result[type]);
+              }
+            }
+          });
       for (i = 0; i < BPHYS_TOT_DATA; i++) {
         if (pm->data[i]) {
           uint in_len = pm->totpoint * ptcache_data_size[i];
-          uchar *out = (uchar *)MEM_callocN(LZO_OUT_LEN(in_len) * 4, "pointcache_lzo_buffer");
-          ptcache_file_compressed_write(
-              pf, (uchar *)(pm->data[i]), in_len, out, pid->cache->compression);
-          MEM_freeN(out);
+          ptcache_file_compressed_write_result(
+              pf, (uchar *)(pm->data[i]), in_len, out[i], &result[i]);
+          MEM_freeN(out[i]);
         }
       }
     }
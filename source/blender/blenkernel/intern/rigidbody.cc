@@ -23,6 +23,7 @@
 #include "BLI_math_matrix.h"
 #include "BLI_math_rotation.h"
 #include "BLI_math_vector.h"
+#include "BLI_task.hh"
 
 #ifdef WITH_BULLET
 #  include "RBI_api.h"
@@ -2037,67 +2038,75 @@ static void rigidbody_update_external_forces(Depsgraph *depsgraph,
                                              Scene *scene,
                                              RigidBodyWorld *rbw)
 {
-  FOREACH_COLLECTION_OBJECT_RECURSIVE_BEGIN (rbw->group, ob) {
-    /* only update if rigid body exists */
-    RigidBodyOb *rbo = ob->rigidbody_object;
-    if (ob->type != OB_MESH || rbo->shared->physics_object == nullptr) {
-      continue;
+  EffectorWeights *effector_weights = rbw->effector_weights;
+
+  /* Get effectors present in the group specified by effector_weights. Bodies which are effectors
+   * themselves are skipped below, so the list is the same for all bodies and is created once
+   * instead of for every body on every sub-step. */
+  ListBase *effectors = BKE_effectors_create(depsgraph, nullptr, nullptr, effector_weights, false);
+  if (effectors == nullptr) {
+    if (G.f & G_DEBUG) {
+      printf("\tno forces to apply\n");
     }
+    return;
+  }
 
-    /* update influence of effectors - but don't do it on an effector */
-    /* only dynamic bodies need effector update */
-    if (rbo->type == RBO_TYPE_ACTIVE &&
-        ((ob->pd == nullptr) || (ob->pd->forcefield == PFIELD_NULL)))
-    {
-      EffectorWeights *effector_weights = rbw->effector_weights;
-      EffectedPoint epoint;
-      ListBase *effectors;
+  /* Bodies are independent here, forces only accumulate on the body itself. */
+  blender::threading::parallel_for(
+      blender::IndexRange(rbw->numbodies), 256, [&](const blender::IndexRange range) {
+        for (const int64_t i : range) {
+          Object *ob = rbw->objects[i];
+          /* only update if rigid body exists */
+          RigidBodyOb *rbo = ob->rigidbody_object;
+          if (ob->type != OB_MESH || rbo->shared->physics_object == nullptr) {
+            continue;
+          }
 
-      /* get effectors present in the group specified by effector_weights */
-      effectors = BKE_effectors_create(depsgraph, ob, nullptr, effector_weights, false);
-      if (effectors) {
-        float eff_force[3] = {0.0f, 0.0f, 0.0f};
-        float eff_loc[3], eff_vel[3];
+          /* update influence of effectors - but don't do it on an effector */
+          /* only dynamic bodies need effector update */
+          /* NOTE: passive objects don't need to be updated since they don't move */
+          if (rbo->type != RBO_TYPE_ACTIVE ||
+              ((ob->pd != nullptr) && (ob->pd->forcefield != PFIELD_NULL)))
+          {
+            continue;
+          }
 
-        /* create dummy 'point' which represents last known position of object as result of sim
-         */
-        /* XXX: this can create some inaccuracies with sim position,
-         * but is probably better than using un-simulated values? */
-        RB_body_get_position(static_cast<rbRigidBody *>(rbo->shared->physics_object), eff_loc);
-        RB_body_get_linear_velocity(static_cast<rbRigidBody *>(rbo->shared->physics_object),
-                                    eff_vel);
-
-        pd_point_from_loc(scene, eff_loc, eff_vel, 0, &epoint);
-
-        /* Calculate net force of effectors, and apply to sim object:
-         * - we use 'central force' since apply force requires a "relative position"
-         *   which we don't have... */
-        BKE_effectors_apply(
-            effectors, nullptr, effector_weights, &epoint, eff_force, nullptr, nullptr);
-        if (G.f & G_DEBUG) {
-          printf("\tapplying force (%f,%f,%f) to '%s'\n",
-                 eff_force[0],
-                 eff_force[1],
-                 eff_force[2],
-                 ob->id.name + 2);
-        }
-        /* activate object in case it is deactivated */
-        if (!is_zero_v3(eff_force)) {
-          RB_body_activate(static_cast<rbRigidBody *>(rbo->shared->physics_object));
+          rbRigidBody *body = static_cast<rbRigidBody *>(rbo->shared->physics_object);
+          EffectedPoint epoint;
+          float eff_force[3] = {0.0f, 0.0f, 0.0f};
+          float eff_loc[3], eff_vel[3];
+
+          /* create dummy 'point' which represents last known position of object as result of
+           * sim */
+          /* XXX: this can create some inaccuracies with sim position,
+           * but is probably better than using un-simulated values? */
+          RB_body_get_position(body, eff_loc);
+          RB_body_get_linear_velocity(body, eff_vel);
+
+          pd_point_from_loc(scene, eff_loc, eff_vel, 0, &epoint);
+
+          /* Calculate net force of effectors, and apply to sim object:
+           * - we use 'central force' since apply force requires a "relative position"
+           *   which we don't have... */
+          BKE_effectors_apply(
+              effectors, nullptr, effector_weights, &epoint, eff_force, nullptr, nullptr);
+          if (G.f & G_DEBUG) {
+            printf("\tapplying force (%f,%f,%f) to '%s'\n",
+                   eff_force[0],
+                   eff_force[1],
+                   eff_force[2],
+                   ob->id.name + 2);
+          }
+          /* activate object in case it is deactivated */
+          if (!is_zero_v3(eff_force)) {
+            RB_body_activate(body);
+          }
+          RB_body_apply_central_force(body, eff_force);
         }
-        RB_body_apply_central_force(static_cast<rbRigidBody *>(rbo->shared->physics_object),
-                                    eff_force);
-      }
-      else if (G.f & G_DEBUG) {
-        printf("\tno forces to apply to '%s'\n", ob->id.name + 2);
-      }
+      });
 
-      /* cleanup */
-      BKE_effectors_free(effectors);
-    }
-    /* NOTE: passive objects don't need to be updated since they don't move */
-  }
-  FOREACH_COLLECTION_OBJECT_RECURSIVE_END;
+  /* cleanup */
+  BKE_effectors_free(effectors);
 }
 
 static void rigidbody_free_substep_data(ListBase *substep_targets)
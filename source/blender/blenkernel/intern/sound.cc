@@ -13,6 +13,7 @@
 #include "MEM_guardedalloc.h"
 
 #include "BLI_blenlib.h"
+#include "BLI_hash.h"
 #include "BLI_iterator.h"
 #include "BLI_math_rotation.h"
 #include "BLI_threads.h"
@@ -40,6 +41,7 @@
 #  include <AUD_Special.h>
 #endif
 
+#include "BKE_appdir.hh"
 #include "BKE_bpath.hh"
 #include "BKE_global.hh"
 #include "BKE_idtype.hh"
@@ -1059,8 +1061,137 @@ void BKE_sound_free_waveform(bSound *sound)
   sound->tags &= ~SOUND_TAGS_WAVEFORM_NO_RELOAD;
 }
 
+/* Waveforms of sound files are cached in the user cache directory, so they are not read again in
+ * every session. The header identifies the sound file and settings the waveform was read with. */
+#  define SOUND_WAVEFORM_CACHE_VERSION 1
+
+struct SoundWaveformCacheHeader {
+  char magic[4];
+  int version;
+  int samples_per_second;
+  int flags;
+  int64_t file_size;
+  int64_t file_mtime;
+  int length;
+  char filepath[FILE_MAX];
+};
+
+/* Fill in the cache header and file path for the sound, returns false for sounds that are not
+ * cached, such as packed sounds. */
+static bool sound_waveform_cache_header_init(Main *bmain,
+                                             const bSound *sound,
+                                             SoundWaveformCacheHeader *r_header,
+                                             char *r_cache_path,
+                                             size_t cache_path_maxncpy)
+{
+  if (sound->packedfile) {
+    return false;
+  }
+
+  memset(r_header, 0, sizeof(*r_header));
+  STRNCPY(r_header->filepath, sound->filepath);
+  BLI_path_abs(r_header->filepath, ID_BLEND_PATH(bmain, &sound->id));
+
+  BLI_stat_t st;
+  if (BLI_stat(r_header->filepath, &st) != 0) {
+    return false;
+  }
+
+  if (!BKE_appdir_folder_caches(r_cache_path, cache_path_maxncpy)) {
+    return false;
+  }
+  char cache_filename[FILE_MAXFILE];
+  SNPRINTF(cache_filename, "%08x.waveform", BLI_hash_string(r_header->filepath));
+  BLI_path_append(r_cache_path, cache_path_maxncpy, "sound-waveforms");
+  BLI_path_append(r_cache_path, cache_path_maxncpy, cache_filename);
+
+  memcpy(r_header->magic, "BWAV", sizeof(r_header->magic));
+  r_header->version = SOUND_WAVEFORM_CACHE_VERSION;
+  r_header->samples_per_second = SOUND_WAVE_SAMPLES_PER_SECOND;
+  r_header->flags = sound->flags & SOUND_FLAGS_MONO;
+  r_header->file_size = st.st_size;
+  r_header->file_mtime = st.st_mtime;
+  return true;
+}
+
+static SoundWaveform *sound_waveform_cache_read(Main *bmain, const bSound *sound)
+{
+  SoundWaveformCacheHeader header;
+  char cache_path[FILE_MAX];
+  if (!sound_waveform_cache_header_init(bmain, sound, &header, cache_path, sizeof(cache_path))) {
+    return nullptr;
+  }
+
+  FILE *file = BLI_fopen(cache_path, "rb");
+  if (file == nullptr) {
+    return nullptr;
+  }
+
+  SoundWaveformCacheHeader file_header;
+  if (fread(&file_header, sizeof(file_header), 1, file) != 1 || file_header.length <= 0) {
+    fclose(file);
+    return nullptr;
+  }
+  /* Length is the only field not known before reading the sound. */
+  header.length = file_header.length;
+  if (memcmp(&header, &file_header, sizeof(header)) != 0) {
+    fclose(file);
+    return nullptr;
+  }
+
+  SoundWaveform *waveform = static_cast<SoundWaveform *>(
+      MEM_mallocN(sizeof(SoundWaveform), "SoundWaveform"));
+  waveform->length = file_header.length;
+  waveform->data = static_cast<float *>(
+      MEM_mallocN(sizeof(float[3]) * waveform->length, "SoundWaveform.samples"));
+  const size_t num_read = fread(waveform->data, sizeof(float[3]), waveform->length, file);
+  fclose(file);
+
+  if (num_read != size_t(waveform->length)) {
+    MEM_freeN(waveform->data);
+    MEM_freeN(waveform);
+    return nullptr;
+  }
+  return waveform;
+}
+
+static void sound_waveform_cache_write(Main *bmain,
+                                       const bSound *sound,
+                                       const SoundWaveform *waveform)
+{
+  SoundWaveformCacheHeader header;
+  char cache_path[FILE_MAX];
+  if (!sound_waveform_cache_header_init(bmain, sound, &header, cache_path, sizeof(cache_path))) {
+    return;
+  }
+  header.length = waveform->length;
+
+  if (!BLI_file_ensure_parent_dir_exists(cache_path)) {
+    return;
+  }
+  FILE *file = BLI_fopen(cache_path, "wb");
+  if (file == nullptr) {
+    return;
+  }
+  /* A partially written file is rejected when reading, as the sample count won't match. */
+  fwrite(&header, sizeof(header), 1, file);
+  fwrite(waveform->data, sizeof(float[3]), waveform->length, file);
+  fclose(file);
+}
+
 void BKE_sound_read_waveform(Main *bmain, bSound *sound, bool *stop)
 {
+  SoundWaveform *cached_waveform = sound_waveform_cache_read(bmain, sound);
+  if (cached_waveform) {
+    BKE_sound_free_waveform(sound);
+
+    BLI_spin_lock(static_cast<SpinLock *>(sound->spinlock));
+    sound->waveform = cached_waveform;
+    sound->tags &= ~SOUND_TAGS_WAVEFORM_LOADING;
+    BLI_spin_unlock(static_cast<SpinLock *>(sound->spinlock));
+    return;
+  }
+
   bool need_close_audio_handles = false;
   if (sound->playback_handle == nullptr) {
     /* TODO(sergey): Make it fully independent audio handle. */
@@ -1103,6 +1234,10 @@ void BKE_sound_read_waveform(Main *bmain, bSound *sound, bool *stop)
     return;
   }
 
+  if (waveform->length > 0) {
+    sound_waveform_cache_write(bmain, sound, waveform);
+  }
+
   BKE_sound_free_waveform(sound);
 
   BLI_spin_lock(static_cast<SpinLock *>(sound->spinlock));
@@ -11,8 +11,14 @@
 #include "DNA_mesh_types.h"
 #include "DNA_modifier_types.h"
 
+#include "BLI_implicit_sharing.hh"
+#include "BLI_struct_equality_utils.hh"
 #include "BLI_utildefines.h"
+#include "BLI_vector.hh"
 
+#include "BKE_attribute.hh"
+#include "BKE_customdata.hh"
+#include "BKE_mesh.hh"
 #include "BKE_subdiv_modifier.hh"
 
 #include "MEM_guardedalloc.h"
@@ -137,6 +143,137 @@ Subdiv *new_from_mesh(const Settings *settings, const Mesh *mesh)
 
 /* Creation with cached-aware semantic. */
 
+/**
+ * Mesh data that the topology refiner depends on, identified by its implicit sharing info and
+ * version. Unlike the positions, this data usually stays shared between frames of deforming
+ * animation, so this is a fast way to detect that the topology didn't change.
+ */
+struct TopologyKey {
+  struct Layer {
+    const ImplicitSharingInfo *sharing_info;
+    int64_t version;
+
+    BLI_STRUCT_EQUALITY_OPERATORS_2(Layer, sharing_info, version)
+  };
+
+  Vector<Layer> layers;
+  int verts_num;
+  int edges_num;
+  int faces_num;
+  int corners_num;
+  /** Stored keys keep the sharing infos alive, so that they can't be reused for other data. */
+  bool owns_weak_users = false;
+
+  ~TopologyKey()
+  {
+    if (owns_weak_users) {
+      for (const Layer &layer : layers) {
+        if (layer.sharing_info) {
+          layer.sharing_info->remove_weak_user_and_delete_if_last();
+        }
+      }
+    }
+  }
+
+  bool operator==(const TopologyKey &other) const
+  {
+    return layers == other.layers && verts_num == other.verts_num &&
+           edges_num == other.edges_num && faces_num == other.faces_num &&
+           corners_num == other.corners_num;
+  }
+};
+
+/* Returns false when the layer exists but is not implicitly shared, and can't be identified. */
+static bool add_layer_key(const CustomData &data,
+                          const eCustomDataType type,
+                          const StringRef name,
+                          Vector<TopologyKey::Layer> &r_layers)
+{
+  const int layer_index = CustomData_get_named_layer_index(&data, type, name);
+  if (layer_index == -1) {
+    r_layers.append({nullptr, 0});
+    return true;
+  }
+  const ImplicitSharingInfo *sharing_info = data.layers[layer_index].sharing_info;
+  if (sharing_info == nullptr) {
+    return false;
+  }
+  r_layers.append({sharing_info, sharing_info->version()});
+  return true;
+}
+
+static std::optional<TopologyKey> topology_key_for_mesh(const Settings &settings, const Mesh &mesh)
+{
+  if (mesh.faces_num > 0 && mesh.runtime->face_offsets_sharing_info == nullptr) {
+    return std::nullopt;
+  }
+  TopologyKey key;
+  key.verts_num = mesh.verts_num;
+  key.edges_num = mesh.edges_num;
+  key.faces_num = mesh.faces_num;
+  key.corners_num = mesh.corners_num;
+  if (const ImplicitSharingInfo *sharing_info = mesh.runtime->face_offsets_sharing_info) {
+    key.layers.append({sharing_info, sharing_info->version()});
+  }
+  if (!add_layer_key(mesh.edge_data, CD_PROP_INT32_2D, ".edge_verts", key.layers) ||
+      !add_layer_key(mesh.corner_data, CD_PROP_INT32, ".corner_vert", key.layers) ||
+      !add_layer_key(mesh.corner_data, CD_PROP_INT32, ".corner_edge", key.layers))
+  {
+    return std::nullopt;
+  }
+  if (settings.use_creases) {
+    /* Creases stored on other domains or with other types are interpolated by the converter,
+     * don't try to identify those. */
+    const bke::AttributeAccessor attributes = mesh.attributes();
+    const std::optional<bke::AttributeMetaData> vert_crease = attributes.lookup_meta_data(
+        "crease_vert");
+    const std::optional<bke::AttributeMetaData> edge_crease = attributes.lookup_meta_data(
+        "crease_edge");
+    if (vert_crease && *vert_crease != bke::AttributeMetaData{bke::AttrDomain::Point,
+                                                              CD_PROP_FLOAT})
+    {
+      return std::nullopt;
+    }
+    if (edge_crease &&
+        *edge_crease != bke::AttributeMetaData{bke::AttrDomain::Edge, CD_PROP_FLOAT})
+    {
+      return std::nullopt;
+    }
+    if (!add_layer_key(mesh.vert_data, CD_PROP_FLOAT, "crease_vert", key.layers) ||
+        !add_layer_key(mesh.edge_data, CD_PROP_FLOAT, "crease_edge", key.layers))
+    {
+      return std::nullopt;
+    }
+  }
+  /* The face-varying topology depends on the values of all UV maps. */
+  for (const CustomDataLayer &layer : Span(mesh.corner_data.layers, mesh.corner_data.totlayer)) {
+    if (layer.type != CD_PROP_FLOAT2) {
+      continue;
+    }
+    if (layer.sharing_info == nullptr) {
+      return std::nullopt;
+    }
+    key.layers.append({layer.sharing_info, layer.sharing_info->version()});
+  }
+  return key;
+}
+
+static void topology_key_store(Subdiv &subdiv, const std::optional<TopologyKey> &key)
+{
+  MEM_delete(subdiv.cache_.topology_key);
+  subdiv.cache_.topology_key = nullptr;
+  if (!key) {
+    return;
+  }
+  subdiv.cache_.topology_key = MEM_new<TopologyKey>(__func__, *key);
+  for (const TopologyKey::Layer &layer : subdiv.cache_.topology_key->layers) {
+    if (layer.sharing_info) {
+      layer.sharing_info->add_weak_user();
+    }
+  }
+  subdiv.cache_.topology_key->owns_weak_users = true;
+}
+
 Subdiv *update_from_converter(Subdiv *subdiv,
                               const Settings *settings,
                               OpenSubdiv_Converter *converter)
@@ -169,10 +306,22 @@ Subdiv *update_from_converter(Subdiv *subdiv,
 
 Subdiv *update_from_mesh(Subdiv *subdiv, const Settings *settings, const Mesh *mesh)
 {
+  std::optional<TopologyKey> key = topology_key_for_mesh(*settings, *mesh);
+  if (subdiv != nullptr && subdiv->topology_refiner != nullptr && key &&
+      subdiv->cache_.topology_key != nullptr && *subdiv->cache_.topology_key == *key &&
+      settings_equal(&subdiv->settings, settings))
+  {
+    /* None of the data used to create the topology refiner changed, so there is no need to
+     * create a converter and compare its topology. */
+    return subdiv;
+  }
   OpenSubdiv_Converter converter;
   converter_init_for_mesh(&converter, settings, mesh);
   subdiv = update_from_converter(subdiv, settings, &converter);
   converter_free(&converter);
+  if (subdiv != nullptr) {
+    topology_key_store(*subdiv, key);
+  }
   return subdiv;
 }
 
@@ -196,6 +345,7 @@ void free(Subdiv *subdiv)
   if (subdiv->cache_.face_ptex_offset != nullptr) {
     MEM_freeN(subdiv->cache_.face_ptex_offset);
   }
+  MEM_delete(subdiv->cache_.topology_key);
   MEM_freeN(subdiv);
 }
 
@@ -15,7 +15,6 @@
 #include "BLI_math_bits.h"
 #include "BLI_math_geom.h"
 #include "BLI_math_vector.h"
-#include "BLI_set.hh"
 #include "BLI_task.hh"
 #include "BLI_vector_set.hh"
 
@@ -919,13 +918,9 @@ static void subdiv_ccg_average_corners(SubdivCCG &subdiv_ccg,
 void BKE_subdiv_ccg_average_grids(SubdivCCG &subdiv_ccg)
 {
 #ifdef WITH_OPENSUBDIV
-  using namespace blender;
-  const CCGKey key = BKE_subdiv_ccg_key_top_level(subdiv_ccg);
   /* Average inner boundaries of grids (within one face), across faces
    * from different face-corners. */
   BKE_subdiv_ccg_average_stitch_faces(subdiv_ccg, subdiv_ccg.faces.index_range());
-  subdiv_ccg_average_boundaries(subdiv_ccg, key, subdiv_ccg.adjacent_edges.index_range());
-  subdiv_ccg_average_corners(subdiv_ccg, key, subdiv_ccg.adjacent_verts.index_range());
 #else
   UNUSED_VARS(subdiv_ccg);
 #endif
@@ -935,24 +930,27 @@ void BKE_subdiv_ccg_average_grids(SubdivCCG &subdiv_ccg)
 
 static void subdiv_ccg_affected_face_adjacency(SubdivCCG &subdiv_ccg,
                                                const IndexMask &face_mask,
-                                               blender::Set<int> &adjacent_verts,
-                                               blender::Set<int> &adjacent_edges)
+                                               MutableSpan<bool> adjacent_verts,
+                                               MutableSpan<bool> adjacent_edges)
 {
+  using namespace blender;
   Subdiv *subdiv = subdiv_ccg.subdiv;
   const OpenSubdiv_TopologyRefiner *topology_refiner = subdiv->topology_refiner;
 
-  Vector<int, 64> face_vertices;
-  Vector<int, 64> face_edges;
-
-  face_mask.foreach_index([&](const int face_index) {
-    const int num_face_grids = subdiv_ccg.faces[face_index].size();
-    face_vertices.reinitialize(num_face_grids);
-    topology_refiner->getFaceVertices(face_index, face_vertices.data());
-    adjacent_verts.add_multiple(face_vertices);
+  /* Like #nodes_to_face_selection_grids, use boolean arrays instead of sets for deduplication,
+   * so that the loop over faces can be multi-threaded. */
+  threading::EnumerableThreadSpecific<Vector<int, 64>> all_face_indices;
+  face_mask.foreach_segment(GrainSize(1024), [&](const IndexMaskSegment segment) {
+    Vector<int, 64> &face_indices = all_face_indices.local();
+    for (const int face_index : segment) {
+      const int num_face_grids = subdiv_ccg.faces[face_index].size();
+      face_indices.reinitialize(num_face_grids);
+      topology_refiner->getFaceVertices(face_index, face_indices.data());
+      adjacent_verts.fill_indices(face_indices.as_span(), true);
 
-    face_edges.reinitialize(num_face_grids);
-    topology_refiner->getFaceEdges(face_index, face_edges.data());
-    adjacent_edges.add_multiple(face_edges);
+      topology_refiner->getFaceEdges(face_index, face_indices.data());
+      adjacent_edges.fill_indices(face_indices.as_span(), true);
+    }
   });
 }
 
@@ -960,22 +958,20 @@ void subdiv_ccg_average_faces_boundaries_and_corners(SubdivCCG &subdiv_ccg,
                                                      const CCGKey &key,
                                                      const IndexMask &face_mask)
 {
-  blender::Set<int> adjacent_vert_set;
-  blender::Set<int> adjacent_edge_set;
-  subdiv_ccg_affected_face_adjacency(subdiv_ccg, face_mask, adjacent_vert_set, adjacent_edge_set);
-
-  Vector<int> adjacent_verts(adjacent_vert_set.begin(), adjacent_vert_set.end());
-  Vector<int> adjacent_edges(adjacent_edge_set.begin(), adjacent_edge_set.end());
+  if (face_mask.size() == subdiv_ccg.faces.size()) {
+    /* All faces are affected, skip building the adjacency masks. */
+    subdiv_ccg_average_boundaries(subdiv_ccg, key, subdiv_ccg.adjacent_edges.index_range());
+    subdiv_ccg_average_corners(subdiv_ccg, key, subdiv_ccg.adjacent_verts.index_range());
+    return;
+  }
 
-  std::sort(adjacent_verts.begin(), adjacent_verts.end());
-  std::sort(adjacent_edges.begin(), adjacent_edges.end());
+  Array<bool> adjacent_verts(subdiv_ccg.adjacent_verts.size(), false);
+  Array<bool> adjacent_edges(subdiv_ccg.adjacent_edges.size(), false);
+  subdiv_ccg_affected_face_adjacency(subdiv_ccg, face_mask, adjacent_verts, adjacent_edges);
 
   IndexMaskMemory memory;
-  subdiv_ccg_average_boundaries(
-      subdiv_ccg, key, IndexMask::from_indices(adjacent_edges.as_span(), memory));
-
-  subdiv_ccg_average_corners(
-      subdiv_ccg, key, IndexMask::from_indices(adjacent_verts.as_span(), memory));
+  subdiv_ccg_average_boundaries(subdiv_ccg, key, IndexMask::from_bools(adjacent_edges, memory));
+  subdiv_ccg_average_corners(subdiv_ccg, key, IndexMask::from_bools(adjacent_verts, memory));
 }
 
 #endif
@@ -988,10 +984,8 @@ void BKE_subdiv_ccg_average_stitch_faces(SubdivCCG &subdiv_ccg, const IndexMask
   face_mask.foreach_index(GrainSize(512), [&](const int face_index) {
     subdiv_ccg_average_inner_face_grids(subdiv_ccg, key, subdiv_ccg.faces[face_index]);
   });
-  /* TODO(sergey): Only average elements which are adjacent to modified
-   * faces. */
-  subdiv_ccg_average_boundaries(subdiv_ccg, key, subdiv_ccg.adjacent_edges.index_range());
-  subdiv_ccg_average_corners(subdiv_ccg, key, subdiv_ccg.adjacent_verts.index_range());
+  /* Only average elements which are adjacent to modified faces. */
+  subdiv_ccg_average_faces_boundaries_and_corners(subdiv_ccg, key, face_mask);
 #else
   UNUSED_VARS(subdiv_ccg, face_mask);
 #endif
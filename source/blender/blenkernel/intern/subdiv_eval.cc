@@ -18,6 +18,7 @@
 
 #include "MEM_guardedalloc.h"
 
+#include "opensubdiv_capi_type.hh"
 #include "opensubdiv_evaluator_capi.hh"
 #include "opensubdiv_topology_refiner_capi.hh"
 
@@ -379,4 +380,24 @@ void eval_final_point(
   }
 }
 
+/* --------------------------------------------------------------------
+ * Multiple point queries.
+ */
+
+void eval_limit_points(Subdiv *subdiv,
+                       const Span<OpenSubdiv_PatchCoord> patch_coords,
+                       MutableSpan<float3> r_P)
+{
+  BLI_assert(patch_coords.size() == r_P.size());
+  if (patch_coords.is_empty()) {
+    return;
+  }
+  subdiv->evaluator->evaluatePatchesLimit(subdiv->evaluator,
+                                          patch_coords.data(),
+                                          patch_coords.size(),
+                                          reinterpret_cast<float *>(r_P.data()),
+                                          nullptr,
+                                          nullptr);
+}
+
 }  // namespace blender::bke::subdiv
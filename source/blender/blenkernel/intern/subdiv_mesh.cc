@@ -15,6 +15,7 @@
 #include "BLI_math_vector.h"
 #include "BLI_math_vector_types.hh"
 #include "BLI_task.hh"
+#include "BLI_vector.hh"
 
 #include "BKE_customdata.hh"
 #include "BKE_key.hh"
@@ -27,6 +28,8 @@
 
 #include "MEM_guardedalloc.h"
 
+#include "opensubdiv_capi_type.hh"
+
 namespace blender::bke::subdiv {
 
 /* -------------------------------------------------------------------- */
@@ -65,6 +68,11 @@ struct SubdivMeshContext {
   int *accumulated_counters;
   bool have_displacement;
 
+  /* Limit surface coordinates of inner vertices, evaluated all at once after the traversal
+   * when there is no displacement. A negative ptex face index means the vertex was evaluated
+   * already, or is not an inner vertex. */
+  Array<OpenSubdiv_PatchCoord> inner_vertex_coords;
+
   /* Write optimal display edge tags into a boolean array rather than the final bit vector
    * to avoid race conditions when setting bits. */
   Array<bool> subdiv_display_edges;
@@ -531,6 +539,10 @@ static bool subdiv_mesh_topology_info(const ForeachContext *foreach_context,
       subdiv_context->coarse_mesh, num_vertices, num_edges, 0, num_faces, num_loops, mask);
   subdiv_mesh_ctx_cache_custom_data_layers(subdiv_context);
   subdiv_mesh_prepare_accumulator(subdiv_context, num_vertices);
+  if (!subdiv_context->have_displacement) {
+    subdiv_context->inner_vertex_coords = Array<OpenSubdiv_PatchCoord>(num_vertices,
+                                                                       {-1, 0.0f, 0.0f});
+  }
   subdiv_context->subdiv_mesh->runtime->subsurf_face_dot_tags.clear();
   subdiv_context->subdiv_mesh->runtime->subsurf_face_dot_tags.resize(num_vertices);
   if (subdiv_context->settings->use_optimal_display) {
@@ -778,11 +790,41 @@ static void subdiv_mesh_vertex_inner(const ForeachContext *foreach_context,
   float3 &subdiv_position = ctx->subdiv_positions[subdiv_vertex_index];
   subdiv_mesh_ensure_vertex_interpolation(ctx, tls, coarse_face_index, coarse_corner);
   subdiv_vertex_data_interpolate(ctx, subdiv_vertex_index, &tls->vertex_interpolation, u, v);
-  eval_final_point(subdiv, ptex_face_index, u, v, subdiv_position);
+  if (ctx->inner_vertex_coords.is_empty()) {
+    eval_final_point(subdiv, ptex_face_index, u, v, subdiv_position);
+  }
+  else {
+    ctx->inner_vertex_coords[subdiv_vertex_index] = {ptex_face_index, u, v};
+  }
   subdiv_mesh_tag_center_vertex(coarse_face, subdiv_vertex_index, u, v, subdiv_mesh);
   subdiv_vertex_orco_evaluate(ctx, ptex_face_index, u, v, subdiv_vertex_index);
 }
 
+static void subdiv_mesh_evaluate_inner_vertices(SubdivMeshContext *ctx)
+{
+  const Span<OpenSubdiv_PatchCoord> coords = ctx->inner_vertex_coords;
+  if (coords.is_empty()) {
+    return;
+  }
+  /* Inner vertices of a ptex face are stored next to each other, so contiguous ranges of
+   * vertices mostly use the same few patches. */
+  threading::parallel_for(coords.index_range(), 4096, [&](const IndexRange range) {
+    Vector<OpenSubdiv_PatchCoord> batch_coords;
+    Vector<int> batch_verts;
+    for (const int vert : range) {
+      if (coords[vert].ptex_face >= 0) {
+        batch_coords.append(coords[vert]);
+        batch_verts.append(vert);
+      }
+    }
+    Array<float3> positions(batch_verts.size());
+    eval_limit_points(ctx->subdiv, batch_coords, positions);
+    for (const int i : batch_verts.index_range()) {
+      ctx->subdiv_positions[batch_verts[i]] = positions[i];
+    }
+  });
+}
+
 /** \} */
 
 /* -------------------------------------------------------------------- */
@@ -1182,6 +1224,7 @@ Mesh *subdiv_to_mesh(Subdiv *subdiv, const ToMeshSettings *settings, const Mesh
   foreach_context.user_data_tls_size = sizeof(SubdivMeshTLS);
   foreach_context.user_data_tls = &tls;
   foreach_subdiv_geometry(subdiv, &foreach_context, settings, coarse_mesh);
+  subdiv_mesh_evaluate_inner_vertices(&subdiv_context);
   stats_end(&subdiv->stats, SUBDIV_STATS_SUBDIV_TO_MESH_GEOMETRY);
   Mesh *result = subdiv_context.subdiv_mesh;
 
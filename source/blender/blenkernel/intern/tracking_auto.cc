@@ -689,6 +689,29 @@ static void autotrack_context_step_cb(void *__restrict userdata,
   BLI_addtail(&autotrack_tls->results, autotrack_result);
 }
 
+struct AutoTrackPrefetchData {
+  MovieClip *clip;
+  int clip_frame;
+};
+
+/* Get the frame buffer into the movie clip cache, using the same settings as the image accessor
+ * of the tracking context. */
+static void autotrack_prefetch_frame_cb(TaskPool *__restrict /*pool*/, void *taskdata)
+{
+  const AutoTrackPrefetchData *prefetch_data = static_cast<AutoTrackPrefetchData *>(taskdata);
+  MovieClip *clip = prefetch_data->clip;
+
+  MovieClipUser user = {};
+  BKE_movieclip_user_set_frame(
+      &user, BKE_movieclip_remap_clip_to_scene_frame(clip, prefetch_data->clip_frame));
+  user.render_size = MCLIP_PROXY_RENDER_SIZE_FULL;
+  user.render_flag = 0;
+  ImBuf *ibuf = BKE_movieclip_get_ibuf(clip, &user);
+  if (ibuf != nullptr) {
+    IMB_freeImBuf(ibuf);
+  }
+}
+
 static void autotrack_context_reduce(const void *__restrict /*userdata*/,
                                      void *__restrict chunk_join,
                                      void *__restrict chunk)
@@ -712,6 +735,21 @@ bool BKE_autotrack_context_step(AutoTrackContext *context)
   AutoTrackTLS tls;
   BLI_listbase_clear(&tls.results);
 
+  /* Decode the frames which are needed by the next step while the markers of this step are
+   * tracked. Decoding happens while the movie clip cache is locked, so otherwise all tracking
+   * threads would wait for it at the beginning of the next step. All markers of a step are at the
+   * same frame. */
+  const int frame_delta = context->is_backwards ? -1 : 1;
+  AutoTrackPrefetchData prefetch_data[MAX_ACCESSOR_CLIP];
+  TaskPool *prefetch_pool = BLI_task_pool_create(nullptr, TASK_PRIORITY_LOW);
+  for (int clip_index = 0; clip_index < context->num_clips; clip_index++) {
+    prefetch_data[clip_index].clip = context->autotrack_clips[clip_index].clip;
+    prefetch_data[clip_index].clip_frame = context->autotrack_markers[0].libmv_marker.frame +
+                                           2 * frame_delta;
+    BLI_task_pool_push(
+        prefetch_pool, autotrack_prefetch_frame_cb, &prefetch_data[clip_index], false, nullptr);
+  }
+
   TaskParallelSettings settings;
   BLI_parallel_range_settings_defaults(&settings);
   settings.use_threading = (context->num_autotrack_markers > 1);
@@ -722,6 +760,9 @@ bool BKE_autotrack_context_step(AutoTrackContext *context)
   BLI_task_parallel_range(
       0, context->num_autotrack_markers, context, autotrack_context_step_cb, &settings);
 
+  BLI_task_pool_work_and_wait(prefetch_pool);
+  BLI_task_pool_free(prefetch_pool);
+
   /* Prepare next tracking step by updating the AutoTrack context with new markers and moving
    * tracked markers as an input for the next iteration. */
   context->num_autotrack_markers = 0;
@@ -145,7 +145,11 @@ static bool undosys_step_encode(bContext *C, Main *bmain, UndoStack *ustack, Und
 {
   CLOG_INFO(&LOG, 2, "addr=%p, name='%s', type='%s'", us, us->name, us->type->name);
   UNDO_NESTED_CHECK_BEGIN;
-  bool ok = us->type->step_encode(C, bmain, us);
+  bool ok;
+  {
+    MEM_TagScope mem_tag_scope(MEM_TAG_UNDO);
+    ok = us->type->step_encode(C, bmain, us);
+  }
   UNDO_NESTED_CHECK_END;
   if (ok) {
     if (us->type->step_foreach_ID_ref != nullptr) {
@@ -8,11 +8,29 @@
 #  include "BKE_volume_openvdb.hh"
 
 #  include "BLI_map.hh"
+#  include "BLI_system.h"
+
+#  include <algorithm>
+#  include <atomic>
 
 #  include <openvdb/openvdb.h>
 
 namespace blender::bke::volume_grid::file_cache {
 
+/**
+ * A grid at a specific simplify level.
+ */
+struct CachedGrid {
+  GVolumeGrid grid;
+  /**
+   * Memory used by the tree, measured when it was loaded. Zero when the tree is not loaded or has
+   * been unloaded by the cache. This is shared with the load callback of the grid.
+   */
+  std::shared_ptr<std::atomic<int64_t>> tree_memory;
+  /** Value of #GlobalCache::access_counter when the grid was requested the last time. */
+  uint64_t last_access = 0;
+};
+
 /**
  * Cache for a single grid stored in a file.
  */
@@ -25,7 +43,7 @@ struct GridCache {
   /**
    * Cached simplify levels.
    */
-  Map<int, GVolumeGrid> grid_by_simplify_level;
+  Map<int, CachedGrid> grid_by_simplify_level;
 };
 
 /**
@@ -62,6 +80,8 @@ struct FileCache {
 struct GlobalCache {
   std::mutex mutex;
   Map<std::string, FileCache> file_map;
+  /** Incremented whenever a grid is requested, used to find the least recently used grids. */
+  uint64_t access_counter = 0;
 };
 
 /**
@@ -148,23 +168,38 @@ static GVolumeGrid get_cached_grid(const StringRef file_path,
                                    GridCache &grid_cache,
                                    const int simplify_level)
 {
-  if (GVolumeGrid *grid = grid_cache.grid_by_simplify_level.lookup_ptr(simplify_level)) {
-    return *grid;
+  GlobalCache &global_cache = get_global_cache();
+  /* Assumes that the cache is locked already. */
+  BLI_assert(!global_cache.mutex.try_lock());
+  global_cache.access_counter++;
+
+  if (CachedGrid *cached_grid = grid_cache.grid_by_simplify_level.lookup_ptr(simplify_level)) {
+    cached_grid->last_access = global_cache.access_counter;
+    return cached_grid->grid;
   }
+  auto tree_memory = std::make_shared<std::atomic<int64_t>>(0);
   /* A callback that actually loads the full grid including the tree when it's accessed. */
   auto load_grid_fn = [file_path = std::string(file_path),
                        grid_name = std::string(grid_cache.meta_data_grid->getName()),
-                       simplify_level]() {
+                       simplify_level,
+                       tree_memory]() {
+    openvdb::GridBase::Ptr grid;
     if (simplify_level == 0) {
-      return load_single_grid_from_disk(file_path, grid_name);
+      grid = load_single_grid_from_disk(file_path, grid_name);
     }
-    /* Build the simplified grid from the main grid. */
-    const GVolumeGrid main_grid = get_grid_from_file(file_path, grid_name, 0);
-    const VolumeGridType grid_type = main_grid->grid_type();
-    const float resolution_factor = 1.0f / (1 << simplify_level);
-    VolumeTreeAccessToken tree_token;
-    return BKE_volume_grid_create_with_changed_resolution(
-        grid_type, main_grid->grid(tree_token), resolution_factor);
+    else {
+      /* Build the simplified grid from the main grid. */
+      const GVolumeGrid main_grid = get_grid_from_file(file_path, grid_name, 0);
+      const VolumeGridType grid_type = main_grid->grid_type();
+      const float resolution_factor = 1.0f / (1 << simplify_level);
+      VolumeTreeAccessToken tree_token;
+      grid = BKE_volume_grid_create_with_changed_resolution(
+          grid_type, main_grid->grid(tree_token), resolution_factor);
+    }
+    if (grid) {
+      tree_memory->store(int64_t(grid->memUsage()));
+    }
+    return grid;
   };
   /* This allows the returned grid to already contain meta-data and transforms, even if the tree is
    * not loaded yet. */
@@ -177,10 +212,74 @@ static GVolumeGrid get_cached_grid(const StringRef file_path,
   VolumeGridData *grid_data = MEM_new<VolumeGridData>(
       __func__, load_grid_fn, meta_data_and_transform_grid);
   GVolumeGrid grid{grid_data};
-  grid_cache.grid_by_simplify_level.add(simplify_level, grid);
+  grid_cache.grid_by_simplify_level.add(
+      simplify_level, CachedGrid{grid, std::move(tree_memory), global_cache.access_counter});
   return grid;
 }
 
+/**
+ * Memory that the loaded trees of all cached grids may use together. Scrubbing through a long
+ * sequence of files would otherwise keep the trees of all frames in memory.
+ */
+static int64_t get_memory_budget()
+{
+  return int64_t(BLI_system_memory_max_in_megabytes()) * 1024 * 1024 / 2;
+}
+
+/**
+ * Unload the trees of the least recently used grids until the loaded trees fit into the memory
+ * budget. Trees that are accessed right now are skipped, unloaded trees are loaded again when
+ * they are used the next time.
+ *
+ * Must not be called while the cache or any grid is locked: Unloading locks the grids, and a
+ * grid may lock the cache while it loads.
+ */
+static void unload_trees_over_budget()
+{
+  struct LoadedTree {
+    uint64_t last_access;
+    GVolumeGrid grid;
+    std::shared_ptr<std::atomic<int64_t>> tree_memory;
+  };
+  Vector<LoadedTree> loaded_trees;
+  int64_t total_memory = 0;
+  {
+    GlobalCache &global_cache = get_global_cache();
+    std::lock_guard lock{global_cache.mutex};
+    for (FileCache &file_cache : global_cache.file_map.values()) {
+      for (GridCache &grid_cache : file_cache.grids) {
+        for (CachedGrid &cached_grid : grid_cache.grid_by_simplify_level.values()) {
+          const int64_t memory = cached_grid.tree_memory->load();
+          if (memory > 0) {
+            total_memory += memory;
+            loaded_trees.append(
+                {cached_grid.last_access, cached_grid.grid, cached_grid.tree_memory});
+          }
+        }
+      }
+    }
+  }
+
+  const int64_t budget = get_memory_budget();
+  if (total_memory <= budget) {
+    return;
+  }
+  std::sort(loaded_trees.begin(),
+            loaded_trees.end(),
+            [](const LoadedTree &a, const LoadedTree &b) {
+              return a.last_access < b.last_access;
+            });
+  for (LoadedTree &loaded_tree : loaded_trees) {
+    if (total_memory <= budget) {
+      break;
+    }
+    loaded_tree.grid->unload_tree_if_possible();
+    if (!loaded_tree.grid->is_loaded()) {
+      total_memory -= loaded_tree.tree_memory->exchange(0);
+    }
+  }
+}
+
 GVolumeGrid get_grid_from_file(const StringRef file_path,
                                const StringRef grid_name,
                                const int simplify_level)
@@ -197,18 +296,22 @@ GVolumeGrid get_grid_from_file(const StringRef file_path,
 GridsFromFile get_all_grids_from_file(const StringRef file_path, const int simplify_level)
 {
   GridsFromFile result;
-  GlobalCache &global_cache = get_global_cache();
-  std::lock_guard lock{global_cache.mutex};
-  FileCache &file_cache = get_file_cache(file_path);
+  {
+    GlobalCache &global_cache = get_global_cache();
+    std::lock_guard lock{global_cache.mutex};
+    FileCache &file_cache = get_file_cache(file_path);
 
-  if (!file_cache.error_message.empty()) {
-    result.error_message = file_cache.error_message;
-    return result;
-  }
-  result.file_meta_data = std::make_shared<openvdb::MetaMap>(file_cache.meta_data);
-  for (GridCache &grid_cache : file_cache.grids) {
-    result.grids.append(get_cached_grid(file_path, grid_cache, simplify_level));
+    if (!file_cache.error_message.empty()) {
+      result.error_message = file_cache.error_message;
+      return result;
+    }
+    result.file_meta_data = std::make_shared<openvdb::MetaMap>(file_cache.meta_data);
+    for (GridCache &grid_cache : file_cache.grids) {
+      result.grids.append(get_cached_grid(file_path, grid_cache, simplify_level));
+    }
   }
+  /* Loading a new file is a good time to make room for its trees, e.g. when changing frames. */
+  unload_trees_over_budget();
   return result;
 }
 
@@ -219,7 +322,7 @@ void unload_unused()
   for (FileCache &file_cache : global_cache.file_map.values()) {
     for (GridCache &grid_cache : file_cache.grids) {
       grid_cache.grid_by_simplify_level.remove_if(
-          [&](const auto &item) { return item.value->is_mutable(); });
+          [&](const auto &item) { return item.value.grid->is_mutable(); });
     }
   }
 }
@@ -26,6 +26,7 @@
 
 #  include "BLI_endian_defines.h"
 #  include "BLI_math_base.h"
+#  include "BLI_task.h"
 #  include "BLI_threads.h"
 #  include "BLI_utildefines.h"
 #  include "BLI_vector.hh"
@@ -100,10 +101,17 @@ struct FFMpegContext {
   AVFrame *current_frame; /* Image frame in output pixel format. */
   int video_time;
 
-  /* Image frame in Blender's own pixel format, may need conversion to the output pixel format. */
-  AVFrame *img_convert_frame;
+  /* Conversion from Blender's own pixel format to the output pixel format, if they differ. */
   SwsContext *img_convert_ctx;
 
+  /* Frames are converted and encoded by a serial background task, so the next frame can be
+   * rendered meanwhile. The number of queued frames is limited to bound memory usage. */
+  TaskPool *encode_pool;
+  ThreadMutex encode_mutex;
+  ThreadCondition encode_cond;
+  int encode_queue_len;
+  bool encode_failed;
+
   uint8_t *audio_input_buffer;
   uint8_t *audio_deinterleave_buffer;
   int audio_input_samples;
@@ -120,6 +128,7 @@ struct FFMpegContext {
 };
 
 #  define FFMPEG_AUTOSPLIT_SIZE 2000000000
+#  define FFMPEG_ENCODE_QUEUE_SIZE 4
 
 #  define PRINT \
     if (G.debug & G_DEBUG_FFMPEG) \
@@ -395,7 +404,8 @@ static bool write_video_frame(FFMpegContext *context, AVFrame *frame, ReportList
   return success;
 }
 
-/* read and encode a frame of video from the buffer */
+/* Copy the image into a new frame in Blender's internal pixel format, so the image can be
+ * released before the frame is encoded. */
 static AVFrame *generate_video_frame(FFMpegContext *context, const ImBuf *image)
 {
   /* For now only 8-bit/channel images are supported. */
@@ -406,15 +416,9 @@ static AVFrame *generate_video_frame(FFMpegContext *context, const ImBuf *image)
 
   AVCodecParameters *codec = context->video_stream->codecpar;
   int height = codec->height;
-  AVFrame *rgb_frame;
-
-  if (context->img_convert_frame != nullptr) {
-    /* Pixel format conversion is needed. */
-    rgb_frame = context->img_convert_frame;
-  }
-  else {
-    /* The output pixel format is Blender's internal pixel format. */
-    rgb_frame = context->current_frame;
+  AVFrame *rgb_frame = alloc_picture(AV_PIX_FMT_RGBA, codec->width, height);
+  if (rgb_frame == nullptr) {
+    return nullptr;
   }
 
   /* Copy the Blender pixels into the FFMPEG data-structure, taking care of endianness and flipping
@@ -444,12 +448,16 @@ static AVFrame *generate_video_frame(FFMpegContext *context, const ImBuf *image)
 #  endif
   }
 
-  /* Convert to the output pixel format, if it's different that Blender's internal one. */
-  if (context->img_convert_frame != nullptr) {
-    BLI_assert(context->img_convert_ctx != NULL);
-    BKE_ffmpeg_sws_scale_frame(context->img_convert_ctx, context->current_frame, rgb_frame);
-  }
+  return rgb_frame;
+}
 
+/* Convert to the output pixel format, if it's different that Blender's internal one. */
+static AVFrame *convert_video_frame(FFMpegContext *context, AVFrame *rgb_frame)
+{
+  if (context->img_convert_ctx == nullptr) {
+    return rgb_frame;
+  }
+  BKE_ffmpeg_sws_scale_frame(context->img_convert_ctx, context->current_frame, rgb_frame);
   return context->current_frame;
 }
 
@@ -1095,12 +1103,9 @@ static AVStream *alloc_video_stream(FFMpegContext *context,
 
   if (c->pix_fmt == AV_PIX_FMT_RGBA) {
     /* Output pixel format is the same we use internally, no conversion necessary. */
-    context->img_convert_frame = nullptr;
     context->img_convert_ctx = nullptr;
   }
   else {
-    /* Output pixel format is different, allocate frame for conversion. */
-    context->img_convert_frame = alloc_picture(AV_PIX_FMT_RGBA, c->width, c->height);
     context->img_convert_ctx = BKE_ffmpeg_sws_get_context(
         c->width, c->height, AV_PIX_FMT_RGBA, c->pix_fmt, SWS_BICUBIC);
   }
@@ -1707,6 +1712,66 @@ static void write_audio_frames(FFMpegContext *context, double to_pts)
 }
 #  endif
 
+struct FFMpegEncodeTask {
+  FFMpegContext *context;
+  AVFrame *rgb_frame;
+  /* Time up to which audio is encoded after the frame. */
+  double audio_to_pts;
+};
+
+static void ffmpeg_encode_task(TaskPool *__restrict /*pool*/, void *taskdata)
+{
+  FFMpegEncodeTask *task = static_cast<FFMpegEncodeTask *>(taskdata);
+  FFMpegContext *context = task->context;
+
+  /* Only this task writes the flag, so it can be read without locking here. */
+  bool failed = context->encode_failed;
+  if (!failed) {
+    AVFrame *avframe = convert_video_frame(context, task->rgb_frame);
+    /* Errors are reported by #BKE_ffmpeg_append, reports are not used from this thread. */
+    failed = !write_video_frame(context, avframe, nullptr);
+#  ifdef WITH_AUDASPACE
+    write_audio_frames(context, task->audio_to_pts);
+#  endif
+  }
+  delete_picture(task->rgb_frame);
+
+  BLI_mutex_lock(&context->encode_mutex);
+  context->encode_failed = failed;
+  context->encode_queue_len--;
+  BLI_condition_notify_one(&context->encode_cond);
+  BLI_mutex_unlock(&context->encode_mutex);
+}
+
+/* Wait until all queued frames are encoded. */
+static void ffmpeg_encode_wait(FFMpegContext *context)
+{
+  if (context->encode_pool) {
+    BLI_task_pool_work_and_wait(context->encode_pool);
+  }
+}
+
+static void ffmpeg_encode_push(FFMpegContext *context, AVFrame *rgb_frame, double audio_to_pts)
+{
+  if (context->encode_pool == nullptr) {
+    context->encode_pool = BLI_task_pool_create_background_serial(nullptr, TASK_PRIORITY_HIGH);
+  }
+
+  BLI_mutex_lock(&context->encode_mutex);
+  while (context->encode_queue_len >= FFMPEG_ENCODE_QUEUE_SIZE) {
+    BLI_condition_wait(&context->encode_cond, &context->encode_mutex);
+  }
+  context->encode_queue_len++;
+  BLI_mutex_unlock(&context->encode_mutex);
+
+  FFMpegEncodeTask *task = static_cast<FFMpegEncodeTask *>(
+      MEM_mallocN(sizeof(FFMpegEncodeTask), "FFMpegEncodeTask"));
+  task->context = context;
+  task->rgb_frame = rgb_frame;
+  task->audio_to_pts = audio_to_pts;
+  BLI_task_pool_push(context->encode_pool, ffmpeg_encode_task, task, true, nullptr);
+}
+
 bool BKE_ffmpeg_append(void *context_v,
                        RenderData *rd,
                        int start_frame,
@@ -1723,14 +1788,27 @@ bool BKE_ffmpeg_append(void *context_v,
 
   if (context->video_stream) {
     avframe = generate_video_frame(context, image);
-    success = (avframe && write_video_frame(context, avframe, reports));
-#  ifdef WITH_AUDASPACE
-    /* Add +1 frame because we want to encode audio up until the next video frame. */
-    write_audio_frames(
-        context, (frame - start_frame + 1) / (double(rd->frs_sec) / double(rd->frs_sec_base)));
-#  else
-    UNUSED_VARS(start_frame);
-#  endif
+    if (avframe) {
+      /* Add +1 frame because we want to encode audio up until the next video frame. */
+      const double audio_to_pts = (frame - start_frame + 1) /
+                                  (double(rd->frs_sec) / double(rd->frs_sec_base));
+      ffmpeg_encode_push(context, avframe, audio_to_pts);
+    }
+    else {
+      success = false;
+    }
+
+    if (context->ffmpeg_autosplit) {
+      /* The file size is only known once the queued frames are written. */
+      ffmpeg_encode_wait(context);
+    }
+    BLI_mutex_lock(&context->encode_mutex);
+    const bool encode_failed = context->encode_failed;
+    BLI_mutex_unlock(&context->encode_mutex);
+    if (encode_failed) {
+      BKE_report(reports, RPT_ERROR, "Error writing frame");
+      success = false;
+    }
 
     if (context->ffmpeg_autosplit) {
       if (avio_tell(context->outfile->pb) > FFMPEG_AUTOSPLIT_SIZE) {
@@ -1749,6 +1827,8 @@ static void end_ffmpeg_impl(FFMpegContext *context, int is_autosplit)
 {
   PRINT("Closing FFMPEG...\n");
 
+  ffmpeg_encode_wait(context);
+
 #  ifdef WITH_AUDASPACE
   if (is_autosplit == false) {
     if (context->audio_mixdown_device) {
@@ -1790,10 +1870,6 @@ static void end_ffmpeg_impl(FFMpegContext *context, int is_autosplit)
     delete_picture(context->current_frame);
     context->current_frame = nullptr;
   }
-  if (context->img_convert_frame != nullptr) {
-    delete_picture(context->img_convert_frame);
-    context->img_convert_frame = nullptr;
-  }
 
   if (context->outfile != nullptr && context->outfile->oformat) {
     if (!(context->outfile->oformat->flags & AVFMT_NOFILE)) {
@@ -1834,6 +1910,12 @@ void BKE_ffmpeg_end(void *context_v)
 {
   FFMpegContext *context = static_cast<FFMpegContext *>(context_v);
   end_ffmpeg_impl(context, false);
+
+  if (context->encode_pool) {
+    BLI_task_pool_free(context->encode_pool);
+    context->encode_pool = nullptr;
+  }
+  context->encode_failed = false;
 }
 
 void BKE_ffmpeg_preset_set(RenderData *rd, int preset)
@@ -1965,6 +2047,8 @@ void *BKE_ffmpeg_context_create()
   context->ffmpeg_preview = false;
   context->stamp_data = nullptr;
   context->audio_time_total = 0.0;
+  BLI_mutex_init(&context->encode_mutex);
+  BLI_condition_init(&context->encode_cond);
 
   return context;
 }
@@ -1978,6 +2062,12 @@ void BKE_ffmpeg_context_free(void *context_v)
   if (context->stamp_data) {
     MEM_freeN(context->stamp_data);
   }
+  if (context->encode_pool) {
+    BLI_task_pool_work_and_wait(context->encode_pool);
+    BLI_task_pool_free(context->encode_pool);
+  }
+  BLI_mutex_end(&context->encode_mutex);
+  BLI_condition_end(&context->encode_cond);
   MEM_freeN(context);
 }
 
@@ -132,6 +132,9 @@ typedef struct NlaEvalData {
   GHash *path_hash;
   GHash *key_hash;
 
+  /* Optional cache of resolved paths that is kept across evaluations. */
+  struct AnimationEvalCache *eval_cache;
+
   /* Base snapshot. */
   int num_channels;
   NlaEvalSnapshot base_snapshot;
@@ -32,12 +32,20 @@ struct FileReader;
 typedef int64_t (*FileReaderReadFn)(struct FileReader *reader, void *buffer, size_t size);
 typedef off64_t (*FileReaderSeekFn)(struct FileReader *reader, off64_t offset, int whence);
 typedef void (*FileReaderCloseFn)(struct FileReader *reader);
+typedef const void *(*FileReaderPeekFn)(struct FileReader *reader, off64_t offset, size_t size);
 
 /** General structure for all #FileReaders, implementations add custom fields at the end. */
 typedef struct FileReader {
   FileReaderReadFn read;
   FileReaderSeekFn seek;
   FileReaderCloseFn close;
+  /**
+   * Optional, access `size` bytes starting at `offset` without copying them.
+   * Only readers that hold the whole (uncompressed) file in memory implement this,
+   * the returned memory is read-only and stays valid until the reader is closed.
+   * Returns NULL when the range is out of bounds or after a read error.
+   */
+  FileReaderPeekFn peek;
 
   off64_t offset;
 } FileReader;
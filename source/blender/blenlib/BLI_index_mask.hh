@@ -252,6 +252,18 @@ class IndexMask : private IndexMaskData {
                                   GrainSize grain_size,
                                   IndexMaskMemory &memory,
                                   Fn &&predicate);
+  /**
+   * Same as #from_predicate, but the predicate is evaluated for a whole segment of the universe
+   * at once. This allows the caller to compute the condition for many indices in bulk. The
+   * predicate has the signature `int64_t(IndexMaskSegment universe_segment, int16_t
+   * *r_true_indices)`. It has to write the indices (relative to the segment offset) that are part
+   * of the mask into `r_true_indices` in sorted order and return how many there are.
+   */
+  template<typename Fn>
+  static IndexMask from_batch_predicate(const IndexMask &universe,
+                                        GrainSize grain_size,
+                                        IndexMaskMemory &memory,
+                                        Fn &&batch_predicate);
   /** Sorts all indices from #universe into the different output masks. */
   template<typename T, typename Fn>
   static void from_groups(const IndexMask &universe,
@@ -1017,6 +1029,15 @@ inline IndexMask IndexMask::from_predicate(const IndexMask &universe,
       });
 }
 
+template<typename Fn>
+inline IndexMask IndexMask::from_batch_predicate(const IndexMask &universe,
+                                                 const GrainSize grain_size,
+                                                 IndexMaskMemory &memory,
+                                                 Fn &&batch_predicate)
+{
+  return detail::from_predicate_impl(universe, grain_size, memory, batch_predicate);
+}
+
 template<typename T, typename Fn>
 void IndexMask::from_groups(const IndexMask &universe,
                             IndexMaskMemory &memory,
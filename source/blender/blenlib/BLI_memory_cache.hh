@@ -0,0 +1,84 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#pragma once
+
+/** \file
+ * \ingroup bli
+ *
+ * A global cache for results of expensive computations that can be reused across evaluations,
+ * like outputs of nodes whose inputs did not change. The cache has an approximate size limit,
+ * when it is exceeded the least recently used values are removed.
+ */
+
+#include <memory>
+#include <typeinfo>
+
+#include "BLI_function_ref.hh"
+
+namespace blender::memory_cache {
+
+/**
+ * Identifies a cached value. Implementations define hashing and equality for their own type, keys
+ * of different types are never equal.
+ */
+class GenericKey {
+ public:
+  virtual ~GenericKey() = default;
+
+  virtual uint64_t hash() const = 0;
+
+  /** Only called with keys that have the same type. */
+  virtual bool equal_to(const GenericKey &other) const = 0;
+
+  /**
+   * Create a copy of the key that is stored in the cache. This allows keys used for lookups to
+   * only reference data, while the stored key may e.g. have to keep referenced data alive.
+   */
+  virtual std::unique_ptr<GenericKey> to_storable() const = 0;
+
+  friend bool operator==(const GenericKey &a, const GenericKey &b)
+  {
+    if (typeid(a) != typeid(b)) {
+      return false;
+    }
+    return a.equal_to(b);
+  }
+};
+
+class CachedValue {
+ public:
+  virtual ~CachedValue() = default;
+
+  /** Approximate memory used by the value, used to limit the total size of the cache. */
+  virtual int64_t size_in_bytes() const = 0;
+};
+
+/**
+ * Get the value for the key, computing and adding it to the cache when it does not exist yet.
+ * The compute function is called without holding a lock, so it may run concurrently for the same
+ * key from different threads. Values which are null are not cached.
+ */
+std::shared_ptr<const CachedValue> get_base(
+    const GenericKey &key, FunctionRef<std::unique_ptr<CachedValue>()> compute_fn);
+
+template<typename T>
+inline std::shared_ptr<const T> get(const GenericKey &key,
+                                    const FunctionRef<std::unique_ptr<T>()> compute_fn)
+{
+  static_assert(std::is_base_of_v<CachedValue, T>);
+  return std::static_pointer_cast<const T>(
+      get_base(key, [&]() -> std::unique_ptr<CachedValue> { return compute_fn(); }));
+}
+
+/** Change the approximate size limit, removing values when the cache is larger than that. */
+void set_approximate_size_limit(int64_t limit_in_bytes);
+
+/** Approximate memory used by all cached values. */
+int64_t size_in_bytes();
+
+/** Remove all values, cached values still in use are freed once they are not used anymore. */
+void clear();
+
+}  // namespace blender::memory_cache
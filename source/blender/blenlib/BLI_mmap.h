@@ -34,6 +34,9 @@ bool BLI_mmap_read(BLI_mmap_file *file, void *dest, size_t offset, size_t length
 
 void *BLI_mmap_get_pointer(BLI_mmap_file *file) ATTR_WARN_UNUSED_RESULT;
 size_t BLI_mmap_get_length(const BLI_mmap_file *file) ATTR_WARN_UNUSED_RESULT;
+/* Whether an IO error occurred while accessing the mapped memory (directly or through
+ * #BLI_mmap_read). Once set, the mapped region only contains zeroes. */
+bool BLI_mmap_any_io_error(const BLI_mmap_file *file) ATTR_WARN_UNUSED_RESULT ATTR_NONNULL(1);
 
 void BLI_mmap_free(BLI_mmap_file *file) ATTR_NONNULL(1);
 
@@ -131,22 +131,35 @@ class RandomNumberGenerator {
   void get_bytes(MutableSpan<char> r_bytes);
 
   /**
-   * Simulate getting \a n random values.
+   * Simulate getting \a n random values. This takes logarithmic time in \a n, so it can be used
+   * to give every task of a parallel loop the same random values as a serial loop would get.
    */
   void skip(int64_t n)
   {
-    while (n--) {
-      this->step();
+    /* Compose the affine step `x * multiplier + addend` with itself by repeated squaring. The
+     * 48 bit modulus divides 2^64, so the overflow of the multiplications doesn't matter. */
+    uint64_t step_multiplier = multiplier;
+    uint64_t step_addend = addend;
+    uint64_t skip_multiplier = 1;
+    uint64_t skip_addend = 0;
+    for (; n > 0; n >>= 1) {
+      if (n & 1) {
+        skip_multiplier = (skip_multiplier * step_multiplier) & mask;
+        skip_addend = (skip_addend * step_multiplier + step_addend) & mask;
+      }
+      step_addend = ((step_multiplier + 1) * step_addend) & mask;
+      step_multiplier = (step_multiplier * step_multiplier) & mask;
     }
+    x_ = (skip_multiplier * x_ + skip_addend) & mask;
   }
 
  private:
+  static constexpr uint64_t multiplier = 0x5DEECE66Dll;
+  static constexpr uint64_t addend = 0xB;
+  static constexpr uint64_t mask = 0x0000FFFFFFFFFFFFll;
+
   void step()
   {
-    constexpr uint64_t multiplier = 0x5DEECE66Dll;
-    constexpr uint64_t addend = 0xB;
-    constexpr uint64_t mask = 0x0000FFFFFFFFFFFFll;
-
     x_ = (multiplier * x_ + addend) & mask;
   }
 };
@@ -21,6 +21,12 @@ struct SearchItem {
    * different otherwise.
    */
   Span<int> word_group_ids;
+  /**
+   * A bit mask for every word, with a bit set for each code point in the word. Different code
+   * points can share a bit. Used to skip the expensive fuzzy matching for words which are missing
+   * too many characters of a query word.
+   */
+  Span<uint64_t> word_char_masks;
   /**
    * The id of the group that is highlighted in the UI. In some places, the words in this group are
    * given higher weight.
@@ -74,6 +74,7 @@ void parallel_for_weighted_impl(IndexRange range,
                                 FunctionRef<void(IndexRange)> function,
                                 FunctionRef<void(IndexRange, MutableSpan<int64_t>)> task_sizes_fn);
 void memory_bandwidth_bound_task_impl(FunctionRef<void()> function);
+void low_priority_task_impl(FunctionRef<void()> function);
 }  // namespace detail
 
 template<typename Function>
@@ -270,4 +271,17 @@ inline void memory_bandwidth_bound_task(const int64_t approximate_bytes_touched,
   detail::memory_bandwidth_bound_task_impl(function);
 }
 
+/**
+ * Run the function, including all the parallel work it spawns, with a low priority. Worker threads
+ * prefer tasks with the default priority, so that background work (jobs, prefetching, etc.)
+ * doesn't slow down interactive work like depsgraph evaluation and drawing.
+ *
+ * The function is run in a separate task arena. While waiting for its tasks, the calling thread
+ * only runs other low priority tasks.
+ */
+template<typename Function> inline void low_priority_task(const Function &function)
+{
+  detail::low_priority_task_impl(function);
+}
+
 }  // namespace blender::threading
@@ -0,0 +1,94 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#pragma once
+
+/** \file
+ * \ingroup bli
+ *
+ * Lightweight tracing of nested scopes and counters, meant for analyzing slow frames without
+ * rebuilding Blender. The instrumentation is always compiled in; when tracing is disabled (the
+ * default) a scope only costs a relaxed atomic load.
+ *
+ * Tracing is enabled with `--debug-trace <filepath>`. Events are recorded into a fixed size ring
+ * buffer per thread, so only the most recent events are kept when tracing runs for a long time.
+ * On exit they are written to the file in the Chrome trace event JSON format, which can be
+ * opened in `chrome://tracing` or https://ui.perfetto.dev.
+ *
+ * Names are not copied, they must be string literals or otherwise outlive the trace.
+ *
+ * \code{.cc}
+ * void evaluate()
+ * {
+ *   TRACE_SCOPE("Depsgraph::evaluate");
+ *   ...
+ *   TRACE_COUNTER("Operations", num_operations);
+ * }
+ * \endcode
+ */
+
+#include <atomic>
+#include <cstdint>
+
+#include "BLI_string_ref.hh"
+
+namespace blender::trace {
+
+namespace detail {
+extern std::atomic<bool> enabled;
+int64_t now();
+void record_scope(const char *name, int64_t start, int64_t end);
+void record_counter(const char *name, double value);
+}  // namespace detail
+
+inline bool is_enabled()
+{
+  return detail::enabled.load(std::memory_order_relaxed);
+}
+
+/** Start recording events, they are written to the given file by #write. */
+void enable(StringRefNull filepath);
+/**
+ * Write all recorded events to the file given to #enable. Should be called when no other threads
+ * record events anymore. Does nothing when tracing is disabled.
+ * \return false if the file could not be written.
+ */
+bool write();
+
+inline void counter(const char *name, const double value)
+{
+  if (is_enabled()) {
+    detail::record_counter(name, value);
+  }
+}
+
+/** Records the time between its construction and destruction as a scope on the calling thread. */
+class ScopedTrace {
+ private:
+  const char *name_;
+  int64_t start_;
+
+ public:
+  ScopedTrace(const char *name) : name_(name), start_(is_enabled() ? detail::now() : -1) {}
+
+  ~ScopedTrace()
+  {
+    /* Scopes that started before tracing was enabled are skipped. */
+    if (start_ != -1 && is_enabled()) {
+      detail::record_scope(name_, start_, detail::now());
+    }
+  }
+
+  ScopedTrace(const ScopedTrace &other) = delete;
+  ScopedTrace &operator=(const ScopedTrace &other) = delete;
+};
+
+}  // namespace blender::trace
+
+#define BLI_TRACE_CONCAT_IMPL(a, b) a##b
+#define BLI_TRACE_CONCAT(a, b) BLI_TRACE_CONCAT_IMPL(a, b)
+
+#define TRACE_SCOPE(name) \
+  const blender::trace::ScopedTrace BLI_TRACE_CONCAT(trace_scope_, __LINE__)(name)
+#define TRACE_COUNTER(name, value) blender::trace::counter(name, double(value))
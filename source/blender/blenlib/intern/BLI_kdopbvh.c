@@ -55,6 +55,9 @@
 #  define KDOPBVH_THREAD_LEAF_THRESHOLD 1024
 #endif
 
+/* Number of leafs that are joined by a single task when computing the bounds of large branches. */
+#define KDOPBVH_REFIT_BLOCK_SIZE 16384
+
 /* -------------------------------------------------------------------- */
 /** \name Struct Definitions
  * \{ */
@@ -371,17 +374,14 @@ static void create_kdop_hull(
 }
 
 /**
- * \note depends on the fact that the BVH's for each face is already built
+ * Grow the bounding volume \a bv to contain the nodes in the given range.
  */
-static void refit_kdop_hull(const BVHTree *tree, BVHNode *node, int start, int end)
+static void refit_kdop_hull_range(const BVHTree *tree, float *__restrict bv, int start, int end)
 {
   float newmin, newmax;
-  float *__restrict bv = node->bv;
   int j;
   axis_t axis_iter;
 
-  node_minmax_init(tree, node);
-
   for (j = start; j < end; j++) {
     float *__restrict node_bv = tree->nodes[j]->bv;
 
@@ -400,6 +400,72 @@ static void refit_kdop_hull(const BVHTree *tree, BVHNode *node, int start, int e
   }
 }
 
+typedef struct BVHRefitData {
+  const BVHTree *tree;
+  int start, end;
+} BVHRefitData;
+
+typedef struct BVHRefitChunk {
+  /* Minimum and maximum for up to 13 axes. */
+  float bv[26];
+} BVHRefitChunk;
+
+static void refit_kdop_hull_task_cb(void *__restrict userdata,
+                                    const int block,
+                                    const TaskParallelTLS *__restrict tls)
+{
+  const BVHRefitData *data = userdata;
+  BVHRefitChunk *chunk = tls->userdata_chunk;
+  const int start = data->start + block * KDOPBVH_REFIT_BLOCK_SIZE;
+  const int end = min_ii(start + KDOPBVH_REFIT_BLOCK_SIZE, data->end);
+  refit_kdop_hull_range(data->tree, chunk->bv, start, end);
+}
+
+static void refit_kdop_hull_reduce(const void *__restrict userdata,
+                                   void *__restrict chunk_join,
+                                   void *__restrict chunk)
+{
+  const BVHRefitData *data = userdata;
+  float *bv_join = ((BVHRefitChunk *)chunk_join)->bv;
+  const float *bv = ((const BVHRefitChunk *)chunk)->bv;
+  for (axis_t axis_iter = data->tree->start_axis; axis_iter < data->tree->stop_axis; axis_iter++)
+  {
+    bv_join[(2 * axis_iter)] = min_ff(bv_join[(2 * axis_iter)], bv[(2 * axis_iter)]);
+    bv_join[(2 * axis_iter) + 1] = max_ff(bv_join[(2 * axis_iter) + 1], bv[(2 * axis_iter) + 1]);
+  }
+}
+
+/**
+ * \note depends on the fact that the BVH's for each face is already built
+ */
+static void refit_kdop_hull(const BVHTree *tree, BVHNode *node, int start, int end)
+{
+  node_minmax_init(tree, node);
+
+  const int blocks_num = (end - start + KDOPBVH_REFIT_BLOCK_SIZE - 1) / KDOPBVH_REFIT_BLOCK_SIZE;
+  if (blocks_num < 4) {
+    refit_kdop_hull_range(tree, node->bv, start, end);
+    return;
+  }
+
+  /* Only the top levels of large trees get here. There are fewer branches than threads to build
+   * in parallel, so the leafs of each branch are joined in parallel instead. */
+  BVHRefitData data = {.tree = tree, .start = start, .end = end};
+  BVHRefitChunk chunk;
+  const size_t bv_offset = 2 * (size_t)tree->start_axis;
+  const size_t bv_size = sizeof(float) * 2 * (size_t)(tree->stop_axis - tree->start_axis);
+  memcpy(chunk.bv + bv_offset, node->bv + bv_offset, bv_size);
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.userdata_chunk = &chunk;
+  settings.userdata_chunk_size = sizeof(chunk);
+  settings.func_reduce = refit_kdop_hull_reduce;
+  BLI_task_parallel_range(0, blocks_num, &data, refit_kdop_hull_task_cb, &settings);
+
+  memcpy(node->bv + bv_offset, chunk.bv + bv_offset, bv_size);
+}
+
 /**
  * Only supports x,y,z axis in the moment
  * but we should use a plain and simple function here for speed sake.
@@ -14,14 +14,15 @@
  *  - Literals:
  *      floating point and decimal integer.
  *  - Constants:
- *      pi, True, False
+ *      pi, e, tau, True, False
  *  - Operators:
- *      +, -, *, /, ==, !=, <, <=, >, >=, and, or, not, ternary if
+ *      +, -, *, /, //, %, **, ==, !=, <, <=, >, >=, and, or, not, ternary if
  *  - Functions:
  *      min, max, radians, degrees,
- *      abs, fabs, floor, ceil, trunc, int,
- *      sin, cos, tan, asin, acos, atan, atan2,
- *      exp, log, sqrt, pow, fmod
+ *      abs, fabs, floor, ceil, trunc, int, float, bool,
+ *      sin, cos, tan, asin, acos, atan, atan2, sinh, cosh, tanh, hypot,
+ *      exp, log, log2, log10, sqrt, pow, fmod
+ *  - Names of the math module can also be written with a `math.` prefix.
  *
  * The implementation has no global state and can be used multi-threaded.
  */
@@ -292,6 +293,52 @@ static double op_div(double a, double b)
   return a / b;
 }
 
+/* Python style `divmod`: the remainder has the sign of the divisor. */
+static void op_divmod(double a, double b, double *r_div, double *r_mod)
+{
+  double mod = fmod(a, b);
+  double div = (a - mod) / b;
+
+  if (mod != 0.0) {
+    if ((b < 0.0) != (mod < 0.0)) {
+      mod += b;
+      div -= 1.0;
+    }
+  }
+  else {
+    mod = copysign(0.0, b);
+  }
+
+  if (div != 0.0) {
+    double floordiv = floor(div);
+    *r_div = (div - floordiv > 0.5) ? floordiv + 1.0 : floordiv;
+  }
+  else {
+    *r_div = copysign(0.0, a / b);
+  }
+  *r_mod = mod;
+}
+
+static double op_floordiv(double a, double b)
+{
+  if (b == 0.0) {
+    return a / b;
+  }
+  double div, mod;
+  op_divmod(a, b, &div, &mod);
+  return div;
+}
+
+static double op_mod(double a, double b)
+{
+  if (b == 0.0) {
+    return a / b;
+  }
+  double div, mod;
+  op_divmod(a, b, &div, &mod);
+  return mod;
+}
+
 static double op_add(double a, double b)
 {
   return a + b;
@@ -317,6 +364,16 @@ static double op_log2(double a, double b)
   return log(a) / log(b);
 }
 
+static double op_float(double arg)
+{
+  return arg;
+}
+
+static double op_bool(double arg)
+{
+  return arg ? 1.0 : 0.0;
+}
+
 static double op_lerp(double a, double b, double x)
 {
   return a * (1.0 - x) + b * x;
@@ -379,15 +436,25 @@ static double op_ge(double a, double b)
 typedef struct BuiltinConstDef {
   const char *name;
   double value;
+  /* Also accessible with the `math.` prefix. */
+  bool in_math_module;
 } BuiltinConstDef;
 
 static BuiltinConstDef builtin_consts[] = {
-    {"pi", M_PI}, {"True", 1.0}, {"False", 0.0}, {NULL, 0.0}};
+    {"pi", M_PI, true},
+    {"e", M_E, true},
+    {"tau", 2.0 * M_PI, true},
+    {"True", 1.0, false},
+    {"False", 0.0, false},
+    {NULL, 0.0, false},
+};
 
 typedef struct BuiltinOpDef {
   const char *name;
   eOpCode op;
   void *funcptr;
+  /* Also accessible with the `math.` prefix. */
+  bool in_math_module;
 } BuiltinOpDef;
 
 #ifdef _MSC_VER
@@ -398,33 +465,41 @@ typedef struct BuiltinOpDef {
 #endif
 
 static BuiltinOpDef builtin_ops[] = {
-    {"radians", OPCODE_FUNC1, op_radians},
-    {"degrees", OPCODE_FUNC1, op_degrees},
-    {"abs", OPCODE_FUNC1, fabs},
-    {"fabs", OPCODE_FUNC1, fabs},
-    {"floor", OPCODE_FUNC1, floor},
-    {"ceil", OPCODE_FUNC1, ceil},
-    {"trunc", OPCODE_FUNC1, trunc},
-    {"round", OPCODE_FUNC1, round},
-    {"int", OPCODE_FUNC1, trunc},
-    {"sin", OPCODE_FUNC1, sin},
-    {"cos", OPCODE_FUNC1, cos},
-    {"tan", OPCODE_FUNC1, tan},
-    {"asin", OPCODE_FUNC1, asin},
-    {"acos", OPCODE_FUNC1, acos},
-    {"atan", OPCODE_FUNC1, atan},
-    {"atan2", OPCODE_FUNC2, atan2},
-    {"exp", OPCODE_FUNC1, exp},
-    {"log", OPCODE_FUNC1, log},
-    {"log", OPCODE_FUNC2, op_log2},
-    {"sqrt", OPCODE_FUNC1, sqrt},
-    {"pow", OPCODE_FUNC2, pow},
-    {"fmod", OPCODE_FUNC2, fmod},
-    {"lerp", OPCODE_FUNC3, op_lerp},
-    {"clamp", OPCODE_FUNC1, op_clamp},
-    {"clamp", OPCODE_FUNC3, op_clamp3},
-    {"smoothstep", OPCODE_FUNC3, op_smoothstep},
-    {NULL, OPCODE_CONST, NULL},
+    {"radians", OPCODE_FUNC1, op_radians, true},
+    {"degrees", OPCODE_FUNC1, op_degrees, true},
+    {"abs", OPCODE_FUNC1, fabs, false},
+    {"fabs", OPCODE_FUNC1, fabs, true},
+    {"floor", OPCODE_FUNC1, floor, true},
+    {"ceil", OPCODE_FUNC1, ceil, true},
+    {"trunc", OPCODE_FUNC1, trunc, true},
+    {"round", OPCODE_FUNC1, round, false},
+    {"int", OPCODE_FUNC1, trunc, false},
+    {"float", OPCODE_FUNC1, op_float, false},
+    {"bool", OPCODE_FUNC1, op_bool, false},
+    {"sin", OPCODE_FUNC1, sin, true},
+    {"cos", OPCODE_FUNC1, cos, true},
+    {"tan", OPCODE_FUNC1, tan, true},
+    {"asin", OPCODE_FUNC1, asin, true},
+    {"acos", OPCODE_FUNC1, acos, true},
+    {"atan", OPCODE_FUNC1, atan, true},
+    {"atan2", OPCODE_FUNC2, atan2, true},
+    {"sinh", OPCODE_FUNC1, sinh, true},
+    {"cosh", OPCODE_FUNC1, cosh, true},
+    {"tanh", OPCODE_FUNC1, tanh, true},
+    {"hypot", OPCODE_FUNC2, hypot, true},
+    {"exp", OPCODE_FUNC1, exp, true},
+    {"log", OPCODE_FUNC1, log, true},
+    {"log", OPCODE_FUNC2, op_log2, true},
+    {"log2", OPCODE_FUNC1, log2, true},
+    {"log10", OPCODE_FUNC1, log10, true},
+    {"sqrt", OPCODE_FUNC1, sqrt, true},
+    {"pow", OPCODE_FUNC2, pow, true},
+    {"fmod", OPCODE_FUNC2, fmod, true},
+    {"lerp", OPCODE_FUNC3, op_lerp, false},
+    {"clamp", OPCODE_FUNC1, op_clamp, false},
+    {"clamp", OPCODE_FUNC3, op_clamp3, false},
+    {"smoothstep", OPCODE_FUNC3, op_smoothstep, false},
+    {NULL, OPCODE_CONST, NULL, false},
 };
 
 /** \} */
@@ -454,6 +529,8 @@ static BuiltinOpDef builtin_ops[] = {
 #define TOKEN_NOT MAKE_CHAR2('N', 'O')
 #define TOKEN_IF MAKE_CHAR2('I', 'F')
 #define TOKEN_ELSE MAKE_CHAR2('E', 'L')
+#define TOKEN_POW MAKE_CHAR2('*', '*')
+#define TOKEN_FLOORDIV MAKE_CHAR2('/', '/')
 
 static const char *token_eq_characters = "!=><";
 static const char *token_characters = "~`!@#$%^&*+-=/\\?:;<>(){}[]|.,\"'";
@@ -692,6 +769,13 @@ static bool parse_next_token(ExprParseState *state)
     return (end == out);
   }
 
+  /* Doubled operators: `**` and `//`. */
+  if (ELEM(state->cur[0], '*', '/') && state->cur[1] == state->cur[0]) {
+    state->token = MAKE_CHAR2(state->cur[0], state->cur[1]);
+    state->cur += 2;
+    return true;
+  }
+
   /* ?= tokens */
   if (state->cur[1] == '=' && strchr(token_eq_characters, state->cur[0])) {
     state->token = MAKE_CHAR2(state->cur[0], state->cur[1]);
@@ -736,6 +820,7 @@ static bool parse_next_token(ExprParseState *state)
  * \{ */
 
 static bool parse_expr(ExprParseState *state);
+static bool parse_unary(ExprParseState *state);
 
 static int parse_function_args(ExprParseState *state)
 {
@@ -771,19 +856,12 @@ static int parse_function_args(ExprParseState *state)
   }
 }
 
-static bool parse_unary(ExprParseState *state)
+static bool parse_primary(ExprParseState *state)
 {
+  bool math_module = false;
   int i;
 
   switch (state->token) {
-    case '+':
-      return parse_next_token(state) && parse_unary(state);
-
-    case '-':
-      CHECK_ERROR(parse_next_token(state) && parse_unary(state));
-      parse_add_func(state, OPCODE_FUNC1, 1, op_negate);
-      return true;
-
     case '(':
       return parse_next_token(state) && parse_expr(state) && state->token == ')' &&
              parse_next_token(state);
@@ -802,9 +880,18 @@ static bool parse_unary(ExprParseState *state)
         }
       }
 
+      /* Names qualified with the math module, which doesn't provide all builtins. */
+      if (STREQ(state->tokenbuf, "math") && state->cur[0] == '.') {
+        CHECK_ERROR(parse_next_token(state) && parse_next_token(state) &&
+                    state->token == TOKEN_ID);
+        math_module = true;
+      }
+
       /* Ordinary builtin constants. */
       for (i = 0; builtin_consts[i].name; i++) {
-        if (STREQ(state->tokenbuf, builtin_consts[i].name)) {
+        if (STREQ(state->tokenbuf, builtin_consts[i].name) &&
+            (!math_module || builtin_consts[i].in_math_module))
+        {
           parse_add_op(state, OPCODE_CONST, 1)->arg.dval = builtin_consts[i].value;
           return parse_next_token(state);
         }
@@ -812,7 +899,9 @@ static bool parse_unary(ExprParseState *state)
 
       /* Ordinary builtin functions. */
       for (i = 0; builtin_ops[i].name; i++) {
-        if (STREQ(state->tokenbuf, builtin_ops[i].name)) {
+        if (STREQ(state->tokenbuf, builtin_ops[i].name) &&
+            (!math_module || builtin_ops[i].in_math_module))
+        {
           int args = parse_function_args(state);
 
           /* Search for other arg count versions if necessary. */
@@ -832,6 +921,10 @@ static bool parse_unary(ExprParseState *state)
       }
 
       /* Specially supported functions. */
+      if (math_module) {
+        return false;
+      }
+
       if (STREQ(state->tokenbuf, "min")) {
         int count = parse_function_args(state);
         CHECK_ERROR(count > 0);
@@ -855,6 +948,35 @@ static bool parse_unary(ExprParseState *state)
   }
 }
 
+/* The power operator binds tighter than unary operators on its left, but not on its right. */
+static bool parse_power(ExprParseState *state)
+{
+  CHECK_ERROR(parse_primary(state));
+
+  if (state->token == TOKEN_POW) {
+    CHECK_ERROR(parse_next_token(state) && parse_unary(state));
+    parse_add_func(state, OPCODE_FUNC2, 2, pow);
+  }
+
+  return true;
+}
+
+static bool parse_unary(ExprParseState *state)
+{
+  switch (state->token) {
+    case '+':
+      return parse_next_token(state) && parse_unary(state);
+
+    case '-':
+      CHECK_ERROR(parse_next_token(state) && parse_unary(state));
+      parse_add_func(state, OPCODE_FUNC1, 1, op_negate);
+      return true;
+
+    default:
+      return parse_power(state);
+  }
+}
+
 static bool parse_mul(ExprParseState *state)
 {
   CHECK_ERROR(parse_unary(state));
@@ -871,6 +993,16 @@ static bool parse_mul(ExprParseState *state)
         parse_add_func(state, OPCODE_FUNC2, 2, op_div);
         break;
 
+      case TOKEN_FLOORDIV:
+        CHECK_ERROR(parse_next_token(state) && parse_unary(state));
+        parse_add_func(state, OPCODE_FUNC2, 2, op_floordiv);
+        break;
+
+      case '%':
+        CHECK_ERROR(parse_next_token(state) && parse_unary(state));
+        parse_add_func(state, OPCODE_FUNC2, 2, op_mod);
+        break;
+
       default:
         return true;
     }
@@ -62,6 +62,16 @@ static off64_t memory_seek(FileReader *reader, off64_t offset, int whence)
   return mem->reader.offset;
 }
 
+static const void *memory_peek_raw(FileReader *reader, off64_t offset, size_t size)
+{
+  MemoryReader *mem = (MemoryReader *)reader;
+
+  if (offset < 0 || (size_t)offset + size > mem->length) {
+    return NULL;
+  }
+  return mem->data + offset;
+}
+
 static void memory_close_raw(FileReader *reader)
 {
   MEM_freeN(reader);
@@ -77,6 +87,7 @@ FileReader *BLI_filereader_new_memory(const void *data, size_t len)
   mem->reader.read = memory_read_raw;
   mem->reader.seek = memory_seek;
   mem->reader.close = memory_close_raw;
+  mem->reader.peek = memory_peek_raw;
 
   return (FileReader *)mem;
 }
@@ -103,6 +114,18 @@ static int64_t memory_read_mmap(FileReader *reader, void *buffer, size_t size)
   return readsize;
 }
 
+/* Note that accessing the mapping directly bypasses the IO error handling of #BLI_mmap_read,
+ * a failed page-in is replaced by zeroes and makes all following reads fail instead. */
+static const void *memory_peek_mmap(FileReader *reader, off64_t offset, size_t size)
+{
+  MemoryReader *mem = (MemoryReader *)reader;
+
+  if (offset < 0 || (size_t)offset + size > mem->length || BLI_mmap_any_io_error(mem->mmap)) {
+    return NULL;
+  }
+  return (const char *)BLI_mmap_get_pointer(mem->mmap) + offset;
+}
+
 static void memory_close_mmap(FileReader *reader)
 {
   MemoryReader *mem = (MemoryReader *)reader;
@@ -125,6 +148,7 @@ FileReader *BLI_filereader_new_mmap(int filedes)
   mem->reader.read = memory_read_mmap;
   mem->reader.seek = memory_seek;
   mem->reader.close = memory_close_mmap;
+  mem->reader.peek = memory_peek_mmap;
 
   return (FileReader *)mem;
 }
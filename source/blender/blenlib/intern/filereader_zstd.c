@@ -11,9 +11,35 @@
 
 #include "BLI_filereader.h"
 #include "BLI_math_base.h"
+#include "BLI_task.h"
 
 #include "MEM_guardedalloc.h"
 
+/** Upper limit for the number of frames that are decompressed ahead in parallel. */
+#define ZSTD_PREFETCH_FRAMES_MAX 16
+
+/** A frame which is decompressed by a prefetch task, buffers are reused between frames. */
+typedef struct ZstdFrameSlot {
+  ZSTD_DCtx *ctx;
+
+  char *compressed_data;
+  size_t compressed_size;
+  size_t compressed_alloc_size;
+
+  char *uncompressed_data;
+  size_t uncompressed_size;
+  size_t uncompressed_alloc_size;
+
+  bool is_valid;
+} ZstdFrameSlot;
+
+/** A range of consecutive frames that are decompressed together. */
+typedef struct ZstdFrameBatch {
+  ZstdFrameSlot *slots;
+  int first_frame;
+  int frames_num;
+} ZstdFrameBatch;
+
 typedef struct {
   FileReader reader;
 
@@ -31,6 +57,21 @@ typedef struct {
     char *cached_content;
     int cached_frame;
   } seek;
+
+  /**
+   * When reading sequentially the following frames are decompressed on a #TaskPool
+   * while the caller consumes the current ones. Only used for seekable files, the pool
+   * is NULL when there is only a single thread available.
+   */
+  struct {
+    TaskPool *pool;
+    int frames_per_batch;
+    /** One batch is ready to be read from, the other one may still be decompressing. */
+    ZstdFrameBatch batch[2];
+    int ready;
+    bool pending_active;
+    int last_frame;
+  } prefetch;
 } ZstdReader;
 
 static bool zstd_read_u32(FileReader *base, uint32_t *val)
@@ -191,6 +232,165 @@ static const char *zstd_ensure_cache(ZstdReader *zstd, int frame)
   return uncompressed_data;
 }
 
+static void zstd_prefetch_task(TaskPool *__restrict UNUSED(pool), void *taskdata)
+{
+  ZstdFrameSlot *slot = (ZstdFrameSlot *)taskdata;
+
+  size_t res = ZSTD_decompressDCtx(slot->ctx,
+                                   slot->uncompressed_data,
+                                   slot->uncompressed_size,
+                                   slot->compressed_data,
+                                   slot->compressed_size);
+  slot->is_valid = !ZSTD_isError(res) && res >= slot->uncompressed_size;
+}
+
+static void zstd_prefetch_slot_ensure_size(char **data, size_t *alloc_size, size_t size)
+{
+  if (*alloc_size < size) {
+    MEM_SAFE_FREE(*data);
+    *data = MEM_mallocN(size, __func__);
+    *alloc_size = size;
+  }
+}
+
+/* Read the compressed data of `frames_num` frames starting at `first_frame` on the calling
+ * thread (the base reader isn't thread-safe), then queue their decompression. */
+static void zstd_prefetch_batch_start(ZstdReader *zstd,
+                                      ZstdFrameBatch *batch,
+                                      int first_frame,
+                                      int frames_num)
+{
+  batch->first_frame = first_frame;
+  batch->frames_num = max_ii(min_ii(frames_num, zstd->seek.frames_num - first_frame), 0);
+
+  for (int i = 0; i < batch->frames_num; i++) {
+    const int frame = first_frame + i;
+    ZstdFrameSlot *slot = &batch->slots[i];
+
+    slot->is_valid = false;
+    slot->compressed_size = zstd->seek.compressed_ofs[frame + 1] -
+                            zstd->seek.compressed_ofs[frame];
+    slot->uncompressed_size = zstd->seek.uncompressed_ofs[frame + 1] -
+                              zstd->seek.uncompressed_ofs[frame];
+    zstd_prefetch_slot_ensure_size(
+        &slot->compressed_data, &slot->compressed_alloc_size, slot->compressed_size);
+    zstd_prefetch_slot_ensure_size(
+        &slot->uncompressed_data, &slot->uncompressed_alloc_size, slot->uncompressed_size);
+
+    if (zstd->base->seek(zstd->base, zstd->seek.compressed_ofs[frame], SEEK_SET) < 0 ||
+        zstd->base->read(zstd->base, slot->compressed_data, slot->compressed_size) <
+            slot->compressed_size)
+    {
+      /* Reading failed, the slot stays invalid and following frames are not prefetched. */
+      batch->frames_num = i + 1;
+      break;
+    }
+
+    if (slot->ctx == NULL) {
+      slot->ctx = ZSTD_createDCtx();
+    }
+    BLI_task_pool_push(zstd->prefetch.pool, zstd_prefetch_task, slot, false, NULL);
+  }
+}
+
+/* Returns true when the frame is part of the batch, `r_data` is NULL when decompression failed. */
+static bool zstd_prefetch_batch_lookup(const ZstdFrameBatch *batch, int frame, const char **r_data)
+{
+  if (frame < batch->first_frame || frame >= batch->first_frame + batch->frames_num) {
+    return false;
+  }
+  const ZstdFrameSlot *slot = &batch->slots[frame - batch->first_frame];
+  *r_data = slot->is_valid ? slot->uncompressed_data : NULL;
+  return true;
+}
+
+static const char *zstd_prefetch_ensure(ZstdReader *zstd, int frame)
+{
+  const char *data;
+  const bool is_sequential = (frame == zstd->prefetch.last_frame + 1);
+  zstd->prefetch.last_frame = frame;
+
+  ZstdFrameBatch *ready = &zstd->prefetch.batch[zstd->prefetch.ready];
+  if (zstd_prefetch_batch_lookup(ready, frame, &data)) {
+    return data;
+  }
+
+  if (zstd->prefetch.pending_active) {
+    BLI_task_pool_work_and_wait(zstd->prefetch.pool);
+    zstd->prefetch.pending_active = false;
+
+    ZstdFrameBatch *pending = &zstd->prefetch.batch[!zstd->prefetch.ready];
+    if (zstd_prefetch_batch_lookup(pending, frame, &data)) {
+      /* The reader caught up with the prefetched frames, swap and queue the next batch. */
+      zstd->prefetch.ready = !zstd->prefetch.ready;
+      zstd_prefetch_batch_start(zstd,
+                                ready,
+                                pending->first_frame + pending->frames_num,
+                                zstd->prefetch.frames_per_batch);
+      zstd->prefetch.pending_active = ready->frames_num > 0;
+      return data;
+    }
+  }
+
+  /* Random access (e.g. reading #BHead data on demand) only decompresses the requested frame,
+   * sequential access decompresses a whole batch and queues the following one. */
+  zstd_prefetch_batch_start(
+      zstd, ready, frame, is_sequential ? zstd->prefetch.frames_per_batch : 1);
+  BLI_task_pool_work_and_wait(zstd->prefetch.pool);
+
+  if (is_sequential) {
+    ZstdFrameBatch *pending = &zstd->prefetch.batch[!zstd->prefetch.ready];
+    zstd_prefetch_batch_start(zstd,
+                              pending,
+                              ready->first_frame + ready->frames_num,
+                              zstd->prefetch.frames_per_batch);
+    zstd->prefetch.pending_active = pending->frames_num > 0;
+  }
+
+  if (!zstd_prefetch_batch_lookup(ready, frame, &data)) {
+    return NULL;
+  }
+  return data;
+}
+
+static void zstd_prefetch_init(ZstdReader *zstd)
+{
+  const int threads_num = BLI_task_scheduler_num_threads();
+  if (threads_num <= 1 || zstd->seek.frames_num <= 1) {
+    return;
+  }
+
+  zstd->prefetch.frames_per_batch = min_ii(threads_num, ZSTD_PREFETCH_FRAMES_MAX);
+  for (int i = 0; i < 2; i++) {
+    zstd->prefetch.batch[i].slots = MEM_calloc_arrayN(
+        zstd->prefetch.frames_per_batch, sizeof(ZstdFrameSlot), __func__);
+  }
+  zstd->prefetch.last_frame = -1;
+  zstd->prefetch.pool = BLI_task_pool_create(zstd, TASK_PRIORITY_HIGH);
+}
+
+static void zstd_prefetch_free(ZstdReader *zstd)
+{
+  if (zstd->prefetch.pool == NULL) {
+    return;
+  }
+
+  BLI_task_pool_work_and_wait(zstd->prefetch.pool);
+  BLI_task_pool_free(zstd->prefetch.pool);
+
+  for (int i = 0; i < 2; i++) {
+    for (int j = 0; j < zstd->prefetch.frames_per_batch; j++) {
+      ZstdFrameSlot *slot = &zstd->prefetch.batch[i].slots[j];
+      if (slot->ctx) {
+        ZSTD_freeDCtx(slot->ctx);
+      }
+      MEM_SAFE_FREE(slot->compressed_data);
+      MEM_SAFE_FREE(slot->uncompressed_data);
+    }
+    MEM_freeN(zstd->prefetch.batch[i].slots);
+  }
+}
+
 static int64_t zstd_read_seekable(FileReader *reader, void *buffer, size_t size)
 {
   ZstdReader *zstd = (ZstdReader *)reader;
@@ -203,7 +403,8 @@ static int64_t zstd_read_seekable(FileReader *reader, void *buffer, size_t size)
       break;
     }
 
-    const char *framedata = zstd_ensure_cache(zstd, frame);
+    const char *framedata = zstd->prefetch.pool ? zstd_prefetch_ensure(zstd, frame) :
+                                                  zstd_ensure_cache(zstd, frame);
     if (framedata == NULL) {
       /* Error while reading the frame, so return as much as we can. */
       break;
@@ -279,6 +480,7 @@ static void zstd_close(FileReader *reader)
 
   ZSTD_freeDCtx(zstd->ctx);
   if (zstd->reader.seek) {
+    zstd_prefetch_free(zstd);
     MEM_freeN(zstd->seek.uncompressed_ofs);
     MEM_freeN(zstd->seek.compressed_ofs);
     /* When an error has occurred this may be NULL, see: #99744. */
@@ -304,6 +506,7 @@ FileReader *BLI_filereader_new_zstd(FileReader *base)
   if (zstd_read_seek_table(zstd)) {
     zstd->reader.read = zstd_read_seekable;
     zstd->reader.seek = zstd_seek;
+    zstd_prefetch_init(zstd);
   }
   else {
     zstd->reader.read = zstd_read;
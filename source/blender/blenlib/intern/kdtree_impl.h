@@ -10,6 +10,7 @@
 
 #include "BLI_kdtree_impl.h"
 #include "BLI_math_base.h"
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
 
 #include <string.h>
@@ -56,6 +57,12 @@ struct KDTree {
  */
 #define KD_NODE_ROOT_IS_INIT ((uint)-2)
 
+/**
+ * Sub-trees with more nodes than this are balanced in a separate task.
+ * The partitioning is linear in the number of nodes, so smaller sub-trees aren't worth it.
+ */
+#define KD_BALANCE_TASK_NODES_MIN 16384
+
 /* -------------------------------------------------------------------- */
 /** \name Local Math API
  * \{ */
@@ -139,7 +146,51 @@ void BLI_kdtree_nd_(insert)(KDTree *tree, int index, const float co[KD_DIMS])
 #endif
 }
 
-static uint kdtree_balance(KDTreeNode *nodes, uint nodes_len, uint axis, const uint ofs)
+typedef struct KDTreeBalanceTaskData {
+  KDTreeNode *nodes;
+  uint nodes_len;
+  uint axis;
+  uint ofs;
+  /** The index of the root of the balanced sub-tree is written here. */
+  uint *r_root;
+} KDTreeBalanceTaskData;
+
+static uint kdtree_balance(
+    KDTreeNode *nodes, uint nodes_len, uint axis, const uint ofs, TaskPool *pool);
+
+static void kdtree_balance_task(TaskPool *pool, void *taskdata)
+{
+  const KDTreeBalanceTaskData *data = taskdata;
+  *data->r_root = kdtree_balance(data->nodes, data->nodes_len, data->axis, data->ofs, pool);
+}
+
+/**
+ * Balance a sub-tree in a new task when it is large enough. Sub-trees never overlap, so they can
+ * be sorted in parallel. The root index is written into the parent node which is owned by the
+ * caller.
+ */
+static void kdtree_balance_subtree_in_task(
+    KDTreeNode *nodes, uint nodes_len, uint axis, const uint ofs, TaskPool *pool, uint *r_root)
+{
+  if (nodes_len < KD_BALANCE_TASK_NODES_MIN) {
+    *r_root = kdtree_balance(nodes, nodes_len, axis, ofs, NULL);
+    return;
+  }
+  KDTreeBalanceTaskData *data = MEM_mallocN(sizeof(*data), __func__);
+  data->nodes = nodes;
+  data->nodes_len = nodes_len;
+  data->axis = axis;
+  data->ofs = ofs;
+  data->r_root = r_root;
+  BLI_task_pool_push(pool, kdtree_balance_task, data, true, NULL);
+}
+
+/**
+ * \param pool: When not null, large sub-trees are balanced in tasks of this pool,
+ * the caller has to wait for it to finish.
+ */
+static uint kdtree_balance(
+    KDTreeNode *nodes, uint nodes_len, uint axis, const uint ofs, TaskPool *pool)
 {
   KDTreeNode *node;
   float co;
@@ -188,9 +239,18 @@ static uint kdtree_balance(KDTreeNode *nodes, uint nodes_len, uint axis, const u
   node = &nodes[median];
   node->d = axis;
   axis = (axis + 1) % KD_DIMS;
-  node->left = kdtree_balance(nodes, median, axis, ofs);
-  node->right = kdtree_balance(
-      nodes + median + 1, (nodes_len - (median + 1)), axis, (median + 1) + ofs);
+  if (pool) {
+    /* Continue with the right sub-tree on this thread while the left one may be balanced by
+     * another thread. */
+    kdtree_balance_subtree_in_task(nodes, median, axis, ofs, pool, &node->left);
+    node->right = kdtree_balance(
+        nodes + median + 1, (nodes_len - (median + 1)), axis, (median + 1) + ofs, pool);
+  }
+  else {
+    node->left = kdtree_balance(nodes, median, axis, ofs, NULL);
+    node->right = kdtree_balance(
+        nodes + median + 1, (nodes_len - (median + 1)), axis, (median + 1) + ofs, NULL);
+  }
 
   return median + ofs;
 }
@@ -204,7 +264,15 @@ void BLI_kdtree_nd_(balance)(KDTree *tree)
     }
   }
 
-  tree->root = kdtree_balance(tree->nodes, tree->nodes_len, 0, 0);
+  if (tree->nodes_len < KD_BALANCE_TASK_NODES_MIN * 2) {
+    tree->root = kdtree_balance(tree->nodes, tree->nodes_len, 0, 0, NULL);
+  }
+  else {
+    TaskPool *pool = BLI_task_pool_create(NULL, TASK_PRIORITY_HIGH);
+    tree->root = kdtree_balance(tree->nodes, tree->nodes_len, 0, 0, pool);
+    BLI_task_pool_work_and_wait(pool);
+    BLI_task_pool_free(pool);
+  }
 
 #ifndef NDEBUG
   tree->is_balanced = true;
@@ -0,0 +1,144 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup bli
+ */
+
+#include <algorithm>
+#include <mutex>
+
+#include "BLI_map.hh"
+#include "BLI_memory_cache.hh"
+#include "BLI_vector.hh"
+
+namespace blender::memory_cache {
+
+namespace {
+
+/** Allows looking up stored keys with keys that are not stored. */
+struct KeyRef {
+  const GenericKey *key;
+
+  uint64_t hash() const
+  {
+    return key->hash();
+  }
+
+  friend bool operator==(const KeyRef &a, const KeyRef &b)
+  {
+    return *a.key == *b.key;
+  }
+};
+
+struct StoredValue {
+  std::unique_ptr<GenericKey> key;
+  std::shared_ptr<const CachedValue> value;
+  int64_t size_in_bytes;
+  /** Logical time of the last access, used to find the least recently used values. */
+  uint64_t last_use;
+};
+
+struct Cache {
+  std::mutex mutex;
+  Map<KeyRef, std::unique_ptr<StoredValue>> values;
+  int64_t size_in_bytes = 0;
+  int64_t size_limit = int64_t(1) << 30;
+  uint64_t logical_time = 0;
+};
+
+}  // namespace
+
+static Cache &get_cache()
+{
+  static Cache cache;
+  return cache;
+}
+
+/* Remove least recently used values until the cache fits into its limit again. Evicting down to a
+ * fraction of the limit avoids doing this again for every new value. */
+static void try_enforce_limit(Cache &cache)
+{
+  if (cache.size_in_bytes <= cache.size_limit) {
+    return;
+  }
+  Vector<StoredValue *> stored_values;
+  for (std::unique_ptr<StoredValue> &stored_value : cache.values.values()) {
+    stored_values.append(stored_value.get());
+  }
+  std::sort(stored_values.begin(),
+            stored_values.end(),
+            [](const StoredValue *a, const StoredValue *b) { return a->last_use < b->last_use; });
+  const int64_t target_size = cache.size_limit / 4 * 3;
+  for (StoredValue *stored_value : stored_values) {
+    if (cache.size_in_bytes <= target_size) {
+      break;
+    }
+    cache.size_in_bytes -= stored_value->size_in_bytes;
+    /* Removing the value frees the key, so don't access it afterwards. */
+    cache.values.remove(KeyRef{stored_value->key.get()});
+  }
+}
+
+std::shared_ptr<const CachedValue> get_base(
+    const GenericKey &key, const FunctionRef<std::unique_ptr<CachedValue>()> compute_fn)
+{
+  Cache &cache = get_cache();
+  {
+    std::lock_guard lock{cache.mutex};
+    if (std::unique_ptr<StoredValue> *stored_value = cache.values.lookup_ptr(KeyRef{&key})) {
+      (*stored_value)->last_use = cache.logical_time++;
+      return (*stored_value)->value;
+    }
+  }
+
+  std::shared_ptr<const CachedValue> value = compute_fn();
+  if (!value) {
+    return nullptr;
+  }
+  const int64_t size_in_bytes = value->size_in_bytes();
+  std::unique_ptr<GenericKey> stored_key = key.to_storable();
+
+  std::lock_guard lock{cache.mutex};
+  if (std::unique_ptr<StoredValue> *stored_value = cache.values.lookup_ptr(KeyRef{&key})) {
+    /* Another thread computed the same value in the mean time. */
+    (*stored_value)->last_use = cache.logical_time++;
+    return (*stored_value)->value;
+  }
+  std::unique_ptr<StoredValue> stored_value = std::make_unique<StoredValue>();
+  const KeyRef key_ref{stored_key.get()};
+  stored_value->key = std::move(stored_key);
+  stored_value->value = value;
+  stored_value->size_in_bytes = size_in_bytes;
+  stored_value->last_use = cache.logical_time++;
+  cache.values.add_new(key_ref, std::move(stored_value));
+  cache.size_in_bytes += size_in_bytes;
+  try_enforce_limit(cache);
+  return value;
+}
+
+void set_approximate_size_limit(const int64_t limit_in_bytes)
+{
+  Cache &cache = get_cache();
+  std::lock_guard lock{cache.mutex};
+  cache.size_limit = limit_in_bytes;
+  try_enforce_limit(cache);
+}
+
+int64_t size_in_bytes()
+{
+  Cache &cache = get_cache();
+  std::lock_guard lock{cache.mutex};
+  return cache.size_in_bytes;
+}
+
+void clear()
+{
+  Cache &cache = get_cache();
+  std::lock_guard lock{cache.mutex};
+  cache.values.clear();
+  cache.size_in_bytes = 0;
+}
+
+}  // namespace blender::memory_cache
@@ -30,6 +30,7 @@
 #  include "BLI_stack.hh"
 #  include "BLI_task.hh"
 #  include "BLI_vector.hh"
+#  include "BLI_vector_set.hh"
 
 #  include "BLI_mesh_boolean.hh"
 
@@ -1069,23 +1070,19 @@ static Array<int> sort_tris_around_edge(
  * This possibly makes new cells in \a cinfo, and sets up the
  * bipartite graph edges between cells and patches.
  * Will modify \a pinfo and \a cinfo and the patches and cells they contain.
+ * \a sorted_tris are the triangles around \a e, as returned by #sort_tris_around_edge.
  */
 static void find_cells_from_edge(const IMesh &tm,
-                                 const TriMeshTopology &tmtopo,
                                  PatchesInfo &pinfo,
                                  CellsInfo &cinfo,
-                                 const Edge e)
+                                 const Edge e,
+                                 const Span<int> sorted_tris)
 {
   const int dbg_level = 0;
   if (dbg_level > 0) {
     std::cout << "FIND_CELLS_FROM_EDGE " << e << "\n";
   }
-  const Vector<int> *edge_tris = tmtopo.edge_tris(e);
-  BLI_assert(edge_tris != nullptr);
-  Array<int> sorted_tris = sort_tris_around_edge(
-      tm, e, Span<int>(*edge_tris), (*edge_tris)[0], nullptr);
-
-  int n_edge_tris = edge_tris->size();
+  int n_edge_tris = sorted_tris.size();
   Array<int> edge_patches(n_edge_tris);
   for (int i = 0; i < n_edge_tris; ++i) {
     edge_patches[i] = pinfo.tri_patch(sorted_tris[i]);
@@ -1186,19 +1183,31 @@ static CellsInfo find_cells(const IMesh &tm, const TriMeshTopology &tmtopo, Patc
     std::cout << "\nFIND_CELLS\n";
   }
   CellsInfo cinfo;
-  /* For each unique edge shared between patch pairs, process it. */
-  Set<Edge> processed_edges;
+  /* Gather each unique edge shared between patch pairs. */
+  VectorSet<Edge> patch_edges;
   for (const auto item : pinfo.patch_patch_edge_map().items()) {
     int p = item.key.first;
     int q = item.key.second;
     if (p < q) {
-      const Edge &e = item.value;
-      if (!processed_edges.contains(e)) {
-        processed_edges.add_new(e);
-        find_cells_from_edge(tm, tmtopo, pinfo, cinfo, e);
-      }
+      patch_edges.add(item.value);
     }
   }
+  /* Sorting the triangles around an edge needs exact arithmetic and dominates the cost of
+   * finding cells. It only reads the mesh, so do it for all edges in parallel first. The cell
+   * assignment below depends on the processing order and stays serial. */
+  Array<Array<int>> sorted_tris_by_edge(patch_edges.size());
+  threading::parallel_for(patch_edges.index_range(), 64, [&](const IndexRange range) {
+    for (const int i : range) {
+      const Edge e = patch_edges[i];
+      const Vector<int> *edge_tris = tmtopo.edge_tris(e);
+      BLI_assert(edge_tris != nullptr);
+      sorted_tris_by_edge[i] = sort_tris_around_edge(
+          tm, e, Span<int>(*edge_tris), (*edge_tris)[0], nullptr);
+    }
+  });
+  for (const int i : patch_edges.index_range()) {
+    find_cells_from_edge(tm, pinfo, cinfo, patch_edges[i], sorted_tris_by_edge[i]);
+  }
   /* Some patches may have no cells at this point. These are either:
    * (a) a closed manifold patch only incident on itself (sphere, torus, klein bottle, etc.).
    * (b) an open manifold patch only incident on itself (has non-manifold boundaries).
@@ -768,7 +768,9 @@ BLI_INLINE float4 random_float4_offset(float seed)
                 100.0f + hash_float_to_float(float2(seed, 3.0f)) * 100.0f);
 }
 
-/* Perlin noises to be added to the position to distort other noises. */
+/* Perlin noises to be added to the position to distort other noises. They are skipped when the
+ * distortion strength is zero, which is the common case and saves a noise evaluation per
+ * dimension. */
 
 BLI_INLINE float perlin_distortion(float position, float strength)
 {
@@ -809,7 +811,9 @@ float perlin_fractal_distorted(T position,
                                int type,
                                bool normalize)
 {
-  position += perlin_distortion(position, distortion);
+  if (distortion != 0.0f) {
+    position += perlin_distortion(position, distortion);
+  }
   return perlin_select<T>(position, detail, roughness, lacunarity, offset, gain, type, normalize);
 }
 
@@ -863,7 +867,9 @@ float3 perlin_float3_fractal_distorted(float position,
                                        int type,
                                        bool normalize)
 {
-  position += perlin_distortion(position, distortion);
+  if (distortion != 0.0f) {
+    position += perlin_distortion(position, distortion);
+  }
   return float3(
       perlin_select<float>(position, detail, roughness, lacunarity, offset, gain, type, normalize),
       perlin_select<float>(position + random_float_offset(1.0f),
@@ -894,7 +900,9 @@ float3 perlin_float3_fractal_distorted(float2 position,
                                        int type,
                                        bool normalize)
 {
-  position += perlin_distortion(position, distortion);
+  if (distortion != 0.0f) {
+    position += perlin_distortion(position, distortion);
+  }
   return float3(perlin_select<float2>(
                     position, detail, roughness, lacunarity, offset, gain, type, normalize),
                 perlin_select<float2>(position + random_float2_offset(2.0f),
@@ -925,7 +933,9 @@ float3 perlin_float3_fractal_distorted(float3 position,
                                        int type,
                                        bool normalize)
 {
-  position += perlin_distortion(position, distortion);
+  if (distortion != 0.0f) {
+    position += perlin_distortion(position, distortion);
+  }
   return float3(perlin_select<float3>(
                     position, detail, roughness, lacunarity, offset, gain, type, normalize),
                 perlin_select<float3>(position + random_float3_offset(3.0f),
@@ -956,7 +966,9 @@ float3 perlin_float3_fractal_distorted(float4 position,
                                        int type,
                                        bool normalize)
 {
-  position += perlin_distortion(position, distortion);
+  if (distortion != 0.0f) {
+    position += perlin_distortion(position, distortion);
+  }
   return float3(perlin_select<float4>(
                     position, detail, roughness, lacunarity, offset, gain, type, normalize),
                 perlin_select<float4>(position + random_float4_offset(4.0f),
@@ -87,6 +87,26 @@ int damerau_levenshtein_distance(StringRef a, StringRef b)
   return v1.last();
 }
 
+static int get_fuzzy_match_max_errors(const int query_size)
+{
+  return query_size <= 1 ? 0 : query_size / 8 + 1;
+}
+
+static uint64_t get_char_mask_bit(const uint32_t unicode)
+{
+  return uint64_t(1) << (unicode % 64);
+}
+
+static uint64_t get_char_mask(StringRef str)
+{
+  uint64_t mask = 0;
+  size_t offset = 0;
+  while (offset < size_t(str.size())) {
+    mask |= get_char_mask_bit(BLI_str_utf8_as_unicode_step_safe(str.data(), str.size(), &offset));
+  }
+  return mask;
+}
+
 int get_fuzzy_match_errors(StringRef query, StringRef full)
 {
   /* If it is a perfect partial match, return immediately. */
@@ -104,7 +124,7 @@ int get_fuzzy_match_errors(StringRef query, StringRef full)
   BLI_assert(query.size() >= 2);
 
   /* Allow more errors when the size grows larger. */
-  const int max_errors = query_size <= 1 ? 0 : query_size / 8 + 1;
+  const int max_errors = get_fuzzy_match_max_errors(query_size);
 
   /* If the query is too large, this cannot be a match. */
   if (query_size - full_size > max_errors) {
@@ -312,14 +332,35 @@ static int get_best_word_index_that_startswith(StringRef query,
 }
 
 static int get_word_index_that_fuzzy_matches(StringRef query,
-                                             Span<StringRef> words,
+                                             const SearchItem &item,
                                              Span<int> word_match_map,
                                              int *r_error_count)
 {
+  /* Every code point of the query that is not in a word needs at least one substitution or
+   * deletion. #get_fuzzy_match_errors accepts a distance of at most twice the maximum number of
+   * errors, so words missing more code points can be skipped without computing the distance. */
+  Vector<uint64_t, 32> query_char_bits;
+  size_t offset = 0;
+  while (offset < size_t(query.size())) {
+    query_char_bits.append(get_char_mask_bit(
+        BLI_str_utf8_as_unicode_step_safe(query.data(), query.size(), &offset)));
+  }
+  const int query_size = int(query_char_bits.size());
+  const int max_missing_chars = query_size <= 1 ? 0 : get_fuzzy_match_max_errors(query_size) * 2;
+
+  const Span<StringRef> words = item.normalized_words;
   for (const int i : words.index_range()) {
     if (word_match_map[i] != unused_word) {
       continue;
     }
+    const uint64_t word_mask = item.word_char_masks[i];
+    int missing_chars = 0;
+    for (const uint64_t bit : query_char_bits) {
+      missing_chars += (word_mask & bit) == 0;
+    }
+    if (missing_chars > max_missing_chars) {
+      continue;
+    }
     StringRef word = words[i];
     const int error_count = get_fuzzy_match_errors(query, word);
     if (error_count >= 0) {
@@ -377,7 +418,7 @@ static std::optional<float> score_query_against_words(Span<StringRef> query_word
       /* Fuzzy match against words. */
       int error_count = 0;
       const int word_index = get_word_index_that_fuzzy_matches(
-          query_word, item.normalized_words, word_match_map, &error_count);
+          query_word, item, word_match_map, &error_count);
       if (word_index >= 0) {
         total_match_score += 3 - error_count;
         word_match_map[word_index] = query_word_index;
@@ -513,12 +554,18 @@ void StringSearchBase::add_impl(const StringRef str, void *user_data, const floa
     }
   }
 
+  Array<uint64_t, 64> word_char_masks(words.size());
+  for (const int i : words.index_range()) {
+    word_char_masks[i] = get_char_mask(words[i]);
+  }
+
   /* Not checking for the "D" to avoid problems with upper/lower-case. */
   const bool is_deprecated = str.find("eprecated") != StringRef::not_found;
 
   items_.append({user_data,
                  allocator_.construct_array_copy(words.as_span()),
                  allocator_.construct_array_copy(word_group_ids.as_span()),
+                 allocator_.construct_array_copy(word_char_masks.as_span()),
                  main_group_id,
                  main_group_length,
                  int(str.size()),
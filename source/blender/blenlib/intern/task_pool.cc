@@ -18,6 +18,7 @@
 
 #include "BLI_mempool.h"
 #include "BLI_task.h"
+#include "BLI_task.hh"
 #include "BLI_threads.h"
 
 #ifdef WITH_TBB
@@ -109,13 +110,14 @@ class Task {
 #ifdef WITH_TBB
 class TBBTaskGroup : public tbb::task_group {
  public:
+  /* In TBB 2021 priorities are only available as part of task arenas, no longer for task
+   * groups. Low priority tasks are spawned and waited for in a separate arena instead. */
+  bool use_low_priority_arena = false;
+
   TBBTaskGroup(eTaskPriority priority)
   {
 #  if TBB_INTERFACE_VERSION_MAJOR >= 12
-    /* TODO: support priorities in TBB 2021, where they are only available as
-     * part of task arenas, no longer for task groups. Or remove support for
-     * task priorities if they are no longer useful. */
-    UNUSED_VARS(priority);
+    use_low_priority_arena = (priority == TASK_PRIORITY_LOW);
 #  else
     switch (priority) {
       case TASK_PRIORITY_LOW:
@@ -127,6 +129,17 @@ class TBBTaskGroup : public tbb::task_group {
     }
 #  endif
   }
+
+  /* Run a function that spawns or waits for tasks of this group, in the arena of the group. */
+  template<typename Function> void execute(const Function &function)
+  {
+    if (use_low_priority_arena) {
+      blender::threading::low_priority_task(function);
+    }
+    else {
+      function();
+    }
+  }
 };
 #endif
 
@@ -207,7 +220,7 @@ static void tbb_task_pool_run(TaskPool *pool, Task &&task)
 #ifdef WITH_TBB
   else if (pool->use_threads) {
     /* Execute in TBB task group. */
-    pool->tbb_group.run(std::move(task));
+    pool->tbb_group.execute([&]() { pool->tbb_group.run(std::move(task)); });
   }
 #endif
   else {
@@ -236,7 +249,7 @@ static void tbb_task_pool_work_and_wait(TaskPool *pool)
     /* This is called wait(), but internally it can actually do work. This
      * matters because we don't want recursive usage of task pools to run
      * out of threads and get stuck. */
-    pool->tbb_group.wait();
+    pool->tbb_group.execute([&]() { pool->tbb_group.wait(); });
   }
 #endif
 }
@@ -246,7 +259,7 @@ static void tbb_task_pool_cancel(TaskPool *pool)
 #ifdef WITH_TBB
   if (pool->use_threads) {
     pool->tbb_group.cancel();
-    pool->tbb_group.wait();
+    pool->tbb_group.execute([&]() { pool->tbb_group.wait(); });
   }
 #else
   UNUSED_VARS(pool);
@@ -12,6 +12,7 @@
 
 #include "BLI_lazy_threading.hh"
 #include "BLI_task.h"
+#include "BLI_task.hh"
 #include "BLI_threads.h"
 
 #ifdef WITH_TBB
@@ -22,6 +23,10 @@
 #    include <tbb/global_control.h>
 #    define WITH_TBB_GLOBAL_CONTROL
 #  endif
+/* Since TBB 2021, priorities are only available for task arenas. */
+#  if TBB_INTERFACE_VERSION_MAJOR >= 12
+#    define WITH_TBB_ARENA_PRIORITY
+#  endif
 #endif
 
 /* Task Scheduler */
@@ -76,3 +81,29 @@ void BLI_task_isolate(void (*func)(void *userdata), void *userdata)
   func(userdata);
 #endif
 }
+
+namespace blender::threading::detail {
+
+void low_priority_task_impl(const FunctionRef<void()> function)
+{
+#ifdef WITH_TBB_ARENA_PRIORITY
+  if (BLI_task_scheduler_num_threads() <= 1) {
+    function();
+    return;
+  }
+  /* Uses all threads, the priority only matters when there is other work to do. One slot is
+   * reserved so that the calling thread can always join the arena. */
+  static tbb::task_arena arena{tbb::task_arena::automatic, 1, tbb::task_arena::priority::low};
+
+  /* Make sure the lazy threading hints are send now, because they shouldn't be send out of an
+   * isolated region. */
+  lazy_threading::send_hint();
+  lazy_threading::ReceiverIsolation isolation;
+
+  arena.execute(function);
+#else
+  function();
+#endif
+}
+
+}  // namespace blender::threading::detail
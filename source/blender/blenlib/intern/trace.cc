@@ -0,0 +1,192 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup bli
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "BLI_array.hh"
+#include "BLI_fileops.h"
+#include "BLI_trace.hh"
+#include "BLI_utildefines.h"
+#include "BLI_vector.hh"
+
+namespace blender::trace {
+
+namespace detail {
+std::atomic<bool> enabled = false;
+}
+
+/** Number of events kept per thread, older events are overwritten. */
+static constexpr int64_t EVENTS_PER_THREAD = 1 << 15;
+
+enum class EventType : int8_t {
+  Scope,
+  Counter,
+};
+
+struct Event {
+  const char *name;
+  /** Nanoseconds since tracing was enabled. */
+  int64_t start;
+  union {
+    int64_t duration;
+    double value;
+  };
+  EventType type;
+};
+
+struct ThreadEvents {
+  /** Only contended while writing the trace. */
+  std::mutex mutex;
+  Array<Event> events;
+  /** Total number of recorded events, the next event is written at `num % events.size()`. */
+  int64_t num = 0;
+  int thread_index;
+
+  ThreadEvents(const int thread_index)
+      : events(EVENTS_PER_THREAD, NoInitialization()), thread_index(thread_index)
+  {
+  }
+
+  void add(const Event &event)
+  {
+    std::lock_guard lock{mutex};
+    events[num % events.size()] = event;
+    num++;
+  }
+};
+
+/**
+ * The buffers of all threads that recorded events. They are kept until exit, so that events of
+ * threads that finished before the trace is written are not lost.
+ */
+static struct {
+  std::mutex mutex;
+  Vector<std::unique_ptr<ThreadEvents>> threads;
+  std::string filepath;
+  std::chrono::steady_clock::time_point start_time;
+} g_trace;
+
+static thread_local ThreadEvents *thread_events = nullptr;
+
+static ThreadEvents &get_thread_events()
+{
+  if (thread_events == nullptr) {
+    std::lock_guard lock{g_trace.mutex};
+    g_trace.threads.append(std::make_unique<ThreadEvents>(int(g_trace.threads.size())));
+    thread_events = g_trace.threads.last().get();
+  }
+  return *thread_events;
+}
+
+int64_t detail::now()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now() - g_trace.start_time)
+      .count();
+}
+
+void detail::record_scope(const char *name, const int64_t start, const int64_t end)
+{
+  Event event;
+  event.name = name;
+  event.start = start;
+  event.duration = end - start;
+  event.type = EventType::Scope;
+  get_thread_events().add(event);
+}
+
+void detail::record_counter(const char *name, const double value)
+{
+  Event event;
+  event.name = name;
+  event.start = now();
+  event.value = value;
+  event.type = EventType::Counter;
+  get_thread_events().add(event);
+}
+
+void enable(const StringRefNull filepath)
+{
+  {
+    std::lock_guard lock{g_trace.mutex};
+    g_trace.filepath = filepath;
+    g_trace.start_time = std::chrono::steady_clock::now();
+    for (const std::unique_ptr<ThreadEvents> &thread : g_trace.threads) {
+      std::lock_guard thread_lock{thread->mutex};
+      thread->num = 0;
+    }
+  }
+  detail::enabled.store(true);
+}
+
+static void write_escaped(FILE *file, const char *str)
+{
+  for (const char *c = str; *c; c++) {
+    if (ELEM(*c, '"', '\\')) {
+      fputc('\\', file);
+    }
+    fputc(*c, file);
+  }
+}
+
+bool write()
+{
+  if (!is_enabled()) {
+    return true;
+  }
+  detail::enabled.store(false);
+
+  std::lock_guard lock{g_trace.mutex};
+  FILE *file = BLI_fopen(g_trace.filepath.c_str(), "w");
+  if (file == nullptr) {
+    fprintf(stderr, "Could not write trace to '%s'\n", g_trace.filepath.c_str());
+    return false;
+  }
+
+  fputs("{\"traceEvents\":[\n", file);
+  bool first = true;
+  for (const std::unique_ptr<ThreadEvents> &thread : g_trace.threads) {
+    std::lock_guard thread_lock{thread->mutex};
+    const int64_t size = thread->events.size();
+    /* Write the events from oldest to newest, the oldest ones may have been overwritten. */
+    for (int64_t i = std::max<int64_t>(0, thread->num - size); i < thread->num; i++) {
+      const Event &event = thread->events[i % size];
+      fputs(first ? "{\"name\":\"" : ",\n{\"name\":\"", file);
+      write_escaped(file, event.name);
+      switch (event.type) {
+        case EventType::Scope:
+          fprintf(file,
+                  "\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f}",
+                  thread->thread_index,
+                  double(event.start) / 1000.0,
+                  double(event.duration) / 1000.0);
+          break;
+        case EventType::Counter:
+          fprintf(file,
+                  "\",\"ph\":\"C\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"args\":{\"value\":%g}}",
+                  thread->thread_index,
+                  double(event.start) / 1000.0,
+                  event.value);
+          break;
+      }
+      first = false;
+    }
+  }
+  fputs("\n]}\n", file);
+  fclose(file);
+
+  printf("Trace written to '%s'\n", g_trace.filepath.c_str());
+  return true;
+}
+
+}  // namespace blender::trace
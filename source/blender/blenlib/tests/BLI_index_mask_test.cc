@@ -247,6 +247,31 @@ TEST(index_mask, FromPredicate)
   }
 }
 
+TEST(index_mask, FromBatchPredicate)
+{
+  IndexMaskMemory memory;
+  const IndexMask universe = IndexMask::from_predicate(
+      IndexRange(100'000), GrainSize(1024), memory, [&](const int64_t i) { return i % 3 != 0; });
+  const IndexMask mask = IndexMask::from_batch_predicate(
+      universe,
+      GrainSize(1024),
+      memory,
+      [&](const IndexMaskSegment universe_segment, int16_t *r_true_indices) {
+        int16_t *r_current = r_true_indices;
+        for (const int16_t local_index : universe_segment.base_span()) {
+          if ((local_index + universe_segment.offset()) % 2 == 0) {
+            *r_current++ = local_index;
+          }
+        }
+        return int64_t(r_current - r_true_indices);
+      });
+  const IndexMask expected = IndexMask::from_predicate(
+      IndexRange(100'000), GrainSize(1024), memory, [&](const int64_t i) {
+        return i % 3 != 0 && i % 2 == 0;
+      });
+  EXPECT_EQ(mask, expected);
+}
+
 TEST(index_mask, IndexIteratorConversionFuzzy)
 {
   RandomNumberGenerator rng;
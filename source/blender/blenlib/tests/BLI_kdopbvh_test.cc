@@ -121,6 +121,11 @@ TEST(kdopbvh, FindNearest_500)
 {
   find_nearest_points_test(500, 1.0, 1000, 12);
 }
+/* Large enough for the bounds of the top level branches to be computed in parallel. */
+TEST(kdopbvh, FindNearest_100000)
+{
+  find_nearest_points_test(100000, 1.0, 1000, 12);
+}
 
 TEST(kdopbvh, OptimalFindNearest_1)
 {
@@ -6,7 +6,9 @@
 
 #include "BLI_kdtree.h"
 
+#include <array>
 #include <cmath>
+#include <vector>
 
 /* -------------------------------------------------------------------- */
 /* Tests */
@@ -54,6 +56,27 @@ static void deduplicate_test()
   }
 }
 
+static void large_tree_test()
+{
+  /* Large enough for sub-trees to be balanced in parallel. */
+  const int tree_size = 100000;
+  KDTree_3d *tree = BLI_kdtree_3d_new(tree_size);
+  std::vector<std::array<float, 3>> points(tree_size);
+  for (int i = 0; i < tree_size; i++) {
+    /* Points on a distorted grid, so that all coordinates are unique. */
+    points[i] = {float(i % 47) + i * 1e-5f, float((i / 47) % 53), float(i / (47 * 53))};
+    BLI_kdtree_3d_insert(tree, i, points[i].data());
+  }
+  BLI_kdtree_3d_balance(tree);
+
+  for (int i = 0; i < tree_size; i += 997) {
+    const float co[3] = {points[i][0] + 0.1f, points[i][1] - 0.1f, points[i][2] + 0.1f};
+    KDTreeNearest_3d nearest;
+    EXPECT_EQ(BLI_kdtree_3d_find_nearest(tree, co, &nearest), i);
+  }
+  BLI_kdtree_3d_free(tree);
+}
+
 TEST(kdtree, Standard)
 {
   standard_test();
@@ -63,3 +86,8 @@ TEST(kdtree, Deduplicate)
 {
   deduplicate_test();
 }
+
+TEST(kdtree, LargeTree)
+{
+  large_tree_test();
+}
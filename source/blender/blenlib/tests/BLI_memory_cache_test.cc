@@ -0,0 +1,106 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0 */
+
+#include "testing/testing.h"
+
+#include "BLI_memory_cache.hh"
+
+namespace blender::memory_cache::tests {
+
+class IntKey : public GenericKey {
+ public:
+  int value;
+
+  IntKey(const int value) : value(value) {}
+
+  uint64_t hash() const override
+  {
+    return uint64_t(value);
+  }
+
+  bool equal_to(const GenericKey &other) const override
+  {
+    return value == static_cast<const IntKey &>(other).value;
+  }
+
+  std::unique_ptr<GenericKey> to_storable() const override
+  {
+    return std::make_unique<IntKey>(value);
+  }
+};
+
+class SizedValue : public CachedValue {
+ public:
+  int64_t size;
+
+  SizedValue(const int64_t size) : size(size) {}
+
+  int64_t size_in_bytes() const override
+  {
+    return size;
+  }
+};
+
+TEST(memory_cache, ComputeOnce)
+{
+  clear();
+  int compute_count = 0;
+  auto compute_fn = [&]() {
+    compute_count++;
+    return std::make_unique<SizedValue>(10);
+  };
+  std::shared_ptr<const SizedValue> a = get<SizedValue>(IntKey(1), compute_fn);
+  std::shared_ptr<const SizedValue> b = get<SizedValue>(IntKey(1), compute_fn);
+  std::shared_ptr<const SizedValue> c = get<SizedValue>(IntKey(2), compute_fn);
+  EXPECT_EQ(compute_count, 2);
+  EXPECT_EQ(a, b);
+  EXPECT_NE(a, c);
+  EXPECT_EQ(size_in_bytes(), 20);
+  clear();
+  EXPECT_EQ(size_in_bytes(), 0);
+}
+
+TEST(memory_cache, NullNotCached)
+{
+  clear();
+  int compute_count = 0;
+  auto compute_fn = [&]() -> std::unique_ptr<SizedValue> {
+    compute_count++;
+    return nullptr;
+  };
+  EXPECT_EQ(get<SizedValue>(IntKey(1), compute_fn), nullptr);
+  EXPECT_EQ(get<SizedValue>(IntKey(1), compute_fn), nullptr);
+  EXPECT_EQ(compute_count, 2);
+}
+
+TEST(memory_cache, EvictLeastRecentlyUsed)
+{
+  clear();
+  set_approximate_size_limit(100);
+  int compute_count = 0;
+  auto compute_fn = [&]() {
+    compute_count++;
+    return std::make_unique<SizedValue>(30);
+  };
+  get<SizedValue>(IntKey(1), compute_fn);
+  get<SizedValue>(IntKey(2), compute_fn);
+  get<SizedValue>(IntKey(3), compute_fn);
+  /* Use the first value again, so that the second one is the least recently used. */
+  get<SizedValue>(IntKey(1), compute_fn);
+  EXPECT_EQ(compute_count, 3);
+  get<SizedValue>(IntKey(4), compute_fn);
+  EXPECT_EQ(compute_count, 4);
+  EXPECT_LE(size_in_bytes(), 100);
+
+  get<SizedValue>(IntKey(1), compute_fn);
+  get<SizedValue>(IntKey(4), compute_fn);
+  EXPECT_EQ(compute_count, 4);
+  get<SizedValue>(IntKey(2), compute_fn);
+  EXPECT_EQ(compute_count, 5);
+
+  clear();
+  set_approximate_size_limit(int64_t(1) << 30);
+}
+
+}  // namespace blender::memory_cache::tests
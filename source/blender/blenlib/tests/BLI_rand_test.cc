@@ -0,0 +1,36 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0 */
+
+#include "testing/testing.h"
+
+#include "BLI_rand.hh"
+
+namespace blender::tests {
+
+TEST(random_number_generator, SkipMatchesSteps)
+{
+  for (const int64_t n : {0, 1, 2, 3, 7, 64, 1000, 12345}) {
+    RandomNumberGenerator rng_step(42);
+    RandomNumberGenerator rng_skip(42);
+    for (int64_t i = 0; i < n; i++) {
+      rng_step.get_uint32();
+    }
+    rng_skip.skip(n);
+    for (int i = 0; i < 10; i++) {
+      EXPECT_EQ(rng_step.get_uint32(), rng_skip.get_uint32());
+    }
+  }
+}
+
+TEST(random_number_generator, SkipLarge)
+{
+  RandomNumberGenerator rng_a(7);
+  RandomNumberGenerator rng_b(7);
+  rng_a.skip(int64_t(1) << 40);
+  rng_b.skip(int64_t(1) << 39);
+  rng_b.skip(int64_t(1) << 39);
+  EXPECT_EQ(rng_a.get_uint32(), rng_b.get_uint32());
+}
+
+}  // namespace blender::tests
@@ -63,4 +63,16 @@ TEST(string_search, extract_normalized_words)
   EXPECT_EQ(word_group_ids[5], 2);
 }
 
+TEST(string_search, query_fuzzy)
+{
+  StringSearch<const char> search{nullptr, MainWordsHeuristic::All};
+  search.add("Select All", "select_all");
+  search.add("Delete Vertices", "delete");
+  search.add("Extrude Region", "extrude");
+  const Vector<const char *> results = search.query("selcet");
+  ASSERT_EQ(results.size(), 1);
+  EXPECT_STREQ(results[0], "select_all");
+  EXPECT_TRUE(search.query("xyzwvq").is_empty());
+}
+
 }  // namespace blender::string_search::tests
@@ -0,0 +1,70 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0 */
+
+#include "testing/testing.h"
+
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include "BLI_fileops.h"
+#include "BLI_path_util.h"
+#include "BLI_tempfile.h"
+#include "BLI_trace.hh"
+
+namespace blender::tests {
+
+static std::string read_file(const char *filepath)
+{
+  std::ifstream file(filepath);
+  std::stringstream stream;
+  stream << file.rdbuf();
+  return stream.str();
+}
+
+TEST(trace, Disabled)
+{
+  EXPECT_FALSE(trace::is_enabled());
+  {
+    TRACE_SCOPE("Disabled");
+    TRACE_COUNTER("Counter", 1);
+  }
+  EXPECT_TRUE(trace::write());
+}
+
+TEST(trace, ScopesAndCounters)
+{
+  char temp_dir[FILE_MAX];
+  BLI_temp_directory_path_get(temp_dir, sizeof(temp_dir));
+  char filepath[FILE_MAX];
+  BLI_path_join(filepath, sizeof(filepath), temp_dir, "blender_trace_test.json");
+
+  trace::enable(filepath);
+  EXPECT_TRUE(trace::is_enabled());
+  {
+    TRACE_SCOPE("Outer");
+    {
+      TRACE_SCOPE("Inner \"quoted\"");
+    }
+    TRACE_COUNTER("Counter", 42);
+  }
+  std::thread thread([]() { TRACE_SCOPE("Thread"); });
+  thread.join();
+  EXPECT_TRUE(trace::write());
+  EXPECT_FALSE(trace::is_enabled());
+
+  const std::string json = read_file(filepath);
+  BLI_delete(filepath, false, false);
+
+  EXPECT_EQ(json.find("{\"traceEvents\":["), 0);
+  EXPECT_NE(json.find("\"name\":\"Outer\",\"ph\":\"X\""), std::string::npos);
+  EXPECT_NE(json.find("\"name\":\"Inner \\\"quoted\\\"\",\"ph\":\"X\""), std::string::npos);
+  EXPECT_NE(json.find("\"name\":\"Thread\",\"ph\":\"X\",\"pid\":1,\"tid\":1"), std::string::npos);
+  EXPECT_NE(json.find("\"args\":{\"value\":42}"), std::string::npos);
+  /* The inner scope ends first, so it is recorded before the outer one. */
+  EXPECT_LT(json.find("Inner"), json.find("Outer"));
+}
+
+}  // namespace blender::tests
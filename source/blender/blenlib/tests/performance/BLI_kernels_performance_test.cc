@@ -0,0 +1,210 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0 */
+
+/** \file
+ * Micro-benchmarks for core containers and geometry kernels.
+ *
+ * Each test measures the best of a few runs on a deterministic data-set, prints it and records
+ * it as the `benchmark_time` property of the test (`time` is reserved by GTest). Running the
+ * executable with `--gtest_output=json:<file>` makes the timings available to
+ * `tests/performance/benchmark.py` through the `microbenchmarks` category, so regressions show
+ * up in the same charts as the other performance tests.
+ */
+
+#include "testing/testing.h"
+
+#include <string>
+
+#include "BLI_array.hh"
+#include "BLI_array_utils.hh"
+#include "BLI_index_mask.hh"
+#include "BLI_kdopbvh.h"
+#include "BLI_kdtree.h"
+#include "BLI_map.hh"
+#include "BLI_math_vector_types.hh"
+#include "BLI_rand.hh"
+#include "BLI_set.hh"
+#include "BLI_timeit.hh"
+#include "BLI_vector_set.hh"
+
+namespace blender::tests {
+
+/** Number of times each benchmark is repeated, only the fastest run is recorded. */
+static constexpr int BENCHMARK_RUNS = 5;
+
+static constexpr int NUM_KEYS = 1000000;
+static constexpr int NUM_POINTS = 200000;
+static constexpr int NUM_QUERIES = 100000;
+
+template<typename Fn> static void benchmark(const char *name, const Fn &fn)
+{
+  timeit::Nanoseconds best = timeit::Nanoseconds::max();
+  for ([[maybe_unused]] const int run : IndexRange(BENCHMARK_RUNS)) {
+    const timeit::TimePoint start = timeit::Clock::now();
+    fn();
+    const timeit::TimePoint end = timeit::Clock::now();
+    best = std::min(best, end - start);
+  }
+  std::cout << name << ": ";
+  timeit::print_duration(best);
+  std::cout << "\n";
+
+  const double seconds = std::chrono::duration<double>(best).count();
+  ::testing::Test::RecordProperty("benchmark_time", std::to_string(seconds));
+}
+
+static Array<int> random_keys(const int size, const uint32_t seed)
+{
+  RandomNumberGenerator rng(seed);
+  Array<int> keys(size);
+  for (int &key : keys) {
+    key = rng.get_int32();
+  }
+  return keys;
+}
+
+static Array<float3> random_points(const int size, const uint32_t seed)
+{
+  RandomNumberGenerator rng(seed);
+  Array<float3> points(size);
+  for (float3 &point : points) {
+    point = float3(rng.get_float(), rng.get_float(), rng.get_float());
+  }
+  return points;
+}
+
+/* -------------------------------------------------------------------- */
+/** \name Containers
+ * \{ */
+
+TEST(containers, MapInsertLookup)
+{
+  const Array<int> keys = random_keys(NUM_KEYS, 0);
+  benchmark("Map insert/lookup", [&]() {
+    Map<int, int> map;
+    for (const int i : keys.index_range()) {
+      map.add(keys[i], i);
+    }
+    int64_t sum = 0;
+    for (const int key : keys) {
+      sum += map.lookup_default(key, 0);
+    }
+    EXPECT_GT(sum, 0);
+  });
+}
+
+TEST(containers, SetInsertLookup)
+{
+  const Array<int> keys = random_keys(NUM_KEYS, 1);
+  benchmark("Set insert/lookup", [&]() {
+    Set<int> set;
+    for (const int key : keys) {
+      set.add(key);
+    }
+    int found = 0;
+    for (const int key : keys) {
+      found += set.contains(key);
+    }
+    EXPECT_EQ(found, NUM_KEYS);
+  });
+}
+
+TEST(containers, VectorSetInsertIndexOf)
+{
+  const Array<int> keys = random_keys(NUM_KEYS, 2);
+  benchmark("VectorSet insert/index_of", [&]() {
+    VectorSet<int> set;
+    for (const int key : keys) {
+      set.add(key);
+    }
+    int64_t sum = 0;
+    for (const int key : keys) {
+      sum += set.index_of(key);
+    }
+    EXPECT_GT(sum, 0);
+  });
+}
+
+/** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name Index Masks
+ * \{ */
+
+TEST(index_mask, FromPredicate)
+{
+  const Array<int> keys = random_keys(NUM_KEYS * 10, 3);
+  benchmark("IndexMask::from_predicate", [&]() {
+    IndexMaskMemory memory;
+    const IndexMask mask = IndexMask::from_predicate(
+        keys.index_range(), GrainSize(4096), memory, [&](const int64_t i) {
+          return keys[i] % 3 != 0;
+        });
+    EXPECT_GT(mask.size(), 0);
+  });
+}
+
+TEST(index_mask, Gather)
+{
+  const Array<float3> src = random_points(NUM_KEYS * 10, 4);
+  IndexMaskMemory memory;
+  const IndexMask mask = IndexMask::from_predicate(
+      src.index_range(), GrainSize(4096), memory, [&](const int64_t i) {
+        return src[i].x < 0.5f;
+      });
+  Array<float3> dst(mask.size());
+  benchmark("array_utils::gather",
+            [&]() { array_utils::gather(src.as_span(), mask, dst.as_mutable_span()); });
+}
+
+/** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name Spatial Trees
+ * \{ */
+
+TEST(kdtree, BuildFindNearest)
+{
+  const Array<float3> points = random_points(NUM_POINTS, 5);
+  const Array<float3> queries = random_points(NUM_QUERIES, 6);
+  benchmark("KDTree build/find_nearest", [&]() {
+    KDTree_3d *tree = BLI_kdtree_3d_new(points.size());
+    for (const int i : points.index_range()) {
+      BLI_kdtree_3d_insert(tree, i, points[i]);
+    }
+    BLI_kdtree_3d_balance(tree);
+    int found = 0;
+    for (const float3 &query : queries) {
+      found += BLI_kdtree_3d_find_nearest(tree, query, nullptr) != -1;
+    }
+    BLI_kdtree_3d_free(tree);
+    EXPECT_EQ(found, NUM_QUERIES);
+  });
+}
+
+TEST(kdopbvh, BuildFindNearest)
+{
+  const Array<float3> points = random_points(NUM_POINTS, 7);
+  const Array<float3> queries = random_points(NUM_QUERIES, 8);
+  benchmark("BVHTree build/find_nearest", [&]() {
+    BVHTree *tree = BLI_bvhtree_new(points.size(), 0.0f, 2, 6);
+    for (const int i : points.index_range()) {
+      BLI_bvhtree_insert(tree, i, points[i], 1);
+    }
+    BLI_bvhtree_balance(tree);
+    int found = 0;
+    for (const float3 &query : queries) {
+      BVHTreeNearest nearest;
+      nearest.index = -1;
+      nearest.dist_sq = FLT_MAX;
+      found += BLI_bvhtree_find_nearest(tree, query, &nearest, nullptr, nullptr) != -1;
+    }
+    BLI_bvhtree_free(tree);
+    EXPECT_EQ(found, NUM_QUERIES);
+  });
+}
+
+/** \} */
+
+}  // namespace blender::tests
@@ -3,6 +3,8 @@
  * SPDX-License-Identifier: GPL-2.0-or-later */
 #pragma once
 
+#include <cstdint>
+
 /** \file
  * \ingroup blenloader
  * \brief defines for blend-file codes.
@@ -59,3 +61,37 @@ enum {
 };
 
 #define BLEN_THUMB_MEMSIZE_FILE(_x, _y) (sizeof(int) * (2 + (size_t)(_x) * (size_t)(_y)))
+
+/**
+ * Optional index written after #BLO_CODE_ENDB (so it's ignored by regular file reading), listing
+ * the blocks that aren't #BLO_CODE_DATA with their offset in the (uncompressed) file. This allows
+ * looking up the DNA, ID names and previews of a file with a few seeks instead of scanning all
+ * blocks.
+ *
+ * The entries are followed by #BlendFooterIndexTail at the very end of the file. Values are
+ * stored with the endianness of the file, the index is ignored for files with a different
+ * endianness or pointer size.
+ */
+#define BLEND_FOOTER_INDEX_MAGIC "BLOINDX1"
+
+enum {
+  /** The ID has asset data. */
+  BLEND_FOOTER_INDEX_ID_IS_ASSET = (1 << 0),
+};
+
+struct BlendFooterIndexEntry {
+  /** Offset of the #BHead in the file. */
+  uint64_t offset;
+  /** Offset of the #BHead of the ID's #PreviewImage, zero when it has none. */
+  uint64_t preview_offset;
+  int code;
+  int flag;
+  /** ID name (including the ID code), empty for blocks that aren't an ID. */
+  char name[66];
+  char _pad[6];
+};
+
+struct BlendFooterIndexTail {
+  uint64_t entries_num;
+  char magic[8];
+};
@@ -285,6 +285,16 @@ const blender::ImplicitSharingInfo *BLO_read_shared(
   return sharing_info;
 }
 
+/**
+ * Replace freshly read data that doesn't contain pointers by a mapping of a shared memory segment
+ * with the same content, shared with other processes reading the same data (see
+ * #G_FLAG_READ_SHARED_MEMORY). \a data and \a sharing_info are replaced when that's the case.
+ */
+void BLO_read_shared_memory_array(BlendDataReader *reader,
+                                  void **data,
+                                  size_t size,
+                                  const blender::ImplicitSharingInfo **sharing_info);
+
 int BLO_read_fileversion_get(BlendDataReader *reader);
 bool BLO_read_requires_endian_switch(BlendDataReader *reader);
 bool BLO_read_data_is_undo(BlendDataReader *reader);
@@ -36,6 +36,14 @@ struct MemFileChunk {
   size_t size;
   /** When true, this chunk doesn't own the memory, it's shared with a previous #MemFileChunk */
   bool is_identical;
+  /**
+   * When true, the memory is shared with a chunk of the same ID in the previous step that was
+   * at a different position (e.g. because an array written before it changed size).
+   * The chunk is then not considered identical when detecting unchanged IDs.
+   */
+  bool is_moved;
+  /** Set when #MemFileChunk.hash has been computed (only done when needed). */
+  bool has_hash;
   /** When true, this chunk is also identical to the one in the next step (used by undo code to
    * detect unchanged IDs).
    * Defined when writing the next step (i.e. last undo step has those always false). */
@@ -43,6 +51,8 @@ struct MemFileChunk {
   /** Session UID of the ID being currently written (MAIN_ID_SESSION_UID_UNSET when not writing
    * ID-related data). Used to find matching chunks in previous memundo step. */
   uint id_session_uid;
+  /** Hash of the chunk content, see #MemFileChunk.has_hash. */
+  uint64_t hash;
 };
 
 struct MemFile {
@@ -64,6 +74,13 @@ struct MemFileWriteData {
 
   /** Maps an ID session uid to its first reference MemFileChunk, if existing. */
   blender::Map<uint, MemFileChunk *> id_session_uid_mapping;
+
+  /**
+   * Reference chunks of the ID with session uid #id_chunks_session_uid, by content hash.
+   * Only built once a chunk of that ID doesn't match the reference chunk at the same position.
+   */
+  blender::Map<uint64_t, MemFileChunk *> id_chunks_by_hash;
+  uint id_chunks_session_uid;
 };
 
 struct MemFileUndoData {
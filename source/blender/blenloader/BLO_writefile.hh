@@ -9,6 +9,7 @@
  * \brief external `writefile.cc` function prototypes.
  */
 
+struct BlendFileWriteBuffer;
 struct BlendThumbnail;
 struct Main;
 struct MemFile;
@@ -42,9 +43,25 @@ struct BlendFileWriteParams {
   /** On write, restore paths after editing them (see #BLO_WRITE_PATH_REMAP_RELATIVE). */
   uint use_save_as_copy : 1;
   uint use_userdef : 1;
+  /** Write a #BLO_BLOCK_HASH_INDEX_EXT file next to the saved file. */
+  uint use_block_hash_index : 1;
   const BlendThumbnail *thumb;
 };
 
+/**
+ * Extension appended to the `.blend` file path for the optional block hash index,
+ * which lets external tools (e.g. incremental sync) detect unchanged blocks without
+ * reading the file.
+ *
+ * It's a text file starting with a `BLENDER-BLOCK-HASH <version>` line, followed by a line
+ * per block: `<offset> <length> <code> <hash>`. The offset of the #BHead and the length of
+ * the data following it are in bytes of the uncompressed file, the code is the four
+ * character block code (with zero bytes shown as `_`) and the hash is the hexadecimal
+ * XXH3 64 bit hash of the block data.
+ */
+#define BLO_BLOCK_HASH_INDEX_EXT ".blockhash"
+#define BLO_BLOCK_HASH_INDEX_VERSION 1
+
 /**
  * \return Success.
  */
@@ -54,6 +71,26 @@ extern bool BLO_write_file(Main *mainvar,
                            const BlendFileWriteParams *params,
                            ReportList *reports);
 
+/**
+ * Write the file into memory instead of to disk, the result can be written to disk later using
+ * #BLO_write_buffer_to_file, which doesn't access \a mainvar and may run in a separate thread.
+ *
+ * Paths are written as-is, without any remapping, user preferences and thumbnail aren't written.
+ *
+ * \return The buffer (to be freed with #BLO_write_buffer_free) or null on failure.
+ */
+extern BlendFileWriteBuffer *BLO_write_file_to_buffer(Main *mainvar,
+                                                      int write_flags,
+                                                      ReportList *reports);
+/**
+ * Write a buffer from #BLO_write_file_to_buffer to \a filepath, using a temporary file
+ * so an existing file is kept intact on failure. Errors are logged to the console.
+ *
+ * \return Success.
+ */
+extern bool BLO_write_buffer_to_file(const BlendFileWriteBuffer *buffer, const char *filepath);
+extern void BLO_write_buffer_free(BlendFileWriteBuffer *buffer);
+
 /**
  * \return Success.
  */
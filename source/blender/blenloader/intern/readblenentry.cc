@@ -19,6 +19,7 @@
 #include "BLI_linklist.h"
 #include "BLI_path_util.h" /* Only for assertions. */
 #include "BLI_string.h"
+#include "BLI_trace.hh"
 #include "BLI_utildefines.h"
 
 #include "DNA_genfile.h"
@@ -127,6 +128,20 @@ LinkNode *BLO_blendhandle_get_datablock_names(BlendHandle *bh,
   BHead *bhead;
   int tot = 0;
 
+  if (!blo_footer_index_get(fd).is_empty()) {
+    for (const BlendFooterIndexEntry &entry : blo_footer_index_get(fd)) {
+      if (entry.code == ofblocktype) {
+        if (use_assets_only && (entry.flag & BLEND_FOOTER_INDEX_ID_IS_ASSET) == 0) {
+          continue;
+        }
+        BLI_linklist_prepend(&names, BLI_strdup(entry.name + 2));
+        tot++;
+      }
+    }
+    *r_tot_names = tot;
+    return names;
+  }
+
   for (bhead = blo_bhead_first(fd); bhead; bhead = blo_bhead_next(fd, bhead)) {
     if (bhead->code == ofblocktype) {
       const char *idname = blo_bhead_id_name(fd, bhead);
@@ -253,11 +268,75 @@ static BHead *blo_blendhandle_read_preview_rects(FileData *fd,
   return bhead;
 }
 
+/**
+ * Same as #BLO_blendhandle_get_preview_for_id, using the footer index to find the preview.
+ * The blocks of the preview rects directly follow the preview.
+ */
+static PreviewImage *blo_blendhandle_get_preview_for_id_from_footer_index(
+    FileData *fd, const int ofblocktype, const char *name)
+{
+  const int sdna_preview_image = DNA_struct_find_with_alias(fd->filesdna, "PreviewImage");
+
+  for (const BlendFooterIndexEntry &entry : blo_footer_index_get(fd)) {
+    if (entry.code != ofblocktype || !STREQ(entry.name + 2, name)) {
+      continue;
+    }
+    if (entry.preview_offset == 0) {
+      return nullptr;
+    }
+    BHead *bhead = blo_bhead_read_at(fd, entry.preview_offset);
+    if (bhead == nullptr) {
+      return nullptr;
+    }
+    PreviewImage *preview_from_file = nullptr;
+    if (bhead->code == BLO_CODE_DATA && bhead->SDNAnr == sdna_preview_image) {
+      preview_from_file = static_cast<PreviewImage *>(
+          BLO_library_read_struct(fd, bhead, "PreviewImage"));
+    }
+    uint64_t offset = entry.preview_offset + sizeof(BHead) + uint64_t(bhead->len);
+    blo_bhead_free_detached(bhead);
+    if (preview_from_file == nullptr) {
+      return nullptr;
+    }
+    BKE_previewimg_runtime_data_clear(preview_from_file);
+
+    PreviewImage *result = static_cast<PreviewImage *>(MEM_dupallocN(preview_from_file));
+    for (int preview_index = 0; preview_index < NUM_ICON_SIZES; preview_index++) {
+      result->rect[preview_index] = nullptr;
+      const size_t rect_len = size_t(preview_from_file->w[preview_index]) *
+                              size_t(preview_from_file->h[preview_index]) * sizeof(uint);
+      if (preview_from_file->rect[preview_index] && rect_len) {
+        bhead = blo_bhead_read_at(fd, offset);
+        if (bhead && bhead->code == BLO_CODE_DATA && size_t(bhead->len) == rect_len) {
+          result->rect[preview_index] = static_cast<uint *>(
+              BLO_library_read_struct(fd, bhead, "PreviewImage Icon Rect"));
+        }
+        if (bhead) {
+          offset += sizeof(BHead) + uint64_t(bhead->len);
+          blo_bhead_free_detached(bhead);
+        }
+      }
+      if (result->rect[preview_index] == nullptr) {
+        result->w[preview_index] = result->h[preview_index] = 0;
+      }
+      BKE_previewimg_finish(result, preview_index);
+    }
+    MEM_freeN(preview_from_file);
+    return result;
+  }
+
+  return nullptr;
+}
+
 PreviewImage *BLO_blendhandle_get_preview_for_id(BlendHandle *bh,
                                                  int ofblocktype,
                                                  const char *name)
 {
   FileData *fd = (FileData *)bh;
+  if (!blo_footer_index_get(fd).is_empty()) {
+    return blo_blendhandle_get_preview_for_id_from_footer_index(fd, ofblocktype, name);
+  }
+
   bool looking = false;
   const int sdna_preview_image = DNA_struct_find_with_alias(fd->filesdna, "PreviewImage");
 
@@ -363,6 +442,23 @@ LinkNode *BLO_blendhandle_get_linkable_groups(BlendHandle *bh)
   LinkNode *names = nullptr;
   BHead *bhead;
 
+  if (!blo_footer_index_get(fd).is_empty()) {
+    for (const BlendFooterIndexEntry &entry : blo_footer_index_get(fd)) {
+      /* Only ID's have a name. */
+      if (entry.name[0] == '\0') {
+        continue;
+      }
+      if (BKE_idtype_idcode_is_valid(entry.code) && BKE_idtype_idcode_is_linkable(entry.code)) {
+        const char *str = BKE_idtype_idcode_to_name(entry.code);
+        if (BLI_gset_add(gathered, (void *)str)) {
+          BLI_linklist_prepend(&names, BLI_strdup(str));
+        }
+      }
+    }
+    BLI_gset_free(gathered, nullptr);
+    return names;
+  }
+
   for (bhead = blo_bhead_first(fd); bhead; bhead = blo_bhead_next(fd, bhead)) {
     if (bhead->code == BLO_CODE_ENDB) {
       break;
@@ -405,6 +501,7 @@ BlendFileData *BLO_read_from_file(const char *filepath,
 {
   BLI_assert(!BLI_path_is_rel(filepath));
   BLI_assert(BLI_path_is_abs_from_cwd(filepath));
+  TRACE_SCOPE("BLO::read_from_file");
 
   BlendFileData *bfd = nullptr;
   FileData *fd;
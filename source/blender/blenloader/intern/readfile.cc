@@ -17,6 +17,8 @@
 
 #include "BLI_utildefines.h"
 #ifndef WIN32
+#  include <sys/mman.h> /* for shared memory arrays. */
+#  include <sys/stat.h>
 #  include <unistd.h> /* for read close */
 #else
 #  include "BLI_winstuff.h"
@@ -57,6 +59,7 @@
 #include "BLI_mempool.h"
 #include "BLI_threads.h"
 #include "BLI_time.h"
+#include "BLI_vector.hh"
 
 #include "BLT_translation.hh"
 
@@ -105,6 +108,8 @@
 
 #include "readfile.hh"
 
+#include <xxhash.h>
+
 /* Make preferences read-only. */
 #define U (*((const UserDef *)&U))
 
@@ -887,6 +892,22 @@ static bool blo_bhead_read_data(FileData *fd, BHead *thisblock, void *buf)
   return success;
 }
 
+/**
+ * Access the data of a block that hasn't been read yet without copying it,
+ * when the file is memory-mapped (or already in memory), see #FileReader.peek.
+ * The returned memory is read-only, blocks which need to be modified in-place
+ * (e.g. to switch endianness) still have to be read with #blo_bhead_read_full.
+ */
+static const void *blo_bhead_peek_data(FileData *fd, BHead *thisblock)
+{
+  BHeadN *new_bhead = BHEADN_FROM_BHEAD(thisblock);
+  BLI_assert(new_bhead->has_data == false && new_bhead->file_offset != 0);
+  if (fd->file->peek == nullptr || (fd->flags & FD_FLAGS_IS_MEMFILE)) {
+    return nullptr;
+  }
+  return fd->file->peek(fd->file, new_bhead->file_offset, size_t(new_bhead->bhead.len));
+}
+
 static BHead *blo_bhead_read_full(FileData *fd, BHead *thisblock)
 {
   BHeadN *new_bhead = BHEADN_FROM_BHEAD(thisblock);
@@ -904,6 +925,41 @@ static BHead *blo_bhead_read_full(FileData *fd, BHead *thisblock)
 }
 #endif /* USE_BHEAD_READ_ON_DEMAND */
 
+BHead *blo_bhead_read_at(FileData *fd, const uint64_t offset)
+{
+  /* Only used with the footer index, which is only used when no conversion is needed. */
+  BLI_assert(fd->footer_index != nullptr);
+  BHeadN *new_bhead = nullptr;
+  const off64_t offset_backup = fd->file->offset;
+
+  BHead bhead;
+  if (fd->file->seek(fd->file, off64_t(offset), SEEK_SET) != -1 &&
+      fd->file->read(fd->file, &bhead, sizeof(bhead)) == sizeof(bhead) && bhead.len >= 0)
+  {
+    new_bhead = static_cast<BHeadN *>(
+        MEM_mallocN(sizeof(BHeadN) + size_t(bhead.len), "new_bhead"));
+    new_bhead->next = new_bhead->prev = nullptr;
+#ifdef USE_BHEAD_READ_ON_DEMAND
+    new_bhead->file_offset = 0;
+    new_bhead->has_data = true;
+#endif
+    new_bhead->is_memchunk_identical = false;
+    new_bhead->bhead = bhead;
+    if (fd->file->read(fd->file, new_bhead + 1, size_t(bhead.len)) != bhead.len) {
+      MEM_freeN(new_bhead);
+      new_bhead = nullptr;
+    }
+  }
+
+  fd->file->seek(fd->file, offset_backup, SEEK_SET);
+  return new_bhead ? &new_bhead->bhead : nullptr;
+}
+
+void blo_bhead_free_detached(BHead *bhead)
+{
+  MEM_freeN(BHEADN_FROM_BHEAD(bhead));
+}
+
 const char *blo_bhead_id_name(const FileData *fd, const BHead *bhead)
 {
   return (const char *)POINTER_OFFSET(bhead, sizeof(*bhead) + fd->id_name_offset);
@@ -958,6 +1014,141 @@ static void decode_blender_header(FileData *fd)
   }
 }
 
+/**
+ * Read the #BlendFooterIndexEntry array at the end of the file, if there is any that can be used.
+ */
+static void read_file_footer_index(FileData *fd)
+{
+  if (fd->file->seek == nullptr ||
+      (fd->flags & (FD_FLAGS_IS_MEMFILE | FD_FLAGS_SWITCH_ENDIAN | FD_FLAGS_POINTSIZE_DIFFERS)))
+  {
+    return;
+  }
+
+  const off64_t offset_backup = fd->file->offset;
+  BlendFooterIndexTail tail;
+  const off64_t tail_offset = fd->file->seek(fd->file, -off64_t(sizeof(tail)), SEEK_END);
+  if (tail_offset > 0 && fd->file->read(fd->file, &tail, sizeof(tail)) == sizeof(tail) &&
+      memcmp(tail.magic, BLEND_FOOTER_INDEX_MAGIC, sizeof(tail.magic)) == 0 &&
+      tail.entries_num > 0 && tail.entries_num <= INT_MAX &&
+      tail.entries_num * sizeof(BlendFooterIndexEntry) < uint64_t(tail_offset))
+  {
+    const size_t entries_size = size_t(tail.entries_num) * sizeof(BlendFooterIndexEntry);
+    BlendFooterIndexEntry *entries = static_cast<BlendFooterIndexEntry *>(
+        MEM_mallocN(entries_size, "BlendFooterIndexEntry"));
+    if (fd->file->seek(fd->file, tail_offset - off64_t(entries_size), SEEK_SET) != -1 &&
+        fd->file->read(fd->file, entries, entries_size) == int64_t(entries_size))
+    {
+      for (const int i : blender::IndexRange(int(tail.entries_num))) {
+        entries[i].name[sizeof(entries[i].name) - 1] = '\0';
+      }
+      fd->footer_index = entries;
+      fd->footer_index_num = int(tail.entries_num);
+    }
+    else {
+      MEM_freeN(entries);
+    }
+  }
+
+  fd->file->seek(fd->file, offset_backup, SEEK_SET);
+}
+
+static void footer_index_free(FileData *fd)
+{
+  MEM_SAFE_FREE(fd->footer_index);
+  fd->footer_index_num = 0;
+}
+
+blender::Span<BlendFooterIndexEntry> blo_footer_index_get(const FileData *fd)
+{
+  return {fd->footer_index, fd->footer_index_num};
+}
+
+static int read_file_subversion(const FileData *fd, const BHead *bhead)
+{
+  BLI_assert(bhead->code == BLO_CODE_GLOB);
+  /* Before this, the subversion didn't exist in 'FileGlobal' so the subversion
+   * value isn't accessible for the purpose of DNA versioning in this case. */
+  if (fd->fileversion <= 242) {
+    return 0;
+  }
+  /* We can't use read_global because this needs 'DNA1' to be decoded,
+   * however the first 4 chars are _always_ the subversion. */
+  const FileGlobal *fg = reinterpret_cast<const FileGlobal *>(&bhead[1]);
+  BLI_STATIC_ASSERT(offsetof(FileGlobal, subvstr) == 0, "Must be first: subvstr")
+  char num[5];
+  memcpy(num, fg->subvstr, 4);
+  num[4] = 0;
+  return atoi(num);
+}
+
+static bool read_file_dna_block(FileData *fd,
+                                const BHead *bhead,
+                                const int subversion,
+                                const char **r_error_message)
+{
+  BLI_assert(bhead->code == BLO_CODE_DNA1);
+  const bool do_endian_swap = (fd->flags & FD_FLAGS_SWITCH_ENDIAN) != 0;
+  const bool do_alias = false; /* Postpone until after #blo_do_versions_dna runs. */
+  fd->filesdna = DNA_sdna_from_data(
+      &bhead[1], bhead->len, do_endian_swap, true, do_alias, r_error_message);
+  if (fd->filesdna == nullptr) {
+    return false;
+  }
+  blo_do_versions_dna(fd->filesdna, fd->fileversion, subversion);
+  /* Allow aliased lookups (must be after version patching DNA). */
+  DNA_sdna_alias_data_ensure_structs_map(fd->filesdna);
+
+  fd->compflags = DNA_struct_get_compareflags(fd->filesdna, fd->memsdna);
+  fd->reconstruct_info = DNA_reconstruct_info_create(fd->filesdna, fd->memsdna, fd->compflags);
+  /* used to retrieve ID names from (bhead+1) */
+  fd->id_name_offset = DNA_struct_member_offset_by_name_with_alias(
+      fd->filesdna, "ID", "char", "name[]");
+  BLI_assert(fd->id_name_offset != -1);
+  fd->id_asset_data_offset = DNA_struct_member_offset_by_name_with_alias(
+      fd->filesdna, "ID", "AssetMetaData", "*asset_data");
+
+  return true;
+}
+
+/**
+ * Read the blocks needed to decode the DNA using the offsets from the footer index, avoiding
+ * to read the headers of all blocks before them.
+ *
+ * \return false when the index doesn't match the file.
+ */
+static bool read_file_dna_blocks_from_footer_index(FileData *fd,
+                                                   BHead **r_glob_bhead,
+                                                   BHead **r_dna_bhead)
+{
+  BHead *glob_bhead = nullptr;
+  BHead *dna_bhead = nullptr;
+  for (const BlendFooterIndexEntry &entry : blo_footer_index_get(fd)) {
+    if (entry.code == BLO_CODE_GLOB && glob_bhead == nullptr) {
+      glob_bhead = blo_bhead_read_at(fd, entry.offset);
+    }
+    else if (entry.code == BLO_CODE_DNA1 && dna_bhead == nullptr) {
+      dna_bhead = blo_bhead_read_at(fd, entry.offset);
+    }
+  }
+
+  if (glob_bhead && glob_bhead->code == BLO_CODE_GLOB && dna_bhead &&
+      dna_bhead->code == BLO_CODE_DNA1)
+  {
+    *r_glob_bhead = glob_bhead;
+    *r_dna_bhead = dna_bhead;
+    return true;
+  }
+
+  if (glob_bhead) {
+    blo_bhead_free_detached(glob_bhead);
+  }
+  if (dna_bhead) {
+    blo_bhead_free_detached(dna_bhead);
+  }
+  return false;
+}
+
 /**
  * \return Success if the file is read correctly, else set \a r_error_message.
  */
@@ -966,46 +1157,26 @@ static bool read_file_dna(FileData *fd, const char **r_error_message)
   BHead *bhead;
   int subversion = 0;
 
+  read_file_footer_index(fd);
+  if (fd->footer_index) {
+    BHead *glob_bhead, *dna_bhead;
+    if (read_file_dna_blocks_from_footer_index(fd, &glob_bhead, &dna_bhead)) {
+      subversion = read_file_subversion(fd, glob_bhead);
+      const bool ok = read_file_dna_block(fd, dna_bhead, subversion, r_error_message);
+      blo_bhead_free_detached(glob_bhead);
+      blo_bhead_free_detached(dna_bhead);
+      return ok;
+    }
+    /* The file was modified after it was written, ignore the index. */
+    footer_index_free(fd);
+  }
+
   for (bhead = blo_bhead_first(fd); bhead; bhead = blo_bhead_next(fd, bhead)) {
     if (bhead->code == BLO_CODE_GLOB) {
-      /* Before this, the subversion didn't exist in 'FileGlobal' so the subversion
-       * value isn't accessible for the purpose of DNA versioning in this case. */
-      if (fd->fileversion <= 242) {
-        continue;
-      }
-      /* We can't use read_global because this needs 'DNA1' to be decoded,
-       * however the first 4 chars are _always_ the subversion. */
-      FileGlobal *fg = reinterpret_cast<FileGlobal *>(&bhead[1]);
-      BLI_STATIC_ASSERT(offsetof(FileGlobal, subvstr) == 0, "Must be first: subvstr")
-      char num[5];
-      memcpy(num, fg->subvstr, 4);
-      num[4] = 0;
-      subversion = atoi(num);
+      subversion = read_file_subversion(fd, bhead);
     }
     else if (bhead->code == BLO_CODE_DNA1) {
-      const bool do_endian_swap = (fd->flags & FD_FLAGS_SWITCH_ENDIAN) != 0;
-      const bool do_alias = false; /* Postpone until after #blo_do_versions_dna runs. */
-      fd->filesdna = DNA_sdna_from_data(
-          &bhead[1], bhead->len, do_endian_swap, true, do_alias, r_error_message);
-      if (fd->filesdna) {
-        blo_do_versions_dna(fd->filesdna, fd->fileversion, subversion);
-        /* Allow aliased lookups (must be after version patching DNA). */
-        DNA_sdna_alias_data_ensure_structs_map(fd->filesdna);
-
-        fd->compflags = DNA_struct_get_compareflags(fd->filesdna, fd->memsdna);
-        fd->reconstruct_info = DNA_reconstruct_info_create(
-            fd->filesdna, fd->memsdna, fd->compflags);
-        /* used to retrieve ID names from (bhead+1) */
-        fd->id_name_offset = DNA_struct_member_offset_by_name_with_alias(
-            fd->filesdna, "ID", "char", "name[]");
-        BLI_assert(fd->id_name_offset != -1);
-        fd->id_asset_data_offset = DNA_struct_member_offset_by_name_with_alias(
-            fd->filesdna, "ID", "AssetMetaData", "*asset_data");
-
-        return true;
-      }
-
-      return false;
+      return read_file_dna_block(fd, bhead, subversion, r_error_message);
     }
     else if (bhead->code == BLO_CODE_ENDB) {
       break;
@@ -1058,6 +1229,194 @@ static int *read_file_thumbnail(FileData *fd)
 
 /** \} */
 
+/* -------------------------------------------------------------------- */
+/** \name Shared Memory Arrays
+ *
+ * With #G_FLAG_READ_SHARED_MEMORY, large arrays of trivial data are moved into POSIX shared
+ * memory segments named after a hash of their content. Other processes reading the same data
+ * (e.g. render farm workers loading the same file) map the existing segment instead of keeping
+ * their own copy, so the pages are only stored once per machine.
+ *
+ * Segments are mapped copy-on-write, so modifying the data in place is still valid and only
+ * makes the modified pages private to the process. A segment is unlinked when the process that
+ * created it frees the data, mappings in other processes stay valid.
+ * \{ */
+
+/** Smaller arrays aren't worth a segment (and its page size rounding). */
+#define SHARED_MEMORY_ARRAY_MIN_SIZE (1 << 16)
+
+#ifndef WIN32
+
+class SharedMemoryArraySharingInfo : public blender::ImplicitSharingInfo {
+ public:
+  void *data;
+  size_t size;
+  char name[32];
+  /** Set when this process created the segment, it's unlinked again when the data is freed. */
+  bool is_owner;
+
+ private:
+  void delete_self_with_data() override
+  {
+    this->delete_data_only();
+    MEM_delete(this);
+  }
+
+  void delete_data_only() override
+  {
+    munmap(data, size);
+    if (is_owner) {
+      shm_unlink(name);
+    }
+    data = nullptr;
+  }
+};
+
+/** Per #FileData state, see #BLO_read_shared_memory_array. */
+struct SharedMemoryArrays {
+  /** Data read from the file that was already replaced by a mapping. */
+  blender::Map<const void *, const blender::ImplicitSharingInfo *> mapping_by_data;
+  /**
+   * Users of the replaced data, kept until the data-block is read to avoid freeing data that's
+   * still referenced by read code looking it up by its address.
+   */
+  blender::Vector<const blender::ImplicitSharingInfo *> replaced;
+};
+
+static void *shared_memory_map(const int fd, const size_t size)
+{
+  void *data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+  return (data == MAP_FAILED) ? nullptr : data;
+}
+
+/**
+ * Map an existing segment with the same content, or publish the data in a new one.
+ * \return The sharing info of the mapped data or null when shared memory can't be used.
+ */
+static SharedMemoryArraySharingInfo *shared_memory_array_map(const void *data, const size_t size)
+{
+  SharedMemoryArraySharingInfo *sharing_info = MEM_new<SharedMemoryArraySharingInfo>(__func__);
+  const uint64_t hash = XXH3_64bits(data, size);
+  /* Keep within the 31 characters macOS allows for shared memory names. */
+  SNPRINTF(sharing_info->name, "/blo%016" PRIx64 "%zx", hash, size);
+  sharing_info->size = size;
+  sharing_info->is_owner = false;
+  sharing_info->data = nullptr;
+
+  int fd = shm_open(sharing_info->name, O_RDONLY, 0);
+  if (fd != -1) {
+    struct stat st;
+    if (fstat(fd, &st) == 0 && size_t(st.st_size) == size) {
+      sharing_info->data = shared_memory_map(fd, size);
+    }
+    close(fd);
+    /* The hash may collide and the segment may still be written by its owner, only use it when
+     * the content matches. */
+    if (sharing_info->data && memcmp(sharing_info->data, data, size) != 0) {
+      munmap(sharing_info->data, size);
+      sharing_info->data = nullptr;
+    }
+  }
+  else if ((fd = shm_open(sharing_info->name, O_RDWR | O_CREAT | O_EXCL, 0644)) != -1) {
+    bool ok = (ftruncate(fd, size) == 0);
+    if (ok) {
+      void *shared_data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+      if (shared_data != MAP_FAILED) {
+        memcpy(shared_data, data, size);
+        munmap(shared_data, size);
+        sharing_info->data = shared_memory_map(fd, size);
+      }
+    }
+    close(fd);
+    if (sharing_info->data) {
+      sharing_info->is_owner = true;
+    }
+    else {
+      shm_unlink(sharing_info->name);
+    }
+  }
+
+  if (sharing_info->data == nullptr) {
+    sharing_info->remove_user_and_delete_if_last();
+    return nullptr;
+  }
+  return sharing_info;
+}
+
+#endif /* !WIN32 */
+
+void BLO_read_shared_memory_array(BlendDataReader *reader,
+                                  void **data,
+                                  const size_t size,
+                                  const blender::ImplicitSharingInfo **sharing_info)
+{
+#ifdef WIN32
+  UNUSED_VARS(reader, data, size, sharing_info);
+#else
+  if ((G.f & G_FLAG_READ_SHARED_MEMORY) == 0 || BLO_read_data_is_undo(reader)) {
+    return;
+  }
+  if (*data == nullptr || *sharing_info == nullptr || size < SHARED_MEMORY_ARRAY_MIN_SIZE) {
+    return;
+  }
+
+  FileData *fd = reader->fd;
+  if (fd->shared_memory_arrays == nullptr) {
+    fd->shared_memory_arrays = MEM_new<SharedMemoryArrays>(__func__);
+  }
+  SharedMemoryArrays &arrays = *fd->shared_memory_arrays;
+
+  const blender::ImplicitSharingInfo *mapping = arrays.mapping_by_data.lookup_default(*data,
+                                                                                     nullptr);
+  if (mapping) {
+    mapping->add_user();
+  }
+  else {
+    mapping = shared_memory_array_map(*data, size);
+    if (mapping == nullptr) {
+      return;
+    }
+    arrays.mapping_by_data.add(*data, mapping);
+  }
+
+  arrays.replaced.append(*sharing_info);
+  *sharing_info = mapping;
+  *data = static_cast<const SharedMemoryArraySharingInfo *>(mapping)->data;
+#endif
+}
+
+/** Free the data replaced by mappings while reading the current data-block. */
+static void shared_memory_arrays_clear(FileData *fd)
+{
+#ifndef WIN32
+  if (fd->shared_memory_arrays == nullptr) {
+    return;
+  }
+  for (const blender::ImplicitSharingInfo *sharing_info : fd->shared_memory_arrays->replaced) {
+    sharing_info->remove_user_and_delete_if_last();
+  }
+  fd->shared_memory_arrays->replaced.clear();
+  fd->shared_memory_arrays->mapping_by_data.clear();
+#else
+  UNUSED_VARS(fd);
+#endif
+}
+
+static void shared_memory_arrays_free(FileData *fd)
+{
+#ifndef WIN32
+  if (fd->shared_memory_arrays) {
+    shared_memory_arrays_clear(fd);
+    MEM_delete(fd->shared_memory_arrays);
+    fd->shared_memory_arrays = nullptr;
+  }
+#else
+  UNUSED_VARS(fd);
+#endif
+}
+
+/** \} */
+
 /* -------------------------------------------------------------------- */
 /** \name File Data API
  * \{ */
@@ -1361,6 +1720,8 @@ void blo_filedata_free(FileData *fd)
       BKE_main_idmap_destroy(fd->new_idmap_uid);
     }
     blo_cache_storage_end(fd);
+    shared_memory_arrays_free(fd);
+    footer_index_free(fd);
     if (fd->bheadmap) {
       MEM_freeN(fd->bheadmap);
     }
@@ -1805,16 +2166,23 @@ static void *read_struct(FileData *fd, BHead *bh, const char *blockname)
 
     if (fd->compflags[bh->SDNAnr] != SDNA_CMP_REMOVED) {
       if (fd->compflags[bh->SDNAnr] == SDNA_CMP_NOT_EQUAL) {
+        const void *data = (bh + 1);
 #ifdef USE_BHEAD_READ_ON_DEMAND
         if (BHEADN_FROM_BHEAD(bh)->has_data == false) {
-          bh = blo_bhead_read_full(fd, bh);
-          if (UNLIKELY(bh == nullptr)) {
-            fd->flags &= ~FD_FLAGS_FILE_OK;
-            return nullptr;
+          /* Reconstruction only reads the old data, so reference it directly from the
+           * memory-mapped file when possible instead of making a temporary copy. */
+          data = blo_bhead_peek_data(fd, bh);
+          if (data == nullptr) {
+            bh = blo_bhead_read_full(fd, bh);
+            if (UNLIKELY(bh == nullptr)) {
+              fd->flags &= ~FD_FLAGS_FILE_OK;
+              return nullptr;
+            }
+            data = (bh + 1);
           }
         }
 #endif
-        temp = DNA_struct_reconstruct(fd->reconstruct_info, bh->SDNAnr, bh->nr, (bh + 1));
+        temp = DNA_struct_reconstruct(fd->reconstruct_info, bh->SDNAnr, bh->nr, data);
       }
       else {
         /* SDNA_CMP_EQUAL */
@@ -2974,6 +3342,7 @@ static BHead *read_libblock(FileData *fd,
   bhead = read_data_into_datamap(fd, bhead, allocname);
   const bool success = direct_link_id(fd, main, id_tag, id, id_old);
   oldnewmap_clear(fd->datamap);
+  shared_memory_arrays_clear(fd);
 
   if (!success) {
     /* XXX This is probably working OK currently given the very limited scope of that flag.
@@ -3805,6 +4174,13 @@ static int verg_bheadsort(const void *v1, const void *v2)
   return 0;
 }
 
+/**
+ * Map old ID addresses to their #BHead, only used to find the IDs referenced by linked data.
+ *
+ * Only ID blocks (including placeholders for IDs from other libraries) are added,
+ * large library files can contain millions of data blocks which would make this map
+ * a lot more expensive to build, while only a small part of the IDs typically gets linked.
+ */
 static void sort_bhead_old_map(FileData *fd)
 {
   BHead *bhead;
@@ -3812,7 +4188,9 @@ static void sort_bhead_old_map(FileData *fd)
   int tot = 0;
 
   for (bhead = blo_bhead_first(fd); bhead; bhead = blo_bhead_next(fd, bhead)) {
-    tot++;
+    if (blo_bhead_is_id(bhead)) {
+      tot++;
+    }
   }
 
   fd->tot_bheadmap = tot;
@@ -3823,9 +4201,12 @@ static void sort_bhead_old_map(FileData *fd)
   bhs = fd->bheadmap = static_cast<BHeadSort *>(
       MEM_malloc_arrayN(tot, sizeof(BHeadSort), "BHeadSort"));
 
-  for (bhead = blo_bhead_first(fd); bhead; bhead = blo_bhead_next(fd, bhead), bhs++) {
-    bhs->bhead = bhead;
-    bhs->old = bhead->old;
+  for (bhead = blo_bhead_first(fd); bhead; bhead = blo_bhead_next(fd, bhead)) {
+    if (blo_bhead_is_id(bhead)) {
+      bhs->bhead = bhead;
+      bhs->old = bhead->old;
+      bhs++;
+    }
   }
 
   qsort(fd->bheadmap, tot, sizeof(BHeadSort), verg_bheadsort);
@@ -16,6 +16,7 @@
 #endif
 
 #include "BLI_filereader.h"
+#include "BLI_span.hh"
 #include "DNA_sdna_types.h"
 #include "DNA_space_types.h"
 #include "DNA_windowmanager_types.h" /* for eReportType */
@@ -23,6 +24,7 @@
 #include "BLO_readfile.hh"
 
 struct BlendFileData;
+struct BlendFooterIndexEntry;
 struct BlendFileReadParams;
 struct BlendFileReadReport;
 struct BLOCacheStorage;
@@ -35,6 +37,7 @@ struct MemFile;
 struct Object;
 struct OldNewMap;
 struct ReportList;
+struct SharedMemoryArrays;
 struct UserDef;
 
 enum eFileDataFlag {
@@ -113,6 +116,11 @@ struct FileData {
 
   OldNewMap *packedmap;
   BLOCacheStorage *cache_storage;
+  /** See #BLO_read_shared_memory_array, only allocated when used. */
+  SharedMemoryArrays *shared_memory_arrays;
+  /** See #BlendFooterIndexEntry, null when the file has no index that can be used. */
+  BlendFooterIndexEntry *footer_index;
+  int footer_index_num;
 
   BHeadSort *bheadmap;
   int tot_bheadmap;
@@ -184,6 +192,17 @@ BHead *blo_bhead_first(FileData *fd);
 BHead *blo_bhead_next(FileData *fd, BHead *thisblock);
 BHead *blo_bhead_prev(FileData *fd, BHead *thisblock);
 
+/**
+ * Entries of the footer index of the file, empty when it has none (see #BlendFooterIndexEntry).
+ */
+blender::Span<BlendFooterIndexEntry> blo_footer_index_get(const FileData *fd);
+/**
+ * Read the block at \a offset (see #BlendFooterIndexEntry.offset) including its data, without
+ * adding it to the blocks read so far. Free with #blo_bhead_free_detached.
+ */
+BHead *blo_bhead_read_at(FileData *fd, uint64_t offset);
+void blo_bhead_free_detached(BHead *bhead);
+
 /**
  * Warning! Caller's responsibility to ensure given bhead **is** an ID one!
  */
@@ -34,10 +34,18 @@
 #include "BKE_main.hh"
 #include "BKE_undo_system.hh"
 
+#include <xxhash.h>
+
 #include "BLI_strict_flags.h" /* Keep last. */
 
 /* **************** support for memory-write, for undo buffers *************** */
 
+/**
+ * Minimum size of chunks that are looked up by content when they don't match the reference chunk
+ * at the same position. Smaller chunks are typically buffered small structs which rarely move.
+ */
+#define MEMFILE_MOVED_CHUNK_MIN_SIZE (1 << 12)
+
 void BLO_memfile_free(MemFile *memfile)
 {
   while (MemFileChunk *chunk = static_cast<MemFileChunk *>(BLI_pophead(&memfile->chunks))) {
@@ -106,6 +114,7 @@ void BLO_memfile_write_init(MemFileWriteData *mem_data,
   mem_data->reference_current_chunk = reference_memfile ? static_cast<MemFileChunk *>(
                                                               reference_memfile->chunks.first) :
                                                           nullptr;
+  mem_data->id_chunks_session_uid = MAIN_ID_SESSION_UID_UNSET;
 
   /* If we have a reference memfile, we generate a mapping between the session_uid's of the
    * IDs stored in that previous undo step, and its first matching memchunk. This will allow
@@ -126,6 +135,59 @@ void BLO_memfile_write_init(MemFileWriteData *mem_data,
 void BLO_memfile_write_finalize(MemFileWriteData *mem_data)
 {
   mem_data->id_session_uid_mapping.clear_and_shrink();
+  mem_data->id_chunks_by_hash.clear_and_shrink();
+}
+
+static uint64_t memfile_chunk_hash_ensure(MemFileChunk *chunk)
+{
+  if (!chunk->has_hash) {
+    chunk->hash = XXH3_64bits(chunk->buf, chunk->size);
+    chunk->has_hash = true;
+  }
+  return chunk->hash;
+}
+
+/**
+ * Find a reference chunk of the ID currently being written with the same content as \a buf.
+ * This keeps memory shared when data moved within the ID, e.g. when an array changed size,
+ * the chunks of all arrays written after it would not match positionally anymore.
+ */
+static MemFileChunk *memfile_chunk_find_moved(MemFileWriteData *mem_data,
+                                              MemFileChunk *curchunk,
+                                              const char *buf,
+                                              const size_t size)
+{
+  const uint session_uid = mem_data->current_id_session_uid;
+  if (size < MEMFILE_MOVED_CHUNK_MIN_SIZE || session_uid == MAIN_ID_SESSION_UID_UNSET) {
+    return nullptr;
+  }
+
+  if (mem_data->id_chunks_session_uid != session_uid) {
+    mem_data->id_chunks_session_uid = session_uid;
+    mem_data->id_chunks_by_hash.clear();
+    for (MemFileChunk *ref = mem_data->id_session_uid_mapping.lookup_default(session_uid,
+                                                                             nullptr);
+         ref != nullptr && ref->id_session_uid == session_uid;
+         ref = static_cast<MemFileChunk *>(ref->next))
+    {
+      if (ref->size >= MEMFILE_MOVED_CHUNK_MIN_SIZE) {
+        mem_data->id_chunks_by_hash.add(memfile_chunk_hash_ensure(ref), ref);
+      }
+    }
+  }
+  if (mem_data->id_chunks_by_hash.is_empty()) {
+    return nullptr;
+  }
+
+  /* Also useful for the next undo step, where this chunk is used as reference. */
+  curchunk->hash = XXH3_64bits(buf, size);
+  curchunk->has_hash = true;
+
+  MemFileChunk *ref = mem_data->id_chunks_by_hash.lookup_default(curchunk->hash, nullptr);
+  if (ref != nullptr && ref->size == size && memcmp(ref->buf, buf, size) == 0) {
+    return ref;
+  }
+  return nullptr;
 }
 
 void BLO_memfile_chunk_add(MemFileWriteData *mem_data, const char *buf, size_t size)
@@ -138,6 +200,9 @@ void BLO_memfile_chunk_add(MemFileWriteData *mem_data, const char *buf, size_t s
   curchunk->size = size;
   curchunk->buf = nullptr;
   curchunk->is_identical = false;
+  curchunk->is_moved = false;
+  curchunk->has_hash = false;
+  curchunk->hash = 0;
   /* This is unsafe in the sense that an app handler or other code that does not
    * perform an undo push may make changes after the last undo push that
    * will then not be undo. Though it's not entirely clear that is wrong behavior. */
@@ -158,6 +223,16 @@ void BLO_memfile_chunk_add(MemFileWriteData *mem_data, const char *buf, size_t s
     *compchunk_step = static_cast<MemFileChunk *>(compchunk->next);
   }
 
+  if (curchunk->buf == nullptr) {
+    if (MemFileChunk *movedchunk = memfile_chunk_find_moved(mem_data, curchunk, buf, size)) {
+      curchunk->buf = movedchunk->buf;
+      curchunk->is_identical = true;
+      curchunk->is_moved = true;
+      /* Following data most likely matches the chunks following the moved one. */
+      *compchunk_step = static_cast<MemFileChunk *>(movedchunk->next);
+    }
+  }
+
   /* not equal... */
   if (curchunk->buf == nullptr) {
     char *buf_new = static_cast<char *>(MEM_mallocN(size, "Chunk buffer"));
@@ -251,8 +326,9 @@ static int64_t undo_read(FileReader *reader, void *buffer, size_t size)
        * step. this is fine in redo case, but not in undo case, where we need an extra flag
        * defined when saving the next (future) step after the one we want to restore, as we are
        * supposed to 'come from' that future undo step, and not the one before current one. */
-      undo->memchunk_identical &= undo->undo_direction == STEP_REDO ? chunk->is_identical :
-                                                                      chunk->is_identical_future;
+      undo->memchunk_identical &= undo->undo_direction == STEP_REDO ?
+                                       (chunk->is_identical && !chunk->is_moved) :
+                                       chunk->is_identical_future;
     } while (totread < size);
 
     return int64_t(totread);
@@ -2063,16 +2063,16 @@ static void versioning_node_hue_correct_set_wrappng(bNodeTree *ntree)
 void blo_do_versions_400(FileData *fd, Library * /*lib*/, Main *bmain)
 {
   if (!MAIN_VERSION_FILE_ATLEAST(bmain, 400, 1)) {
-    LISTBASE_FOREACH (Mesh *, mesh, &bmain->meshes) {
-      version_mesh_legacy_to_struct_of_array_format(*mesh);
-    }
+    version_parallel_foreach_id(bmain->meshes, [](ID &id) {
+      version_mesh_legacy_to_struct_of_array_format(reinterpret_cast<Mesh &>(id));
+    });
     version_movieclips_legacy_camera_object(bmain);
   }
 
   if (!MAIN_VERSION_FILE_ATLEAST(bmain, 400, 2)) {
-    LISTBASE_FOREACH (Mesh *, mesh, &bmain->meshes) {
-      BKE_mesh_legacy_bevel_weight_to_generic(mesh);
-    }
+    version_parallel_foreach_id(bmain->meshes, [](ID &id) {
+      BKE_mesh_legacy_bevel_weight_to_generic(reinterpret_cast<Mesh *>(&id));
+    });
   }
 
   /* 400 4 did not require any do_version here. */
@@ -2102,7 +2102,9 @@ void blo_do_versions_400(FileData *fd, Library * /*lib*/, Main *bmain)
   }
 
   if (!MAIN_VERSION_FILE_ATLEAST(bmain, 400, 7)) {
-    LISTBASE_FOREACH (Mesh *, mesh, &bmain->meshes) {
+    /* Handles all meshes (and the node trees & modifiers referring to the attribute) at once,
+     * there is no need to call it for every mesh. */
+    if (!BLI_listbase_is_empty(&bmain->meshes)) {
       version_mesh_crease_generic(*bmain);
     }
   }
@@ -3182,6 +3184,13 @@ void blo_do_versions_400(FileData *fd, Library * /*lib*/, Main *bmain)
     }
   }
 
+  if (!MAIN_VERSION_FILE_ATLEAST(bmain, 402, 20)) {
+    LISTBASE_FOREACH (Object *, ob, &bmain->objects) {
+      /* The flag might have been set by very old files which used it for base flags. */
+      ob->flag &= ~OB_FLAG_USE_PLAYBACK_CACHE;
+    }
+  }
+
   /**
    * Always bump subversion in BKE_blender_version.h when adding versioning
    * code here, and wrap it inside a MAIN_VERSION_FILE_ATLEAST check.
@@ -17,6 +17,8 @@
 #include "BLI_map.hh"
 #include "BLI_string.h"
 #include "BLI_string_ref.hh"
+#include "BLI_task.hh"
+#include "BLI_vector.hh"
 
 #include "BKE_animsys.h"
 #include "BKE_grease_pencil_legacy_convert.hh"
@@ -82,6 +84,20 @@ ARegion *do_versions_ensure_region(ListBase *regionbase,
   return new_region;
 }
 
+void version_parallel_foreach_id(ListBase &id_list, FunctionRef<void(ID &id)> fn)
+{
+  blender::Vector<ID *> ids;
+  LISTBASE_FOREACH (ID *, id, &id_list) {
+    ids.append(id);
+  }
+  /* IDs can contain large amounts of data, so use the smallest grain size. */
+  blender::threading::parallel_for(ids.index_range(), 1, [&](const blender::IndexRange range) {
+    for (const int64_t i : range) {
+      fn(*ids[i]);
+    }
+  });
+}
+
 ID *do_versions_rename_id(Main *bmain,
                           const short id_type,
                           const char *name_src,
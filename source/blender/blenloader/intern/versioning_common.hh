@@ -49,6 +49,15 @@ ARegion *do_versions_ensure_region(ListBase *regionbase,
  */
 ID *do_versions_rename_id(Main *bmain, short id_type, const char *name_src, const char *name_dst);
 
+/**
+ * Run \a fn for every ID in \a id_list, in parallel.
+ *
+ * Only use this for versioning that is local to a single ID (e.g. converting the ID's own
+ * data arrays), it must not access other IDs, the #Main database or any other shared state.
+ * Versioning that relates multiple IDs has to stay serial.
+ */
+void version_parallel_foreach_id(ListBase &id_list, FunctionRef<void(ID &id)> fn);
+
 bool version_node_socket_is_used(bNodeSocket *sock);
 
 void version_node_socket_name(bNodeTree *ntree,
@@ -87,6 +87,7 @@
 #include "DNA_key_types.h"
 #include "DNA_sdna_types.h"
 
+#include "BLI_array.hh"
 #include "BLI_bitmap.h"
 #include "BLI_blenlib.h"
 #include "BLI_endian_defines.h"
@@ -97,6 +98,8 @@
 #include "BLI_math_base.h"
 #include "BLI_mempool.h"
 #include "BLI_threads.h"
+#include "BLI_trace.hh"
+#include "BLI_vector.hh"
 
 #include "MEM_guardedalloc.h" /* MEM_freeN */
 
@@ -125,6 +128,7 @@
 
 #include "readfile.hh"
 
+#include <xxhash.h>
 #include <zstd.h>
 
 /* Make preferences read-only. */
@@ -388,12 +392,51 @@ bool ZstdWriteWrap::write(const void *buf, size_t buf_len)
   return true;
 }
 
+struct BlendFileWriteBuffer {
+  blender::Vector<blender::Array<char, 0>> chunks;
+};
+
+/**
+ * Keeps the written file in memory, see #BLO_write_file_to_buffer.
+ */
+class MemoryWriteWrap : public WriteWrap {
+ public:
+  MemoryWriteWrap(BlendFileWriteBuffer &buffer) : buffer(buffer) {}
+
+  bool open(const char * /*filepath*/) override
+  {
+    return true;
+  }
+  bool close() override
+  {
+    return true;
+  }
+  bool write(const void *buf, size_t buf_len) override
+  {
+    buffer.chunks.append_as(buf_len);
+    memcpy(buffer.chunks.last().data(), buf, buf_len);
+    return true;
+  }
+
+ private:
+  BlendFileWriteBuffer &buffer;
+};
+
 /** \} */
 
 /* -------------------------------------------------------------------- */
 /** \name Write Data Type & Functions
  * \{ */
 
+/** An entry of the block hash index, see #BLO_BLOCK_HASH_INDEX_EXT. */
+struct BlockHash {
+  /** Offset of the #BHead in the (uncompressed) file. */
+  size_t offset;
+  int code;
+  int len;
+  uint64_t hash;
+};
+
 struct WriteData {
   const SDNA *sdna;
 
@@ -422,6 +465,23 @@ struct WriteData {
   /** When true, write to #WriteData.current, could also call 'is_undo'. */
   bool use_memfile;
 
+  /** Number of bytes written so far (the offset of the next block). */
+  size_t offset;
+
+  /** Only used when writing a block hash index, see #BlendFileWriteParams. */
+  struct {
+    bool use;
+    blender::Vector<BlockHash> blocks;
+  } block_hash;
+
+  /** Only used when writing files (not undo), see #BlendFooterIndexEntry. */
+  struct {
+    bool use;
+    /** SDNA index of #PreviewImage, to find the previews of ID's. */
+    int preview_image_nr;
+    blender::Vector<BlendFooterIndexEntry> entries;
+  } footer_index;
+
   /**
    * Wrap writing, so we can use zstd or
    * other compression types later, see: G_FILE_COMPRESS
@@ -529,6 +589,8 @@ static void mywrite(WriteData *wd, const void *adr, size_t len)
   wd->write_len += len;
 #endif
 
+  wd->offset += len;
+
   if (wd->buffer.buf == nullptr) {
     writedata_do_write(wd, adr, len);
   }
@@ -652,6 +714,72 @@ static void mywrite_id_end(WriteData *wd, ID * /*id*/)
   }
 }
 
+/**
+ * Store the content hash of a block which is about to be written.
+ *
+ * The hash only covers the data (not the #BHead), since the old memory address
+ * stored in the header typically changes between saves even when the data didn't.
+ */
+static void mywrite_block_hash(WriteData *wd, const BHead *bh, const void *data)
+{
+  if (!wd->block_hash.use) {
+    return;
+  }
+  BlockHash block;
+  block.offset = wd->offset;
+  block.code = bh->code;
+  block.len = bh->len;
+  block.hash = XXH3_64bits(data, size_t(bh->len));
+  wd->block_hash.blocks.append(block);
+}
+
+/**
+ * Add blocks which are about to be written to the footer index.
+ */
+static void mywrite_footer_index(WriteData *wd, const BHead *bh, const void *data)
+{
+  if (!wd->footer_index.use) {
+    return;
+  }
+  blender::Vector<BlendFooterIndexEntry> &entries = wd->footer_index.entries;
+  if (bh->code == BLO_CODE_DATA) {
+    /* Like #BLO_blendhandle_get_preview_for_id, use the first preview following the ID. */
+    if (bh->SDNAnr == wd->footer_index.preview_image_nr && !entries.is_empty() &&
+        entries.last().name[0] != '\0' && entries.last().preview_offset == 0)
+    {
+      entries.last().preview_offset = wd->offset;
+    }
+    return;
+  }
+
+  BlendFooterIndexEntry entry = {};
+  entry.offset = wd->offset;
+  entry.code = bh->code;
+  if (bh->code <= 0xFFFF && BKE_idtype_idcode_is_valid(short(bh->code))) {
+    const ID *id = static_cast<const ID *>(data);
+    STRNCPY(entry.name, id->name);
+    if (id->asset_data) {
+      entry.flag |= BLEND_FOOTER_INDEX_ID_IS_ASSET;
+    }
+  }
+  entries.append(entry);
+}
+
+static void mywrite_footer_index_end(WriteData *wd)
+{
+  if (!wd->footer_index.use) {
+    return;
+  }
+  const blender::Vector<BlendFooterIndexEntry> &entries = wd->footer_index.entries;
+  if (!entries.is_empty()) {
+    mywrite(wd, entries.data(), size_t(entries.size()) * sizeof(BlendFooterIndexEntry));
+  }
+  BlendFooterIndexTail tail = {};
+  tail.entries_num = uint64_t(entries.size());
+  memcpy(tail.magic, BLEND_FOOTER_INDEX_MAGIC, sizeof(tail.magic));
+  mywrite(wd, &tail, sizeof(tail));
+}
+
 /** \} */
 
 /* -------------------------------------------------------------------- */
@@ -683,6 +811,8 @@ static void writestruct_at_address_nr(
     return;
   }
 
+  mywrite_block_hash(wd, &bh, data);
+  mywrite_footer_index(wd, &bh, data);
   mywrite(wd, &bh, sizeof(BHead));
   mywrite(wd, data, size_t(bh.len));
 }
@@ -719,6 +849,8 @@ static void writedata(WriteData *wd, int filecode, size_t len, const void *adr)
   bh.SDNAnr = 0;
   bh.len = int(len);
 
+  mywrite_block_hash(wd, &bh, adr);
+  mywrite_footer_index(wd, &bh, adr);
   mywrite(wd, &bh, sizeof(BHead));
   mywrite(wd, adr, len);
 }
@@ -1201,13 +1333,17 @@ static int write_id_direct_linked_data_process_cb(LibraryIDLinkCallbackData *cb_
  * \param compare: Previous memory file (can be nullptr).
  * \param current: The current memory file (can be nullptr).
  */
+/**
+ * \param r_block_hashes: When not null, filled with the content hashes of all written blocks.
+ */
 static bool write_file_handle(Main *mainvar,
                               WriteWrap *ww,
                               MemFile *compare,
                               MemFile *current,
                               int write_flags,
                               bool use_userdef,
-                              const BlendThumbnail *thumb)
+                              const BlendThumbnail *thumb,
+                              blender::Vector<BlockHash> *r_block_hashes)
 {
   BHead bhead;
   ListBase mainlist;
@@ -1215,6 +1351,9 @@ static bool write_file_handle(Main *mainvar,
   WriteData *wd;
 
   wd = mywrite_begin(ww, compare, current);
+  wd->block_hash.use = (r_block_hashes != nullptr);
+  wd->footer_index.use = !wd->use_memfile;
+  wd->footer_index.preview_image_nr = DNA_struct_find_with_alias(wd->sdna, "PreviewImage");
   BlendWriter writer = {wd};
 
   /* Clear 'directly linked' flag for all linked data, these are not necessarily valid/up-to-date
@@ -1393,11 +1532,66 @@ static bool write_file_handle(Main *mainvar,
   bhead.code = BLO_CODE_ENDB;
   mywrite(wd, &bhead, sizeof(BHead));
 
+  mywrite_footer_index_end(wd);
+
   blo_join_main(&mainlist);
 
+  if (r_block_hashes) {
+    *r_block_hashes = std::move(wd->block_hash.blocks);
+  }
+
   return mywrite_end(wd);
 }
 
+/**
+ * Write the block hash index next to `filepath`, see #BLO_BLOCK_HASH_INDEX_EXT.
+ * \return True on success.
+ */
+static bool write_block_hash_index(const char *filepath,
+                                   const blender::Span<BlockHash> blocks,
+                                   ReportList *reports)
+{
+  char index_filepath[FILE_MAX + sizeof(BLO_BLOCK_HASH_INDEX_EXT)];
+  char index_filepath_temp[sizeof(index_filepath) + 1];
+  SNPRINTF(index_filepath, "%s" BLO_BLOCK_HASH_INDEX_EXT, filepath);
+  SNPRINTF(index_filepath_temp, "%s@", index_filepath);
+
+  FILE *file = BLI_fopen(index_filepath_temp, "wb");
+  if (file == nullptr) {
+    BKE_reportf(reports,
+                RPT_WARNING,
+                "Cannot open file %s for writing: %s",
+                index_filepath_temp,
+                strerror(errno));
+    return false;
+  }
+
+  bool ok = fprintf(file, "BLENDER-BLOCK-HASH %d\n", BLO_BLOCK_HASH_INDEX_VERSION) > 0;
+  for (const BlockHash &block : blocks) {
+    if (!ok) {
+      break;
+    }
+    const char *code = reinterpret_cast<const char *>(&block.code);
+    ok = fprintf(file,
+                 "%llu %d %c%c%c%c %016llx\n",
+                 (unsigned long long)block.offset,
+                 block.len,
+                 code[0] ? code[0] : '_',
+                 code[1] ? code[1] : '_',
+                 code[2] ? code[2] : '_',
+                 code[3] ? code[3] : '_',
+                 (unsigned long long)block.hash) > 0;
+  }
+  ok = (fclose(file) == 0) && ok;
+
+  if (!ok || BLI_rename_overwrite(index_filepath_temp, index_filepath) != 0) {
+    BKE_reportf(reports, RPT_WARNING, "Cannot write block hash index %s", index_filepath);
+    BLI_delete(index_filepath_temp, false, false);
+    return false;
+  }
+  return true;
+}
+
 /**
  * Do reverse file history: `.blend1` -> `.blend2`, `.blend` -> `.blend1` ... etc.
  * \return True on success.
@@ -1496,6 +1690,7 @@ static bool BLO_write_file_impl(Main *mainvar,
   const bool use_save_versions = params->use_save_versions;
   const bool use_save_as_copy = params->use_save_as_copy;
   const bool use_userdef = params->use_userdef;
+  const bool use_block_hash_index = params->use_block_hash_index;
   const BlendThumbnail *thumb = params->thumb;
   const bool relbase_valid = (mainvar->filepath[0] != '\0');
 
@@ -1599,8 +1794,15 @@ static bool BLO_write_file_impl(Main *mainvar,
   }
 
   /* Actual file writing. */
-  const bool err = write_file_handle(
-      mainvar, &ww, nullptr, nullptr, write_flags, use_userdef, thumb);
+  blender::Vector<BlockHash> block_hashes;
+  const bool err = write_file_handle(mainvar,
+                                     &ww,
+                                     nullptr,
+                                     nullptr,
+                                     write_flags,
+                                     use_userdef,
+                                     thumb,
+                                     use_block_hash_index ? &block_hashes : nullptr);
 
   ww.close();
 
@@ -1630,6 +1832,11 @@ static bool BLO_write_file_impl(Main *mainvar,
     return false;
   }
 
+  if (use_block_hash_index) {
+    /* Not fatal, the file itself was saved. */
+    write_block_hash_index(filepath, block_hashes, reports);
+  }
+
   write_file_main_validate_post(mainvar, reports);
 
   return true;
@@ -1647,6 +1854,7 @@ bool BLO_write_file(Main *mainvar,
                     const BlendFileWriteParams *params,
                     ReportList *reports)
 {
+  TRACE_SCOPE("BLO::write_file");
   RawWriteWrap raw_wrap;
 
   if (write_flags & G_FILE_COMPRESS) {
@@ -1657,12 +1865,77 @@ bool BLO_write_file(Main *mainvar,
   return BLO_write_file_impl(mainvar, filepath, write_flags, params, reports, raw_wrap);
 }
 
+BlendFileWriteBuffer *BLO_write_file_to_buffer(Main *mainvar,
+                                               const int write_flags,
+                                               ReportList *reports)
+{
+  BlendFileWriteBuffer *buffer = MEM_new<BlendFileWriteBuffer>(__func__);
+  MemoryWriteWrap mem_wrap(*buffer);
+
+  write_file_main_validate_pre(mainvar, reports);
+
+  const bool err = write_file_handle(
+      mainvar, &mem_wrap, nullptr, nullptr, write_flags, false, nullptr, nullptr);
+
+  if (err) {
+    BKE_report(reports, RPT_ERROR, "Cannot write file to memory");
+    BLO_write_buffer_free(buffer);
+    return nullptr;
+  }
+
+  write_file_main_validate_post(mainvar, reports);
+
+  return buffer;
+}
+
+bool BLO_write_buffer_to_file(const BlendFileWriteBuffer *buffer, const char *filepath)
+{
+  char tempname[FILE_MAX + 1];
+  SNPRINTF(tempname, "%s@", filepath);
+
+  RawWriteWrap raw_wrap;
+  if (raw_wrap.open(tempname) == false) {
+    CLOG_ERROR(&LOG, "Cannot open file %s for writing: %s", tempname, strerror(errno));
+    return false;
+  }
+
+  bool ok = true;
+  for (const blender::Array<char, 0> &chunk : buffer->chunks) {
+    if (!raw_wrap.write(chunk.data(), size_t(chunk.size()))) {
+      CLOG_ERROR(&LOG, "Cannot write file %s: %s", tempname, strerror(errno));
+      ok = false;
+      break;
+    }
+  }
+
+  if (!raw_wrap.close()) {
+    ok = false;
+  }
+
+  if (!ok) {
+    BLI_delete(tempname, false, false);
+    return false;
+  }
+
+  if (BLI_rename_overwrite(tempname, filepath) != 0) {
+    CLOG_ERROR(&LOG, "Cannot change old file %s (file saved with @)", filepath);
+    return false;
+  }
+
+  return true;
+}
+
+void BLO_write_buffer_free(BlendFileWriteBuffer *buffer)
+{
+  MEM_delete(buffer);
+}
+
 bool BLO_write_file_mem(Main *mainvar, MemFile *compare, MemFile *current, int write_flags)
 {
   bool use_userdef = false;
 
   const bool err = write_file_handle(
-      mainvar, nullptr, compare, current, write_flags, use_userdef, nullptr);
+      mainvar, nullptr, compare, current, write_flags, use_userdef, nullptr, nullptr);
 
   return (err == 0);
 }
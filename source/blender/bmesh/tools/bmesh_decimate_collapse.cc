@@ -8,11 +8,13 @@
  * BMesh decimator that uses an edge collapse method.
  */
 
+#include <algorithm>
 #include <cstddef>
 
 #include "MEM_guardedalloc.h"
 
 #include "BLI_alloca.h"
+#include "BLI_array.hh"
 #include "BLI_heap.h"
 #include "BLI_linklist.h"
 #include "BLI_math_geom.h"
@@ -21,7 +23,9 @@
 #include "BLI_polyfill_2d.h"
 #include "BLI_polyfill_2d_beautify.h"
 #include "BLI_quadric.h"
+#include "BLI_task.hh"
 #include "BLI_utildefines_stack.h"
+#include "BLI_vector.hh"
 
 #include "BKE_customdata.hh"
 
@@ -71,57 +75,87 @@ ENUM_OPERATORS(CD_UseFlag, CD_DO_LOOP)
  */
 static void bm_decim_build_quadrics(BMesh *bm, Quadric *vquadrics)
 {
-  BMIter iter;
-  BMFace *f;
-  BMEdge *e;
-
-  BM_ITER_MESH (f, &iter, bm, BM_FACES_OF_MESH) {
-    BMLoop *l_first;
-    BMLoop *l_iter;
-
-    float center[3];
-    double plane_db[4];
-    Quadric q;
-
-    BM_face_calc_center_median(f, center);
-    copy_v3db_v3fl(plane_db, f->no);
-    plane_db[3] = -dot_v3db_v3fl(plane_db, center);
-
-    BLI_quadric_from_plane(&q, plane_db);
-
-    l_iter = l_first = BM_FACE_FIRST_LOOP(f);
-    do {
-      BLI_quadric_add_qu_qu(&vquadrics[BM_elem_index_get(l_iter->v)], &q);
-    } while ((l_iter = l_iter->next) != l_first);
-  }
+  using namespace blender;
+  BM_mesh_elem_index_ensure(bm, BM_EDGE | BM_FACE);
+  BM_mesh_elem_table_ensure(bm, BM_VERT | BM_EDGE | BM_FACE);
+
+  Array<Quadric> face_quadrics(bm->totface);
+  threading::parallel_for(face_quadrics.index_range(), 1024, [&](const IndexRange range) {
+    for (const int i : range) {
+      const BMFace *f = BM_face_at_index(bm, i);
+      float center[3];
+      double plane_db[4];
+
+      BM_face_calc_center_median(f, center);
+      copy_v3db_v3fl(plane_db, f->no);
+      plane_db[3] = -dot_v3db_v3fl(plane_db, center);
+
+      BLI_quadric_from_plane(&face_quadrics[i], plane_db);
+    }
+  });
 
   /* boundary edges */
-  BM_ITER_MESH (e, &iter, bm, BM_EDGES_OF_MESH) {
-    if (UNLIKELY(BM_edge_is_boundary(e))) {
-      float edge_vector[3];
-      float edge_plane[3];
-      double edge_plane_db[4];
-      sub_v3_v3v3(edge_vector, e->v2->co, e->v1->co);
-      f = e->l->f;
-
-      cross_v3_v3v3(edge_plane, edge_vector, f->no);
-      copy_v3db_v3fl(edge_plane_db, edge_plane);
-
-      if (normalize_v3_db(edge_plane_db) > double(FLT_EPSILON)) {
-        Quadric q;
-        float center[3];
-
-        mid_v3_v3v3(center, e->v1->co, e->v2->co);
-
-        edge_plane_db[3] = -dot_v3db_v3fl(edge_plane_db, center);
-        BLI_quadric_from_plane(&q, edge_plane_db);
-        BLI_quadric_mul(&q, BOUNDARY_PRESERVE_WEIGHT);
+  Array<Quadric> edge_quadrics(bm->totedge);
+  Array<bool> edge_use_quadric(bm->totedge, false);
+  threading::parallel_for(edge_quadrics.index_range(), 1024, [&](const IndexRange range) {
+    for (const int i : range) {
+      const BMEdge *e = BM_edge_at_index(bm, i);
+      if (UNLIKELY(BM_edge_is_boundary(e))) {
+        float edge_vector[3];
+        float edge_plane[3];
+        double edge_plane_db[4];
+        sub_v3_v3v3(edge_vector, e->v2->co, e->v1->co);
+
+        cross_v3_v3v3(edge_plane, edge_vector, e->l->f->no);
+        copy_v3db_v3fl(edge_plane_db, edge_plane);
+
+        if (normalize_v3_db(edge_plane_db) > double(FLT_EPSILON)) {
+          float center[3];
+
+          mid_v3_v3v3(center, e->v1->co, e->v2->co);
+
+          edge_plane_db[3] = -dot_v3db_v3fl(edge_plane_db, center);
+          BLI_quadric_from_plane(&edge_quadrics[i], edge_plane_db);
+          BLI_quadric_mul(&edge_quadrics[i], BOUNDARY_PRESERVE_WEIGHT);
+          edge_use_quadric[i] = true;
+        }
+      }
+    }
+  });
+
+  /* Gather the quadrics around each vertex. They are added in order of the face and edge indices
+   * like a serial loop over all faces and then all edges would, so the floating point result
+   * (and with it the order of collapses) doesn't depend on the order of the disk cycles. */
+  threading::parallel_for(IndexRange(bm->totvert), 1024, [&](const IndexRange range) {
+    Vector<int, 32> indices;
+    for (const int i : range) {
+      BMVert *v = BM_vert_at_index(bm, i);
+      Quadric &q = vquadrics[BM_elem_index_get(v)];
+      BMIter iter;
+
+      indices.clear();
+      BMLoop *l;
+      BM_ITER_ELEM (l, &iter, v, BM_LOOPS_OF_VERT) {
+        indices.append(BM_elem_index_get(l->f));
+      }
+      std::sort(indices.begin(), indices.end());
+      for (const int face_i : indices) {
+        BLI_quadric_add_qu_qu(&q, &face_quadrics[face_i]);
+      }
 
-        BLI_quadric_add_qu_qu(&vquadrics[BM_elem_index_get(e->v1)], &q);
-        BLI_quadric_add_qu_qu(&vquadrics[BM_elem_index_get(e->v2)], &q);
+      indices.clear();
+      BMEdge *e;
+      BM_ITER_ELEM (e, &iter, v, BM_EDGES_OF_VERT) {
+        if (edge_use_quadric[BM_elem_index_get(e)]) {
+          indices.append(BM_elem_index_get(e));
+        }
+      }
+      std::sort(indices.begin(), indices.end());
+      for (const int edge_i : indices) {
+        BLI_quadric_add_qu_qu(&q, &edge_quadrics[edge_i]);
       }
     }
-  }
+  });
 }
 
 static void bm_decim_calc_target_co_db(BMEdge *e, double optimize_co[3], const Quadric *vquadrics)
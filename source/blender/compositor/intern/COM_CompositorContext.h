@@ -121,6 +121,14 @@ class CompositorContext {
     return bnodetree_;
   }
 
+  /**
+   * \brief whether intermediate results may be stored with half precision
+   */
+  bool use_half_precision() const
+  {
+    return bnodetree_->precision == NODE_TREE_COMPOSITOR_PRECISION_HALF;
+  }
+
   /**
    * \brief get the scene of the context
    */
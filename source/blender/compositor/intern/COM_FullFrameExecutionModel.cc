@@ -27,6 +27,8 @@ FullFrameExecutionModel::FullFrameExecutionModel(CompositorContext &context,
       active_buffers_(shared_buffers),
       num_operations_finished_(0)
 {
+  active_buffers_.set_use_half_storage(context.use_half_precision());
+
   priorities_.append(eCompositorPriority::High);
   if (!context.is_fast_calculation()) {
     priorities_.append(eCompositorPriority::Medium);
@@ -201,24 +203,25 @@ void FullFrameExecutionModel::determine_areas_to_render(NodeOperation *output_op
     std::pair<NodeOperation *, rcti> pair = stack.pop_last();
     NodeOperation *operation = pair.first;
     const rcti &render_area = pair.second;
-    if (BLI_rcti_is_empty(&render_area) ||
-        active_buffers_.is_area_registered(operation, render_area))
-    {
+    if (BLI_rcti_is_empty(&render_area)) {
       continue;
     }
 
-    active_buffers_.register_area(operation, render_area);
+    /* Only areas not requested before are propagated to the inputs. */
+    const Vector<rcti> new_areas = active_buffers_.request_area(operation, render_area);
 
     const int num_inputs = operation->get_number_of_input_sockets();
-    for (int i = 0; i < num_inputs; i++) {
-      NodeOperation *input_op = operation->get_input_operation(i);
-      rcti input_area;
-      operation->get_area_of_interest(input_op, render_area, input_area);
+    for (const rcti &new_area : new_areas) {
+      for (int i = 0; i < num_inputs; i++) {
+        NodeOperation *input_op = operation->get_input_operation(i);
+        rcti input_area;
+        operation->get_area_of_interest(input_op, new_area, input_area);
 
-      /* Ensure area of interest is within operation bounds, cropping areas outside. */
-      BLI_rcti_isect(&input_area, &input_op->get_canvas(), &input_area);
+        /* Ensure area of interest is within operation bounds, cropping areas outside. */
+        BLI_rcti_isect(&input_area, &input_op->get_canvas(), &input_area);
 
-      stack.append({input_op, input_area});
+        stack.append({input_op, input_area});
+      }
     }
   }
 }
@@ -0,0 +1,109 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#include "COM_FusedRowOperation.h"
+
+namespace blender::compositor {
+
+FusedRowOperation::FusedRowOperation(Span<MultiThreadedRowOperation *> operations)
+    : operations_(operations)
+{
+  BLI_assert(operations.size() > 1);
+  for (const int i : operations.index_range()) {
+    MultiThreadedRowOperation *op = operations[i];
+    /* First input of every operation but the first one is the previous operation output. */
+    for (int k = (i == 0) ? 0 : 1; k < op->get_number_of_input_sockets(); k++) {
+      const NodeOperationInput *input = op->get_input_socket(k);
+      this->add_input_socket(input->get_data_type(), input->get_resize_mode());
+    }
+  }
+
+  MultiThreadedRowOperation *last_op = operations.last();
+  this->add_output_socket(last_op->get_output_socket()->get_data_type());
+  this->set_canvas(last_op->get_canvas());
+  this->set_name(last_op->get_name());
+  this->set_node_instance_key(last_op->get_node_instance_key());
+}
+
+FusedRowOperation::~FusedRowOperation()
+{
+  for (MultiThreadedRowOperation *op : operations_) {
+    delete op;
+  }
+}
+
+void FusedRowOperation::init_data()
+{
+  for (MultiThreadedRowOperation *op : operations_) {
+    op->init_data();
+  }
+}
+
+void FusedRowOperation::init_execution()
+{
+  for (MultiThreadedRowOperation *op : operations_) {
+    op->init_execution();
+  }
+}
+
+void FusedRowOperation::deinit_execution()
+{
+  for (MultiThreadedRowOperation *op : operations_) {
+    op->deinit_execution();
+  }
+}
+
+void FusedRowOperation::update_memory_buffer_partial(MemoryBuffer *output,
+                                                     const rcti &area,
+                                                     Span<MemoryBuffer *> inputs)
+{
+  using PixelCursor = MultiThreadedRowOperation::PixelCursor;
+
+  BLI_assert(output != nullptr);
+  const int width = BLI_rcti_size_x(&area);
+  const int num_ops = operations_.size();
+
+  /* Row sized buffers for the output of every operation but the last one, which writes directly
+   * into the output buffer. */
+  Array<Array<float>> rows(num_ops - 1);
+  Vector<PixelCursor> cursors;
+  for (const int i : operations_.index_range()) {
+    MultiThreadedRowOperation *op = operations_[i];
+    cursors.append_as(op->get_number_of_input_sockets());
+    PixelCursor &p = cursors.last();
+    if (i < num_ops - 1) {
+      p.out_stride = COM_data_type_num_channels(op->get_output_socket()->get_data_type());
+      rows[i].reinitialize(width * p.out_stride);
+    }
+    else {
+      p.out_stride = output->elem_stride;
+    }
+  }
+
+  int input_index = 0;
+  for (const int i : operations_.index_range()) {
+    PixelCursor &p = cursors[i];
+    for (int k = 0; k < p.in_strides.size(); k++) {
+      p.in_strides[k] = (i > 0 && k == 0) ? cursors[i - 1].out_stride :
+                                            inputs[input_index++]->elem_stride;
+    }
+  }
+  BLI_assert(input_index == inputs.size());
+
+  for (int y = area.ymin; y < area.ymax; y++) {
+    input_index = 0;
+    for (const int i : operations_.index_range()) {
+      PixelCursor &p = cursors[i];
+      for (int k = 0; k < p.ins.size(); k++) {
+        p.ins[k] = (i > 0 && k == 0) ? rows[i - 1].data() :
+                                       inputs[input_index++]->get_elem(area.xmin, y);
+      }
+      p.out = (i < num_ops - 1) ? rows[i].data() : output->get_elem(area.xmin, y);
+      p.row_end = p.out + width * p.out_stride;
+      operations_[i]->update_memory_buffer_row(p);
+    }
+  }
+}
+
+}  // namespace blender::compositor
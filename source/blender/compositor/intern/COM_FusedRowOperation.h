@@ -0,0 +1,42 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#pragma once
+
+#include "COM_MultiThreadedRowOperation.h"
+
+namespace blender::compositor {
+
+/**
+ * Chain of row operations evaluated as a single operation. Each operation of the chain reads the
+ * output of the previous one from its first input, row by row, so no full intermediate buffers
+ * are allocated.
+ *
+ * Inputs are the inputs of the first operation followed by the remaining inputs of every other
+ * operation, in chain order. The fused operations are owned by this operation.
+ */
+class FusedRowOperation : public MultiThreadedOperation {
+ private:
+  Vector<MultiThreadedRowOperation *> operations_;
+
+ public:
+  FusedRowOperation(Span<MultiThreadedRowOperation *> operations);
+  ~FusedRowOperation();
+
+  void init_data() override;
+  void init_execution() override;
+  void deinit_execution() override;
+
+  Span<MultiThreadedRowOperation *> get_fused_operations() const
+  {
+    return operations_;
+  }
+
+ protected:
+  void update_memory_buffer_partial(MemoryBuffer *output,
+                                    const rcti &area,
+                                    Span<MemoryBuffer *> inputs) override;
+};
+
+}  // namespace blender::compositor
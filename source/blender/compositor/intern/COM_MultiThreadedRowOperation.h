@@ -38,6 +38,9 @@ class MultiThreadedRowOperation : public MultiThreadedOperation {
   virtual void update_memory_buffer_row(PixelCursor &p) = 0;
 
  private:
+  /* Evaluates chains of row operations without intermediate buffers. */
+  friend class FusedRowOperation;
+
   void update_memory_buffer_partial(MemoryBuffer *output,
                                     const rcti &area,
                                     Span<MemoryBuffer *> inputs) final;
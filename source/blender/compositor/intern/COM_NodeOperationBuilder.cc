@@ -5,12 +5,14 @@
 #include <set>
 
 #include "BLI_multi_value_map.hh"
+#include "BLI_set.hh"
 
 #include "BKE_node_runtime.hh"
 
 #include "COM_Converter.h"
 #include "COM_Debug.h"
 
+#include "COM_FusedRowOperation.h"
 #include "COM_PreviewOperation.h"
 #include "COM_SetColorOperation.h"
 #include "COM_SetValueOperation.h"
@@ -90,6 +92,8 @@ void NodeOperationBuilder::convert_to_operations(ExecutionSystem *system)
   save_graphviz("compositor_prior_merging");
   merge_equal_operations();
 
+  fuse_row_operations();
+
   /* links not available from here on */
   /* XXX make links_ a local variable to avoid confusion! */
   links_.clear();
@@ -493,6 +497,104 @@ void NodeOperationBuilder::merge_equal_operations(NodeOperation *from, NodeOpera
   delete from;
 }
 
+/**
+ * Get the row operation that could be fused as the previous step of the given one: the operation
+ * linked to its first input, used by nothing else and sharing its canvas.
+ */
+static MultiThreadedRowOperation *get_fusable_row_input(
+    const Map<NodeOperationOutput *, int> &users, MultiThreadedRowOperation *op)
+{
+  NodeOperationInput *input = op->get_number_of_input_sockets() > 0 ? op->get_input_socket(0) :
+                                                                      nullptr;
+  if (input == nullptr || !input->is_connected()) {
+    return nullptr;
+  }
+  NodeOperationOutput *link = input->get_link();
+  MultiThreadedRowOperation *input_op = dynamic_cast<MultiThreadedRowOperation *>(
+      &link->get_operation());
+  if (input_op == nullptr || input_op->get_number_of_output_sockets() != 1 ||
+      users.lookup_default(link, 0) != 1 ||
+      link->get_data_type() != input->get_data_type() ||
+      !BLI_rcti_compare(&input_op->get_canvas(), &op->get_canvas()))
+  {
+    return nullptr;
+  }
+  return input_op;
+}
+
+void NodeOperationBuilder::fuse_row_operations()
+{
+  Map<NodeOperationOutput *, int> users;
+  for (const Link &link : links_) {
+    users.lookup_or_add(link.from(), 0)++;
+  }
+
+  /* Chains are collected from their last operation first, as fusing modifies #operations_. */
+  Set<MultiThreadedRowOperation *> fusable_inputs;
+  Vector<MultiThreadedRowOperation *> row_ops;
+  for (NodeOperation *op : operations_) {
+    MultiThreadedRowOperation *row_op = dynamic_cast<MultiThreadedRowOperation *>(op);
+    if (row_op == nullptr) {
+      continue;
+    }
+    row_ops.append(row_op);
+    if (MultiThreadedRowOperation *input_op = get_fusable_row_input(users, row_op)) {
+      fusable_inputs.add(input_op);
+    }
+  }
+
+  Vector<Vector<MultiThreadedRowOperation *>> chains;
+  for (MultiThreadedRowOperation *op : row_ops) {
+    if (fusable_inputs.contains(op)) {
+      /* Not the last operation of its chain. */
+      continue;
+    }
+    Vector<MultiThreadedRowOperation *> chain;
+    for (MultiThreadedRowOperation *chain_op = op; chain_op;
+         chain_op = get_fusable_row_input(users, chain_op))
+    {
+      chain.append(chain_op);
+    }
+    if (chain.size() > 1) {
+      std::reverse(chain.begin(), chain.end());
+      chains.append(std::move(chain));
+    }
+  }
+
+  for (const Vector<MultiThreadedRowOperation *> &chain : chains) {
+    fuse_row_operations(chain);
+  }
+}
+
+void NodeOperationBuilder::fuse_row_operations(Span<MultiThreadedRowOperation *> chain)
+{
+  FusedRowOperation *fused_op = new FusedRowOperation(chain);
+
+  int fused_input_index = 0;
+  for (const int i : chain.index_range()) {
+    MultiThreadedRowOperation *op = chain[i];
+    for (int k = 0; k < op->get_number_of_input_sockets(); k++) {
+      NodeOperationInput *input = op->get_input_socket(k);
+      NodeOperationOutput *from = input->get_link();
+      remove_input_link(input);
+      if (i == 0 || k > 0) {
+        add_link(from, fused_op->get_input_socket(fused_input_index++));
+      }
+    }
+  }
+
+  NodeOperationOutput *last_output = chain.last()->get_output_socket();
+  for (NodeOperationInput *input : cache_output_links(last_output)) {
+    remove_input_link(input);
+    add_link(fused_op->get_output_socket(), input);
+  }
+
+  for (MultiThreadedRowOperation *op : chain) {
+    operations_.remove_first_occurrence_and_reorder(op);
+  }
+  add_operation(fused_op);
+}
+
 Vector<NodeOperationInput *> NodeOperationBuilder::cache_output_links(
     NodeOperationOutput *output) const
 {
@@ -25,6 +25,7 @@ class NodeOperationOutput;
 class PreviewOperation;
 class ViewerOperation;
 class ConstantOperation;
+class MultiThreadedRowOperation;
 
 class NodeOperationBuilder {
  public:
@@ -143,6 +144,9 @@ class NodeOperationBuilder {
   /** Merge operations with same type, inputs and parameters that produce the same result. */
   void merge_equal_operations();
   void merge_equal_operations(NodeOperation *from, NodeOperation *into);
+  /** Replace chains of row operations by single operations without intermediate buffers. */
+  void fuse_row_operations();
+  void fuse_row_operations(Span<MultiThreadedRowOperation *> chain);
   void save_graphviz(StringRefNull name = "");
 #ifdef WITH_CXX_GUARDEDALLOC
   MEM_CXX_CLASS_ALLOC_FUNCS("COM:NodeCompilerImpl")
@@ -2,14 +2,121 @@
  *
  * SPDX-License-Identifier: GPL-2.0-or-later */
 
-#include "COM_SharedOperationBuffers.h"
+#include "BLI_task.hh"
+
+#include "COM_MemoryBuffer.h"
 #include "COM_NodeOperation.h"
+#include "COM_SharedOperationBuffers.h"
 
 namespace blender::compositor {
 
 SharedOperationBuffers::BufferData::BufferData()
-    : buffer(nullptr), registered_reads(0), received_reads(0), is_rendered(false)
+    : buffer(nullptr),
+      half_data_type(DataType::Color),
+      half_rect(COM_AREA_NONE),
+      registered_reads(0),
+      received_reads(0),
+      is_rendered(false)
+{
+}
+
+static uint32_t float_as_uint(const float f)
+{
+  uint32_t u;
+  memcpy(&u, &f, sizeof(u));
+  return u;
+}
+
+static float uint_as_float(const uint32_t u)
+{
+  float f;
+  memcpy(&f, &u, sizeof(f));
+  return f;
+}
+
+/** IEEE half conversion, rounding to nearest even. Out of range values become infinite. */
+static uint16_t float_to_half(const float f)
+{
+  const uint32_t f32_infinity = 255u << 23;
+  const uint32_t f16_max = (127u + 16u) << 23;
+  const uint32_t denormal_magic = ((127u - 15u) + (23u - 10u) + 1u) << 23;
+  uint32_t u = float_as_uint(f);
+  const uint32_t sign = u & 0x80000000u;
+  u ^= sign;
+  uint16_t h;
+  if (u >= f16_max) {
+    /* Infinity or NaN. */
+    h = (u > f32_infinity) ? 0x7e00 : 0x7c00;
+  }
+  else if (u < (113u << 23)) {
+    /* Denormal, let the float addition do the rounding. */
+    h = uint16_t(float_as_uint(uint_as_float(u) + uint_as_float(denormal_magic)) -
+                 denormal_magic);
+  }
+  else {
+    const uint32_t mantissa_odd = (u >> 13) & 1u;
+    u += (uint32_t(15 - 127) << 23) + 0xfffu + mantissa_odd;
+    h = uint16_t(u >> 13);
+  }
+  return h | uint16_t(sign >> 16);
+}
+
+static float half_to_float(const uint16_t h)
+{
+  const uint32_t shifted_exponent = 0x7c00u << 13;
+  uint32_t u = uint32_t(h & 0x7fff) << 13;
+  const uint32_t exponent = shifted_exponent & u;
+  u += (127u - 15u) << 23;
+  if (exponent == shifted_exponent) {
+    /* Infinity or NaN. */
+    u += (128u - 16u) << 23;
+  }
+  else if (exponent == 0) {
+    /* Zero or denormal, renormalize. */
+    u = float_as_uint(uint_as_float(u + (1u << 23)) - uint_as_float(113u << 23));
+  }
+  return uint_as_float(u | (uint32_t(h & 0x8000) << 16));
+}
+
+void SharedOperationBuffers::store_half_buffer(BufferData &buf_data)
 {
+  MemoryBuffer *buffer = buf_data.buffer.get();
+  if (buffer == nullptr || buffer->is_a_single_elem() || BLI_rcti_is_empty(&buffer->get_rect())) {
+    return;
+  }
+
+  /* The buffer can't change between reads, so it's only converted once. */
+  if (buf_data.half_buffer.is_empty()) {
+    const float *src = buffer->get_buffer();
+    const int64_t len = int64_t(buffer->get_width()) * buffer->get_height() *
+                        buffer->get_num_channels();
+    buf_data.half_buffer.reinitialize(len);
+    buf_data.half_data_type = COM_num_channels_data_type(buffer->get_num_channels());
+    buf_data.half_rect = buffer->get_rect();
+    uint16_t *dst = buf_data.half_buffer.data();
+    threading::parallel_for(IndexRange(len), 65536, [&](const IndexRange range) {
+      for (const int64_t i : range) {
+        dst[i] = float_to_half(src[i]);
+      }
+    });
+  }
+  buf_data.buffer = nullptr;
+}
+
+void SharedOperationBuffers::restore_half_buffer(BufferData &buf_data)
+{
+  if (buf_data.buffer || buf_data.half_buffer.is_empty()) {
+    return;
+  }
+
+  buf_data.buffer = std::make_unique<MemoryBuffer>(buf_data.half_data_type, buf_data.half_rect);
+  float *dst = buf_data.buffer->get_buffer();
+  const uint16_t *src = buf_data.half_buffer.data();
+  threading::parallel_for(buf_data.half_buffer.index_range(), 65536, [&](const IndexRange range) {
+    for (const int64_t i : range) {
+      dst[i] = half_to_float(src[i]);
+    }
+  });
 }
 
 SharedOperationBuffers::BufferData &SharedOperationBuffers::get_buffer_data(NodeOperation *op)
@@ -17,23 +124,57 @@ SharedOperationBuffers::BufferData &SharedOperationBuffers::get_buffer_data(Node
   return buffers_.lookup_or_add_cb(op, []() { return BufferData(); });
 }
 
-bool SharedOperationBuffers::is_area_registered(NodeOperation *op, const rcti &area_to_render)
+/**
+ * Append the parts of \a area outside of \a hole, as up to four non overlapping rectangles.
+ */
+static void subtract_area(const rcti &area, const rcti &hole, Vector<rcti> &r_areas)
 {
-  /* TODO: Possibly refactor to "request_area". Current implementation is incomplete:
-   * partial overlapping, etc. Leading to more rendering than necessary. */
+  rcti isect;
+  if (!BLI_rcti_isect(&area, &hole, &isect) || BLI_rcti_is_empty(&isect)) {
+    r_areas.append(area);
+    return;
+  }
 
-  BufferData &buf_data = get_buffer_data(op);
-  for (rcti &reg_rect : buf_data.render_areas) {
-    if (BLI_rcti_inside_rcti(&reg_rect, &area_to_render)) {
-      return true;
-    }
+  rcti part;
+  if (area.ymin < isect.ymin) {
+    BLI_rcti_init(&part, area.xmin, area.xmax, area.ymin, isect.ymin);
+    r_areas.append(part);
+  }
+  if (isect.ymax < area.ymax) {
+    BLI_rcti_init(&part, area.xmin, area.xmax, isect.ymax, area.ymax);
+    r_areas.append(part);
+  }
+  if (area.xmin < isect.xmin) {
+    BLI_rcti_init(&part, area.xmin, isect.xmin, isect.ymin, isect.ymax);
+    r_areas.append(part);
+  }
+  if (isect.xmax < area.xmax) {
+    BLI_rcti_init(&part, isect.xmax, area.xmax, isect.ymin, isect.ymax);
+    r_areas.append(part);
   }
-  return false;
 }
 
-void SharedOperationBuffers::register_area(NodeOperation *op, const rcti &area_to_render)
+Vector<rcti> SharedOperationBuffers::request_area(NodeOperation *op, const rcti &area_to_render)
 {
-  get_buffer_data(op).render_areas.append(area_to_render);
+  BufferData &buf_data = get_buffer_data(op);
+
+  /* Only register the parts not rendered by previous requests, so that partially overlapping
+   * areas are not rendered twice, neither by this operation nor by its inputs. */
+  Vector<rcti> new_areas;
+  new_areas.append(area_to_render);
+  for (const rcti &reg_rect : buf_data.render_areas) {
+    Vector<rcti> remaining_areas;
+    for (const rcti &area : new_areas) {
+      subtract_area(area, reg_rect, remaining_areas);
+    }
+    new_areas = std::move(remaining_areas);
+    if (new_areas.is_empty()) {
+      break;
+    }
+  }
+
+  buf_data.render_areas.extend(new_areas);
+  return new_areas;
 }
 
 bool SharedOperationBuffers::has_registered_reads(NodeOperation *op)
@@ -77,7 +218,9 @@ void SharedOperationBuffers::set_rendered_buffer(NodeOperation *op,
 MemoryBuffer *SharedOperationBuffers::get_rendered_buffer(NodeOperation *op)
 {
   BLI_assert(is_operation_rendered(op));
-  return get_buffer_data(op).buffer.get();
+  BufferData &buf_data = get_buffer_data(op);
+  restore_half_buffer(buf_data);
+  return buf_data.buffer.get();
 }
 
 void SharedOperationBuffers::read_finished(NodeOperation *read_op)
@@ -88,6 +231,12 @@ void SharedOperationBuffers::read_finished(NodeOperation *read_op)
   if (buf_data.received_reads == buf_data.registered_reads) {
     /* Dispose buffer. */
     buf_data.buffer = nullptr;
+    buf_data.half_buffer = {};
+  }
+  else if (use_half_storage_) {
+    /* Only keep a half precision copy until the next read. Buffers read by a single operation
+     * are never converted. */
+    store_half_buffer(buf_data);
   }
 }
 
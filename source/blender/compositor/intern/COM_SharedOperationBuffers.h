@@ -4,11 +4,14 @@
 
 #pragma once
 
+#include "BLI_array.hh"
 #include "BLI_map.hh"
 #include "BLI_vector.hh"
 
 #include "DNA_vec_types.h"
 
+#include "COM_defines.h"
+
 #ifdef WITH_CXX_GUARDEDALLOC
 #  include "MEM_guardedalloc.h"
 #endif
@@ -28,22 +31,36 @@ class SharedOperationBuffers {
    public:
     BufferData();
     std::unique_ptr<MemoryBuffer> buffer;
+    /**
+     * Half precision copy of the buffer, used while it waits for further reads and #buffer is
+     * released.
+     */
+    blender::Array<uint16_t> half_buffer;
+    DataType half_data_type;
+    rcti half_rect;
     blender::Vector<rcti> render_areas;
     int registered_reads;
     int received_reads;
     bool is_rendered;
   } BufferData;
   blender::Map<NodeOperation *, BufferData> buffers_;
+  bool use_half_storage_ = false;
 
  public:
   /**
-   * Whether given operation area to render is already registered.
+   * Store buffers that wait for further reads with half precision, instead of keeping the full
+   * precision buffer in memory between reads.
    */
-  bool is_area_registered(NodeOperation *op, const rcti &area_to_render);
+  void set_use_half_storage(bool use_half_storage)
+  {
+    use_half_storage_ = use_half_storage;
+  }
+
   /**
-   * Registers an operation area to render.
+   * Registers the parts of given operation area to render that are not registered yet.
+   * \return Newly registered areas, not overlapping each other nor previously registered areas.
    */
-  void register_area(NodeOperation *op, const rcti &area_to_render);
+  Vector<rcti> request_area(NodeOperation *op, const rcti &area_to_render);
 
   /**
    * Whether given operation has any registered reads (other operation registered it depends on
@@ -68,18 +85,20 @@ class SharedOperationBuffers {
    */
   void set_rendered_buffer(NodeOperation *op, std::unique_ptr<MemoryBuffer> buffer);
   /**
-   * Get given operation rendered buffer.
+   * Get given operation rendered buffer, restoring it from its half precision copy if needed.
    */
   MemoryBuffer *get_rendered_buffer(NodeOperation *op);
 
   /**
    * Reports an operation has finished reading given operation. If all given operation dependencies
-   * have finished its buffer will be disposed.
+   * have finished its buffer will be disposed, otherwise it may be stored with half precision.
    */
   void read_finished(NodeOperation *read_op);
 
  private:
   BufferData &get_buffer_data(NodeOperation *op);
+  void store_half_buffer(BufferData &buf_data);
+  void restore_half_buffer(BufferData &buf_data);
 
 #ifdef WITH_CXX_GUARDEDALLOC
   MEM_CXX_CLASS_ALLOC_FUNCS("COM:SharedOperationBuffers")
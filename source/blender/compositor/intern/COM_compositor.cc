@@ -10,6 +10,7 @@
 #include "BKE_node_runtime.hh"
 #include "BKE_scene.hh"
 
+#include "COM_DenoiseOperation.h"
 #include "COM_ExecutionSystem.h"
 #include "COM_WorkScheduler.h"
 #include "COM_compositor.hh"
@@ -77,8 +78,11 @@ void COM_execute(Render *render,
   compositor_init_node_previews(render_data, node_tree);
   compositor_reset_node_tree_status(node_tree);
 
+  /* Renders that are too large to be allocated on the GPU fall back to the CPU compositor, which
+   * has no such limit, instead of failing. */
   if (U.experimental.use_full_frame_compositor &&
-      node_tree->execution_mode == NTREE_EXECUTION_MODE_GPU)
+      node_tree->execution_mode == NTREE_EXECUTION_MODE_GPU &&
+      RE_compositor_is_possible_on_gpu(*render_data))
   {
     /* GPU compositor. */
     RE_compositor_execute(*render, *scene, *render_data, *node_tree, view_name, render_context);
@@ -128,6 +132,7 @@ void COM_deinitialize()
   if (g_compositor.is_initialized) {
     BLI_mutex_lock(&g_compositor.mutex);
     blender::compositor::WorkScheduler::deinitialize();
+    blender::compositor::COM_denoise_cache_free();
     g_compositor.is_initialized = false;
     BLI_mutex_unlock(&g_compositor.mutex);
     BLI_mutex_end(&g_compositor.mutex);
@@ -2,11 +2,14 @@
  *
  * SPDX-License-Identifier: GPL-2.0-or-later */
 
+#include "BLI_array.hh"
 #include "BLI_math_vector.h"
 #include "BLI_math_vector.hh"
+#include "BLI_task.hh"
 
 #include "COM_BokehBlurOperation.h"
 #include "COM_ConstantOperation.h"
+#include "COM_FHTConvolution.h"
 
 namespace blender::compositor {
 
@@ -15,6 +18,10 @@ constexpr int BOKEH_INPUT_INDEX = 1;
 constexpr int BOUNDING_BOX_INPUT_INDEX = 2;
 constexpr int SIZE_INPUT_INDEX = 3;
 
+/* Blur radius from which convolving in the frequency domain is faster than sampling every bokeh
+ * texel for each pixel. */
+constexpr int FHT_MIN_RADIUS = 16;
+
 BokehBlurOperation::BokehBlurOperation()
 {
   this->add_input_socket(DataType::Color);
@@ -29,6 +36,7 @@ BokehBlurOperation::BokehBlurOperation()
   sizeavailable_ = false;
 
   extend_bounds_ = false;
+  use_fht_ = false;
 }
 
 void BokehBlurOperation::init_data()
@@ -101,6 +109,68 @@ void BokehBlurOperation::get_area_of_interest(const int input_idx,
   }
 }
 
+void BokehBlurOperation::update_memory_buffer_started(MemoryBuffer *output,
+                                                      const rcti &area,
+                                                      Span<MemoryBuffer *> inputs)
+{
+  const float max_dim = std::max(this->get_width(), this->get_height());
+  const int radius = size_ * max_dim / 100.0f;
+
+  const MemoryBuffer *image_input = inputs[IMAGE_INPUT_INDEX];
+  const MemoryBuffer *bokeh_input = inputs[BOKEH_INPUT_INDEX];
+  use_fht_ = get_step() == 1 && radius >= FHT_MIN_RADIUS && !image_input->is_a_single_elem();
+  if (!use_fht_) {
+    return;
+  }
+
+  /* Image area read by the kernel, with edges extended the same as #get_elem_clamped. */
+  rcti padded_area;
+  BLI_rcti_init(&padded_area,
+                area.xmin - radius,
+                area.xmax + radius,
+                area.ymin - radius,
+                area.ymax + radius);
+  MemoryBuffer padded_image(DataType::Color, padded_area);
+  threading::parallel_for(
+      IndexRange(padded_area.ymin, BLI_rcti_size_y(&padded_area)), 32, [&](const IndexRange ys) {
+        for (const int y : ys) {
+          for (int x = padded_area.xmin; x < padded_area.xmax; x++) {
+            copy_v4_v4(padded_image.get_elem(x, y), image_input->get_elem_clamped(x, y));
+          }
+        }
+      });
+
+  /* The kernel is the bokeh image flipped, as the blur accumulates `image(x + xi) * bokeh(xi)`
+   * while a convolution accumulates `image(x - xi) * kernel(xi)`. */
+  const int2 bokeh_size = int2(bokeh_input->get_width(), bokeh_input->get_height());
+  const int kernel_size = radius * 2 + 1;
+  rcti kernel_rect;
+  BLI_rcti_init(&kernel_rect, 0, kernel_size, 0, kernel_size);
+  MemoryBuffer kernel(DataType::Color, kernel_rect);
+  for (int y = 0; y < kernel_size; y++) {
+    for (int x = 0; x < kernel_size; x++) {
+      const float2 normalized_texel = (float2(radius - x, radius - y) + radius + 0.5f) /
+                                      float(kernel_size);
+      const float2 weight_texel = (1.0f - normalized_texel) * float2(bokeh_size - 1);
+      copy_v4_v4(kernel.get_elem(x, y),
+                 bokeh_input->get_elem(int(weight_texel.x), int(weight_texel.y)));
+    }
+  }
+
+  const int padded_width = BLI_rcti_size_x(&padded_area);
+  Array<float> result(size_t(padded_width) * BLI_rcti_size_y(&padded_area) *
+                      COM_DATA_TYPE_COLOR_CHANNELS);
+  convolve_fht(result.data(), &padded_image, &kernel, COM_DATA_TYPE_COLOR_CHANNELS);
+
+  for (int y = area.ymin; y < area.ymax; y++) {
+    const float *row = &result[(size_t(y - padded_area.ymin) * padded_width + radius) *
+                               COM_DATA_TYPE_COLOR_CHANNELS];
+    for (int x = area.xmin; x < area.xmax; x++) {
+      copy_v4_v4(output->get_elem(x, y), &row[(x - area.xmin) * COM_DATA_TYPE_COLOR_CHANNELS]);
+    }
+  }
+}
+
 void BokehBlurOperation::update_memory_buffer_partial(MemoryBuffer *output,
                                                       const rcti &area,
                                                       Span<MemoryBuffer *> inputs)
@@ -121,6 +191,10 @@ void BokehBlurOperation::update_memory_buffer_partial(MemoryBuffer *output,
       image_input->read_elem(x, y, it.out);
       continue;
     }
+    if (use_fht_) {
+      /* Already convolved when the update started. */
+      continue;
+    }
 
     float4 accumulated_color = float4(0.0f);
     float4 accumulated_weight = float4(0.0f);
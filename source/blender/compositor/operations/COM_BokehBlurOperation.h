@@ -16,6 +16,8 @@ class BokehBlurOperation : public MultiThreadedOperation, public QualityStepHelp
   bool sizeavailable_;
 
   bool extend_bounds_;
+  /** Whether the area being updated is convolved in the frequency domain. */
+  bool use_fht_;
 
  public:
   BokehBlurOperation();
@@ -38,6 +40,9 @@ class BokehBlurOperation : public MultiThreadedOperation, public QualityStepHelp
   void determine_canvas(const rcti &preferred_area, rcti &r_area) override;
 
   void get_area_of_interest(int input_idx, const rcti &output_area, rcti &r_input_area) override;
+  void update_memory_buffer_started(MemoryBuffer *output,
+                                    const rcti &area,
+                                    Span<MemoryBuffer *> inputs) override;
   void update_memory_buffer_partial(MemoryBuffer *output,
                                     const rcti &area,
                                     Span<MemoryBuffer *> inputs) override;
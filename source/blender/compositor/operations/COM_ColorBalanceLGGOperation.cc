@@ -8,21 +8,31 @@
 
 namespace blender::compositor {
 
-inline float colorbalance_lgg(float in, float lift_lgg, float gamma_inv, float gain)
+/* The color space conversions of all three channels are done at once through the SIMD versions of
+ * the conversion functions, which are considerably faster than converting each channel on its
+ * own. */
+inline void colorbalance_lgg_v3(float r_result[3],
+                                const float in[3],
+                                const float lift_lgg[3],
+                                const float gamma_inv[3],
+                                const float gain[3])
 {
   /* 1:1 match with the sequencer with linear/srgb conversions, the conversion isn't pretty
    * but best keep it this way, since testing for durian shows a similar calculation
    * without lin/srgb conversions gives bad results (over-saturated shadows) with colors
    * slightly below 1.0. some correction can be done but it ends up looking bad for shadows or
    * lighter tones - campbell */
-  float x = (((linearrgb_to_srgb(in) - 1.0f) * lift_lgg) + 1.0f) * gain;
-
-  /* prevent NaN */
-  if (x < 0.0f) {
-    x = 0.0f;
+  float x[3];
+  linearrgb_to_srgb_v3_v3(x, in);
+  for (int i = 0; i < 3; i++) {
+    /* prevent NaN */
+    x[i] = std::max((((x[i] - 1.0f) * lift_lgg[i]) + 1.0f) * gain[i], 0.0f);
   }
 
-  return powf(srgb_to_linearrgb(x), gamma_inv);
+  srgb_to_linearrgb_v3_v3(x, x);
+  for (int i = 0; i < 3; i++) {
+    r_result[i] = powf(x[i], gamma_inv[i]);
+  }
 }
 
 ColorBalanceLGGOperation::ColorBalanceLGGOperation()
@@ -41,12 +51,11 @@ void ColorBalanceLGGOperation::update_memory_buffer_row(PixelCursor &p)
     const float *in_color = p.ins[1];
     const float fac = std::min(1.0f, in_factor[0]);
     const float fac_m = 1.0f - fac;
-    p.out[0] = fac_m * in_color[0] +
-               fac * colorbalance_lgg(in_color[0], lift_[0], gamma_inv_[0], gain_[0]);
-    p.out[1] = fac_m * in_color[1] +
-               fac * colorbalance_lgg(in_color[1], lift_[1], gamma_inv_[1], gain_[1]);
-    p.out[2] = fac_m * in_color[2] +
-               fac * colorbalance_lgg(in_color[2], lift_[2], gamma_inv_[2], gain_[2]);
+    float balanced[3];
+    colorbalance_lgg_v3(balanced, in_color, lift_, gamma_inv_, gain_);
+    p.out[0] = fac_m * in_color[0] + fac * balanced[0];
+    p.out[1] = fac_m * in_color[1] + fac * balanced[1];
+    p.out[2] = fac_m * in_color[2] + fac * balanced[2];
     p.out[3] = in_color[3];
   }
 }
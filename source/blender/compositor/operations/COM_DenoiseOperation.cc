@@ -2,8 +2,16 @@
  *
  * SPDX-License-Identifier: GPL-2.0-or-later */
 
-#include "COM_DenoiseOperation.h"
+#include <mutex>
+
+#include <xxhash.h>
+
+#include "BLI_hash.hh"
 #include "BLI_system.h"
+
+#include "DNA_userdef_types.h"
+
+#include "COM_DenoiseOperation.h"
 #ifdef WITH_OPENIMAGEDENOISE
 #  include "BLI_threads.h"
 #  include <OpenImageDenoise/oidn.hpp>
@@ -33,14 +41,58 @@ static bool oidn_progress_monitor_function(void *user_ptr, double /*n*/)
   const NodeOperation *operation = static_cast<const NodeOperation *>(user_ptr);
   return !operation->is_braked();
 }
+
+/* The device is kept across executions, since creating GPU devices is expensive. Only accessed
+ * while holding oidn_lock. */
+static oidn::DeviceRef oidn_device;
+/* The device can't access host memory, so images are copied to and from device buffers. */
+static bool oidn_device_needs_buffers = false;
+
+static void ensure_oidn_device()
+{
+  if (oidn_device) {
+    return;
+  }
+
+#  if OIDN_VERSION_MAJOR >= 2
+  /* Let OIDN pick the fastest available device, which is a GPU device (CUDA, HIP, SYCL or Metal)
+   * if one is supported, otherwise this falls back to the CPU device below. */
+  bool has_gpu_device = false;
+  for (int i = 0; i < oidnGetNumPhysicalDevices(); i++) {
+    has_gpu_device |= oidnGetPhysicalDeviceInt(i, "type") != OIDN_DEVICE_TYPE_CPU;
+  }
+
+  if (has_gpu_device) {
+    oidn::DeviceRef device = oidn::newDevice(oidn::DeviceType::Default);
+    device.commit();
+    const char *error_message;
+    if (device.getError(error_message) == oidn::Error::None &&
+        device.get<int>("type") != OIDN_DEVICE_TYPE_CPU)
+    {
+      oidn_device = device;
+      oidn_device_needs_buffers = !device.get<bool>("systemMemorySupported");
+      return;
+    }
+  }
+#  endif
+
+  oidn_device = oidn::newDevice(oidn::DeviceType::CPU);
+  oidn_device.set("setAffinity", false);
+  oidn_device.commit();
+  oidn_device_needs_buffers = false;
+}
 #endif
 
 class DenoiseFilter {
  private:
 #ifdef WITH_OPENIMAGEDENOISE
-  oidn::DeviceRef device_;
   oidn::FilterRef filter_;
   bool initialized_ = false;
+#  if OIDN_VERSION_MAJOR >= 2
+  /* Device copy of the output image, to be read back after execution. */
+  oidn::BufferRef output_buffer_;
+  MemoryBuffer *output_ = nullptr;
+#  endif
 #endif
 
  public:
@@ -57,10 +109,8 @@ class DenoiseFilter {
      * nonetheless. */
     BLI_mutex_lock(&oidn_lock);
 
-    device_ = oidn::newDevice(oidn::DeviceType::CPU);
-    device_.set("setAffinity", false);
-    device_.commit();
-    filter_ = device_.newFilter("RT");
+    ensure_oidn_device();
+    filter_ = oidn_device.newFilter("RT");
     filter_.setProgressMonitorFunction(oidn_progress_monitor_function, operation);
     initialized_ = true;
     set_image("output", output);
@@ -68,6 +118,11 @@ class DenoiseFilter {
 
   void deinit_and_unlock_denoiser()
   {
+#  if OIDN_VERSION_MAJOR >= 2
+    output_buffer_ = oidn::BufferRef();
+    output_ = nullptr;
+#  endif
+    filter_ = oidn::FilterRef();
     BLI_mutex_unlock(&oidn_lock);
     initialized_ = false;
   }
@@ -76,6 +131,28 @@ class DenoiseFilter {
   {
     BLI_assert(initialized_);
     BLI_assert(!buffer->is_a_single_elem());
+#  if OIDN_VERSION_MAJOR >= 2
+    if (oidn_device_needs_buffers) {
+      const size_t size = size_t(buffer->get_width()) * buffer->get_height() *
+                          buffer->get_elem_bytes_len();
+      oidn::BufferRef device_buffer = oidn_device.newBuffer(size);
+      if (name == "output") {
+        output_buffer_ = device_buffer;
+        output_ = buffer;
+      }
+      else {
+        device_buffer.write(0, size, buffer->get_buffer());
+      }
+      filter_.setImage(name.data(),
+                       device_buffer,
+                       oidn::Format::Float3,
+                       buffer->get_width(),
+                       buffer->get_height(),
+                       0,
+                       buffer->get_elem_bytes_len());
+      return;
+    }
+#  endif
     filter_.setImage(name.data(),
                      buffer->get_buffer(),
                      oidn::Format::Float3,
@@ -96,6 +173,11 @@ class DenoiseFilter {
     BLI_assert(initialized_);
     filter_.commit();
     filter_.execute();
+#  if OIDN_VERSION_MAJOR >= 2
+    if (output_buffer_) {
+      output_buffer_.read(0, output_buffer_.getSize(), output_->get_buffer());
+    }
+#  endif
   }
 
 #else
@@ -111,6 +193,104 @@ class DenoiseFilter {
 #endif
 };
 
+/* -------------------------------------------------------------------- */
+/** \name Denoise Result Cache
+ *
+ * Denoising is usually the slowest operation of a tree, while the settings being tweaked are
+ * often downstream of it. Results are kept across executions, keyed by the denoise settings and
+ * a hash of the input pixels. Pixels are hashed instead of the upstream operations, as sources
+ * like Render Layers change their content without changing any parameter.
+ * \{ */
+
+struct DenoiseCacheEntry {
+  uint64_t key;
+  std::unique_ptr<MemoryBuffer> result;
+};
+
+static std::mutex denoise_cache_mutex;
+/** Entries from least to most recently used. */
+static Vector<DenoiseCacheEntry> denoise_cache;
+
+static size_t buffer_bytes_len(const MemoryBuffer &buffer)
+{
+  const size_t num_elems = buffer.is_a_single_elem() ?
+                               1 :
+                               size_t(buffer.get_width()) * size_t(buffer.get_height());
+  return num_elems * buffer.get_elem_bytes_len();
+}
+
+static uint64_t denoise_cache_key(uint64_t params_hash, Span<MemoryBuffer *> inputs)
+{
+  uint64_t key = params_hash;
+  for (MemoryBuffer *input : inputs) {
+    const rcti &rect = input->get_rect();
+    const uint64_t data_hash = XXH3_64bits(input->get_buffer(), buffer_bytes_len(*input));
+    key = get_default_hash(
+        key, data_hash, get_default_hash(rect.xmin, rect.xmax, rect.ymin, rect.ymax));
+  }
+  return key;
+}
+
+/** Copy a cached result into \a output, returns false if there is none. */
+static bool denoise_cache_lookup(const uint64_t key, MemoryBuffer *output)
+{
+  std::scoped_lock lock(denoise_cache_mutex);
+  for (const int i : denoise_cache.index_range()) {
+    if (denoise_cache[i].key != key) {
+      continue;
+    }
+    const MemoryBuffer &result = *denoise_cache[i].result;
+    if (!BLI_rcti_compare(&result.get_rect(), &output->get_rect()) ||
+        result.get_num_channels() != output->get_num_channels())
+    {
+      continue;
+    }
+    output->copy_from(&result, result.get_rect());
+
+    /* Move to the most recently used position. */
+    DenoiseCacheEntry entry = std::move(denoise_cache[i]);
+    denoise_cache.remove(i);
+    denoise_cache.append(std::move(entry));
+    return true;
+  }
+  return false;
+}
+
+static void denoise_cache_add(const uint64_t key, const MemoryBuffer *output)
+{
+  const size_t max_bytes = size_t(U.memcachelimit) * 1024 * 1024;
+  const size_t result_bytes = buffer_bytes_len(*output);
+  if (output->is_a_single_elem() || result_bytes > max_bytes) {
+    return;
+  }
+
+  std::scoped_lock lock(denoise_cache_mutex);
+  size_t cache_bytes = result_bytes;
+  for (const DenoiseCacheEntry &entry : denoise_cache) {
+    cache_bytes += buffer_bytes_len(*entry.result);
+  }
+  /* Evict least recently used entries. */
+  while (cache_bytes > max_bytes && !denoise_cache.is_empty()) {
+    cache_bytes -= buffer_bytes_len(*denoise_cache.first().result);
+    denoise_cache.remove(0);
+  }
+  denoise_cache.append({key, std::make_unique<MemoryBuffer>(*output)});
+}
+
+void COM_denoise_cache_free()
+{
+  std::scoped_lock lock(denoise_cache_mutex);
+  denoise_cache.clear_and_shrink();
+
+#ifdef WITH_OPENIMAGEDENOISE
+  BLI_mutex_lock(&oidn_lock);
+  oidn_device = oidn::DeviceRef();
+  BLI_mutex_unlock(&oidn_lock);
+#endif
+}
+
+/** \} */
+
 DenoiseBaseOperation::DenoiseBaseOperation()
 {
   flags_.can_be_constant = true;
@@ -195,7 +375,17 @@ void DenoiseOperation::update_memory_buffer(MemoryBuffer *output,
                                             Span<MemoryBuffer *> inputs)
 {
   if (!output_rendered_) {
-    this->generate_denoise(output, inputs[0], inputs[1], inputs[2], settings_);
+    const uint64_t key = denoise_cache_key(
+        settings_ ? get_default_hash(int(settings_->hdr),
+                                     are_guiding_passes_noise_free(settings_)) :
+                    0,
+        inputs);
+    if (!denoise_cache_lookup(key, output)) {
+      this->generate_denoise(output, inputs[0], inputs[1], inputs[2], settings_);
+      if (!is_braked()) {
+        denoise_cache_add(key, output);
+      }
+    }
     output_rendered_ = true;
   }
 }
@@ -233,7 +423,13 @@ void DenoisePrefilterOperation::update_memory_buffer(MemoryBuffer *output,
                                                      Span<MemoryBuffer *> inputs)
 {
   if (!output_rendered_) {
-    this->generate_denoise(output, inputs[0]);
+    const uint64_t key = denoise_cache_key(get_default_hash(image_name_), inputs);
+    if (!denoise_cache_lookup(key, output)) {
+      this->generate_denoise(output, inputs[0]);
+      if (!is_braked()) {
+        denoise_cache_add(key, output);
+      }
+    }
     output_rendered_ = true;
   }
 }
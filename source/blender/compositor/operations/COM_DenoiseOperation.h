@@ -10,6 +10,8 @@
 namespace blender::compositor {
 
 bool COM_is_denoise_supported();
+/** Free denoise results and the denoising device kept across executions. */
+void COM_denoise_cache_free();
 
 class DenoiseBaseOperation : public NodeOperation {
  protected:
@@ -0,0 +1,380 @@
+/* SPDX-FileCopyrightText: 2011 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#include "BLI_array.hh"
+#include "BLI_task.hh"
+
+#include "COM_FHTConvolution.h"
+
+namespace blender::compositor {
+
+/*
+ *  2D Fast Hartley Transform, used for convolution
+ */
+
+using fREAL = float;
+
+/* Returns next highest power of 2 of x, as well its log2 in L2. */
+static uint next_pow2(uint x, uint *L2)
+{
+  uint pw, x_notpow2 = x & (x - 1);
+  *L2 = 0;
+  while (x >>= 1) {
+    ++(*L2);
+  }
+  pw = 1 << (*L2);
+  if (x_notpow2) {
+    (*L2)++;
+    pw <<= 1;
+  }
+  return pw;
+}
+
+//------------------------------------------------------------------------------
+
+/* From FXT library by Joerg Arndt, faster in order bit-reversal
+ * use: `r = revbin_upd(r, h)` where `h = N>>1`. */
+static uint revbin_upd(uint r, uint h)
+{
+  while (!((r ^= h) & h)) {
+    h >>= 1;
+  }
+  return r;
+}
+//------------------------------------------------------------------------------
+static void FHT(fREAL *data, uint M, uint inverse)
+{
+  double tt, fc, dc, fs, ds, a = M_PI;
+  fREAL t1, t2;
+  int n2, bd, bl, istep, k, len = 1 << M, n = 1;
+
+  int i, j = 0;
+  uint Nh = len >> 1;
+  for (i = 1; i < (len - 1); i++) {
+    j = revbin_upd(j, Nh);
+    if (j > i) {
+      t1 = data[i];
+      data[i] = data[j];
+      data[j] = t1;
+    }
+  }
+
+  do {
+    fREAL *data_n = &data[n];
+
+    istep = n << 1;
+    for (k = 0; k < len; k += istep) {
+      t1 = data_n[k];
+      data_n[k] = data[k] - t1;
+      data[k] += t1;
+    }
+
+    n2 = n >> 1;
+    if (n > 2) {
+      fc = dc = cos(a);
+      fs = ds = sqrt(1.0 - fc * fc);  // sin(a);
+      bd = n - 2;
+      for (bl = 1; bl < n2; bl++) {
+        fREAL *data_nbd = &data_n[bd];
+        fREAL *data_bd = &data[bd];
+        for (k = bl; k < len; k += istep) {
+          t1 = fc * double(data_n[k]) + fs * double(data_nbd[k]);
+          t2 = fs * double(data_n[k]) - fc * double(data_nbd[k]);
+          data_n[k] = data[k] - t1;
+          data_nbd[k] = data_bd[k] - t2;
+          data[k] += t1;
+          data_bd[k] += t2;
+        }
+        tt = fc * dc - fs * ds;
+        fs = fs * dc + fc * ds;
+        fc = tt;
+        bd -= 2;
+      }
+    }
+
+    if (n > 1) {
+      for (k = n2; k < len; k += istep) {
+        t1 = data_n[k];
+        data_n[k] = data[k] - t1;
+        data[k] += t1;
+      }
+    }
+
+    n = istep;
+    a *= 0.5;
+  } while (n < len);
+
+  if (inverse) {
+    fREAL sc = (fREAL)1 / (fREAL)len;
+    for (k = 0; k < len; k++) {
+      data[k] *= sc;
+    }
+  }
+}
+//------------------------------------------------------------------------------
+/* 2D Fast Hartley Transform, Mx/My -> log2 of width/height,
+ * nzp -> the row where zero pad data starts,
+ * inverse -> see above. */
+static void FHT2D(fREAL *data, uint Mx, uint My, uint nzp, uint inverse)
+{
+  uint i, j, Nx, Ny, maxy;
+
+  Nx = 1 << Mx;
+  Ny = 1 << My;
+
+  /* Rows (forward transform skips 0 pad data). */
+  maxy = inverse ? Ny : nzp;
+  for (j = 0; j < maxy; j++) {
+    FHT(&data[Nx * j], Mx, inverse);
+  }
+
+  /* Transpose data. */
+  if (Nx == Ny) { /* Square. */
+    for (j = 0; j < Ny; j++) {
+      for (i = j + 1; i < Nx; i++) {
+        uint op = i + (j << Mx), np = j + (i << My);
+        std::swap(data[op], data[np]);
+      }
+    }
+  }
+  else { /* Rectangular. */
+    uint k, Nym = Ny - 1, stm = 1 << (Mx + My);
+    for (i = 0; stm > 0; i++) {
+#define PRED(k) (((k & Nym) << Mx) + (k >> My))
+      for (j = PRED(i); j > i; j = PRED(j)) {
+        /* Pass. */
+      }
+      if (j < i) {
+        continue;
+      }
+      for (k = i, j = PRED(i); j != i; k = j, j = PRED(j), stm--) {
+        std::swap(data[j], data[k]);
+      }
+#undef PRED
+      stm--;
+    }
+  }
+
+  std::swap(Nx, Ny);
+  std::swap(Mx, My);
+
+  /* Now columns == transposed rows. */
+  for (j = 0; j < Ny; j++) {
+    FHT(&data[Nx * j], Mx, inverse);
+  }
+
+  /* Finalize. */
+  for (j = 0; j <= (Ny >> 1); j++) {
+    uint jm = (Ny - j) & (Ny - 1);
+    uint ji = j << Mx;
+    uint jmi = jm << Mx;
+    for (i = 0; i <= (Nx >> 1); i++) {
+      uint im = (Nx - i) & (Nx - 1);
+      fREAL A = data[ji + i];
+      fREAL B = data[jmi + i];
+      fREAL C = data[ji + im];
+      fREAL D = data[jmi + im];
+      fREAL E = (fREAL)0.5 * ((A + D) - (B + C));
+      data[ji + i] = A - E;
+      data[jmi + i] = B + E;
+      data[ji + im] = C + E;
+      data[jmi + im] = D - E;
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+
+/* 2D convolution calc, d1 *= d2, M/N - > log2 of width/height. */
+static void fht_convolve(fREAL *d1, const fREAL *d2, uint M, uint N)
+{
+  fREAL a, b;
+  uint i, j, k, L, mj, mL;
+  uint m = 1 << M, n = 1 << N;
+  uint m2 = 1 << (M - 1), n2 = 1 << (N - 1);
+  uint mn2 = m << (N - 1);
+
+  d1[0] *= d2[0];
+  d1[mn2] *= d2[mn2];
+  d1[m2] *= d2[m2];
+  d1[m2 + mn2] *= d2[m2 + mn2];
+  for (i = 1; i < m2; i++) {
+    k = m - i;
+    a = d1[i] * d2[i] - d1[k] * d2[k];
+    b = d1[k] * d2[i] + d1[i] * d2[k];
+    d1[i] = (b + a) * (fREAL)0.5;
+    d1[k] = (b - a) * (fREAL)0.5;
+    a = d1[i + mn2] * d2[i + mn2] - d1[k + mn2] * d2[k + mn2];
+    b = d1[k + mn2] * d2[i + mn2] + d1[i + mn2] * d2[k + mn2];
+    d1[i + mn2] = (b + a) * (fREAL)0.5;
+    d1[k + mn2] = (b - a) * (fREAL)0.5;
+  }
+  for (j = 1; j < n2; j++) {
+    L = n - j;
+    mj = j << M;
+    mL = L << M;
+    a = d1[mj] * d2[mj] - d1[mL] * d2[mL];
+    b = d1[mL] * d2[mj] + d1[mj] * d2[mL];
+    d1[mj] = (b + a) * (fREAL)0.5;
+    d1[mL] = (b - a) * (fREAL)0.5;
+    a = d1[m2 + mj] * d2[m2 + mj] - d1[m2 + mL] * d2[m2 + mL];
+    b = d1[m2 + mL] * d2[m2 + mj] + d1[m2 + mj] * d2[m2 + mL];
+    d1[m2 + mj] = (b + a) * (fREAL)0.5;
+    d1[m2 + mL] = (b - a) * (fREAL)0.5;
+  }
+  for (i = 1; i < m2; i++) {
+    k = m - i;
+    for (j = 1; j < n2; j++) {
+      L = n - j;
+      mj = j << M;
+      mL = L << M;
+      a = d1[i + mj] * d2[i + mj] - d1[k + mL] * d2[k + mL];
+      b = d1[k + mL] * d2[i + mj] + d1[i + mj] * d2[k + mL];
+      d1[i + mj] = (b + a) * (fREAL)0.5;
+      d1[k + mL] = (b - a) * (fREAL)0.5;
+      a = d1[i + mL] * d2[i + mL] - d1[k + mj] * d2[k + mj];
+      b = d1[k + mj] * d2[i + mL] + d1[i + mL] * d2[k + mj];
+      d1[i + mL] = (b + a) * (fREAL)0.5;
+      d1[k + mj] = (b - a) * (fREAL)0.5;
+    }
+  }
+}
+//------------------------------------------------------------------------------
+
+void convolve_fht(float *dst, MemoryBuffer *image, MemoryBuffer *kernel, const int num_channels)
+{
+  BLI_assert(num_channels >= 1 && num_channels <= COM_DATA_TYPE_COLOR_CHANNELS);
+  BLI_assert(image->get_num_channels() == COM_DATA_TYPE_COLOR_CHANNELS);
+  BLI_assert(kernel->get_num_channels() == COM_DATA_TYPE_COLOR_CHANNELS);
+  uint w2, h2, log2_w, log2_h;
+  const int kernel_width = kernel->get_width();
+  const int kernel_height = kernel->get_height();
+  const int image_width = image->get_width();
+  const int image_height = image->get_height();
+  float *kernel_buffer = kernel->get_buffer();
+  const float *image_buffer = image->get_buffer();
+
+  memset(dst, 0, sizeof(float) * image_width * image_height * COM_DATA_TYPE_COLOR_CHANNELS);
+
+  /* Convolution result width & height. */
+  w2 = 2 * kernel_width - 1;
+  h2 = 2 * kernel_height - 1;
+  /* FFT pow2 required size & log2. */
+  w2 = next_pow2(w2, &log2_w);
+  h2 = next_pow2(h2, &log2_h);
+  const size_t block_len = size_t(w2) * h2;
+
+  /* Normalize convolution. */
+  float wt[COM_DATA_TYPE_COLOR_CHANNELS] = {0.0f};
+  for (int y = 0; y < kernel_height; y++) {
+    const float *colp = &kernel_buffer[y * kernel_width * COM_DATA_TYPE_COLOR_CHANNELS];
+    for (int x = 0; x < kernel_width; x++) {
+      for (int ch = 0; ch < num_channels; ch++) {
+        wt[ch] += colp[x * COM_DATA_TYPE_COLOR_CHANNELS + ch];
+      }
+    }
+  }
+  for (int ch = 0; ch < num_channels; ch++) {
+    if (wt[ch] != 0.0f) {
+      wt[ch] = 1.0f / wt[ch];
+    }
+  }
+  for (int y = 0; y < kernel_height; y++) {
+    float *colp = &kernel_buffer[y * kernel_width * COM_DATA_TYPE_COLOR_CHANNELS];
+    for (int x = 0; x < kernel_width; x++) {
+      for (int ch = 0; ch < num_channels; ch++) {
+        colp[x * COM_DATA_TYPE_COLOR_CHANNELS + ch] *= wt[ch];
+      }
+    }
+  }
+
+  /* Transform the kernel once per channel, it is re-used for every block. */
+  Array<fREAL> kernel_fht(num_channels * block_len, fREAL(0));
+  threading::parallel_for(IndexRange(num_channels), 1, [&](const IndexRange channels) {
+    for (const int ch : channels) {
+      fREAL *data1ch = &kernel_fht[ch * block_len];
+      for (int y = 0; y < kernel_height; y++) {
+        fREAL *fp = &data1ch[y * w2];
+        const float *colp = &kernel_buffer[y * kernel_width * COM_DATA_TYPE_COLOR_CHANNELS];
+        for (int x = 0; x < kernel_width; x++) {
+          fp[x] = colp[x * COM_DATA_TYPE_COLOR_CHANNELS + ch];
+        }
+      }
+      /* Zero pad data start is different for each == height+1. */
+      FHT2D(data1ch, log2_w, log2_h, kernel_height + 1, 0);
+    }
+  });
+
+  /* Block add-overlap. */
+  const int hw = kernel_width >> 1;
+  const int hh = kernel_height >> 1;
+  const int xbsz = (w2 + 1) - kernel_width;
+  const int ybsz = (h2 + 1) - kernel_height;
+  const int nxb = (image_width + xbsz - 1) / xbsz;
+  const int nyb = (image_height + ybsz - 1) / ybsz;
+
+  /* The result of a block overlaps its direct neighbors only, as the block size is at least the
+   * kernel size. Blocks of the same row and column parity are independent and are processed in
+   * parallel, in four successive phases. */
+  for (const int phase : IndexRange(4)) {
+    const int xphase = phase & 1;
+    const int yphase = phase >> 1;
+    const int phase_nxb = (nxb - xphase + 1) / 2;
+    const int phase_nyb = (nyb - yphase + 1) / 2;
+    const int num_tasks = phase_nxb * phase_nyb * num_channels;
+    threading::parallel_for(IndexRange(num_tasks), 1, [&](const IndexRange tasks) {
+      Array<fREAL> data2(block_len);
+      for (const int task : tasks) {
+        const int ch = task % num_channels;
+        const int block = task / num_channels;
+        const int xbl = (block % phase_nxb) * 2 + xphase;
+        const int ybl = (block / phase_nxb) * 2 + yphase;
+
+        /* Image block, channel ch -> data2. */
+        data2.fill(fREAL(0));
+        for (int y = 0; y < ybsz; y++) {
+          const int yy = ybl * ybsz + y;
+          if (yy >= image_height) {
+            break;
+          }
+          fREAL *fp = &data2[y * w2];
+          const float *colp = &image_buffer[yy * image_width * COM_DATA_TYPE_COLOR_CHANNELS];
+          for (int x = 0; x < xbsz; x++) {
+            const int xx = xbl * xbsz + x;
+            if (xx >= image_width) {
+              break;
+            }
+            fp[x] = colp[xx * COM_DATA_TYPE_COLOR_CHANNELS + ch];
+          }
+        }
+
+        /* Forward FHT, rows past the block height are zero padding. Transposed data, row/col
+         * now swapped, convolve & inverse FHT. */
+        FHT2D(data2.data(), log2_w, log2_h, ybsz, 0);
+        fht_convolve(data2.data(), &kernel_fht[ch * block_len], log2_h, log2_w);
+        FHT2D(data2.data(), log2_h, log2_w, 0, 1);
+        /* Data again transposed, so in order again. */
+
+        /* Overlap-add result. */
+        for (int y = 0; y < int(h2); y++) {
+          const int yy = ybl * ybsz + y - hh;
+          if ((yy < 0) || (yy >= image_height)) {
+            continue;
+          }
+          const fREAL *fp = &data2[y * w2];
+          float *colp = &dst[yy * image_width * COM_DATA_TYPE_COLOR_CHANNELS];
+          for (int x = 0; x < int(w2); x++) {
+            const int xx = xbl * xbsz + x - hw;
+            if ((xx < 0) || (xx >= image_width)) {
+              continue;
+            }
+            colp[xx * COM_DATA_TYPE_COLOR_CHANNELS + ch] += fp[x];
+          }
+        }
+      }
+    });
+  }
+}
+
+}  // namespace blender::compositor
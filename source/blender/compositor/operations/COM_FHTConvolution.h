@@ -0,0 +1,20 @@
+/* SPDX-FileCopyrightText: 2011 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#pragma once
+
+#include "COM_MemoryBuffer.h"
+
+namespace blender::compositor {
+
+/**
+ * Convolve the first \a num_channels channels of a color \a image with a centered color
+ * \a kernel using 2D Fast Hartley Transforms, writing the result in \a dst, which has the size
+ * of \a image. Pixels outside the image are considered zero, the image is processed in blocks
+ * so memory stays proportional to the kernel size. The kernel is normalized in place so each of
+ * its channels sums to one.
+ */
+void convolve_fht(float *dst, MemoryBuffer *image, MemoryBuffer *kernel, int num_channels);
+
+}  // namespace blender::compositor
@@ -37,7 +37,9 @@ bool operator==(const CachedShaderKey &a, const CachedShaderKey &b);
  * Cached Shader.
  *
  * A cached resource that constructs and caches a GPU shader from the given info name with its
- * output images' precision changed to the given precision. */
+ * output images' precision changed to the given precision. Cached shaders are kept for the
+ * lifetime of the container even if they are no longer needed, see CachedShaderContainer::reset.
+ */
 class CachedShader : public CachedResource {
  private:
   GPUShader *shader_ = nullptr;
@@ -77,11 +77,10 @@ GPUShader *CachedShader::shader() const
 
 void CachedShaderContainer::reset()
 {
-  /* First, delete all resources that are no longer needed. */
-  map_.remove_if([](auto item) { return !item.value->needed; });
-
-  /* Second, reset the needed status of the remaining resources to false to ready them to track
-   * their needed status for the next evaluation. */
+  /* Unlike other cached resources, shaders are not deleted when they are no longer needed. They
+   * only depend on the info name and precision, so there is a small bounded number of them, while
+   * compiling them again when a node is unmuted or a link is restored causes a noticeable hitch.
+   * So just reset the needed status, which is still tracked for consistency. */
   for (auto &value : map_.values()) {
     value->needed = false;
   }
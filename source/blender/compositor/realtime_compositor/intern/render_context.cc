@@ -10,7 +10,9 @@
 #include "BLI_map.hh"
 #include "BLI_math_vector_types.hh"
 #include "BLI_string.h"
+#include "BLI_task.hh"
 #include "BLI_utildefines.h"
+#include "BLI_vector.hh"
 
 #include "MEM_guardedalloc.h"
 
@@ -145,9 +147,19 @@ FileOutput &RenderContext::get_file_output(std::string path,
 
 void RenderContext::save_file_outputs(Scene *scene)
 {
+  /* Each file output owns its render result and only reads the scene, so the outputs can be
+   * encoded and written in parallel. This matters for multi-layer EXR outputs and multiple File
+   * Output nodes, where compression dominates the time spent saving. */
+  Vector<FileOutput *> file_outputs;
   for (std::unique_ptr<FileOutput> &file_output : file_outputs_.values()) {
-    file_output->save(scene);
+    file_outputs.append(file_output.get());
   }
+
+  threading::parallel_for(file_outputs.index_range(), 1, [&](const IndexRange range) {
+    for (const int64_t i : range) {
+      file_outputs[i]->save(scene);
+    }
+  });
 }
 
 }  // namespace blender::realtime_compositor
@@ -30,6 +30,9 @@
 
 #pragma once
 
+#include "BLI_function_ref.hh"
+#include "BLI_span.hh"
+
 #include "DNA_ID.h"
 
 /* Dependency Graph */
@@ -200,6 +203,31 @@ void DEG_evaluate_on_refresh(
     Depsgraph *graph,
     DepsgraphEvaluateSyncWriteback sync_writeback = DEG_EVALUATE_SYNC_WRITEBACK_NO);
 
+/**
+ * Check whether evaluating a frame does not depend on evaluating the previous frames first, which
+ * is not the case with simulation zones, point caches and rigid body simulations.
+ */
+bool DEG_frames_are_independent(const Depsgraph *graph);
+
+/**
+ * Evaluate the given frames of the view layer using up to \a graphs_num dependency graphs which
+ * are evaluated in parallel and share the original data. Every graph evaluates a continuous part
+ * of the frames, in order. The callback is called for every evaluated frame from the thread that
+ * evaluated it, so calls for different graphs happen concurrently.
+ *
+ * When frames are not independent (see #DEG_frames_are_independent) all of them are evaluated in
+ * a single graph. Every graph has its own evaluated copies of the data, so memory usage grows
+ * with \a graphs_num.
+ */
+void DEG_evaluate_frames_parallel(
+    Main *bmain,
+    Scene *scene,
+    ViewLayer *view_layer,
+    eEvaluationMode mode,
+    blender::Span<float> frames,
+    int graphs_num,
+    blender::FunctionRef<void(Depsgraph *graph, float frame)> frame_fn);
+
 /** \} */
 
 /* -------------------------------------------------------------------- */
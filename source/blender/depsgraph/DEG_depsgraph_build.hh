@@ -122,6 +122,18 @@ enum eDepsObjectComponentType {
   DEG_OB_COMP_CACHE,
 };
 
+/**
+ * Only evaluate the given components of visible objects, and whatever they depend on. By default
+ * all components of visible objects are evaluated, which is more than needed by consumers that
+ * only use part of the evaluated data (for example an exporter which only needs geometry skips
+ * the evaluation of shading and viewport drawing caches of all objects). An empty span requests
+ * all components again.
+ *
+ * Tags the graph for a relations update when the requested components change.
+ */
+void DEG_graph_set_requested_object_components(
+    Depsgraph *graph, blender::Span<eDepsObjectComponentType> components);
+
 void DEG_add_scene_relation(DepsNodeHandle *node_handle,
                             Scene *scene,
                             eDepsSceneComponentType component,
@@ -40,6 +40,39 @@ void DEG_stats_simple(const Depsgraph *graph,
                       size_t *r_operations,
                       size_t *r_relations);
 
+/**
+ * Obtain memory used by the large buffers (attributes, shape keys, lattice and curve points) of
+ * the data-blocks in the graph.
+ * \param[out] r_original:  Memory used by the original data-blocks.
+ * \param[out] r_evaluated: Memory used by the evaluated copies, not counting buffers that are
+ *                          shared with the original data-blocks.
+ * \param[out] r_shared:    Memory of the evaluated copies that is shared with the originals.
+ */
+void DEG_stats_memory(const Depsgraph *graph,
+                      size_t *r_original,
+                      size_t *r_evaluated,
+                      size_t *r_shared);
+
+/* ************************************************ */
+/* Evaluation Trace */
+
+/** Start recording the evaluation time of all operations of the graph. */
+void DEG_debug_trace_begin(Depsgraph *graph);
+/**
+ * Stop recording and write the events recorded since #DEG_debug_trace_begin as JSON in the Chrome
+ * trace event format (which can be viewed in `chrome://tracing` or Perfetto).
+ */
+void DEG_debug_trace_end(Depsgraph *graph, FILE *fp);
+/**
+ * Add an event to the trace of the graph evaluating on the current thread, does nothing when that
+ * graph is not being traced. Used for timings of work done within operations, like modifiers.
+ * \param start_time, duration: In seconds, start time as returned by #BLI_time_now_seconds.
+ */
+void DEG_debug_trace_event_add(const char *name,
+                               const char *category,
+                               double start_time,
+                               double duration);
+
 /* ************************************************ */
 /* Diagram-Based Graph Debugging */
 
@@ -1145,7 +1145,10 @@ void DepsgraphNodeBuilder::build_object_constraints(Object *object)
 
 void DepsgraphNodeBuilder::build_object_pointcache(Object *object)
 {
-  if (!BKE_ptcache_object_has(scene_, object, 0)) {
+  /* The playback cache is cleared by the same operation. */
+  const bool use_playback_cache = object->type == OB_MESH &&
+                                  (object->flag & OB_FLAG_USE_PLAYBACK_CACHE);
+  if (!BKE_ptcache_object_has(scene_, object, 0) && !use_playback_cache) {
     return;
   }
   Scene *scene_cow = get_cow_datablock(scene_);
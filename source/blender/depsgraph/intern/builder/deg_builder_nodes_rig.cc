@@ -16,6 +16,7 @@
 #include "MEM_guardedalloc.h"
 
 #include "BLI_blenlib.h"
+#include "BLI_set.hh"
 #include "BLI_string.h"
 #include "BLI_utildefines.h"
 
@@ -42,6 +43,28 @@
 
 namespace blender::deg {
 
+/**
+ * Bones which might be part of an IK or Spline IK chain. Instead of replicating the chain length
+ * logic of the solvers, all parents of a bone with such a constraint are included.
+ */
+static Set<const bPoseChannel *> find_pchans_affected_by_ik(const Object *object)
+{
+  Set<const bPoseChannel *> pchans;
+  LISTBASE_FOREACH (const bPoseChannel *, pchan, &object->pose->chanbase) {
+    LISTBASE_FOREACH (const bConstraint *, con, &pchan->constraints) {
+      if (ELEM(con->type, CONSTRAINT_TYPE_KINEMATIC, CONSTRAINT_TYPE_SPLINEIK)) {
+        for (const bPoseChannel *parchan = pchan; parchan; parchan = parchan->parent) {
+          if (!pchans.add(parchan)) {
+            break;
+          }
+        }
+        break;
+      }
+    }
+  }
+  return pchans;
+}
+
 void DepsgraphNodeBuilder::build_pose_constraints(Object *object,
                                                   bPoseChannel *pchan,
                                                   int pchan_index)
@@ -208,6 +231,7 @@ void DepsgraphNodeBuilder::build_rig(Object *object)
       [object_cow](::Depsgraph *depsgraph) { BKE_pose_eval_done(depsgraph, object_cow); });
   op_node->set_as_exit();
   /* Bones. */
+  const Set<const bPoseChannel *> pchans_affected_by_ik = find_pchans_affected_by_ik(object);
   int pchan_index = 0;
   LISTBASE_FOREACH (bPoseChannel *, pchan, &object->pose->chanbase) {
     /* Node for bone evaluation. */
@@ -215,24 +239,41 @@ void DepsgraphNodeBuilder::build_rig(Object *object)
         &object->id, NodeType::BONE, pchan->name, OperationCode::BONE_LOCAL);
     op_node->set_as_entry();
 
+    /* Without constraints and IK nothing changes the pose of the bone after parenting, so its
+     * final matrices are computed by the same operation. This halves the number of operations
+     * to schedule for the typical rig made of many small bone chains. The Done operation is kept
+     * as a no-op, so relations to it stay valid. */
+    const bool is_final_after_parent = pchan->constraints.first == nullptr &&
+                                       !pchans_affected_by_ik.contains(pchan);
+
     add_operation_node(&object->id,
                        NodeType::BONE,
                        pchan->name,
                        OperationCode::BONE_POSE_PARENT,
-                       [scene_cow, object_cow, pchan_index](::Depsgraph *depsgraph) {
+                       [scene_cow, object_cow, pchan_index, is_final_after_parent](
+                           ::Depsgraph *depsgraph) {
                          BKE_pose_eval_bone(depsgraph, scene_cow, object_cow, pchan_index);
+                         if (is_final_after_parent) {
+                           BKE_pose_bone_done(depsgraph, object_cow, pchan_index);
+                         }
                        });
 
     /* NOTE: Dedicated noop for easier relationship construction. */
     add_operation_node(&object->id, NodeType::BONE, pchan->name, OperationCode::BONE_READY);
 
-    op_node = add_operation_node(&object->id,
-                                 NodeType::BONE,
-                                 pchan->name,
-                                 OperationCode::BONE_DONE,
-                                 [object_cow, pchan_index](::Depsgraph *depsgraph) {
-                                   BKE_pose_bone_done(depsgraph, object_cow, pchan_index);
-                                 });
+    if (is_final_after_parent) {
+      op_node = add_operation_node(
+          &object->id, NodeType::BONE, pchan->name, OperationCode::BONE_DONE);
+    }
+    else {
+      op_node = add_operation_node(&object->id,
+                                   NodeType::BONE,
+                                   pchan->name,
+                                   OperationCode::BONE_DONE,
+                                   [object_cow, pchan_index](::Depsgraph *depsgraph) {
+                                     BKE_pose_bone_done(depsgraph, object_cow, pchan_index);
+                                   });
+    }
 
     /* B-Bone shape computation - the real last step if present. */
     if (check_pchan_has_bbone(object, pchan)) {
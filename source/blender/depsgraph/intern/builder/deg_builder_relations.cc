@@ -1226,8 +1226,15 @@ void DepsgraphRelationBuilder::build_object_pointcache(Object *object)
       break;
     }
   }
+  /* The playback cache is cleared before the geometry is evaluated again. */
+  const bool use_playback_cache = object->type == OB_MESH &&
+                                  (object->flag & OB_FLAG_USE_PLAYBACK_CACHE);
+  if (use_playback_cache && (handled_components & FLAG_GEOMETRY) == 0) {
+    OperationKey geometry_key(&object->id, NodeType::GEOMETRY, OperationCode::GEOMETRY_EVAL);
+    add_relation(point_cache_key, geometry_key, "Point Cache -> Geometry");
+  }
   /* Manual edits to any dependency (or self) should reset the point cache. */
-  if (!BLI_listbase_is_empty(&ptcache_id_list)) {
+  if (!BLI_listbase_is_empty(&ptcache_id_list) || use_playback_cache) {
     OperationKey transform_eval_key(
         &object->id, NodeType::TRANSFORM, OperationCode::TRANSFORM_EVAL);
     OperationKey geometry_init_key(
@@ -11,6 +11,7 @@
 #include "BLI_console.h"
 #include "BLI_hash.h"
 #include "BLI_string.h"
+#include "BLI_task.h"
 #include "BLI_time_utildefines.h"
 #include "BLI_utildefines.h"
 
@@ -53,6 +54,83 @@ void DepsgraphDebug::end_graph_evaluation()
   else {
     printf("Depsgraph [%s] updated in %f seconds.\n", name.c_str(), graph_eval_time);
   }
+
+  const EvaluationStats &stats = evaluation_stats;
+  if (stats.num_operations != 0 && stats.wall_time > 0.0) {
+    const double utilization = stats.busy_time / (stats.wall_time * stats.num_threads);
+    printf("  %d operations, %.1f%% utilization of %d threads, critical path %f seconds.\n",
+           stats.num_operations,
+           utilization * 100.0,
+           stats.num_threads,
+           stats.critical_path_time);
+  }
+}
+
+thread_local DepsgraphDebug *DepsgraphDebug::active_trace = nullptr;
+
+void DepsgraphDebug::trace_begin()
+{
+  std::lock_guard lock(trace_mutex_);
+  trace_events_.clear();
+  do_trace = true;
+}
+
+void DepsgraphDebug::trace_event_add(string name,
+                                     const char *category,
+                                     const double start_time,
+                                     const double duration)
+{
+  const int thread_id = BLI_task_parallel_thread_id(nullptr);
+  std::lock_guard lock(trace_mutex_);
+  trace_events_.append({std::move(name), category, start_time, duration, thread_id});
+}
+
+static void trace_write_json_string(FILE *fp, const string &str)
+{
+  fputc('"', fp);
+  for (const char c : str) {
+    if (c == '"' || c == '\\') {
+      fputc('\\', fp);
+      fputc(c, fp);
+    }
+    else if (uchar(c) < 0x20) {
+      fprintf(fp, "\\u%04x", int(c));
+    }
+    else {
+      fputc(c, fp);
+    }
+  }
+  fputc('"', fp);
+}
+
+void DepsgraphDebug::trace_end(FILE *fp)
+{
+  std::lock_guard lock(trace_mutex_);
+  do_trace = false;
+  /* Chrome trace timestamps are in micro-seconds, start at the first event for readability. */
+  double start_time = 0.0;
+  if (!trace_events_.is_empty()) {
+    start_time = trace_events_.first().start_time;
+    for (const TraceEvent &event : trace_events_) {
+      start_time = std::min(start_time, event.start_time);
+    }
+  }
+  fprintf(fp, "{\"traceEvents\": [\n");
+  for (const int i : trace_events_.index_range()) {
+    const TraceEvent &event = trace_events_[i];
+    fprintf(fp, "  {\"name\": ");
+    trace_write_json_string(fp, event.name);
+    fprintf(fp,
+            ", \"cat\": \"%s\", \"ph\": \"X\", \"ts\": %.3f, \"dur\": %.3f, \"pid\": 0, "
+            "\"tid\": %d}%s\n",
+            event.category,
+            (event.start_time - start_time) * 1e6,
+            event.duration * 1e6,
+            event.thread_id,
+            (i + 1 < trace_events_.size()) ? "," : "");
+  }
+  fprintf(fp, "]}\n");
+  trace_events_.clear_and_shrink();
 }
 
 bool terminal_do_color()
@@ -8,6 +8,9 @@
 
 #pragma once
 
+#include <cstdio>
+#include <mutex>
+
 #include "intern/depsgraph_type.hh"
 
 #include "BKE_global.hh"
@@ -32,6 +35,40 @@ class DepsgraphDebug {
    * created for different view layer). */
   string name;
 
+  /* Statistics of the last graph evaluation, only gathered when time debug is enabled. */
+  struct EvaluationStats {
+    int num_operations = 0;
+    int num_threads = 0;
+    /* Summed up evaluation time of all operations. */
+    double busy_time = 0.0;
+    /* Wall-clock time spent evaluating operations. */
+    double wall_time = 0.0;
+    /* Cost of the most expensive chain of operations, which bounds the wall time from below no
+     * matter how many threads are used. */
+    double critical_path_time = 0.0;
+  } evaluation_stats;
+
+  /* Event of the evaluation trace, see #DEG_debug_trace_begin. Times are in seconds. */
+  struct TraceEvent {
+    string name;
+    const char *category;
+    double start_time;
+    double duration;
+    int thread_id;
+  };
+
+  /* Whether evaluation events are recorded into the trace. */
+  bool do_trace = false;
+
+  /* Trace of the graph currently evaluating on this thread, if it is being traced. Allows code
+   * which has no access to the graph (like modifiers) to add events to the trace. */
+  static thread_local DepsgraphDebug *active_trace;
+
+  void trace_begin();
+  void trace_event_add(string name, const char *category, double start_time, double duration);
+  /* Write recorded events in the Chrome trace event format, and stop tracing. */
+  void trace_end(FILE *fp);
+
  protected:
   /* Maximum number of counters used to calculate frame rate of depsgraph update. */
   static const constexpr int MAX_FPS_COUNTERS = 64;
@@ -40,6 +77,9 @@ class DepsgraphDebug {
    * Is initialized from begin_graph_evaluation() when time debug is enabled.
    */
   double graph_evaluation_start_time_;
+
+  Vector<TraceEvent> trace_events_;
+  std::mutex trace_mutex_;
 };
 
 #define DEG_DEBUG_PRINTF(depsgraph, type, ...) \
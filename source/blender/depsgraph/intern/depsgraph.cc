@@ -60,6 +60,7 @@ Depsgraph::Depsgraph(Main *bmain, Scene *scene, ViewLayer *view_layer, eEvaluati
       scene_cow(nullptr),
       is_active(false),
       use_visibility_optimization(true),
+      requested_object_components(0),
       is_evaluating(false),
       is_render_pipeline_depsgraph(false),
       use_editors_update(false),
@@ -203,6 +204,21 @@ Relation *Depsgraph::check_nodes_connected(const Node *from,
                                            const Node *to,
                                            const char *description)
 {
+  /* Look through the shorter list of relations: one of the nodes often is a hub with a relation to
+   * every object (like the time source), which made building such relations quadratic. */
+  if (to->inlinks.size() < from->outlinks.size()) {
+    for (Relation *rel : to->inlinks) {
+      BLI_assert(rel->to == to);
+      if (rel->from != from) {
+        continue;
+      }
+      if (description != nullptr && !STREQ(rel->name, description)) {
+        continue;
+      }
+      return rel;
+    }
+    return nullptr;
+  }
   for (Relation *rel : from->outlinks) {
     BLI_assert(rel->from == from);
     if (rel->to != to) {
@@ -154,6 +154,10 @@ struct Depsgraph {
   /* Optimize out evaluation of operations which affect hidden objects or disabled modifiers. */
   bool use_visibility_optimization;
 
+  /* Bit-mask of #NodeType of the object components which are evaluated for visible objects, see
+   * #DEG_graph_set_requested_object_components. Zero when all components are requested. */
+  uint64_t requested_object_components;
+
   DepsgraphDebug debug;
 
   bool is_evaluating;
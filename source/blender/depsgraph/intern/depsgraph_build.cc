@@ -304,6 +304,28 @@ void DEG_graph_tag_relations_update(Depsgraph *graph)
   }
 }
 
+void DEG_graph_set_requested_object_components(
+    Depsgraph *graph, const blender::Span<eDepsObjectComponentType> components)
+{
+  deg::Depsgraph *deg_graph = reinterpret_cast<deg::Depsgraph *>(graph);
+  static_assert(int(deg::NodeType::NUM_TYPES) <= 64);
+  uint64_t mask = 0;
+  for (const eDepsObjectComponentType component : components) {
+    const deg::NodeType type = deg::nodeTypeFromObjectComponent(component);
+    if (type == deg::NodeType::UNDEFINED) {
+      /* #DEG_OB_COMP_ANY. */
+      mask = 0;
+      break;
+    }
+    mask |= uint64_t(1) << int(type);
+  }
+  if (deg_graph->requested_object_components == mask) {
+    return;
+  }
+  deg_graph->requested_object_components = mask;
+  DEG_graph_tag_relations_update(graph);
+}
+
 void DEG_graph_relations_update(Depsgraph *graph)
 {
   deg::Depsgraph *deg_graph = (deg::Depsgraph *)graph;
@@ -8,11 +8,27 @@
  * Implementation of tools for debugging the depsgraph
  */
 
+#include <algorithm>
+#include <string>
+
+#include "BLI_function_ref.hh"
+#include "BLI_map.hh"
+#include "BLI_set.hh"
 #include "BLI_utildefines.h"
+#include "BLI_vector.hh"
 
+#include "DNA_curve_types.h"
+#include "DNA_curves_types.h"
+#include "DNA_key_types.h"
+#include "DNA_lattice_types.h"
+#include "DNA_mesh_types.h"
+#include "DNA_object_types.h"
+#include "DNA_pointcloud_types.h"
 #include "DNA_scene_types.h"
 
-#include "DNA_object_types.h"
+#include "BKE_customdata.hh"
+
+#include "MEM_guardedalloc.h"
 
 #include "DEG_depsgraph.hh"
 #include "DEG_depsgraph_build.hh"
@@ -25,6 +41,7 @@
 #include "intern/depsgraph_type.hh"
 #include "intern/node/deg_node_component.hh"
 #include "intern/node/deg_node_id.hh"
+#include "intern/node/deg_node_operation.hh"
 #include "intern/node/deg_node_time.hh"
 
 namespace deg = blender::deg;
@@ -53,6 +70,37 @@ const char *DEG_debug_name_get(Depsgraph *depsgraph)
   return deg_graph->debug.name.c_str();
 }
 
+namespace blender::deg {
+
+/* Identifier of an operation which is the same for graphs built from the same data. */
+static std::string debug_operation_key(const OperationNode *operation_node)
+{
+  return operation_node->full_identifier() + "#" + std::to_string(operation_node->name_tag);
+}
+
+static std::string debug_node_key(const Node *node)
+{
+  if (node->type == NodeType::OPERATION) {
+    return debug_operation_key(static_cast<const OperationNode *>(node));
+  }
+  return node->identifier();
+}
+
+/* Sorted descriptions of relations, ignoring flags like #RELATION_FLAG_CYCLIC which depend on the
+ * order the graph has been traversed in. */
+static Vector<std::string> debug_relation_keys(const Node::Relations &relations,
+                                               const bool outgoing)
+{
+  Vector<std::string> keys;
+  for (const Relation *rel : relations) {
+    keys.append(debug_node_key(outgoing ? rel->to : rel->from) + " (" + rel->name + ")");
+  }
+  std::sort(keys.begin(), keys.end());
+  return keys;
+}
+
+}  // namespace blender::deg
+
 bool DEG_debug_compare(const Depsgraph *graph1, const Depsgraph *graph2)
 {
   BLI_assert(graph1 != nullptr);
@@ -62,12 +110,28 @@ bool DEG_debug_compare(const Depsgraph *graph1, const Depsgraph *graph2)
   if (deg_graph1->operations.size() != deg_graph2->operations.size()) {
     return false;
   }
-  /* TODO(sergey): Currently we only do real stupid check,
-   * which is fast but which isn't 100% reliable.
-   *
-   * Would be cool to make it more robust, but it's good enough
-   * for now. Also, proper graph check is actually NP-complex
-   * problem. */
+  /* Operations are matched by their identifiers, which are unique within a graph, so the graphs
+   * are compared without having to solve graph isomorphism. */
+  blender::Map<std::string, const deg::OperationNode *> operations_by_key;
+  for (const deg::OperationNode *operation_node : deg_graph2->operations) {
+    operations_by_key.add(deg::debug_operation_key(operation_node), operation_node);
+  }
+  for (const deg::OperationNode *operation_node1 : deg_graph1->operations) {
+    const std::string key = deg::debug_operation_key(operation_node1);
+    const deg::OperationNode *operation_node2 = operations_by_key.lookup_default(key, nullptr);
+    if (operation_node2 == nullptr) {
+      fprintf(stderr, "Operation %s is missing in the other graph.\n", key.c_str());
+      return false;
+    }
+    if (deg::debug_relation_keys(operation_node1->inlinks, false) !=
+            deg::debug_relation_keys(operation_node2->inlinks, false) ||
+        deg::debug_relation_keys(operation_node1->outlinks, true) !=
+            deg::debug_relation_keys(operation_node2->outlinks, true))
+    {
+      fprintf(stderr, "Relations of operation %s differ between graphs.\n", key.c_str());
+      return false;
+    }
+  }
   return true;
 }
 
@@ -224,6 +288,141 @@ void DEG_stats_simple(const Depsgraph *graph,
   }
 }
 
+namespace blender::deg {
+
+static void debug_foreach_customdata_buffer(const CustomData &data,
+                                            const int totelem,
+                                            const FunctionRef<void(const void *, size_t)> fn)
+{
+  for (const CustomDataLayer &layer : Span(data.layers, data.totlayer)) {
+    if (layer.data != nullptr) {
+      fn(layer.data, size_t(CustomData_sizeof(eCustomDataType(layer.type))) * totelem);
+    }
+  }
+}
+
+static void debug_foreach_mem_buffer(const void *data,
+                                     const FunctionRef<void(const void *, size_t)> fn)
+{
+  if (data != nullptr) {
+    fn(data, MEM_allocN_len(data));
+  }
+}
+
+/* Call the function for all large buffers owned (or shared) by the data-block. Buffers that are
+ * shared between data-blocks with implicit sharing have the same address. */
+static void debug_foreach_id_buffer(const ID *id, const FunctionRef<void(const void *, size_t)> fn)
+{
+  switch (GS(id->name)) {
+    case ID_ME: {
+      const Mesh *mesh = reinterpret_cast<const Mesh *>(id);
+      debug_foreach_customdata_buffer(mesh->vert_data, mesh->verts_num, fn);
+      debug_foreach_customdata_buffer(mesh->edge_data, mesh->edges_num, fn);
+      debug_foreach_customdata_buffer(mesh->face_data, mesh->faces_num, fn);
+      debug_foreach_customdata_buffer(mesh->corner_data, mesh->corners_num, fn);
+      if (mesh->face_offset_indices != nullptr) {
+        fn(mesh->face_offset_indices, sizeof(int) * (mesh->faces_num + 1));
+      }
+      break;
+    }
+    case ID_CV: {
+      const Curves *curves = reinterpret_cast<const Curves *>(id);
+      debug_foreach_customdata_buffer(curves->geometry.point_data, curves->geometry.point_num, fn);
+      debug_foreach_customdata_buffer(curves->geometry.curve_data, curves->geometry.curve_num, fn);
+      if (curves->geometry.curve_offsets != nullptr) {
+        fn(curves->geometry.curve_offsets, sizeof(int) * (curves->geometry.curve_num + 1));
+      }
+      break;
+    }
+    case ID_PT: {
+      const PointCloud *pointcloud = reinterpret_cast<const PointCloud *>(id);
+      debug_foreach_customdata_buffer(pointcloud->pdata, pointcloud->totpoint, fn);
+      break;
+    }
+    case ID_KE: {
+      const Key *key = reinterpret_cast<const Key *>(id);
+      LISTBASE_FOREACH (const KeyBlock *, kb, &key->block) {
+        debug_foreach_mem_buffer(kb->data, fn);
+      }
+      break;
+    }
+    case ID_LT: {
+      const Lattice *lattice = reinterpret_cast<const Lattice *>(id);
+      debug_foreach_mem_buffer(lattice->def, fn);
+      debug_foreach_mem_buffer(lattice->dvert, fn);
+      break;
+    }
+    case ID_CU_LEGACY: {
+      const Curve *curve = reinterpret_cast<const Curve *>(id);
+      LISTBASE_FOREACH (const Nurb *, nu, &curve->nurb) {
+        debug_foreach_mem_buffer(nu->bezt, fn);
+        debug_foreach_mem_buffer(nu->bp, fn);
+      }
+      break;
+    }
+    default:
+      break;
+  }
+}
+
+}  // namespace blender::deg
+
+void DEG_stats_memory(const Depsgraph *graph,
+                      size_t *r_original,
+                      size_t *r_evaluated,
+                      size_t *r_shared)
+{
+  const deg::Depsgraph *deg_graph = reinterpret_cast<const deg::Depsgraph *>(graph);
+  size_t original = 0;
+  size_t evaluated = 0;
+  size_t shared = 0;
+  for (const deg::IDNode *id_node : deg_graph->id_nodes) {
+    blender::Set<const void *> original_buffers;
+    deg::debug_foreach_id_buffer(id_node->id_orig, [&](const void *data, const size_t size) {
+      original_buffers.add(data);
+      original += size;
+    });
+    if (id_node->id_cow == nullptr || id_node->id_cow == id_node->id_orig) {
+      continue;
+    }
+    deg::debug_foreach_id_buffer(id_node->id_cow, [&](const void *data, const size_t size) {
+      if (original_buffers.contains(data)) {
+        shared += size;
+      }
+      else {
+        evaluated += size;
+      }
+    });
+  }
+  *r_original = original;
+  *r_evaluated = evaluated;
+  *r_shared = shared;
+}
+
+void DEG_debug_trace_begin(Depsgraph *graph)
+{
+  deg::Depsgraph *deg_graph = reinterpret_cast<deg::Depsgraph *>(graph);
+  deg_graph->debug.trace_begin();
+}
+
+void DEG_debug_trace_end(Depsgraph *graph, FILE *fp)
+{
+  deg::Depsgraph *deg_graph = reinterpret_cast<deg::Depsgraph *>(graph);
+  deg_graph->debug.trace_end(fp);
+}
+
+void DEG_debug_trace_event_add(const char *name,
+                               const char *category,
+                               const double start_time,
+                               const double duration)
+{
+  deg::DepsgraphDebug *debug = deg::DepsgraphDebug::active_trace;
+  if (debug == nullptr) {
+    return;
+  }
+  debug->trace_event_add(name, category, start_time, duration);
+}
+
 static deg::string depsgraph_name_for_logging(Depsgraph *depsgraph)
 {
   const char *name = DEG_debug_name_get(depsgraph);
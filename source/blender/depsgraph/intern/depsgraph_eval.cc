@@ -10,15 +10,23 @@
 
 #include "MEM_guardedalloc.h"
 
+#include <algorithm>
+
 #include "BLI_listbase.h"
+#include "BLI_task.hh"
 #include "BLI_utildefines.h"
+#include "BLI_vector.hh"
 
+#include "BKE_node_runtime.hh"
+#include "BKE_pointcache.h"
 #include "BKE_scene.hh"
 
+#include "DNA_node_types.h"
 #include "DNA_object_types.h"
 #include "DNA_scene_types.h"
 
 #include "DEG_depsgraph.hh"
+#include "DEG_depsgraph_build.hh"
 #include "DEG_depsgraph_query.hh"
 #include "DEG_depsgraph_writeback_sync.hh"
 
@@ -29,9 +37,15 @@
 #include "intern/node/deg_node_operation.hh"
 #include "intern/node/deg_node_time.hh"
 
+#include "intern/node/deg_node_id.hh"
+
 #include "intern/depsgraph.hh"
 #include "intern/depsgraph_tag.hh"
 
+#ifdef WITH_PYTHON
+#  include "BPY_extern.h"
+#endif
+
 namespace deg = blender::deg;
 
 static void deg_flush_updates_and_refresh(deg::Depsgraph *deg_graph,
@@ -92,3 +106,87 @@ void DEG_evaluate_on_framechange(Depsgraph *graph,
   deg_graph->ctime = BKE_scene_frame_to_ctime(scene, frame);
   deg_flush_updates_and_refresh(deg_graph, sync_writeback);
 }
+
+bool DEG_frames_are_independent(const Depsgraph *graph)
+{
+  const deg::Depsgraph *deg_graph = reinterpret_cast<const deg::Depsgraph *>(graph);
+  Scene *scene = deg_graph->scene;
+  if (scene->rigidbody_world != nullptr) {
+    return false;
+  }
+  for (const deg::IDNode *id_node : deg_graph->id_nodes) {
+    ID *id = id_node->id_orig;
+    switch (GS(id->name)) {
+      case ID_OB:
+        if (BKE_ptcache_object_has(scene, reinterpret_cast<Object *>(id), 0)) {
+          return false;
+        }
+        break;
+      case ID_NT: {
+        const bNodeTree *ntree = reinterpret_cast<const bNodeTree *>(id);
+        /* The flag is propagated from node groups to the trees using them. */
+        if (ntree->runtime->runtime_flag & NTREE_RUNTIME_FLAG_HAS_SIMULATION_ZONE) {
+          return false;
+        }
+        break;
+      }
+      default:
+        break;
+    }
+  }
+  return true;
+}
+
+void DEG_evaluate_frames_parallel(Main *bmain,
+                                  Scene *scene,
+                                  ViewLayer *view_layer,
+                                  const eEvaluationMode mode,
+                                  const blender::Span<float> frames,
+                                  int graphs_num,
+                                  const blender::FunctionRef<void(Depsgraph *, float)> frame_fn)
+{
+  using namespace blender;
+  if (frames.is_empty()) {
+    return;
+  }
+
+  /* Graphs are built up-front from the calling thread, building accesses the original data in
+   * ways which are not thread-safe. */
+  Vector<Depsgraph *> graphs;
+  graphs.append(DEG_graph_new(bmain, scene, view_layer, mode));
+  DEG_graph_build_from_view_layer(graphs.first());
+  if (!DEG_frames_are_independent(graphs.first())) {
+    graphs_num = 1;
+  }
+  graphs_num = std::clamp(graphs_num, 1, int(frames.size()));
+  for (int i = 1; i < graphs_num; i++) {
+    graphs.append(DEG_graph_new(bmain, scene, view_layer, mode));
+    DEG_graph_build_from_view_layer(graphs.last());
+  }
+
+#ifdef WITH_PYTHON
+  /* Release the GIL so that Python drivers can be evaluated from the other threads, while this
+   * one waits for them. */
+  BPy_BEGIN_ALLOW_THREADS;
+#endif
+
+  threading::parallel_for(graphs.index_range(), 1, [&](const IndexRange range) {
+    for (const int graph_index : range) {
+      Depsgraph *graph = graphs[graph_index];
+      const int64_t frames_start = frames.size() * graph_index / graphs_num;
+      const int64_t frames_end = frames.size() * (graph_index + 1) / graphs_num;
+      for (const float frame : frames.slice(frames_start, frames_end - frames_start)) {
+        DEG_evaluate_on_framechange(graph, frame);
+        frame_fn(graph, frame);
+      }
+    }
+  });
+
+#ifdef WITH_PYTHON
+  BPy_END_ALLOW_THREADS;
+#endif
+
+  for (Depsgraph *graph : graphs) {
+    DEG_graph_free(graph);
+  }
+}
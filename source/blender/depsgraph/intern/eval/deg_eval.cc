@@ -10,12 +10,19 @@
 
 #include "intern/eval/deg_eval.h"
 
+#include <algorithm>
+
+#include "MEM_guardedalloc.h"
+
+#include "BLI_array.hh"
 #include "BLI_compiler_attrs.h"
 #include "BLI_function_ref.hh"
 #include "BLI_gsqueue.h"
 #include "BLI_task.h"
 #include "BLI_time.h"
+#include "BLI_trace.hh"
 #include "BLI_utildefines.h"
+#include "BLI_vector.hh"
 
 #include "BKE_global.hh"
 
@@ -83,6 +90,11 @@ struct DepsgraphEvalState {
   EvaluationStage stage;
   bool need_update_pending_parents = true;
   bool need_single_thread_pass = false;
+
+  /* Operations in the order they were scheduled in, which is a topological order of the evaluated
+   * part of the graph. Used to update the critical path costs once evaluation is done. */
+  Array<OperationNode *> scheduled_operations;
+  uint32_t num_scheduled_operations = 0;
 };
 
 void evaluate_node(const DepsgraphEvalState *state, OperationNode *operation_node)
@@ -91,15 +103,31 @@ void evaluate_node(const DepsgraphEvalState *state, OperationNode *operation_nod
 
   /* Sanity checks. */
   BLI_assert_msg(!operation_node->is_noop(), "NOOP nodes should not actually be scheduled");
-  /* Perform operation. */
-  if (state->do_stats) {
-    const double start_time = BLI_time_now_seconds();
-    operation_node->evaluate(depsgraph);
-    operation_node->stats.current_time += BLI_time_now_seconds() - start_time;
+  /* Perform operation. The cost is always measured since it is used for scheduling priorities in
+   * the next evaluation, timing is cheap compared to an operation. */
+  DepsgraphDebug &debug = state->graph->debug;
+  /* Restored afterwards since other operations might run on this thread while this one waits for
+   * its own tasks. */
+  DepsgraphDebug *prev_active_trace = DepsgraphDebug::active_trace;
+  if (debug.do_trace) {
+    DepsgraphDebug::active_trace = &debug;
   }
-  else {
+  const double start_time = BLI_time_now_seconds();
+  {
+    /* Nested subsystems like geometry nodes use their own tag. */
+    MEM_TagScope mem_tag_scope(MEM_TAG_DEPSGRAPH);
+    TRACE_SCOPE("Depsgraph::evaluate_operation");
     operation_node->evaluate(depsgraph);
   }
+  const double eval_time = BLI_time_now_seconds() - start_time;
+  operation_node->eval_cost = float(eval_time);
+  if (state->do_stats) {
+    operation_node->stats.current_time += eval_time;
+  }
+  if (debug.do_trace) {
+    DepsgraphDebug::active_trace = prev_active_trace;
+    debug.trace_event_add(operation_node->full_identifier(), "operation", start_time, eval_time);
+  }
 
   /* Clear the flag early on, allowing partial updates without re-evaluating the same node multiple
    * times.
@@ -113,14 +141,26 @@ void deg_task_run_func(TaskPool *pool, void *taskdata)
   void *userdata_v = BLI_task_pool_user_data(pool);
   DepsgraphEvalState *state = (DepsgraphEvalState *)userdata_v;
 
-  /* Evaluate node. */
   OperationNode *operation_node = reinterpret_cast<OperationNode *>(taskdata);
-  evaluate_node(state, operation_node);
+  while (operation_node != nullptr) {
+    /* Evaluate node. */
+    evaluate_node(state, operation_node);
 
-  /* Schedule children. */
-  schedule_children(state, operation_node, [&](OperationNode *node) {
-    BLI_task_pool_push(pool, deg_task_run_func, node, false, nullptr);
-  });
+    /* Schedule children. The one with the most expensive path ahead of it is evaluated right away
+     * on this thread, so that the critical path does not wait in the pool behind cheap tasks. */
+    OperationNode *next_node = nullptr;
+    schedule_children(state, operation_node, [&](OperationNode *node) {
+      if (next_node == nullptr) {
+        next_node = node;
+        return;
+      }
+      if (node->critical_path_cost > next_node->critical_path_cost) {
+        std::swap(node, next_node);
+      }
+      BLI_task_pool_push(pool, deg_task_run_func, node, false, nullptr);
+    });
+    operation_node = next_node;
+  }
 }
 
 bool check_operation_node_visible(const DepsgraphEvalState *state, OperationNode *op_node)
@@ -268,6 +308,9 @@ void schedule_node(DepsgraphEvalState *state,
   /* Actually schedule the node. */
   bool is_scheduled = atomic_fetch_and_or_uint8((uint8_t *)&node->scheduled, uint8_t(true));
   if (!is_scheduled) {
+    const uint32_t index = atomic_fetch_and_add_uint32(&state->num_scheduled_operations, 1);
+    state->scheduled_operations[index] = node;
+
     if (node->is_noop()) {
       /* Clear flags to avoid affecting subsequent update propagation.
        * For normal nodes these are cleared when it is evaluated. */
@@ -317,9 +360,17 @@ void evaluate_graph_threaded_stage(DepsgraphEvalState *state,
 
   calculate_pending_parents_if_needed(state);
 
-  schedule_graph(state, [&](OperationNode *node) {
+  /* Push the operations which start the most expensive chains first, so that they are picked up
+   * before the cheap ones. */
+  Vector<OperationNode *> ready_nodes;
+  schedule_graph(state, [&](OperationNode *node) { ready_nodes.append(node); });
+  std::stable_sort(
+      ready_nodes.begin(), ready_nodes.end(), [](const OperationNode *a, const OperationNode *b) {
+        return a->critical_path_cost > b->critical_path_cost;
+      });
+  for (OperationNode *node : ready_nodes) {
     BLI_task_pool_push(task_pool, deg_task_run_func, node, false, nullptr);
-  });
+  }
   BLI_task_pool_work_and_wait(task_pool);
 }
 
@@ -351,6 +402,47 @@ void evaluate_graph_single_threaded_if_needed(DepsgraphEvalState *state)
   BLI_gsqueue_free(evaluation_queue);
 }
 
+/* Update the critical path costs of the evaluated operations for the next evaluation. Walking them
+ * in reverse scheduling order handles children before their parents. Children which were not
+ * evaluated keep their cost from an earlier evaluation, which is the best estimate available. */
+void update_critical_path_costs(DepsgraphEvalState *state)
+{
+  for (int i = int(state->num_scheduled_operations) - 1; i >= 0; i--) {
+    OperationNode *node = state->scheduled_operations[i];
+    float children_cost = 0.0f;
+    for (Relation *rel : node->outlinks) {
+      if (rel->flag & RELATION_FLAG_CYCLIC) {
+        continue;
+      }
+      const OperationNode *child = (OperationNode *)rel->to;
+      children_cost = std::max(children_cost, child->critical_path_cost);
+    }
+    node->critical_path_cost = node->eval_cost + children_cost;
+  }
+}
+
+void gather_evaluation_stats(const DepsgraphEvalState *state, const double wall_time)
+{
+  DepsgraphDebug::EvaluationStats &stats = state->graph->debug.evaluation_stats;
+  stats.num_operations = 0;
+  stats.num_threads = (G.debug & G_DEBUG_DEPSGRAPH_NO_THREADS) ?
+                          1 :
+                          BLI_task_scheduler_num_threads();
+  stats.busy_time = 0.0;
+  stats.wall_time = wall_time;
+  stats.critical_path_time = 0.0;
+  for (const int i : IndexRange(state->num_scheduled_operations)) {
+    const OperationNode *node = state->scheduled_operations[i];
+    if (node->is_noop()) {
+      continue;
+    }
+    stats.num_operations++;
+    stats.busy_time += node->eval_cost;
+    stats.critical_path_time = std::max(stats.critical_path_time,
+                                        double(node->critical_path_cost));
+  }
+}
+
 void depsgraph_ensure_view_layer(Depsgraph *graph)
 {
   /* We update evaluated scene in the following cases:
@@ -388,7 +480,9 @@ void deg_evaluate_on_refresh(Depsgraph *graph)
 
   graph->update_count++;
 
+  TRACE_SCOPE("Depsgraph::evaluate");
   graph->debug.begin_graph_evaluation();
+  const double trace_start_time = graph->debug.do_trace ? BLI_time_now_seconds() : 0.0;
 
 #ifdef WITH_PYTHON
   /* Release the GIL so that Python drivers can be evaluated. See #91046. */
@@ -402,6 +496,7 @@ void deg_evaluate_on_refresh(Depsgraph *graph)
   DepsgraphEvalState state;
   state.graph = graph;
   state.do_stats = graph->debug.do_time_debug();
+  state.scheduled_operations.reinitialize(graph->operations.size());
 
   /* Prepare all nodes for evaluation. */
   initialize_execution(&state, graph);
@@ -421,7 +516,12 @@ void deg_evaluate_on_refresh(Depsgraph *graph)
    *   safe from threading point of view, so the threaded evaluation will stop at the metaball
    *   operation node.
    *
-   * - Single-threaded pass of all remaining operations. */
+   * - Single-threaded pass of all remaining operations.
+   *
+   * Within the threaded stages, operations on the most expensive chains of the previous
+   * evaluation are dispatched first (see #OperationNode::critical_path_cost). */
+
+  const double eval_start_time = BLI_time_now_seconds();
 
   TaskPool *task_pool = deg_evaluate_task_pool_create(&state);
 
@@ -450,21 +550,33 @@ void deg_evaluate_on_refresh(Depsgraph *graph)
 
   evaluate_graph_single_threaded_if_needed(&state);
 
+  update_critical_path_costs(&state);
+
   /* Finalize statistics gathering. This is because we only gather single
    * operation timing here, without aggregating anything to avoid any extra
    * synchronization. */
   if (state.do_stats) {
     deg_eval_stats_aggregate(graph);
+    gather_evaluation_stats(&state, BLI_time_now_seconds() - eval_start_time);
   }
 
   /* Clear any uncleared tags. */
   deg_graph_clear_tags(graph);
   graph->is_evaluating = false;
 
+  TRACE_COUNTER("Memory in use", MEM_get_memory_in_use());
+
 #ifdef WITH_PYTHON
   BPy_END_ALLOW_THREADS;
 #endif
 
+  if (graph->debug.do_trace) {
+    graph->debug.trace_event_add("Evaluation (frame " + to_string(graph->frame) + ")",
+                                 "evaluation",
+                                 trace_start_time,
+                                 BLI_time_now_seconds() - trace_start_time);
+  }
+
   graph->debug.end_graph_evaluation();
 }
 
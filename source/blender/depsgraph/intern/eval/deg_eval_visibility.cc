@@ -88,6 +88,18 @@ void deg_evaluate_object_modifiers_mode_node_visibility(::Depsgraph *depsgraph,
   }
 }
 
+/* Whether the component is to be evaluated when its ID is visible, as opposed to only when other
+ * evaluated components depend on it. */
+static bool is_component_requested(const Depsgraph *graph,
+                                   const IDNode *id_node,
+                                   const ComponentNode *comp_node)
+{
+  if (graph->requested_object_components == 0 || id_node->id_type != ID_OB) {
+    return true;
+  }
+  return graph->requested_object_components & (uint64_t(1) << int(comp_node->type));
+}
+
 void deg_graph_flush_visibility_flags(Depsgraph *graph)
 {
   enum {
@@ -97,7 +109,8 @@ void deg_graph_flush_visibility_flags(Depsgraph *graph)
   for (IDNode *id_node : graph->id_nodes) {
     for (ComponentNode *comp_node : id_node->components.values()) {
       comp_node->possibly_affects_visible_id = id_node->is_visible_on_build;
-      comp_node->affects_visible_id = id_node->is_visible_on_build && id_node->is_enabled_on_eval;
+      comp_node->affects_visible_id = id_node->is_visible_on_build && id_node->is_enabled_on_eval &&
+                                      is_component_requested(graph, id_node, comp_node);
 
       /* Visibility component is always to be considered to have the same visibility as the
        * `id_node->is_visible_on_build`. This is because the visibility is to be evaluated
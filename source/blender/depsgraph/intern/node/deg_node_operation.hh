@@ -281,6 +281,12 @@ struct OperationNode : public Node {
   uint32_t num_links_pending;
   bool scheduled;
 
+  /* Time in seconds the last evaluation of this operation took. */
+  float eval_cost;
+  /* Cost of the most expensive chain of operations starting at this one, including its own cost,
+   * as of the last evaluation. Used to dispatch operations on the critical path first. */
+  float critical_path_cost;
+
   /* Identifier for the operation being performed. */
   OperationCode opcode;
   int name_tag;
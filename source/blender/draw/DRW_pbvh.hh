@@ -97,6 +97,22 @@ struct PBVH_GPU_Args {
 };
 
 void node_update(PBVHBatches *batches, const PBVH_GPU_Args &args);
+
+/** Which attribute buffers to refill in #node_update_attributes. */
+struct AttributeUpdate {
+  bool mask = false;
+  bool face_sets = false;
+  /** Color and other generic attributes. */
+  bool generic = false;
+};
+
+/**
+ * Only refill the buffers of the given attributes, when the positions, normals and topology of
+ * the node are unchanged. This avoids re-uploading the other buffers to the GPU.
+ */
+void node_update_attributes(PBVHBatches *batches,
+                            const PBVH_GPU_Args &args,
+                            const AttributeUpdate &update);
 void update_pre(PBVHBatches *batches, const PBVH_GPU_Args &args);
 
 void node_gpu_flush(PBVHBatches *batches);
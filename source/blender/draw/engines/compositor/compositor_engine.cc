@@ -164,6 +164,7 @@ class Context : public realtime_compositor::Context {
   {
     switch (get_node_tree().precision) {
       case NODE_TREE_COMPOSITOR_PRECISION_AUTO:
+      case NODE_TREE_COMPOSITOR_PRECISION_HALF:
         return realtime_compositor::ResultPrecision::Half;
       case NODE_TREE_COMPOSITOR_PRECISION_FULL:
         return realtime_compositor::ResultPrecision::Full;
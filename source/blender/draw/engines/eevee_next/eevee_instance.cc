@@ -13,6 +13,7 @@
 #include "BKE_global.hh"
 #include "BKE_object.hh"
 #include "BLI_rect.h"
+#include "BLI_time.h"
 #include "DEG_depsgraph_query.hh"
 #include "DNA_ID.h"
 #include "DNA_lightprobe_types.h"
@@ -665,15 +666,22 @@ void Instance::light_bake_irradiance(
     return;
   }
 
+  /* Batch ray casts to avoid too much overhead of the update function & context switch.
+   * The batch size is adjusted so that each batch takes about the same time. This keeps the
+   * progressive result updating at a steady rate and bounds the time the GPU context is held,
+   * which matters when it is shared with the UI. */
+  const double batch_time_target = 0.1;
+  const int batch_size_max = 64;
+  int batch_size = 4;
+
   sampling.init(probe);
   while (!sampling.finished()) {
+    const double batch_start_time = BLI_time_now_seconds();
+
     context_wrapper([&]() {
       DebugScope debug_scope(debug_scope_irradiance_sample, "EEVEE.irradiance_sample");
 
-      /* Batch ray cast by pack of 16. Avoids too much overhead of the update function & context
-       * switch. */
-      /* TODO(fclem): Could make the number of iteration depend on the computation time. */
-      for (int i = 0; i < 16 && !sampling.finished(); i++) {
+      for (int i = 0; i < batch_size && !sampling.finished(); i++) {
         sampling.step();
 
         volume_probes.bake.raylists_build();
@@ -702,6 +710,12 @@ void Instance::light_bake_irradiance(
     if (stop()) {
       return;
     }
+
+    /* The result read-back synchronizes with the GPU, so this includes the GPU time. */
+    const double batch_time = BLI_time_now_seconds() - batch_start_time;
+    const double scale = batch_time_target / math::max(batch_time, 1e-4);
+    /* Limit growth to avoid oscillations caused by timing noise. */
+    batch_size = math::clamp(int(batch_size * math::min(scale, 2.0)), 1, batch_size_max);
   }
 }
 
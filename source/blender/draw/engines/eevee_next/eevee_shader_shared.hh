@@ -1146,7 +1146,11 @@ struct ShadowTileMapData {
   int clip_data_index;
   /** Bias LOD to tag for usage to lower the amount of tile used. */
   float lod_bias;
-  int _pad0;
+  /**
+   * True if every tile of this tile-map is going to be updated this sync cycle.
+   * Unlike `grid_shift`, this is not reset by the GPU setup phase.
+   */
+  bool32_t is_dirty;
   int _pad1;
   int _pad2;
   /** Near and far clip distances for punctual. */
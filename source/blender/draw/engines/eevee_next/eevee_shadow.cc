@@ -204,6 +204,7 @@ void ShadowTileMapPool::end_sync(ShadowModule &module)
       tilemap_data.tiles_index = index;
       tilemap_data.clip_data_index = -1;
       tilemap_data.grid_shift = int2(SHADOW_TILEMAP_RES);
+      tilemap_data.is_dirty = true;
       tilemap_data.projection_type = SHADOW_PROJECTION_CUBEFACE;
 
       tilemaps_unused.append(tilemap_data);
@@ -1413,9 +1414,8 @@ void ShadowModule::set_view(View &view, GPUTexture *depth_tx)
 
       inst_.manager->submit(tilemap_setup_ps_, view);
       if (assign_if_different(update_casters_, false)) {
-        /* Run caster update only once. */
-        /* TODO(fclem): There is an optimization opportunity here where we can
-         * test casters only against the static tilemaps instead of all of them. */
+        /* Run caster update only once. Tile-maps that are fully updated this cycle are skipped
+         * inside the shader (see #ShadowTileMapData::is_dirty). */
         inst_.manager->submit(caster_update_ps_, view);
       }
       if (assign_if_different(first_loop, false)) {
@@ -29,6 +29,11 @@ void main()
 {
   ShadowTileMapData tilemap = tilemaps_buf[gl_GlobalInvocationID.z];
 
+  if (tilemap.is_dirty) {
+    /* All tiles were already tagged for update by the setup phase. */
+    return;
+  }
+
   IsectPyramid frustum;
   if (tilemap.projection_type == SHADOW_PROJECTION_CUBEFACE) {
     Pyramid pyramid = shadow_tilemap_cubeface_bounds(tilemap, ivec2(0), ivec2(SHADOW_TILEMAP_RES));
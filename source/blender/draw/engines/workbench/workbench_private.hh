@@ -401,6 +401,7 @@ class ShadowPass {
    protected:
     virtual void compute_visibility(ObjectBoundsBuf &bounds,
                                     uint resource_len,
+                                    uint64_t sync_id,
                                     bool debug_freeze) override;
     virtual VisibilityBuf &get_visibility_buffer() override;
   } view_ = {};
@@ -209,6 +209,7 @@ void ShadowPass::ShadowView::set_mode(ShadowPass::PassType type)
 
 void ShadowPass::ShadowView::compute_visibility(ObjectBoundsBuf &bounds,
                                                 uint resource_len,
+                                                uint64_t /*sync_id*/,
                                                 bool /*debug_freeze*/)
 {
   /* TODO (Miguel Pozo): Add debug_freeze support */
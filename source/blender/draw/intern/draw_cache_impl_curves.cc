@@ -552,7 +552,7 @@ static void ensure_control_point_attribute(const Curves &curves,
       static_cast<ColorGeometry4f *>(GPU_vertbuf_get_data(attr_vbo)),
       attributes.domain_size(request.domain)};
 
-  attribute.varray.materialize(vbo_span);
+  array_utils::copy(attribute.varray, vbo_span);
 }
 
 static void ensure_final_attribute(const Curves &curves,
@@ -581,15 +581,17 @@ static void ensure_final_attribute(const Curves &curves,
 }
 
 static void fill_curve_offsets_vbos(const OffsetIndices<int> points_by_curve,
-                                    GPUVertBufRaw &data_step,
-                                    GPUVertBufRaw &seg_step)
+                                    const GPUVertBufRaw &data_step,
+                                    const GPUVertBufRaw &seg_step)
 {
-  for (const int i : points_by_curve.index_range()) {
-    const IndexRange points = points_by_curve[i];
+  threading::parallel_for(points_by_curve.index_range(), 4096, [&](const IndexRange range) {
+    for (const int i : range) {
+      const IndexRange points = points_by_curve[i];
 
-    *(uint *)GPU_vertbuf_raw_step(&data_step) = points.start();
-    *(ushort *)GPU_vertbuf_raw_step(&seg_step) = points.size() - 1;
-  }
+      *(uint *)(data_step.data + size_t(i) * data_step.stride) = points.start();
+      *(ushort *)(seg_step.data + size_t(i) * seg_step.stride) = points.size() - 1;
+    }
+  });
 }
 
 static void create_curve_offsets_vbos(const OffsetIndices<int> points_by_curve,
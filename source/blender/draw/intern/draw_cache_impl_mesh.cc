@@ -671,6 +671,49 @@ static void mesh_batch_cache_discard_shaded_tri(MeshBatchCache &cache)
   mesh_cd_layers_type_clear(&cache.cd_used);
 }
 
+/**
+ * Discard the buffers that depend on vertex positions, keeping everything that only depends on
+ * topology and attributes (selection indices, edit flags, loose geometry, UVs, etc.).
+ * Triangle index buffers are discarded too since the tessellation of n-gons can change.
+ */
+static void mesh_batch_cache_discard_deform(MeshBatchCache &cache)
+{
+  FOREACH_MESH_BUFFER_CACHE (cache, mbc) {
+    GPU_VERTBUF_DISCARD_SAFE(mbc->buff.vbo.pos);
+    GPU_VERTBUF_DISCARD_SAFE(mbc->buff.vbo.nor);
+    GPU_VERTBUF_DISCARD_SAFE(mbc->buff.vbo.vnor);
+    GPU_VERTBUF_DISCARD_SAFE(mbc->buff.vbo.edge_fac);
+    GPU_VERTBUF_DISCARD_SAFE(mbc->buff.vbo.tan);
+    GPU_VERTBUF_DISCARD_SAFE(mbc->buff.vbo.mesh_analysis);
+    GPU_VERTBUF_DISCARD_SAFE(mbc->buff.vbo.fdots_pos);
+    GPU_VERTBUF_DISCARD_SAFE(mbc->buff.vbo.fdots_nor);
+    GPU_VERTBUF_DISCARD_SAFE(mbc->buff.vbo.skin_roots);
+    GPU_VERTBUF_DISCARD_SAFE(mbc->buff.vbo.edituv_stretch_area);
+    GPU_VERTBUF_DISCARD_SAFE(mbc->buff.vbo.edituv_stretch_angle);
+    GPU_INDEXBUF_DISCARD_SAFE(mbc->buff.ibo.tris);
+    GPU_INDEXBUF_DISCARD_SAFE(mbc->buff.ibo.edituv_tris);
+  }
+  /* Sub-ranges of the triangle index buffer. */
+  for (int i = 0; i < cache.mat_len; i++) {
+    GPU_INDEXBUF_DISCARD_SAFE(cache.tris_per_mat[i]);
+  }
+  DRWBatchFlag batch_map = BATCH_MAP(vbo.pos,
+                                     vbo.nor,
+                                     vbo.vnor,
+                                     vbo.edge_fac,
+                                     vbo.tan,
+                                     vbo.mesh_analysis,
+                                     vbo.fdots_pos,
+                                     vbo.fdots_nor,
+                                     vbo.skin_roots);
+  batch_map |= BATCH_MAP(
+      vbo.edituv_stretch_area, vbo.edituv_stretch_angle, ibo.tris, ibo.edituv_tris);
+  batch_map |= batches_that_use_buffer(TRIS_PER_MAT_INDEX);
+  mesh_batch_cache_discard_batch(cache, batch_map);
+
+  cache.tot_area = 0.0f;
+}
+
 static void mesh_batch_cache_discard_uvedit(MeshBatchCache &cache)
 {
   FOREACH_MESH_BUFFER_CACHE (cache, mbc) {
@@ -774,6 +817,14 @@ void DRW_mesh_batch_cache_dirty_tag(Mesh *mesh, eMeshBatchDirtyMode mode)
       batch_map = BATCH_MAP(vbo.edituv_data, vbo.fdots_edituv_data);
       mesh_batch_cache_discard_batch(cache, batch_map);
       break;
+    case BKE_MESH_BATCH_DIRTY_DEFORM:
+      if (cache.subdiv_cache) {
+        /* The GPU subdivision buffers are evaluated from the positions as a whole. */
+        cache.is_dirty = true;
+        break;
+      }
+      mesh_batch_cache_discard_deform(cache);
+      break;
     default:
       BLI_assert(0);
   }
@@ -7,6 +7,7 @@
  */
 
 #include "BKE_global.hh"
+#include "BKE_image.h"
 #include "GPU_compute.hh"
 
 #include "draw_debug.hh"
@@ -18,6 +19,20 @@
 
 namespace blender::draw {
 
+void material_images_preload(GPUMaterial *material)
+{
+  Vector<::Image *> images;
+  Vector<::ImageUser *> iusers;
+  ListBase textures = GPU_material_textures(material);
+  LISTBASE_FOREACH (GPUMaterialTexture *, tex, &textures) {
+    if (tex->ima) {
+      images.append(tex->ima);
+      iusers.append(tex->iuser_available ? &tex->iuser : nullptr);
+    }
+  }
+  BKE_image_preload_gpu_textures(images.data(), iusers.data(), images.size());
+}
+
 Manager::~Manager()
 {
   for (GPUTexture *texture : acquired_textures) {
@@ -113,6 +128,7 @@ void Manager::end_sync()
   attributes_buf.push_update();
   layer_attributes_buf.push_update();
   attributes_buf_legacy.push_update();
+  sync_id_++;
 
   /* Useful for debugging the following resource finalize. But will trigger the drawing of the GPU
    * debug draw/print buffers for every frame. Not nice for performance. */
@@ -185,7 +201,7 @@ void Manager::submit(PassMain &pass, View &view)
   bool freeze_culling = (U.experimental.use_viewport_debug && DST.draw_ctx.v3d &&
                          (DST.draw_ctx.v3d->debug_flag & V3D_DEBUG_FREEZE_CULLING) != 0);
 
-  view.compute_visibility(bounds_buf.current(), resource_len_, freeze_culling);
+  view.compute_visibility(bounds_buf.current(), resource_len_, sync_id_, freeze_culling);
 
   command::RecordingState state;
   state.inverted_view = view.is_inverted();
@@ -110,6 +110,8 @@ class Manager {
   uint resource_len_ = 0;
   /** Number of object attribute recorded. */
   uint attribute_len_ = 0;
+  /** Incremented each time the resource buffers are uploaded. Used for caching view visibility. */
+  uint64_t sync_id_ = 0;
 
   Object *object_active = nullptr;
 
@@ -323,6 +325,12 @@ inline void Manager::register_layer_attributes(GPUMaterial *material)
   }
 }
 
+/**
+ * Load the images of all image textures used by the material in parallel, so that binding the
+ * material resources doesn't decode them one after another on the drawing thread.
+ */
+void material_images_preload(GPUMaterial *material);
+
 }  // namespace blender::draw
 
 /* TODO(@fclem): This is for testing. The manager should be passed to the engine through the
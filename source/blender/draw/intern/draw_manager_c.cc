@@ -15,6 +15,7 @@
 #include "BLI_string.h"
 #include "BLI_task.h"
 #include "BLI_threads.h"
+#include "BLI_trace.hh"
 
 #include "BLF_api.hh"
 
@@ -1641,6 +1642,7 @@ void DRW_draw_render_loop_ex(Depsgraph *depsgraph,
                              const bContext *evil_C)
 {
   using namespace blender::draw;
+  TRACE_SCOPE("DRW::draw_render_loop");
   Scene *scene = DEG_get_evaluated_scene(depsgraph);
   ViewLayer *view_layer = DEG_get_evaluated_view_layer(depsgraph);
   RegionView3D *rv3d = static_cast<RegionView3D *>(region->regiondata);
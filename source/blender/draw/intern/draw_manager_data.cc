@@ -9,6 +9,7 @@
 #include "DRW_pbvh.hh"
 
 #include "draw_attributes.hh"
+#include "draw_manager.hh"
 #include "draw_manager_c.hh"
 #include "draw_pbvh.hh"
 
@@ -1816,6 +1817,7 @@ void DRW_shgroup_add_material_resources(DRWShadingGroup *grp, GPUMaterial *mater
   ListBase textures = GPU_material_textures(material);
 
   /* Bind all textures needed by the material. */
+  blender::draw::material_images_preload(material);
   LISTBASE_FOREACH (GPUMaterialTexture *, tex, &textures) {
     if (tex->ima) {
       const bool use_tile_mapping = tex->tiled_mapping_name[0];
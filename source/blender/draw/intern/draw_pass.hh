@@ -934,6 +934,7 @@ template<class T> inline void PassBase<T>::material_set(Manager &manager, GPUMat
   shader_set(GPU_pass_shader_get(gpupass));
 
   /* Bind all textures needed by the material. */
+  material_images_preload(material);
   ListBase textures = GPU_material_textures(material);
   for (GPUMaterialTexture *tex : ListBaseWrapper<GPUMaterialTexture>(textures)) {
     if (tex->ima) {
@@ -811,6 +811,25 @@ struct PBVHBatches {
     }
   }
 
+  void update_attributes(const PBVH_GPU_Args &args, const AttributeUpdate &update)
+  {
+    if (!lines_index) {
+      create_index(args);
+    }
+    for (PBVHVbo &vbo : vbos) {
+      if (const CustomRequest *request_type = std::get_if<CustomRequest>(&vbo.request)) {
+        if ((*request_type == CustomRequest::Mask && update.mask) ||
+            (*request_type == CustomRequest::FaceSet && update.face_sets))
+        {
+          fill_vbo(vbo, args);
+        }
+      }
+      else if (update.generic) {
+        fill_vbo(vbo, args);
+      }
+    }
+  }
+
   void fill_vbo_bmesh(PBVHVbo &vbo, const PBVH_GPU_Args &args)
   {
     faces_count = tris_count = count_faces(args);
@@ -1388,6 +1407,13 @@ void node_update(PBVHBatches *batches, const PBVH_GPU_Args &args)
   batches->update(args);
 }
 
+void node_update_attributes(PBVHBatches *batches,
+                            const PBVH_GPU_Args &args,
+                            const AttributeUpdate &update)
+{
+  batches->update_attributes(args, update);
+}
+
 void node_gpu_flush(PBVHBatches *batches)
 {
   batches->gpu_flush();
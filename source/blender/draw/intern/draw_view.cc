@@ -31,6 +31,7 @@ void View::sync(const float4x4 &view_mat, const float4x4 &win_mat, int view_id)
   frustum_culling_sphere_calc(view_id);
 
   dirty_ = true;
+  visibility_dirty_ = true;
 }
 
 void View::sync(const DRWView *view)
@@ -236,6 +237,8 @@ void View::disable(IndexRange range)
   for (auto view_id : range) {
     reinterpret_cast<BoundSphere *>(&culling_[view_id].bound_sphere)->radius = -1.0f;
   }
+  dirty_ = true;
+  visibility_dirty_ = true;
 }
 
 void View::bind()
@@ -264,8 +267,27 @@ void View::compute_procedural_bounds()
   GPU_debug_group_end();
 }
 
-void View::compute_visibility(ObjectBoundsBuf &bounds, uint resource_len, bool debug_freeze)
+void View::compute_visibility(ObjectBoundsBuf &bounds,
+                              uint resource_len,
+                              uint64_t sync_id,
+                              bool debug_freeze)
 {
+  /* The same view is often submitted for many passes in a redraw. Reuse the previous result if
+   * neither the view nor the resources changed since then. Procedural views have their matrices
+   * updated on the GPU, so they always need to be recomputed. */
+  const bool visibility_valid = !visibility_dirty_ && !procedural_ &&
+                                visibility_sync_id_ == sync_id &&
+                                visibility_resource_len_ == resource_len &&
+                                visibility_bounds_ == std::addressof(bounds) &&
+                                frozen_ == debug_freeze;
+  if (visibility_valid) {
+    return;
+  }
+  visibility_dirty_ = false;
+  visibility_sync_id_ = sync_id;
+  visibility_resource_len_ = resource_len;
+  visibility_bounds_ = std::addressof(bounds);
+
   if (debug_freeze && frozen_ == false) {
     data_freeze_[0] = static_cast<ViewMatrices>(data_[0]);
     data_freeze_.push_update();
@@ -282,8 +304,6 @@ void View::compute_visibility(ObjectBoundsBuf &bounds, uint resource_len, bool d
 
   GPU_debug_group_begin("View.compute_visibility");
 
-  /* TODO(fclem): Early out if visibility hasn't changed. */
-
   uint word_per_draw = this->visibility_word_per_draw();
   /* Switch between tightly packed and set of whole word per instance. */
   uint words_len = (view_len_ == 1) ? divide_ceil_u(resource_len, 32) :
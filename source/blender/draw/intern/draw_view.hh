@@ -54,6 +54,15 @@ class View {
   bool frozen_ = false;
   bool procedural_ = false;
 
+  /**
+   * State of the last visibility computation, used to skip it when the same view is submitted
+   * multiple times with the same resources (see #compute_visibility).
+   */
+  bool visibility_dirty_ = true;
+  uint64_t visibility_sync_id_ = 0;
+  uint visibility_resource_len_ = 0;
+  const ObjectBoundsBuf *visibility_bounds_ = nullptr;
+
  public:
   View(const char *name, int view_len = 1, bool procedural = false)
       : visibility_buf_(name), debug_name_(name), view_len_(view_len), procedural_(procedural)
@@ -79,6 +88,9 @@ class View {
   /** Enable or disable every visibility test (frustum culling, HiZ culling). */
   void visibility_test(bool enable)
   {
+    if (do_visibility_ != enable) {
+      visibility_dirty_ = true;
+    }
     do_visibility_ = enable;
   }
 
@@ -176,7 +188,14 @@ class View {
  protected:
   /** Called from draw manager. */
   void bind();
-  virtual void compute_visibility(ObjectBoundsBuf &bounds, uint resource_len, bool debug_freeze);
+  /**
+   * \a sync_id identifies the content of \a bounds. It changes every time the manager uploads
+   * new resource data, allowing the result of a previous computation to be reused.
+   */
+  virtual void compute_visibility(ObjectBoundsBuf &bounds,
+                                  uint resource_len,
+                                  uint64_t sync_id,
+                                  bool debug_freeze);
   virtual VisibilityBuf &get_visibility_buffer();
 
   void update_viewport_size();
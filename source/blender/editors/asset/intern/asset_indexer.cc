@@ -288,6 +288,13 @@ static int init_indexer_entries_from_value(FileIndexerEntries &indexer_entries,
 struct AssetLibraryIndex {
   struct PreexistingFileIndexInfo {
     bool is_used = false;
+    /**
+     * File size and modification time from the directory listing, so checking whether an index
+     * is up to date doesn't have to access the file system again for every asset file. Libraries
+     * are often stored on network drives where each of these accesses has a noticeable latency.
+     */
+    size_t file_size = 0;
+    int64_t mtime = 0;
   };
 
   /**
@@ -371,7 +378,10 @@ struct AssetLibraryIndex {
     for (int i = 0; i < dir_entries_num; i++) {
       direntry *entry = &dir_entries[i];
       if (BLI_str_endswith(entry->relname, ".index.json")) {
-        this->preexisting_file_indices.add_as(std::string(entry->path));
+        PreexistingFileIndexInfo info;
+        info.file_size = size_t(entry->s.st_size);
+        info.mtime = int64_t(entry->s.st_mtime);
+        this->preexisting_file_indices.add(std::string(entry->path), info);
       }
     }
 
@@ -386,6 +396,11 @@ struct AssetLibraryIndex {
     }
   }
 
+  const PreexistingFileIndexInfo *lookup_preexisting(const std::string &filename) const
+  {
+    return this->preexisting_file_indices.lookup_ptr(filename);
+  }
+
   /**
    * Removes the file index from disk and #preexisting_file_indices (invalidating its iterators, so
    * don't call while iterating).
@@ -549,7 +564,16 @@ class AssetIndexFile : public AbstractFile {
    */
   bool is_older_than(const BlendFile &asset_file) const
   {
-    return BLI_file_older(this->get_file_path(), asset_file.get_file_path());
+    const AssetLibraryIndex::PreexistingFileIndexInfo *preexisting =
+        this->library_index.lookup_preexisting(this->filename);
+    if (preexisting == nullptr) {
+      return BLI_file_older(this->get_file_path(), asset_file.get_file_path());
+    }
+    BLI_stat_t stat = {};
+    if (BLI_stat(asset_file.get_file_path(), &stat) == -1) {
+      return false;
+    }
+    return preexisting->mtime < int64_t(stat.st_mtime);
   }
 
   /**
@@ -557,7 +581,9 @@ class AssetIndexFile : public AbstractFile {
    */
   bool constains_entries() const
   {
-    const size_t file_size = get_file_size();
+    const AssetLibraryIndex::PreexistingFileIndexInfo *preexisting =
+        this->library_index.lookup_preexisting(this->filename);
+    const size_t file_size = preexisting ? preexisting->file_size : get_file_size();
     return file_size >= MIN_FILE_SIZE_WITH_ENTRIES;
   }
 
@@ -598,7 +624,8 @@ int AssetLibraryIndex::remove_broken_index_files()
 {
   Set<StringRef> files_to_remove;
 
-  for (const std::string &index_path : this->preexisting_file_indices.keys()) {
+  for (const auto item : this->preexisting_file_indices.items()) {
+    const std::string &index_path = item.key;
     AssetIndexFile index_file(*this, index_path);
 
     /* Bug was causing empty index files, so non-empty ones can be skipped. */
@@ -621,11 +648,7 @@ int AssetLibraryIndex::remove_broken_index_files()
     tm_from.tm_mday = 3;           /* Day after fix. */
     std::time_t timestamp_from = std::mktime(&tm_from);
     std::time_t timestamp_to = std::mktime(&tm_to);
-    BLI_stat_t stat = {};
-    if (BLI_stat(index_file.get_file_path(), &stat) == -1) {
-      continue;
-    }
-    if (IN_RANGE(stat.st_mtime, timestamp_from, timestamp_to)) {
+    if (IN_RANGE(item.value.mtime, int64_t(timestamp_from), int64_t(timestamp_to))) {
       CLOG_INFO(&LOG, 2, "Remove potentially broken index file [%s].", index_path.c_str());
       files_to_remove.add(index_path);
     }
@@ -650,7 +673,9 @@ static eFileIndexerResult read_index(const char *filename,
   BlendFile asset_file(filename);
   AssetIndexFile asset_index_file(library_index, asset_file);
 
-  if (!asset_index_file.exists()) {
+  /* Use the directory listing from #AssetLibraryIndex::collect_preexisting_file_indices instead
+   * of accessing the file system. Indices written since then aren't read again in the same run. */
+  if (!library_index.lookup_preexisting(asset_index_file.filename)) {
     return FILE_INDEXER_NEEDS_UPDATE;
   }
 
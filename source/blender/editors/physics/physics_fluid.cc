@@ -425,6 +425,11 @@ static void fluid_bake_startjob(void *customdata, wmJobWorkerStatus *worker_stat
 
   fluid_bake_sequence(job);
 
+#ifdef WITH_FLUID
+  /* The bake is only complete when the last frames are written to disk. */
+  BKE_fluid_cache_flush_writes();
+#endif
+
   worker_status->do_update = true;
   worker_status->stop = false;
 }
@@ -387,11 +387,21 @@ struct EraseOperationExecutor {
     Array<PointCircleSide> src_point_side(src_points_num, PointCircleSide::Outside);
     Array<SegmentCircleIntersection> src_intersections(src_points_num *
                                                        intersections_max_per_segment);
-    curves_intersections_and_points_sides(src,
-                                          screen_space_positions,
-                                          intersections_max_per_segment,
-                                          src_point_side,
-                                          src_intersections);
+    const int total_intersections = curves_intersections_and_points_sides(
+        src,
+        screen_space_positions,
+        intersections_max_per_segment,
+        src_point_side,
+        src_intersections);
+
+    /* Most samples only touch a few of the drawings, skip rebuilding the others. */
+    if (total_intersections == 0 &&
+        std::all_of(src_point_side.begin(), src_point_side.end(), [](const PointCircleSide side) {
+          return side == PointCircleSide::Outside;
+        }))
+    {
+      return false;
+    }
 
     Array<Vector<ed::greasepencil::PointTransferData>> src_to_dst_points(src_points_num);
     const OffsetIndices<int> src_points_by_curve = src.points_by_curve();
@@ -2462,6 +2462,103 @@ void SCULPT_brush_strength_color(
   mul_v4_fl(r_rgba, masks_combined);
 }
 
+namespace blender::ed::sculpt_paint {
+
+void fill_factor_from_hide_and_mask(const Mesh &mesh,
+                                    const Span<int> verts,
+                                    const MutableSpan<float> r_factors)
+{
+  BLI_assert(verts.size() == r_factors.size());
+
+  const bke::AttributeAccessor attributes = mesh.attributes();
+  const VArraySpan mask = *attributes.lookup<float>(".sculpt_mask", bke::AttrDomain::Point);
+  if (!mask.is_empty()) {
+    for (const int i : verts.index_range()) {
+      r_factors[i] = 1.0f - mask[verts[i]];
+    }
+  }
+  else {
+    r_factors.fill(1.0f);
+  }
+
+  const VArraySpan hide_vert = *attributes.lookup<bool>(".hide_vert", bke::AttrDomain::Point);
+  if (!hide_vert.is_empty()) {
+    for (const int i : verts.index_range()) {
+      if (hide_vert[verts[i]]) {
+        r_factors[i] = 0.0f;
+      }
+    }
+  }
+}
+
+void calc_distance_falloff(SculptSession &ss,
+                           const Span<float3> vert_positions,
+                           const Span<int> verts,
+                           const char falloff_shape,
+                           const MutableSpan<float> r_distances,
+                           const MutableSpan<float> factors)
+{
+  BLI_assert(verts.size() == factors.size());
+  BLI_assert(verts.size() == r_distances.size());
+
+  SculptBrushTest test;
+  const SculptBrushTestFn sculpt_brush_test_sq_fn = SCULPT_brush_test_init_with_falloff_shape(
+      &ss, &test, falloff_shape);
+  for (const int i : verts.index_range()) {
+    if (factors[i] == 0.0f) {
+      continue;
+    }
+    if (!sculpt_brush_test_sq_fn(&test, vert_positions[verts[i]])) {
+      factors[i] = 0.0f;
+      continue;
+    }
+    r_distances[i] = std::sqrt(test.dist);
+  }
+}
+
+void calc_brush_strength_factors(SculptSession &ss,
+                                 const Brush &brush,
+                                 const Span<float3> vert_positions,
+                                 const Span<float3> vert_normals,
+                                 const Span<int> verts,
+                                 const Span<float> distances,
+                                 const MutableSpan<float> factors)
+{
+  BLI_assert(verts.size() == factors.size());
+  const StrokeCache &cache = *ss.cache;
+
+  const MTex *mtex = BKE_brush_mask_texture_get(&brush, OB_MODE_SCULPT);
+  if (mtex->tex) {
+    const int thread_id = BLI_task_parallel_thread_id(nullptr);
+    for (const int i : verts.index_range()) {
+      if (factors[i] == 0.0f) {
+        continue;
+      }
+      float texture_value;
+      float texture_rgba[4];
+      sculpt_apply_texture(
+          &ss, &brush, vert_positions[verts[i]], thread_id, &texture_value, texture_rgba);
+      factors[i] *= texture_value;
+    }
+  }
+
+  for (const int i : verts.index_range()) {
+    if (factors[i] == 0.0f) {
+      continue;
+    }
+    const float final_len = sculpt_apply_hardness(&ss, distances[i]);
+    factors[i] *= BKE_brush_curve_strength(&brush, final_len, cache.radius);
+  }
+
+  if (brush.flag & BRUSH_FRONTFACE) {
+    for (const int i : verts.index_range()) {
+      factors[i] *= frontface(brush, cache.view_normal, vert_normals[verts[i]]);
+    }
+  }
+}
+
+}  // namespace blender::ed::sculpt_paint
+
 void SCULPT_calc_vertex_displacement(SculptSession *ss,
                                      const Brush *brush,
                                      float rgba[3],
@@ -6035,6 +6132,31 @@ void node_update(auto_mask::NodeData &automask_data, PBVHVertexIter &vd)
   }
 }
 
+void calc_vert_factors(Object &object,
+                       const Cache *automasking,
+                       PBVHNode &node,
+                       const Span<int> verts,
+                       const MutableSpan<float> factors)
+{
+  if (!automasking) {
+    return;
+  }
+  SculptSession *ss = object.sculpt;
+
+  NodeData automask_data = node_begin(object, automasking, node);
+  for (const int i : verts.index_range()) {
+    if (factors[i] == 0.0f) {
+      continue;
+    }
+    if (automask_data.have_orig_data) {
+      /* Same as #SCULPT_orig_vert_data_update for mesh vertices. */
+      automask_data.orig_data.co = automask_data.orig_data.coords[i];
+      automask_data.orig_data.no = automask_data.orig_data.normals[i];
+    }
+    factors[i] *= factor_get(automasking, ss, BKE_pbvh_make_vref(verts[i]), &automask_data);
+  }
+}
+
 }  // namespace blender::ed::sculpt_paint::auto_mask
 
 bool SCULPT_vertex_is_occluded(SculptSession *ss, PBVHVertRef vertex, bool original)
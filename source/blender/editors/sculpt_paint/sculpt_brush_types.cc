@@ -9,6 +9,7 @@
 
 #include "MEM_guardedalloc.h"
 
+#include "BLI_enumerable_thread_specific.hh"
 #include "BLI_ghash.h"
 #include "BLI_math_geom.h"
 #include "BLI_math_matrix.h"
@@ -26,6 +27,7 @@
 #include "BKE_brush.hh"
 #include "BKE_ccg.h"
 #include "BKE_colortools.hh"
+#include "BKE_mesh.hh"
 #include "BKE_kelvinlet.h"
 #include "BKE_paint.hh"
 #include "BKE_pbvh_api.hh"
@@ -300,6 +302,47 @@ static void do_draw_brush_task(Object *ob, const Brush *brush, const float *offs
   BKE_pbvh_vertex_iter_end;
 }
 
+namespace blender::ed::sculpt_paint {
+
+struct DrawLocalData {
+  Vector<float> factors;
+  Vector<float> distances;
+};
+
+/**
+ * Version of #do_draw_brush_task for regular meshes, which evaluates each step of the brush
+ * strength for all of the node's vertices at once.
+ */
+static void do_draw_brush_task_mesh(Object &object,
+                                    const Brush &brush,
+                                    const float3 &offset,
+                                    const Span<float3> vert_positions,
+                                    const Span<float3> vert_normals,
+                                    PBVHNode &node,
+                                    DrawLocalData &tls)
+{
+  SculptSession &ss = *object.sculpt;
+  const Mesh &mesh = *static_cast<const Mesh *>(object.data);
+  const Span<int> verts = BKE_pbvh_node_get_unique_vert_indices(&node);
+  const MutableSpan<float3> proxy = BKE_pbvh_node_add_proxy(*ss.pbvh, node).co;
+
+  tls.factors.resize(verts.size());
+  const MutableSpan<float> factors = tls.factors;
+  fill_factor_from_hide_and_mask(mesh, verts, factors);
+
+  tls.distances.resize(verts.size());
+  const MutableSpan<float> distances = tls.distances;
+  calc_distance_falloff(ss, vert_positions, verts, brush.falloff_shape, distances, factors);
+  calc_brush_strength_factors(ss, brush, vert_positions, vert_normals, verts, distances, factors);
+  auto_mask::calc_vert_factors(object, ss.cache->automasking.get(), node, verts, factors);
+
+  for (const int i : verts.index_range()) {
+    proxy[i] = offset * factors[i];
+  }
+}
+
+}  // namespace blender::ed::sculpt_paint
+
 void SCULPT_do_draw_brush(Sculpt *sd, Object *ob, Span<PBVHNode *> nodes)
 {
   using namespace blender;
@@ -319,6 +362,23 @@ void SCULPT_do_draw_brush(Sculpt *sd, Object *ob, Span<PBVHNode *> nodes)
    * initialize before threads so they can do curve mapping. */
   BKE_curvemapping_init(brush->curve);
 
+  const bool use_color_as_displacement = (ss->cache->brush->flag2 &
+                                          BRUSH_USE_COLOR_AS_DISPLACEMENT) &&
+                                         (brush->mtex.brush_map_mode == MTEX_MAP_MODE_AREA);
+  if (BKE_pbvh_type(ss->pbvh) == PBVH_FACES && !use_color_as_displacement) {
+    using namespace blender::ed::sculpt_paint;
+    const Span<float3> vert_positions = BKE_pbvh_get_vert_positions(ss->pbvh);
+    const Span<float3> vert_normals = BKE_pbvh_get_vert_normals(ss->pbvh);
+    threading::EnumerableThreadSpecific<DrawLocalData> all_tls;
+    threading::parallel_for(nodes.index_range(), 1, [&](const IndexRange range) {
+      DrawLocalData &tls = all_tls.local();
+      for (const int i : range) {
+        do_draw_brush_task_mesh(*ob, *brush, offset, vert_positions, vert_normals, *nodes[i], tls);
+      }
+    });
+    return;
+  }
+
   threading::parallel_for(nodes.index_range(), 1, [&](const IndexRange range) {
     for (const int i : range) {
       do_draw_brush_task(ob, brush, offset, nodes[i]);
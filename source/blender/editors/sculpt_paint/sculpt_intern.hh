@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include <array>
 #include <queue>
 
 #include "BKE_attribute.hh"
@@ -228,6 +229,14 @@ struct Node {
 
   Vector<int> face_indices;
 
+  /**
+   * The #position, #orig_position, #col, #mask, #loop_col and #orig_loop_col arrays, compressed
+   * together once the undo step is finished. Empty while the arrays are stored directly.
+   */
+  Array<std::byte> compressed_data;
+  /** The sizes of the compressed arrays, in the same order. */
+  std::array<int64_t, 6> compressed_array_sizes;
+
   size_t undo_size;
 };
 
@@ -1140,6 +1149,42 @@ void SCULPT_brush_strength_color(
     const blender::ed::sculpt_paint::auto_mask::NodeData *automask_data,
     float r_rgba[4]);
 
+namespace blender::ed::sculpt_paint {
+
+/**
+ * Batched evaluation of the brush strength for the unique vertices of a mesh PBVH node, as an
+ * alternative to calling #SCULPT_brush_strength_factor for every vertex. Every step processes
+ * all vertices of the node in a single loop over contiguous factors. Vertices with a factor of
+ * zero are not affected by the brush and are skipped by the later, more expensive steps.
+ */
+
+/** Initialize factors from the vertex visibility and the paint mask. */
+void fill_factor_from_hide_and_mask(const Mesh &mesh,
+                                    Span<int> verts,
+                                    MutableSpan<float> r_factors);
+
+/**
+ * Test the vertices against the brush shape and compute their distance to the brush center.
+ * Vertices outside of the brush get a factor of zero.
+ */
+void calc_distance_falloff(SculptSession &ss,
+                           Span<float3> vert_positions,
+                           Span<int> verts,
+                           char falloff_shape,
+                           MutableSpan<float> r_distances,
+                           MutableSpan<float> factors);
+
+/** Apply the brush texture, the hardness, the falloff curve and the front-face option. */
+void calc_brush_strength_factors(SculptSession &ss,
+                                 const Brush &brush,
+                                 Span<float3> vert_positions,
+                                 Span<float3> vert_normals,
+                                 Span<int> verts,
+                                 Span<float> distances,
+                                 MutableSpan<float> factors);
+
+}  // namespace blender::ed::sculpt_paint
+
 /**
  * Calculates the vertex offset for a single vertex depending on the brush setting rgb as vector
  * displacement.
@@ -1320,6 +1365,16 @@ float factor_get(const Cache *automasking,
                  PBVHVertRef vertex,
                  const NodeData *automask_data);
 
+/**
+ * Multiply the factors of the unique vertices of a mesh PBVH node by their automasking factors,
+ * see #fill_factor_from_hide_and_mask. Vertices with a zero factor are skipped.
+ */
+void calc_vert_factors(Object &object,
+                       const Cache *automasking,
+                       PBVHNode &node,
+                       Span<int> verts,
+                       MutableSpan<float> factors);
+
 /* Returns the automasking cache depending on the active tool. Used for code that can run both for
  * brushes and filter. */
 Cache *active_cache_get(SculptSession *ss);
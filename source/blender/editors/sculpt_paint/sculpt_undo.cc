@@ -31,12 +31,14 @@
  */
 
 #include <cstddef>
+#include <zstd.h>
 
 #include "MEM_guardedalloc.h"
 
 #include "BLI_array_utils.hh"
 #include "BLI_listbase.h"
 #include "BLI_string.h"
+#include "BLI_task.hh"
 #include "BLI_threads.h"
 #include "BLI_utildefines.h"
 
@@ -1107,6 +1109,152 @@ static void free_list(UndoSculpt &usculpt)
   usculpt.nodes.~Vector();
 }
 
+/**
+ * The arrays of undo nodes that store the values of the affected elements are only used again
+ * when the undo step is restored. Once the step is finished, keep them compressed until then,
+ * which reduces the memory usage of the undo stack significantly for high resolution meshes.
+ */
+template<typename Fn> static void foreach_compressible_array(Node &unode, const Fn &fn)
+{
+  fn(unode.position);
+  fn(unode.orig_position);
+  fn(unode.col);
+  fn(unode.mask);
+  fn(unode.loop_col);
+  fn(unode.orig_loop_col);
+}
+
+/** Compressing the data of small nodes isn't worth the overhead. */
+static constexpr int64_t compress_min_size = 4096;
+
+/**
+ * All compressible arrays consist of 4 byte floats. Storing the bytes with the same significance
+ * next to each other gives the compressor much more repetition to work with.
+ */
+static void shuffle_float_bytes(const Span<std::byte> src, MutableSpan<std::byte> dst)
+{
+  const int64_t values_num = src.size() / 4;
+  for (const int64_t i : IndexRange(values_num)) {
+    for (const int64_t byte : IndexRange(4)) {
+      dst[byte * values_num + i] = src[i * 4 + byte];
+    }
+  }
+}
+
+static void unshuffle_float_bytes(const Span<std::byte> src, MutableSpan<std::byte> dst)
+{
+  const int64_t values_num = src.size() / 4;
+  for (const int64_t i : IndexRange(values_num)) {
+    for (const int64_t byte : IndexRange(4)) {
+      dst[i * 4 + byte] = src[byte * values_num + i];
+    }
+  }
+}
+
+/** \return The change of the memory used by the node. */
+static int64_t compress_node_data(Node &unode)
+{
+  if (!unode.compressed_data.is_empty()) {
+    return 0;
+  }
+  int64_t size = 0;
+  foreach_compressible_array(unode,
+                             [&](const auto &array) { size += array.as_span().size_in_bytes(); });
+  if (size < compress_min_size) {
+    return 0;
+  }
+
+  Array<std::byte> shuffled_data(size, NoInitialization());
+  {
+    Array<std::byte> data(size, NoInitialization());
+    int64_t offset = 0;
+    int array_index = 0;
+    foreach_compressible_array(unode, [&](const auto &array) {
+      const Span<std::byte> bytes = array.as_span().template cast<std::byte>();
+      data.as_mutable_span().slice(offset, bytes.size()).copy_from(bytes);
+      unode.compressed_array_sizes[array_index++] = array.size();
+      offset += bytes.size();
+    });
+    shuffle_float_bytes(data, shuffled_data);
+  }
+
+  Array<std::byte> compressed_data(ZSTD_compressBound(size), NoInitialization());
+  const size_t compressed_size = ZSTD_compress(
+      compressed_data.data(), compressed_data.size(), shuffled_data.data(), size, 1);
+  if (ZSTD_isError(compressed_size) || int64_t(compressed_size) >= size) {
+    return 0;
+  }
+
+  unode.compressed_data = compressed_data.as_span().take_front(compressed_size);
+  foreach_compressible_array(unode, [&](auto &array) { array = {}; });
+  return int64_t(compressed_size) - size;
+}
+
+/** \return The change of the memory used by the node. */
+static int64_t decompress_node_data(Node &unode)
+{
+  if (unode.compressed_data.is_empty()) {
+    return 0;
+  }
+  int64_t size = 0;
+  int array_index = 0;
+  foreach_compressible_array(unode, [&](const auto &array) {
+    using T = typename std::decay_t<decltype(array)>::value_type;
+    size += unode.compressed_array_sizes[array_index++] * int64_t(sizeof(T));
+  });
+
+  Array<std::byte> data(size, NoInitialization());
+  {
+    Array<std::byte> shuffled_data(size, NoInitialization());
+    const size_t decompressed_size = ZSTD_decompress(shuffled_data.data(),
+                                                     shuffled_data.size(),
+                                                     unode.compressed_data.data(),
+                                                     unode.compressed_data.size());
+    BLI_assert(int64_t(decompressed_size) == size);
+    UNUSED_VARS_NDEBUG(decompressed_size);
+    unshuffle_float_bytes(shuffled_data, data);
+  }
+
+  int64_t offset = 0;
+  array_index = 0;
+  foreach_compressible_array(unode, [&](auto &array) {
+    array.reinitialize(unode.compressed_array_sizes[array_index++]);
+    MutableSpan<std::byte> bytes = array.as_mutable_span().template cast<std::byte>();
+    bytes.copy_from(data.as_span().slice(offset, bytes.size()));
+    offset += bytes.size();
+  });
+
+  const int64_t compressed_size = unode.compressed_data.size();
+  unode.compressed_data = {};
+  return size - compressed_size;
+}
+
+static void compress_nodes(UndoSculpt &usculpt)
+{
+  Array<int64_t> size_changes(usculpt.nodes.size());
+  threading::parallel_for(usculpt.nodes.index_range(), 1, [&](const IndexRange range) {
+    for (const int i : range) {
+      size_changes[i] = compress_node_data(*usculpt.nodes[i]);
+    }
+  });
+  for (const int64_t size_change : size_changes) {
+    usculpt.undo_size += size_change;
+  }
+}
+
+static void decompress_nodes(UndoSculpt &usculpt)
+{
+  Array<int64_t> size_changes(usculpt.nodes.size());
+  threading::parallel_for(usculpt.nodes.index_range(), 1, [&](const IndexRange range) {
+    for (const int i : range) {
+      size_changes[i] = decompress_node_data(*usculpt.nodes[i]);
+    }
+  });
+  for (const int64_t size_change : size_changes) {
+    usculpt.undo_size += size_change;
+  }
+}
+
 Node *get_node(PBVHNode *node, Type type)
 {
   UndoSculpt *usculpt = get_nodes();
@@ -1117,6 +1265,8 @@ Node *get_node(PBVHNode *node, Type type)
 
   for (std::unique_ptr<Node> &unode : usculpt->nodes) {
     if (unode->node == node && unode->type == type) {
+      /* The node might belong to a finished step. */
+      usculpt->undo_size += decompress_node_data(*unode);
       return unode.get();
     }
   }
@@ -1776,6 +1926,7 @@ static bool sculpt_undosys_step_encode(bContext * /*C*/, Main *bmain, UndoStep *
   /* Dummy, encoding is done along the way by adding tiles
    * to the current 'SculptUndoStep' added by encode_init. */
   SculptUndoStep *us = (SculptUndoStep *)us_p;
+  compress_nodes(us->data);
   us->step.data_size = us->data.undo_size;
 
   Node *unode = us->data.nodes.is_empty() ? nullptr : us->data.nodes.last().get();
@@ -1797,7 +1948,9 @@ static void sculpt_undosys_step_decode_undo_impl(bContext *C,
 {
   BLI_assert(us->step.is_applied == true);
 
+  decompress_nodes(us->data);
   restore_list(C, depsgraph, us->data);
+  compress_nodes(us->data);
   us->step.is_applied = false;
 
   print_nodes(CTX_data_active_object(C), nullptr);
@@ -1809,7 +1962,9 @@ static void sculpt_undosys_step_decode_redo_impl(bContext *C,
 {
   BLI_assert(us->step.is_applied == false);
 
+  decompress_nodes(us->data);
   restore_list(C, depsgraph, us->data);
+  compress_nodes(us->data);
   us->step.is_applied = true;
 
   print_nodes(CTX_data_active_object(C), nullptr);
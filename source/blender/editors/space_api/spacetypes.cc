@@ -10,6 +10,7 @@
 
 #include "MEM_guardedalloc.h"
 
+#include "BLI_trace.hh"
 #include "BLI_utildefines.h"
 
 #include "DNA_scene_types.h"
@@ -60,6 +61,8 @@
 
 void ED_spacetypes_init()
 {
+  TRACE_SCOPE("ED::spacetypes_init");
+
   using namespace blender::ed;
   /* UI unit is a variable, may be used in some space type initialization. */
   U.widget_unit = 20;
@@ -1774,6 +1774,13 @@ static bool node_link_draw_is_visible(const View2D &v2d, const std::array<float2
   if (max_ffff(points[0].x, points[1].x, points[2].x, points[3].x) < v2d.cur.xmin) {
     return false;
   }
+  /* The curve is inside the convex hull of its control points, so it is also culled vertically. */
+  if (min_ffff(points[0].y, points[1].y, points[2].y, points[3].y) > v2d.cur.ymax) {
+    return false;
+  }
+  if (max_ffff(points[0].y, points[1].y, points[2].y, points[3].y) < v2d.cur.ymin) {
+    return false;
+  }
   return true;
 }
 
@@ -3362,7 +3362,9 @@ static void outliner_draw_tree_element(bContext *C,
   float icon_bgcolor[4], icon_border[4];
   outliner_icon_background_colors(icon_bgcolor, icon_border);
 
-  if (*starty + 2 * UI_UNIT_Y >= region->v2d.cur.ymin && *starty <= region->v2d.cur.ymax) {
+  const bool is_in_view = *starty + 2 * UI_UNIT_Y >= region->v2d.cur.ymin &&
+                          *starty <= region->v2d.cur.ymax;
+  if (is_in_view) {
     const float alpha_fac = element_should_draw_faded(tvc, te, tselem) ? 0.5f : 1.0f;
     int xmax = region->v2d.cur.xmax;
 
@@ -3545,6 +3547,7 @@ static void outliner_draw_tree_element(bContext *C,
   te->xend = startx + offsx;
 
   if (TSELEM_OPEN(tselem, space_outliner)) {
+    te->flag &= ~TE_SUBTREE_COORDS_CLEARED;
     *starty -= UI_UNIT_Y;
 
     LISTBASE_FOREACH (TreeElement *, ten, &te->subtree) {
@@ -3566,7 +3569,13 @@ static void outliner_draw_tree_element(bContext *C,
     }
   }
   else {
-    outliner_set_subtree_coords(te);
+    /* Only the icon-row of items in view changes the coordinates of hidden children, so the
+     * (possibly huge) subtrees of closed items outside of the view don't have to be walked again
+     * for every redraw. */
+    if (is_in_view || (te->flag & TE_SUBTREE_COORDS_CLEARED) == 0) {
+      outliner_set_subtree_coords(te);
+      te->flag |= TE_SUBTREE_COORDS_CLEARED;
+    }
     *starty -= UI_UNIT_Y;
   }
 }
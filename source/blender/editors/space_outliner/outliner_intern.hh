@@ -178,6 +178,9 @@ enum {
   /* Child elements of the same type in the icon-row are drawn merged as one icon.
    * This flag is set for an element that is part of these merged child icons. */
   TE_ICONROW_MERGED = (1 << 7),
+  /* The coordinates of the hidden children of a closed item were cleared in a previous redraw and
+   * can only have changed if the item was in view since (see #outliner_draw_tree_element()). */
+  TE_SUBTREE_COORDS_CLEARED = (1 << 8),
 };
 
 /* button events */
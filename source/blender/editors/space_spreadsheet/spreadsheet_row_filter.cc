@@ -11,6 +11,7 @@
 #include "DNA_screen_types.h"
 #include "DNA_space_types.h"
 
+#include "DEG_depsgraph.hh"
 #include "DEG_depsgraph_query.hh"
 
 #include "UI_interface.hh"
@@ -19,6 +20,7 @@
 #include "RNA_access.hh"
 
 #include "BKE_instances.hh"
+#include "BKE_viewer_path.hh"
 
 #include "spreadsheet_data_source_geometry.hh"
 #include "spreadsheet_intern.hh"
@@ -363,22 +365,96 @@ static bool use_selection_filter(const SpaceSpreadsheet &sspreadsheet,
   return true;
 }
 
-IndexMask spreadsheet_filter_rows(const SpaceSpreadsheet &sspreadsheet,
-                                  const SpreadsheetLayout &spreadsheet_layout,
-                                  const DataSource &data_source,
-                                  ResourceScope &scope)
-{
-  const int tot_rows = data_source.tot_rows();
+/**
+ * Identifies the result of filtering. The displayed data can only change when the depsgraph is
+ * evaluated, so as long as that doesn't happen and the same data is selected with the same filter
+ * settings, the rows don't have to be filtered again for every redraw (e.g. while scrolling).
+ */
+class RowFilterCacheKey : public SpreadsheetCache::Key {
+ public:
+  const Depsgraph *depsgraph;
+  uint64_t update_count;
+  const Object *object_eval;
+  ViewerPath viewer_path;
+  /** Settings of the spreadsheet that select the displayed data and the enabled filters. */
+  std::string settings;
+  int tot_rows;
 
-  const bool use_selection = use_selection_filter(sspreadsheet, data_source);
-  const bool use_filters = use_row_filters(sspreadsheet);
+  RowFilterCacheKey(const SpaceSpreadsheet &sspreadsheet,
+                    const Depsgraph &depsgraph,
+                    const GeometryDataSource &data_source,
+                    const bool use_selection,
+                    const bool use_filters)
+      : depsgraph(&depsgraph),
+        update_count(DEG_get_update_count(&depsgraph)),
+        object_eval(data_source.object_eval()),
+        tot_rows(data_source.tot_rows())
+  {
+    BKE_viewer_path_copy(&viewer_path, &sspreadsheet.viewer_path);
+    settings.push_back(char(use_selection));
+    settings.push_back(char(sspreadsheet.geometry_component_type));
+    settings.push_back(char(sspreadsheet.attribute_domain));
+    settings.push_back(char(sspreadsheet.object_eval_state));
+    settings.append(reinterpret_cast<const char *>(&sspreadsheet.active_layer_index),
+                    sizeof(sspreadsheet.active_layer_index));
+    if (!use_filters) {
+      return;
+    }
+    LISTBASE_FOREACH (const SpreadsheetRowFilter *, row_filter, &sspreadsheet.row_filters) {
+      if (!(row_filter->flag & SPREADSHEET_ROW_FILTER_ENABLED)) {
+        continue;
+      }
+      SpreadsheetRowFilter filter = *row_filter;
+      filter.next = nullptr;
+      filter.prev = nullptr;
+      filter.value_string = nullptr;
+      filter.flag &= ~SPREADSHEET_ROW_FILTER_UI_EXPAND;
+      settings.append(reinterpret_cast<const char *>(&filter), sizeof(filter));
+      if (row_filter->value_string) {
+        settings.append(row_filter->value_string);
+      }
+      settings.push_back('\0');
+    }
+  }
 
-  /* Avoid allocating an array if no row filtering is necessary. */
-  if (!(use_filters || use_selection)) {
-    return IndexMask(tot_rows);
+  ~RowFilterCacheKey()
+  {
+    BKE_viewer_path_clear(&viewer_path);
+  }
+
+  uint64_t hash() const override
+  {
+    return get_default_hash(update_count, settings, tot_rows);
+  }
+
+ private:
+  bool is_equal_to(const Key &other) const override
+  {
+    if (const RowFilterCacheKey *other_key = dynamic_cast<const RowFilterCacheKey *>(&other)) {
+      return depsgraph == other_key->depsgraph && update_count == other_key->update_count &&
+             object_eval == other_key->object_eval && settings == other_key->settings &&
+             tot_rows == other_key->tot_rows &&
+             BKE_viewer_path_equal(&viewer_path, &other_key->viewer_path);
+    }
+    return false;
   }
+};
+
+class RowFilterCacheValue : public SpreadsheetCache::Value {
+ public:
+  IndexMaskMemory memory;
+  IndexMask mask;
+  bool is_computed = false;
+};
 
-  IndexMaskMemory &mask_memory = scope.construct<IndexMaskMemory>();
+static IndexMask filter_rows(const SpaceSpreadsheet &sspreadsheet,
+                             const SpreadsheetLayout &spreadsheet_layout,
+                             const DataSource &data_source,
+                             const bool use_selection,
+                             const bool use_filters,
+                             IndexMaskMemory &mask_memory)
+{
+  const int tot_rows = data_source.tot_rows();
   IndexMask mask(tot_rows);
 
   if (use_selection) {
@@ -406,6 +482,46 @@ IndexMask spreadsheet_filter_rows(const SpaceSpreadsheet &sspreadsheet,
   return mask;
 }
 
+IndexMask spreadsheet_filter_rows(const SpaceSpreadsheet &sspreadsheet,
+                                  const Depsgraph &depsgraph,
+                                  const SpreadsheetLayout &spreadsheet_layout,
+                                  const DataSource &data_source,
+                                  ResourceScope &scope)
+{
+  const bool use_selection = use_selection_filter(sspreadsheet, data_source);
+  const bool use_filters = use_row_filters(sspreadsheet);
+
+  /* Avoid allocating an array if no row filtering is necessary. */
+  if (!(use_filters || use_selection)) {
+    return IndexMask(data_source.tot_rows());
+  }
+
+  const GeometryDataSource *geometry_data_source = dynamic_cast<const GeometryDataSource *>(
+      &data_source);
+  if (geometry_data_source == nullptr) {
+    return filter_rows(sspreadsheet,
+                       spreadsheet_layout,
+                       data_source,
+                       use_selection,
+                       use_filters,
+                       scope.construct<IndexMaskMemory>());
+  }
+
+  RowFilterCacheValue &cached = sspreadsheet.runtime->cache.lookup_or_add<RowFilterCacheValue>(
+      std::make_unique<RowFilterCacheKey>(
+          sspreadsheet, depsgraph, *geometry_data_source, use_selection, use_filters));
+  if (!cached.is_computed) {
+    cached.mask = filter_rows(sspreadsheet,
+                              spreadsheet_layout,
+                              data_source,
+                              use_selection,
+                              use_filters,
+                              cached.memory);
+    cached.is_computed = true;
+  }
+  return cached.mask;
+}
+
 SpreadsheetRowFilter *spreadsheet_row_filter_new()
 {
   SpreadsheetRowFilter *row_filter = MEM_cnew<SpreadsheetRowFilter>(__func__);
@@ -9,9 +9,16 @@
 #include "spreadsheet_data_source.hh"
 #include "spreadsheet_layout.hh"
 
+struct Depsgraph;
+
 namespace blender::ed::spreadsheet {
 
+/**
+ * Filtering is cached in the spreadsheet's runtime cache until the depsgraph is evaluated again or
+ * the settings change, the returned mask may reference memory owned by that cache.
+ */
 IndexMask spreadsheet_filter_rows(const SpaceSpreadsheet &sspreadsheet,
+                                  const Depsgraph &depsgraph,
                                   const SpreadsheetLayout &spreadsheet_layout,
                                   const DataSource &data_source,
                                   ResourceScope &scope);
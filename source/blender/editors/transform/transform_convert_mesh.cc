@@ -11,6 +11,7 @@
 #include "MEM_guardedalloc.h"
 
 #include "BLI_alloca.h"
+#include "BLI_array.hh"
 #include "BLI_bitmap.h"
 #include "BLI_linklist_stack.h"
 #include "BLI_math_geom.h"
@@ -18,6 +19,7 @@
 #include "BLI_math_rotation.h"
 #include "BLI_math_vector.h"
 #include "BLI_memarena.h"
+#include "BLI_task.hh"
 #include "BLI_utildefines_stack.h"
 
 #include "BKE_context.hh"
@@ -1627,83 +1629,102 @@ static void createTransEditVerts(bContext * /*C*/, TransInfo *t)
           MEM_callocN(tc->data_len * sizeof(TransDataExtension), "TransObData ext"));
     }
 
-    TransData *tob = tc->data;
-    TransDataMirror *td_mirror = tc->data_mirror;
+    /* Find the indices of the transform (or mirror) data of all vertices first, so the data itself
+     * can be filled in parallel. */
+    BM_mesh_elem_table_ensure(bm, BM_VERT);
+    Array<int> data_indices(bm->totvert, -1);
+    Array<int> mirror_indices(bm->totvert, -1);
+    int data_index = 0;
+    int mirror_index = 0;
     BM_ITER_MESH_INDEX (eve, &iter, bm, BM_VERTS_OF_MESH, a) {
       if (BM_elem_flag_test(eve, BM_ELEM_HIDDEN)) {
         continue;
       }
-
-      int island_index = -1;
-      if (island_data.island_vert_map) {
-        const int connected_index = (dists_index && dists_index[a] != -1) ? dists_index[a] : a;
-        island_index = island_data.island_vert_map[connected_index];
-      }
-
       if (mirror_data.vert_map && mirror_data.vert_map[a].index != -1) {
-        int elem_index = mirror_data.vert_map[a].index;
-        BMVert *v_src = BM_vert_at_index(bm, elem_index);
-
-        if (BM_elem_flag_test(eve, BM_ELEM_SELECT)) {
-          mirror_data.vert_map[a].flag |= TD_SELECTED;
-        }
-
-        td_mirror->extra = eve;
-        td_mirror->loc = eve->co;
-        copy_v3_v3(td_mirror->iloc, eve->co);
-        td_mirror->flag = mirror_data.vert_map[a].flag;
-        td_mirror->loc_src = v_src->co;
-        mesh_transdata_center_copy(&island_data, island_index, td_mirror->iloc, td_mirror->center);
-
-        td_mirror++;
+        mirror_indices[a] = mirror_index++;
       }
       else if (prop_mode || BM_elem_flag_test(eve, BM_ELEM_SELECT)) {
-        /* Do not use the island center in case we are using islands
-         * only to get axis for snap/rotate to normal... */
-        VertsToTransData(t, tob, tx, em, eve, &island_data, island_index);
-        if (tx) {
-          tx++;
-        }
+        data_indices[a] = data_index++;
+      }
+    }
+    BLI_assert(data_index == data_len);
 
-        /* Selected. */
-        if (BM_elem_flag_test(eve, BM_ELEM_SELECT)) {
-          tob->flag |= TD_SELECTED;
+    threading::parallel_for(IndexRange(bm->totvert), 1024, [&](const IndexRange range) {
+      for (const int a : range) {
+        if (data_indices[a] == -1 && mirror_indices[a] == -1) {
+          continue;
         }
+        BMVert *vert = BM_vert_at_index(bm, a);
 
-        if (prop_mode) {
-          if (prop_mode & T_PROP_CONNECTED) {
-            tob->dist = dists[a];
-          }
-          else {
-            tob->dist = FLT_MAX;
-          }
+        int island_index = -1;
+        if (island_data.island_vert_map) {
+          const int connected_index = (dists_index && dists_index[a] != -1) ? dists_index[a] :
+                                                                                a;
+          island_index = island_data.island_vert_map[connected_index];
         }
 
-        /* CrazySpace. */
-        transform_convert_mesh_crazyspace_transdata_set(
-            mtx,
-            smtx,
-            !crazyspace_data.defmats.is_empty() ? crazyspace_data.defmats[a].ptr() : nullptr,
-            crazyspace_data.quats && BM_elem_flag_test(eve, BM_ELEM_TAG) ?
-                crazyspace_data.quats[a] :
-                nullptr,
-            tob);
+        if (mirror_indices[a] != -1) {
+          TransDataMirror *td_mirror = &tc->data_mirror[mirror_indices[a]];
+          int elem_index = mirror_data.vert_map[a].index;
+          BMVert *v_src = BM_vert_at_index(bm, elem_index);
 
-        if (tc->use_mirror_axis_any) {
-          if (tc->use_mirror_axis_x && fabsf(tob->loc[0]) < TRANSFORM_MAXDIST_MIRROR) {
-            tob->flag |= TD_MIRROR_EDGE_X;
+          if (BM_elem_flag_test(vert, BM_ELEM_SELECT)) {
+            mirror_data.vert_map[a].flag |= TD_SELECTED;
           }
-          if (tc->use_mirror_axis_y && fabsf(tob->loc[1]) < TRANSFORM_MAXDIST_MIRROR) {
-            tob->flag |= TD_MIRROR_EDGE_Y;
+
+          td_mirror->extra = vert;
+          td_mirror->loc = vert->co;
+          copy_v3_v3(td_mirror->iloc, vert->co);
+          td_mirror->flag = mirror_data.vert_map[a].flag;
+          td_mirror->loc_src = v_src->co;
+          mesh_transdata_center_copy(
+              &island_data, island_index, td_mirror->iloc, td_mirror->center);
+        }
+        else if (data_indices[a] != -1) {
+          TransData *tob = &tc->data[data_indices[a]];
+          TransDataExtension *tob_ext = tx ? &tx[data_indices[a]] : nullptr;
+          /* Do not use the island center in case we are using islands
+           * only to get axis for snap/rotate to normal... */
+          VertsToTransData(t, tob, tob_ext, em, vert, &island_data, island_index);
+
+          /* Selected. */
+          if (BM_elem_flag_test(vert, BM_ELEM_SELECT)) {
+            tob->flag |= TD_SELECTED;
           }
-          if (tc->use_mirror_axis_z && fabsf(tob->loc[2]) < TRANSFORM_MAXDIST_MIRROR) {
-            tob->flag |= TD_MIRROR_EDGE_Z;
+
+          if (prop_mode) {
+            if (prop_mode & T_PROP_CONNECTED) {
+              tob->dist = dists[a];
+            }
+            else {
+              tob->dist = FLT_MAX;
+            }
           }
-        }
 
-        tob++;
+          /* CrazySpace. */
+          transform_convert_mesh_crazyspace_transdata_set(
+              mtx,
+              smtx,
+              !crazyspace_data.defmats.is_empty() ? crazyspace_data.defmats[a].ptr() : nullptr,
+              crazyspace_data.quats && BM_elem_flag_test(vert, BM_ELEM_TAG) ?
+                  crazyspace_data.quats[a] :
+                  nullptr,
+              tob);
+
+          if (tc->use_mirror_axis_any) {
+            if (tc->use_mirror_axis_x && fabsf(tob->loc[0]) < TRANSFORM_MAXDIST_MIRROR) {
+              tob->flag |= TD_MIRROR_EDGE_X;
+            }
+            if (tc->use_mirror_axis_y && fabsf(tob->loc[1]) < TRANSFORM_MAXDIST_MIRROR) {
+              tob->flag |= TD_MIRROR_EDGE_Y;
+            }
+            if (tc->use_mirror_axis_z && fabsf(tob->loc[2]) < TRANSFORM_MAXDIST_MIRROR) {
+              tob->flag |= TD_MIRROR_EDGE_Z;
+            }
+          }
+        }
       }
-    }
+    });
 
     transform_convert_mesh_islanddata_free(&island_data);
     transform_convert_mesh_mirrordata_free(&mirror_data);
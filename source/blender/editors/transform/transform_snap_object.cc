@@ -6,6 +6,7 @@
  * \ingroup edtransform
  */
 
+#include "BLI_bounds.hh"
 #include "BLI_math_matrix.h"
 #include "BLI_math_matrix.hh"
 #include "BLI_math_vector.h"
@@ -471,10 +472,84 @@ static bool snap_object_is_snappable(const SnapObjectContext *sctx,
   return true;
 }
 
+/**
+ * Merged world space bounds of the instances in the dupli-list. Only mesh instances have bounds
+ * that contain everything that can be snapped to, so there are no bounds if there are others.
+ */
+static std::optional<Bounds<float3>> duplilist_bounds(const ListBase *lb)
+{
+  std::optional<Bounds<float3>> result;
+  LISTBASE_FOREACH (const DupliObject *, dupli_ob, lb) {
+    if (dupli_ob->ob_data == nullptr || GS(dupli_ob->ob_data->name) != ID_ME) {
+      return std::nullopt;
+    }
+    const Mesh *mesh = reinterpret_cast<const Mesh *>(dupli_ob->ob_data);
+    const std::optional<Bounds<float3>> bounds = mesh->bounds_min_max();
+    if (!bounds) {
+      continue;
+    }
+    BoundBox bb;
+    BKE_boundbox_init_from_minmax(&bb, bounds->min, bounds->max);
+    const float4x4 mat(dupli_ob->mat);
+    Bounds<float3> world_bounds(math::transform_point(mat, float3(bb.vec[0])));
+    for (const int i : IndexRange(1, 7)) {
+      const float3 co = math::transform_point(mat, float3(bb.vec[i]));
+      math::min_max(co, world_bounds.min, world_bounds.max);
+    }
+    result = bounds::merge(result, std::optional<Bounds<float3>>(world_bounds));
+  }
+  return result;
+}
+
+static const SnapObjectContext::InstancesBounds *instances_bounds_lookup(
+    const SnapObjectContext *sctx, const Object *ob_eval)
+{
+  const SnapObjectContext::InstancesBounds *cached = sctx->instances_bounds.lookup_ptr(ob_eval);
+  if (cached == nullptr || cached->depsgraph != sctx->runtime.depsgraph ||
+      cached->update_count != DEG_get_update_count(sctx->runtime.depsgraph))
+  {
+    return nullptr;
+  }
+  return cached;
+}
+
+static void instances_bounds_ensure(SnapObjectContext *sctx,
+                                    const Object *ob_eval,
+                                    const ListBase *lb)
+{
+  if (instances_bounds_lookup(sctx, ob_eval)) {
+    return;
+  }
+  SnapObjectContext::InstancesBounds &cached = sctx->instances_bounds.lookup_or_add_default(
+      ob_eval);
+  cached.depsgraph = sctx->runtime.depsgraph;
+  cached.update_count = DEG_get_update_count(sctx->runtime.depsgraph);
+  cached.bounds = duplilist_bounds(lb);
+}
+
+/**
+ * Check whether all instances of the instancer are further away from the cursor than the current
+ * snap result, using bounds cached by a previous snap since the last depsgraph update.
+ */
+static bool instances_out_of_range(SnapObjectContext *sctx, const Object *ob_eval)
+{
+  const SnapObjectContext::InstancesBounds *cached = instances_bounds_lookup(sctx, ob_eval);
+  if (cached == nullptr || !cached->bounds) {
+    return false;
+  }
+  SnapData nearest2d(sctx);
+  return !nearest2d.snap_boundbox(cached->bounds->min, cached->bounds->max);
+}
+
 /**
  * Walks through all objects in the scene to create the list of objects to snap.
+ *
+ * \param use_instances_bounds: Skip instancers whose instances are all further away from the
+ * cursor than the current result, only valid for snapping to the nearest element in screen space.
  */
-static eSnapMode iter_snap_objects(SnapObjectContext *sctx, IterSnapObjsCallback sob_callback)
+static eSnapMode iter_snap_objects(SnapObjectContext *sctx,
+                                   IterSnapObjsCallback sob_callback,
+                                   const bool use_instances_bounds = false)
 {
   eSnapMode ret = SCE_SNAP_TO_NONE;
   eSnapMode tmp;
@@ -492,10 +567,14 @@ static eSnapMode iter_snap_objects(SnapObjectContext *sctx, IterSnapObjsCallback
 
     const bool is_object_active = (base == base_act);
     Object *obj_eval = DEG_get_evaluated_object(sctx->runtime.depsgraph, base->object);
-    if (obj_eval->transflag & OB_DUPLI ||
-        blender::bke::object_has_geometry_set_instances(*obj_eval))
+    if ((obj_eval->transflag & OB_DUPLI ||
+         blender::bke::object_has_geometry_set_instances(*obj_eval)) &&
+        !(use_instances_bounds && instances_out_of_range(sctx, obj_eval)))
     {
       ListBase *lb = object_duplilist(sctx->runtime.depsgraph, sctx->scene, obj_eval);
+      if (use_instances_bounds) {
+        instances_bounds_ensure(sctx, obj_eval, lb);
+      }
       LISTBASE_FOREACH (DupliObject *, dupli_ob, lb) {
         BLI_assert(DEG_is_evaluated_object(dupli_ob->ob));
         if ((tmp = sob_callback(sctx,
@@ -961,7 +1040,7 @@ static eSnapMode snap_obj_fn(SnapObjectContext *sctx,
  */
 static eSnapMode snapObjectsRay(SnapObjectContext *sctx)
 {
-  return iter_snap_objects(sctx, snap_obj_fn);
+  return iter_snap_objects(sctx, snap_obj_fn, true);
 }
 
 static bool snap_grid(SnapObjectContext *sctx)
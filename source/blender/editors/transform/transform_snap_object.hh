@@ -8,6 +8,9 @@
 
 #pragma once
 
+#include <optional>
+
+#include "BLI_bounds_types.hh"
 #include "BLI_map.hh"
 #include "BLI_math_geom.h"
 
@@ -25,6 +28,19 @@ struct SnapObjectContext {
   };
   blender::Map<const ID *, std::unique_ptr<SnapCache>> editmesh_caches;
 
+  /**
+   * World space bounds of the instances of instancer objects, so that the dupli-list of an
+   * instancer far away from the cursor doesn't have to be created again for every snap.
+   * The bounds are valid until the next update of the dependency graph they were computed for.
+   */
+  struct InstancesBounds {
+    const Depsgraph *depsgraph;
+    uint64_t update_count;
+    /** Not set when an instance can be snapped to without having bounds. */
+    std::optional<blender::Bounds<blender::float3>> bounds;
+  };
+  blender::Map<const Object *, InstancesBounds> instances_bounds;
+
   /* Filter data, returns true to check this value. */
   struct {
     struct {
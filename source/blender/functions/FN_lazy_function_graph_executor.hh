@@ -11,6 +11,8 @@
  * another #Graph again).
  */
 
+#include <atomic>
+
 #include "BLI_vector.hh"
 #include "BLI_vector_set.hh"
 
@@ -118,6 +120,13 @@ class GraphExecutor : public LazyFunction {
     int total_size;
   } init_buffer_info_;
 
+  /**
+   * Estimated run time of every node in seconds, indexed by #Node::index_in_graph. It's measured
+   * during previous executions and zero when unknown yet. This is used to decide which nodes should
+   * be executed on separate threads.
+   */
+  mutable Array<std::atomic<float>> node_run_times_;
+
   friend class Executor;
 
  public:
@@ -136,6 +145,7 @@ class GraphExecutor : public LazyFunction {
 
  private:
   void execute_impl(Params &params, const Context &context) const override;
+  void update_node_run_time(const FunctionNode &node, float run_time) const;
 };
 
 }  // namespace blender::fn::lazy_function
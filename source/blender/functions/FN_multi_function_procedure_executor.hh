@@ -17,6 +17,8 @@ class ProcedureExecutor : public MultiFunction {
  private:
   Signature signature_;
   const Procedure &procedure_;
+  /** Number of indices that are processed at once, see #compute_chunk_size. */
+  int64_t chunk_size_;
 
  public:
   ProcedureExecutor(const Procedure &procedure);
@@ -772,12 +772,78 @@ int FieldEvaluator::add(GField field)
   return field_index;
 }
 
+/**
+ * Evaluates a selection that varies per index segment by segment and builds the mask from the
+ * result directly. This avoids writing the selection into a boolean array with the size of the
+ * full domain, which would only be read once to build the mask afterwards. Segments are small
+ * enough that the booleans stay in the CPU cache.
+ *
+ * \return Nothing if the selection does not vary per index, in which case the general field
+ * evaluation handles it better.
+ */
+static std::optional<IndexMask> try_evaluate_varying_selection(const GFieldRef selection_field,
+                                                               const FieldContext &context,
+                                                               const IndexMask &full_mask,
+                                                               ResourceScope &scope)
+{
+  if (selection_field.node().node_type() != FieldNodeType::Operation) {
+    return std::nullopt;
+  }
+  FieldTreeInfo field_tree_info = preprocess_field_tree({selection_field});
+  const Vector<GVArray> field_context_inputs = get_field_context_inputs(
+      scope, full_mask, context, field_tree_info.deduplicated_field_inputs);
+  if (!find_varying_fields(field_tree_info, field_context_inputs).contains(selection_field)) {
+    return std::nullopt;
+  }
+
+  mf::Procedure procedure;
+  build_multi_function_procedure_for_fields(procedure, scope, field_tree_info, {selection_field});
+  const mf::ProcedureExecutor procedure_executor{procedure};
+
+  return IndexMask::from_batch_predicate(
+      full_mask,
+      GrainSize(4096),
+      scope.construct<IndexMaskMemory>(),
+      [&](const IndexMaskSegment universe_segment, int16_t *r_true_indices) -> int64_t {
+        /* Evaluate the segment with indices starting at zero, so that only a small buffer is
+         * necessary for the result. */
+        const int64_t offset = universe_segment.offset();
+        IndexMaskFromSegment local_mask_from_segment;
+        const IndexMask &local_mask = local_mask_from_segment.update(
+            universe_segment.shift(-offset));
+        const IndexRange input_slice(offset, local_mask.min_array_size());
+
+        std::array<bool, index_mask::max_segment_size> selection_buffer;
+        mf::ParamsBuilder mf_params{procedure_executor, &local_mask};
+        for (const GVArray &varray : field_context_inputs) {
+          mf_params.add_readonly_single_input(varray.slice(input_slice));
+        }
+        mf_params.add_uninitialized_single_output(
+            GMutableSpan(CPPType::get<bool>(), selection_buffer.data(), input_slice.size()));
+        mf::ContextBuilder mf_context;
+        procedure_executor.call(local_mask, mf_params, mf_context);
+
+        int16_t *r_current = r_true_indices;
+        for (const int16_t local_index : universe_segment.base_span()) {
+          *r_current = local_index;
+          /* Branchless conditional increment. */
+          r_current += selection_buffer[local_index];
+        }
+        return r_current - r_true_indices;
+      });
+}
+
 static IndexMask evaluate_selection(const Field<bool> &selection_field,
                                     const FieldContext &context,
                                     IndexMask full_mask,
                                     ResourceScope &scope)
 {
   if (selection_field) {
+    if (std::optional<IndexMask> selection = try_evaluate_varying_selection(
+            selection_field, context, full_mask, scope))
+    {
+      return *selection;
+    }
     VArray<bool> selection =
         evaluate_fields(scope, {selection_field}, full_mask, context)[0].typed<bool>();
     return index_mask_from_selection(full_mask, selection, scope);
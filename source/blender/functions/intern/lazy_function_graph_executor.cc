@@ -39,6 +39,11 @@
  * When all tasks are completed, the executor gives back control to the caller which may later
  * provide new inputs to the graph which in turn leads to new nodes being scheduled and the process
  * starts again.
+ *
+ * The run time of every node is measured and remembered across executions of the same graph. The
+ * estimates are used to decide when scheduled nodes should be split up between threads: cheap
+ * nodes stay together in a single task where they are executed serially, while expensive nodes end
+ * up in separate tasks that can be stolen by other threads.
  */
 
 #include <mutex>
@@ -214,36 +219,53 @@ struct LockedNode {
 class Executor;
 class GraphExecutorLFParams;
 
+/**
+ * Scheduled nodes are split up between threads when their estimated total run time is above this
+ * threshold (in seconds). Below it, the overhead of using another task is likely larger than the
+ * time that can be saved.
+ */
+static constexpr float parallel_run_time_threshold = 0.0001f;
+
 /**
  * Keeps track of nodes that are currently scheduled on a thread. A node can only be scheduled by
  * one thread at the same time.
  */
 struct ScheduledNodes {
  private:
+  struct ScheduledNode {
+    const FunctionNode *node;
+    /** Estimated run time of the node in seconds, zero when unknown. */
+    float run_time;
+  };
+
   /** Use two stacks of scheduled nodes for different priorities. */
-  Vector<const FunctionNode *> priority_;
-  Vector<const FunctionNode *> normal_;
+  Vector<ScheduledNode> priority_;
+  Vector<ScheduledNode> normal_;
+  /** Sum of the estimated run times of all scheduled nodes. */
+  float run_time_ = 0.0f;
 
  public:
-  void schedule(const FunctionNode &node, const bool is_priority)
+  void schedule(const FunctionNode &node, const bool is_priority, const float run_time)
   {
     if (is_priority) {
-      this->priority_.append(&node);
+      this->priority_.append({&node, run_time});
     }
     else {
-      this->normal_.append(&node);
+      this->normal_.append({&node, run_time});
     }
+    run_time_ += run_time;
   }
 
   const FunctionNode *pop_next_node()
   {
-    if (!this->priority_.is_empty()) {
-      return this->priority_.pop_last();
-    }
-    if (!this->normal_.is_empty()) {
-      return this->normal_.pop_last();
+    Vector<ScheduledNode> &stack = this->priority_.is_empty() ? this->normal_ : this->priority_;
+    if (stack.is_empty()) {
+      return nullptr;
     }
-    return nullptr;
+    const ScheduledNode scheduled_node = stack.pop_last();
+    /* Reset when empty to avoid accumulating floating point errors. */
+    run_time_ = this->is_empty() ? 0.0f : std::max(run_time_ - scheduled_node.run_time, 0.0f);
+    return scheduled_node.node;
   }
 
   bool is_empty() const
@@ -256,18 +278,59 @@ struct ScheduledNodes {
     return priority_.size() + normal_.size();
   }
 
+  float estimated_run_time() const
+  {
+    return run_time_;
+  }
+
   /**
-   * Split up the scheduled nodes into two groups that can be worked on in parallel.
+   * Split up the scheduled nodes into two groups that can be worked on in parallel. The groups
+   * have about the same estimated run time, so an expensive node may end up in a group on its own.
    */
   void split_into(ScheduledNodes &other)
   {
     BLI_assert(this != &other);
-    const int64_t priority_split = priority_.size() / 2;
-    const int64_t normal_split = normal_.size() / 2;
+    const int64_t priority_split = find_split_index(priority_);
+    const int64_t normal_split = find_split_index(normal_);
     other.priority_.extend(priority_.as_span().drop_front(priority_split));
     other.normal_.extend(normal_.as_span().drop_front(normal_split));
     priority_.resize(priority_split);
     normal_.resize(normal_split);
+    this->update_run_time();
+    other.update_run_time();
+  }
+
+ private:
+  static int64_t find_split_index(const Span<ScheduledNode> nodes)
+  {
+    float total_run_time = 0.0f;
+    for (const ScheduledNode &node : nodes) {
+      total_run_time += node.run_time;
+    }
+    if (total_run_time == 0.0f) {
+      /* Without any estimates, assume that all nodes take the same time. */
+      return nodes.size() / 2;
+    }
+    float accumulated_run_time = 0.0f;
+    for (const int64_t i : nodes.index_range()) {
+      accumulated_run_time += nodes[i].run_time;
+      if (accumulated_run_time * 2.0f >= total_run_time) {
+        /* Always move at least one node to the other group. */
+        return std::min(i + 1, nodes.size() - 1);
+      }
+    }
+    return nodes.size() - 1;
+  }
+
+  void update_run_time()
+  {
+    run_time_ = 0.0f;
+    for (const ScheduledNode &node : priority_) {
+      run_time_ += node.run_time;
+    }
+    for (const ScheduledNode &node : normal_) {
+      run_time_ += node.run_time;
+    }
   }
 };
 
@@ -742,12 +805,14 @@ class Executor {
       case NodeScheduleState::NotScheduled: {
         locked_node.node_state.schedule_state = NodeScheduleState::Scheduled;
         const FunctionNode &node = static_cast<const FunctionNode &>(locked_node.node);
+        const float run_time = self_.node_run_times_[node.index_in_graph()].load(
+            std::memory_order_relaxed);
         if (this->use_multi_threading()) {
           std::lock_guard lock{current_task.mutex};
-          current_task.scheduled_nodes.schedule(node, is_priority);
+          current_task.scheduled_nodes.schedule(node, is_priority, run_time);
         }
         else {
-          current_task.scheduled_nodes.schedule(node, is_priority);
+          current_task.scheduled_nodes.schedule(node, is_priority, run_time);
         }
         current_task.has_scheduled_nodes.store(true, std::memory_order_relaxed);
         break;
@@ -814,9 +879,14 @@ class Executor {
       }
       this->run_node_task(*node, current_task, local_data);
 
-      /* If there are many nodes scheduled at the same time, it's beneficial to let multiple
-       * threads work on those. */
-      if (current_task.scheduled_nodes.nodes_num() > 128) {
+      /* If there are many or expensive nodes scheduled at the same time, it's beneficial to let
+       * multiple threads work on those. Cheap nodes are kept on the current thread, because
+       * distributing them would cost more than executing them. */
+      const int64_t scheduled_nodes_num = current_task.scheduled_nodes.nodes_num();
+      if (scheduled_nodes_num > 128 ||
+          (scheduled_nodes_num > 1 &&
+           current_task.scheduled_nodes.estimated_run_time() > parallel_run_time_threshold))
+      {
         if (this->try_enable_multi_threading()) {
           std::unique_ptr<ScheduledNodes> split_nodes = std::make_unique<ScheduledNodes>();
           current_task.scheduled_nodes.split_into(*split_nodes);
@@ -1448,12 +1518,15 @@ inline void Executor::execute_node(const FunctionNode &node,
   };
 
   lazy_threading::HintReceiver blocking_hint_receiver{blocking_hint_fn};
+  const timeit::TimePoint start_time = timeit::Clock::now();
   if (self_.node_execute_wrapper_) {
     self_.node_execute_wrapper_->execute_node(node, node_params, fn_context);
   }
   else {
     fn.execute(node_params, fn_context);
   }
+  const timeit::Nanoseconds duration = timeit::Clock::now() - start_time;
+  self_.update_node_run_time(node, float(duration.count()) * 1e-9f);
 
   if (self_.logger_ != nullptr) {
     self_.logger_->log_after_node_execute(node, node_params, fn_context);
@@ -1473,8 +1546,13 @@ GraphExecutor::GraphExecutor(const Graph &graph,
       graph_output_index_by_socket_index_(graph.graph_outputs().size(), -1),
       logger_(logger),
       side_effect_provider_(side_effect_provider),
-      node_execute_wrapper_(node_execute_wrapper)
+      node_execute_wrapper_(node_execute_wrapper),
+      node_run_times_(graph.nodes().size())
 {
+  for (std::atomic<float> &run_time : node_run_times_) {
+    run_time.store(0.0f, std::memory_order_relaxed);
+  }
+
   /* The graph executor can handle partial execution when there are still missing inputs. */
   allow_missing_requested_inputs_ = true;
 
@@ -1517,6 +1595,18 @@ GraphExecutor::GraphExecutor(const Graph &graph,
   init_buffer_info_.total_size = offset;
 }
 
+void GraphExecutor::update_node_run_time(const FunctionNode &node, const float run_time) const
+{
+  /* Use a moving average so that the estimate adapts when the inputs change, without being too
+   * sensitive to outliers. It's fine if concurrent updates overwrite each other, because this is
+   * only a heuristic. */
+  std::atomic<float> &estimate = node_run_times_[node.index_in_graph()];
+  const float old_estimate = estimate.load(std::memory_order_relaxed);
+  const float new_estimate = old_estimate == 0.0f ? run_time :
+                                                    old_estimate * 0.75f + run_time * 0.25f;
+  estimate.store(new_estimate, std::memory_order_relaxed);
+}
+
 void GraphExecutor::execute_impl(Params &params, const Context &context) const
 {
   Executor &executor = *static_cast<Executor *>(context.storage);
@@ -8,7 +8,34 @@
 
 namespace blender::fn::multi_function {
 
-ProcedureExecutor::ProcedureExecutor(const Procedure &procedure) : procedure_(procedure)
+/**
+ * Every instruction is executed for all indices of a chunk before the next instruction starts, so
+ * the intermediate buffers of a chunk should fit into the CPU cache together. Otherwise every
+ * instruction has to load its inputs from main memory again, which is often slower than the
+ * computation itself in long chains of simple math operations. Chunks must not become too small
+ * either, because the overhead of interpreting the instructions is paid once per chunk.
+ */
+static int64_t compute_chunk_size(const Procedure &procedure)
+{
+  const int64_t cache_budget = 512 * 1024;
+  const int64_t min_chunk_size = 1024;
+  const int64_t max_chunk_size = 10000;
+
+  int64_t bytes_per_index = 0;
+  for (const Variable *variable : procedure.variables()) {
+    const DataType data_type = variable->data_type();
+    /* This is an upper bound, because buffers of destructed variables are reused. */
+    bytes_per_index += data_type.is_single() ? data_type.single_type().size() :
+                                               sizeof(GVectorArray);
+  }
+  if (bytes_per_index == 0) {
+    return max_chunk_size;
+  }
+  return std::clamp(cache_budget / bytes_per_index, min_chunk_size, max_chunk_size);
+}
+
+ProcedureExecutor::ProcedureExecutor(const Procedure &procedure)
+    : procedure_(procedure), chunk_size_(compute_chunk_size(procedure))
 {
   SignatureBuilder builder("Procedure Executor", signature_);
 
@@ -1245,7 +1272,7 @@ MultiFunction::ExecutionHints ProcedureExecutor::get_execution_hints() const
 {
   ExecutionHints hints;
   hints.allocates_array = true;
-  hints.min_grain_size = 10000;
+  hints.min_grain_size = chunk_size_;
   return hints;
 }
 
@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include "BLI_function_ref.hh"
+
 #include "BKE_geometry_set.hh"
 
 namespace blender::geometry {
@@ -38,4 +40,19 @@ struct RealizeInstancesOptions {
 bke::GeometrySet realize_instances(bke::GeometrySet geometry_set,
                                    const RealizeInstancesOptions &options);
 
+/**
+ * Same as #realize_instances, but the top-level instances are realized in separate parts that are
+ * passed to #fn one after another. Each part contains about #max_part_elements_num realized
+ * elements (vertices, edges, faces, corners, points and curves), so the full result never has to
+ * be in memory at the same time. A single instance that is larger than the limit becomes a part on
+ * its own. The realized geometry that was not instanced is added to the first part.
+ *
+ * Joining all parts gives the same result as #realize_instances, except for generated ids when
+ * the instances don't have an `id` attribute.
+ */
+void realize_instances_in_parts(bke::GeometrySet geometry_set,
+                                const RealizeInstancesOptions &options,
+                                int64_t max_part_elements_num,
+                                FunctionRef<void(bke::GeometrySet part)> fn);
+
 }  // namespace blender::geometry
@@ -7,10 +7,14 @@
 
 #include "BLI_array.hh"
 #include "BLI_bit_vector.hh"
+#include "BLI_bounds.hh"
 #include "BLI_index_mask.hh"
 #include "BLI_kdtree.h"
+#include "BLI_map.hh"
 #include "BLI_math_vector.h"
 #include "BLI_offset_indices.hh"
+#include "BLI_sort.hh"
+#include "BLI_task.hh"
 #include "BLI_vector.hh"
 
 #include "BKE_customdata.hh"
@@ -1694,21 +1698,144 @@ static Mesh *create_merged_mesh(const Mesh &mesh,
 /** \name Merge Map Creation
  * \{ */
 
+/**
+ * Finds the same duplicates as #BLI_kdtree_3d_calc_duplicates_fast with index order, but the
+ * search for the neighbors of every vertex is done in parallel using a uniform grid. Only the
+ * cheap greedy assignment of vertices to their merge targets remains serial, because its result
+ * depends on the order of the vertices.
+ *
+ * \return The number of merged vertices, or nothing if the grid would have too many cells.
+ */
+static std::optional<int> calc_duplicates_with_grid(const Span<float3> positions,
+                                                    const IndexMask &selection,
+                                                    const float merge_distance,
+                                                    MutableSpan<int> vert_dest_map)
+{
+  if (merge_distance <= 0.0f) {
+    return std::nullopt;
+  }
+  const std::optional<Bounds<float3>> bounds = bounds::min_max(selection, positions);
+  if (!bounds) {
+    return 0;
+  }
+  /* With cells twice as large as the distance, the neighbors of a vertex are in at most two
+   * cells along every axis. */
+  const float cell_size = merge_distance * 2.0f;
+  /* Pad the search range slightly so that rounding can't skip a cell. */
+  const float search_range = merge_distance * 1.0001f;
+  constexpr int64_t max_cells_per_axis = int64_t(1) << 21;
+  const float3 cells_num = (bounds->max - bounds->min) / cell_size;
+  if (math::reduce_max(cells_num) >= float(max_cells_per_axis - 2)) {
+    return std::nullopt;
+  }
+  auto cell_coord = [&](const float3 &position) {
+    return int3(math::floor((position - bounds->min) / cell_size)) + int3(1);
+  };
+  auto cell_key = [](const int3 &cell) {
+    return uint64_t(cell.x) | (uint64_t(cell.y) << 21) | (uint64_t(cell.z) << 42);
+  };
+
+  /* Sort the vertices by their cell, so that the vertices of each cell are contiguous. */
+  Array<int> sorted_verts(selection.size());
+  selection.to_indices<int>(sorted_verts);
+  Array<uint64_t> keys(positions.size());
+  threading::parallel_for(sorted_verts.index_range(), 4096, [&](const IndexRange range) {
+    for (const int vert : sorted_verts.as_span().slice(range)) {
+      keys[vert] = cell_key(cell_coord(positions[vert]));
+    }
+  });
+  parallel_sort(sorted_verts.begin(), sorted_verts.end(), [&](const int a, const int b) {
+    return keys[a] < keys[b] || (keys[a] == keys[b] && a < b);
+  });
+  Map<uint64_t, IndexRange> verts_by_cell;
+  verts_by_cell.reserve(sorted_verts.size());
+  for (int64_t start = 0; start < sorted_verts.size();) {
+    const uint64_t key = keys[sorted_verts[start]];
+    int64_t end = start + 1;
+    while (end < sorted_verts.size() && keys[sorted_verts[end]] == key) {
+      end++;
+    }
+    verts_by_cell.add_new(key, IndexRange::from_begin_end(start, end));
+    start = end;
+  }
+
+  const float merge_distance_sq = merge_distance * merge_distance;
+  auto foreach_neighbor = [&](const int vert, auto &&fn) {
+    const float3 &position = positions[vert];
+    const int3 min_cell = cell_coord(position - float3(search_range));
+    const int3 max_cell = cell_coord(position + float3(search_range));
+    for (int z = min_cell.z; z <= max_cell.z; z++) {
+      for (int y = min_cell.y; y <= max_cell.y; y++) {
+        for (int x = min_cell.x; x <= max_cell.x; x++) {
+          const IndexRange cell_verts = verts_by_cell.lookup_default(cell_key({x, y, z}), {});
+          for (const int other : sorted_verts.as_span().slice(cell_verts)) {
+            if (other != vert && len_squared_v3v3(position, positions[other]) <= merge_distance_sq)
+            {
+              fn(other);
+            }
+          }
+        }
+      }
+    }
+  };
+
+  /* Gather all neighbors of every selected vertex in parallel. */
+  Array<int> neighbor_offsets(selection.size() + 1);
+  selection.foreach_index(GrainSize(1024), [&](const int vert, const int pos) {
+    int count = 0;
+    foreach_neighbor(vert, [&](const int /*other*/) { count++; });
+    neighbor_offsets[pos] = count;
+  });
+  const OffsetIndices neighbors_by_vert = offset_indices::accumulate_counts_to_offsets(
+      neighbor_offsets);
+  Array<int> neighbors(neighbors_by_vert.total_size());
+  selection.foreach_index(GrainSize(1024), [&](const int vert, const int pos) {
+    int *dst = &neighbors[neighbors_by_vert[pos].start()];
+    foreach_neighbor(vert, [&](const int other) { *dst++ = other; });
+  });
+
+  /* Same assignment as in the KD-tree, where chains of doubles are prevented. */
+  int found = 0;
+  selection.foreach_index([&](const int vert, const int pos) {
+    if (!ELEM(vert_dest_map[vert], OUT_OF_CONTEXT, vert)) {
+      return;
+    }
+    const int found_prev = found;
+    for (const int other : neighbors.as_span().slice(neighbors_by_vert[pos])) {
+      if (vert_dest_map[other] == OUT_OF_CONTEXT) {
+        vert_dest_map[other] = vert;
+        found++;
+      }
+    }
+    if (found != found_prev) {
+      vert_dest_map[vert] = vert;
+    }
+  });
+  return found;
+}
+
 std::optional<Mesh *> mesh_merge_by_distance_all(const Mesh &mesh,
                                                  const IndexMask &selection,
                                                  const float merge_distance)
 {
   Array<int> vert_dest_map(mesh.verts_num, OUT_OF_CONTEXT);
 
-  KDTree_3d *tree = BLI_kdtree_3d_new(selection.size());
-
   const Span<float3> positions = mesh.vert_positions();
-  selection.foreach_index([&](const int64_t i) { BLI_kdtree_3d_insert(tree, i, positions[i]); });
-
-  BLI_kdtree_3d_balance(tree);
-  const int vert_kill_len = BLI_kdtree_3d_calc_duplicates_fast(
-      tree, merge_distance, true, vert_dest_map.data());
-  BLI_kdtree_3d_free(tree);
+  int vert_kill_len;
+  if (const std::optional<int> grid_kill_len = calc_duplicates_with_grid(
+          positions, selection, merge_distance, vert_dest_map))
+  {
+    vert_kill_len = *grid_kill_len;
+  }
+  else {
+    KDTree_3d *tree = BLI_kdtree_3d_new(selection.size());
+    selection.foreach_index(
+        [&](const int64_t i) { BLI_kdtree_3d_insert(tree, i, positions[i]); });
+    BLI_kdtree_3d_balance(tree);
+    vert_kill_len = BLI_kdtree_3d_calc_duplicates_fast(
+        tree, merge_distance, true, vert_dest_map.data());
+    BLI_kdtree_3d_free(tree);
+  }
 
   if (vert_kill_len == 0) {
     return std::nullopt;
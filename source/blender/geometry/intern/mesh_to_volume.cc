@@ -2,6 +2,7 @@
  *
  * SPDX-License-Identifier: GPL-2.0-or-later */
 
+#include "BLI_array.hh"
 #include "BLI_math_matrix.hh"
 #include "BLI_task.hh"
 
@@ -20,19 +21,20 @@
 
 namespace blender::geometry {
 
-/* This class follows the MeshDataAdapter interface from openvdb. */
+/**
+ * This class follows the MeshDataAdapter interface from openvdb. The positions are expected to be
+ * in index space already, OpenVDB requests every vertex once for each triangle using it.
+ */
 class OpenVDBMeshAdapter {
  private:
   Span<float3> positions_;
   Span<int> corner_verts_;
   Span<int3> corner_tris_;
-  float4x4 transform_;
 
  public:
   OpenVDBMeshAdapter(const Span<float3> positions,
                      const Span<int> corner_verts,
-                     const Span<int3> corner_tris,
-                     const float4x4 &transform);
+                     const Span<int3> corner_tris);
   size_t polygonCount() const;
   size_t pointCount() const;
   size_t vertexCount(size_t /*polygon_index*/) const;
@@ -41,12 +43,8 @@ class OpenVDBMeshAdapter {
 
 OpenVDBMeshAdapter::OpenVDBMeshAdapter(const Span<float3> positions,
                                        const Span<int> corner_verts,
-                                       const Span<int3> corner_tris,
-                                       const float4x4 &transform)
-    : positions_(positions),
-      corner_verts_(corner_verts),
-      corner_tris_(corner_tris),
-      transform_(transform)
+                                       const Span<int3> corner_tris)
+    : positions_(positions), corner_verts_(corner_verts), corner_tris_(corner_tris)
 {
 }
 
@@ -71,9 +69,7 @@ void OpenVDBMeshAdapter::getIndexSpacePoint(size_t polygon_index,
                                             openvdb::Vec3d &pos) const
 {
   const int3 &tri = corner_tris_[polygon_index];
-  const float3 transformed_co = math::transform_point(
-      transform_, positions_[corner_verts_[tri[vertex_index]]]);
-  pos = &transformed_co.x;
+  pos = &positions_[corner_verts_[tri[vertex_index]]].x;
 }
 
 float volume_compute_voxel_size(const Depsgraph *depsgraph,
@@ -128,8 +124,15 @@ static openvdb::FloatGrid::Ptr mesh_to_density_grid_impl(
   /* Better align generated grid with the source mesh. */
   mesh_to_index_space_transform.location() -= 0.5f;
 
-  OpenVDBMeshAdapter mesh_adapter{
-      positions, corner_verts, corner_tris, mesh_to_index_space_transform};
+  Array<float3> index_space_positions(positions.size());
+  threading::parallel_for(positions.index_range(), 2048, [&](const IndexRange range) {
+    for (const int i : range) {
+      index_space_positions[i] = math::transform_point(mesh_to_index_space_transform,
+                                                       positions[i]);
+    }
+  });
+
+  OpenVDBMeshAdapter mesh_adapter{index_space_positions, corner_verts, corner_tris};
   const float interior = std::max(1.0f, interior_band_width / voxel_size);
 
   openvdb::math::Transform::Ptr transform = openvdb::math::Transform::createLinearTransform(
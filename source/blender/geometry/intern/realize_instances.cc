@@ -1666,4 +1666,87 @@ bke::GeometrySet realize_instances(bke::GeometrySet geometry_set,
 
 /** \} */
 
+static int64_t realized_elements_num(const bke::GeometrySet &geometry_set);
+
+static Array<int64_t> realized_elements_num_by_reference(const Instances &instances)
+{
+  const Span<InstanceReference> references = instances.references();
+  Array<int64_t> sizes(references.size(), 0);
+  for (const int i : references.index_range()) {
+    foreach_geometry_in_reference(
+        references[i],
+        float4x4::identity(),
+        0,
+        [&](const bke::GeometrySet &geometry_set, const float4x4 & /*transform*/, uint32_t /*id*/) {
+          sizes[i] += realized_elements_num(geometry_set);
+        });
+  }
+  return sizes;
+}
+
+/** Approximate size of the geometry after realizing it, used to decide how to split the work. */
+static int64_t realized_elements_num(const bke::GeometrySet &geometry_set)
+{
+  int64_t size = 0;
+  if (const Mesh *mesh = geometry_set.get_mesh()) {
+    size += mesh->verts_num + mesh->edges_num + mesh->faces_num + mesh->corners_num;
+  }
+  if (const PointCloud *pointcloud = geometry_set.get_pointcloud()) {
+    size += pointcloud->totpoint;
+  }
+  if (const Curves *curves = geometry_set.get_curves()) {
+    size += curves->geometry.point_num + curves->geometry.curve_num;
+  }
+  if (const Instances *instances = geometry_set.get_instances()) {
+    const Array<int64_t> sizes_by_handle = realized_elements_num_by_reference(*instances);
+    for (const int handle : instances->reference_handles()) {
+      size += sizes_by_handle[handle];
+    }
+  }
+  return size;
+}
+
+void realize_instances_in_parts(bke::GeometrySet geometry_set,
+                                const RealizeInstancesOptions &options,
+                                const int64_t max_part_elements_num,
+                                const FunctionRef<void(bke::GeometrySet part)> fn)
+{
+  const Instances *instances = geometry_set.get_instances();
+  if (instances == nullptr || instances->instances_num() == 0) {
+    fn(realize_instances(std::move(geometry_set), options));
+    return;
+  }
+
+  const Array<int64_t> sizes_by_handle = realized_elements_num_by_reference(*instances);
+  const Span<int> handles = instances->reference_handles();
+
+  auto realize_part = [&](const IndexRange range) {
+    bke::GeometrySet part;
+    if (range.start() == 0) {
+      part = geometry_set;
+    }
+    /* Copying the instances is cheap because the attribute arrays are shared. Only the instances
+     * in the range are copied when the others are removed. */
+    Instances *part_instances = new Instances(*instances);
+    part_instances->remove(range, options.propagation_info);
+    part.replace_instances(part_instances);
+    fn(realize_instances(std::move(part), options));
+  };
+
+  bke::GeometrySet non_instances_geometry = geometry_set;
+  non_instances_geometry.remove(bke::GeometryComponent::Type::Instance);
+  int64_t part_size = realized_elements_num(non_instances_geometry);
+  int64_t part_start = 0;
+  for (const int i : handles.index_range()) {
+    const int64_t instance_size = sizes_by_handle[handles[i]];
+    if (part_size > 0 && part_size + instance_size > max_part_elements_num) {
+      realize_part(IndexRange::from_begin_end(part_start, i));
+      part_start = i;
+      part_size = 0;
+    }
+    part_size += instance_size;
+  }
+  realize_part(IndexRange::from_begin_end(part_start, handles.size()));
+}
+
 }  // namespace blender::geometry
@@ -6,6 +6,7 @@
 #include "BKE_attribute.hh"
 #include "BKE_attribute_math.hh"
 #include "BKE_curves.hh"
+#include "BKE_customdata.hh"
 #include "BKE_geometry_set.hh"
 #include "BKE_instances.hh"
 #include "BKE_mesh.hh"
@@ -41,12 +42,24 @@ components_supported_reordering()
   return supported_types_and_domains;
 }
 
-static void reorder_attributes_group_to_group(const bke::AttributeAccessor src_attributes,
-                                              const bke::AttrDomain domain,
-                                              const OffsetIndices<int> src_offsets,
-                                              const OffsetIndices<int> dst_offsets,
-                                              const Span<int> old_by_new_map,
-                                              bke::MutableAttributeAccessor dst_attributes)
+/**
+ * The result geometry starts out as a copy that shares all attribute arrays with the source. All
+ * generic attributes on the reordered domains are overwritten entirely, so give them new arrays
+ * instead of copying the old values first when they are made mutable.
+ */
+static void unshare_reordered_attributes(CustomData &data, const int size)
+{
+  CustomData_unshare_layers_for_overwrite(&data, CD_MASK_PROP_ALL & ~CD_MASK_PROP_STRING, size);
+}
+
+static void reorder_attributes_group_to_group(
+    const bke::AttributeAccessor src_attributes,
+    const bke::AttrDomain domain,
+    const bke::AnonymousAttributePropagationInfo &propagation_info,
+    const OffsetIndices<int> src_offsets,
+    const OffsetIndices<int> dst_offsets,
+    const Span<int> old_by_new_map,
+    bke::MutableAttributeAccessor dst_attributes)
 {
   src_attributes.for_all(
       [&](const bke::AttributeIDRef &id, const bke::AttributeMetaData meta_data) {
@@ -56,6 +69,9 @@ static void reorder_attributes_group_to_group(const bke::AttributeAccessor src_a
         if (meta_data.data_type == CD_PROP_STRING) {
           return true;
         }
+        if (id.is_anonymous() && !propagation_info.propagate(id.anonymous_id())) {
+          return true;
+        }
         const GVArray src = *src_attributes.lookup(id, domain);
         bke::GSpanAttributeWriter dst = dst_attributes.lookup_or_add_for_write_only_span(
             id, domain, meta_data.data_type);
@@ -88,11 +104,13 @@ static Array<int> invert_permutation(const Span<int> permutation)
 
 static void reorder_mesh_verts_exec(const Mesh &src_mesh,
                                     const Span<int> old_by_new_map,
+                                    const bke::AnonymousAttributePropagationInfo &propagation_info,
                                     Mesh &dst_mesh)
 {
+  unshare_reordered_attributes(dst_mesh.vert_data, dst_mesh.verts_num);
   bke::gather_attributes(src_mesh.attributes(),
                          bke::AttrDomain::Point,
-                         {},
+                         propagation_info,
                          {},
                          old_by_new_map,
                          dst_mesh.attributes_for_write());
@@ -106,11 +124,13 @@ static void reorder_mesh_verts_exec(const Mesh &src_mesh,
 
 static void reorder_mesh_edges_exec(const Mesh &src_mesh,
                                     const Span<int> old_by_new_map,
+                                    const bke::AnonymousAttributePropagationInfo &propagation_info,
                                     Mesh &dst_mesh)
 {
+  unshare_reordered_attributes(dst_mesh.edge_data, dst_mesh.edges_num);
   bke::gather_attributes(src_mesh.attributes(),
                          bke::AttrDomain::Edge,
-                         {},
+                         propagation_info,
                          {},
                          old_by_new_map,
                          dst_mesh.attributes_for_write());
@@ -121,11 +141,14 @@ static void reorder_mesh_edges_exec(const Mesh &src_mesh,
 
 static void reorder_mesh_faces_exec(const Mesh &src_mesh,
                                     const Span<int> old_by_new_map,
+                                    const bke::AnonymousAttributePropagationInfo &propagation_info,
                                     Mesh &dst_mesh)
 {
+  unshare_reordered_attributes(dst_mesh.face_data, dst_mesh.faces_num);
+  unshare_reordered_attributes(dst_mesh.corner_data, dst_mesh.corners_num);
   bke::gather_attributes(src_mesh.attributes(),
                          bke::AttrDomain::Face,
-                         {},
+                         propagation_info,
                          {},
                          old_by_new_map,
                          dst_mesh.attributes_for_write());
@@ -135,6 +158,7 @@ static void reorder_mesh_faces_exec(const Mesh &src_mesh,
   offset_indices::accumulate_counts_to_offsets(new_offsets);
   reorder_attributes_group_to_group(src_mesh.attributes(),
                                     bke::AttrDomain::Corner,
+                                    propagation_info,
                                     old_offsets,
                                     new_offsets.as_span(),
                                     old_by_new_map,
@@ -144,17 +168,18 @@ static void reorder_mesh_faces_exec(const Mesh &src_mesh,
 static void reorder_mesh_exec(const Mesh &src_mesh,
                               const Span<int> old_by_new_map,
                               const bke::AttrDomain domain,
+                              const bke::AnonymousAttributePropagationInfo &propagation_info,
                               Mesh &dst_mesh)
 {
   switch (domain) {
     case bke::AttrDomain::Point:
-      reorder_mesh_verts_exec(src_mesh, old_by_new_map, dst_mesh);
+      reorder_mesh_verts_exec(src_mesh, old_by_new_map, propagation_info, dst_mesh);
       break;
     case bke::AttrDomain::Edge:
-      reorder_mesh_edges_exec(src_mesh, old_by_new_map, dst_mesh);
+      reorder_mesh_edges_exec(src_mesh, old_by_new_map, propagation_info, dst_mesh);
       break;
     case bke::AttrDomain::Face:
-      reorder_mesh_faces_exec(src_mesh, old_by_new_map, dst_mesh);
+      reorder_mesh_faces_exec(src_mesh, old_by_new_map, propagation_info, dst_mesh);
       break;
     default:
       break;
@@ -165,11 +190,13 @@ static void reorder_mesh_exec(const Mesh &src_mesh,
 
 static void reorder_points_exec(const PointCloud &src_pointcloud,
                                 const Span<int> old_by_new_map,
+                                const bke::AnonymousAttributePropagationInfo &propagation_info,
                                 PointCloud &dst_pointcloud)
 {
+  unshare_reordered_attributes(dst_pointcloud.pdata, dst_pointcloud.totpoint);
   bke::gather_attributes(src_pointcloud.attributes(),
                          bke::AttrDomain::Point,
-                         {},
+                         propagation_info,
                          {},
                          old_by_new_map,
                          dst_pointcloud.attributes_for_write());
@@ -179,11 +206,14 @@ static void reorder_points_exec(const PointCloud &src_pointcloud,
 
 static void reorder_curves_exec(const bke::CurvesGeometry &src_curves,
                                 const Span<int> old_by_new_map,
+                                const bke::AnonymousAttributePropagationInfo &propagation_info,
                                 bke::CurvesGeometry &dst_curves)
 {
+  unshare_reordered_attributes(dst_curves.curve_data, dst_curves.curves_num());
+  unshare_reordered_attributes(dst_curves.point_data, dst_curves.points_num());
   bke::gather_attributes(src_curves.attributes(),
                          bke::AttrDomain::Curve,
-                         {},
+                         propagation_info,
                          {},
                          old_by_new_map,
                          dst_curves.attributes_for_write());
@@ -195,6 +225,7 @@ static void reorder_curves_exec(const bke::CurvesGeometry &src_curves,
 
   reorder_attributes_group_to_group(src_curves.attributes(),
                                     bke::AttrDomain::Point,
+                                    propagation_info,
                                     old_offsets,
                                     new_offsets.as_span(),
                                     old_by_new_map,
@@ -204,11 +235,14 @@ static void reorder_curves_exec(const bke::CurvesGeometry &src_curves,
 
 static void reorder_instaces_exec(const bke::Instances &src_instances,
                                   const Span<int> old_by_new_map,
+                                  const bke::AnonymousAttributePropagationInfo &propagation_info,
                                   bke::Instances &dst_instances)
 {
+  unshare_reordered_attributes(dst_instances.custom_data_attributes(),
+                               dst_instances.instances_num());
   bke::gather_attributes(src_instances.attributes(),
                          bke::AttrDomain::Instance,
-                         {},
+                         propagation_info,
                          {},
                          old_by_new_map,
                          dst_instances.attributes_for_write());
@@ -244,7 +278,7 @@ Mesh *reorder_mesh(const Mesh &src_mesh,
 {
   Mesh *dst_mesh = BKE_mesh_copy_for_eval(&src_mesh);
   clean_unused_attributes(propagation_info, dst_mesh->attributes_for_write());
-  reorder_mesh_exec(src_mesh, old_by_new_map, domain, *dst_mesh);
+  reorder_mesh_exec(src_mesh, old_by_new_map, domain, propagation_info, *dst_mesh);
   return dst_mesh;
 }
 
@@ -254,7 +288,7 @@ PointCloud *reorder_points(const PointCloud &src_pointcloud,
 {
   PointCloud *dst_pointcloud = BKE_pointcloud_copy_for_eval(&src_pointcloud);
   clean_unused_attributes(propagation_info, dst_pointcloud->attributes_for_write());
-  reorder_points_exec(src_pointcloud, old_by_new_map, *dst_pointcloud);
+  reorder_points_exec(src_pointcloud, old_by_new_map, propagation_info, *dst_pointcloud);
   return dst_pointcloud;
 }
 
@@ -265,7 +299,7 @@ bke::CurvesGeometry reorder_curves_geometry(
 {
   bke::CurvesGeometry dst_curves = bke::CurvesGeometry(src_curves);
   clean_unused_attributes(propagation_info, dst_curves.attributes_for_write());
-  reorder_curves_exec(src_curves, old_by_new_map, dst_curves);
+  reorder_curves_exec(src_curves, old_by_new_map, propagation_info, dst_curves);
   return dst_curves;
 }
 
@@ -286,7 +320,7 @@ bke::Instances *reorder_instaces(const bke::Instances &src_instances,
 {
   bke::Instances *dst_instances = new bke::Instances(src_instances);
   clean_unused_attributes(propagation_info, dst_instances->attributes_for_write());
-  reorder_instaces_exec(src_instances, old_by_new_map, *dst_instances);
+  reorder_instaces_exec(src_instances, old_by_new_map, propagation_info, *dst_instances);
   return dst_instances;
 }
 
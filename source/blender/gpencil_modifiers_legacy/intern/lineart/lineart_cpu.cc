@@ -21,6 +21,7 @@
 #include "BLI_sort.hh"
 #include "BLI_string.h"
 #include "BLI_task.h"
+#include "BLI_task.hh"
 #include "BLI_time.h"
 #include "BLI_utildefines.h"
 #include "BLI_vector.hh"
@@ -1374,23 +1375,27 @@ void lineart_main_free_adjacent_data(LineartData *ld)
 
 void lineart_main_perspective_division(LineartData *ld)
 {
+  /* Z isn't re-mapped into (0-1) range, because we no longer need NDC (Normalized Device
+   * Coordinates) at the moment.
+   * The algorithm currently doesn't need Z for operation, we use W instead. If Z is needed
+   * in the future, the line below correctly transforms it to view space coordinates. */
+  // `vt[i].fbcoord[2] = -2 * vt[i].fbcoord[2] / (far - near) - (far + near) / (far - near);
   LISTBASE_FOREACH (LineartElementLinkNode *, eln, &ld->geom.vertex_buffer_pointers) {
     LineartVert *vt = static_cast<LineartVert *>(eln->pointer);
-    for (int i = 0; i < eln->element_count; i++) {
-      if (ld->conf.cam_is_persp) {
-        /* Do not divide Z, we use Z to back transform cut points in later chaining process. */
-        vt[i].fbcoord[0] /= vt[i].fbcoord[3];
-        vt[i].fbcoord[1] /= vt[i].fbcoord[3];
-        /* Re-map z into (0-1) range, because we no longer need NDC (Normalized Device Coordinates)
-         * at the moment.
-         * The algorithm currently doesn't need Z for operation, we use W instead. If Z is needed
-         * in the future, the line below correctly transforms it to view space coordinates. */
-        // `vt[i].fbcoord[2] = -2 * vt[i].fbcoord[2] / (far - near) - (far + near) / (far - near);
-      }
-      /* Shifting is always needed. */
-      vt[i].fbcoord[0] -= ld->conf.shift_x * 2;
-      vt[i].fbcoord[1] -= ld->conf.shift_y * 2;
-    }
+    blender::threading::parallel_for(
+        blender::IndexRange(eln->element_count), 4096, [&](const blender::IndexRange range) {
+          for (const int64_t i : range) {
+            if (ld->conf.cam_is_persp) {
+              /* Do not divide Z, we use Z to back transform cut points in later chaining
+               * process. Z isn't re-mapped into (0-1) range either, see below. */
+              vt[i].fbcoord[0] /= vt[i].fbcoord[3];
+              vt[i].fbcoord[1] /= vt[i].fbcoord[3];
+            }
+            /* Shifting is always needed. */
+            vt[i].fbcoord[0] -= ld->conf.shift_x * 2;
+            vt[i].fbcoord[1] -= ld->conf.shift_y * 2;
+          }
+        });
   }
 }
 
@@ -1404,24 +1409,27 @@ void lineart_main_discard_out_of_frame_edges(LineartData *ld)
 
   LISTBASE_FOREACH (LineartElementLinkNode *, eln, &ld->geom.line_buffer_pointers) {
     e = (LineartEdge *)eln->pointer;
-    for (int i = 0; i < eln->element_count; i++) {
-      if (!e[i].v1 || !e[i].v2) {
-        e[i].flags = MOD_LINEART_EDGE_FLAG_CHAIN_PICKED;
-        continue;
-      }
-      const blender::float2 vec1(e[i].v1->fbcoord), vec2(e[i].v2->fbcoord);
-      if (LRT_VERT_OUT_OF_BOUND(e[i].v1) && LRT_VERT_OUT_OF_BOUND(e[i].v2)) {
-        /* A line could still cross the image border even when both of the vertices are out of
-         * bound. */
-        if (isect_seg_seg_v2(bounds[0], bounds[1], vec1, vec2) == ISECT_LINE_LINE_NONE &&
-            isect_seg_seg_v2(bounds[0], bounds[2], vec1, vec2) == ISECT_LINE_LINE_NONE &&
-            isect_seg_seg_v2(bounds[1], bounds[3], vec1, vec2) == ISECT_LINE_LINE_NONE &&
-            isect_seg_seg_v2(bounds[2], bounds[3], vec1, vec2) == ISECT_LINE_LINE_NONE)
-        {
-          e[i].flags = MOD_LINEART_EDGE_FLAG_CHAIN_PICKED;
-        }
-      }
-    }
+    blender::threading::parallel_for(
+        blender::IndexRange(eln->element_count), 2048, [&](const blender::IndexRange range) {
+          for (const int64_t i : range) {
+            if (!e[i].v1 || !e[i].v2) {
+              e[i].flags = MOD_LINEART_EDGE_FLAG_CHAIN_PICKED;
+              continue;
+            }
+            const blender::float2 vec1(e[i].v1->fbcoord), vec2(e[i].v2->fbcoord);
+            if (LRT_VERT_OUT_OF_BOUND(e[i].v1) && LRT_VERT_OUT_OF_BOUND(e[i].v2)) {
+              /* A line could still cross the image border even when both of the vertices are
+               * out of bound. */
+              if (isect_seg_seg_v2(bounds[0], bounds[1], vec1, vec2) == ISECT_LINE_LINE_NONE &&
+                  isect_seg_seg_v2(bounds[0], bounds[2], vec1, vec2) == ISECT_LINE_LINE_NONE &&
+                  isect_seg_seg_v2(bounds[1], bounds[3], vec1, vec2) == ISECT_LINE_LINE_NONE &&
+                  isect_seg_seg_v2(bounds[2], bounds[3], vec1, vec2) == ISECT_LINE_LINE_NONE)
+              {
+                e[i].flags = MOD_LINEART_EDGE_FLAG_CHAIN_PICKED;
+              }
+            }
+          }
+        });
   }
 }
 
@@ -11,3 +11,7 @@
 /* gpu_backend.cc */
 
 void gpu_backend_delete_resources();
+
+/* gpu_select.cc */
+
+void gpu_select_exit();
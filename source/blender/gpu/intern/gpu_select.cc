@@ -19,6 +19,7 @@
 
 #include "BLI_utildefines.h"
 
+#include "gpu_private.hh"
 #include "gpu_select_private.hh"
 
 /* -------------------------------------------------------------------- */
@@ -315,3 +316,14 @@ void GPU_select_buffer_stride_realign(const rcti *src, const rcti *dst, uint *r_
 }
 
 /** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name Exit
+ * \{ */
+
+void gpu_select_exit()
+{
+  gpu_select_pick_exit();
+}
+
+/** \} */
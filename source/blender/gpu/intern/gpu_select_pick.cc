@@ -103,14 +103,54 @@ struct DepthBufCache {
   depth_t buf[0];
 };
 
+/**
+ * Depth buffers that are no longer in use, kept between selections to avoid re-allocating them
+ * on every pass (picking is typically performed repeatedly with the same region size).
+ * All buffers in the pool have `pool_rect_len` elements.
+ */
+static ListBase g_depth_buf_pool = {nullptr, nullptr};
+static uint g_depth_buf_pool_rect_len = 0;
+static uint g_depth_buf_pool_len = 0;
+/** Limit the memory kept around after a selection with many passes was cached. */
+#define DEPTH_BUF_POOL_MAX 16
+
+static void depth_buf_pool_clear()
+{
+  BLI_freelistN(&g_depth_buf_pool);
+  g_depth_buf_pool_len = 0;
+}
+
 static DepthBufCache *depth_buf_malloc(uint rect_len)
 {
-  DepthBufCache *rect = static_cast<DepthBufCache *>(
-      MEM_mallocN(sizeof(DepthBufCache) + sizeof(depth_t) * rect_len, __func__));
+  DepthBufCache *rect;
+  if (g_depth_buf_pool_rect_len == rect_len && g_depth_buf_pool.first != nullptr) {
+    rect = static_cast<DepthBufCache *>(BLI_pophead(&g_depth_buf_pool));
+    g_depth_buf_pool_len--;
+  }
+  else {
+    rect = static_cast<DepthBufCache *>(
+        MEM_mallocN(sizeof(DepthBufCache) + sizeof(depth_t) * rect_len, __func__));
+  }
   rect->id = SELECT_ID_NONE;
   return rect;
 }
 
+/** Return a buffer created by #depth_buf_malloc to the pool, freeing it when the pool is full. */
+static void depth_buf_free(DepthBufCache *rect, uint rect_len)
+{
+  if (g_depth_buf_pool_rect_len != rect_len) {
+    depth_buf_pool_clear();
+    g_depth_buf_pool_rect_len = rect_len;
+  }
+  if (g_depth_buf_pool_len < DEPTH_BUF_POOL_MAX) {
+    BLI_addtail(&g_depth_buf_pool, rect);
+    g_depth_buf_pool_len++;
+  }
+  else {
+    MEM_freeN(rect);
+  }
+}
+
 static bool depth_buf_rect_depth_any(const DepthBufCache *rect_depth, uint rect_len)
 {
   const depth_t *curr = rect_depth->buf;
@@ -673,8 +713,14 @@ uint gpu_select_pick_end()
 
   MEM_freeN(depth_data);
 
-  MEM_SAFE_FREE(ps->gpu.rect_depth);
-  MEM_SAFE_FREE(ps->gpu.rect_depth_test);
+  if (ps->gpu.rect_depth) {
+    depth_buf_free(ps->gpu.rect_depth, ps->src.rect_len);
+    ps->gpu.rect_depth = nullptr;
+  }
+  if (ps->gpu.rect_depth_test) {
+    depth_buf_free(ps->gpu.rect_depth_test, ps->src.rect_len);
+    ps->gpu.rect_depth_test = nullptr;
+  }
 
   if (g_pick_state.mode == GPU_SELECT_PICK_ALL) {
     /* 'hits' already freed as 'depth_data' */
@@ -717,7 +763,10 @@ void gpu_select_pick_cache_end()
   g_pick_state.use_cache = false;
   g_pick_state.is_cached = false;
 
-  BLI_freelistN(&g_pick_state.cache.bufs);
+  LISTBASE_FOREACH_MUTABLE (DepthBufCache *, rect_depth, &g_pick_state.cache.bufs) {
+    depth_buf_free(rect_depth, g_pick_state.src.rect_len);
+  }
+  BLI_listbase_clear(&g_pick_state.cache.bufs);
 }
 
 bool gpu_select_pick_is_cached()
@@ -752,3 +801,16 @@ void gpu_select_pick_cache_load_id()
 }
 
 /** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name Exit
+ * \{ */
+
+void gpu_select_pick_exit()
+{
+  BLI_assert(g_pick_state.use_cache == false);
+  depth_buf_pool_clear();
+  g_depth_buf_pool_rect_len = 0;
+}
+
+/** \} */
@@ -23,6 +23,8 @@ void gpu_select_pick_cache_end();
  */
 bool gpu_select_pick_is_cached();
 void gpu_select_pick_cache_load_id();
+/** Free memory kept between selections. */
+void gpu_select_pick_exit();
 
 /* gpu_select_sample_query */
 
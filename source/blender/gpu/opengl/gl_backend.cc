@@ -320,6 +320,8 @@ static void detect_workarounds()
     GLContext::native_barycentric_support = false;
     GLContext::framebuffer_fetch_support = false;
     GLContext::texture_barrier_support = false;
+    /* Always compile shaders from source. */
+    GLContext::program_binary_support = false;
 
 #if 0
     /* Do not alter OpenGL 4.3 features.
@@ -487,6 +489,7 @@ bool GLContext::explicit_location_support = false;
 bool GLContext::framebuffer_fetch_support = false;
 bool GLContext::layered_rendering_support = false;
 bool GLContext::native_barycentric_support = false;
+bool GLContext::program_binary_support = false;
 bool GLContext::multi_bind_support = false;
 bool GLContext::multi_bind_image_support = false;
 bool GLContext::multi_draw_indirect_support = false;
@@ -579,6 +582,11 @@ void GLBackend::capabilities_init()
   GLContext::shader_draw_parameters_support = epoxy_has_gl_extension(
       "GL_ARB_shader_draw_parameters");
   GLContext::stencil_texturing_support = epoxy_gl_version() >= 43;
+  if (epoxy_gl_version() >= 41 || epoxy_has_gl_extension("GL_ARB_get_program_binary")) {
+    GLint binary_formats_len = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &binary_formats_len);
+    GLContext::program_binary_support = binary_formats_len > 0;
+  }
   GLContext::texture_filter_anisotropic_support = epoxy_has_gl_extension(
       "GL_EXT_texture_filter_anisotropic");
 
@@ -592,6 +600,10 @@ void GLBackend::capabilities_init()
     GLContext::debug_layer_support = false;
     GLContext::debug_layer_workaround = false;
   }
+  else {
+    /* Compile all shaders from source so their logs are reported. */
+    GLContext::program_binary_support = false;
+  }
 }
 
 /** \} */
@@ -54,6 +54,7 @@ class GLContext : public Context {
   static bool framebuffer_fetch_support;
   static bool layered_rendering_support;
   static bool native_barycentric_support;
+  static bool program_binary_support;
   static bool multi_bind_support;
   static bool multi_bind_image_support;
   static bool multi_draw_indirect_support;
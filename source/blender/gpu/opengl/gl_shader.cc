@@ -8,8 +8,13 @@
 
 #include <iomanip>
 
+#include "BKE_appdir.hh"
 #include "BKE_global.hh"
 
+#include "BLI_array.hh"
+#include "BLI_fileops.h"
+#include "BLI_hash_md5.hh"
+#include "BLI_path_util.h"
 #include "BLI_string.h"
 #include "BLI_vector.hh"
 
@@ -17,6 +22,7 @@
 #include "GPU_platform.hh"
 #include "gpu_shader_dependency_private.hh"
 
+#include "gl_context.hh"
 #include "gl_debug.hh"
 #include "gl_vertex_buffer.hh"
 
@@ -1101,16 +1107,19 @@ GLuint GLShader::create_shader_stage(GLenum gl_stage,
     return 0;
   }
 
+  /* Rebuild the sources from the stored ones when compiling a deferred stage or a different
+   * set of specialization constants. */
+  Vector<const char *> recreated_sources;
+  if (sources.is_empty()) {
+    recreated_sources = gl_sources.sources_get();
+    sources = recreated_sources;
+  }
+
   /* Patch the shader sources to include specialization constants. */
   std::string constants_source;
-  Vector<const char *> recreated_sources;
   const bool has_specialization_constants = !constants.types.is_empty();
   if (has_specialization_constants) {
     constants_source = constants_declare();
-    if (sources.is_empty()) {
-      recreated_sources = gl_sources.sources_get();
-      sources = recreated_sources;
-    }
   }
 
   /* Patch the shader code using the first source slot. */
@@ -1180,17 +1189,20 @@ GLuint GLShader::create_shader_stage(GLenum gl_stage,
 void GLShader::update_program_and_sources(GLSources &stage_sources,
                                           MutableSpan<const char *> sources)
 {
+  init_program();
+
   const bool has_specialization_constants = !constants.types.is_empty();
-  if (has_specialization_constants && stage_sources.is_empty()) {
+  if ((has_specialization_constants || use_program_binary_cache_) && stage_sources.is_empty()) {
     stage_sources = sources;
   }
-
-  init_program();
 }
 
 void GLShader::vertex_shader_from_glsl(MutableSpan<const char *> sources)
 {
   update_program_and_sources(vertex_sources_, sources);
+  if (use_program_binary_cache_) {
+    return;
+  }
   program_active_->vert_shader = this->create_shader_stage(
       GL_VERTEX_SHADER, sources, vertex_sources_);
 }
@@ -1198,6 +1210,9 @@ void GLShader::vertex_shader_from_glsl(MutableSpan<const char *> sources)
 void GLShader::geometry_shader_from_glsl(MutableSpan<const char *> sources)
 {
   update_program_and_sources(geometry_sources_, sources);
+  if (use_program_binary_cache_) {
+    return;
+  }
   program_active_->geom_shader = this->create_shader_stage(
       GL_GEOMETRY_SHADER, sources, geometry_sources_);
 }
@@ -1205,6 +1220,9 @@ void GLShader::geometry_shader_from_glsl(MutableSpan<const char *> sources)
 void GLShader::fragment_shader_from_glsl(MutableSpan<const char *> sources)
 {
   update_program_and_sources(fragment_sources_, sources);
+  if (use_program_binary_cache_) {
+    return;
+  }
   program_active_->frag_shader = this->create_shader_stage(
       GL_FRAGMENT_SHADER, sources, fragment_sources_);
 }
@@ -1212,6 +1230,9 @@ void GLShader::fragment_shader_from_glsl(MutableSpan<const char *> sources)
 void GLShader::compute_shader_from_glsl(MutableSpan<const char *> sources)
 {
   update_program_and_sources(compute_sources_, sources);
+  if (use_program_binary_cache_) {
+    return;
+  }
   program_active_->compute_shader = this->create_shader_stage(
       GL_COMPUTE_SHADER, sources, compute_sources_);
 }
@@ -1231,7 +1252,7 @@ bool GLShader::finalize(const shader::ShaderCreateInfo *info)
     geometry_shader_from_glsl(sources);
   }
 
-  if (!program_link()) {
+  if (use_program_binary_cache_ ? !program_link_cached() : !program_link()) {
     return false;
   }
 
@@ -1492,6 +1513,10 @@ void GLShader::init_program()
     return;
   }
 
+  /* Programs using specialization constants are linked once per set of values,
+   * they don't use the binary cache. */
+  use_program_binary_cache_ = GLContext::program_binary_support && constants.types.is_empty();
+
   program_active_ = &program_cache_.lookup_or_add_default(constants.values);
   if (!program_active_->program_id) {
     program_active_->program_id = glCreateProgram();
@@ -1542,3 +1567,187 @@ GLuint GLShader::program_get()
 }
 
 /** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name Program Binary Cache
+ *
+ * Linked programs are stored on disk using `glGetProgramBinary` so that following sessions can
+ * skip compiling and linking shaders whose sources didn't change. Files are named after the
+ * #GLShader::program_binary_key, which includes the driver identification, so binaries of other
+ * drivers are never loaded. The driver can still reject a binary (e.g., after an update which
+ * didn't change the version string), in which case the program is compiled from source again.
+ * \{ */
+
+/** Increase when the layout of the cache files changes. */
+static constexpr uint32_t PROGRAM_BINARY_CACHE_VERSION = 1;
+
+struct ProgramBinaryHeader {
+  uint32_t version;
+  uint32_t format;
+  uint32_t size;
+};
+
+/** Directory of the program binary cache, empty when it can't be used. */
+static const std::string &program_binary_cache_dir()
+{
+  static const std::string dir = []() {
+    char path[FILE_MAX];
+    if (!BKE_appdir_folder_caches(path, sizeof(path))) {
+      return std::string();
+    }
+    BLI_path_append_dir(path, sizeof(path), "shaders");
+    BLI_path_append_dir(path, sizeof(path), "opengl");
+    return std::string(path);
+  }();
+  return dir;
+}
+
+static bool program_binary_load(const GLuint program_id, const char *filepath)
+{
+  size_t file_size = 0;
+  void *data = BLI_file_read_binary_as_mem(filepath, 0, &file_size);
+  if (data == nullptr) {
+    return false;
+  }
+
+  bool success = false;
+  const ProgramBinaryHeader *header = static_cast<const ProgramBinaryHeader *>(data);
+  if (file_size >= sizeof(ProgramBinaryHeader) &&
+      header->version == PROGRAM_BINARY_CACHE_VERSION &&
+      header->size == file_size - sizeof(ProgramBinaryHeader))
+  {
+    glProgramBinary(program_id, header->format, header + 1, header->size);
+    GLint status;
+    glGetProgramiv(program_id, GL_LINK_STATUS, &status);
+    success = bool(status);
+  }
+  MEM_freeN(data);
+  return success;
+}
+
+static void program_binary_save(const GLuint program_id, const char *filepath)
+{
+  GLint binary_len = 0;
+  glGetProgramiv(program_id, GL_PROGRAM_BINARY_LENGTH, &binary_len);
+  if (binary_len <= 0) {
+    return;
+  }
+
+  Array<uint8_t> binary(binary_len);
+  GLenum format;
+  glGetProgramBinary(program_id, binary_len, &binary_len, &format, binary.data());
+  if (binary_len <= 0) {
+    return;
+  }
+
+  ProgramBinaryHeader header;
+  header.version = PROGRAM_BINARY_CACHE_VERSION;
+  header.format = format;
+  header.size = binary_len;
+
+  if (!BLI_file_ensure_parent_dir_exists(filepath)) {
+    return;
+  }
+  /* Write to a temporary file first, so other sessions never read a partially written one. */
+  char filepath_tmp[FILE_MAX];
+  SNPRINTF(filepath_tmp, "%s@", filepath);
+  FILE *file = BLI_fopen(filepath_tmp, "wb");
+  if (file == nullptr) {
+    return;
+  }
+  const bool written = fwrite(&header, sizeof(header), 1, file) == 1 &&
+                       fwrite(binary.data(), binary_len, 1, file) == 1;
+  fclose(file);
+  if (!written || BLI_rename_overwrite(filepath_tmp, filepath) != 0) {
+    BLI_delete(filepath_tmp, false, false);
+  }
+}
+
+std::string GLShader::program_binary_key()
+{
+  std::string key;
+  for (const GLenum name : {GL_VENDOR, GL_RENDERER, GL_VERSION}) {
+    key += reinterpret_cast<const char *>(glGetString(name));
+    key += '\n';
+  }
+
+  auto add_stage = [&](const GLenum gl_stage, const GLSources &stage_sources) {
+    if (stage_sources.is_empty()) {
+      return;
+    }
+    key += std::to_string(gl_stage);
+    key += glsl_patch_get(gl_stage);
+    const Vector<const char *> sources = stage_sources.sources_get();
+    for (const char *source : sources.as_span().drop_front(SOURCES_INDEX_VERSION + 1)) {
+      key += source;
+    }
+  };
+  add_stage(GL_VERTEX_SHADER, vertex_sources_);
+  add_stage(GL_GEOMETRY_SHADER, geometry_sources_);
+  add_stage(GL_FRAGMENT_SHADER, fragment_sources_);
+  add_stage(GL_COMPUTE_SHADER, compute_sources_);
+
+  char digest[16];
+  BLI_hash_md5_buffer(key.data(), key.size(), digest);
+  char digest_hex[33];
+  return BLI_hash_md5_to_hexdigest(digest, digest_hex);
+}
+
+bool GLShader::program_link_cached()
+{
+  BLI_assert(use_program_binary_cache_);
+  const GLuint program_id = program_active_->program_id;
+
+  /* The transform feedback varyings aren't part of the key. */
+  const bool use_cache = transform_feedback_type_ == GPU_SHADER_TFB_NONE &&
+                         !program_binary_cache_dir().empty();
+
+  char filepath[FILE_MAX] = "";
+  if (use_cache) {
+    const std::string filename = program_binary_key() + ".bin";
+    BLI_path_join(
+        filepath, sizeof(filepath), program_binary_cache_dir().c_str(), filename.c_str());
+  }
+
+  bool success = use_cache && program_binary_load(program_id, filepath);
+  if (!success) {
+    MutableSpan<const char *> no_sources;
+    if (!vertex_sources_.is_empty()) {
+      program_active_->vert_shader = create_shader_stage(
+          GL_VERTEX_SHADER, no_sources, vertex_sources_);
+    }
+    if (!geometry_sources_.is_empty()) {
+      program_active_->geom_shader = create_shader_stage(
+          GL_GEOMETRY_SHADER, no_sources, geometry_sources_);
+    }
+    if (!fragment_sources_.is_empty()) {
+      program_active_->frag_shader = create_shader_stage(
+          GL_FRAGMENT_SHADER, no_sources, fragment_sources_);
+    }
+    if (!compute_sources_.is_empty()) {
+      program_active_->compute_shader = create_shader_stage(
+          GL_COMPUTE_SHADER, no_sources, compute_sources_);
+    }
+    if (compilation_failed_) {
+      return false;
+    }
+
+    if (use_cache) {
+      glProgramParameteri(program_id, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    }
+    success = program_link();
+    if (success && use_cache) {
+      program_binary_save(program_id, filepath);
+    }
+  }
+
+  /* The sources are only needed again for programs using specialization constants. The compute
+   * sources are kept as they are used by #is_compute. */
+  vertex_sources_.clear_and_shrink();
+  geometry_sources_.clear_and_shrink();
+  fragment_sources_.clear_and_shrink();
+
+  return success;
+}
+
+/** \} */
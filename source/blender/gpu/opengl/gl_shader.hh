@@ -114,6 +114,22 @@ class GLShader : public Shader {
    */
   bool program_link();
 
+  /**
+   * When true, the stages are not compiled when their sources are given. Instead the sources are
+   * kept and the program is loaded from the program binary cache when finalizing, and only
+   * compiled and linked (and added to the cache) when it isn't found.
+   * See #GLShader::program_link_cached.
+   */
+  bool use_program_binary_cache_ = false;
+
+  /**
+   * Load the active program from the program binary cache, or compile it from the kept stage
+   * sources and store the result in the cache.
+   */
+  bool program_link_cached();
+  /** Hash of the driver and of the final sources of all stages, used to find cached binaries. */
+  std::string program_binary_key();
+
   /**
    * Return a GLProgram program id that reflects the current state of shader.constants.values.
    * The returned program_id is in linked state, or an error happened during linking.
@@ -26,6 +26,7 @@ VKCommandBufferWrapper::VKCommandBufferWrapper()
 
   vk_command_buffer_begin_info_ = {};
   vk_command_buffer_begin_info_.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+  vk_command_buffer_begin_info_.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
 
   vk_fence_create_info_ = {};
   vk_fence_create_info_.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
@@ -48,8 +49,10 @@ VKCommandBufferWrapper::~VKCommandBufferWrapper()
   VKDevice &device = VKBackend::get().device_get();
 
   if (vk_command_pool_ != VK_NULL_HANDLE) {
+    /* Also frees the command buffer allocated from it. */
     vkDestroyCommandPool(device.device_get(), vk_command_pool_, vk_allocation_callbacks);
     vk_command_pool_ = VK_NULL_HANDLE;
+    vk_command_buffer_ = VK_NULL_HANDLE;
   }
   if (vk_fence_ != VK_NULL_HANDLE) {
     vkDestroyFence(device.device_get(), vk_fence_, vk_allocation_callbacks);
@@ -74,9 +77,16 @@ void VKCommandBufferWrapper::begin_recording()
     vkCreateFence(
         device.device_get(), &vk_fence_create_info_, vk_allocation_callbacks, &vk_fence_);
   }
-  BLI_assert(vk_command_buffer_ == VK_NULL_HANDLE);
-  vkAllocateCommandBuffers(
-      device.device_get(), &vk_command_buffer_allocate_info_, &vk_command_buffer_);
+  if (vk_command_buffer_ == VK_NULL_HANDLE) {
+    vkAllocateCommandBuffers(
+        device.device_get(), &vk_command_buffer_allocate_info_, &vk_command_buffer_);
+  }
+  else {
+    /* The command buffer is reused for every submission, instead of allocating a new one each
+     * time from the pool. Beginning it implicitly resets it, which is only allowed when the
+     * previous submission has finished. */
+    wait_for_cpu_synchronization();
+  }
 
   vkBeginCommandBuffer(vk_command_buffer_, &vk_command_buffer_begin_info_);
 }
@@ -91,7 +101,6 @@ void VKCommandBufferWrapper::submit_with_cpu_synchronization()
   VKDevice &device = VKBackend::get().device_get();
   vkResetFences(device.device_get(), 1, &vk_fence_);
   vkQueueSubmit(device.queue_get(), 1, &vk_submit_info_, vk_fence_);
-  vk_command_buffer_ = VK_NULL_HANDLE;
 }
 
 void VKCommandBufferWrapper::wait_for_cpu_synchronization()
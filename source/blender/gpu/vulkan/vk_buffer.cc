@@ -46,15 +46,11 @@ static VkMemoryPropertyFlags vma_preferred_flags(const bool is_host_visible)
                            VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
 }
 
-/*
- * TODO: Check which memory is selected and adjust the creation flag to add mapping. This way the
- * staging buffer can be skipped, or in case of a vertex buffer an intermediate buffer can be
- * removed.
- */
 bool VKBuffer::create(int64_t size_in_bytes,
                       GPUUsageType usage,
                       VkBufferUsageFlags buffer_usage,
-                      const bool is_host_visible)
+                      const bool is_host_visible,
+                      const bool allow_host_upload)
 {
   BLI_assert(!is_allocated());
   BLI_assert(vk_buffer_ == VK_NULL_HANDLE);
@@ -85,6 +81,11 @@ bool VKBuffer::create(int64_t size_in_bytes,
   vma_create_info.priority = 1.0f;
   vma_create_info.preferredFlags = vma_preferred_flags(is_host_visible);
   vma_create_info.usage = VMA_MEMORY_USAGE_AUTO;
+  const bool try_host_upload = allow_host_upload && !is_host_visible;
+  if (try_host_upload) {
+    vma_create_info.flags |= VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT |
+                             VMA_ALLOCATION_CREATE_HOST_ACCESS_ALLOW_TRANSFER_INSTEAD_BIT;
+  }
 
   VkResult result = vmaCreateBuffer(
       allocator, &create_info, &vma_create_info, &vk_buffer_, &allocation_, nullptr);
@@ -99,6 +100,13 @@ bool VKBuffer::create(int64_t size_in_bytes,
   if (is_host_visible) {
     return map();
   }
+  if (try_host_upload) {
+    VkMemoryPropertyFlags memory_properties;
+    vmaGetAllocationMemoryProperties(allocator, allocation_, &memory_properties);
+    if (memory_properties & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) {
+      return map();
+    }
+  }
   return true;
 }
 
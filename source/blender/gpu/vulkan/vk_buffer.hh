@@ -31,10 +31,18 @@ class VKBuffer {
 
   /** Has this buffer been allocated? */
   bool is_allocated() const;
+  /**
+   * \param allow_host_upload: Only used when not `is_host_visible`. When the allocation ends up
+   * in memory that is both device local and host visible (integrated GPUs, resizable BAR) the
+   * buffer is mapped anyway, so its initial data can be written directly instead of going through
+   * a staging buffer. Callers should still use a staging buffer for later updates, as those need
+   * to be ordered with the commands using the buffer.
+   */
   bool create(int64_t size,
               GPUUsageType usage,
               VkBufferUsageFlags buffer_usage,
-              bool is_host_visible = true);
+              bool is_host_visible = true,
+              bool allow_host_upload = false);
   void clear(VKContext &context, uint32_t clear_value);
   void update(const void *data) const;
   void flush() const;
@@ -21,7 +21,8 @@ void VKIndexBuffer::ensure_updated()
     return;
   }
 
-  if (!buffer_.is_allocated()) {
+  const bool is_new_buffer = !buffer_.is_allocated();
+  if (is_new_buffer) {
     allocate();
   }
 
@@ -29,10 +30,16 @@ void VKIndexBuffer::ensure_updated()
     return;
   }
 
-  VKContext &context = *VKContext::get();
-  VKStagingBuffer staging_buffer(buffer_, VKStagingBuffer::Direction::HostToDevice);
-  staging_buffer.host_buffer_get().update(data_);
-  staging_buffer.copy_to_device(context);
+  /* Device local buffers can only be written directly before any command uses them. */
+  if (is_new_buffer && buffer_.is_mapped()) {
+    buffer_.update(data_);
+  }
+  else {
+    VKContext &context = *VKContext::get();
+    VKStagingBuffer staging_buffer(buffer_, VKStagingBuffer::Direction::HostToDevice);
+    staging_buffer.host_buffer_get().update(data_);
+    staging_buffer.copy_to_device(context);
+  }
   MEM_SAFE_FREE(data_);
 }
 
@@ -93,7 +100,8 @@ void VKIndexBuffer::allocate()
                  usage,
                  VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT |
                      VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-                 false);
+                 false,
+                 usage == GPU_USAGE_STATIC);
   debug::object_label(buffer_.vk_handle(), "IndexBuffer");
 }
 
@@ -95,7 +95,9 @@ void VKVertexBuffer::read(void *data) const
   if (!use_render_graph) {
     context.flush();
   }
-  if (buffer_.is_mapped()) {
+  /* Static buffers can be mapped for their initial upload, but that memory isn't meant to be read
+   * by the host. */
+  if (buffer_.is_mapped() && usage_ != GPU_USAGE_STATIC) {
     buffer_.read(context, data);
     return;
   }
@@ -162,7 +164,8 @@ void VKVertexBuffer::upload_data_via_staging_buffer(VKContext &context)
 
 void VKVertexBuffer::upload_data()
 {
-  if (!buffer_.is_allocated()) {
+  const bool is_new_buffer = !buffer_.is_allocated();
+  if (is_new_buffer) {
     allocate();
   }
   if (!ELEM(usage_, GPU_USAGE_STATIC, GPU_USAGE_STREAM, GPU_USAGE_DYNAMIC)) {
@@ -171,7 +174,9 @@ void VKVertexBuffer::upload_data()
 
   if (flag & GPU_VERTBUF_DATA_DIRTY) {
     device_format_ensure();
-    if (buffer_.is_mapped()) {
+    /* Device local buffers can only be written directly before any command uses them. */
+    const bool is_host_visible = ELEM(usage_, GPU_USAGE_DYNAMIC, GPU_USAGE_STREAM);
+    if (buffer_.is_mapped() && (is_host_visible || is_new_buffer)) {
       upload_data_direct(buffer_);
     }
     else {
@@ -215,7 +220,9 @@ void VKVertexBuffer::allocate()
   if (!is_host_visible) {
     vk_buffer_usage |= VK_BUFFER_USAGE_TRANSFER_DST_BIT;
   }
-  buffer_.create(size_alloc_get(), usage_, vk_buffer_usage, is_host_visible);
+  const bool allow_host_upload = usage_ == GPU_USAGE_STATIC;
+  buffer_.create(
+      size_alloc_get(), usage_, vk_buffer_usage, is_host_visible, allow_host_upload);
   debug::object_label(buffer_.vk_handle(), "VertexBuffer");
 }
 
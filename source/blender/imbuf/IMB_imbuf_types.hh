@@ -100,6 +100,8 @@ enum eImBufFlags {
    * whole pixel data is overwritten after allocation, then this flag can be
    * faster since it avoids a memory clear. */
   IB_uninitialized_pixels = 1 << 10,
+  /** Decode movies on the GPU when supported, falling back to the CPU otherwise. */
+  IB_animhwdecode = 1 << 11,
 
   /** indicates whether image on disk have premul alpha */
   IB_alphamode_premul = 1 << 12,
@@ -13,6 +13,7 @@
 #include "IMB_imbuf_enums.h"
 
 #ifdef WITH_FFMPEG
+struct AVBufferRef;
 struct AVFormatContext;
 struct AVCodecContext;
 struct AVCodec;
@@ -47,8 +48,17 @@ struct ImBufAnim {
   AVFrame *pFrameRGB;
   AVFrame *pFrameDeinterlaced;
   SwsContext *img_convert_ctx;
+  /** Source pixel format of #img_convert_ctx (an `AVPixelFormat`). */
+  int img_convert_ctx_pix_fmt;
   int videoStream;
 
+  /** Hardware decoding device, null when decoding on the CPU, see #IB_animhwdecode. */
+  AVBufferRef *hw_device_ctx;
+  /** Pixel format of frames decoded on the GPU (an `AVPixelFormat`). */
+  int hw_pix_fmt;
+  /** Hardware decoded frame downloaded to system memory. */
+  AVFrame *pFrame_hw_download;
+
   AVFrame *pFrame;
   bool pFrame_complete;
   AVFrame *pFrame_backup;
@@ -43,7 +43,9 @@
 extern "C" {
 #  include <libavcodec/avcodec.h>
 #  include <libavformat/avformat.h>
+#  include <libavutil/hwcontext.h>
 #  include <libavutil/imgutils.h>
+#  include <libavutil/pixdesc.h>
 #  include <libavutil/rational.h>
 #  include <libswscale/swscale.h>
 
@@ -161,6 +163,138 @@ void IMB_suffix_anim(ImBufAnim *anim, const char *suffix)
 
 #ifdef WITH_FFMPEG
 
+/**
+ * Create the context converting decoded frames of \a src_format to RGBA, taking the YCbCr
+ * range and color-space of the stream into account.
+ */
+static SwsContext *ffmpeg_sws_context_create(ImBufAnim *anim, AVPixelFormat src_format)
+{
+  /* The following for color space determination */
+  int srcRange, dstRange, brightness, contrast, saturation;
+  int *table;
+  const int *inv_table;
+
+  SwsContext *sws_ctx = BKE_ffmpeg_sws_get_context(anim->x,
+                                                   anim->y,
+                                                   src_format,
+                                                   AV_PIX_FMT_RGBA,
+                                                   SWS_BILINEAR | SWS_PRINT_INFO |
+                                                       SWS_FULL_CHR_H_INT);
+  if (!sws_ctx) {
+    return nullptr;
+  }
+
+  /* Try do detect if input has 0-255 YCbCR range (JFIF, JPEG, Motion-JPEG). */
+  if (!sws_getColorspaceDetails(sws_ctx,
+                                (int **)&inv_table,
+                                &srcRange,
+                                &table,
+                                &dstRange,
+                                &brightness,
+                                &contrast,
+                                &saturation))
+  {
+    srcRange = srcRange || anim->pCodecCtx->color_range == AVCOL_RANGE_JPEG;
+    inv_table = sws_getCoefficients(anim->pCodecCtx->colorspace);
+
+    if (sws_setColorspaceDetails(sws_ctx,
+                                 (int *)inv_table,
+                                 srcRange,
+                                 table,
+                                 dstRange,
+                                 brightness,
+                                 contrast,
+                                 saturation))
+    {
+      fprintf(stderr, "Warning: Could not set libswscale colorspace details.\n");
+    }
+  }
+  else {
+    fprintf(stderr, "Warning: Could not set libswscale colorspace details.\n");
+  }
+
+  anim->img_convert_ctx_pix_fmt = src_format;
+  return sws_ctx;
+}
+
+/* Device types tried for hardware decoding, in order of preference. */
+static const AVHWDeviceType ffmpeg_hw_device_types[] = {
+#  if defined(__APPLE__)
+    AV_HWDEVICE_TYPE_VIDEOTOOLBOX,
+#  elif defined(_WIN32)
+    AV_HWDEVICE_TYPE_D3D11VA,
+    AV_HWDEVICE_TYPE_CUDA,
+#  else
+    AV_HWDEVICE_TYPE_CUDA,
+    AV_HWDEVICE_TYPE_VAAPI,
+#  endif
+};
+
+static AVPixelFormat ffmpeg_hw_get_format(AVCodecContext *codec_ctx,
+                                          const AVPixelFormat *pix_fmts)
+{
+  const ImBufAnim *anim = static_cast<const ImBufAnim *>(codec_ctx->opaque);
+
+  for (const AVPixelFormat *p = pix_fmts; *p != AV_PIX_FMT_NONE; p++) {
+    if (*p == anim->hw_pix_fmt) {
+      return *p;
+    }
+  }
+
+  /* The hardware can't decode this stream (e.g. unsupported profile or resolution), fall back to
+   * the first software format. */
+  for (const AVPixelFormat *p = pix_fmts; *p != AV_PIX_FMT_NONE; p++) {
+    if (!(av_pix_fmt_desc_get(*p)->flags & AV_PIX_FMT_FLAG_HWACCEL)) {
+      return *p;
+    }
+  }
+  return AV_PIX_FMT_NONE;
+}
+
+/**
+ * Set up the codec context to decode on the GPU, if the codec and platform support it.
+ * Decoded frames are downloaded to system memory in #ffmpeg_postprocess.
+ * Leaves the context unchanged for software decoding otherwise.
+ */
+static void ffmpeg_hw_decode_init(ImBufAnim *anim,
+                                  const AVCodec *codec,
+                                  AVCodecContext *codec_ctx)
+{
+  for (const AVHWDeviceType device_type : ffmpeg_hw_device_types) {
+    AVPixelFormat hw_pix_fmt = AV_PIX_FMT_NONE;
+    for (int i = 0;; i++) {
+      const AVCodecHWConfig *config = avcodec_get_hw_config(codec, i);
+      if (config == nullptr) {
+        break;
+      }
+      if ((config->methods & AV_CODEC_HW_CONFIG_METHOD_HW_DEVICE_CTX) &&
+          config->device_type == device_type)
+      {
+        hw_pix_fmt = config->pix_fmt;
+        break;
+      }
+    }
+
+    if (hw_pix_fmt == AV_PIX_FMT_NONE) {
+      continue;
+    }
+    if (av_hwdevice_ctx_create(&anim->hw_device_ctx, device_type, nullptr, nullptr, 0) < 0) {
+      continue;
+    }
+
+    anim->hw_pix_fmt = hw_pix_fmt;
+    codec_ctx->hw_device_ctx = av_buffer_ref(anim->hw_device_ctx);
+    codec_ctx->get_format = ffmpeg_hw_get_format;
+    codec_ctx->opaque = anim;
+
+    av_log(codec_ctx,
+           AV_LOG_INFO,
+           "Using %s hardware decoding\n",
+           av_hwdevice_get_type_name(device_type));
+    return;
+  }
+}
+
 static int startffmpeg(ImBufAnim *anim)
 {
   int i, video_stream_index;
@@ -174,15 +308,13 @@ static int startffmpeg(ImBufAnim *anim)
   double frs_den;
   int streamcount;
 
-  /* The following for color space determination */
-  int srcRange, dstRange, brightness, contrast, saturation;
-  int *table;
-  const int *inv_table;
-
   if (anim == nullptr) {
     return (-1);
   }
 
+  anim->hw_device_ctx = nullptr;
+  anim->hw_pix_fmt = AV_PIX_FMT_NONE;
+
   streamcount = anim->streamindex;
 
   if (avformat_open_input(&pFormatCtx, anim->filepath, nullptr, nullptr) != 0) {
@@ -242,12 +374,20 @@ static int startffmpeg(ImBufAnim *anim)
     pCodecCtx->thread_type = FF_THREAD_SLICE;
   }
 
+  /* De-interlacing works on the decoded planes directly, keep it on the CPU. */
+  if ((anim->ib_flags & IB_animhwdecode) && !(anim->ib_flags & IB_animdeinterlace)) {
+    ffmpeg_hw_decode_init(anim, pCodec, pCodecCtx);
+  }
+
   if (avcodec_open2(pCodecCtx, pCodec, nullptr) < 0) {
+    avcodec_free_context(&pCodecCtx);
+    av_buffer_unref(&anim->hw_device_ctx);
     avformat_close_input(&pFormatCtx);
     return -1;
   }
   if (pCodecCtx->pix_fmt == AV_PIX_FMT_NONE) {
     avcodec_free_context(&anim->pCodecCtx);
+    av_buffer_unref(&anim->hw_device_ctx);
     avformat_close_input(&pFormatCtx);
     return -1;
   }
@@ -377,6 +517,7 @@ static int startffmpeg(ImBufAnim *anim)
     av_frame_free(&anim->pFrameDeinterlaced);
     av_frame_free(&anim->pFrame);
     av_frame_free(&anim->pFrame_backup);
+    av_buffer_unref(&anim->hw_device_ctx);
     anim->pCodecCtx = nullptr;
     return -1;
   }
@@ -390,6 +531,7 @@ static int startffmpeg(ImBufAnim *anim)
     av_frame_free(&anim->pFrameDeinterlaced);
     av_frame_free(&anim->pFrame);
     av_frame_free(&anim->pFrame_backup);
+    av_buffer_unref(&anim->hw_device_ctx);
     anim->pCodecCtx = nullptr;
     return -1;
   }
@@ -408,12 +550,8 @@ static int startffmpeg(ImBufAnim *anim)
         1);
   }
 
-  anim->img_convert_ctx = BKE_ffmpeg_sws_get_context(anim->x,
-                                                     anim->y,
-                                                     anim->pCodecCtx->pix_fmt,
-                                                     AV_PIX_FMT_RGBA,
-                                                     SWS_BILINEAR | SWS_PRINT_INFO |
-                                                         SWS_FULL_CHR_H_INT);
+  anim->pFrame_hw_download = av_frame_alloc();
+  anim->img_convert_ctx = ffmpeg_sws_context_create(anim, anim->pCodecCtx->pix_fmt);
 
   if (!anim->img_convert_ctx) {
     fprintf(stderr, "Can't transform color space??? Bailing out...\n");
@@ -424,39 +562,12 @@ static int startffmpeg(ImBufAnim *anim)
     av_frame_free(&anim->pFrameDeinterlaced);
     av_frame_free(&anim->pFrame);
     av_frame_free(&anim->pFrame_backup);
+    av_frame_free(&anim->pFrame_hw_download);
+    av_buffer_unref(&anim->hw_device_ctx);
     anim->pCodecCtx = nullptr;
     return -1;
   }
 
-  /* Try do detect if input has 0-255 YCbCR range (JFIF, JPEG, Motion-JPEG). */
-  if (!sws_getColorspaceDetails(anim->img_convert_ctx,
-                                (int **)&inv_table,
-                                &srcRange,
-                                &table,
-                                &dstRange,
-                                &brightness,
-                                &contrast,
-                                &saturation))
-  {
-    srcRange = srcRange || anim->pCodecCtx->color_range == AVCOL_RANGE_JPEG;
-    inv_table = sws_getCoefficients(anim->pCodecCtx->colorspace);
-
-    if (sws_setColorspaceDetails(anim->img_convert_ctx,
-                                 (int *)inv_table,
-                                 srcRange,
-                                 table,
-                                 dstRange,
-                                 brightness,
-                                 contrast,
-                                 saturation))
-    {
-      fprintf(stderr, "Warning: Could not set libswscale colorspace details.\n");
-    }
-  }
-  else {
-    fprintf(stderr, "Warning: Could not set libswscale colorspace details.\n");
-  }
-
   return 0;
 }
 
@@ -542,6 +653,31 @@ static void ffmpeg_postprocess(ImBufAnim *anim, AVFrame *input, ImBuf *ibuf)
          input->data[2],
          input->data[3]);
 
+  /* Frames decoded on the GPU are downloaded first. Their software format is only known after
+   * decoding (typically NV12 or P010), and the decoder may fall back to software decoding for
+   * some frames, so the conversion context is recreated when the format changes. */
+  if (anim->hw_device_ctx) {
+    if (input->format == anim->hw_pix_fmt) {
+      av_frame_unref(anim->pFrame_hw_download);
+      if (av_hwframe_transfer_data(anim->pFrame_hw_download, input, 0) < 0) {
+        av_log(anim->pFormatCtx, AV_LOG_ERROR, "Could not download hardware decoded frame\n");
+        return;
+      }
+      input = anim->pFrame_hw_download;
+    }
+
+    if (input->format != anim->img_convert_ctx_pix_fmt) {
+      if (anim->img_convert_ctx) {
+        BKE_ffmpeg_sws_release_context(anim->img_convert_ctx);
+      }
+      anim->img_convert_ctx = ffmpeg_sws_context_create(anim, AVPixelFormat(input->format));
+      if (!anim->img_convert_ctx) {
+        av_log(anim->pFormatCtx, AV_LOG_ERROR, "Can't convert hardware decoded frame\n");
+        return;
+      }
+    }
+  }
+
   if (anim->ib_flags & IB_animdeinterlace) {
     if (av_image_deinterlace(anim->pFrameDeinterlaced,
                              anim->pFrame,
@@ -1183,7 +1319,11 @@ static void free_anim_ffmpeg(ImBufAnim *anim)
     av_frame_free(&anim->pFrame_backup);
     av_frame_free(&anim->pFrameRGB);
     av_frame_free(&anim->pFrameDeinterlaced);
-    BKE_ffmpeg_sws_release_context(anim->img_convert_ctx);
+    av_frame_free(&anim->pFrame_hw_download);
+    av_buffer_unref(&anim->hw_device_ctx);
+    if (anim->img_convert_ctx) {
+      BKE_ffmpeg_sws_release_context(anim->img_convert_ctx);
+    }
   }
   anim->duration_in_frames = 0;
 }
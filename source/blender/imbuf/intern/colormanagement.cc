@@ -11,6 +11,7 @@
 
 #include <cmath>
 #include <cstring>
+#include <string>
 
 #include "DNA_color_types.h"
 #include "DNA_image_types.h"
@@ -29,6 +30,8 @@
 #include "MEM_guardedalloc.h"
 
 #include "BLI_blenlib.h"
+#include "BLI_hash.hh"
+#include "BLI_map.hh"
 #include "BLI_math_color.h"
 #include "BLI_rect.h"
 #include "BLI_string.h"
@@ -97,8 +100,42 @@ struct ColormanageProcessor {
   OCIO_ConstCPUProcessorRcPtr *cpu_processor;
   CurveMapping *curve_mapping;
   bool is_data_result;
+  /* The CPU processor is owned by the display processor cache and is not to be released. */
+  bool is_cpu_processor_cached;
 };
 
+/* Display processors are created for every display buffer update, thumbnail and image save, while
+ * only a few distinct view settings are used at a time. So they are cached by their settings and
+ * kept until the configuration is freed. The number of cached processors is limited, since
+ * continuously changing settings like exposure produce a new processor for every value. */
+struct DisplayProcessorKey {
+  std::string look;
+  std::string view_transform;
+  std::string display;
+  std::string from_colorspace;
+  float exposure;
+  float gamma;
+
+  uint64_t hash() const
+  {
+    return blender::get_default_hash(
+        blender::get_default_hash(look, view_transform, display, from_colorspace),
+        exposure,
+        gamma);
+  }
+
+  friend bool operator==(const DisplayProcessorKey &a, const DisplayProcessorKey &b)
+  {
+    return a.look == b.look && a.view_transform == b.view_transform && a.display == b.display &&
+           a.from_colorspace == b.from_colorspace && a.exposure == b.exposure &&
+           a.gamma == b.gamma;
+  }
+};
+
+static constexpr int DISPLAY_PROCESSOR_CACHE_MAX_SIZE = 64;
+/* Protected by processor_lock. */
+static blender::Map<DisplayProcessorKey, OCIO_ConstCPUProcessorRcPtr *> global_display_processors;
+
 static struct global_gpu_state {
   /* GPU shader currently bound. */
   bool gpu_shader_bound;
@@ -622,6 +659,12 @@ static void colormanage_free_config()
   BLI_listbase_clear(&global_colorspaces);
   global_tot_colorspace = 0;
 
+  /* Free cached display processors. */
+  for (OCIO_ConstCPUProcessorRcPtr *cpu_processor : global_display_processors.values()) {
+    OCIO_cpuProcessorRelease(cpu_processor);
+  }
+  global_display_processors.clear_and_shrink();
+
   /* free displays */
   display = static_cast<ColorManagedDisplay *>(global_displays.first);
   while (display) {
@@ -904,6 +947,36 @@ static OCIO_ConstCPUProcessorRcPtr *create_display_buffer_processor(const char *
   return cpu_processor;
 }
 
+/* Same as create_display_buffer_processor, but returns a cached processor if one exists for the
+ * given settings. r_is_cached is set to true if the returned processor is owned by the cache. */
+static OCIO_ConstCPUProcessorRcPtr *get_display_buffer_processor(const char *look,
+                                                                 const char *view_transform,
+                                                                 const char *display,
+                                                                 float exposure,
+                                                                 float gamma,
+                                                                 const char *from_colorspace,
+                                                                 bool *r_is_cached)
+{
+  DisplayProcessorKey key{look, view_transform, display, from_colorspace, exposure, gamma};
+
+  BLI_mutex_lock(&processor_lock);
+
+  OCIO_ConstCPUProcessorRcPtr *cpu_processor = global_display_processors.lookup_default(key,
+                                                                                        nullptr);
+  *r_is_cached = cpu_processor != nullptr;
+  if (cpu_processor == nullptr) {
+    cpu_processor = create_display_buffer_processor(
+        look, view_transform, display, exposure, gamma, from_colorspace);
+    if (cpu_processor && global_display_processors.size() < DISPLAY_PROCESSOR_CACHE_MAX_SIZE) {
+      global_display_processors.add_new(std::move(key), cpu_processor);
+      *r_is_cached = true;
+    }
+  }
+
+  BLI_mutex_unlock(&processor_lock);
+  return cpu_processor;
+}
+
 static OCIO_ConstProcessorRcPtr *create_colorspace_transform_processor(const char *from_colorspace,
                                                                        const char *to_colorspace)
 {
@@ -3934,13 +4007,14 @@ ColormanageProcessor *IMB_colormanagement_display_processor_new(
     cm_processor->is_data_result = display_space->is_data;
   }
 
-  cm_processor->cpu_processor = create_display_buffer_processor(
+  cm_processor->cpu_processor = get_display_buffer_processor(
       applied_view_settings->look,
       applied_view_settings->view_transform,
       display_settings->display_device,
       applied_view_settings->exposure,
       applied_view_settings->gamma,
-      global_role_scene_linear);
+      global_role_scene_linear,
+      &cm_processor->is_cpu_processor_cached);
 
   if (applied_view_settings->flag & COLORMANAGE_VIEW_USE_CURVES) {
     cm_processor->curve_mapping = BKE_curvemapping_copy(applied_view_settings->curve_mapping);
@@ -4117,7 +4191,7 @@ void IMB_colormanagement_processor_free(ColormanageProcessor *cm_processor)
   if (cm_processor->curve_mapping) {
     BKE_curvemapping_free(cm_processor->curve_mapping);
   }
-  if (cm_processor->cpu_processor) {
+  if (cm_processor->cpu_processor && !cm_processor->is_cpu_processor_cached) {
     OCIO_cpuProcessorRelease(cm_processor->cpu_processor);
   }
 
@@ -1271,6 +1271,20 @@ void IMB_exr_read_channels(void *handle)
       "internal_name");
 
   for (int i = 0; i < numparts; i++) {
+    /* Skip parts that have no channel to read into, reading them would still decode all of their
+     * pixels even with an empty frame-buffer. */
+    bool has_requested_channel = false;
+    LISTBASE_FOREACH (ExrChannel *, echan, &data->channels) {
+      if (echan->m->part_number == i && echan->rect) {
+        has_requested_channel = true;
+        break;
+      }
+    }
+    if (!has_requested_channel) {
+      exr_printf("readPixels:readPixels[%d]: skipped, no requested channels\n", i);
+      continue;
+    }
+
     /* Read part header. */
     InputPart in(*data->ifile, i);
     Header header = in.header();
@@ -8,6 +8,7 @@
 
 #include <cmath>
 
+#include "BLI_task.hh"
 #include "BLI_utildefines.h"
 #include "MEM_guardedalloc.h"
 
@@ -18,6 +19,8 @@
 
 #include "BLI_sys_types.h" /* for intptr_t support */
 
+using blender::IndexRange;
+
 static void imb_half_x_no_alloc(ImBuf *ibuf2, ImBuf *ibuf1)
 {
   uchar *p1, *_p1, *dest;
@@ -752,17 +755,9 @@ static ImBuf *scaledownx(ImBuf *ibuf, int newx)
 {
   const bool do_rect = (ibuf->byte_buffer.data != nullptr);
   const bool do_float = (ibuf->float_buffer.data != nullptr);
-  const size_t rect_size = IMB_get_rect_len(ibuf) * 4;
-
-  uchar *rect, *_newrect, *newrect;
-  float *rectf, *_newrectf, *newrectf;
-  float sample, add, val[4], nval[4], valf[4], nvalf[4];
-  int x, y;
 
-  rectf = _newrectf = newrectf = nullptr;
-  rect = _newrect = newrect = nullptr;
-  nval[0] = nval[1] = nval[2] = nval[3] = 0.0f;
-  nvalf[0] = nvalf[1] = nvalf[2] = nvalf[3] = 0.0f;
+  uchar *_newrect = nullptr;
+  float *_newrectf = nullptr;
 
   if (!do_rect && !do_float) {
     return ibuf;
@@ -785,108 +780,113 @@ static ImBuf *scaledownx(ImBuf *ibuf, int newx)
     }
   }
 
-  add = (ibuf->x - 0.01) / newx;
-
-  if (do_rect) {
-    rect = ibuf->byte_buffer.data;
-    newrect = _newrect;
-  }
-  if (do_float) {
-    rectf = ibuf->float_buffer.data;
-    newrectf = _newrectf;
-  }
+  const float add = (ibuf->x - 0.01) / newx;
 
-  for (y = ibuf->y; y > 0; y--) {
-    sample = 0.0f;
-    val[0] = val[1] = val[2] = val[3] = 0.0f;
-    valf[0] = valf[1] = valf[2] = valf[3] = 0.0f;
-
-    for (x = newx; x > 0; x--) {
+  /* Rows are independent, so they are scaled in parallel. */
+  blender::threading::parallel_for(IndexRange(ibuf->y), 16, [&](const IndexRange rows) {
+    for (const int64_t y : rows) {
+      const uchar *rect = nullptr;
+      uchar *newrect = nullptr;
+      const float *rectf = nullptr;
+      float *newrectf = nullptr;
       if (do_rect) {
-        nval[0] = -val[0] * sample;
-        nval[1] = -val[1] * sample;
-        nval[2] = -val[2] * sample;
-        nval[3] = -val[3] * sample;
+        rect = ibuf->byte_buffer.data + y * ibuf->x * 4;
+        newrect = _newrect + y * newx * 4;
       }
       if (do_float) {
-        nvalf[0] = -valf[0] * sample;
-        nvalf[1] = -valf[1] * sample;
-        nvalf[2] = -valf[2] * sample;
-        nvalf[3] = -valf[3] * sample;
+        rectf = ibuf->float_buffer.data + y * ibuf->x * 4;
+        newrectf = _newrectf + y * newx * 4;
       }
 
-      sample += add;
-
-      while (sample >= 1.0f) {
-        sample -= 1.0f;
+      float sample = 0.0f;
+      float val[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+      float valf[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+      float nval[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+      float nvalf[4] = {0.0f, 0.0f, 0.0f, 0.0f};
 
+      for (int x = newx; x > 0; x--) {
         if (do_rect) {
-          nval[0] += rect[0];
-          nval[1] += rect[1];
-          nval[2] += rect[2];
-          nval[3] += rect[3];
-          rect += 4;
+          nval[0] = -val[0] * sample;
+          nval[1] = -val[1] * sample;
+          nval[2] = -val[2] * sample;
+          nval[3] = -val[3] * sample;
         }
         if (do_float) {
-          nvalf[0] += rectf[0];
-          nvalf[1] += rectf[1];
-          nvalf[2] += rectf[2];
-          nvalf[3] += rectf[3];
-          rectf += 4;
+          nvalf[0] = -valf[0] * sample;
+          nvalf[1] = -valf[1] * sample;
+          nvalf[2] = -valf[2] * sample;
+          nvalf[3] = -valf[3] * sample;
         }
-      }
 
-      if (do_rect) {
-        val[0] = rect[0];
-        val[1] = rect[1];
-        val[2] = rect[2];
-        val[3] = rect[3];
-        rect += 4;
+        sample += add;
 
-        newrect[0] = roundf((nval[0] + sample * val[0]) / add);
-        newrect[1] = roundf((nval[1] + sample * val[1]) / add);
-        newrect[2] = roundf((nval[2] + sample * val[2]) / add);
-        newrect[3] = roundf((nval[3] + sample * val[3]) / add);
+        while (sample >= 1.0f) {
+          sample -= 1.0f;
 
-        newrect += 4;
-      }
-      if (do_float) {
+          if (do_rect) {
+            nval[0] += rect[0];
+            nval[1] += rect[1];
+            nval[2] += rect[2];
+            nval[3] += rect[3];
+            rect += 4;
+          }
+          if (do_float) {
+            nvalf[0] += rectf[0];
+            nvalf[1] += rectf[1];
+            nvalf[2] += rectf[2];
+            nvalf[3] += rectf[3];
+            rectf += 4;
+          }
+        }
 
-        valf[0] = rectf[0];
-        valf[1] = rectf[1];
-        valf[2] = rectf[2];
-        valf[3] = rectf[3];
-        rectf += 4;
+        if (do_rect) {
+          val[0] = rect[0];
+          val[1] = rect[1];
+          val[2] = rect[2];
+          val[3] = rect[3];
+          rect += 4;
 
-        newrectf[0] = ((nvalf[0] + sample * valf[0]) / add);
-        newrectf[1] = ((nvalf[1] + sample * valf[1]) / add);
-        newrectf[2] = ((nvalf[2] + sample * valf[2]) / add);
-        newrectf[3] = ((nvalf[3] + sample * valf[3]) / add);
+          newrect[0] = roundf((nval[0] + sample * val[0]) / add);
+          newrect[1] = roundf((nval[1] + sample * val[1]) / add);
+          newrect[2] = roundf((nval[2] + sample * val[2]) / add);
+          newrect[3] = roundf((nval[3] + sample * val[3]) / add);
 
-        newrectf += 4;
+          newrect += 4;
+        }
+        if (do_float) {
+
+          valf[0] = rectf[0];
+          valf[1] = rectf[1];
+          valf[2] = rectf[2];
+          valf[3] = rectf[3];
+          rectf += 4;
+
+          newrectf[0] = ((nvalf[0] + sample * valf[0]) / add);
+          newrectf[1] = ((nvalf[1] + sample * valf[1]) / add);
+          newrectf[2] = ((nvalf[2] + sample * valf[2]) / add);
+          newrectf[3] = ((nvalf[3] + sample * valf[3]) / add);
+
+          newrectf += 4;
+        }
+
+        sample -= 1.0f;
       }
 
-      sample -= 1.0f;
+      /* See bug #26502. */
+      BLI_assert(!do_rect || rect == ibuf->byte_buffer.data + (y + 1) * ibuf->x * 4);
+      BLI_assert(!do_float || rectf == ibuf->float_buffer.data + (y + 1) * ibuf->x * 4);
     }
-  }
+  });
 
   if (do_rect) {
-    // printf("%ld %ld\n", (uchar *)rect - ibuf->byte_buffer.data, rect_size);
-    BLI_assert((uchar *)rect - ibuf->byte_buffer.data == rect_size); /* see bug #26502. */
-
     imb_freerectImBuf(ibuf);
     IMB_assign_byte_buffer(ibuf, _newrect, IB_TAKE_OWNERSHIP);
   }
   if (do_float) {
-    // printf("%ld %ld\n", rectf - ibuf->float_buffer.data, rect_size);
-    BLI_assert((rectf - ibuf->float_buffer.data) == rect_size); /* see bug #26502. */
-
     imb_freerectfloatImBuf(ibuf);
     IMB_assign_float_buffer(ibuf, _newrectf, IB_TAKE_OWNERSHIP);
   }
 
-  (void)rect_size; /* UNUSED in release builds */
-
   ibuf->x = newx;
   return ibuf;
 }
@@ -895,17 +895,9 @@ static ImBuf *scaledowny(ImBuf *ibuf, int newy)
 {
   const bool do_rect = (ibuf->byte_buffer.data != nullptr);
   const bool do_float = (ibuf->float_buffer.data != nullptr);
-  const size_t rect_size = IMB_get_rect_len(ibuf) * 4;
-
-  uchar *rect, *_newrect, *newrect;
-  float *rectf, *_newrectf, *newrectf;
-  float sample, add, val[4], nval[4], valf[4], nvalf[4];
-  int x, y, skipx;
 
-  rectf = _newrectf = newrectf = nullptr;
-  rect = _newrect = newrect = nullptr;
-  nval[0] = nval[1] = nval[2] = nval[3] = 0.0f;
-  nvalf[0] = nvalf[1] = nvalf[2] = nvalf[3] = 0.0f;
+  uchar *_newrect = nullptr;
+  float *_newrectf = nullptr;
 
   if (!do_rect && !do_float) {
     return ibuf;
@@ -928,118 +920,123 @@ static ImBuf *scaledowny(ImBuf *ibuf, int newy)
     }
   }
 
-  add = (ibuf->y - 0.01) / newy;
-  skipx = 4 * ibuf->x;
+  const float add = (ibuf->y - 0.01) / newy;
+  const int skipx = 4 * ibuf->x;
 
-  for (x = skipx - 4; x >= 0; x -= 4) {
-    if (do_rect) {
-      rect = ibuf->byte_buffer.data + x;
-      newrect = _newrect + x;
-    }
-    if (do_float) {
-      rectf = ibuf->float_buffer.data + x;
-      newrectf = _newrectf + x;
-    }
-
-    sample = 0.0f;
-    val[0] = val[1] = val[2] = val[3] = 0.0f;
-    valf[0] = valf[1] = valf[2] = valf[3] = 0.0f;
-
-    for (y = newy; y > 0; y--) {
+  /* Columns are independent, so they are scaled in parallel. */
+  blender::threading::parallel_for(IndexRange(ibuf->x), 64, [&](const IndexRange columns) {
+    for (const int64_t column : columns) {
+      const int64_t x = column * 4;
+      const uchar *rect = nullptr;
+      uchar *newrect = nullptr;
+      const float *rectf = nullptr;
+      float *newrectf = nullptr;
       if (do_rect) {
-        nval[0] = -val[0] * sample;
-        nval[1] = -val[1] * sample;
-        nval[2] = -val[2] * sample;
-        nval[3] = -val[3] * sample;
+        rect = ibuf->byte_buffer.data + x;
+        newrect = _newrect + x;
       }
       if (do_float) {
-        nvalf[0] = -valf[0] * sample;
-        nvalf[1] = -valf[1] * sample;
-        nvalf[2] = -valf[2] * sample;
-        nvalf[3] = -valf[3] * sample;
+        rectf = ibuf->float_buffer.data + x;
+        newrectf = _newrectf + x;
       }
 
-      sample += add;
-
-      while (sample >= 1.0f) {
-        sample -= 1.0f;
+      float sample = 0.0f;
+      float val[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+      float valf[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+      float nval[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+      float nvalf[4] = {0.0f, 0.0f, 0.0f, 0.0f};
 
+      for (int y = newy; y > 0; y--) {
         if (do_rect) {
-          nval[0] += rect[0];
-          nval[1] += rect[1];
-          nval[2] += rect[2];
-          nval[3] += rect[3];
-          rect += skipx;
+          nval[0] = -val[0] * sample;
+          nval[1] = -val[1] * sample;
+          nval[2] = -val[2] * sample;
+          nval[3] = -val[3] * sample;
         }
         if (do_float) {
-          nvalf[0] += rectf[0];
-          nvalf[1] += rectf[1];
-          nvalf[2] += rectf[2];
-          nvalf[3] += rectf[3];
-          rectf += skipx;
+          nvalf[0] = -valf[0] * sample;
+          nvalf[1] = -valf[1] * sample;
+          nvalf[2] = -valf[2] * sample;
+          nvalf[3] = -valf[3] * sample;
         }
-      }
 
-      if (do_rect) {
-        val[0] = rect[0];
-        val[1] = rect[1];
-        val[2] = rect[2];
-        val[3] = rect[3];
-        rect += skipx;
+        sample += add;
 
-        newrect[0] = roundf((nval[0] + sample * val[0]) / add);
-        newrect[1] = roundf((nval[1] + sample * val[1]) / add);
-        newrect[2] = roundf((nval[2] + sample * val[2]) / add);
-        newrect[3] = roundf((nval[3] + sample * val[3]) / add);
+        while (sample >= 1.0f) {
+          sample -= 1.0f;
 
-        newrect += skipx;
-      }
-      if (do_float) {
+          if (do_rect) {
+            nval[0] += rect[0];
+            nval[1] += rect[1];
+            nval[2] += rect[2];
+            nval[3] += rect[3];
+            rect += skipx;
+          }
+          if (do_float) {
+            nvalf[0] += rectf[0];
+            nvalf[1] += rectf[1];
+            nvalf[2] += rectf[2];
+            nvalf[3] += rectf[3];
+            rectf += skipx;
+          }
+        }
 
-        valf[0] = rectf[0];
-        valf[1] = rectf[1];
-        valf[2] = rectf[2];
-        valf[3] = rectf[3];
-        rectf += skipx;
+        if (do_rect) {
+          val[0] = rect[0];
+          val[1] = rect[1];
+          val[2] = rect[2];
+          val[3] = rect[3];
+          rect += skipx;
 
-        newrectf[0] = ((nvalf[0] + sample * valf[0]) / add);
-        newrectf[1] = ((nvalf[1] + sample * valf[1]) / add);
-        newrectf[2] = ((nvalf[2] + sample * valf[2]) / add);
-        newrectf[3] = ((nvalf[3] + sample * valf[3]) / add);
+          newrect[0] = roundf((nval[0] + sample * val[0]) / add);
+          newrect[1] = roundf((nval[1] + sample * val[1]) / add);
+          newrect[2] = roundf((nval[2] + sample * val[2]) / add);
+          newrect[3] = roundf((nval[3] + sample * val[3]) / add);
 
-        newrectf += skipx;
+          newrect += skipx;
+        }
+        if (do_float) {
+
+          valf[0] = rectf[0];
+          valf[1] = rectf[1];
+          valf[2] = rectf[2];
+          valf[3] = rectf[3];
+          rectf += skipx;
+
+          newrectf[0] = ((nvalf[0] + sample * valf[0]) / add);
+          newrectf[1] = ((nvalf[1] + sample * valf[1]) / add);
+          newrectf[2] = ((nvalf[2] + sample * valf[2]) / add);
+          newrectf[3] = ((nvalf[3] + sample * valf[3]) / add);
+
+          newrectf += skipx;
+        }
+
+        sample -= 1.0f;
       }
 
-      sample -= 1.0f;
+      /* See bug #26502. */
+      BLI_assert(!do_rect || rect == ibuf->byte_buffer.data + x + int64_t(ibuf->y) * skipx);
+      BLI_assert(!do_float || rectf == ibuf->float_buffer.data + x + int64_t(ibuf->y) * skipx);
     }
-  }
+  });
 
   if (do_rect) {
-    // printf("%ld %ld\n", (uchar *)rect - byte_buffer.data, rect_size);
-    BLI_assert((uchar *)rect - ibuf->byte_buffer.data == rect_size); /* see bug #26502. */
-
     imb_freerectImBuf(ibuf);
     IMB_assign_byte_buffer(ibuf, _newrect, IB_TAKE_OWNERSHIP);
   }
   if (do_float) {
-    // printf("%ld %ld\n", rectf - ibuf->float_buffer.data, rect_size);
-    BLI_assert((rectf - ibuf->float_buffer.data) == rect_size); /* see bug #26502. */
-
     imb_freerectfloatImBuf(ibuf);
     IMB_assign_float_buffer(ibuf, _newrectf, IB_TAKE_OWNERSHIP);
   }
 
-  (void)rect_size; /* UNUSED in release builds */
-
   ibuf->y = newy;
   return ibuf;
 }
 
 static ImBuf *scaleupx(ImBuf *ibuf, int newx)
 {
-  uchar *rect, *_newrect = nullptr, *newrect;
-  float *rectf, *_newrectf = nullptr, *newrectf;
-  int x, y;
+  uchar *_newrect = nullptr;
+  float *_newrectf = nullptr;
   bool do_rect = false, do_float = false;
 
   if (ibuf == nullptr) {
@@ -1067,17 +1064,16 @@ static ImBuf *scaleupx(ImBuf *ibuf, int newx)
     }
   }
 
-  rect = ibuf->byte_buffer.data;
-  rectf = ibuf->float_buffer.data;
-  newrect = _newrect;
-  newrectf = _newrectf;
-
   /* Special case, copy all columns, needed since the scaling logic assumes there is at least
    * two rows to interpolate between causing out of bounds read for 1px images, see #70356. */
   if (UNLIKELY(ibuf->x == 1)) {
+    const uchar *rect = ibuf->byte_buffer.data;
+    const float *rectf = ibuf->float_buffer.data;
+    uchar *newrect = _newrect;
+    float *newrectf = _newrectf;
     if (do_rect) {
-      for (y = ibuf->y; y > 0; y--) {
-        for (x = newx; x > 0; x--) {
+      for (int y = ibuf->y; y > 0; y--) {
+        for (int x = newx; x > 0; x--) {
           memcpy(newrect, rect, sizeof(char[4]));
           newrect += 4;
         }
@@ -1085,8 +1081,8 @@ static ImBuf *scaleupx(ImBuf *ibuf, int newx)
       }
     }
     if (do_float) {
-      for (y = ibuf->y; y > 0; y--) {
-        for (x = newx; x > 0; x--) {
+      for (int y = ibuf->y; y > 0; y--) {
+        for (int x = newx; x > 0; x--) {
           memcpy(newrectf, rectf, sizeof(float[4]));
           newrectf += 4;
         }
@@ -1096,130 +1092,144 @@ static ImBuf *scaleupx(ImBuf *ibuf, int newx)
   }
   else {
     const float add = (ibuf->x - 1.001) / (newx - 1.0);
-    float sample;
-
-    float val_a, nval_a, diff_a;
-    float val_b, nval_b, diff_b;
-    float val_g, nval_g, diff_g;
-    float val_r, nval_r, diff_r;
-    float val_af, nval_af, diff_af;
-    float val_bf, nval_bf, diff_bf;
-    float val_gf, nval_gf, diff_gf;
-    float val_rf, nval_rf, diff_rf;
 
-    val_a = nval_a = diff_a = val_b = nval_b = diff_b = 0;
-    val_g = nval_g = diff_g = val_r = nval_r = diff_r = 0;
-    val_af = nval_af = diff_af = val_bf = nval_bf = diff_bf = 0;
-    val_gf = nval_gf = diff_gf = val_rf = nval_rf = diff_rf = 0;
+    /* Rows are independent, so they are scaled in parallel. */
+    blender::threading::parallel_for(IndexRange(ibuf->y), 16, [&](const IndexRange rows) {
+      for (const int64_t y : rows) {
+        const uchar *rect = nullptr;
+        uchar *newrect = nullptr;
+        const float *rectf = nullptr;
+        float *newrectf = nullptr;
+        if (do_rect) {
+          rect = ibuf->byte_buffer.data + y * ibuf->x * 4;
+          newrect = _newrect + y * newx * 4;
+        }
+        if (do_float) {
+          rectf = ibuf->float_buffer.data + y * ibuf->x * 4;
+          newrectf = _newrectf + y * newx * 4;
+        }
 
-    for (y = ibuf->y; y > 0; y--) {
+        float sample = 0;
 
-      sample = 0;
+        float val_a, nval_a, diff_a;
+        float val_b, nval_b, diff_b;
+        float val_g, nval_g, diff_g;
+        float val_r, nval_r, diff_r;
+        float val_af, nval_af, diff_af;
+        float val_bf, nval_bf, diff_bf;
+        float val_gf, nval_gf, diff_gf;
+        float val_rf, nval_rf, diff_rf;
 
-      if (do_rect) {
-        val_a = rect[0];
-        nval_a = rect[4];
-        diff_a = nval_a - val_a;
-        val_a += 0.5f;
-
-        val_b = rect[1];
-        nval_b = rect[5];
-        diff_b = nval_b - val_b;
-        val_b += 0.5f;
-
-        val_g = rect[2];
-        nval_g = rect[6];
-        diff_g = nval_g - val_g;
-        val_g += 0.5f;
-
-        val_r = rect[3];
-        nval_r = rect[7];
-        diff_r = nval_r - val_r;
-        val_r += 0.5f;
-
-        rect += 8;
-      }
-      if (do_float) {
-        val_af = rectf[0];
-        nval_af = rectf[4];
-        diff_af = nval_af - val_af;
+        val_a = nval_a = diff_a = val_b = nval_b = diff_b = 0;
+        val_g = nval_g = diff_g = val_r = nval_r = diff_r = 0;
+        val_af = nval_af = diff_af = val_bf = nval_bf = diff_bf = 0;
+        val_gf = nval_gf = diff_gf = val_rf = nval_rf = diff_rf = 0;
 
-        val_bf = rectf[1];
-        nval_bf = rectf[5];
-        diff_bf = nval_bf - val_bf;
+        if (do_rect) {
+          val_a = rect[0];
+          nval_a = rect[4];
+          diff_a = nval_a - val_a;
+          val_a += 0.5f;
+
+          val_b = rect[1];
+          nval_b = rect[5];
+          diff_b = nval_b - val_b;
+          val_b += 0.5f;
+
+          val_g = rect[2];
+          nval_g = rect[6];
+          diff_g = nval_g - val_g;
+          val_g += 0.5f;
+
+          val_r = rect[3];
+          nval_r = rect[7];
+          diff_r = nval_r - val_r;
+          val_r += 0.5f;
+
+          rect += 8;
+        }
+        if (do_float) {
+          val_af = rectf[0];
+          nval_af = rectf[4];
+          diff_af = nval_af - val_af;
 
-        val_gf = rectf[2];
-        nval_gf = rectf[6];
-        diff_gf = nval_gf - val_gf;
+          val_bf = rectf[1];
+          nval_bf = rectf[5];
+          diff_bf = nval_bf - val_bf;
 
-        val_rf = rectf[3];
-        nval_rf = rectf[7];
-        diff_rf = nval_rf - val_rf;
+          val_gf = rectf[2];
+          nval_gf = rectf[6];
+          diff_gf = nval_gf - val_gf;
 
-        rectf += 8;
-      }
-      for (x = newx; x > 0; x--) {
-        if (sample >= 1.0f) {
-          sample -= 1.0f;
+          val_rf = rectf[3];
+          nval_rf = rectf[7];
+          diff_rf = nval_rf - val_rf;
 
+          rectf += 8;
+        }
+        for (int x = newx; x > 0; x--) {
+          if (sample >= 1.0f) {
+            sample -= 1.0f;
+
+            if (do_rect) {
+              val_a = nval_a;
+              nval_a = rect[0];
+              diff_a = nval_a - val_a;
+              val_a += 0.5f;
+
+              val_b = nval_b;
+              nval_b = rect[1];
+              diff_b = nval_b - val_b;
+              val_b += 0.5f;
+
+              val_g = nval_g;
+              nval_g = rect[2];
+              diff_g = nval_g - val_g;
+              val_g += 0.5f;
+
+              val_r = nval_r;
+              nval_r = rect[3];
+              diff_r = nval_r - val_r;
+              val_r += 0.5f;
+              rect += 4;
+            }
+            if (do_float) {
+              val_af = nval_af;
+              nval_af = rectf[0];
+              diff_af = nval_af - val_af;
+
+              val_bf = nval_bf;
+              nval_bf = rectf[1];
+              diff_bf = nval_bf - val_bf;
+
+              val_gf = nval_gf;
+              nval_gf = rectf[2];
+              diff_gf = nval_gf - val_gf;
+
+              val_rf = nval_rf;
+              nval_rf = rectf[3];
+              diff_rf = nval_rf - val_rf;
+              rectf += 4;
+            }
+          }
           if (do_rect) {
-            val_a = nval_a;
-            nval_a = rect[0];
-            diff_a = nval_a - val_a;
-            val_a += 0.5f;
-
-            val_b = nval_b;
-            nval_b = rect[1];
-            diff_b = nval_b - val_b;
-            val_b += 0.5f;
-
-            val_g = nval_g;
-            nval_g = rect[2];
-            diff_g = nval_g - val_g;
-            val_g += 0.5f;
-
-            val_r = nval_r;
-            nval_r = rect[3];
-            diff_r = nval_r - val_r;
-            val_r += 0.5f;
-            rect += 4;
+            newrect[0] = val_a + sample * diff_a;
+            newrect[1] = val_b + sample * diff_b;
+            newrect[2] = val_g + sample * diff_g;
+            newrect[3] = val_r + sample * diff_r;
+            newrect += 4;
           }
           if (do_float) {
-            val_af = nval_af;
-            nval_af = rectf[0];
-            diff_af = nval_af - val_af;
-
-            val_bf = nval_bf;
-            nval_bf = rectf[1];
-            diff_bf = nval_bf - val_bf;
-
-            val_gf = nval_gf;
-            nval_gf = rectf[2];
-            diff_gf = nval_gf - val_gf;
-
-            val_rf = nval_rf;
-            nval_rf = rectf[3];
-            diff_rf = nval_rf - val_rf;
-            rectf += 4;
+            newrectf[0] = val_af + sample * diff_af;
+            newrectf[1] = val_bf + sample * diff_bf;
+            newrectf[2] = val_gf + sample * diff_gf;
+            newrectf[3] = val_rf + sample * diff_rf;
+            newrectf += 4;
           }
+          sample += add;
         }
-        if (do_rect) {
-          newrect[0] = val_a + sample * diff_a;
-          newrect[1] = val_b + sample * diff_b;
-          newrect[2] = val_g + sample * diff_g;
-          newrect[3] = val_r + sample * diff_r;
-          newrect += 4;
-        }
-        if (do_float) {
-          newrectf[0] = val_af + sample * diff_af;
-          newrectf[1] = val_bf + sample * diff_bf;
-          newrectf[2] = val_gf + sample * diff_gf;
-          newrectf[3] = val_rf + sample * diff_rf;
-          newrectf += 4;
-        }
-        sample += add;
       }
-    }
+    });
   }
 
   if (do_rect) {
@@ -1237,9 +1247,8 @@ static ImBuf *scaleupx(ImBuf *ibuf, int newx)
 
 static ImBuf *scaleupy(ImBuf *ibuf, int newy)
 {
-  uchar *rect, *_newrect = nullptr, *newrect;
-  float *rectf, *_newrectf = nullptr, *newrectf;
-  int x, y, skipx;
+  uchar *_newrect = nullptr;
+  float *_newrectf = nullptr;
   bool do_rect = false, do_float = false;
 
   if (ibuf == nullptr) {
@@ -1267,24 +1276,23 @@ static ImBuf *scaleupy(ImBuf *ibuf, int newy)
     }
   }
 
-  rect = ibuf->byte_buffer.data;
-  rectf = ibuf->float_buffer.data;
-  newrect = _newrect;
-  newrectf = _newrectf;
-
-  skipx = 4 * ibuf->x;
+  const int skipx = 4 * ibuf->x;
 
   /* Special case, copy all rows, needed since the scaling logic assumes there is at least
    * two rows to interpolate between causing out of bounds read for 1px images, see #70356. */
   if (UNLIKELY(ibuf->y == 1)) {
+    const uchar *rect = ibuf->byte_buffer.data;
+    const float *rectf = ibuf->float_buffer.data;
+    uchar *newrect = _newrect;
+    float *newrectf = _newrectf;
     if (do_rect) {
-      for (y = newy; y > 0; y--) {
+      for (int y = newy; y > 0; y--) {
         memcpy(newrect, rect, sizeof(char) * skipx);
         newrect += skipx;
       }
     }
     if (do_float) {
-      for (y = newy; y > 0; y--) {
+      for (int y = newy; y > 0; y--) {
         memcpy(newrectf, rectf, sizeof(float) * skipx);
         newrectf += skipx;
       }
@@ -1292,135 +1300,142 @@ static ImBuf *scaleupy(ImBuf *ibuf, int newy)
   }
   else {
     const float add = (ibuf->y - 1.001) / (newy - 1.0);
-    float sample;
-
-    float val_a, nval_a, diff_a;
-    float val_b, nval_b, diff_b;
-    float val_g, nval_g, diff_g;
-    float val_r, nval_r, diff_r;
-    float val_af, nval_af, diff_af;
-    float val_bf, nval_bf, diff_bf;
-    float val_gf, nval_gf, diff_gf;
-    float val_rf, nval_rf, diff_rf;
-
-    val_a = nval_a = diff_a = val_b = nval_b = diff_b = 0;
-    val_g = nval_g = diff_g = val_r = nval_r = diff_r = 0;
-    val_af = nval_af = diff_af = val_bf = nval_bf = diff_bf = 0;
-    val_gf = nval_gf = diff_gf = val_rf = nval_rf = diff_rf = 0;
-
-    for (x = ibuf->x; x > 0; x--) {
-      sample = 0;
-      if (do_rect) {
-        rect = ibuf->byte_buffer.data + 4 * (x - 1);
-        newrect = _newrect + 4 * (x - 1);
-
-        val_a = rect[0];
-        nval_a = rect[skipx];
-        diff_a = nval_a - val_a;
-        val_a += 0.5f;
-
-        val_b = rect[1];
-        nval_b = rect[skipx + 1];
-        diff_b = nval_b - val_b;
-        val_b += 0.5f;
-
-        val_g = rect[2];
-        nval_g = rect[skipx + 2];
-        diff_g = nval_g - val_g;
-        val_g += 0.5f;
-
-        val_r = rect[3];
-        nval_r = rect[skipx + 3];
-        diff_r = nval_r - val_r;
-        val_r += 0.5f;
-
-        rect += 2 * skipx;
-      }
-      if (do_float) {
-        rectf = ibuf->float_buffer.data + 4 * (x - 1);
-        newrectf = _newrectf + 4 * (x - 1);
 
-        val_af = rectf[0];
-        nval_af = rectf[skipx];
-        diff_af = nval_af - val_af;
+    /* Columns are independent, so they are scaled in parallel. */
+    blender::threading::parallel_for(IndexRange(ibuf->x), 64, [&](const IndexRange columns) {
+      for (const int64_t column : columns) {
+        const uchar *rect = nullptr;
+        uchar *newrect = nullptr;
+        const float *rectf = nullptr;
+        float *newrectf = nullptr;
+        float sample = 0;
+
+        float val_a, nval_a, diff_a;
+        float val_b, nval_b, diff_b;
+        float val_g, nval_g, diff_g;
+        float val_r, nval_r, diff_r;
+        float val_af, nval_af, diff_af;
+        float val_bf, nval_bf, diff_bf;
+        float val_gf, nval_gf, diff_gf;
+        float val_rf, nval_rf, diff_rf;
+
+        val_a = nval_a = diff_a = val_b = nval_b = diff_b = 0;
+        val_g = nval_g = diff_g = val_r = nval_r = diff_r = 0;
+        val_af = nval_af = diff_af = val_bf = nval_bf = diff_bf = 0;
+        val_gf = nval_gf = diff_gf = val_rf = nval_rf = diff_rf = 0;
+
+        if (do_rect) {
+          rect = ibuf->byte_buffer.data + 4 * column;
+          newrect = _newrect + 4 * column;
+
+          val_a = rect[0];
+          nval_a = rect[skipx];
+          diff_a = nval_a - val_a;
+          val_a += 0.5f;
+
+          val_b = rect[1];
+          nval_b = rect[skipx + 1];
+          diff_b = nval_b - val_b;
+          val_b += 0.5f;
+
+          val_g = rect[2];
+          nval_g = rect[skipx + 2];
+          diff_g = nval_g - val_g;
+          val_g += 0.5f;
+
+          val_r = rect[3];
+          nval_r = rect[skipx + 3];
+          diff_r = nval_r - val_r;
+          val_r += 0.5f;
+
+          rect += 2 * skipx;
+        }
+        if (do_float) {
+          rectf = ibuf->float_buffer.data + 4 * column;
+          newrectf = _newrectf + 4 * column;
 
-        val_bf = rectf[1];
-        nval_bf = rectf[skipx + 1];
-        diff_bf = nval_bf - val_bf;
+          val_af = rectf[0];
+          nval_af = rectf[skipx];
+          diff_af = nval_af - val_af;
 
-        val_gf = rectf[2];
-        nval_gf = rectf[skipx + 2];
-        diff_gf = nval_gf - val_gf;
+          val_bf = rectf[1];
+          nval_bf = rectf[skipx + 1];
+          diff_bf = nval_bf - val_bf;
 
-        val_rf = rectf[3];
-        nval_rf = rectf[skipx + 3];
-        diff_rf = nval_rf - val_rf;
+          val_gf = rectf[2];
+          nval_gf = rectf[skipx + 2];
+          diff_gf = nval_gf - val_gf;
 
-        rectf += 2 * skipx;
-      }
+          val_rf = rectf[3];
+          nval_rf = rectf[skipx + 3];
+          diff_rf = nval_rf - val_rf;
 
-      for (y = newy; y > 0; y--) {
-        if (sample >= 1.0f) {
-          sample -= 1.0f;
+          rectf += 2 * skipx;
+        }
 
+        for (int y = newy; y > 0; y--) {
+          if (sample >= 1.0f) {
+            sample -= 1.0f;
+
+            if (do_rect) {
+              val_a = nval_a;
+              nval_a = rect[0];
+              diff_a = nval_a - val_a;
+              val_a += 0.5f;
+
+              val_b = nval_b;
+              nval_b = rect[1];
+              diff_b = nval_b - val_b;
+              val_b += 0.5f;
+
+              val_g = nval_g;
+              nval_g = rect[2];
+              diff_g = nval_g - val_g;
+              val_g += 0.5f;
+
+              val_r = nval_r;
+              nval_r = rect[3];
+              diff_r = nval_r - val_r;
+              val_r += 0.5f;
+              rect += skipx;
+            }
+            if (do_float) {
+              val_af = nval_af;
+              nval_af = rectf[0];
+              diff_af = nval_af - val_af;
+
+              val_bf = nval_bf;
+              nval_bf = rectf[1];
+              diff_bf = nval_bf - val_bf;
+
+              val_gf = nval_gf;
+              nval_gf = rectf[2];
+              diff_gf = nval_gf - val_gf;
+
+              val_rf = nval_rf;
+              nval_rf = rectf[3];
+              diff_rf = nval_rf - val_rf;
+              rectf += skipx;
+            }
+          }
           if (do_rect) {
-            val_a = nval_a;
-            nval_a = rect[0];
-            diff_a = nval_a - val_a;
-            val_a += 0.5f;
-
-            val_b = nval_b;
-            nval_b = rect[1];
-            diff_b = nval_b - val_b;
-            val_b += 0.5f;
-
-            val_g = nval_g;
-            nval_g = rect[2];
-            diff_g = nval_g - val_g;
-            val_g += 0.5f;
-
-            val_r = nval_r;
-            nval_r = rect[3];
-            diff_r = nval_r - val_r;
-            val_r += 0.5f;
-            rect += skipx;
+            newrect[0] = val_a + sample * diff_a;
+            newrect[1] = val_b + sample * diff_b;
+            newrect[2] = val_g + sample * diff_g;
+            newrect[3] = val_r + sample * diff_r;
+            newrect += skipx;
           }
           if (do_float) {
-            val_af = nval_af;
-            nval_af = rectf[0];
-            diff_af = nval_af - val_af;
-
-            val_bf = nval_bf;
-            nval_bf = rectf[1];
-            diff_bf = nval_bf - val_bf;
-
-            val_gf = nval_gf;
-            nval_gf = rectf[2];
-            diff_gf = nval_gf - val_gf;
-
-            val_rf = nval_rf;
-            nval_rf = rectf[3];
-            diff_rf = nval_rf - val_rf;
-            rectf += skipx;
+            newrectf[0] = val_af + sample * diff_af;
+            newrectf[1] = val_bf + sample * diff_bf;
+            newrectf[2] = val_gf + sample * diff_gf;
+            newrectf[3] = val_rf + sample * diff_rf;
+            newrectf += skipx;
           }
+          sample += add;
         }
-        if (do_rect) {
-          newrect[0] = val_a + sample * diff_a;
-          newrect[1] = val_b + sample * diff_b;
-          newrect[2] = val_g + sample * diff_g;
-          newrect[3] = val_r + sample * diff_r;
-          newrect += skipx;
-        }
-        if (do_float) {
-          newrectf[0] = val_af + sample * diff_af;
-          newrectf[1] = val_bf + sample * diff_bf;
-          newrectf[2] = val_gf + sample * diff_gf;
-          newrectf[3] = val_rf + sample * diff_rf;
-          newrectf += skipx;
-        }
-        sample += add;
       }
-    }
+    });
   }
 
   if (do_rect) {
@@ -430,9 +430,11 @@ static void get_vertices(Mesh *mesh, std::vector<Imath::V3f> &points)
   points.resize(mesh->verts_num);
 
   const Span<float3> positions = mesh->vert_positions();
-  for (int i = 0, e = mesh->verts_num; i < e; i++) {
-    copy_yup_from_zup(points[i].getValue(), positions[i]);
-  }
+  threading::parallel_for(positions.index_range(), 4096, [&](const IndexRange range) {
+    for (const int i : range) {
+      copy_yup_from_zup(points[i].getValue(), positions[i]);
+    }
+  });
 }
 
 static void get_topology(Mesh *mesh,
@@ -444,19 +446,19 @@ static void get_topology(Mesh *mesh,
 
   face_verts.clear();
   loop_counts.clear();
-  face_verts.reserve(corner_verts.size());
-  loop_counts.reserve(faces.size());
+  face_verts.resize(corner_verts.size());
+  loop_counts.resize(faces.size());
 
   /* NOTE: data needs to be written in the reverse order. */
-  for (const int i : faces.index_range()) {
-    const IndexRange face = faces[i];
-    loop_counts.push_back(face.size());
-
-    int corner = face.start() + (face.size() - 1);
-    for (int j = 0; j < face.size(); j++, corner--) {
-      face_verts.push_back(corner_verts[corner]);
+  threading::parallel_for(faces.index_range(), 1024, [&](const IndexRange range) {
+    for (const int i : range) {
+      const IndexRange face = faces[i];
+      loop_counts[i] = face.size();
+      for (const int j : face.index_range()) {
+        face_verts[face[j]] = corner_verts[face.last(j)];
+      }
     }
-  }
+  });
 }
 
 static void get_edge_creases(Mesh *mesh,
@@ -48,6 +48,13 @@ class AbcMeshReader final : public AbcObjectReader {
                         const Alembic::Abc::ISampleSelector &sample_sel) override;
 
  private:
+  /**
+   * Same as above, for a sample that was already read, so that the arrays are not read from the
+   * archive again.
+   */
+  bool topology_changed(const Mesh *existing_mesh,
+                        const Alembic::AbcGeom::IPolyMeshSchema::Sample &sample);
+
   void readFaceSetsSample(Main *bmain,
                           Mesh *mesh,
                           const Alembic::AbcGeom::ISampleSelector &sample_sel);
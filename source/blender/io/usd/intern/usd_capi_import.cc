@@ -313,6 +313,9 @@ static void import_startjob(void *customdata, wmJobWorkerStatus *worker_status)
   *data->do_update = true;
   *data->progress = 0.25f;
 
+  /* Object data names aren't sorted like the readers are, sort all new IDs once at the end. */
+  BKE_main_id_sort_defer_begin(data->bmain);
+
   /* Create blender objects. */
   for (USDPrimReader *reader : archive->readers()) {
     if (!reader) {
@@ -351,10 +354,13 @@ static void import_startjob(void *customdata, wmJobWorkerStatus *worker_status)
 
     if (G.is_break) {
       data->was_canceled = true;
+      BKE_main_id_sort_defer_end(data->bmain);
       return;
     }
   }
 
+  BKE_main_id_sort_defer_end(data->bmain);
+
   if (data->params.import_skeletons) {
     archive->process_armature_modifiers();
   }
@@ -23,6 +23,7 @@
 #include "BLI_map.hh"
 #include "BLI_math_vector_types.hh"
 #include "BLI_span.hh"
+#include "BLI_task.hh"
 
 #include "DNA_customdata_types.h"
 #include "DNA_material_types.h"
@@ -327,27 +328,26 @@ void USDMeshReader::read_mpolys(Mesh *mesh)
   MutableSpan<int> face_offsets = mesh->face_offsets_for_write();
   MutableSpan<int> corner_verts = mesh->corner_verts_for_write();
 
-  int loop_index = 0;
-
-  for (int i = 0; i < face_counts_.size(); i++) {
-    const int face_size = face_counts_[i];
-
-    face_offsets[i] = loop_index;
+  for (const int i : IndexRange(mesh->faces_num)) {
+    face_offsets[i] = face_counts_[i];
+  }
+  const OffsetIndices faces = offset_indices::accumulate_counts_to_offsets(face_offsets);
 
-    /* Polygons are always assumed to be smooth-shaded. If the mesh should be flat-shaded,
-     * this is encoded in custom loop normals. */
+  /* Polygons are always assumed to be smooth-shaded. If the mesh should be flat-shaded,
+   * this is encoded in custom loop normals. */
 
-    if (is_left_handed_) {
-      int loop_end_index = loop_index + (face_size - 1);
-      for (int f = 0; f < face_size; ++f, ++loop_index) {
-        corner_verts[loop_index] = face_indices_[loop_end_index - f];
-      }
-    }
-    else {
-      for (int f = 0; f < face_size; ++f, ++loop_index) {
-        corner_verts[loop_index] = face_indices_[loop_index];
+  if (is_left_handed_) {
+    threading::parallel_for(faces.index_range(), 1024, [&](const IndexRange range) {
+      for (const int i : range) {
+        const IndexRange face = faces[i];
+        for (const int j : face.index_range()) {
+          corner_verts[face[j]] = face_indices_[face.last(j)];
+        }
       }
-    }
+    });
+  }
+  else {
+    corner_verts.copy_from(Span(face_indices_.cdata(), int64_t(face_indices_.size())));
   }
 
   bke::mesh_calc_edges(*mesh, false, false);
@@ -838,9 +838,8 @@ void USDMeshReader::read_mesh_sample(ImportSettings *settings,
 
   if (new_mesh || (settings->read_flag & MOD_MESHSEQ_READ_VERT) != 0) {
     MutableSpan<float3> vert_positions = mesh->vert_positions_for_write();
-    for (int i = 0; i < positions_.size(); i++) {
-      vert_positions[i] = {positions_[i][0], positions_[i][1], positions_[i][2]};
-    }
+    vert_positions.copy_from(
+        Span(reinterpret_cast<const float3 *>(positions_.cdata()), int64_t(positions_.size())));
     mesh->tag_positions_changed();
 
     read_vertex_creases(mesh, motionSampleTime);
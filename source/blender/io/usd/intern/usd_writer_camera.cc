@@ -79,23 +79,33 @@ void USDCameraWriter::do_write(HierarchyContext &context)
   float sensor_size, aperture_x, aperture_y;
   camera_sensor_size_for_render(camera, &scene->r, &sensor_size, &aperture_x, &aperture_y);
 
-  usd_camera.CreateFocalLengthAttr().Set(camera->lens / tenth_unit_to_mm, timecode);
-  usd_camera.CreateHorizontalApertureAttr().Set(aperture_x / tenth_unit_to_mm, timecode);
-  usd_camera.CreateVerticalApertureAttr().Set(aperture_y / tenth_unit_to_mm, timecode);
-  usd_camera.CreateHorizontalApertureOffsetAttr().Set(
-      sensor_size * camera->shiftx / tenth_unit_to_mm, timecode);
-  usd_camera.CreateVerticalApertureOffsetAttr().Set(
-      sensor_size * camera->shifty / tenth_unit_to_mm, timecode);
-
-  usd_camera.CreateClippingRangeAttr().Set(
-      pxr::VtValue(pxr::GfVec2f(camera->clip_start, camera->clip_end)), timecode);
+  usd_value_writer_.SetAttribute(
+      usd_camera.CreateFocalLengthAttr(), pxr::VtValue(camera->lens / tenth_unit_to_mm), timecode);
+  usd_value_writer_.SetAttribute(usd_camera.CreateHorizontalApertureAttr(),
+                                 pxr::VtValue(aperture_x / tenth_unit_to_mm),
+                                 timecode);
+  usd_value_writer_.SetAttribute(usd_camera.CreateVerticalApertureAttr(),
+                                 pxr::VtValue(aperture_y / tenth_unit_to_mm),
+                                 timecode);
+  usd_value_writer_.SetAttribute(usd_camera.CreateHorizontalApertureOffsetAttr(),
+                                 pxr::VtValue(sensor_size * camera->shiftx / tenth_unit_to_mm),
+                                 timecode);
+  usd_value_writer_.SetAttribute(usd_camera.CreateVerticalApertureOffsetAttr(),
+                                 pxr::VtValue(sensor_size * camera->shifty / tenth_unit_to_mm),
+                                 timecode);
+
+  usd_value_writer_.SetAttribute(usd_camera.CreateClippingRangeAttr(),
+                                 pxr::VtValue(pxr::GfVec2f(camera->clip_start, camera->clip_end)),
+                                 timecode);
 
   /* Write DoF-related attributes. */
   if (camera->dof.flag & CAM_DOF_ENABLED) {
-    usd_camera.CreateFStopAttr().Set(camera->dof.aperture_fstop, timecode);
+    usd_value_writer_.SetAttribute(
+        usd_camera.CreateFStopAttr(), pxr::VtValue(camera->dof.aperture_fstop), timecode);
 
     float focus_distance = BKE_camera_object_dof_distance(context.object);
-    usd_camera.CreateFocusDistanceAttr().Set(focus_distance, timecode);
+    usd_value_writer_.SetAttribute(
+        usd_camera.CreateFocusDistanceAttr(), pxr::VtValue(focus_distance), timecode);
   }
 }
 
@@ -50,29 +50,36 @@ void USDLightWriter::do_write(HierarchyContext &context)
       switch (light->area_shape) {
         case LA_AREA_RECT: {
           pxr::UsdLuxRectLight rect_light = pxr::UsdLuxRectLight::Define(stage, usd_path);
-          rect_light.CreateWidthAttr().Set(light->area_size, timecode);
-          rect_light.CreateHeightAttr().Set(light->area_sizey, timecode);
+          usd_value_writer_.SetAttribute(
+              rect_light.CreateWidthAttr(), pxr::VtValue(light->area_size), timecode);
+          usd_value_writer_.SetAttribute(
+              rect_light.CreateHeightAttr(), pxr::VtValue(light->area_sizey), timecode);
           usd_light_api = rect_light.LightAPI();
           break;
         }
         case LA_AREA_SQUARE: {
           pxr::UsdLuxRectLight rect_light = pxr::UsdLuxRectLight::Define(stage, usd_path);
-          rect_light.CreateWidthAttr().Set(light->area_size, timecode);
-          rect_light.CreateHeightAttr().Set(light->area_size, timecode);
+          usd_value_writer_.SetAttribute(
+              rect_light.CreateWidthAttr(), pxr::VtValue(light->area_size), timecode);
+          usd_value_writer_.SetAttribute(
+              rect_light.CreateHeightAttr(), pxr::VtValue(light->area_size), timecode);
           usd_light_api = rect_light.LightAPI();
           break;
         }
         case LA_AREA_DISK: {
           pxr::UsdLuxDiskLight disk_light = pxr::UsdLuxDiskLight::Define(stage, usd_path);
-          disk_light.CreateRadiusAttr().Set(light->area_size / 2.0f, timecode);
+          usd_value_writer_.SetAttribute(
+              disk_light.CreateRadiusAttr(), pxr::VtValue(light->area_size / 2.0f), timecode);
           usd_light_api = disk_light.LightAPI();
           break;
         }
         case LA_AREA_ELLIPSE: {
           /* An ellipse light deteriorates into a disk light. */
           pxr::UsdLuxDiskLight disk_light = pxr::UsdLuxDiskLight::Define(stage, usd_path);
-          disk_light.CreateRadiusAttr().Set((light->area_size + light->area_sizey) / 4.0f,
-                                            timecode);
+          usd_value_writer_.SetAttribute(
+              disk_light.CreateRadiusAttr(),
+              pxr::VtValue((light->area_size + light->area_sizey) / 4.0f),
+              timecode);
           usd_light_api = disk_light.LightAPI();
           break;
         }
@@ -82,16 +89,22 @@ void USDLightWriter::do_write(HierarchyContext &context)
     case LA_LOCAL:
     case LA_SPOT: {
       pxr::UsdLuxSphereLight sphere_light = pxr::UsdLuxSphereLight::Define(stage, usd_path);
-      sphere_light.CreateRadiusAttr().Set(light->radius, timecode);
+      usd_value_writer_.SetAttribute(
+          sphere_light.CreateRadiusAttr(), pxr::VtValue(light->radius), timecode);
       if (light->radius == 0.0f) {
-        sphere_light.CreateTreatAsPointAttr().Set(true, timecode);
+        usd_value_writer_.SetAttribute(
+            sphere_light.CreateTreatAsPointAttr(), pxr::VtValue(true), timecode);
       }
 
       if (light->type == LA_SPOT) {
         pxr::UsdLuxShapingAPI shaping_api = pxr::UsdLuxShapingAPI::Apply(sphere_light.GetPrim());
         if (shaping_api) {
-          shaping_api.CreateShapingConeAngleAttr().Set(RAD2DEGF(light->spotsize) / 2.0f, timecode);
-          shaping_api.CreateShapingConeSoftnessAttr().Set(light->spotblend, timecode);
+          usd_value_writer_.SetAttribute(shaping_api.CreateShapingConeAngleAttr(),
+                                         pxr::VtValue(RAD2DEGF(light->spotsize) / 2.0f),
+                                         timecode);
+          usd_value_writer_.SetAttribute(shaping_api.CreateShapingConeSoftnessAttr(),
+                                         pxr::VtValue(light->spotblend),
+                                         timecode);
         }
       }
 
@@ -100,7 +113,9 @@ void USDLightWriter::do_write(HierarchyContext &context)
     }
     case LA_SUN: {
       pxr::UsdLuxDistantLight distant_light = pxr::UsdLuxDistantLight::Define(stage, usd_path);
-      distant_light.CreateAngleAttr().Set(RAD2DEGF(light->sun_angle / 2.0f), timecode);
+      usd_value_writer_.SetAttribute(distant_light.CreateAngleAttr(),
+                                     pxr::VtValue(RAD2DEGF(light->sun_angle / 2.0f)),
+                                     timecode);
       usd_light_api = distant_light.LightAPI();
       break;
     }
@@ -119,12 +134,18 @@ void USDLightWriter::do_write(HierarchyContext &context)
     intensity = light->energy / M_PI;
   }
 
-  usd_light_api.CreateIntensityAttr().Set(intensity, timecode);
-  usd_light_api.CreateExposureAttr().Set(0.0f, timecode);
-  usd_light_api.CreateColorAttr().Set(pxr::GfVec3f(light->r, light->g, light->b), timecode);
-  usd_light_api.CreateDiffuseAttr().Set(light->diff_fac, timecode);
-  usd_light_api.CreateSpecularAttr().Set(light->spec_fac, timecode);
-  usd_light_api.CreateNormalizeAttr().Set(true, timecode);
+  usd_value_writer_.SetAttribute(
+      usd_light_api.CreateIntensityAttr(), pxr::VtValue(intensity), timecode);
+  usd_value_writer_.SetAttribute(usd_light_api.CreateExposureAttr(), pxr::VtValue(0.0f), timecode);
+  usd_value_writer_.SetAttribute(usd_light_api.CreateColorAttr(),
+                                 pxr::VtValue(pxr::GfVec3f(light->r, light->g, light->b)),
+                                 timecode);
+  usd_value_writer_.SetAttribute(
+      usd_light_api.CreateDiffuseAttr(), pxr::VtValue(light->diff_fac), timecode);
+  usd_value_writer_.SetAttribute(
+      usd_light_api.CreateSpecularAttr(), pxr::VtValue(light->spec_fac), timecode);
+  usd_value_writer_.SetAttribute(
+      usd_light_api.CreateNormalizeAttr(), pxr::VtValue(true), timecode);
 
   set_light_extents(usd_light_api.GetPrim(), timecode);
 }
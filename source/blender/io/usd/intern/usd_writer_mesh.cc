@@ -268,12 +268,11 @@ void USDGenericMeshWriter::copy_blender_buffer_to_prim(const Span<BlenderT> buff
     }
   }
 
+  /* Values at time samples go through the sparse value writer, so that constant attributes are
+   * only written once instead of for every frame. */
   if (!attribute_pv.HasValue() && timecode != pxr::UsdTimeCode::Default()) {
     attribute_pv.Set(data, pxr::UsdTimeCode::Default());
   }
-  else {
-    attribute_pv.Set(data, timecode);
-  }
 
   const pxr::UsdAttribute &prim_attr = attribute_pv.GetAttr();
   usd_value_writer_.SetAttribute(prim_attr, pxr::VtValue(data), timecode);
@@ -847,7 +846,8 @@ void USDGenericMeshWriter::write_surface_velocity(const Mesh *mesh, pxr::UsdGeom
   }
 
   pxr::UsdTimeCode timecode = get_export_time_code();
-  usd_mesh.CreateVelocitiesAttr().Set(usd_velocities, timecode);
+  usd_value_writer_.SetAttribute(
+      usd_mesh.CreateVelocitiesAttr(), pxr::VtValue(usd_velocities), timecode);
 }
 
 USDMeshWriter::USDMeshWriter(const USDExporterContext &ctx)
@@ -20,6 +20,7 @@
 #include "BLI_task.hh"
 #include "BLI_vector.hh"
 
+#include "DEG_depsgraph_build.hh"
 #include "DEG_depsgraph_query.hh"
 
 #include "DNA_collection_types.h"
@@ -42,17 +43,23 @@ OBJDepsgraph::OBJDepsgraph(const bContext *C,
   Scene *scene = CTX_data_scene(C);
   Main *bmain = CTX_data_main(C);
   ViewLayer *view_layer = CTX_data_view_layer(C);
+  /* Only geometry with its transform is exported, other components of the objects in a graph
+   * created for the export don't need to be evaluated. */
+  const eDepsObjectComponentType exported_components[] = {DEG_OB_COMP_TRANSFORM,
+                                                          DEG_OB_COMP_GEOMETRY};
 
   /* If a collection was provided, use it. */
   if (collection) {
     depsgraph_ = DEG_graph_new(bmain, scene, view_layer, eval_mode);
     needs_free_ = true;
+    DEG_graph_set_requested_object_components(depsgraph_, exported_components);
     DEG_graph_build_from_collection(depsgraph_, collection);
     BKE_scene_graph_evaluated_ensure(depsgraph_, bmain);
   }
   else if (eval_mode == DAG_EVAL_RENDER) {
     depsgraph_ = DEG_graph_new(bmain, scene, view_layer, eval_mode);
     needs_free_ = true;
+    DEG_graph_set_requested_object_components(depsgraph_, exported_components);
     DEG_graph_build_for_all_objects(depsgraph_);
     BKE_scene_graph_evaluated_ensure(depsgraph_, bmain);
   }
@@ -15,6 +15,7 @@
 
 struct Main;
 struct Material;
+struct Mesh;
 struct Object;
 
 namespace blender::io::obj {
@@ -33,10 +34,19 @@ class MeshFromGeometry : NonMovable, NonCopyable {
   {
   }
 
-  Object *create_mesh(Main *bmain,
-                      Map<std::string, std::unique_ptr<MTLMaterial>> &materials,
-                      Map<std::string, Material *> &created_materials,
-                      const OBJImportParams &import_params);
+  /**
+   * Build the mesh data of the geometry. This doesn't touch #Main, so it can run for different
+   * geometries in parallel. Returns null for geometry without vertices.
+   */
+  Mesh *create_mesh(const OBJImportParams &import_params);
+  /**
+   * Add a mesh object to #Main for a mesh made by #create_mesh, taking ownership of the mesh.
+   */
+  Object *create_mesh_object(Mesh *mesh,
+                             Main *bmain,
+                             Map<std::string, std::unique_ptr<MTLMaterial>> &materials,
+                             Map<std::string, Material *> &created_materials,
+                             const OBJImportParams &import_params);
 
  private:
   /**
@@ -8,14 +8,17 @@
 
 #include <string>
 
+#include "BLI_array.hh"
 #include "BLI_map.hh"
 #include "BLI_set.hh"
 #include "BLI_sort.hh"
 #include "BLI_string.h"
 #include "BLI_string_ref.hh"
+#include "BLI_task.hh"
 
 #include "BKE_context.hh"
 #include "BKE_layer.hh"
+#include "BKE_lib_id.hh"
 
 #include "DEG_depsgraph_build.hh"
 
@@ -95,15 +98,32 @@ static void geometry_to_blender_objects(Main *bmain,
         return BLI_strcasecmp(na, nb) < 0;
       });
 
-  /* Create all the objects. */
+  /* Building mesh data is independent of #Main, do it for all geometries in parallel. */
+  Array<Mesh *> meshes(all_geometries.size(), nullptr);
+  threading::parallel_for(all_geometries.index_range(), 1, [&](const IndexRange range) {
+    for (const int64_t i : range) {
+      if (all_geometries[i]->geom_type_ == GEOM_MESH) {
+        MeshFromGeometry mesh_from_geometry{*all_geometries[i], global_vertices};
+        meshes[i] = mesh_from_geometry.create_mesh(import_params);
+      }
+    }
+  });
+
+  /* Create all the objects. Materials and collections aren't created in name order, sort all new
+   * IDs once at the end. */
   Vector<Object *> objects;
   objects.reserve(all_geometries.size());
   Set<Collection *> collections;
-  for (const std::unique_ptr<Geometry> &geometry : all_geometries) {
+  BKE_main_id_sort_defer_begin(bmain);
+  for (const int64_t i : all_geometries.index_range()) {
+    const std::unique_ptr<Geometry> &geometry = all_geometries[i];
     Object *obj = nullptr;
     if (geometry->geom_type_ == GEOM_MESH) {
-      MeshFromGeometry mesh_ob_from_geometry{*geometry, global_vertices};
-      obj = mesh_ob_from_geometry.create_mesh(bmain, materials, created_materials, import_params);
+      if (meshes[i] != nullptr) {
+        MeshFromGeometry mesh_ob_from_geometry{*geometry, global_vertices};
+        obj = mesh_ob_from_geometry.create_mesh_object(
+            meshes[i], bmain, materials, created_materials, import_params);
+      }
     }
     else if (geometry->geom_type_ == GEOM_CURVE) {
       CurveFromGeometry curve_ob_from_geometry(*geometry, global_vertices);
@@ -118,6 +138,7 @@ static void geometry_to_blender_objects(Main *bmain,
       objects.append(obj);
     }
   }
+  BKE_main_id_sort_defer_end(bmain);
 
   /* Do object selections in a separate loop (allows just one view layer sync). */
   BKE_view_layer_synced_ensure(scene, view_layer);
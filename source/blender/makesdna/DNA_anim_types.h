@@ -27,6 +27,7 @@ struct AnimationLayer;
 struct AnimationBinding;
 struct AnimationStrip;
 struct AnimationChannelBag;
+struct AnimationEvalCache;
 
 /* ************************************************ */
 /* F-Curve DataTypes */
@@ -1157,6 +1158,8 @@ typedef struct AnimData {
 
   /** Runtime data, for depsgraph evaluation. */
   FCurve **driver_array;
+  /** Runtime data, resolved channels of the active action, see #BKE_animsys_eval_animdata. */
+  struct AnimationEvalCache *eval_cache;
 
   /**
    * Active Animation data-block. If this is set, `action` and NLA-related
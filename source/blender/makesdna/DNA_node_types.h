@@ -859,6 +859,7 @@ typedef enum eNodeTreeExecutionMode {
 typedef enum eNodeTreePrecision {
   NODE_TREE_COMPOSITOR_PRECISION_AUTO = 0,
   NODE_TREE_COMPOSITOR_PRECISION_FULL = 1,
+  NODE_TREE_COMPOSITOR_PRECISION_HALF = 2,
 } eNodeTreePrecision;
 
 typedef enum eNodeTreeRuntimeFlag {
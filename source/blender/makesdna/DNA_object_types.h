@@ -682,6 +682,8 @@ enum {
 #ifdef DNA_DEPRECATED_ALLOW
   OB_FLAG_UNUSED_12 = 1 << 12, /* cleared */
 #endif
+  /** Keep evaluated meshes of previous frames for faster scrubbing. */
+  OB_FLAG_USE_PLAYBACK_CACHE = 1 << 14,
 };
 
 /** #Object.visibility_flag */
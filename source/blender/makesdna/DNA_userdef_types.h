@@ -1060,7 +1060,7 @@ typedef struct UserDef {
 
   float collection_instance_empty_size;
   char text_flag;
-  char _pad10[1];
+  char sequencer_decode_flag; /* eUserpref_SeqDecodeFlag */
 
   char file_preview_type; /* eUserpref_File_Preview_Type */
   char statusbar_flag;    /* eUserpref_StatusBar_Flag */
@@ -1529,6 +1529,10 @@ typedef enum eUserpref_SeqProxySetup {
   USER_SEQ_PROXY_SETUP_AUTOMATIC = 1,
 } eUserpref_SeqProxySetup;
 
+typedef enum eUserpref_SeqDecodeFlag {
+  USER_SEQ_DECODE_HARDWARE = (1 << 0),
+} eUserpref_SeqDecodeFlag;
+
 /* Locale Ids. Auto will try to get local from OS. Our default is English though. */
 /** #UserDef.language */
 enum {
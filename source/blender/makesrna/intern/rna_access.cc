@@ -28,6 +28,7 @@
 #include "BLI_dynstr.h"
 #include "BLI_ghash.h"
 #include "BLI_threads.h"
+#include "BLI_trace.hh"
 #include "BLI_utildefines.h"
 
 #include "BLF_api.hh"
@@ -73,6 +74,8 @@ static CLG_LogRef LOG = {"rna.access"};
 
 void RNA_init()
 {
+  TRACE_SCOPE("RNA::init");
+
   StructRNA *srna;
 
   BLENDER_RNA.structs_map = BLI_ghash_str_new_ex(__func__, 2048);
@@ -4784,8 +4787,26 @@ static int rna_raw_access(ReportList *reports,
         return 1;
       }
 
-      /* Could also be faster with non-matching types,
-       * for now we just do slower loop. */
+      /* Non-matching types, still access the raw array directly and only convert each value,
+       * instead of going through the property accessors for every item. */
+      RawArray out_item = out;
+      for (int a = 0; a < out.len; a++) {
+        for (int j = 0; j < arraylen; j++) {
+          const int in_index = a * arraylen + j;
+          double value;
+          if (set) {
+            RAW_GET(double, value, in, in_index);
+            RAW_SET(double, out_item, j, value);
+          }
+          else {
+            RAW_GET(double, value, out_item, j);
+            RAW_SET(double, in, in_index, value);
+          }
+        }
+        out_item.array = (char *)out_item.array + out.stride;
+      }
+
+      return 1;
     }
     BLI_assert_msg(itemlen == 0 || itemtype != PROP_ENUM,
                    "Enum array properties should not exist");
@@ -4804,10 +4825,13 @@ static int rna_raw_access(ReportList *reports,
       /* avoid creating temporary buffer if the data type match */
       needconv = 0;
     }
+    const bool is_path = strpbrk(propname, ".[") != nullptr;
+
     /* no item property pointer, can still be id property, or
      * property of a type derived from the collection pointer type */
     RNA_PROP_BEGIN (ptr, itemptr, prop) {
       if (itemptr.data) {
+        PointerRNA propptr = itemptr;
         if (itemprop) {
           /* we got the property already */
           iprop = itemprop;
@@ -4816,8 +4840,15 @@ static int rna_raw_access(ReportList *reports,
           /* not yet, look it up and verify if it is valid */
           iprop = RNA_struct_find_property(&itemptr, propname);
 
+          /* The name may also be a path relative to the item, e.g. `data.energy` for objects. */
+          if (iprop == nullptr && is_path &&
+              !RNA_path_resolve_property(&itemptr, propname, &propptr, &iprop))
+          {
+            iprop = nullptr;
+          }
+
           if (iprop) {
-            itemlen = rna_property_array_length_all_dimensions(&itemptr, iprop);
+            itemlen = rna_property_array_length_all_dimensions(&propptr, iprop);
             itemtype = RNA_property_type(iprop);
           }
           else {
@@ -4837,7 +4868,7 @@ static int rna_raw_access(ReportList *reports,
         }
 
         /* editable check */
-        if (!set || RNA_property_editable(&itemptr, iprop)) {
+        if (!set || RNA_property_editable(&propptr, iprop)) {
           if (a + itemlen > in.len) {
             BKE_reportf(
                 reports, RPT_ERROR, "Array length mismatch (got %d, expected more)", in.len);
@@ -4852,25 +4883,25 @@ static int rna_raw_access(ReportList *reports,
                 case PROP_BOOLEAN: {
                   int b;
                   RAW_GET(bool, b, in, a);
-                  RNA_property_boolean_set(&itemptr, iprop, b);
+                  RNA_property_boolean_set(&propptr, iprop, b);
                   break;
                 }
                 case PROP_INT: {
                   int i;
                   RAW_GET(int, i, in, a);
-                  RNA_property_int_set(&itemptr, iprop, i);
+                  RNA_property_int_set(&propptr, iprop, i);
                   break;
                 }
                 case PROP_FLOAT: {
                   float f;
                   RAW_GET(float, f, in, a);
-                  RNA_property_float_set(&itemptr, iprop, f);
+                  RNA_property_float_set(&propptr, iprop, f);
                   break;
                 }
                 case PROP_ENUM: {
                   int i;
                   RAW_GET(int, i, in, a);
-                  RNA_property_enum_set(&itemptr, iprop, i);
+                  RNA_property_enum_set(&propptr, iprop, i);
                   break;
                 }
                 default:
@@ -4881,22 +4912,22 @@ static int rna_raw_access(ReportList *reports,
             else {
               switch (itemtype) {
                 case PROP_BOOLEAN: {
-                  int b = RNA_property_boolean_get(&itemptr, iprop);
+                  int b = RNA_property_boolean_get(&propptr, iprop);
                   RAW_SET(bool, in, a, b);
                   break;
                 }
                 case PROP_INT: {
-                  int i = RNA_property_int_get(&itemptr, iprop);
+                  int i = RNA_property_int_get(&propptr, iprop);
                   RAW_SET(int, in, a, i);
                   break;
                 }
                 case PROP_FLOAT: {
-                  float f = RNA_property_float_get(&itemptr, iprop);
+                  float f = RNA_property_float_get(&propptr, iprop);
                   RAW_SET(float, in, a, f);
                   break;
                 }
                 case PROP_ENUM: {
-                  int i = RNA_property_enum_get(&itemptr, iprop);
+                  int i = RNA_property_enum_get(&propptr, iprop);
                   RAW_SET(int, in, a, i);
                   break;
                 }
@@ -4926,7 +4957,7 @@ static int rna_raw_access(ReportList *reports,
                   for (j = 0; j < itemlen; j++, a++) {
                     RAW_GET(bool, array[j], in, a);
                   }
-                  RNA_property_boolean_set_array(&itemptr, iprop, array);
+                  RNA_property_boolean_set_array(&propptr, iprop, array);
                   break;
                 }
                 case PROP_INT: {
@@ -4934,7 +4965,7 @@ static int rna_raw_access(ReportList *reports,
                   for (j = 0; j < itemlen; j++, a++) {
                     RAW_GET(int, array[j], in, a);
                   }
-                  RNA_property_int_set_array(&itemptr, iprop, array);
+                  RNA_property_int_set_array(&propptr, iprop, array);
                   break;
                 }
                 case PROP_FLOAT: {
@@ -4942,7 +4973,7 @@ static int rna_raw_access(ReportList *reports,
                   for (j = 0; j < itemlen; j++, a++) {
                     RAW_GET(float, array[j], in, a);
                   }
-                  RNA_property_float_set_array(&itemptr, iprop, array);
+                  RNA_property_float_set_array(&propptr, iprop, array);
                   break;
                 }
                 default:
@@ -4954,7 +4985,7 @@ static int rna_raw_access(ReportList *reports,
               switch (itemtype) {
                 case PROP_BOOLEAN: {
                   bool *array = static_cast<bool *>(tmparray);
-                  RNA_property_boolean_get_array(&itemptr, iprop, array);
+                  RNA_property_boolean_get_array(&propptr, iprop, array);
                   for (j = 0; j < itemlen; j++, a++) {
                     RAW_SET(int, in, a, ((bool *)tmparray)[j]);
                   }
@@ -4962,7 +4993,7 @@ static int rna_raw_access(ReportList *reports,
                 }
                 case PROP_INT: {
                   int *array = static_cast<int *>(tmparray);
-                  RNA_property_int_get_array(&itemptr, iprop, array);
+                  RNA_property_int_get_array(&propptr, iprop, array);
                   for (j = 0; j < itemlen; j++, a++) {
                     RAW_SET(int, in, a, array[j]);
                   }
@@ -4970,7 +5001,7 @@ static int rna_raw_access(ReportList *reports,
                 }
                 case PROP_FLOAT: {
                   float *array = static_cast<float *>(tmparray);
-                  RNA_property_float_get_array(&itemptr, iprop, array);
+                  RNA_property_float_get_array(&propptr, iprop, array);
                   for (j = 0; j < itemlen; j++, a++) {
                     RAW_SET(float, in, a, array[j]);
                   }
@@ -4986,17 +5017,17 @@ static int rna_raw_access(ReportList *reports,
             if (set) {
               switch (itemtype) {
                 case PROP_BOOLEAN: {
-                  RNA_property_boolean_set_array(&itemptr, iprop, &((bool *)in.array)[a]);
+                  RNA_property_boolean_set_array(&propptr, iprop, &((bool *)in.array)[a]);
                   a += itemlen;
                   break;
                 }
                 case PROP_INT: {
-                  RNA_property_int_set_array(&itemptr, iprop, &((int *)in.array)[a]);
+                  RNA_property_int_set_array(&propptr, iprop, &((int *)in.array)[a]);
                   a += itemlen;
                   break;
                 }
                 case PROP_FLOAT: {
-                  RNA_property_float_set_array(&itemptr, iprop, &((float *)in.array)[a]);
+                  RNA_property_float_set_array(&propptr, iprop, &((float *)in.array)[a]);
                   a += itemlen;
                   break;
                 }
@@ -5008,17 +5039,17 @@ static int rna_raw_access(ReportList *reports,
             else {
               switch (itemtype) {
                 case PROP_BOOLEAN: {
-                  RNA_property_boolean_get_array(&itemptr, iprop, &((bool *)in.array)[a]);
+                  RNA_property_boolean_get_array(&propptr, iprop, &((bool *)in.array)[a]);
                   a += itemlen;
                   break;
                 }
                 case PROP_INT: {
-                  RNA_property_int_get_array(&itemptr, iprop, &((int *)in.array)[a]);
+                  RNA_property_int_get_array(&propptr, iprop, &((int *)in.array)[a]);
                   a += itemlen;
                   break;
                 }
                 case PROP_FLOAT: {
-                  RNA_property_float_get_array(&itemptr, iprop, &((float *)in.array)[a]);
+                  RNA_property_float_get_array(&propptr, iprop, &((float *)in.array)[a]);
                   a += itemlen;
                   break;
                 }
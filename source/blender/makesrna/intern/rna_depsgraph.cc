@@ -272,6 +272,21 @@ static void rna_Depsgraph_debug_stats_gnuplot(Depsgraph *depsgraph,
   fclose(f);
 }
 
+static void rna_Depsgraph_debug_trace_begin(Depsgraph *depsgraph)
+{
+  DEG_debug_trace_begin(depsgraph);
+}
+
+static void rna_Depsgraph_debug_trace_end(Depsgraph *depsgraph, const char *filepath)
+{
+  FILE *f = fopen(filepath, "w");
+  if (f == nullptr) {
+    return;
+  }
+  DEG_debug_trace_end(depsgraph, f);
+  fclose(f);
+}
+
 static void rna_Depsgraph_debug_tag_update(Depsgraph *depsgraph)
 {
   DEG_graph_tag_relations_update(depsgraph);
@@ -281,12 +296,18 @@ static void rna_Depsgraph_debug_stats(Depsgraph *depsgraph, char *result)
 {
   size_t outer, ops, rels;
   DEG_stats_simple(depsgraph, &outer, &ops, &rels);
+  size_t mem_orig, mem_eval, mem_shared;
+  DEG_stats_memory(depsgraph, &mem_orig, &mem_eval, &mem_shared);
   BLI_snprintf(result,
                STATS_MAX_SIZE,
-               "Approx %zu Operations, %zu Relations, %zu Outer Nodes",
+               "Approx %zu Operations, %zu Relations, %zu Outer Nodes, "
+               "%zu MB Original Data, %zu MB Evaluated Data (%zu MB Shared)",
                ops,
                rels,
-               outer);
+               outer,
+               mem_orig >> 20,
+               mem_eval >> 20,
+               mem_shared >> 20);
 }
 
 static void rna_Depsgraph_update(Depsgraph *depsgraph, Main *bmain, ReportList *reports)
@@ -716,6 +737,17 @@ static void rna_def_depsgraph(BlenderRNA *brna)
                                   "File name where gnuplot script will save the result");
   RNA_def_parameter_flags(parm, PropertyFlag(0), PARM_REQUIRED);
 
+  func = RNA_def_function(srna, "debug_trace_begin", "rna_Depsgraph_debug_trace_begin");
+  RNA_def_function_ui_description(
+      func, "Start recording evaluation times of operations and modifiers of the dependency graph");
+
+  func = RNA_def_function(srna, "debug_trace_end", "rna_Depsgraph_debug_trace_end");
+  RNA_def_function_ui_description(
+      func, "Stop recording evaluation times and write them as a Chrome trace JSON file");
+  parm = RNA_def_string_file_path(
+      func, "filepath", nullptr, FILE_MAX, "File Name", "Output path for the trace file");
+  RNA_def_parameter_flags(parm, PropertyFlag(0), PARM_REQUIRED);
+
   func = RNA_def_function(srna, "debug_tag_update", "rna_Depsgraph_debug_tag_update");
 
   func = RNA_def_function(srna, "debug_stats", "rna_Depsgraph_debug_stats");
@@ -114,6 +114,11 @@ static const EnumPropertyItem rna_enum_precision_items[] = {
      "Auto",
      "Full precision for final renders, half precision otherwise"},
     {NODE_TREE_COMPOSITOR_PRECISION_FULL, "FULL", 0, "Full", "Full precision"},
+    {NODE_TREE_COMPOSITOR_PRECISION_HALF,
+     "HALF",
+     0,
+     "Half",
+     "Half precision, reducing the memory used by intermediate results"},
     {0, nullptr, 0, nullptr, nullptr},
 };
 
@@ -3616,6 +3616,16 @@ static void rna_def_object(BlenderRNA *brna)
   RNA_def_property_clear_flag(prop, PROP_ANIMATABLE);
   RNA_def_property_update(prop, NC_OBJECT | ND_DRAW, nullptr);
 
+  prop = RNA_def_property(srna, "use_playback_cache", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, nullptr, "flag", OB_FLAG_USE_PLAYBACK_CACHE);
+  RNA_def_property_ui_text(prop,
+                           "Use Playback Cache",
+                           "Keep the evaluated mesh of every played frame in memory, so that "
+                           "scrubbing over these frames again does not evaluate the modifiers. "
+                           "The cache is cleared when the object or its dependencies are edited");
+  RNA_def_property_clear_flag(prop, PROP_ANIMATABLE);
+  RNA_def_property_update(prop, NC_OBJECT | ND_DRAW, "rna_Object_internal_update_data_dependency");
+
   rna_def_object_visibility(srna);
 
   /* instancing */
@@ -5981,6 +5981,13 @@ static void rna_def_userdef_system(BlenderRNA *brna)
   RNA_def_property_enum_sdna(prop, nullptr, "sequencer_proxy_setup");
   RNA_def_property_ui_text(prop, "Proxy Setup", "When and how proxies are created");
 
+  prop = RNA_def_property(srna, "use_sequencer_hardware_decoding", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, nullptr, "sequencer_decode_flag", USER_SEQ_DECODE_HARDWARE);
+  RNA_def_property_ui_text(prop,
+                           "Hardware Decoding",
+                           "Decode movie strips on the GPU when supported, falling back to the "
+                           "CPU otherwise (takes effect for movies loaded afterwards)");
+
   prop = RNA_def_property(srna, "scrollback", PROP_INT, PROP_UNSIGNED);
   RNA_def_property_int_sdna(prop, nullptr, "scrollback");
   RNA_def_property_range(prop, 32, 32768);
@@ -21,6 +21,7 @@
 #include "BLI_path_util.h"
 #include "BLI_set.hh"
 #include "BLI_string.h"
+#include "BLI_trace.hh"
 #include "BLI_utildefines.h"
 
 #include "DNA_array_utils.hh"
@@ -1633,6 +1634,8 @@ static void modifyGeometry(ModifierData *md,
                            bke::GeometrySet &geometry_set)
 {
   using namespace blender;
+  MEM_TagScope mem_tag_scope(MEM_TAG_GEOMETRY_NODES);
+  TRACE_SCOPE("GeometryNodes::modifier");
   NodesModifierData *nmd = reinterpret_cast<NodesModifierData *>(md);
   if (nmd->node_group == nullptr) {
     return;
@@ -2,11 +2,17 @@
  *
  * SPDX-License-Identifier: GPL-2.0-or-later */
 
+#include "BLI_hash.hh"
+#include "BLI_implicit_sharing.hh"
+#include "BLI_memory_cache.hh"
+#include "BLI_struct_equality_utils.hh"
 #include "BLI_task.hh"
 
 #include "DNA_modifier_types.h"
 
 #include "BKE_attribute.hh"
+#include "BKE_customdata.hh"
+#include "BKE_deform.hh"
 #include "BKE_lib_id.hh"
 #include "BKE_mesh.hh"
 #include "BKE_subdiv.hh"
@@ -165,6 +171,198 @@ static Mesh *mesh_subsurf_calc(const Mesh *mesh,
   return result;
 }
 
+/**
+ * Identifies the result of subdividing a mesh with constant creases. The mesh data is identified
+ * by the implicit sharing info and version of each attribute array, so that unchanged data is
+ * detected without comparing its contents.
+ */
+class SubdivisionKey : public memory_cache::GenericKey {
+ public:
+  struct Layer {
+    std::string name;
+    int type;
+    const ImplicitSharingInfo *sharing_info;
+    int64_t version;
+
+    BLI_STRUCT_EQUALITY_OPERATORS_4(Layer, name, type, sharing_info, version)
+  };
+
+  Vector<Layer> layers;
+  int verts_num;
+  int edges_num;
+  int faces_num;
+  int corners_num;
+  int level;
+  int boundary_smooth;
+  int uv_smooth;
+  float vert_crease;
+  float edge_crease;
+  /** Stored keys keep the sharing infos alive, so that they can't be reused for other data. */
+  bool owns_weak_users = false;
+
+  ~SubdivisionKey() override
+  {
+    if (owns_weak_users) {
+      for (const Layer &layer : layers) {
+        layer.sharing_info->remove_weak_user_and_delete_if_last();
+      }
+    }
+  }
+
+  uint64_t hash() const override
+  {
+    uint64_t hash = get_default_hash(verts_num, edges_num, faces_num, corners_num);
+    hash = get_default_hash(hash, level);
+    for (const Layer &layer : layers) {
+      hash = get_default_hash(hash, layer.sharing_info, layer.version);
+    }
+    return hash;
+  }
+
+  bool equal_to(const GenericKey &other) const override
+  {
+    const SubdivisionKey &b = static_cast<const SubdivisionKey &>(other);
+    return layers == b.layers && verts_num == b.verts_num && edges_num == b.edges_num &&
+           faces_num == b.faces_num && corners_num == b.corners_num && level == b.level &&
+           boundary_smooth == b.boundary_smooth && uv_smooth == b.uv_smooth &&
+           vert_crease == b.vert_crease && edge_crease == b.edge_crease;
+  }
+
+  std::unique_ptr<GenericKey> to_storable() const override
+  {
+    std::unique_ptr<SubdivisionKey> key = std::make_unique<SubdivisionKey>(*this);
+    for (const Layer &layer : key->layers) {
+      layer.sharing_info->add_weak_user();
+    }
+    key->owns_weak_users = true;
+    return key;
+  }
+};
+
+/* Returns false when some mesh data is not implicitly shared, and can't be identified. */
+static bool add_customdata_layer_keys(const CustomData &data,
+                                      Vector<SubdivisionKey::Layer> &r_layers)
+{
+  for (const CustomDataLayer &layer : Span(data.layers, data.totlayer)) {
+    if (layer.sharing_info == nullptr) {
+      return false;
+    }
+    r_layers.append({layer.name, layer.type, layer.sharing_info, layer.sharing_info->version()});
+  }
+  return true;
+}
+
+static std::optional<SubdivisionKey> subdivision_key_for_mesh(const Mesh &mesh,
+                                                              const int level,
+                                                              const float vert_crease,
+                                                              const float edge_crease,
+                                                              const int boundary_smooth,
+                                                              const int uv_smooth)
+{
+  SubdivisionKey key;
+  for (const CustomData *data :
+       {&mesh.vert_data, &mesh.edge_data, &mesh.face_data, &mesh.corner_data})
+  {
+    if (!add_customdata_layer_keys(*data, key.layers)) {
+      return std::nullopt;
+    }
+  }
+  if (const ImplicitSharingInfo *sharing_info = mesh.runtime->face_offsets_sharing_info) {
+    key.layers.append({"", -1, sharing_info, sharing_info->version()});
+  }
+  else if (mesh.faces_num > 0) {
+    return std::nullopt;
+  }
+  key.verts_num = mesh.verts_num;
+  key.edges_num = mesh.edges_num;
+  key.faces_num = mesh.faces_num;
+  key.corners_num = mesh.corners_num;
+  key.level = level;
+  key.boundary_smooth = boundary_smooth;
+  key.uv_smooth = uv_smooth;
+  key.vert_crease = vert_crease;
+  key.edge_crease = edge_crease;
+  return key;
+}
+
+class CachedMesh : public memory_cache::CachedValue {
+ public:
+  Mesh *mesh;
+
+  CachedMesh(Mesh *mesh) : mesh(mesh) {}
+
+  ~CachedMesh() override
+  {
+    BKE_id_free(nullptr, mesh);
+  }
+
+  int64_t size_in_bytes() const override
+  {
+    int64_t size = sizeof(int) * (mesh->faces_num + 1);
+    const std::pair<const CustomData *, int> domains[] = {{&mesh->vert_data, mesh->verts_num},
+                                                          {&mesh->edge_data, mesh->edges_num},
+                                                          {&mesh->face_data, mesh->faces_num},
+                                                          {&mesh->corner_data, mesh->corners_num}};
+    for (const auto &[data, size_num] : domains) {
+      for (const CustomDataLayer &layer : Span(data->layers, data->totlayer)) {
+        size += int64_t(CustomData_sizeof(eCustomDataType(layer.type))) * size_num;
+      }
+    }
+    return size;
+  }
+};
+
+/**
+ * Subdivision is often used on inputs that don't change between evaluations, for example when
+ * only nodes after it are edited. Reuse the result in that case, which is possible when the
+ * creases are constant and the whole input mesh can be identified.
+ */
+static Mesh *mesh_subsurf_calc_cached(const Mesh *mesh,
+                                      const int level,
+                                      const Field<float> &vert_crease_field,
+                                      const Field<float> &edge_crease_field,
+                                      const int boundary_smooth,
+                                      const int uv_smooth)
+{
+  std::optional<SubdivisionKey> key;
+  if (!vert_crease_field.node().depends_on_input() &&
+      !edge_crease_field.node().depends_on_input())
+  {
+    key = subdivision_key_for_mesh(*mesh,
+                                   level,
+                                   fn::evaluate_constant_field(vert_crease_field),
+                                   fn::evaluate_constant_field(edge_crease_field),
+                                   boundary_smooth,
+                                   uv_smooth);
+  }
+  if (!key) {
+    return mesh_subsurf_calc(
+        mesh, level, vert_crease_field, edge_crease_field, boundary_smooth, uv_smooth);
+  }
+  std::shared_ptr<const CachedMesh> cached = memory_cache::get<CachedMesh>(
+      *key, [&]() -> std::unique_ptr<CachedMesh> {
+        Mesh *result = mesh_subsurf_calc(
+            mesh, level, vert_crease_field, edge_crease_field, boundary_smooth, uv_smooth);
+        if (result == nullptr) {
+          return nullptr;
+        }
+        return std::make_unique<CachedMesh>(result);
+      });
+  if (!cached) {
+    return nullptr;
+  }
+  /* Arrays are shared with the cached mesh, while the other data of the input mesh which is not
+   * part of the key is copied from the input mesh, as if the result was computed again. */
+  Mesh *result = BKE_mesh_copy_for_eval(cached->mesh);
+  BKE_mesh_copy_parameters(result, mesh);
+  BLI_freelistN(&result->vertex_group_names);
+  BKE_defgroup_copy_list(&result->vertex_group_names, &mesh->vertex_group_names);
+  MEM_SAFE_FREE(result->mat);
+  result->mat = static_cast<Material **>(MEM_dupallocN(mesh->mat));
+  result->totcol = mesh->totcol;
+  return result;
+}
+
 #endif
 
 static void node_geo_exec(GeoNodeExecParams params)
@@ -186,7 +384,8 @@ static void node_geo_exec(GeoNodeExecParams params)
   geometry_set.modify_geometry_sets([&](GeometrySet &geometry_set) {
     if (const Mesh *mesh = geometry_set.get_mesh()) {
       geometry_set.replace_mesh(
-          mesh_subsurf_calc(mesh, level, vert_crease, edge_crease, boundary_smooth, uv_smooth));
+          mesh_subsurf_calc_cached(
+              mesh, level, vert_crease, edge_crease, boundary_smooth, uv_smooth));
     }
   });
 #else
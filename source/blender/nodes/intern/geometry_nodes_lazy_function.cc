@@ -1481,11 +1481,33 @@ struct ZoneBodyFunction {
   ZoneFunctionIndices indices;
 };
 
+/**
+ * Execute the body of a repeat zone with the correct #ComputeContext for the given iteration.
+ * This is necessary to support correct logging inside of a repeat zone.
+ */
+static void execute_repeat_body(const LazyFunction &body_fn,
+                                lf::Params &params,
+                                const lf::Context &context,
+                                const bNode &repeat_output_bnode,
+                                const int iteration)
+{
+  GeoNodesLFUserData &user_data = *static_cast<GeoNodesLFUserData *>(context.user_data);
+  bke::RepeatZoneComputeContext body_compute_context{
+      user_data.compute_context, repeat_output_bnode, iteration};
+  GeoNodesLFUserData body_user_data = user_data;
+  body_user_data.compute_context = &body_compute_context;
+  body_user_data.log_socket_values = should_log_socket_values_for_context(
+      user_data, body_compute_context.hash());
+
+  GeoNodesLFLocalUserData body_local_user_data{body_user_data};
+  lf::Context body_context{context.storage, &body_user_data, &body_local_user_data};
+  body_fn.execute(params, body_context);
+}
+
 /**
  * Wraps the execution of a repeat loop body. The purpose is to setup the correct #ComputeContext
- * inside of the loop body. This is necessary to support correct logging inside of a repeat zone.
- * An alternative would be to use a separate `LazyFunction` for every iteration, but that would
- * have higher overhead.
+ * inside of the loop body. An alternative would be to use a separate `LazyFunction` for every
+ * iteration, but that would have higher overhead.
  */
 class RepeatBodyNodeExecuteWrapper : public lf::GraphExecutorNodeExecuteWrapper {
  public:
@@ -1496,7 +1518,6 @@ class RepeatBodyNodeExecuteWrapper : public lf::GraphExecutorNodeExecuteWrapper
                     lf::Params &params,
                     const lf::Context &context) const
   {
-    GeoNodesLFUserData &user_data = *static_cast<GeoNodesLFUserData *>(context.user_data);
     const int iteration = lf_body_nodes_->index_of_try(const_cast<lf::FunctionNode *>(&node));
     const LazyFunction &fn = node.function();
     if (iteration == -1) {
@@ -1504,18 +1525,7 @@ class RepeatBodyNodeExecuteWrapper : public lf::GraphExecutorNodeExecuteWrapper
       fn.execute(params, context);
       return;
     }
-
-    /* Setup context for the loop body evaluation. */
-    bke::RepeatZoneComputeContext body_compute_context{
-        user_data.compute_context, *repeat_output_bnode_, iteration};
-    GeoNodesLFUserData body_user_data = user_data;
-    body_user_data.compute_context = &body_compute_context;
-    body_user_data.log_socket_values = should_log_socket_values_for_context(
-        user_data, body_compute_context.hash());
-
-    GeoNodesLFLocalUserData body_local_user_data{body_user_data};
-    lf::Context body_context{context.storage, &body_user_data, &body_local_user_data};
-    fn.execute(params, body_context);
+    execute_repeat_body(fn, params, context, *repeat_output_bnode_, iteration);
   }
 };
 
@@ -1566,6 +1576,14 @@ struct RepeatEvalStorage {
 
 class LazyFunctionForRepeatZone : public LazyFunction {
  private:
+  /**
+   * Loops with at least this many iterations are evaluated by calling the body function in a
+   * simple loop instead of building a lazy-function graph that contains the body for every
+   * iteration. That avoids the overhead of building and scheduling the large graph, at the cost
+   * of computing all inputs of the zone, even if the body does not use them.
+   */
+  static constexpr int eager_evaluation_min_iterations = 32;
+
   const bNodeTreeZone &zone_;
   const bNode &repeat_output_bnode_;
   const ZoneBuildInfo &zone_info_;
@@ -1660,6 +1678,12 @@ class LazyFunctionForRepeatZone : public LazyFunction {
     }
 
     if (!eval_storage.graph_executor) {
+      const int iterations =
+          params.get_input<SocketValueVariant>(zone_info_.indices.inputs.main[0]).get<int>();
+      if (iterations >= eager_evaluation_min_iterations) {
+        this->execute_eagerly(params, node_storage, user_data, local_user_data, iterations);
+        return;
+      }
       /* Create the execution graph in the first evaluation. */
       this->initialize_execution_graph(
           params, eval_storage, node_storage, user_data, local_user_data);
@@ -1676,6 +1700,170 @@ class LazyFunctionForRepeatZone : public LazyFunction {
     eval_storage.graph_executor->execute(eval_graph_params, eval_graph_context);
   }
 
+  void warn_if_inspection_index_is_out_of_range(const NodeGeometryRepeatOutput &node_storage,
+                                                const int iterations,
+                                                GeoNodesLFUserData &user_data,
+                                                GeoNodesLFLocalUserData &local_user_data) const
+  {
+    if (node_storage.inspection_index > 0) {
+      if (node_storage.inspection_index >= iterations) {
+        if (geo_eval_log::GeoTreeLogger *tree_logger = local_user_data.try_get_tree_logger(
+                user_data))
+        {
+          tree_logger->node_warnings.append(
+              *tree_logger->allocator,
+              {repeat_output_bnode_.identifier,
+               {NodeWarningType::Info, N_("Inspection index is out of range")}});
+        }
+      }
+    }
+  }
+
+  /**
+   * Evaluate the loop by executing the body function once per iteration. All inputs are requested
+   * first, and the main values are moved from one iteration to the next, so that data which is
+   * owned by a single iteration can be modified in place.
+   */
+  void execute_eagerly(lf::Params &params,
+                       const NodeGeometryRepeatOutput &node_storage,
+                       GeoNodesLFUserData &user_data,
+                       GeoNodesLFLocalUserData &local_user_data,
+                       const int iterations) const
+  {
+    const ZoneFunctionIndices &indices = zone_info_.indices;
+    const ZoneFunctionIndices &body_indices = body_fn_.indices;
+    const LazyFunction &body_fn = *body_fn_.function;
+    const int num_repeat_items = body_indices.inputs.main.size();
+    /* Take iterations input into account. */
+    const int main_inputs_offset = 1;
+
+    /* All inputs are used, because every iteration is evaluated. */
+    for (const int i : indices.outputs.input_usages.index_range().drop_front(1)) {
+      if (!params.output_was_set(indices.outputs.input_usages[i])) {
+        params.set_output(indices.outputs.input_usages[i], true);
+      }
+    }
+    for (const int output_index : indices.outputs.border_link_usages) {
+      if (!params.output_was_set(output_index)) {
+        params.set_output(output_index, true);
+      }
+    }
+
+    bool all_inputs_available = true;
+    const auto request_input = [&](const int index) {
+      if (params.try_get_input_data_ptr_or_request(index) == nullptr) {
+        all_inputs_available = false;
+      }
+    };
+    for (const int index : indices.inputs.main.as_span().drop_front(main_inputs_offset)) {
+      request_input(index);
+    }
+    for (const int index : indices.inputs.border_links) {
+      request_input(index);
+    }
+    for (const int index : indices.inputs.attributes_by_field_source_index.values()) {
+      request_input(index);
+    }
+    for (const int index : indices.inputs.attributes_by_caller_propagation_index.values()) {
+      request_input(index);
+    }
+    if (!all_inputs_available) {
+      /* Wait for inputs to be computed. */
+      return;
+    }
+    this->warn_if_inspection_index_is_out_of_range(
+        node_storage, iterations, user_data, local_user_data);
+
+    /* Buffers for the values passed into and out of the body function. They are reused for every
+     * iteration. */
+    LinearAllocator<> allocator;
+    Array<GMutablePointer> body_inputs(body_fn.inputs().size());
+    Array<GMutablePointer> body_outputs(body_fn.outputs().size());
+    for (const int i : body_inputs.index_range()) {
+      const CPPType &type = *body_fn.inputs()[i].type;
+      body_inputs[i] = {type, allocator.allocate(type.size(), type.alignment())};
+    }
+    for (const int i : body_outputs.index_range()) {
+      const CPPType &type = *body_fn.outputs()[i].type;
+      body_outputs[i] = {type, allocator.allocate(type.size(), type.alignment())};
+    }
+    Array<std::optional<lf::ValueUsage>> body_input_usages(body_inputs.size());
+    Array<lf::ValueUsage> body_output_usages(body_outputs.size(), lf::ValueUsage::Used);
+    Array<bool> body_set_outputs(body_outputs.size());
+
+    const auto copy_zone_input = [&](const int zone_index, const int body_index) {
+      const GMutablePointer body_input = body_inputs[body_index];
+      body_input.type()->copy_construct(params.try_get_input_data_ptr(zone_index),
+                                        body_input.get());
+    };
+
+    for (const int iteration : IndexRange(iterations)) {
+      for (const int i : IndexRange(num_repeat_items)) {
+        const GMutablePointer body_input = body_inputs[body_indices.inputs.main[i]];
+        if (iteration == 0) {
+          body_input.type()->move_construct(
+              params.try_get_input_data_ptr(indices.inputs.main[i + main_inputs_offset]),
+              body_input.get());
+        }
+        else {
+          /* Move the value from the previous iteration, so that it is not shared unnecessarily. */
+          GMutablePointer prev_output = body_outputs[body_indices.outputs.main[i]];
+          body_input.type()->move_construct(prev_output.get(), body_input.get());
+          prev_output.destruct();
+        }
+        *static_cast<bool *>(body_inputs[body_indices.inputs.output_usages[i]].get()) = true;
+      }
+      for (const int i : indices.inputs.border_links.index_range()) {
+        copy_zone_input(indices.inputs.border_links[i], body_indices.inputs.border_links[i]);
+      }
+      for (const auto item : body_indices.inputs.attributes_by_field_source_index.items()) {
+        copy_zone_input(indices.inputs.attributes_by_field_source_index.lookup(item.key),
+                        item.value);
+      }
+      for (const auto item : body_indices.inputs.attributes_by_caller_propagation_index.items()) {
+        copy_zone_input(indices.inputs.attributes_by_caller_propagation_index.lookup(item.key),
+                        item.value);
+      }
+
+      body_input_usages.fill(std::nullopt);
+      body_set_outputs.fill(false);
+      lf::BasicParams body_params{body_fn,
+                                  body_inputs,
+                                  body_outputs,
+                                  body_input_usages,
+                                  body_output_usages,
+                                  body_set_outputs};
+      AlignedBuffer<1024, 8> iteration_buffer;
+      LinearAllocator<> iteration_allocator;
+      iteration_allocator.provide_buffer(iteration_buffer);
+      void *body_storage = body_fn.init_storage(iteration_allocator);
+      const lf::Context body_context{body_storage, &user_data, &local_user_data};
+      execute_repeat_body(body_fn, body_params, body_context, repeat_output_bnode_, iteration);
+      body_fn.destruct_storage(body_storage);
+      BLI_assert(!body_set_outputs.as_span().contains(false));
+
+      /* The body may have moved values out of its inputs, but they are still owned by the caller.
+       * All outputs except the main values are not needed anymore. */
+      for (GMutablePointer &body_input : body_inputs) {
+        body_input.destruct();
+      }
+      for (const int i : body_outputs.index_range()) {
+        if (!body_indices.outputs.main.contains(i)) {
+          body_outputs[i].destruct();
+        }
+      }
+    }
+
+    for (const int i : IndexRange(num_repeat_items)) {
+      const int output_index = indices.outputs.main[i];
+      GMutablePointer body_output = body_outputs[body_indices.outputs.main[i]];
+      body_output.type()->move_construct(body_output.get(),
+                                         params.get_output_data_ptr(output_index));
+      body_output.destruct();
+      params.output_set(output_index);
+    }
+  }
+
   /**
    * Generate a lazy-function graph that contains the loop body (`body_fn_`) as many times
    * as there are iterations. Since this graph depends on the number of iterations, it can't be
@@ -1697,19 +1885,8 @@ class LazyFunctionForRepeatZone : public LazyFunction {
     const int iterations = std::max<int>(
         0, params.get_input<SocketValueVariant>(zone_info_.indices.inputs.main[0]).get<int>());
 
-    /* Show a warning when the inspection index is out of range. */
-    if (node_storage.inspection_index > 0) {
-      if (node_storage.inspection_index >= iterations) {
-        if (geo_eval_log::GeoTreeLogger *tree_logger = local_user_data.try_get_tree_logger(
-                user_data))
-        {
-          tree_logger->node_warnings.append(
-              *tree_logger->allocator,
-              {repeat_output_bnode_.identifier,
-               {NodeWarningType::Info, N_("Inspection index is out of range")}});
-        }
-      }
-    }
+    this->warn_if_inspection_index_is_out_of_range(
+        node_storage, iterations, user_data, local_user_data);
 
     /* Take iterations input into account. */
     const int main_inputs_offset = 1;
@@ -271,20 +271,6 @@ class NoiseFunction : public mf::MultiFunction {
     switch (dimensions_) {
       case 1: {
         const VArray<float> &w = params.readonly_single_input<float>(0, "W");
-        if (compute_factor) {
-          mask.foreach_index([&](const int64_t i) {
-            const float position = w[i] * scale[i];
-            r_factor[i] = noise::perlin_fractal_distorted(position,
-                                                          math::clamp(detail[i], 0.0f, 15.0f),
-                                                          math::max(roughness[i], 0.0f),
-                                                          lacunarity[i],
-                                                          offset[i],
-                                                          gain[i],
-                                                          distortion[i],
-                                                          type_,
-                                                          normalize_);
-          });
-        }
         if (compute_color) {
           mask.foreach_index([&](const int64_t i) {
             const float position = w[i] * scale[i];
@@ -299,15 +285,15 @@ class NoiseFunction : public mf::MultiFunction {
                 type_,
                 normalize_);
             r_color[i] = ColorGeometry4f(c[0], c[1], c[2], 1.0f);
+            if (compute_factor) {
+              /* The first channel of the color is the same as the factor. */
+              r_factor[i] = c[0];
+            }
           });
         }
-        break;
-      }
-      case 2: {
-        const VArray<float3> &vector = params.readonly_single_input<float3>(0, "Vector");
-        if (compute_factor) {
+        else if (compute_factor) {
           mask.foreach_index([&](const int64_t i) {
-            const float2 position = float2(vector[i] * scale[i]);
+            const float position = w[i] * scale[i];
             r_factor[i] = noise::perlin_fractal_distorted(position,
                                                           math::clamp(detail[i], 0.0f, 15.0f),
                                                           math::max(roughness[i], 0.0f),
@@ -319,6 +305,10 @@ class NoiseFunction : public mf::MultiFunction {
                                                           normalize_);
           });
         }
+        break;
+      }
+      case 2: {
+        const VArray<float3> &vector = params.readonly_single_input<float3>(0, "Vector");
         if (compute_color) {
           mask.foreach_index([&](const int64_t i) {
             const float2 position = float2(vector[i] * scale[i]);
@@ -333,15 +323,15 @@ class NoiseFunction : public mf::MultiFunction {
                 type_,
                 normalize_);
             r_color[i] = ColorGeometry4f(c[0], c[1], c[2], 1.0f);
+            if (compute_factor) {
+              /* The first channel of the color is the same as the factor. */
+              r_factor[i] = c[0];
+            }
           });
         }
-        break;
-      }
-      case 3: {
-        const VArray<float3> &vector = params.readonly_single_input<float3>(0, "Vector");
-        if (compute_factor) {
+        else if (compute_factor) {
           mask.foreach_index([&](const int64_t i) {
-            const float3 position = vector[i] * scale[i];
+            const float2 position = float2(vector[i] * scale[i]);
             r_factor[i] = noise::perlin_fractal_distorted(position,
                                                           math::clamp(detail[i], 0.0f, 15.0f),
                                                           math::max(roughness[i], 0.0f),
@@ -353,6 +343,10 @@ class NoiseFunction : public mf::MultiFunction {
                                                           normalize_);
           });
         }
+        break;
+      }
+      case 3: {
+        const VArray<float3> &vector = params.readonly_single_input<float3>(0, "Vector");
         if (compute_color) {
           mask.foreach_index([&](const int64_t i) {
             const float3 position = vector[i] * scale[i];
@@ -367,19 +361,15 @@ class NoiseFunction : public mf::MultiFunction {
                 type_,
                 normalize_);
             r_color[i] = ColorGeometry4f(c[0], c[1], c[2], 1.0f);
+            if (compute_factor) {
+              /* The first channel of the color is the same as the factor. */
+              r_factor[i] = c[0];
+            }
           });
         }
-        break;
-      }
-      case 4: {
-        const VArray<float3> &vector = params.readonly_single_input<float3>(0, "Vector");
-        const VArray<float> &w = params.readonly_single_input<float>(1, "W");
-        if (compute_factor) {
+        else if (compute_factor) {
           mask.foreach_index([&](const int64_t i) {
-            const float3 position_vector = vector[i] * scale[i];
-            const float position_w = w[i] * scale[i];
-            const float4 position{
-                position_vector[0], position_vector[1], position_vector[2], position_w};
+            const float3 position = vector[i] * scale[i];
             r_factor[i] = noise::perlin_fractal_distorted(position,
                                                           math::clamp(detail[i], 0.0f, 15.0f),
                                                           math::max(roughness[i], 0.0f),
@@ -391,6 +381,11 @@ class NoiseFunction : public mf::MultiFunction {
                                                           normalize_);
           });
         }
+        break;
+      }
+      case 4: {
+        const VArray<float3> &vector = params.readonly_single_input<float3>(0, "Vector");
+        const VArray<float> &w = params.readonly_single_input<float>(1, "W");
         if (compute_color) {
           mask.foreach_index([&](const int64_t i) {
             const float3 position_vector = vector[i] * scale[i];
@@ -408,6 +403,27 @@ class NoiseFunction : public mf::MultiFunction {
                 type_,
                 normalize_);
             r_color[i] = ColorGeometry4f(c[0], c[1], c[2], 1.0f);
+            if (compute_factor) {
+              /* The first channel of the color is the same as the factor. */
+              r_factor[i] = c[0];
+            }
+          });
+        }
+        else if (compute_factor) {
+          mask.foreach_index([&](const int64_t i) {
+            const float3 position_vector = vector[i] * scale[i];
+            const float position_w = w[i] * scale[i];
+            const float4 position{
+                position_vector[0], position_vector[1], position_vector[2], position_w};
+            r_factor[i] = noise::perlin_fractal_distorted(position,
+                                                          math::clamp(detail[i], 0.0f, 15.0f),
+                                                          math::max(roughness[i], 0.0f),
+                                                          lacunarity[i],
+                                                          offset[i],
+                                                          gain[i],
+                                                          distortion[i],
+                                                          type_,
+                                                          normalize_);
           });
         }
         break;
@@ -579,12 +579,36 @@ static PyObject *bpy_app_help_text(PyObject * /*self*/, PyObject *args, PyObject
   return result;
 }
 
+PyDoc_STRVAR(
+    /* Wrap. */
+    bpy_app_memory_usage_by_tag_doc,
+    ".. staticmethod:: memory_usage_by_tag()\n"
+    "\n"
+    "   Return the memory currently in use, in bytes, by the subsystem that allocated it.\n"
+    "\n"
+    "   :return: Dictionary of subsystem names and their memory usage.\n"
+    "   :rtype: dict[str, int]\n");
+static PyObject *bpy_app_memory_usage_by_tag(PyObject * /*self*/)
+{
+  PyObject *result = PyDict_New();
+  for (int tag = 0; tag < MEM_TAG_NUM; tag++) {
+    PyObject *value = PyLong_FromSize_t(MEM_get_memory_in_use_for_tag(eMEM_Tag(tag)));
+    PyDict_SetItemString(result, MEM_tag_name(eMEM_Tag(tag)), value);
+    Py_DECREF(value);
+  }
+  return result;
+}
+
 #if (defined(__GNUC__) && !defined(__clang__))
 #  pragma GCC diagnostic push
 #  pragma GCC diagnostic ignored "-Wcast-function-type"
 #endif
 
 static PyMethodDef bpy_app_methods[] = {
+    {"memory_usage_by_tag",
+     (PyCFunction)bpy_app_memory_usage_by_tag,
+     METH_NOARGS | METH_STATIC,
+     bpy_app_memory_usage_by_tag_doc},
     {"is_job_running",
      (PyCFunction)bpy_app_is_job_running,
      METH_VARARGS | METH_KEYWORDS | METH_STATIC,
@@ -12,12 +12,14 @@
 
 #include "BLI_utildefines.h"
 #include <Python.h>
+#include <string>
 
 #include "BKE_callbacks.hh"
 
 #include "RNA_access.hh"
 
 #include "bpy_app_handlers.h"
+#include "bpy_capi_utils.h"
 #include "bpy_rna.h"
 
 #include "../generic/python_utildefines.h"
@@ -390,7 +392,13 @@ void bpy_app_generic_callback(Main * /*main*/,
     for (pos = 0; pos < PyList_GET_SIZE(cb_list); pos++) {
       func = PyList_GET_ITEM(cb_list, pos);
       PyObject *args = choose_arguments(func, args_all, args_single);
+      const double time_begin = BPy_callback_timer_begin();
       ret = PyObject_Call(func, args, nullptr);
+      if (time_begin != 0.0) {
+        const std::string caller = std::string("bpy.app.handlers.") +
+                                   app_cb_info_fields[POINTER_AS_INT(arg)].name;
+        BPy_callback_timer_end(time_begin, caller.c_str(), func);
+      }
       if (ret == nullptr) {
         /* Don't set last system variables because they might cause some
          * dangling pointers to external render engines (when exception
@@ -12,12 +12,14 @@
 #include <Python.h>
 
 #include "BLI_listbase.h"
+#include "BLI_time.h"
 #include "BLI_utildefines.h"
 
 #include "bpy_capi_utils.h"
 
 #include "MEM_guardedalloc.h"
 
+#include "BKE_global.hh"
 #include "BKE_report.hh"
 
 #include "../generic/py_capi_utils.h"
@@ -120,6 +122,49 @@ bool BPy_errors_to_report_ex(ReportList *reports,
   return true;
 }
 
+/** Callbacks taking longer than this are reported, roughly a frame at 60 FPS. */
+#define BPY_CALLBACK_SLOW_SECONDS 0.016
+
+double BPy_callback_timer_begin()
+{
+  return (G.debug & G_DEBUG_PYTHON) ? BLI_time_now_seconds() : 0.0;
+}
+
+void BPy_callback_timer_end(const double time_begin, const char *caller, PyObject *callable)
+{
+  if (time_begin == 0.0) {
+    return;
+  }
+  const double time = BLI_time_now_seconds() - time_begin;
+  if (time < BPY_CALLBACK_SLOW_SECONDS) {
+    return;
+  }
+
+  /* Don't let a failing attribute lookup hide or replace an exception raised by the callback. */
+  PyObject *error_type, *error_value, *error_traceback;
+  PyErr_Fetch(&error_type, &error_value, &error_traceback);
+
+  PyObject *module = PyObject_GetAttrString(callable, "__module__");
+  PyObject *qualname = PyObject_GetAttrString(callable, "__qualname__");
+  PyErr_Clear();
+
+  const char *module_str = (module && PyUnicode_Check(module)) ? PyUnicode_AsUTF8(module) :
+                                                                 "<unknown>";
+  const char *qualname_str = (qualname && PyUnicode_Check(qualname)) ?
+                                 PyUnicode_AsUTF8(qualname) :
+                                 "<unknown>";
+  PySys_WriteStdout("Python: slow callback in %s: %s.%s took %.2f ms\n",
+                    caller,
+                    module_str,
+                    qualname_str,
+                    time * 1000.0);
+
+  Py_XDECREF(module);
+  Py_XDECREF(qualname);
+
+  PyErr_Restore(error_type, error_value, error_traceback);
+}
+
 bool BPy_errors_to_report(ReportList *reports)
 {
   return BPy_errors_to_report_ex(reports, nullptr, true, true);
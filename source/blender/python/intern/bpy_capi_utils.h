@@ -47,6 +47,19 @@ bool BPy_errors_to_report_ex(struct ReportList *reports,
  */
 bool BPy_errors_to_report(struct ReportList *reports);
 
+/**
+ * Timing of Python callbacks (handlers, draw callbacks and methods of registered classes),
+ * enabled with `--debug-python`. Calls slower than a few milliseconds are printed with the
+ * module and name of the callable, to find the add-ons that cause UI lag.
+ *
+ * \return The start time, or zero when timing is disabled.
+ */
+double BPy_callback_timer_begin(void);
+/**
+ * \param caller: Describes what ran the callback, e.g. `bpy.app.handlers.frame_change_pre`.
+ */
+void BPy_callback_timer_end(double time_begin, const char *caller, PyObject *callable);
+
 struct bContext *BPY_context_get(void);
 
 extern void bpy_context_set(struct bContext *C, PyGILState_STATE *gilstate);
@@ -27,6 +27,7 @@
 #include "BLI_string.h"
 #include "BLI_string_utf8.h"
 #include "BLI_threads.h"
+#include "BLI_trace.hh"
 #include "BLI_utildefines.h"
 
 #include "BLT_translation.hh"
@@ -328,6 +329,8 @@ static void pystatus_exit_on_error(const PyStatus &status)
 
 void BPY_python_start(bContext *C, int argc, const char **argv)
 {
+  TRACE_SCOPE("BPY::python_start");
+
 #ifndef WITH_PYTHON_MODULE
   BLI_assert_msg(Py_IsInitialized() == 0, "Python has already been initialized");
 
@@ -673,6 +676,8 @@ void BPY_DECREF_RNA_INVALIDATE(void *pyob_ptr)
 
 void BPY_modules_load_user(bContext *C)
 {
+  TRACE_SCOPE("BPY::modules_load_user");
+
   PyGILState_STATE gilstate;
   Main *bmain = CTX_data_main(C);
   Text *text;
@@ -5343,10 +5343,17 @@ static bool foreach_attr_type(BPy_PropertyRNA *self,
 
   /* NOTE: this is fail with zero length lists, so don't let this get called in that case. */
   RNA_PROP_BEGIN (&self->ptr, itemptr, self->prop) {
+    PointerRNA propptr = itemptr;
     prop = RNA_struct_find_property(&itemptr, attr);
+    /* Paths relative to the items are supported too, e.g. `data.energy` for objects. */
+    if (prop == nullptr && strpbrk(attr, ".[") &&
+        !RNA_path_resolve_property(&itemptr, attr, &propptr, &prop))
+    {
+      prop = nullptr;
+    }
     if (prop) {
       *r_raw_type = RNA_property_raw_type(prop);
-      *r_attr_tot = RNA_property_array_length(&itemptr, prop);
+      *r_attr_tot = RNA_property_array_length(&propptr, prop);
       *r_attr_signed = (RNA_property_subtype(prop) != PROP_UNSIGNED);
     }
     else {
@@ -5521,6 +5528,43 @@ static bool foreach_compat_buffer(RawPropertyType raw_type, int attr_signed, con
   return false;
 }
 
+/**
+ * The raw type matching the items of a buffer, or #PROP_RAW_UNSET when the format isn't
+ * supported. Used to pass buffers of a different type than the property (a `float64` array for
+ * a float property for example) to RNA directly, instead of converting them item by item.
+ */
+static RawPropertyType foreach_buffer_raw_type(const Py_buffer &buf)
+{
+  const char f = buf.format ? *buf.format : 'B'; /* B is assumed when not set */
+
+  switch (f) {
+    case 'b':
+      return PROP_RAW_INT8;
+    case 'B':
+      return PROP_RAW_UINT8;
+    case 'h':
+      return PROP_RAW_SHORT;
+    case 'H':
+      return PROP_RAW_UINT16;
+    case 'i':
+      return PROP_RAW_INT;
+    case '?':
+      return PROP_RAW_BOOLEAN;
+    case 'f':
+      return PROP_RAW_FLOAT;
+    case 'd':
+      return PROP_RAW_DOUBLE;
+    case 'l':
+    case 'q':
+      return (buf.itemsize == sizeof(int64_t)) ? PROP_RAW_INT64 : PROP_RAW_UNSET;
+    case 'L':
+    case 'Q':
+      return (buf.itemsize == sizeof(uint64_t)) ? PROP_RAW_UINT64 : PROP_RAW_UNSET;
+  }
+
+  return PROP_RAW_UNSET;
+}
+
 static PyObject *foreach_getset(BPy_PropertyRNA *self, PyObject *args, int set)
 {
   PyObject *item = nullptr;
@@ -5572,6 +5616,15 @@ static PyObject *foreach_getset(BPy_PropertyRNA *self, PyObject *args, int set)
           ok = RNA_property_collection_raw_set(
               nullptr, &self->ptr, self->prop, attr, buf.buf, raw_type, tot);
         }
+        else {
+          /* Let RNA convert from the buffer's own type. */
+          const RawPropertyType buf_raw_type = foreach_buffer_raw_type(buf);
+          if (buf_raw_type != PROP_RAW_UNSET && buf.len == Py_ssize_t(tot) * buf.itemsize) {
+            buffer_is_compat = true;
+            ok = RNA_property_collection_raw_set(
+                nullptr, &self->ptr, self->prop, attr, buf.buf, buf_raw_type, tot);
+          }
+        }
 
         PyBuffer_Release(&buf);
       }
@@ -5648,6 +5701,15 @@ static PyObject *foreach_getset(BPy_PropertyRNA *self, PyObject *args, int set)
           ok = RNA_property_collection_raw_get(
               nullptr, &self->ptr, self->prop, attr, buf.buf, raw_type, tot);
         }
+        else if (!buf.readonly) {
+          /* Let RNA convert to the buffer's own type. */
+          const RawPropertyType buf_raw_type = foreach_buffer_raw_type(buf);
+          if (buf_raw_type != PROP_RAW_UNSET && buf.len == Py_ssize_t(tot) * buf.itemsize) {
+            buffer_is_compat = true;
+            ok = RNA_property_collection_raw_get(
+                nullptr, &self->ptr, self->prop, attr, buf.buf, buf_raw_type, tot);
+          }
+        }
 
         PyBuffer_Release(&buf);
       }
@@ -5738,7 +5800,8 @@ PyDoc_STRVAR(
     pyrna_prop_collection_foreach_get_doc,
     ".. method:: foreach_get(attr, seq)\n"
     "\n"
-    "   This is a function to give fast access to attributes within a collection.\n");
+    "   This is a function to give fast access to attributes within a collection.\n"
+    "   The attribute may also be a path relative to the items, e.g. ``data.energy``.\n");
 static PyObject *pyrna_prop_collection_foreach_get(BPy_PropertyRNA *self, PyObject *args)
 {
   PYRNA_PROP_CHECK_OBJ(self);
@@ -5751,7 +5814,8 @@ PyDoc_STRVAR(
     pyrna_prop_collection_foreach_set_doc,
     ".. method:: foreach_set(attr, seq)\n"
     "\n"
-    "   This is a function to give fast access to attributes within a collection.\n");
+    "   This is a function to give fast access to attributes within a collection.\n"
+    "   The attribute may also be a path relative to the items, e.g. ``data.energy``.\n");
 static PyObject *pyrna_prop_collection_foreach_set(BPy_PropertyRNA *self, PyObject *args)
 {
   PYRNA_PROP_CHECK_OBJ(self);
@@ -8808,7 +8872,9 @@ static int bpy_class_call(bContext *C, PointerRNA *ptr, FunctionRNA *func, Param
 #endif
       /* *** Main Caller *** */
 
+      const double time_begin = BPy_callback_timer_begin();
       ret = PyObject_Call(item, args, nullptr);
+      BPy_callback_timer_end(time_begin, RNA_struct_identifier(ptr->type), item);
 
       /* *** Done Calling *** */
 
@@ -53,7 +53,9 @@ static void cb_region_draw(const bContext *C, ARegion * /*region*/, void *custom
 
   cb_func = PyTuple_GET_ITEM((PyObject *)customdata, 1);
   cb_args = PyTuple_GET_ITEM((PyObject *)customdata, 2);
+  const double time_begin = BPy_callback_timer_begin();
   result = PyObject_CallObject(cb_func, cb_args);
+  BPy_callback_timer_end(time_begin, "region draw handler", cb_func);
 
   if (result) {
     Py_DECREF(result);
@@ -98,7 +100,9 @@ static void cb_wm_cursor_draw(bContext *C, int x, int y, void *customdata)
   PyObject *cb_args_with_xy = PyC_Tuple_CopySized(cb_args, cb_args_len + 1);
   PyTuple_SET_ITEM(cb_args_with_xy, cb_args_len, cb_args_xy);
 
+  const double time_begin = BPy_callback_timer_begin();
   result = PyObject_CallObject(cb_func, cb_args_with_xy);
+  BPy_callback_timer_end(time_begin, "cursor draw handler", cb_func);
 
   Py_DECREF(cb_args_with_xy);
 
@@ -35,5 +35,9 @@ void RE_compositor_execute(Render &render,
                            const char *view_name,
                            blender::realtime_compositor::RenderContext *render_context);
 
+/* Check if the render size of the given render data can be allocated as GPU textures, if not, the
+ * CPU compositor should be used instead. */
+bool RE_compositor_is_possible_on_gpu(const RenderData &render_data);
+
 /* Free compositor caches. */
 void RE_compositor_free(Render &render);
@@ -35,6 +35,7 @@
 
 #include "WM_api.hh"
 
+#include "GPU_capabilities.hh"
 #include "GPU_context.hh"
 
 #include "render_types.h"
@@ -333,6 +334,8 @@ class Context : public realtime_compositor::Context {
         }
       case NODE_TREE_COMPOSITOR_PRECISION_FULL:
         return realtime_compositor::ResultPrecision::Full;
+      case NODE_TREE_COMPOSITOR_PRECISION_HALF:
+        return realtime_compositor::ResultPrecision::Half;
     }
 
     BLI_assert_unreachable();
@@ -594,6 +597,18 @@ void RE_compositor_execute(Render &render,
   render.compositor_execute(scene, render_data, node_tree, view_name, render_context);
 }
 
+bool RE_compositor_is_possible_on_gpu(const RenderData &render_data)
+{
+  int width, height;
+  BKE_render_resolution(&render_data, false, &width, &height);
+  const int max_texture_size = GPU_max_texture_size();
+
+  /* There is no way to know if the render size is too large except if we actually allocate a test
+   * texture, which we want to avoid due its cost. So we employ a heuristic that so far has worked
+   * with all known GPU drivers. */
+  return size_t(width) * height <= (size_t(max_texture_size) * max_texture_size) / 4;
+}
+
 void RE_compositor_free(Render &render)
 {
   render.compositor_free();
@@ -83,7 +83,6 @@
 #include "SEQ_relations.hh"
 #include "SEQ_render.hh"
 
-#include "GPU_capabilities.hh"
 #include "GPU_context.hh"
 #include "WM_api.hh"
 #include "wm_window.hh"
@@ -1687,32 +1686,6 @@ static int check_compositor_output(Scene *scene)
   return node_tree_has_any_compositor_output(scene->nodetree);
 }
 
-/* Identify if the compositor can run on the GPU. Currently, this only checks if the compositor is
- * set to GPU and the render size exceeds what can be allocated as a texture in it. */
-static bool is_compositing_possible_on_gpu(Scene *scene, ReportList *reports)
-{
-  /* CPU compositor can always run. */
-  if (!U.experimental.use_full_frame_compositor ||
-      scene->nodetree->execution_mode != NTREE_EXECUTION_MODE_GPU)
-  {
-    return true;
-  }
-
-  int width, height;
-  BKE_render_resolution(&scene->r, false, &width, &height);
-  const int max_texture_size = GPU_max_texture_size();
-
-  /* There is no way to know if the render size is too large except if we actually allocate a test
-   * texture, which we want to avoid due its cost. So we employ a heuristic that so far has worked
-   * with all known GPU drivers. */
-  if (size_t(width) * height > (size_t(max_texture_size) * max_texture_size) / 4) {
-    BKE_report(reports, RPT_ERROR, "Render size too large for GPU, use CPU compositor instead");
-    return false;
-  }
-
-  return true;
-}
-
 bool RE_is_rendering_allowed(Scene *scene,
                              ViewLayer *single_layer,
                              Object *camera_override,
@@ -1747,10 +1720,6 @@ bool RE_is_rendering_allowed(Scene *scene,
       BKE_report(reports, RPT_ERROR, "No render output node in scene");
       return false;
     }
-
-    if (!is_compositing_possible_on_gpu(scene, reports)) {
-      return false;
-    }
   }
   else {
     /* Regular Render */
@@ -2353,6 +2322,7 @@ void RE_RenderAnim(Render *re,
   G.is_rendering = true;
 
   re->flag |= R_ANIMATION;
+  render_result_pass_pool_begin();
   DEG_graph_id_tag_update(re->main, re->pipeline_depsgraph, &re->scene->id, ID_RECALC_AUDIO_MUTE);
 
   scene->r.subframe = 0.0f;
@@ -2543,6 +2513,7 @@ void RE_RenderAnim(Render *re,
                           G.is_break ? BKE_CB_EVT_RENDER_CANCEL : BKE_CB_EVT_RENDER_COMPLETE);
   BKE_sound_reset_scene_specs(re->pipeline_scene_eval);
 
+  render_result_pass_pool_end();
   render_pipeline_free(re);
 
   /* UGLY WARNING */
@@ -10,6 +10,7 @@
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <mutex>
 
 #include "MEM_guardedalloc.h"
 
@@ -21,6 +22,7 @@
 #include "BLI_string_utils.hh"
 #include "BLI_threads.h"
 #include "BLI_utildefines.h"
+#include "BLI_vector.hh"
 
 #include "BKE_appdir.hh"
 #include "BKE_global.hh"
@@ -41,6 +43,80 @@
 #include "render_result.h"
 #include "render_types.h"
 
+/* -------------------------------------------------------------------- */
+/** \name Pass Buffer Pool
+ *
+ * When rendering animations the render result is freed and allocated again for every frame with
+ * the same passes and resolution. Instead of going through the allocator for every pass of every
+ * frame, the float buffers of freed passes are kept and handed out again for passes of the same
+ * size.
+ * \{ */
+
+struct PooledPassBuffer {
+  float *data;
+  size_t size;
+};
+
+/** Upper bound on the number of kept buffers, in case pass sizes change between frames. */
+static constexpr int PASS_BUFFER_POOL_MAX = 256;
+
+static struct {
+  std::mutex mutex;
+  int users = 0;
+  blender::Vector<PooledPassBuffer> buffers;
+} g_pass_buffer_pool;
+
+void render_result_pass_pool_begin()
+{
+  std::lock_guard lock{g_pass_buffer_pool.mutex};
+  g_pass_buffer_pool.users++;
+}
+
+void render_result_pass_pool_end()
+{
+  std::lock_guard lock{g_pass_buffer_pool.mutex};
+  BLI_assert(g_pass_buffer_pool.users > 0);
+  if (--g_pass_buffer_pool.users == 0) {
+    for (const PooledPassBuffer &buffer : g_pass_buffer_pool.buffers) {
+      MEM_freeN(buffer.data);
+    }
+    g_pass_buffer_pool.buffers.clear_and_shrink();
+  }
+}
+
+/** Take a buffer with the given number of floats from the pool, its contents are undefined. */
+static float *pass_buffer_pool_pop(const size_t size)
+{
+  std::lock_guard lock{g_pass_buffer_pool.mutex};
+  blender::Vector<PooledPassBuffer> &buffers = g_pass_buffer_pool.buffers;
+  for (const int64_t i : buffers.index_range()) {
+    if (buffers[i].size == size) {
+      float *data = buffers[i].data;
+      buffers.remove_and_reorder(i);
+      return data;
+    }
+  }
+  return nullptr;
+}
+
+/** Try to move the float buffer of a pass that is freed into the pool. */
+static void pass_buffer_pool_push(ImBuf *ibuf, const size_t size)
+{
+  if (ibuf == nullptr || ibuf->float_buffer.data == nullptr ||
+      ibuf->float_buffer.ownership != IB_TAKE_OWNERSHIP || ibuf->refcounter != 0)
+  {
+    return;
+  }
+  std::lock_guard lock{g_pass_buffer_pool.mutex};
+  if (g_pass_buffer_pool.users == 0 || g_pass_buffer_pool.buffers.size() >= PASS_BUFFER_POOL_MAX)
+  {
+    return;
+  }
+  g_pass_buffer_pool.buffers.append({IMB_steal_float_buffer(ibuf), size});
+}
+
+/** \} */
+
 /* -------------------------------------------------------------------- */
 /** \name Free
  * \{ */
@@ -71,6 +147,7 @@ void render_result_free(RenderResult *rr)
     while (rl->passes.first) {
       RenderPass *rpass = static_cast<RenderPass *>(rl->passes.first);
 
+      pass_buffer_pool_push(rpass->ibuf, size_t(rpass->rectx) * rpass->recty * rpass->channels);
       IMB_freeImBuf(rpass->ibuf);
 
       BLI_freelinkN(&rl->passes, rpass);
@@ -197,20 +274,32 @@ static void render_layer_allocate_pass(RenderResult *rr, RenderPass *rp)
    * channels. */
 
   const size_t rectsize = size_t(rr->rectx) * rr->recty * rp->channels;
-  float *buffer_data = MEM_cnew_array<float>(rectsize, rp->name);
+  const bool is_vector = STREQ(rp->name, RE_PASSNAME_VECTOR);
+  const bool is_z = STREQ(rp->name, RE_PASSNAME_Z);
+
+  float *buffer_data = pass_buffer_pool_pop(rectsize);
+  if (buffer_data == nullptr) {
+    /* Vector and Z passes are filled below, so they don't need to be cleared. */
+    buffer_data = (is_vector || is_z) ?
+                      static_cast<float *>(MEM_malloc_arrayN(rectsize, sizeof(float), rp->name)) :
+                      MEM_cnew_array<float>(rectsize, rp->name);
+  }
+  else if (!(is_vector || is_z)) {
+    memset(buffer_data, 0, sizeof(float) * rectsize);
+  }
 
   rp->ibuf = IMB_allocImBuf(rr->rectx, rr->recty, get_num_planes_for_pass_ibuf(*rp), 0);
   rp->ibuf->channels = rp->channels;
   IMB_assign_float_buffer(rp->ibuf, buffer_data, IB_TAKE_OWNERSHIP);
   assign_render_pass_ibuf_colorspace(*rp);
 
-  if (STREQ(rp->name, RE_PASSNAME_VECTOR)) {
+  if (is_vector) {
     /* initialize to max speed */
     for (int x = rectsize - 1; x >= 0; x--) {
       buffer_data[x] = PASS_VECTOR_MAX;
     }
   }
-  else if (STREQ(rp->name, RE_PASSNAME_Z)) {
+  else if (is_z) {
     for (int x = rectsize - 1; x >= 0; x--) {
       buffer_data[x] = 10e10;
     }
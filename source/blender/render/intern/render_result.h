@@ -69,6 +69,14 @@ void render_result_clone_passes(struct Render *re, struct RenderResult *rr, cons
 /* Free */
 
 void render_result_free(struct RenderResult *rr);
+
+/**
+ * While any user has begun the pool, the float buffers of freed passes are kept and reused for
+ * newly allocated passes of the same size. Ending the last user frees all kept buffers.
+ */
+void render_result_pass_pool_begin(void);
+void render_result_pass_pool_end(void);
+
 /**
  * Version that's compatible with full-sample buffers.
  */
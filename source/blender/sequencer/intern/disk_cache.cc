@@ -26,6 +26,7 @@
 #include "BLI_fileops_types.h"
 #include "BLI_listbase.h"
 #include "BLI_path_util.h"
+#include "BLI_task.h"
 #include "BLI_threads.h"
 
 #include "BKE_main.hh"
@@ -45,7 +46,8 @@
  * Multiple(DCACHE_IMAGES_PER_FILE) images share the same file.
  * Each of these files contains header DiskCacheHeader followed by image data.
  * ZLIB compression with user definable level can be used to compress image data(per image)
- * Images are written in order in which they are rendered.
+ * Images are written in order in which they are rendered, by a background task so rendering
+ * doesn't wait for compression and file IO.
  * Overwriting of individual entry is not possible.
  * Stored images are deleted by invalidation, or when size of all files exceeds maximum
  * size specified in user preferences.
@@ -79,6 +81,17 @@ struct SeqDiskCache {
   ListBase files;
   ThreadMutex read_write_mutex;
   size_t size_total;
+  /* Serial pool for writing images in the background. */
+  TaskPool *write_pool;
+};
+
+/* Image queued for writing. The file path is resolved when queued, as the strip and scene
+ * referenced by the cache key may be gone when the write runs. */
+struct DiskCacheWriteTask {
+  SeqDiskCache *disk_cache;
+  char filepath[FILE_MAX];
+  float frame_index;
+  ImBuf *ibuf;
 };
 
 struct DiskCacheFile {
@@ -406,6 +419,9 @@ void seq_disk_cache_invalidate(SeqDiskCache *disk_cache,
   int start;
   int end;
 
+  /* Queued images were rendered before the change, don't let them write files afterwards. */
+  BLI_task_pool_work_and_wait(disk_cache->write_pool);
+
   BLI_mutex_lock(&disk_cache->read_write_mutex);
 
   start = SEQ_time_left_handle_frame_get(scene, seq_changed) - DCACHE_IMAGES_PER_FILE;
@@ -481,7 +497,9 @@ static size_t seq_disk_cache_write_header(FILE *file, const DiskCacheHeader *hea
   return fwrite(header, sizeof(*header), 1, file);
 }
 
-static int seq_disk_cache_add_header_entry(SeqCacheKey *key, ImBuf *ibuf, DiskCacheHeader *header)
+static int seq_disk_cache_add_header_entry(const float frame_index,
+                                           ImBuf *ibuf,
+                                           DiskCacheHeader *header)
 {
   int i;
   uint64_t offset = sizeof(*header);
@@ -514,7 +532,7 @@ static int seq_disk_cache_add_header_entry(SeqCacheKey *key, ImBuf *ibuf, DiskCa
   }
 
   header->entry[i].offset = offset;
-  header->entry[i].frameno = key->frame_index;
+  header->entry[i].frameno = frame_index;
 
   /* Store colorspace name of ibuf. */
   const char *colorspace_name;
@@ -542,13 +560,13 @@ static int seq_disk_cache_get_header_entry(SeqCacheKey *key, const DiskCacheHead
   return -1;
 }
 
-bool seq_disk_cache_write_file(SeqDiskCache *disk_cache, SeqCacheKey *key, ImBuf *ibuf)
+static bool seq_disk_cache_write_ibuf(SeqDiskCache *disk_cache,
+                                      const char *filepath,
+                                      const float frame_index,
+                                      ImBuf *ibuf)
 {
   BLI_mutex_lock(&disk_cache->read_write_mutex);
 
-  char filepath[FILE_MAX];
-
-  seq_disk_cache_get_file_path(disk_cache, key, filepath, sizeof(filepath));
   BLI_file_ensure_parent_dir_exists(filepath);
 
   /* Touch the file. */
@@ -573,7 +591,7 @@ bool seq_disk_cache_write_file(SeqDiskCache *disk_cache, SeqCacheKey *key, ImBuf
     BLI_mutex_unlock(&disk_cache->read_write_mutex);
     return false;
   }
-  int entry_index = seq_disk_cache_add_header_entry(key, ibuf, &header);
+  int entry_index = seq_disk_cache_add_header_entry(frame_index, ibuf, &header);
 
   size_t bytes_written = deflate_imbuf_to_file(
       ibuf, file, seq_disk_cache_compression_level(), &header.entry[entry_index]);
@@ -595,6 +613,29 @@ bool seq_disk_cache_write_file(SeqDiskCache *disk_cache, SeqCacheKey *key, ImBuf
   return false;
 }
 
+static void seq_disk_cache_write_task(TaskPool *__restrict /*pool*/, void *taskdata)
+{
+  DiskCacheWriteTask *task = static_cast<DiskCacheWriteTask *>(taskdata);
+  if (seq_disk_cache_write_ibuf(task->disk_cache, task->filepath, task->frame_index, task->ibuf)) {
+    seq_disk_cache_enforce_limits(task->disk_cache);
+  }
+  IMB_freeImBuf(task->ibuf);
+}
+
+void seq_disk_cache_write_file(SeqDiskCache *disk_cache, SeqCacheKey *key, ImBuf *ibuf)
+{
+  DiskCacheWriteTask *task = static_cast<DiskCacheWriteTask *>(
+      MEM_mallocN(sizeof(DiskCacheWriteTask), "DiskCacheWriteTask"));
+  task->disk_cache = disk_cache;
+  seq_disk_cache_get_file_path(disk_cache, key, task->filepath, sizeof(task->filepath));
+  task->frame_index = key->frame_index;
+  /* Cached images are not modified, so holding a reference is enough. */
+  IMB_refImBuf(ibuf);
+  task->ibuf = ibuf;
+
+  BLI_task_pool_push(disk_cache->write_pool, seq_disk_cache_write_task, task, true, nullptr);
+}
+
 ImBuf *seq_disk_cache_read_file(SeqDiskCache *disk_cache, SeqCacheKey *key)
 {
   BLI_mutex_lock(&disk_cache->read_write_mutex);
@@ -671,6 +712,7 @@ SeqDiskCache *seq_disk_cache_create(Main *bmain, Scene *scene)
       MEM_callocN(sizeof(SeqDiskCache), "SeqDiskCache"));
   disk_cache->bmain = bmain;
   BLI_mutex_init(&disk_cache->read_write_mutex);
+  disk_cache->write_pool = BLI_task_pool_create_background_serial(nullptr, TASK_PRIORITY_LOW);
   seq_disk_cache_handle_versioning(disk_cache);
   seq_disk_cache_get_files(disk_cache, seq_disk_cache_base_dir());
   disk_cache->timestamp = scene->ed->disk_cache_timestamp;
@@ -680,6 +722,8 @@ SeqDiskCache *seq_disk_cache_create(Main *bmain, Scene *scene)
 
 void seq_disk_cache_free(SeqDiskCache *disk_cache)
 {
+  BLI_task_pool_work_and_wait(disk_cache->write_pool);
+  BLI_task_pool_free(disk_cache->write_pool);
   BLI_freelistN(&disk_cache->files);
   BLI_mutex_end(&disk_cache->read_write_mutex);
   MEM_freeN(disk_cache);
@@ -72,11 +72,15 @@ struct SeqCache {
   SeqCacheKey *last_key;
   SeqDiskCache *disk_cache;
   int thumbnail_count;
+  /** Memory used by all cached images, compared against the memory cache limit. */
+  size_t memory_used;
 };
 
 struct SeqCacheItem {
   SeqCache *cache_owner;
   ImBuf *ibuf;
+  /** Size of #ibuf at the time it was added, so it can be subtracted again when freed. */
+  size_t size_in_memory;
 };
 
 static ThreadMutex cache_create_lock = BLI_MUTEX_INITIALIZER;
@@ -192,6 +196,8 @@ static void seq_cache_valfree(void *val)
     IMB_freeImBuf(item->ibuf);
   }
 
+  BLI_assert(item->cache_owner->memory_used >= item->size_in_memory);
+  item->cache_owner->memory_used -= item->size_in_memory;
   BLI_mempool_free(item->cache_owner->items_pool, item);
 }
 
@@ -218,6 +224,8 @@ static void seq_cache_put_ex(Scene *scene, SeqCacheKey *key, ImBuf *ibuf)
   item = static_cast<SeqCacheItem *>(BLI_mempool_alloc(cache->items_pool));
   item->cache_owner = cache;
   item->ibuf = ibuf;
+  item->size_in_memory = IMB_get_size_in_memory(ibuf);
+  cache->memory_used += item->size_in_memory;
 
   const int stored_types_flag = get_stored_types_flag(scene, key);
 
@@ -453,7 +461,7 @@ bool seq_cache_recycle_item(Scene *scene)
 
   seq_cache_lock(scene);
 
-  while (seq_cache_is_full()) {
+  while (seq_cache_is_full(scene)) {
     SeqCacheKey *finalkey = seq_cache_get_item_for_removal(scene);
 
     if (finalkey) {
@@ -503,6 +511,7 @@ static void seq_cache_create(Main *bmain, Scene *scene)
     cache->last_key = nullptr;
     cache->bmain = bmain;
     cache->thumbnail_count = 0;
+    cache->memory_used = 0;
     BLI_mutex_init(&cache->iterator_mutex);
     scene->ed->cache = cache;
 
@@ -883,6 +892,12 @@ void seq_cache_put(
   seq_cache_lock(scene);
   SeqCache *cache = seq_cache_get_from_scene(scene);
   SeqCacheKey *key = seq_cache_allocate_key(cache, context, seq, timeline_frame, type);
+  /* Another prefetch worker may have stored the same image since the lookup above. */
+  if (BLI_ghash_haskey(cache->hash, key)) {
+    seq_cache_keyfree(key);
+    seq_cache_unlock(scene);
+    return;
+  }
   seq_cache_put_ex(scene, key, i);
   seq_cache_unlock(scene);
 
@@ -893,7 +908,6 @@ void seq_cache_put(
       }
 
       seq_disk_cache_write_file(cache->disk_cache, key, i);
-      seq_disk_cache_enforce_limits(cache->disk_cache);
     }
   }
 }
@@ -927,7 +941,14 @@ void SEQ_cache_iterate(
   seq_cache_unlock(scene);
 }
 
-bool seq_cache_is_full()
+bool seq_cache_is_full(Scene *scene)
 {
-  return seq_cache_get_mem_total() < MEM_get_memory_in_use();
+  /* Only count the memory used by the cache itself. Comparing against the total memory in use
+   * made the budget shrink with unrelated allocations (undo steps, other caches, open images),
+   * evicting frames right after they were rendered and causing the cache to thrash. */
+  SeqCache *cache = seq_cache_get_from_scene(scene);
+  if (!cache) {
+    return false;
+  }
+  return seq_cache_get_mem_total() < cache->memory_used;
 }
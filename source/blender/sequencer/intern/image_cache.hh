@@ -57,5 +57,5 @@ void seq_cache_cleanup_sequence(Scene *scene,
                                 int invalidate_types,
                                 bool force_seq_changed_range);
 void seq_cache_thumbnail_cleanup(Scene *scene, rctf *view_area);
-bool seq_cache_is_full();
+bool seq_cache_is_full(Scene *scene);
 float seq_cache_frame_index_to_timeline_frame(Sequence *seq, float frame_index);
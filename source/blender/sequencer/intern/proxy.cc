@@ -18,6 +18,8 @@
 #include "BLI_listbase.h"
 #include "BLI_path_util.h"
 #include "BLI_string.h"
+#include "BLI_task.hh"
+#include "BLI_vector.hh"
 
 #ifdef WIN32
 #  include "BLI_winstuff.h"
@@ -251,69 +253,102 @@ ImBuf *seq_proxy_fetch(const SeqRenderData *context, Sequence *seq, int timeline
   return nullptr;
 }
 
-static void seq_proxy_build_frame(const SeqRenderData *context,
-                                  SeqRenderState *state,
-                                  Sequence *seq,
-                                  int timeline_frame,
-                                  int proxy_render_size,
-                                  const bool overwrite)
-{
+struct SeqProxyOutput {
+  int proxy_render_size;
   char filepath[PROXY_MAXFILE];
-  int quality;
-  int rectx, recty;
-  ImBuf *ibuf_tmp, *ibuf;
-  Scene *scene = context->scene;
-
-  if (!seq_proxy_get_filepath(scene,
-                              seq,
-                              timeline_frame,
-                              eSpaceSeq_Proxy_RenderSize(proxy_render_size),
-                              filepath,
-                              context->view_id))
-  {
-    return;
-  }
-
-  if (!overwrite && BLI_exists(filepath)) {
-    return;
-  }
+};
 
-  ibuf_tmp = seq_render_strip(context, state, seq, timeline_frame);
+static void seq_proxy_write_frame(const Sequence *seq,
+                                  const ImBuf *ibuf_src,
+                                  const SeqProxyOutput &output)
+{
+  const int rectx = (output.proxy_render_size * ibuf_src->x) / 100;
+  const int recty = (output.proxy_render_size * ibuf_src->y) / 100;
 
-  rectx = (proxy_render_size * ibuf_tmp->x) / 100;
-  recty = (proxy_render_size * ibuf_tmp->y) / 100;
+  /* The rendered image is shared by all proxy sizes, so each size writes its own copy. */
+  ImBuf *ibuf = IMB_dupImBuf(ibuf_src);
+  IMB_metadata_copy(ibuf, ibuf_src);
 
-  if (ibuf_tmp->x != rectx || ibuf_tmp->y != recty) {
-    ibuf = IMB_dupImBuf(ibuf_tmp);
-    IMB_metadata_copy(ibuf, ibuf_tmp);
-    IMB_freeImBuf(ibuf_tmp);
+  if (ibuf->x != rectx || ibuf->y != recty) {
     IMB_scalefastImBuf(ibuf, short(rectx), short(recty));
   }
-  else {
-    ibuf = ibuf_tmp;
-  }
 
   /* depth = 32 is intentionally left in, otherwise ALPHA channels
    * won't work... */
-  quality = seq->strip->proxy->quality;
   ibuf->ftype = IMB_FTYPE_JPG;
-  ibuf->foptions.quality = quality;
+  ibuf->foptions.quality = seq->strip->proxy->quality;
 
   /* unsupported feature only confuses other s/w */
   if (ibuf->planes == 32) {
     ibuf->planes = 24;
   }
 
-  BLI_file_ensure_parent_dir_exists(filepath);
+  BLI_file_ensure_parent_dir_exists(output.filepath);
 
-  const bool ok = IMB_saveiff(ibuf, filepath, IB_rect);
+  const bool ok = IMB_saveiff(ibuf, output.filepath, IB_rect);
   if (ok == false) {
-    perror(filepath);
+    perror(output.filepath);
   }
 
   IMB_freeImBuf(ibuf);
 }
 
+/**
+ * Render the strip once for all proxy sizes in \a size_flags, and scale and encode the sizes in
+ * parallel. Sizes that already have a file are skipped unless \a overwrite is set, so an
+ * interrupted rebuild continues where it stopped.
+ */
+static void seq_proxy_build_frame(const SeqRenderData *context,
+                                  SeqRenderState *state,
+                                  Sequence *seq,
+                                  int timeline_frame,
+                                  const int size_flags,
+                                  const bool overwrite)
+{
+  const int proxy_sizes[][2] = {
+      {IMB_PROXY_25, 25}, {IMB_PROXY_50, 50}, {IMB_PROXY_75, 75}, {IMB_PROXY_100, 100}};
+  Scene *scene = context->scene;
+
+  blender::Vector<SeqProxyOutput, 4> outputs;
+  for (const int *proxy_size : proxy_sizes) {
+    if ((size_flags & proxy_size[0]) == 0) {
+      continue;
+    }
+
+    SeqProxyOutput output;
+    output.proxy_render_size = proxy_size[1];
+    if (!seq_proxy_get_filepath(scene,
+                                seq,
+                                timeline_frame,
+                                eSpaceSeq_Proxy_RenderSize(output.proxy_render_size),
+                                output.filepath,
+                                context->view_id))
+    {
+      continue;
+    }
+
+    if (!overwrite && BLI_exists(output.filepath)) {
+      continue;
+    }
+
+    outputs.append(output);
+  }
+
+  if (outputs.is_empty()) {
+    return;
+  }
+
+  ImBuf *ibuf = seq_render_strip(context, state, seq, timeline_frame);
+
+  blender::threading::parallel_for(outputs.index_range(), 1, [&](const blender::IndexRange range) {
+    for (const int i : range) {
+      seq_proxy_write_frame(seq, ibuf, outputs[i]);
+    }
+  });
+
+  IMB_freeImBuf(ibuf);
+}
+
 /**
  * Cache the result of #BKE_scene_multiview_view_prefix_get.
  */
@@ -549,18 +584,8 @@ void SEQ_proxy_rebuild(SeqIndexBuildContext *context, wmJobWorkerStatus *worker_
        timeline_frame < SEQ_time_right_handle_frame_get(scene, seq);
        timeline_frame++)
   {
-    if (context->size_flags & IMB_PROXY_25) {
-      seq_proxy_build_frame(&render_context, &state, seq, timeline_frame, 25, overwrite);
-    }
-    if (context->size_flags & IMB_PROXY_50) {
-      seq_proxy_build_frame(&render_context, &state, seq, timeline_frame, 50, overwrite);
-    }
-    if (context->size_flags & IMB_PROXY_75) {
-      seq_proxy_build_frame(&render_context, &state, seq, timeline_frame, 75, overwrite);
-    }
-    if (context->size_flags & IMB_PROXY_100) {
-      seq_proxy_build_frame(&render_context, &state, seq, timeline_frame, 100, overwrite);
-    }
+    seq_proxy_build_frame(
+        &render_context, &state, seq, timeline_frame, context->size_flags, overwrite);
 
     worker_status->progress = float(timeline_frame - SEQ_time_left_handle_frame_get(scene, seq)) /
                               (SEQ_time_right_handle_frame_get(scene, seq) -
@@ -25,6 +25,8 @@
 #include "BLI_math_vector_types.hh"
 #include "BLI_path_util.h"
 #include "BLI_rect.h"
+#include "BLI_set.hh"
+#include "BLI_task.hh"
 
 #include "BKE_anim_data.hh"
 #include "BKE_animsys.h"
@@ -599,6 +601,22 @@ static void sequencer_preprocess_transform_crop(
   const float crop_scale_factor = do_scale_to_render_size ? preview_scale_factor : 1.0f;
   sequencer_image_crop_init(seq, in, crop_scale_factor, &source_crop);
 
+  /* Flip the output as part of the transform, instead of with separate passes over the image.
+   * Pixels are sampled at their centers, so mirroring around the output edges is exact. */
+  if (seq->flag & (SEQ_FLIPX | SEQ_FLIPY)) {
+    float flip_matrix[4][4];
+    unit_m4(flip_matrix);
+    if (seq->flag & SEQ_FLIPX) {
+      flip_matrix[0][0] = -1.0f;
+      flip_matrix[3][0] = out->x;
+    }
+    if (seq->flag & SEQ_FLIPY) {
+      flip_matrix[1][1] = -1.0f;
+      flip_matrix[3][1] = out->y;
+    }
+    mul_m4_m4_post(transform_matrix, flip_matrix);
+  }
+
   const StripTransform *transform = seq->strip->transform;
   eIMBInterpolationFilterMode filter = IMB_FILTER_NEAREST;
   switch (transform->filter) {
@@ -702,18 +720,20 @@ static ImBuf *input_preprocess(const SeqRenderData *context,
     IMB_metadata_copy(preprocessed_ibuf, ibuf);
     IMB_freeImBuf(ibuf);
   }
+  else {
+    /* Duplicate ibuf if we still have original. */
+    if (preprocessed_ibuf == nullptr) {
+      preprocessed_ibuf = IMB_makeSingleUser(ibuf);
+    }
 
-  /* Duplicate ibuf if we still have original. */
-  if (preprocessed_ibuf == nullptr) {
-    preprocessed_ibuf = IMB_makeSingleUser(ibuf);
-  }
-
-  if (seq->flag & SEQ_FLIPX) {
-    IMB_flipx(preprocessed_ibuf);
-  }
+    /* Otherwise flipping is done by the transform. */
+    if (seq->flag & SEQ_FLIPX) {
+      IMB_flipx(preprocessed_ibuf);
+    }
 
-  if (seq->flag & SEQ_FLIPY) {
-    IMB_flipy(preprocessed_ibuf);
+    if (seq->flag & SEQ_FLIPY) {
+      IMB_flipy(preprocessed_ibuf);
+    }
   }
 
   if (seq->sat != 1.0f) {
@@ -1950,6 +1970,72 @@ static ImBuf *seq_render_strip_stack_apply_effect(
   return out;
 }
 
+/* Image and movie strips only read their own source files, so multiple of them can be rendered
+ * at the same time. Other strips may render scenes or other strips, which is not thread-safe. */
+static bool seq_render_strip_is_isolated(const Sequence *seq)
+{
+  if (!ELEM(seq->type, SEQ_TYPE_IMAGE, SEQ_TYPE_MOVIE)) {
+    return false;
+  }
+  LISTBASE_FOREACH (const SequenceModifierData *, smd, &seq->modifiers) {
+    if (smd->mask_sequence) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * Render the strips that are blended on top of the stack, starting at \a start, concurrently.
+ * This spreads decoding of multiple movie strips over multiple cores. Strips that can't be
+ * rendered concurrently are left null, to be rendered when blending.
+ */
+static Vector<ImBuf *> seq_render_strip_stack_inputs(const SeqRenderData *context,
+                                                     SeqRenderState *state,
+                                                     Span<Sequence *> strips,
+                                                     const int64_t start,
+                                                     float timeline_frame,
+                                                     const OpaqueQuadTracker &opaques)
+{
+  Vector<ImBuf *> inputs(strips.size(), nullptr);
+
+  /* Strips used as modifier masks are also rendered by the modifier, don't render them here. */
+  Set<const Sequence *> mask_strips;
+  for (const Sequence *seq : strips) {
+    LISTBASE_FOREACH (const SequenceModifierData *, smd, &seq->modifiers) {
+      if (smd->mask_sequence) {
+        mask_strips.add(smd->mask_sequence);
+      }
+    }
+  }
+
+  Vector<int64_t> indices;
+  for (int64_t i = start; i < strips.size(); i++) {
+    Sequence *seq = strips[i];
+    if (opaques.is_occluded(context, seq, i) ||
+        seq_get_early_out_for_blend_mode(seq) != StripEarlyOut::DoEffect)
+    {
+      continue;
+    }
+    if (seq_render_strip_is_isolated(seq) && !mask_strips.contains(seq)) {
+      indices.append(i);
+    }
+  }
+
+  if (indices.size() < 2) {
+    return inputs;
+  }
+
+  threading::parallel_for(indices.index_range(), 1, [&](const IndexRange range) {
+    for (const int64_t index : range) {
+      const int64_t i = indices[index];
+      inputs[i] = seq_render_strip(context, state, strips[i], timeline_frame);
+    }
+  });
+
+  return inputs;
+}
+
 static ImBuf *seq_render_strip_stack(const SeqRenderData *context,
                                      SeqRenderState *state,
                                      ListBase *channels,
@@ -2044,6 +2130,9 @@ static ImBuf *seq_render_strip_stack(const SeqRenderData *context,
   }
 
   i++;
+  Vector<ImBuf *> inputs = seq_render_strip_stack_inputs(
+      context, state, strips, i, timeline_frame, opaques);
+
   for (; i < strips.size(); i++) {
     Sequence *seq = strips[i];
 
@@ -2053,7 +2142,8 @@ static ImBuf *seq_render_strip_stack(const SeqRenderData *context,
 
     if (seq_get_early_out_for_blend_mode(seq) == StripEarlyOut::DoEffect) {
       ImBuf *ibuf1 = out;
-      ImBuf *ibuf2 = seq_render_strip(context, state, seq, timeline_frame);
+      ImBuf *ibuf2 = inputs[i] ? inputs[i] :
+                                 seq_render_strip(context, state, seq, timeline_frame);
 
       out = seq_render_strip_stack_apply_effect(context, seq, timeline_frame, ibuf1, ibuf2);
 
@@ -2175,14 +2265,48 @@ float SEQ_render_thumbnail_next_frame_get(const Scene *scene,
   return next_frame;
 }
 
+/* Smallest proxy size built for the strip, or #SEQ_RENDER_SIZE_NONE. Thumbnails are much smaller
+ * than any proxy, so decoding the smallest one is cheapest. Proxies are also encoded with every
+ * frame as a key-frame, so seeking to thumbnail frames doesn't decode the frames in between. */
+static eSpaceSeq_Proxy_RenderSize seq_thumbnail_proxy_render_size_get(const Sequence *seq)
+{
+  const StripProxy *proxy = seq->strip->proxy;
+  if (proxy == nullptr || (seq->flag & SEQ_USE_PROXY) == 0) {
+    return SEQ_RENDER_SIZE_NONE;
+  }
+  if (proxy->build_size_flags & IMB_PROXY_25) {
+    return SEQ_RENDER_SIZE_PROXY_25;
+  }
+  if (proxy->build_size_flags & IMB_PROXY_50) {
+    return SEQ_RENDER_SIZE_PROXY_50;
+  }
+  if (proxy->build_size_flags & IMB_PROXY_75) {
+    return SEQ_RENDER_SIZE_PROXY_75;
+  }
+  if (proxy->build_size_flags & IMB_PROXY_100) {
+    return SEQ_RENDER_SIZE_PROXY_100;
+  }
+  return SEQ_RENDER_SIZE_NONE;
+}
+
 /* Gets the direct image from source and scales to thumbnail size. */
 static ImBuf *seq_get_uncached_thumbnail(const SeqRenderData *context,
                                          SeqRenderState *state,
                                          Sequence *seq,
                                          float timeline_frame)
 {
+  /* Read from a proxy when there is one, rendering falls back to the original media if its file
+   * is missing. The context is only used for rendering, cache keys use the thumbnail context. */
+  SeqRenderData local_context = *context;
+  const eSpaceSeq_Proxy_RenderSize proxy_render_size = seq_thumbnail_proxy_render_size_get(seq);
+  if (proxy_render_size != SEQ_RENDER_SIZE_NONE) {
+    local_context.preview_render_size = proxy_render_size;
+    local_context.use_proxies = true;
+  }
+
   bool is_proxy_image = false;
-  ImBuf *ibuf = do_render_strip_uncached(context, state, seq, timeline_frame, &is_proxy_image);
+  ImBuf *ibuf = do_render_strip_uncached(
+      &local_context, state, seq, timeline_frame, &is_proxy_image);
 
   if (ibuf == nullptr) {
     return nullptr;
@@ -12,5 +12,7 @@ struct ListBase;
 struct Scene;
 
 bool sequencer_seq_generates_image(Sequence *seq);
+/** #ImBuf flags to open the movie file of a movie strip with. */
+int seq_anim_open_flags(const Sequence *seq);
 void seq_open_anim_file(Scene *scene, Sequence *seq, bool openfile);
 Sequence *SEQ_get_meta_by_seqbase(ListBase *seqbase_main, ListBase *meta_seqbase);
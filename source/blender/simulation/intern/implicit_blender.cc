@@ -17,9 +17,11 @@
 #  include "DNA_scene_types.h"
 #  include "DNA_texture_types.h"
 
+#  include "BLI_array.hh"
 #  include "BLI_math_geom.h"
 #  include "BLI_math_matrix.h"
 #  include "BLI_math_vector.h"
+#  include "BLI_task.hh"
 #  include "BLI_utildefines.h"
 
 #  include "BKE_cloth.hh"
@@ -36,6 +38,11 @@
 #    define CLOTH_OPENMP_LIMIT 512
 #  endif
 
+/* Number of vertices processed by one task in the long vector and sparse matrix operations.
+ * This is also the size of the chunks that are summed separately in #dot_lfvector, so that the
+ * result does not depend on the number of threads. */
+#  define CLOTH_GRAIN_SIZE 1024
+
 // #define DEBUG_TIME
 
 #  ifdef DEBUG_TIME
@@ -173,15 +180,26 @@ DO_INLINE void submul_lfvectorS(float (*to)[3], float (*fLongVector)[3], float s
 /* dot product for big vector */
 DO_INLINE float dot_lfvector(float (*fLongVectorA)[3], float (*fLongVectorB)[3], uint verts)
 {
-  long i = 0;
-  float temp = 0.0;
-  /* XXX brecht, disabled this for now (first schedule line was already disabled),
-   * due to non-commutative nature of floating point ops this makes the sim give
-   * different results each time you run it!
-   * schedule(guided, 2) */
-  // #pragma omp parallel for reduction(+: temp) if (verts > CLOTH_OPENMP_LIMIT)
-  for (i = 0; i < long(verts); i++) {
-    temp += dot_v3v3(fLongVectorA[i], fLongVectorB[i]);
+  using namespace blender;
+  /* Floating point addition is not associative, a regular parallel reduction would make the
+   * simulation give different results each time it runs. Instead every chunk of a fixed size is
+   * summed separately, and the partial sums are added in order. */
+  const int64_t chunks_num = divide_ceil_u(verts, CLOTH_GRAIN_SIZE);
+  Array<float, 64> chunk_sums(chunks_num);
+  threading::parallel_for(IndexRange(chunks_num), 1, [&](const IndexRange range) {
+    for (const int64_t chunk : range) {
+      const IndexRange chunk_range = IndexRange(chunk * CLOTH_GRAIN_SIZE, CLOTH_GRAIN_SIZE)
+                                         .intersect(IndexRange(verts));
+      float temp = 0.0f;
+      for (const int64_t i : chunk_range) {
+        temp += dot_v3v3(fLongVectorA[i], fLongVectorB[i]);
+      }
+      chunk_sums[chunk] = temp;
+    }
+  });
+  float temp = 0.0f;
+  for (const float chunk_sum : chunk_sums) {
+    temp += chunk_sum;
   }
   return temp;
 }
@@ -191,21 +209,23 @@ DO_INLINE void add_lfvector_lfvector(float (*to)[3],
                                      float (*fLongVectorB)[3],
                                      uint verts)
 {
-  uint i = 0;
-
-  for (i = 0; i < verts; i++) {
-    add_v3_v3v3(to[i], fLongVectorA[i], fLongVectorB[i]);
-  }
+  blender::threading::parallel_for(
+      blender::IndexRange(verts), CLOTH_GRAIN_SIZE, [&](const blender::IndexRange range) {
+        for (const int64_t i : range) {
+          add_v3_v3v3(to[i], fLongVectorA[i], fLongVectorB[i]);
+        }
+      });
 }
 /* `A = B + C * float` -> for big vector. */
 DO_INLINE void add_lfvector_lfvectorS(
     float (*to)[3], float (*fLongVectorA)[3], float (*fLongVectorB)[3], float bS, uint verts)
 {
-  uint i = 0;
-
-  for (i = 0; i < verts; i++) {
-    VECADDS(to[i], fLongVectorA[i], fLongVectorB[i], bS);
-  }
+  blender::threading::parallel_for(
+      blender::IndexRange(verts), CLOTH_GRAIN_SIZE, [&](const blender::IndexRange range) {
+        for (const int64_t i : range) {
+          VECADDS(to[i], fLongVectorA[i], fLongVectorB[i], bS);
+        }
+      });
 }
 /* `A = B * float + C * float` -> for big vector */
 DO_INLINE void add_lfvectorS_lfvectorS(float (*to)[3],
@@ -582,35 +602,87 @@ DO_INLINE void initdiag_bfmatrix(fmatrix3x3 *matrix, float m3[3][3])
   }
 }
 
-/* SPARSE SYMMETRIC multiply big matrix with long vector. */
-/* STATUS: verified */
-DO_INLINE void mul_bfmatrix_lfvector(float (*to)[3], fmatrix3x3 *from, lfVector *fLongVector)
+/* Compressed row index of the off-diagonal blocks: the blocks touching vertex `v` (as row or
+ * as column) are `blocks[offsets[v]]` to `blocks[offsets[v + 1] - 1]`, in increasing order.
+ * All matrices of the solver share the same block layout, so one index is used for all of them. */
+struct fmatrixRowIndex {
+  uint *offsets; /* vcount + 1 */
+  uint *blocks;  /* 2 * scount */
+};
+
+DO_INLINE void create_bfmatrix_row_index(fmatrixRowIndex *index, uint verts, uint springs)
+{
+  index->offsets = (uint *)MEM_callocN(sizeof(uint) * (verts + 1), "cloth_implicit_row_offsets");
+  index->blocks = (uint *)MEM_mallocN(sizeof(uint) * 2 * springs, "cloth_implicit_row_blocks");
+}
+
+DO_INLINE void del_bfmatrix_row_index(fmatrixRowIndex *index)
 {
-  uint vcount = from[0].vcount;
-  lfVector *temp = create_lfvector(vcount);
+  MEM_SAFE_FREE(index->offsets);
+  MEM_SAFE_FREE(index->blocks);
+}
 
-  zero_lfvector(to, vcount);
+/* Build the index from the first `num_blocks` off-diagonal blocks, the remaining ones are unused
+ * and zero. */
+DO_INLINE void build_bfmatrix_row_index(fmatrixRowIndex *index,
+                                        const fmatrix3x3 *matrix,
+                                        uint num_blocks)
+{
+  const uint vcount = matrix[0].vcount;
+  uint *offsets = index->offsets;
 
-#  pragma omp parallel sections if (vcount > CLOTH_OPENMP_LIMIT)
-  {
-#  pragma omp section
-    {
-      for (uint i = from[0].vcount; i < from[0].vcount + from[0].scount; i++) {
-        /* This is the lower triangle of the sparse matrix,
-         * therefore multiplication occurs with transposed sub-matrices. */
-        muladd_fmatrixT_fvector(to[from[i].c], from[i].m, fLongVector[from[i].r]);
-      }
+  memset(offsets, 0, sizeof(uint) * (vcount + 1));
+  for (uint i = vcount; i < vcount + num_blocks; i++) {
+    offsets[matrix[i].r + 1]++;
+    if (matrix[i].c != matrix[i].r) {
+      offsets[matrix[i].c + 1]++;
     }
-#  pragma omp section
-    {
-      for (uint i = 0; i < from[0].vcount + from[0].scount; i++) {
-        muladd_fmatrix_fvector(temp[from[i].r], from[i].m, fLongVector[from[i].c]);
-      }
+  }
+  for (uint v = 0; v < vcount; v++) {
+    offsets[v + 1] += offsets[v];
+  }
+
+  /* Use the start offsets as insertion cursors and shift them back afterwards. */
+  for (uint i = vcount; i < vcount + num_blocks; i++) {
+    index->blocks[offsets[matrix[i].r]++] = i;
+    if (matrix[i].c != matrix[i].r) {
+      index->blocks[offsets[matrix[i].c]++] = i;
     }
   }
-  add_lfvector_lfvector(to, to, temp, from[0].vcount);
+  for (uint v = vcount; v > 0; v--) {
+    offsets[v] = offsets[v - 1];
+  }
+  offsets[0] = 0;
+}
 
-  del_lfvector(temp);
+/* SPARSE SYMMETRIC multiply big matrix with long vector. */
+/* STATUS: verified */
+DO_INLINE void mul_bfmatrix_lfvector(float (*to)[3],
+                                     const fmatrix3x3 *from,
+                                     const fmatrixRowIndex *index,
+                                     lfVector *fLongVector)
+{
+  /* Every vertex gathers the contributions of its own row, so that no two tasks write to the
+   * same element and the order of the additions does not depend on the threading. */
+  blender::threading::parallel_for(
+      blender::IndexRange(from[0].vcount),
+      CLOTH_GRAIN_SIZE,
+      [&](const blender::IndexRange range) {
+        for (const int64_t v : range) {
+          mul_fmatrix_fvector(to[v], from[v].m, fLongVector[v]);
+          for (uint j = index->offsets[v]; j < index->offsets[v + 1]; j++) {
+            const fmatrix3x3 &block = from[index->blocks[j]];
+            if (block.r == v) {
+              muladd_fmatrix_fvector(to[v], block.m, fLongVector[block.c]);
+            }
+            if (block.c == v) {
+              /* This is the lower triangle of the sparse matrix,
+               * therefore multiplication occurs with transposed sub-matrices. */
+              muladd_fmatrixT_fvector(to[v], block.m, fLongVector[block.r]);
+            }
+          }
+        }
+      });
 }
 
 /* SPARSE SYMMETRIC sub big matrix with big matrix. */
@@ -652,6 +724,8 @@ struct Implicit_Data {
   lfVector *z;          /* target velocity in constrained directions */
   fmatrix3x3 *S;        /* filtering matrix for constraints */
   fmatrix3x3 *P, *Pinv; /* pre-conditioning matrix */
+
+  fmatrixRowIndex row_index; /* off-diagonal blocks per vertex, for matrix multiplication */
 };
 
 Implicit_Data *SIM_mass_spring_solver_create(int numverts, int numsprings)
@@ -676,6 +750,7 @@ Implicit_Data *SIM_mass_spring_solver_create(int numverts, int numsprings)
   id->B = create_lfvector(numverts);
   id->dV = create_lfvector(numverts);
   id->z = create_lfvector(numverts);
+  create_bfmatrix_row_index(&id->row_index, numverts, numsprings);
 
   initdiag_bfmatrix(id->bigI, I);
 
@@ -702,6 +777,7 @@ void SIM_mass_spring_solver_free(Implicit_Data *id)
   del_lfvector(id->B);
   del_lfvector(id->dV);
   del_lfvector(id->z);
+  del_bfmatrix_row_index(&id->row_index);
 
   MEM_freeN(id);
 }
@@ -742,11 +818,12 @@ BLI_INLINE void root_to_world_m3(Implicit_Data *data,
 
 DO_INLINE void filter(lfVector *V, fmatrix3x3 *S)
 {
-  uint i = 0;
-
-  for (i = 0; i < S[0].vcount; i++) {
-    mul_m3_v3(S[i].m, V[S[i].r]);
-  }
+  blender::threading::parallel_for(
+      blender::IndexRange(S[0].vcount), CLOTH_GRAIN_SIZE, [&](const blender::IndexRange range) {
+        for (const int64_t i : range) {
+          mul_m3_v3(S[i].m, V[S[i].r]);
+        }
+      });
 }
 
 /* this version of the CG algorithm does not work very well with partial constraints
@@ -821,6 +898,7 @@ static int cg_filtered(lfVector *ldV, fmatrix3x3 *lA, lfVector *lB, lfVector *z,
 
 static int cg_filtered(lfVector *ldV,
                        fmatrix3x3 *lA,
+                       const fmatrixRowIndex *index,
                        lfVector *lB,
                        lfVector *z,
                        fmatrix3x3 *S,
@@ -848,7 +926,7 @@ static int cg_filtered(lfVector *ldV,
   delta_target = conjgrad_epsilon * conjgrad_epsilon * bnorm2;
 
   /* r = filter(B - A * dV) */
-  mul_bfmatrix_lfvector(AdV, lA, ldV);
+  mul_bfmatrix_lfvector(AdV, lA, index, ldV);
   sub_lfvector_lfvector(r, lB, AdV, numverts);
   filter(r, S);
 
@@ -871,7 +949,7 @@ static int cg_filtered(lfVector *ldV,
 #  endif
 
   while (delta_new > delta_target && conjgrad_loopcount < conjgrad_looplimit) {
-    mul_bfmatrix_lfvector(q, lA, c);
+    mul_bfmatrix_lfvector(q, lA, index, c);
     filter(q, S);
 
     alpha = delta_new / dot_lfvector(c, q, numverts);
@@ -1131,7 +1209,9 @@ bool SIM_mass_spring_solve_velocities(Implicit_Data *data, float dt, ImplicitSol
 
   subadd_bfmatrixS_bfmatrixS(data->A, data->dFdV, dt, data->dFdX, (dt * dt));
 
-  mul_bfmatrix_lfvector(dFdXmV, data->dFdX, data->V);
+  build_bfmatrix_row_index(&data->row_index, data->A, data->num_blocks);
+
+  mul_bfmatrix_lfvector(dFdXmV, data->dFdX, &data->row_index, data->V);
 
   add_lfvectorS_lfvectorS(data->B, data->F, dt, dFdXmV, (dt * dt), numverts);
 
@@ -1140,7 +1220,7 @@ bool SIM_mass_spring_solve_velocities(Implicit_Data *data, float dt, ImplicitSol
 #  endif
 
   /* Conjugate gradient algorithm to solve Ax=b. */
-  cg_filtered(data->dV, data->A, data->B, data->z, data->S, result);
+  cg_filtered(data->dV, data->A, &data->row_index, data->B, data->z, data->S, result);
 
   // cg_filtered_pre(id->dV, id->A, id->B, id->z, id->S, id->P, id->Pinv, id->bigI);
 
@@ -23,6 +23,7 @@
 
 #include "BLI_math_matrix.h"
 #include "BLI_math_vector_types.hh"
+#include "BLI_trace.hh"
 #include "BLI_utildefines.h"
 
 #include "BKE_context.hh"
@@ -741,6 +742,21 @@ static void wm_draw_region_buffer_create(Scene *scene,
   }
 }
 
+/**
+ * Check if the off-screen buffer of a region can be composited again without drawing it, because
+ * it still matches the size and format that #wm_draw_region_buffer_create would use.
+ */
+static bool wm_draw_region_buffer_is_reusable(Scene *scene, ARegion *region)
+{
+  if (!region->draw_buffer || region->draw_buffer->stereo) {
+    return false;
+  }
+  GPUOffScreen *offscreen = region->draw_buffer->offscreen;
+  return offscreen && GPU_offscreen_width(offscreen) == region->winx &&
+         GPU_offscreen_height(offscreen) == region->winy &&
+         GPU_offscreen_format(offscreen) == get_hdr_framebuffer_format(scene);
+}
+
 static void wm_draw_region_bind(ARegion *region, int view)
 {
   if (!region->draw_buffer) {
@@ -1023,6 +1039,17 @@ static void wm_draw_window_offscreen(bContext *C, wmWindow *win, bool stereo)
     if (!region->visible) {
       continue;
     }
+
+    Scene *scene = WM_window_get_active_scene(win);
+
+    /* Menus without a layout callback that were not tagged for redraw have not changed, the
+     * window redraw (for example caused by another region) can reuse their previous contents. */
+    if (!region->do_draw && !(region->type && region->type->layout) &&
+        wm_draw_region_buffer_is_reusable(scene, region))
+    {
+      continue;
+    }
+
     CTX_wm_menu_set(C, region);
 
     GPU_debug_group_begin("Menu");
@@ -1034,7 +1061,6 @@ static void wm_draw_window_offscreen(bContext *C, wmWindow *win, bool stereo)
       region->type->layout(C, region);
     }
 
-    Scene *scene = WM_window_get_active_scene(win);
     wm_draw_region_buffer_create(scene, region, false, false);
     wm_draw_region_bind(region, 0);
     GPU_clear_color(0.0f, 0.0f, 0.0f, 0.0f);
@@ -1533,8 +1559,11 @@ void WM_paint_cursor_tag_redraw(wmWindow *win, ARegion * /*region*/)
 
 void wm_draw_update(bContext *C)
 {
+  TRACE_SCOPE("WM::draw_update");
+
   Main *bmain = CTX_data_main(C);
   wmWindowManager *wm = CTX_wm_manager(C);
+  bool any_window_drawn = false;
 
   GPU_context_main_lock();
 
@@ -1577,11 +1606,14 @@ void wm_draw_update(bContext *C)
       wm_draw_update_clear_window(C, win);
 
       wm_window_swap_buffers(win);
+      any_window_drawn = true;
     }
   }
 
   CTX_wm_window_set(C, nullptr);
 
+  wm_event_input_latency_report(any_window_drawn);
+
   /* Draw non-windows (surfaces). */
   wm_surfaces_iter(C, wm_draw_surface);
 
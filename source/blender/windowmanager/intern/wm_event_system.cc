@@ -31,7 +31,9 @@
 
 #include "BLI_blenlib.h"
 #include "BLI_ghash.h"
+#include "BLI_time.h"
 #include "BLI_timer.h"
+#include "BLI_trace.hh"
 #include "BLI_utildefines.h"
 
 #include "BKE_context.hh"
@@ -3898,6 +3900,8 @@ static eHandlerActionFlag wm_event_do_handlers_area_regions(bContext *C,
 
 void wm_event_do_handlers(bContext *C)
 {
+  TRACE_SCOPE("WM::event_do_handlers");
+
   wmWindowManager *wm = CTX_wm_manager(C);
   BLI_assert(ED_undo_is_state_valid(C));
 
@@ -5486,6 +5490,21 @@ static bool wm_event_is_ignorable_key_press(const wmWindow *win, const wmEvent &
   return wm_event_is_same_key_press(last_event, event);
 }
 
+/** Time the oldest input event that has not been presented on screen yet was received. */
+static double wm_event_input_time_unpresented = 0.0;
+
+void wm_event_input_latency_report(const bool presented)
+{
+  if (wm_event_input_time_unpresented == 0.0) {
+    return;
+  }
+  if (presented) {
+    TRACE_COUNTER("WM::input_latency_ms",
+                  (BLI_time_now_seconds() - wm_event_input_time_unpresented) * 1000.0);
+  }
+  wm_event_input_time_unpresented = 0.0;
+}
+
 void wm_event_add_ghostevent(wmWindowManager *wm,
                              wmWindow *win,
                              const int type,
@@ -5496,6 +5515,10 @@ void wm_event_add_ghostevent(wmWindowManager *wm,
     return;
   }
 
+  if (blender::trace::is_enabled() && wm_event_input_time_unpresented == 0.0) {
+    wm_event_input_time_unpresented = BLI_time_now_seconds();
+  }
+
   /**
    * Having both, \a event and \a event_state, can be highly confusing to work with,
    * but is necessary for our current event system, so let's clear things up a bit:
@@ -42,6 +42,7 @@
 #include "BLI_threads.h"
 #include "BLI_time.h"
 #include "BLI_timer.h"
+#include "BLI_trace.hh"
 #include "BLI_utildefines.h"
 #include BLI_SYSTEM_PID_H
 
@@ -1151,6 +1152,8 @@ void wm_homefile_read_ex(bContext *C,
                          ReportList *reports,
                          wmFileReadPost_Params **r_params_file_read_post)
 {
+  TRACE_SCOPE("WM::homefile_read");
+
   /* NOTE: unlike #WM_file_read, don't set the wait cursor when reading the home-file.
    * While technically both are reading a file and could use the wait cursor,
    * avoid doing so for the following reasons.
@@ -1929,6 +1932,7 @@ static bool wm_file_write(bContext *C,
                           int fileflags,
                           eBLO_WritePathRemap remap_mode,
                           bool use_save_as_copy,
+                          bool use_block_hash_index,
                           ReportList *reports)
 {
   Main *bmain = CTX_data_main(C);
@@ -2028,6 +2032,7 @@ static bool wm_file_write(bContext *C,
   blend_write_params.remap_mode = remap_mode;
   blend_write_params.use_save_versions = true;
   blend_write_params.use_save_as_copy = use_save_as_copy;
+  blend_write_params.use_block_hash_index = use_block_hash_index;
   blend_write_params.thumb = thumb;
 
   const bool success = BLO_write_file(bmain, filepath, fileflags, &blend_write_params, reports);
@@ -2128,6 +2133,63 @@ bool WM_autosave_is_scheduled(wmWindowManager *wm)
   return wm->autosave_scheduled;
 }
 
+struct AutosaveJob {
+  BlendFileWriteBuffer *buffer;
+  char filepath[FILE_MAX];
+};
+
+static void wm_autosave_job_startjob(void *customdata, wmJobWorkerStatus * /*worker_status*/)
+{
+  const AutosaveJob *job = static_cast<AutosaveJob *>(customdata);
+  /* Error reporting into console. */
+  BLO_write_buffer_to_file(job->buffer, job->filepath);
+}
+
+static void wm_autosave_job_free(void *customdata)
+{
+  AutosaveJob *job = static_cast<AutosaveJob *>(customdata);
+  BLO_write_buffer_free(job->buffer);
+  MEM_delete(job);
+}
+
+/**
+ * Serialize the file into memory and leave writing it to disk (the slow part on network or
+ * otherwise slow drives) to a job, so auto-save doesn't block the UI for the whole write.
+ *
+ * When a previous auto-save is still being written, the new one is kept pending and replaces it
+ * when it's done, so at most one auto-save buffer waits in memory.
+ *
+ * \return false when the file couldn't be written in the background.
+ */
+static bool wm_autosave_write_in_background(wmWindowManager *wm,
+                                            Main *bmain,
+                                            const char *filepath,
+                                            const int fileflags)
+{
+  if (G.background || BLI_listbase_is_empty(&wm->windows)) {
+    /* Jobs are only handled by the event loop. */
+    return false;
+  }
+
+  BlendFileWriteBuffer *buffer = BLO_write_file_to_buffer(bmain, fileflags, nullptr);
+  if (buffer == nullptr) {
+    return false;
+  }
+
+  AutosaveJob *job = MEM_new<AutosaveJob>(__func__);
+  job->buffer = buffer;
+  STRNCPY(job->filepath, filepath);
+
+  wmJob *wm_job = WM_jobs_get(
+      wm, nullptr, wm, "Auto-Saving...", eWM_JobFlag(0), WM_JOB_TYPE_AUTOSAVE);
+  WM_jobs_customdata_set(wm_job, job, wm_autosave_job_free);
+  WM_jobs_timer(wm_job, 0.1, 0, 0);
+  WM_jobs_callbacks(wm_job, wm_autosave_job_startjob, nullptr, nullptr, nullptr);
+  WM_jobs_start(wm, wm_job);
+
+  return true;
+}
+
 void WM_autosave_write(wmWindowManager *wm, Main *bmain)
 {
   ED_editors_flush_edits(bmain);
@@ -2137,9 +2199,11 @@ void WM_autosave_write(wmWindowManager *wm, Main *bmain)
   /* Save as regular blend file with recovery information. */
   const int fileflags = (G.fileflags & ~G_FILE_COMPRESS) | G_FILE_RECOVER_WRITE;
 
-  /* Error reporting into console. */
-  BlendFileWriteParams params{};
-  BLO_write_file(bmain, filepath, fileflags, &params, nullptr);
+  if (!wm_autosave_write_in_background(wm, bmain, filepath, fileflags)) {
+    /* Error reporting into console. */
+    BlendFileWriteParams params{};
+    BLO_write_file(bmain, filepath, fileflags, &params, nullptr);
+  }
 
   /* Restart auto-save timer. */
   wm_autosave_timer_end(wm);
@@ -3495,8 +3559,10 @@ static int wm_save_as_mainfile_exec(bContext *C, wmOperator *op)
   /* Set compression flag. */
   SET_FLAG_FROM_TEST(fileflags, RNA_boolean_get(op->ptr, "compress"), G_FILE_COMPRESS);
 
+  const bool use_block_hash_index = RNA_boolean_get(op->ptr, "block_hash_index");
+
   const bool success = wm_file_write(
-      C, filepath, fileflags, remap_mode, use_save_as_copy, op->reports);
+      C, filepath, fileflags, remap_mode, use_save_as_copy, use_block_hash_index, op->reports);
 
   if ((op->flag & OP_IS_INVOKE) == 0) {
     /* OP_IS_INVOKE is set when the operator is called from the GUI.
@@ -3565,6 +3631,18 @@ static std::string wm_save_as_mainfile_get_description(bContext * /*C*/,
   return "";
 }
 
+static void wm_save_block_hash_index_prop_def(wmOperatorType *ot)
+{
+  PropertyRNA *prop = RNA_def_boolean(ot->srna,
+                                      "block_hash_index",
+                                      false,
+                                      "Block Hash Index",
+                                      "Write a \"" BLO_BLOCK_HASH_INDEX_EXT
+                                      "\" file listing the content hash of every block, "
+                                      "used by external tools to detect unchanged data");
+  RNA_def_property_flag(prop, PropertyFlag(PROP_HIDDEN | PROP_SKIP_SAVE));
+}
+
 void WM_OT_save_as_mainfile(wmOperatorType *ot)
 {
   PropertyRNA *prop;
@@ -3600,6 +3678,7 @@ void WM_OT_save_as_mainfile(wmOperatorType *ot)
       "Save Copy",
       "Save a copy of the actual working state but does not make saved file active");
   RNA_def_property_flag(prop, PROP_SKIP_SAVE);
+  wm_save_block_hash_index_prop_def(ot);
 }
 
 static int wm_save_mainfile_invoke(bContext *C, wmOperator *op, const wmEvent * /*event*/)
@@ -3691,6 +3770,8 @@ void WM_OT_save_mainfile(wmOperatorType *ot)
                          "Save the current Blender file with a numerically incremented name that "
                          "does not overwrite any existing files");
   RNA_def_property_flag(prop, PropertyFlag(PROP_HIDDEN | PROP_SKIP_SAVE));
+
+  wm_save_block_hash_index_prop_def(ot);
 }
 
 /** \} */
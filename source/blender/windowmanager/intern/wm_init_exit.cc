@@ -28,6 +28,7 @@
 #include "BLI_task.h"
 #include "BLI_threads.h"
 #include "BLI_timer.h"
+#include "BLI_trace.hh"
 #include "BLI_utildefines.h"
 
 #include "BLO_undofile.hh"
@@ -195,6 +196,7 @@ static void sound_jack_sync_callback(Main *bmain, int mode, double time)
 
 void WM_init(bContext *C, int argc, const char **argv)
 {
+  TRACE_SCOPE("WM::init");
 
   if (!G.background) {
     wm_ghost_init(C); /* NOTE: it assigns C to ghost! */
@@ -415,6 +417,7 @@ void WM_init_splash(bContext *C)
 static void wm_init_scripts_extensions_once(bContext *C)
 {
 #ifdef WITH_PYTHON
+  TRACE_SCOPE("WM::init_scripts_extensions");
   const char *imports[] = {"bpy", nullptr};
   BPY_run_string_eval(C, imports, "bpy.utils.load_scripts_extensions()");
 #else
@@ -692,6 +695,9 @@ void WM_exit_ex(bContext *C, const bool do_python_exit, const bool do_user_exit_
 
   BKE_tempdir_session_purge();
 
+  /* Written late so that shutting down sub-systems is part of the trace. */
+  blender::trace::write();
+
   /* Logging cannot be called after exiting (#CLOG_INFO, #CLOG_WARN etc will crash).
    * So postpone exiting until other sub-systems that may use logging have shut down. */
   CLG_exit();
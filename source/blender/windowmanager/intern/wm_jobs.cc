@@ -15,6 +15,7 @@
 #include "MEM_guardedalloc.h"
 
 #include "BLI_blenlib.h"
+#include "BLI_task.hh"
 #include "BLI_threads.h"
 #include "BLI_time.h"
 #include "BLI_utildefines.h"
@@ -395,7 +396,10 @@ static void *do_job_thread(void *job_v)
 {
   wmJob *wm_job = static_cast<wmJob *>(job_v);
 
-  wm_job->startjob(wm_job->run_customdata, &wm_job->worker_status);
+  /* Jobs run in the background, the threads they use should rather be available for interactive
+   * work in the main thread (e.g. depsgraph evaluation and drawing the viewport). */
+  blender::threading::low_priority_task(
+      [&]() { wm_job->startjob(wm_job->run_customdata, &wm_job->worker_status); });
   wm_job->ready = true;
 
   return nullptr;
@@ -148,6 +148,12 @@ void wm_event_add_ghostevent(wmWindowManager *wm,
                              int type,
                              const void *customdata,
                              const uint64_t event_time_ms);
+/**
+ * Record the time from the oldest input event received since the last call until now as the
+ * `WM::input_latency_ms` trace counter. Called after drawing windows, when nothing was
+ * \a presented the input didn't cause a redraw and the pending time is discarded.
+ */
+void wm_event_input_latency_report(bool presented);
 #ifdef WITH_XR_OPENXR
 void wm_event_add_xrevent(wmWindow *win, wmXrActionData *actiondata, short val);
 #endif
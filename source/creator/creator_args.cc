@@ -29,6 +29,7 @@
 #  include "BLI_string_utf8.h"
 #  include "BLI_system.h"
 #  include "BLI_threads.h"
+#  include "BLI_trace.hh"
 #  include "BLI_utildefines.h"
 #  ifndef NDEBUG
 #    include "BLI_mempool.h"
@@ -759,6 +760,7 @@ static void print_help(bArgs *ba, bool all)
 
   PRINT("\n");
   BLI_args_print_arg_doc(ba, "--debug-fpe");
+  BLI_args_print_arg_doc(ba, "--debug-trace");
   BLI_args_print_arg_doc(ba, "--debug-exit-on-error");
   if (defs.with_freestyle) {
     BLI_args_print_arg_doc(ba, "--debug-freestyle");
@@ -778,6 +780,7 @@ static void print_help(bArgs *ba, bool all)
   BLI_args_print_arg_doc(ba, "--app-template");
   BLI_args_print_arg_doc(ba, "--factory-startup");
   BLI_args_print_arg_doc(ba, "--enable-event-simulate");
+  BLI_args_print_arg_doc(ba, "--read-shared-memory");
   PRINT("\n");
   BLI_args_print_arg_doc(ba, "--env-system-datafiles");
   BLI_args_print_arg_doc(ba, "--env-system-scripts");
@@ -1465,6 +1468,24 @@ static int arg_handle_debug_fpe_set(int /*argc*/, const char ** /*argv*/, void *
   return 0;
 }
 
+static const char arg_handle_debug_trace_set_doc[] =
+    "<filepath>\n"
+    "\tRecord a trace of the time spent in instrumented scopes and write it to the file on exit.\n"
+    "\tThe file uses the Chrome trace event format, viewable with 'https://ui.perfetto.dev'.";
+static int arg_handle_debug_trace_set(int argc, const char **argv, void * /*data*/)
+{
+  const char *arg_id = "--debug-trace";
+  if (argc > 1) {
+    char filepath[FILE_MAX];
+    STRNCPY(filepath, argv[1]);
+    BLI_path_abs_from_cwd(filepath, sizeof(filepath));
+    blender::trace::enable(filepath);
+    return 1;
+  }
+  fprintf(stderr, "\nError: '%s' no args given.\n", arg_id);
+  return 0;
+}
+
 static const char arg_handle_app_template_doc[] =
     "<template>\n"
     "\tSet the application template (matching the directory name), use 'default' for none.";
@@ -1498,6 +1519,22 @@ static int arg_handle_enable_event_simulate(int /*argc*/, const char ** /*argv*/
   return 0;
 }
 
+static const char arg_handle_read_shared_memory_set_doc[] =
+    "\n\t"
+    "Share large read-only data of loaded files with other Blender processes on the same machine\n"
+    "\tusing shared memory (reduces memory usage when running multiple render jobs per machine).";
+static int arg_handle_read_shared_memory_set(int /*argc*/,
+                                             const char ** /*argv*/,
+                                             void * /*data*/)
+{
+#ifdef WIN32
+  fprintf(stderr, "\nError: '--read-shared-memory' is not supported on this platform.\n");
+#else
+  G.f |= G_FLAG_READ_SHARED_MEMORY;
+#endif
+  return 0;
+}
+
 static const char arg_handle_env_system_set_doc_datafiles[] =
     "\n\t"
     "Set the " STRINGIFY_ARG(BLENDER_SYSTEM_DATAFILES) " environment variable.";
@@ -2609,6 +2646,7 @@ void main_args_setup(bContext *C, bArgs *ba, bool all)
   BLI_args_add(ba, nullptr, "--debug-io", CB(arg_handle_debug_mode_io), nullptr);
 
   BLI_args_add(ba, nullptr, "--debug-fpe", CB(arg_handle_debug_fpe_set), nullptr);
+  BLI_args_add(ba, nullptr, "--debug-trace", CB(arg_handle_debug_trace_set), nullptr);
 
   if (defs.with_libmv) {
     BLI_args_add(ba, nullptr, "--debug-libmv", CB(arg_handle_debug_mode_libmv), nullptr);
@@ -2689,6 +2727,8 @@ void main_args_setup(bContext *C, bArgs *ba, bool all)
   BLI_args_add(ba, nullptr, "--factory-startup", CB(arg_handle_factory_startup_set), nullptr);
   BLI_args_add(
       ba, nullptr, "--enable-event-simulate", CB(arg_handle_enable_event_simulate), nullptr);
+  BLI_args_add(
+      ba, nullptr, "--read-shared-memory", CB(arg_handle_read_shared_memory_set), nullptr);
 
   /* Pass: Custom Window Stuff. */
   BLI_args_pass_set(ba, ARG_PASS_SETTINGS_GUI);
@@ -0,0 +1,26 @@
+# SPDX-FileCopyrightText: 2024 Blender Authors
+#
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+# Run several jobs in one process, resetting the data between them,
+# as done by worker processes that keep `bpy` imported.
+import sys
+sys.path.append(sys.argv[1])
+
+import bpy
+
+
+def run_job(index):
+    mesh = bpy.data.meshes.new("Mesh")
+    mesh.from_pydata([(0.0, 0.0, 0.0), (1.0, 0.0, 0.0), (0.0, 1.0, float(index))], [], [(0, 1, 2)])
+    obj = bpy.data.objects.new("Object", mesh)
+    bpy.context.scene.collection.objects.link(obj)
+    bpy.context.view_layer.update()
+    assert len(bpy.context.scene.objects) == 1
+
+
+for index in range(3):
+    bpy.ops.wm.read_factory_settings(use_empty=True)
+    assert len(bpy.data.objects) == 0
+    assert len(bpy.data.meshes) == 0
+    run_job(index)
@@ -0,0 +1,60 @@
+# SPDX-FileCopyrightText: 2024 Blender Authors
+#
+# SPDX-License-Identifier: Apache-2.0
+
+import api
+import json
+import pathlib
+import re
+import tempfile
+
+# GTest based micro-benchmark executables, with the source file their tests are defined in.
+EXECUTABLES = {
+    'BLI_kernels_performance': 'source/blender/blenlib/tests/performance/BLI_kernels_performance_test.cc',
+}
+
+
+class MicroBenchmarkTest(api.Test):
+    def __init__(self, executable, suite, test):
+        self.executable = executable
+        self.suite = suite
+        self.test = test
+
+    def name(self):
+        return f'{self.suite}.{self.test}'
+
+    def category(self):
+        return "microbenchmarks"
+
+    def use_device(self):
+        return False
+
+    def run(self, env, device_id):
+        # Test executables are not installed, they stay in the build directory.
+        executable = env.build_dir / 'bin' / 'tests' / self.executable
+        if not executable.exists():
+            raise Exception(f"Micro-benchmark executable {executable} not found, build with WITH_GTESTS=ON")
+
+        with tempfile.TemporaryDirectory() as tmpdir:
+            output_filepath = pathlib.Path(tmpdir) / 'output.json'
+            env.call([executable, f'--gtest_filter={self.name()}', f'--gtest_output=json:{output_filepath}'],
+                     env.build_dir)
+            output = json.loads(output_filepath.read_text())
+
+        for suite in output['testsuites']:
+            for test in suite['testsuite']:
+                if suite['name'] == self.suite and test['name'] == self.test and 'benchmark_time' in test:
+                    return {'time': float(test['benchmark_time'])}
+
+        raise Exception(f"No timing recorded for {self.name()}")
+
+
+def generate(env):
+    tests = []
+    for executable, source in EXECUTABLES.items():
+        filepath = env.blender_git_dir / source
+        if not filepath.exists():
+            continue
+        for suite, test in re.findall(r'^TEST\((\w+), (\w+)\)', filepath.read_text(), re.MULTILINE):
+            tests.append(MicroBenchmarkTest(executable, suite, test))
+    return tests